@@ -45,11 +45,16 @@
 //#define IMGUI_DISABLE_DEFAULT_SHELL_FUNCTIONS             // Don't implement default platform_io.Platform_OpenInShellFn() handler (Win32: ShellExecute(), require shell32.lib/.a, Mac/Linux: use system("")).
 //#define IMGUI_DISABLE_DEFAULT_FORMAT_FUNCTIONS            // Don't implement ImFormatString/ImFormatStringV so you can implement them yourself (e.g. if you don't want to link with vsnprintf)
 //#define IMGUI_DISABLE_DEFAULT_MATH_FUNCTIONS              // Don't implement ImFabs/ImSqrt/ImPow/ImFmod/ImCos/ImSin/ImAcos/ImAtan2 so you can implement them yourself.
+//#define IMGUI_DISABLE_DEFAULT_HASH_FUNCTIONS              // Don't implement ImHashData() so you can implement it yourself (e.g. wyhash, xxh3). ImHashStr() calls it after handling "###".
 //#define IMGUI_DISABLE_FILE_FUNCTIONS                      // Don't implement ImFileOpen/ImFileClose/ImFileRead/ImFileWrite and ImFileHandle at all (replace them with dummies)
 //#define IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS              // Don't implement ImFileOpen/ImFileClose/ImFileRead/ImFileWrite and ImFileHandle so you can implement them yourself if you don't want to link with fopen/fclose/fread/fwrite. This will also disable the LogToTTY() function.
 //#define IMGUI_DISABLE_DEFAULT_ALLOCATORS                  // Don't implement default allocators calling malloc()/free() to avoid linking with them. You will need to call ImGui::SetAllocatorFunctions().
 //#define IMGUI_DISABLE_DEFAULT_FONT                        // Disable default embedded font (ProggyClean.ttf), remove ~9.5 KB from output binary. AddFontDefault() will assert.
 //#define IMGUI_DISABLE_SSE                                 // Disable use of SSE intrinsics even if available
+//#define IMGUI_DISABLE_AVX2                                // Disable use of AVX2 intrinsics even if available (e.g. compiling with /arch:AVX2 or -mavx2)
+//#define IMGUI_DISABLE_NEON                                // Disable use of NEON intrinsics even if available
+//#define IMGUI_DISABLE_ARM_CRC32                           // Disable use of ARMv8 CRC32 instructions for ImHashData() even if available (e.g. compiling with -march=armv8-a+crc). IDs are the same either way
+//#define IMGUI_DISABLE_SPLITTER_IN_PLACE_MERGE             // Disable ImDrawListSplitter channels writing in place into the parent index buffer (Merge() copies every channel back instead)
 
 //---- Enable Test Engine / Automation features.
 //#define IMGUI_ENABLE_TEST_ENGINE                          // Enable imgui_test_engine hooks. Generally set automatically by include "imgui_te_config.h", see Test Engine for details.
@@ -65,6 +70,10 @@
 //---- Use legacy CRC32-adler tables (used before 1.91.6), in order to preserve old .ini data that you cannot afford to invalidate.
 //#define IMGUI_USE_LEGACY_CRC32_ADLER
 
+//---- Use a word-at-a-time multiply hash instead of CRC32c for IDs. Faster when SSE 4.2/ARMv8 CRC instructions are not enabled (e.g. MSVC x64 without /arch:AVX),
+//     but it invalidates .ini data storing IDs (e.g. tables settings), and IDs differ between little and big-endian targets.
+//#define IMGUI_USE_FAST_HASH
+
 //---- Use 32-bit for ImWchar (default is 16-bit) to support Unicode planes 1-16. (e.g. point beyond 0xFFFF like emoticons, dingbats, symbols, shapes, ancient languages, etc...)
 //#define IMGUI_USE_WCHAR32
 
@@ -98,6 +107,11 @@
 // The only purpose of this define is if you want force compilation of the stb_truetype backend ALONG with the FreeType backend.
 //#define IMGUI_ENABLE_STB_TRUETYPE
 
+//---- Rasterize glyphs on worker threads when ImFontAtlasFlags_AsyncGlyphBaking is set (stb_truetype loader only).
+// Requires C++11 <thread>. Number of worker threads defaults to hardware threads - 1 (max 4), override with IMGUI_FONT_ASYNC_BAKING_THREADS.
+//#define IMGUI_ENABLE_FONT_ASYNC_BAKING
+//#define IMGUI_FONT_ASYNC_BAKING_THREADS   2
+
 //---- Define constructor and implicit cast operators to convert back<>forth between your math types and ImVec2/ImVec4.
 // This will be inlined as part of ImVec2 and ImVec4 class declarations.
 /*
@@ -118,6 +132,12 @@
 // Read about ImGuiBackendFlags_RendererHasVtxOffset for details.
 //#define ImDrawIdx unsigned int
 
+//---- Use a compact 12 bytes ImDrawVert instead of 20 bytes (implemented with IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT, see ImDrawVertPos16 in imgui.h).
+// Positions are 16-bit fixed point with IMGUI_DRAWVERT_POS_SUBPIXEL_BITS fractional bits (default 3: 1/8 pixel steps, coordinates within -4096..+4096),
+// UVs are 16-bit normalized (must be within 0..1), colors are unchanged. Your renderer backend needs to support it (imgui_impl_dx12.cpp does).
+//#define IMGUI_USE_COMPACT_DRAWVERT
+//#define IMGUI_DRAWVERT_POS_SUBPIXEL_BITS 3
+
 //---- Override ImDrawCallback signature (will need to modify renderer backends accordingly)
 //struct ImDrawList;
 //struct ImDrawCmd;
@@ -72,7 +72,7 @@ CODE
 // [SECTION] MISC HELPERS/UTILITIES (Color functions)
 // [SECTION] ImGuiStorage
 // [SECTION] ImGuiTextFilter
-// [SECTION] ImGuiTextBuffer, ImGuiTextIndex
+// [SECTION] ImGuiTextBuffer, ImGuiTextIndex, ImGuiTextChunkedBuffer
 // [SECTION] ImGuiListClipper
 // [SECTION] STYLING
 // [SECTION] RENDER HELPERS
@@ -2272,7 +2272,8 @@ void ImFormatStringToTempBufferV(const char** out_buf, const char** out_buf_end,
     }
 }
 
-#ifndef IMGUI_ENABLE_SSE4_2_CRC
+#if !defined(IMGUI_ENABLE_SSE4_2_CRC) && !defined(IMGUI_ENABLE_ARM_CRC32) && !defined(IMGUI_USE_FAST_HASH) && !defined(IMGUI_DISABLE_DEFAULT_HASH_FUNCTIONS)
+#define IMGUI_ENABLE_CRC32_LUT
 // CRC32 needs a 1KB lookup table (not cache friendly)
 // Although the code to generate the table is simple and shorter than the table itself, using a const table allows us to easily:
 // - avoid an unnecessary branch/memory tap, - keep the ImHashXXX functions usable by static constructors, - make it thread-safe.
@@ -2320,43 +2321,108 @@ static const ImU32 GCrc32LookupTable[256] =
 
 // Known size hash
 // It is ok to call ImHashData on a string with known length but the ### operator won't be supported.
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
+// - Default: CRC32c. With SSE 4.2 or ARMv8 CRC instructions we process 8 bytes per step, which gives the same values as the byte-wise table.
+// - IMGUI_USE_FAST_HASH: word-at-a-time multiply hash (xxh64 rounds, wyhash style tail), much faster than the table when no CRC instruction is
+//   enabled (e.g. default MSVC x64 builds) but IDs differ from CRC32c ones, so .ini data storing IDs (e.g. tables) gets invalidated.
+// - IMGUI_DISABLE_DEFAULT_HASH_FUNCTIONS: implement ImHashData() yourself. ImHashStr() calls it after handling ###.
+#ifndef IMGUI_DISABLE_DEFAULT_HASH_FUNCTIONS
 ImGuiID ImHashData(const void* data_p, size_t data_size, ImGuiID seed)
 {
-    ImU32 crc = ~seed;
     const unsigned char* data = (const unsigned char*)data_p;
-    const unsigned char *data_end = (const unsigned char*)data_p + data_size;
-#ifndef IMGUI_ENABLE_SSE4_2_CRC
-    const ImU32* crc32_lut = GCrc32LookupTable;
+    const unsigned char* data_end = (const unsigned char*)data_p + data_size;
+#if defined(IMGUI_USE_FAST_HASH)
+    if (data_size == 0)
+        return seed; // Match CRC32: hashing nothing leaves the seed unchanged (e.g. GetID("") == parent ID)
+    // xxh64 round: a plain '(h ^ v) * mul' only carries differences towards the top bits, which let labels such as "Item 40163" and "Item 80167" collide.
+    const ImU64 prime1 = 0x9E3779B185EBCA87ULL;
+    const ImU64 prime2 = 0xC2B2AE3D27D4EB4FULL;
+    ImU64 h = (((ImU64)seed << 32) | (ImU32)data_size) * prime1;
+    for (; data + 8 <= data_end; data += 8)
+    {
+        ImU64 v;
+        memcpy(&v, data, 8);
+        h += v * prime2;
+        h = ((h << 31) | (h >> 33)) * prime1;
+    }
+    if (data < data_end)
+    {
+        // 1-7 bytes left: two overlapping 4 bytes reads or 3 single bytes reads (as wyhash does), the length is already mixed in
+        const size_t rem = (size_t)(data_end - data);
+        ImU64 v;
+        if (rem >= 4)
+        {
+            ImU32 lo, hi;
+            memcpy(&lo, data, 4);
+            memcpy(&hi, data_end - 4, 4);
+            v = ((ImU64)hi << 32) | lo;
+        }
+        else
+        {
+            v = ((ImU64)data[0] << 16) | ((ImU64)data[rem >> 1] << 8) | data[rem - 1];
+        }
+        h += v * prime2;
+        h = ((h << 31) | (h >> 33)) * prime1;
+    }
+    h ^= h >> 33; // MurmurHash3 fmix64
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return (ImGuiID)h;
+#elif defined(IMGUI_ENABLE_SSE4_2_CRC)
+    ImU32 crc = ~seed;
+#if defined(_M_X64) || defined(__x86_64__)
+    for (; data + 8 <= data_end; data += 8)
+    {
+        ImU64 v;
+        memcpy(&v, data, 8);
+        crc = (ImU32)_mm_crc32_u64(crc, v);
+    }
+#endif
+    for (; data + 4 <= data_end; data += 4)
+    {
+        ImU32 v;
+        memcpy(&v, data, 4);
+        crc = _mm_crc32_u32(crc, v);
+    }
     while (data < data_end)
-        crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ *data++];
+        crc = _mm_crc32_u8(crc, *data++);
     return ~crc;
-#else
-    while (data + 4 <= data_end)
+#elif defined(IMGUI_ENABLE_ARM_CRC32)
+    ImU32 crc = ~seed;
+    for (; data + 8 <= data_end; data += 8)
     {
-        crc = _mm_crc32_u32(crc, *(ImU32*)data);
-        data += 4;
+        ImU64 v;
+        memcpy(&v, data, 8);
+        crc = __crc32cd(crc, v);
     }
     while (data < data_end)
-        crc = _mm_crc32_u8(crc, *data++);
+        crc = __crc32cb(crc, *data++);
+    return ~crc;
+#else // IMGUI_ENABLE_CRC32_LUT
+    ImU32 crc = ~seed;
+    const ImU32* crc32_lut = GCrc32LookupTable;
+    while (data < data_end)
+        crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ *data++];
     return ~crc;
 #endif
 }
+#endif // #ifndef IMGUI_DISABLE_DEFAULT_HASH_FUNCTIONS
 
 // Zero-terminated string hash, with support for ### to reset back to seed value
 // We support a syntax of "label###id" where only "###id" is included in the hash, and only "label" gets displayed.
-// Because this syntax is rarely used we are optimizing for the common case.
-// - If we reach ### in the string we discard the hash so far and reset to the seed.
-// - We don't do 'current += 2; continue;' after handling ### to keep the code smaller/faster (measured ~10% diff in Debug build)
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
+// If we reach ### in the string we discard the hash so far and reset to the seed, which is the same as hashing from the last ###:
+// - With word-at-a-time hashing we find the string end and the last ### with strlen()/memchr() (vectorized by the C library),
+//   then hash the rest as known size data. So ImHashStr(str) == ImHashData(str, strlen(str)) when there is no ###.
+// - With the byte-wise CRC32 table we test each character while hashing it, which is cheaper than the extra passes.
+//   We don't do 'current += 2; continue;' after handling ### to keep the code smaller/faster (measured ~10% diff in Debug build)
 ImGuiID ImHashStr(const char* data_p, size_t data_size, ImGuiID seed)
 {
+#ifdef IMGUI_ENABLE_CRC32_LUT
     seed = ~seed;
     ImU32 crc = seed;
     const unsigned char* data = (const unsigned char*)data_p;
-#ifndef IMGUI_ENABLE_SSE4_2_CRC
     const ImU32* crc32_lut = GCrc32LookupTable;
-#endif
     if (data_size != 0)
     {
         while (data_size-- != 0)
@@ -2364,11 +2430,7 @@ ImGuiID ImHashStr(const char* data_p, size_t data_size, ImGuiID seed)
             unsigned char c = *data++;
             if (c == '#' && data_size >= 2 && data[0] == '#' && data[1] == '#')
                 crc = seed;
-#ifndef IMGUI_ENABLE_SSE4_2_CRC
             crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ c];
-#else
-            crc = _mm_crc32_u8(crc, c);
-#endif
         }
     }
     else
@@ -2377,14 +2439,19 @@ ImGuiID ImHashStr(const char* data_p, size_t data_size, ImGuiID seed)
         {
             if (c == '#' && data[0] == '#' && data[1] == '#')
                 crc = seed;
-#ifndef IMGUI_ENABLE_SSE4_2_CRC
             crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ c];
-#else
-            crc = _mm_crc32_u8(crc, c);
-#endif
         }
     }
     return ~crc;
+#else
+    if (data_size == 0)
+        data_size = strlen(data_p);
+    const char* data_end = data_p + data_size;
+    for (const char* p = data_p; (p = (const char*)ImMemchr(p, '#', (size_t)(data_end - p))) != NULL; p++)
+        if (data_end - p > 2 && p[1] == '#' && p[2] == '#')
+            data_p = p;
+    return ImHashData(data_p, (size_t)(data_end - data_p), seed);
+#endif
 }
 
 // Skip to the "###" marker if any. We don't skip past to match the behavior of GetID()
@@ -2803,18 +2870,94 @@ static int IMGUI_CDECL PairComparerByID(const void* lhs, const void* rhs)
     return (lhs_v > rhs_v ? +1 : lhs_v < rhs_v ? -1 : 0);
 }
 
+// Keys are usually hashes already, but user keys (e.g. indices) are not: mix so that consecutive keys don't fill consecutive slots.
+static inline int ImGuiStorageHashSlot(ImGuiID key, int mask)
+{
+    key ^= key >> 16;
+    key *= 0x7FEB352D;
+    key ^= key >> 15;
+    return (int)(key & (ImGuiID)mask);
+}
+
+// Rebuild HashIndex for Data, sized for 'count' pairs. If Data has duplicate keys the first one wins, like ImLowerBound() on sorted data.
+static void ImGuiStorageRebuildHashIndex(ImGuiStorage* storage, int count)
+{
+    int size = 16;
+    while (size < count * 2)
+        size <<= 1;
+    storage->HashIndex.resize(size);
+    memset(storage->HashIndex.Data, 0xFF, (size_t)size * sizeof(int));
+    const int mask = size - 1;
+    const ImGuiStoragePair* data = storage->Data.Data;
+    int* hash_index = storage->HashIndex.Data;
+    for (int n = 0; n < storage->Data.Size; n++)
+    {
+        int slot = ImGuiStorageHashSlot(data[n].key, mask);
+        while (hash_index[slot] != -1 && data[hash_index[slot]].key != data[n].key)
+            slot = (slot + 1) & mask;
+        if (hash_index[slot] == -1)
+            hash_index[slot] = n;
+    }
+}
+
+static ImGuiStoragePair* ImGuiStorageFind(const ImGuiStorage* storage, ImGuiID key)
+{
+    ImGuiStoragePair* data = const_cast<ImGuiStoragePair*>(storage->Data.Data);
+    if (storage->HashIndex.Size > 0)
+    {
+        const int mask = storage->HashIndex.Size - 1;
+        for (int slot = ImGuiStorageHashSlot(key, mask); ; slot = (slot + 1) & mask)
+        {
+            const int idx = storage->HashIndex.Data[slot];
+            if (idx == -1)
+                return NULL;
+            if (data[idx].key == key)
+                return &data[idx];
+        }
+    }
+    ImGuiStoragePair* it = ImLowerBound(data, data + storage->Data.Size, key);
+    return (it != data + storage->Data.Size && it->key == key) ? it : NULL;
+}
+
+// Find pair, insert 'new_pair' if missing.
+static ImGuiStoragePair* ImGuiStorageFindOrInsert(ImGuiStorage* storage, const ImGuiStoragePair& new_pair)
+{
+    ImVector<ImGuiStoragePair>& data = storage->Data;
+    if (storage->HashIndex.Size == 0 && storage->HashThreshold > 0 && data.Size + 1 >= storage->HashThreshold)
+        ImGuiStorageRebuildHashIndex(storage, data.Size + 1);
+    if (storage->HashIndex.Size == 0)
+    {
+        ImGuiStoragePair* it = ImLowerBound(data.Data, data.Data + data.Size, new_pair.key);
+        if (it == data.Data + data.Size || it->key != new_pair.key)
+            it = data.insert(it, new_pair);
+        return it;
+    }
+
+    const int mask = storage->HashIndex.Size - 1;
+    int slot = ImGuiStorageHashSlot(new_pair.key, mask);
+    for (int idx; (idx = storage->HashIndex.Data[slot]) != -1; slot = (slot + 1) & mask)
+        if (data.Data[idx].key == new_pair.key)
+            return &data.Data[idx];
+    data.push_back(new_pair);
+    if (data.Size * 2 > storage->HashIndex.Size)
+        ImGuiStorageRebuildHashIndex(storage, data.Size);
+    else
+        storage->HashIndex.Data[slot] = data.Size - 1;
+    return &data.back();
+}
+
 // For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
 void ImGuiStorage::BuildSortByKey()
 {
     ImQsort(Data.Data, (size_t)Data.Size, sizeof(ImGuiStoragePair), PairComparerByID);
+    if (HashIndex.Size > 0 || (HashThreshold > 0 && Data.Size >= HashThreshold))
+        ImGuiStorageRebuildHashIndex(this, Data.Size);
 }
 
 int ImGuiStorage::GetInt(ImGuiID key, int default_val) const
 {
-    ImGuiStoragePair* it = ImLowerBound(const_cast<ImGuiStoragePair*>(Data.Data), const_cast<ImGuiStoragePair*>(Data.Data + Data.Size), key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        return default_val;
-    return it->val_i;
+    ImGuiStoragePair* it = ImGuiStorageFind(this, key);
+    return it ? it->val_i : default_val;
 }
 
 bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
@@ -2824,27 +2967,20 @@ bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
 
 float ImGuiStorage::GetFloat(ImGuiID key, float default_val) const
 {
-    ImGuiStoragePair* it = ImLowerBound(const_cast<ImGuiStoragePair*>(Data.Data), const_cast<ImGuiStoragePair*>(Data.Data + Data.Size), key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        return default_val;
-    return it->val_f;
+    ImGuiStoragePair* it = ImGuiStorageFind(this, key);
+    return it ? it->val_f : default_val;
 }
 
 void* ImGuiStorage::GetVoidPtr(ImGuiID key) const
 {
-    ImGuiStoragePair* it = ImLowerBound(const_cast<ImGuiStoragePair*>(Data.Data), const_cast<ImGuiStoragePair*>(Data.Data + Data.Size), key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        return NULL;
-    return it->val_p;
+    ImGuiStoragePair* it = ImGuiStorageFind(this, key);
+    return it ? it->val_p : NULL;
 }
 
 // References are only valid until a new value is added to the storage. Calling a Set***() function or a Get***Ref() function invalidates the pointer.
 int* ImGuiStorage::GetIntRef(ImGuiID key, int default_val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_i;
+    return &ImGuiStorageFindOrInsert(this, ImGuiStoragePair(key, default_val))->val_i;
 }
 
 bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
@@ -2854,28 +2990,18 @@ bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
 
 float* ImGuiStorage::GetFloatRef(ImGuiID key, float default_val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_f;
+    return &ImGuiStorageFindOrInsert(this, ImGuiStoragePair(key, default_val))->val_f;
 }
 
 void** ImGuiStorage::GetVoidPtrRef(ImGuiID key, void* default_val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_p;
+    return &ImGuiStorageFindOrInsert(this, ImGuiStoragePair(key, default_val))->val_p;
 }
 
 // FIXME-OPT: Need a way to reuse the result of lower_bound when doing GetInt()/SetInt() - not too bad because it only happens on explicit interaction (maximum one a frame)
 void ImGuiStorage::SetInt(ImGuiID key, int val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        Data.insert(it, ImGuiStoragePair(key, val));
-    else
-        it->val_i = val;
+    ImGuiStorageFindOrInsert(this, ImGuiStoragePair(key, val))->val_i = val;
 }
 
 void ImGuiStorage::SetBool(ImGuiID key, bool val)
@@ -2885,20 +3011,12 @@ void ImGuiStorage::SetBool(ImGuiID key, bool val)
 
 void ImGuiStorage::SetFloat(ImGuiID key, float val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        Data.insert(it, ImGuiStoragePair(key, val));
-    else
-        it->val_f = val;
+    ImGuiStorageFindOrInsert(this, ImGuiStoragePair(key, val))->val_f = val;
 }
 
 void ImGuiStorage::SetVoidPtr(ImGuiID key, void* val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        Data.insert(it, ImGuiStoragePair(key, val));
-    else
-        it->val_p = val;
+    ImGuiStorageFindOrInsert(this, ImGuiStoragePair(key, val))->val_p = val;
 }
 
 void ImGuiStorage::SetAllInt(int v)
@@ -2915,8 +3033,9 @@ IM_MSVC_RUNTIME_CHECKS_RESTORE
 // Helper: Parse and apply text filters. In format "aaaaa[,bbbb][,ccccc]"
 ImGuiTextFilter::ImGuiTextFilter(const char* default_filter) //-V1077
 {
-    InputBuf[0] = 0;
+    InputBuf[0] = InputBufUpper[0] = 0;
     CountGrep = 0;
+    RefinesPrevious = false;
     if (default_filter)
     {
         ImStrncpy(InputBuf, default_filter, IM_ARRAYSIZE(InputBuf));
@@ -2952,9 +3071,105 @@ void ImGuiTextFilter::ImGuiTextRange::split(char separator, ImVector<ImGuiTextRa
         out->push_back(ImGuiTextRange(wb, we));
 }
 
+#if defined(IMGUI_ENABLE_SSE) || defined(IMGUI_ENABLE_NEON)
+#define IMGUI_ENABLE_TEXTFILTER_SIMD
+#endif
+
+static inline bool ImGuiTextFilter_MatchUpper(const char* text, const char* needle_upper, int len)
+{
+    for (int n = 0; n < len; n++)
+        if (ImToUpper(text[n]) != needle_upper[n])
+            return false;
+    return true;
+}
+
+// Find an upper-case needle in [text, text_end), ignoring ASCII case like ImStristr(). Return NULL if not found.
+// - With SIMD: compare the first and last characters of the needle at 16 positions at a time, then verify candidates.
+// - Otherwise: Horspool search using the filter skip table (or advancing one character at a time if 'skip' is NULL).
+static const char* ImGuiTextFilter_FindNeedle(const char* text, const char* text_end, const char* needle_upper, int needle_len, const ImU8* skip)
+{
+    if (needle_len <= 0)
+        return NULL;
+    const char last = needle_upper[needle_len - 1];
+#ifdef IMGUI_ENABLE_TEXTFILTER_SIMD
+    IM_UNUSED(skip);
+    const char first = needle_upper[0];
+    const char first_lower = (first >= 'A' && first <= 'Z') ? (char)(first | 32) : first;
+    const char last_lower = (last >= 'A' && last <= 'Z') ? (char)(last | 32) : last;
+#if defined(IMGUI_ENABLE_SSE)
+    const __m128i v_first = _mm_set1_epi8(first), v_first_lower = _mm_set1_epi8(first_lower);
+    const __m128i v_last = _mm_set1_epi8(last), v_last_lower = _mm_set1_epi8(last_lower);
+    for (; text_end - text >= needle_len - 1 + 16; text += 16)
+    {
+        const __m128i a = _mm_loadu_si128((const __m128i*)(const void*)text);
+        const __m128i b = _mm_loadu_si128((const __m128i*)(const void*)(text + needle_len - 1));
+        const __m128i m = _mm_and_si128(_mm_or_si128(_mm_cmpeq_epi8(a, v_first), _mm_cmpeq_epi8(a, v_first_lower)), _mm_or_si128(_mm_cmpeq_epi8(b, v_last), _mm_cmpeq_epi8(b, v_last_lower)));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(m);
+        for (int i = 0; mask != 0; i++, mask >>= 1)
+            if ((mask & 1) && ImGuiTextFilter_MatchUpper(text + i + 1, needle_upper + 1, needle_len - 2))
+                return text + i;
+    }
+#else
+    const uint8x16_t v_first = vdupq_n_u8((ImU8)first), v_first_lower = vdupq_n_u8((ImU8)first_lower);
+    const uint8x16_t v_last = vdupq_n_u8((ImU8)last), v_last_lower = vdupq_n_u8((ImU8)last_lower);
+    for (; text_end - text >= needle_len - 1 + 16; text += 16)
+    {
+        const uint8x16_t a = vld1q_u8((const ImU8*)text);
+        const uint8x16_t b = vld1q_u8((const ImU8*)(text + needle_len - 1));
+        const uint8x16_t m = vandq_u8(vorrq_u8(vceqq_u8(a, v_first), vceqq_u8(a, v_first_lower)), vorrq_u8(vceqq_u8(b, v_last), vceqq_u8(b, v_last_lower)));
+        ImU64 mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(m), 4)), 0); // 4 bits per position
+        for (int i = 0; mask != 0; i++, mask >>= 4)
+            if ((mask & 0xF) && ImGuiTextFilter_MatchUpper(text + i + 1, needle_upper + 1, needle_len - 2))
+                return text + i;
+    }
+#endif
+    for (; text_end - text >= needle_len; text++)
+        if (ImToUpper(text[0]) == first && ImToUpper(text[needle_len - 1]) == last && ImGuiTextFilter_MatchUpper(text + 1, needle_upper + 1, needle_len - 2))
+            return text;
+#else
+    while (text_end - text >= needle_len)
+    {
+        const char c = text[needle_len - 1];
+        if (ImToUpper(c) == last && ImGuiTextFilter_MatchUpper(text, needle_upper, needle_len - 1))
+            return text;
+        text += skip ? skip[(ImU8)c] : 1;
+    }
+#endif
+    return NULL;
+}
+
+// Compiled needle of filter 'filter_n' (without its '-' prefix)
+struct ImGuiTextFilterNeedle
+{
+    const char*     Upper;          // NULL if the filter was copied from another ImGuiTextFilter without calling Build(): its ranges point to the original InputBuf.
+    const char*     Original;
+    const char*     OriginalEnd;
+    int             Len;
+    const ImU8*     Skip;
+
+    ImGuiTextFilterNeedle(const ImGuiTextFilter* filter, int filter_n)
+    {
+        const ImGuiTextFilter::ImGuiTextRange& f = filter->Filters[filter_n];
+        Original = (f.b[0] == '-') ? f.b + 1 : f.b;
+        OriginalEnd = f.e;
+        Len = (int)(OriginalEnd - Original);
+        const int offset = (int)(Original - filter->InputBuf);
+        Upper = (offset >= 0 && offset < IM_ARRAYSIZE(filter->InputBuf)) ? filter->InputBufUpper + offset : NULL;
+        Skip = filter->FiltersSkip.Size ? filter->FiltersSkip.Data + filter_n * 256 : NULL;
+    }
+    const char* Find(const char* text, const char* text_end) const
+    {
+        if (Upper == NULL)
+            return (Len > 0) ? ImStristr(text, text_end, Original, OriginalEnd) : NULL;
+        return ImGuiTextFilter_FindNeedle(text, text_end, Upper, Len, Skip);
+    }
+};
+
 void ImGuiTextFilter::Build()
 {
-    Filters.resize(0);
+    // Keep previous filters to tell whether the new ones refine them (InputBufUpper still holds their text)
+    ImVector<ImGuiTextRange> prev_filters;
+    prev_filters.swap(Filters);
     ImGuiTextRange input_range(InputBuf, InputBuf + ImStrlen(InputBuf));
     input_range.split(',', &Filters);
 
@@ -2970,6 +3185,43 @@ void ImGuiTextFilter::Build()
         if (f.b[0] != '-')
             CountGrep += 1;
     }
+
+    // Any text passing the new filter passed the previous one when both only have grep terms, and each term contains the previous one.
+    RefinesPrevious = (CountGrep > 0 && CountGrep == Filters.Size && Filters.Size == prev_filters.Size);
+    for (int filter_n = 0; filter_n < Filters.Size && RefinesPrevious; filter_n++)
+    {
+        const ImGuiTextRange& f = Filters[filter_n];
+        const int prev_b = (int)(prev_filters[filter_n].b - InputBuf);
+        const int prev_e = (int)(prev_filters[filter_n].e - InputBuf);
+        if (prev_b < 0 || prev_b >= prev_e || prev_e > IM_ARRAYSIZE(InputBuf) || InputBufUpper[prev_b] == '-')
+            RefinesPrevious = false;
+        else
+            RefinesPrevious = ImGuiTextFilter_FindNeedle(f.b, f.e, InputBufUpper + prev_b, prev_e - prev_b, NULL) != NULL;
+    }
+
+    // Compile
+    for (int n = 0; n < IM_ARRAYSIZE(InputBuf); n++)
+        if ((InputBufUpper[n] = ImToUpper(InputBuf[n])) == 0)
+            break;
+    FiltersSkip.resize(0);
+#ifndef IMGUI_ENABLE_TEXTFILTER_SIMD
+    FiltersSkip.resize(Filters.Size * 256);
+    for (int filter_n = 0; filter_n < Filters.Size; filter_n++)
+    {
+        const ImGuiTextRange& f = Filters[filter_n];
+        const char* needle = InputBufUpper + (((f.b < f.e && f.b[0] == '-') ? f.b + 1 : f.b) - InputBuf);
+        const int needle_len = (int)(InputBufUpper + (f.e - InputBuf) - needle);
+        ImU8* skip = FiltersSkip.Data + filter_n * 256;
+        memset(skip, ImMax(needle_len, 1), 256);
+        for (int n = 0; n < needle_len - 1; n++)
+        {
+            const char c = needle[n];
+            skip[(ImU8)c] = (ImU8)(needle_len - 1 - n);
+            if (c >= 'A' && c <= 'Z')
+                skip[(ImU8)(c | 32)] = (ImU8)(needle_len - 1 - n);
+        }
+    }
+#endif
 }
 
 bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
@@ -2979,21 +3231,24 @@ bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
 
     if (text == NULL)
         text = text_end = "";
+    if (text_end == NULL)
+        text_end = text + ImStrlen(text);
 
-    for (const ImGuiTextRange& f : Filters)
+    for (int filter_n = 0; filter_n < Filters.Size; filter_n++)
     {
+        const ImGuiTextRange& f = Filters[filter_n];
         if (f.b == f.e)
             continue;
         if (f.b[0] == '-')
         {
             // Subtract
-            if (ImStristr(text, text_end, f.b + 1, f.e) != NULL)
+            if (ImGuiTextFilterNeedle(this, filter_n).Find(text, text_end) != NULL)
                 return false;
         }
         else
         {
             // Grep
-            if (ImStristr(text, text_end, f.b, f.e) != NULL)
+            if (ImGuiTextFilterNeedle(this, filter_n).Find(text, text_end) != NULL)
                 return true;
         }
     }
@@ -3005,8 +3260,136 @@ bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
     return false;
 }
 
+// Bits of word 'word_n' which are within lines [line_begin, line_end)
+static inline ImU32 ImGuiTextFilter_LinesMask(int word_n, int line_begin, int line_end)
+{
+    const int n0 = word_n << 5;
+    ImU32 mask = ~(ImU32)0;
+    if (n0 < line_begin)
+        mask &= ~(ImU32)0 << (line_begin - n0);
+    if (n0 + 32 > line_end)
+        mask &= ~(ImU32)0 >> (n0 + 32 - line_end);
+    return mask;
+}
+
+// First line in [line_n, line_end) whose bit is 'value', or line_end
+static int ImGuiTextFilter_FindLinesBit(const ImU32* words, int word_begin, int line_n, int line_end, bool value)
+{
+    while (line_n < line_end)
+    {
+        ImU32 word = words[(line_n >> 5) - word_begin];
+        word = (value ? word : ~word) >> (line_n & 31);
+        if (word == 0)
+        {
+            line_n = (line_n | 31) + 1;
+            continue;
+        }
+        while ((word & 1) == 0)
+        {
+            word >>= 1;
+            line_n++;
+        }
+        break;
+    }
+    return ImMin(line_n, line_end);
+}
+
+// Filter lines in chunks of 2048: intermediate bits stay on the stack, and all filters scan the same (cached) text.
+// Each filter scans runs of consecutive candidate lines as a whole, matches are then mapped back to lines.
+// Filters are applied in order like PassFilter(): the first filter found in a line decides whether it passes.
+int ImGuiTextFilter::PassFilterLines(const char* buf, const char* buf_end, const int* line_offsets, int lines_count, ImU32* out_pass_bits, int line_begin, int line_end, bool refine) const
+{
+    if (line_end < 0)
+        line_end = lines_count;
+    IM_ASSERT(line_begin >= 0 && line_begin <= line_end && line_end <= lines_count);
+
+    const int CHUNK_WORDS = 64;
+    int pass_count = 0;
+    for (int chunk_begin = line_begin; chunk_begin < line_end; )
+    {
+        const int word_begin = chunk_begin >> 5;
+        const int chunk_end = ImMin((word_begin + CHUNK_WORDS) << 5, line_end);
+        const int words_count = ((chunk_end - 1) >> 5) - word_begin + 1;
+
+        // Lines to test in this chunk
+        ImU32 candidates[CHUNK_WORDS], undecided[CHUNK_WORDS], matched[CHUNK_WORDS], decided[CHUNK_WORDS], pass[CHUNK_WORDS];
+        for (int w = 0; w < words_count; w++)
+        {
+            const ImU32 mask = ImGuiTextFilter_LinesMask(word_begin + w, chunk_begin, chunk_end);
+            candidates[w] = refine ? (out_pass_bits[word_begin + w] & mask) : mask;
+            decided[w] = pass[w] = 0;
+        }
+
+        for (int filter_n = 0; filter_n < Filters.Size; filter_n++)
+        {
+            const ImGuiTextRange& f = Filters[filter_n];
+            if (f.b == f.e)
+                continue;
+            const ImGuiTextFilterNeedle needle(this, filter_n);
+            for (int w = 0; w < words_count; w++)
+            {
+                undecided[w] = candidates[w] & ~decided[w];
+                matched[w] = 0;
+            }
+            for (int n = chunk_begin; n < chunk_end; )
+            {
+                // Find next run of lines not decided by previous filters [run_begin, run_end)
+                const int run_begin = n = ImGuiTextFilter_FindLinesBit(undecided, word_begin, n, chunk_end, true);
+                const int run_end = n = ImGuiTextFilter_FindLinesBit(undecided, word_begin, n, chunk_end, false);
+                if (run_begin == run_end)
+                    break;
+                const char* run_text_end = (run_end < lines_count) ? buf + line_offsets[run_end] - 1 : buf_end;
+
+                // Scan the run as a whole, skip to the next line after each match
+                int line_n = run_begin;
+                for (const char* p = buf + line_offsets[run_begin]; p < run_text_end; )
+                {
+                    const char* match = needle.Find(p, run_text_end);
+                    if (match == NULL)
+                        break;
+                    while (line_n + 1 < run_end && buf + line_offsets[line_n + 1] <= match)
+                        line_n++;
+                    const char* line_text_end = (line_n + 1 < lines_count) ? buf + line_offsets[line_n + 1] - 1 : buf_end;
+                    if (match + needle.Len > line_text_end)
+                    {
+                        p = match + 1; // Match across a line separator
+                        continue;
+                    }
+                    matched[(line_n >> 5) - word_begin] |= 1u << (line_n & 31);
+                    if (++line_n >= run_end)
+                        break;
+                    p = buf + line_offsets[line_n];
+                }
+            }
+
+            // Lines not decided by a previous filter are decided by this one
+            const bool is_subtract = (f.b[0] == '-');
+            for (int w = 0; w < words_count; w++)
+            {
+                const ImU32 newly_decided = matched[w] & ~decided[w];
+                decided[w] |= newly_decided;
+                if (!is_subtract)
+                    pass[w] |= newly_decided;
+            }
+        }
+
+        // Implicit * grep, then output
+        for (int w = 0; w < words_count; w++)
+        {
+            if (CountGrep == 0)
+                pass[w] |= ~decided[w];
+            const ImU32 mask = ImGuiTextFilter_LinesMask(word_begin + w, chunk_begin, chunk_end);
+            const ImU32 bits = pass[w] & candidates[w];
+            out_pass_bits[word_begin + w] = (out_pass_bits[word_begin + w] & ~mask) | bits;
+            pass_count += (int)ImCountSetBits(bits);
+        }
+        chunk_begin = chunk_end;
+    }
+    return pass_count;
+}
+
 //-----------------------------------------------------------------------------
-// [SECTION] ImGuiTextBuffer, ImGuiTextIndex
+// [SECTION] ImGuiTextBuffer, ImGuiTextIndex, ImGuiTextChunkedBuffer
 //-----------------------------------------------------------------------------
 
 // On some platform vsnprintf() takes va_list by reference and modifies it.
@@ -3088,6 +3471,254 @@ void ImGuiTextIndex::append(const char* base, int old_size, int new_size)
     EndOffset = ImMax(EndOffset, new_size);
 }
 
+const char* ImGuiTextWrapIndex::get_wrapped_line_end(const char* base, int n)
+{
+    // Exclude the '\n' and the blanks skipped at a wrap point, which TextWrapped() doesn't count in the line width either
+    const char* line_begin = base + WrapOffsets[n];
+    const char* line_end = base + (n + 1 < WrapOffsets.Size ? WrapOffsets[n + 1] : EndOffset);
+    if (line_end > line_begin && line_end[-1] == '\n')
+        line_end--;
+    while (line_end > line_begin && ImCharIsBlankA(line_end[-1]))
+        line_end--;
+    return line_end;
+}
+
+// Same wrapping as RenderText(): each line is cut by ImFont::CalcWordWrapPosition(), blanks at a wrap point are skipped.
+void ImGuiTextWrapIndex::update(const char* base, ImFont* font, float font_size, float wrap_width)
+{
+    if (font != WrapFont || font_size != WrapFontSize || wrap_width != WrapWidth)
+    {
+        clear_wrap();
+        WrapFont = font;
+        WrapFontSize = font_size;
+        WrapWidth = wrap_width;
+    }
+
+    // The last line may have grown since the previous call: wrap it again
+    WrapOffsets.resize(WrapOffsetsDone);
+    for (int line_n = WrapLinesDone; line_n < LineOffsets.Size; line_n++)
+    {
+        if (line_n == LineOffsets.Size - 1)
+        {
+            WrapLinesDone = line_n;
+            WrapOffsetsDone = WrapOffsets.Size;
+        }
+        const char* s = base + LineOffsets[line_n];
+        const char* line_end = get_line_end(base, line_n);
+        WrapOffsets.push_back((int)(s - base));
+        while (s < line_end)
+        {
+            s = font->CalcWordWrapPosition(font_size, s, line_end, wrap_width);
+            while (s < line_end && ImCharIsBlankA(*s))
+                s++;
+            if (s < line_end)
+                WrapOffsets.push_back((int)(s - base));
+        }
+    }
+}
+
+void ImGuiTextChunkedBuffer::clear()
+{
+    for (Chunk& chunk : Chunks)
+    {
+        IM_FREE(chunk.Data);
+        chunk.LineOffsets.clear();
+    }
+    for (Chunk& chunk : FreeChunks)
+    {
+        IM_FREE(chunk.Data);
+        chunk.LineOffsets.clear();
+    }
+    Chunks.clear();
+    FreeChunks.clear();
+    LinesDropped = 0;
+    TotalSize = 0;
+}
+
+static void ImGuiTextChunkedBuffer_FreeChunk(ImGuiTextChunkedBuffer* buf, ImGuiTextChunkedBuffer::Chunk* chunk)
+{
+    if (chunk->Capacity == buf->ChunkSize)
+    {
+        chunk->LineOffsets.resize(0);
+        buf->FreeChunks.push_back(*chunk); // Takes ownership of both buffers, don't free them
+    }
+    else
+    {
+        IM_FREE(chunk->Data);
+        chunk->LineOffsets.clear();
+    }
+}
+
+// Return where to write 'len' bytes + zero-terminator at the end of the last chunk.
+// When they don't fit, start a new chunk and move the last line there if it is incomplete, so lines never span two chunks.
+static char* ImGuiTextChunkedBuffer_Reserve(ImGuiTextChunkedBuffer* buf, int len)
+{
+    ImGuiTextChunkedBuffer::Chunk* chunk = buf->Chunks.Size ? &buf->Chunks.back() : NULL;
+    if (chunk != NULL && chunk->Size + len + 1 <= chunk->Capacity)
+        return chunk->Data + chunk->Size;
+
+    const bool line_open = (chunk != NULL && chunk->Size > 0 && chunk->Data[chunk->Size - 1] != '\n');
+    const int carry = line_open ? chunk->Size - chunk->LineOffsets.back() : 0;
+    const int capacity = ImMax(buf->ChunkSize, carry + len + 1);
+    const int line_first = buf->LinesDropped + buf->lines_count() - (line_open ? 1 : 0);
+    buf->Chunks.push_back(ImGuiTextChunkedBuffer::Chunk());
+    chunk = (buf->Chunks.Size > 1) ? &buf->Chunks[buf->Chunks.Size - 2] : NULL;
+    ImGuiTextChunkedBuffer::Chunk* new_chunk = &buf->Chunks.back();
+    if (capacity == buf->ChunkSize && buf->FreeChunks.Size > 0)
+    {
+        memcpy((void*)new_chunk, (const void*)&buf->FreeChunks.back(), sizeof(*new_chunk)); // Take ownership of both buffers
+        buf->FreeChunks.pop_back();
+    }
+    else
+    {
+        new_chunk->Data = (char*)IM_ALLOC((size_t)capacity);
+    }
+    new_chunk->Size = carry;
+    new_chunk->Capacity = capacity;
+    new_chunk->LineFirst = line_first;
+    if (carry > 0)
+    {
+        memcpy(new_chunk->Data, chunk->Data + chunk->LineOffsets.back(), (size_t)carry);
+        new_chunk->LineOffsets.push_back(0);
+        chunk->LineOffsets.pop_back();
+        chunk->Size -= carry;
+        if (chunk->Size == 0) // The chunk only held that line
+        {
+            ImGuiTextChunkedBuffer_FreeChunk(buf, chunk);
+            buf->Chunks.erase(chunk);
+        }
+    }
+    return buf->Chunks.back().Data + carry;
+}
+
+// Index lines of the 'len' bytes written at the end of the last chunk, then drop the oldest chunks if over MaxSize.
+static void ImGuiTextChunkedBuffer_Commit(ImGuiTextChunkedBuffer* buf, int len)
+{
+    ImGuiTextChunkedBuffer::Chunk& chunk = buf->Chunks.back();
+    IM_ASSERT(len > 0 && chunk.Size + len < chunk.Capacity);
+    if (chunk.Size == 0 || chunk.Data[chunk.Size - 1] == '\n')
+        chunk.LineOffsets.push_back(chunk.Size);
+    const char* data_end = chunk.Data + chunk.Size + len;
+    for (const char* p = chunk.Data + chunk.Size; (p = (const char*)ImMemchr(p, '\n', data_end - p)) != 0; )
+        if (++p < data_end) // Don't push a trailing offset on last \n
+            chunk.LineOffsets.push_back((int)(intptr_t)(p - chunk.Data));
+    chunk.Size += len;
+    buf->TotalSize += (size_t)len;
+
+    while (buf->MaxSize > 0 && buf->TotalSize > buf->MaxSize && buf->Chunks.Size > 1)
+    {
+        ImGuiTextChunkedBuffer::Chunk* front = &buf->Chunks[0];
+        buf->LinesDropped += front->LineOffsets.Size;
+        buf->TotalSize -= (size_t)front->Size;
+        ImGuiTextChunkedBuffer_FreeChunk(buf, front);
+        buf->Chunks.erase(front);
+    }
+}
+
+void ImGuiTextChunkedBuffer::append(const char* str, const char* str_end)
+{
+    const int len = str_end ? (int)(str_end - str) : (int)ImStrlen(str);
+    if (len <= 0)
+        return;
+    char* dst = ImGuiTextChunkedBuffer_Reserve(this, len);
+    memcpy(dst, str, (size_t)len);
+    ImGuiTextChunkedBuffer_Commit(this, len);
+}
+
+void ImGuiTextChunkedBuffer::appendf(const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    appendfv(fmt, args);
+    va_end(args);
+}
+
+void ImGuiTextChunkedBuffer::appendfv(const char* fmt, va_list args)
+{
+    va_list args_copy;
+    va_copy(args_copy, args);
+
+    // First attempt to format directly in the space left in the last chunk, which usually succeeds
+    int len = 0;
+    if (Chunks.Size > 0)
+    {
+        Chunk& chunk = Chunks.back();
+        const int avail = chunk.Capacity - chunk.Size;
+        len = ImFormatStringV(chunk.Data + chunk.Size, (size_t)avail, fmt, args);
+        if (len < avail - 1)
+        {
+            va_end(args_copy);
+            if (len > 0)
+                ImGuiTextChunkedBuffer_Commit(this, len);
+            return;
+        }
+    }
+
+    va_list args_copy2;
+    va_copy(args_copy2, args_copy);
+    len = ImFormatStringV(NULL, 0, fmt, args_copy);
+    va_end(args_copy);
+    if (len > 0)
+    {
+        char* dst = ImGuiTextChunkedBuffer_Reserve(this, len);
+        ImFormatStringV(dst, (size_t)len + 1, fmt, args_copy2);
+        ImGuiTextChunkedBuffer_Commit(this, len);
+    }
+    va_end(args_copy2);
+}
+
+static void ImGuiTextChunkedBuffer_SetCursorLine(const ImGuiTextChunkedBuffer* buf, ImGuiTextChunkedBuffer::Cursor* cursor)
+{
+    const ImGuiTextChunkedBuffer::Chunk& chunk = buf->Chunks[cursor->ChunkNo];
+    const int n = buf->LinesDropped + cursor->LineNo - chunk.LineFirst;
+    const char* line_begin = chunk.Data + chunk.LineOffsets[n];
+    const char* line_end = chunk.Data + (n + 1 < chunk.LineOffsets.Size ? chunk.LineOffsets[n + 1] : chunk.Size);
+    if (line_end > line_begin && line_end[-1] == '\n')
+        line_end--;
+    cursor->LineBegin = line_begin;
+    cursor->LineEnd = line_end;
+}
+
+ImGuiTextChunkedBuffer::Cursor ImGuiTextChunkedBuffer::seek_line(int line_no) const
+{
+    IM_ASSERT(line_no >= 0 && line_no <= lines_count());
+    Cursor cursor;
+    cursor.LineNo = line_no;
+    cursor.ChunkNo = Chunks.Size;
+    cursor.LineBegin = cursor.LineEnd = NULL;
+    if (line_no == lines_count())
+        return cursor;
+
+    // Last chunk whose first line is <= line_no
+    const int line_abs = LinesDropped + line_no;
+    int lo = 0, hi = Chunks.Size - 1;
+    while (lo < hi)
+    {
+        const int mid = (lo + hi + 1) >> 1;
+        if (Chunks[mid].LineFirst <= line_abs)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+    cursor.ChunkNo = lo;
+    ImGuiTextChunkedBuffer_SetCursorLine(this, &cursor);
+    return cursor;
+}
+
+void ImGuiTextChunkedBuffer::next_line(Cursor* cursor) const
+{
+    IM_ASSERT(cursor->LineNo < lines_count());
+    if (++cursor->LineNo == lines_count())
+    {
+        cursor->ChunkNo = Chunks.Size;
+        cursor->LineBegin = cursor->LineEnd = NULL;
+        return;
+    }
+    if (LinesDropped + cursor->LineNo - Chunks[cursor->ChunkNo].LineFirst == Chunks[cursor->ChunkNo].LineOffsets.Size)
+        cursor->ChunkNo++;
+    ImGuiTextChunkedBuffer_SetCursorLine(this, cursor);
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImGuiListClipper
 //-----------------------------------------------------------------------------
@@ -3152,6 +3783,118 @@ static void ImGuiListClipper_SeekCursorAndSetupPrevLine(ImGuiListClipper* clippe
     }
 }
 
+//-----------------------------------------------------------------------------
+// ImGuiListClipperHeights
+//-----------------------------------------------------------------------------
+
+// Sum of the heights of blocks [0, block_count)
+static double ImGuiListClipperHeights_BlockPrefix(const ImGuiListClipperHeights* heights, int block_count)
+{
+    double sum = 0.0;
+    for (int i = block_count; i > 0; i -= i & -i)
+        sum += heights->BlockTree.Data[i - 1];
+    return sum;
+}
+
+static void ImGuiListClipperHeights_BlockAdd(ImGuiListClipperHeights* heights, int block, double delta)
+{
+    for (int i = block + 1; i <= heights->BlockTree.Size; i += i & -i)
+        heights->BlockTree.Data[i - 1] += delta;
+}
+
+void ImGuiListClipperHeights::Resize(int items_count, float default_height)
+{
+    const int block_size = IMGUI_LISTCLIPPER_HEIGHTS_BLOCK_SIZE;
+    const int old_count = Heights.Size;
+    const int old_blocks = BlockTree.Size;
+    const int new_blocks = (items_count + block_size - 1) / block_size;
+    IM_ASSERT(items_count >= 0);
+    if (items_count < old_count)
+    {
+        // Tree nodes only cover blocks up to their own index: dropping trailing blocks is enough, apart from the new last block which may lose items.
+        double removed = 0.0;
+        for (int n = items_count; n < ImMin(new_blocks * block_size, old_count); n++)
+            removed += Heights.Data[n];
+        BlockTree.resize(new_blocks);
+        Heights.resize(items_count);
+        if (removed != 0.0)
+            ImGuiListClipperHeights_BlockAdd(this, new_blocks - 1, -removed);
+        return;
+    }
+    if (items_count == old_count)
+        return;
+
+    Heights.resize(items_count);
+    for (int n = old_count; n < items_count; n++)
+        Heights.Data[n] = ItemHeightCallback ? ItemHeightCallback(n, ItemHeightCallbackUserData) : default_height;
+
+    // Fill the last existing block, then append new blocks. Node i (1-based) covers blocks (i - lowbit(i), i].
+    double added = 0.0;
+    for (int n = old_count; n < ImMin(old_blocks * block_size, items_count); n++)
+        added += Heights.Data[n];
+    if (added != 0.0)
+        ImGuiListClipperHeights_BlockAdd(this, old_blocks - 1, added);
+    BlockTree.resize(new_blocks);
+    for (int block = old_blocks; block < new_blocks; block++)
+    {
+        double sum = 0.0;
+        for (int n = block * block_size; n < ImMin((block + 1) * block_size, items_count); n++)
+            sum += Heights.Data[n];
+        const int i = block + 1;
+        BlockTree.Data[block] = sum + ImGuiListClipperHeights_BlockPrefix(this, block) - ImGuiListClipperHeights_BlockPrefix(this, i - (i & -i));
+    }
+}
+
+void ImGuiListClipperHeights::SetItemHeight(int item_index, float height)
+{
+    IM_ASSERT(item_index >= 0 && item_index < Heights.Size);
+    const float old_height = Heights.Data[item_index];
+    if (old_height == height)
+        return;
+    Heights.Data[item_index] = height;
+    ImGuiListClipperHeights_BlockAdd(this, item_index / IMGUI_LISTCLIPPER_HEIGHTS_BLOCK_SIZE, (double)height - (double)old_height);
+}
+
+double ImGuiListClipperHeights::GetItemOffset(int item_index) const
+{
+    IM_ASSERT(item_index >= 0 && item_index <= Heights.Size);
+    const int block = item_index / IMGUI_LISTCLIPPER_HEIGHTS_BLOCK_SIZE;
+    double offset = ImGuiListClipperHeights_BlockPrefix(this, block);
+    for (int n = block * IMGUI_LISTCLIPPER_HEIGHTS_BLOCK_SIZE; n < item_index; n++)
+        offset += Heights.Data[n];
+    return offset;
+}
+
+int ImGuiListClipperHeights::FindItemAtOffset(double offset) const
+{
+    if (Heights.Size == 0 || offset <= 0.0)
+        return 0;
+
+    // Descend the tree to find how many whole blocks fit before 'offset', then scan the items of the next block
+    int block = 0;
+    int step = 1;
+    while (step * 2 <= BlockTree.Size)
+        step *= 2;
+    for (; step > 0; step >>= 1)
+        if (block + step <= BlockTree.Size && BlockTree.Data[block + step - 1] <= offset)
+        {
+            block += step;
+            offset -= BlockTree.Data[block - 1];
+        }
+    const int n_end = ImMin((block + 1) * IMGUI_LISTCLIPPER_HEIGHTS_BLOCK_SIZE, Heights.Size);
+    for (int n = block * IMGUI_LISTCLIPPER_HEIGHTS_BLOCK_SIZE; n < n_end; n++)
+    {
+        if (offset < Heights.Data[n])
+            return n;
+        offset -= Heights.Data[n];
+    }
+    return ImMin(n_end, Heights.Size - 1); // Past the end, or rounding differences between the block sums and the scan
+}
+
+//-----------------------------------------------------------------------------
+// ImGuiListClipper
+//-----------------------------------------------------------------------------
+
 ImGuiListClipper::ImGuiListClipper()
 {
     memset(this, 0, sizeof(*this));
@@ -3180,6 +3923,7 @@ void ImGuiListClipper::Begin(int items_count, float items_height)
     ItemsCount = items_count;
     DisplayStart = -1;
     DisplayEnd = 0;
+    Heights = NULL;
 
     // Acquire temporary buffer
     if (++g.ClipperTempDataStacked > g.ClipperTempData.Size)
@@ -3191,6 +3935,19 @@ void ImGuiListClipper::Begin(int items_count, float items_height)
     StartSeekOffsetY = data->LossynessOffset;
 }
 
+// Variable height items: positions and indices are converted through 'heights', which is updated as items get displayed.
+// ItemsHeight is only set to the default estimate.
+void ImGuiListClipper::BeginVariableHeight(int items_count, ImGuiListClipperHeights* heights)
+{
+    IM_ASSERT(heights != NULL && items_count >= 0 && items_count < INT_MAX && "Variable height clipping needs the number of items.");
+    if (Ctx == NULL)
+        Ctx = ImGui::GetCurrentContext();
+    const float default_height = (heights->DefaultHeight > 0.0f) ? heights->DefaultHeight : ImGui::GetTextLineHeightWithSpacing();
+    heights->Resize(items_count, default_height);
+    Begin(items_count, default_height);
+    Heights = heights;
+}
+
 void ImGuiListClipper::End()
 {
     if (ImGuiListClipperData* data = (ImGuiListClipperData*)TempData)
@@ -3230,6 +3987,16 @@ void ImGuiListClipper::SeekCursorForItem(int item_n)
     // - Perform the add and multiply with double to allow seeking through larger ranges.
     // - StartPosY starts from ItemsFrozen, by adding SeekOffsetY we generally cancel that out (SeekOffsetY == LossynessOffset - ItemsFrozen * ItemsHeight).
     // - The reason we store SeekOffsetY instead of inferring it, is because we want to allow user to perform Seek after the last step, where ImGuiListClipperData is already done.
+    if (Heights != NULL)
+    {
+        // Variable height: the line height is used to advance table row counters, so use the average height of the items we skip.
+        const double item_offset = Heights->GetItemOffset(item_n);
+        const int skipped_count = item_n - ImMax(DisplayEnd, 0);
+        const double skipped_height = (skipped_count > 0) ? item_offset - Heights->GetItemOffset(ImMax(DisplayEnd, 0)) : 0.0;
+        const float line_height = (skipped_height > 0.0) ? (float)(skipped_height / skipped_count) : ItemsHeight;
+        ImGuiListClipper_SeekCursorAndSetupPrevLine(this, (float)((double)StartPosY + StartSeekOffsetY + item_offset), line_height);
+        return;
+    }
     float pos_y = (float)((double)StartPosY + StartSeekOffsetY + (double)item_n * ItemsHeight);
     ImGuiListClipper_SeekCursorAndSetupPrevLine(this, pos_y, ItemsHeight);
 }
@@ -3245,6 +4012,13 @@ static bool ImGuiListClipper_StepInternal(ImGuiListClipper* clipper)
     if (table && table->IsInsideRow)
         ImGui::TableEndRow(table);
 
+    // Variable height: measure the item displayed by the previous step
+    if (data->MeasureItemIndex >= 0)
+    {
+        clipper->Heights->SetItemHeight(data->MeasureItemIndex, window->DC.CursorPos.y - data->MeasureItemPosY);
+        data->MeasureItemIndex = -1;
+    }
+
     // No items
     if (clipper->ItemsCount == 0 || GetSkipItemForListClipping())
         return false;
@@ -3256,7 +4030,14 @@ static bool ImGuiListClipper_StepInternal(ImGuiListClipper* clipper)
         clipper->DisplayStart = data->ItemsFrozen;
         clipper->DisplayEnd = ImMin(data->ItemsFrozen + 1, clipper->ItemsCount);
         if (clipper->DisplayStart < clipper->DisplayEnd)
+        {
             data->ItemsFrozen++;
+            if (clipper->Heights)
+            {
+                data->MeasureItemIndex = clipper->DisplayStart;
+                data->MeasureItemPosY = window->DC.CursorPos.y;
+            }
+        }
         return true;
     }
 
@@ -3306,7 +4087,10 @@ static bool ImGuiListClipper_StepInternal(ImGuiListClipper* clipper)
     if (calc_clipping)
     {
         // Record seek offset, this is so ImGuiListClipper::Seek() can be called after ImGuiListClipperData is done
-        clipper->StartSeekOffsetY = (double)data->LossynessOffset - data->ItemsFrozen * (double)clipper->ItemsHeight;
+        if (clipper->Heights)
+            clipper->StartSeekOffsetY = (double)data->LossynessOffset - clipper->Heights->GetItemOffset(data->ItemsFrozen);
+        else
+            clipper->StartSeekOffsetY = (double)data->LossynessOffset - data->ItemsFrozen * (double)clipper->ItemsHeight;
 
         if (g.LogEnabled)
         {
@@ -3358,8 +4142,18 @@ static bool ImGuiListClipper_StepInternal(ImGuiListClipper* clipper)
         // - Very important: when a starting position is after our maximum item, we set Min to (ItemsCount - 1). This allows us to handle most forms of wrapping.
         // - Due to how Selectable extra padding they tend to be "unaligned" with exact unit in the item list,
         //   which with the flooring/ceiling tend to lead to 2 items instead of one being submitted.
+        // - Variable height: items are found from their offset relative to item 0, whose position is what SeekCursorForItem() uses.
         for (ImGuiListClipperRange& range : data->Ranges)
-            if (range.PosToIndexConvert)
+            if (range.PosToIndexConvert && clipper->Heights)
+            {
+                const double item0_pos_y = clipper->StartPosY + clipper->StartSeekOffsetY;
+                const int m1 = clipper->Heights->FindItemAtOffset((double)range.Min - item0_pos_y);
+                const int m2 = clipper->Heights->FindItemAtOffset((double)range.Max - item0_pos_y) + 1;
+                range.Min = ImClamp(m1 + range.PosToIndexOffsetMin, already_submitted, clipper->ItemsCount - 1);
+                range.Max = ImClamp(m2 + range.PosToIndexOffsetMax, range.Min + 1, clipper->ItemsCount);
+                range.PosToIndexConvert = false;
+            }
+            else if (range.PosToIndexConvert)
             {
                 int m1 = (int)(((double)range.Min - window->DC.CursorPos.y - data->LossynessOffset) / clipper->ItemsHeight);
                 int m2 = (int)((((double)range.Max - window->DC.CursorPos.y - data->LossynessOffset) / clipper->ItemsHeight) + 0.999999f);
@@ -3367,19 +4161,35 @@ static bool ImGuiListClipper_StepInternal(ImGuiListClipper* clipper)
                 range.Max = ImClamp(already_submitted + m2 + range.PosToIndexOffsetMax, range.Min + 1, clipper->ItemsCount);
                 range.PosToIndexConvert = false;
             }
+        if (clipper->Heights && data->StepNo == 0)
+        {
+            // Variable height: ranges are displayed one item at a time, move past step 0 so they are not computed again.
+            data->Ranges.push_front(ImGuiListClipperRange::FromIndices(already_submitted, already_submitted));
+            data->StepNo = 1;
+        }
         ImGuiListClipper_SortAndFuseRanges(data->Ranges, data->StepNo);
     }
 
     // Step 0+ (if item height is given in advance) or 1+: Display the next range in line.
+    // - Variable height: display ranges one item at a time so each item can be measured.
     while (data->StepNo < data->Ranges.Size)
     {
-        clipper->DisplayStart = ImMax(data->Ranges[data->StepNo].Min, already_submitted);
-        clipper->DisplayEnd = ImMin(data->Ranges[data->StepNo].Max, clipper->ItemsCount);
-        data->StepNo++;
+        ImGuiListClipperRange& range = data->Ranges[data->StepNo];
+        clipper->DisplayStart = ImMax(range.Min, already_submitted);
+        clipper->DisplayEnd = ImMin(range.Max, clipper->ItemsCount);
+        if (clipper->Heights && clipper->DisplayStart + 1 < clipper->DisplayEnd)
+            range.Min = clipper->DisplayEnd = clipper->DisplayStart + 1;
+        else
+            data->StepNo++;
         if (clipper->DisplayStart >= clipper->DisplayEnd)
             continue;
         if (clipper->DisplayStart > already_submitted)
             clipper->SeekCursorForItem(clipper->DisplayStart);
+        if (clipper->Heights)
+        {
+            data->MeasureItemIndex = clipper->DisplayStart;
+            data->MeasureItemPosY = window->DC.CursorPos.y;
+        }
         return true;
     }
 
@@ -4050,6 +4860,8 @@ ImGuiContext::ImGuiContext(ImFontAtlas* shared_font_atlas)
 
     WindowsActiveCount = 0;
     WindowsBorderHoverPadding = 0.0f;
+    WindowsRefreshStyleHash = 0;
+    WindowsRefreshStyleHashFrame = -1;
     CurrentWindow = NULL;
     HoveredWindow = NULL;
     HoveredWindowUnderMovingWindow = NULL;
@@ -4390,6 +5202,7 @@ void ImGui::Shutdown()
     g.LogBuffer.clear();
     g.DebugLogBuf.clear();
     g.DebugLogIndex.clear();
+    g.TextSizeCache.Clear();
 
     g.Initialized = false;
 }
@@ -4453,6 +5266,7 @@ ImGuiWindow::ImGuiWindow(ImGuiContext* ctx, const char* name) : DrawListInst(NUL
     DrawList->_OwnerName = Name;
     DrawList->_SetDrawListSharedData(&Ctx->DrawListSharedData);
     NavPreferredScoringPosRel[0] = NavPreferredScoringPosRel[1] = ImVec2(FLT_MAX, FLT_MAX);
+    StateStorage.HashThreshold = IMGUI_WINDOW_STORAGE_HASH_THRESHOLD;
 }
 
 ImGuiWindow::~ImGuiWindow()
@@ -4937,7 +5751,8 @@ void* ImGui::MemAlloc(size_t size)
     void* ptr = (*GImAllocatorAllocFunc)(size, GImAllocatorUserData);
 #ifndef IMGUI_DISABLE_DEBUG_TOOLS
     if (ImGuiContext* ctx = GImGui)
-        DebugAllocHook(&ctx->DebugAllocInfo, ctx->FrameCount, ptr, size);
+        if (ctx->DebugAllocInfo.PausedCount == 0)
+            DebugAllocHook(&ctx->DebugAllocInfo, ctx->FrameCount, ptr, size);
 #endif
     return ptr;
 }
@@ -4948,7 +5763,8 @@ void ImGui::MemFree(void* ptr)
 #ifndef IMGUI_DISABLE_DEBUG_TOOLS
     if (ptr != NULL)
         if (ImGuiContext* ctx = GImGui)
-            DebugAllocHook(&ctx->DebugAllocInfo, ctx->FrameCount, ptr, (size_t)-1);
+            if (ctx->DebugAllocInfo.PausedCount == 0)
+                DebugAllocHook(&ctx->DebugAllocInfo, ctx->FrameCount, ptr, (size_t)-1);
 #endif
     return (*GImAllocatorFreeFunc)(ptr, GImAllocatorUserData);
 }
@@ -5332,12 +6148,14 @@ static void SetupDrawListSharedData()
     g.DrawListSharedData.InitialFlags = ImDrawListFlags_None;
     if (g.Style.AntiAliasedLines)
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AntiAliasedLines;
-    if (g.Style.AntiAliasedLinesUseTex && !(g.IO.Fonts->Flags & ImFontAtlasFlags_NoBakedLines))
+    if (g.Style.AntiAliasedLinesUseTex && !(g.IO.Fonts->Flags & (ImFontAtlasFlags_NoBakedLines | ImFontAtlasFlags_SDF)))
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AntiAliasedLinesUseTex;
     if (g.Style.AntiAliasedFill)
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AntiAliasedFill;
     if (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset)
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AllowVtxOffset;
+    if (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasGlyphInstances)
+        g.DrawListSharedData.InitialFlags |= ImDrawListFlags_GlyphInstances;
     g.DrawListSharedData.InitialFringeScale = 1.0f; // FIXME-DPI: Change this for some DPI scaling experiments.
 }
 
@@ -5362,6 +6180,7 @@ void ImGui::NewFrame()
 
     g.Time += g.IO.DeltaTime;
     g.FrameCount += 1;
+    g.TextSizeCache.NewFrame();
     g.TooltipOverrideCount = 0;
     g.WindowsActiveCount = 0;
     g.MenusIdSubmittedThisFrame.resize(0);
@@ -5690,7 +6509,7 @@ static void InitViewportDrawData(ImGuiViewportP* viewport)
 
     draw_data->Valid = true;
     draw_data->CmdListsCount = 0;
-    draw_data->TotalVtxCount = draw_data->TotalIdxCount = 0;
+    draw_data->TotalVtxCount = draw_data->TotalIdxCount = draw_data->TotalGlyphCount = 0;
     draw_data->DisplayPos = viewport->Pos;
     draw_data->DisplaySize = viewport->Size;
     draw_data->FramebufferScale = io.DisplayFramebufferScale;
@@ -5996,6 +6815,24 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
     const float font_size = g.FontSize;
     if (text == text_display_end)
         return ImVec2(0.0f, font_size);
+
+    // Most labels are measured again every frame: hashing the text is cheaper than walking its glyphs.
+    ImGuiTextSizeCache* cache = &g.TextSizeCache;
+    const bool use_cache = cache->Enabled && g.FontBaked != NULL;
+    ImGuiTextSizeCacheEntry key;
+    if (use_cache)
+    {
+        if (text_display_end == NULL)
+            text_display_end = text + ImStrlen(text);
+        key.BakedId = g.FontBaked->BakedId;
+        key.TextLen = (int)(text_display_end - text);
+        key.FontSize = font_size;
+        key.WrapWidth = wrap_width;
+        key.Hash = ImGuiTextSizeCache::HashKey(text, key);
+        if (const ImVec2* cached_size = cache->Find(key, text, g.FrameCount))
+            return *cached_size;
+    }
+
     ImVec2 text_size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_display_end, NULL);
 
     // Round
@@ -6005,9 +6842,158 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
     // - https://embarkstudios.github.io/rust-gpu/api/src/libm/math/ceilf.rs.html
     text_size.x = IM_TRUNC(text_size.x + 0.99999f);
 
+    if (use_cache)
+    {
+        key.Size = text_size;
+        cache->Add(key, text, g.FrameCount);
+    }
     return text_size;
 }
 
+// Labels are short and their measurement is cheap, so this needs to be a lot faster than ImHashData()'s byte-wise CRC32: mix 8 bytes at a time.
+ImU64 ImGuiTextSizeCache::HashKey(const char* text, const ImGuiTextSizeCacheEntry& key)
+{
+    ImU32 font_size_bits, wrap_width_bits;
+    memcpy(&font_size_bits, &key.FontSize, sizeof(ImU32));
+    memcpy(&wrap_width_bits, &key.WrapWidth, sizeof(ImU32));
+    const ImU64 mul = 0x9E3779B97F4A7C15ULL;
+    ImU64 h = (((ImU64)key.BakedId << 32) | (ImU32)key.TextLen) * mul;
+    h = (h ^ (((ImU64)font_size_bits << 32) | wrap_width_bits)) * mul;
+    const char* p = text;
+    const char* p_end = text + key.TextLen;
+    for (; p + 8 <= p_end; p += 8)
+    {
+        ImU64 v;
+        memcpy(&v, p, 8);
+        h = (h ^ v) * mul;
+        h ^= h >> 32;
+    }
+    if (p < p_end)
+    {
+        ImU64 v = 0;
+        memcpy(&v, p, (size_t)(p_end - p));
+        h = (h ^ v) * mul;
+    }
+
+    // Final avalanche (MurmurHash3 fmix64): bytes multiplied into the top bits must reach the low bits used for the slot index
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+const ImVec2* ImGuiTextSizeCache::Find(const ImGuiTextSizeCacheEntry& key, const char* text, int frame_count)
+{
+    if (Entries.Size > 0)
+    {
+        const int mask = Entries.Size - 1;
+        for (int probe_n = 0; probe_n < IM_TEXTSIZECACHE_PROBE_MAX; probe_n++)
+        {
+            ImGuiTextSizeCacheEntry* entry = &Entries.Data[((ImU32)key.Hash + probe_n) & mask];
+            if (entry->Generation != Generation)
+                break;
+            if (entry->Hash == key.Hash && entry->BakedId == key.BakedId && entry->TextLen == key.TextLen && entry->FontSize == key.FontSize && entry->WrapWidth == key.WrapWidth
+                && memcmp(TextBuf.Data + entry->TextOffset, text, (size_t)key.TextLen) == 0)
+            {
+                entry->LastUsedFrame = frame_count;
+                HitsThisFrame++;
+                return &entry->Size;
+            }
+        }
+    }
+    MissesThisFrame++;
+    return NULL;
+}
+
+// Return the first empty slot of the probe window, or else its least recently used entry
+ImGuiTextSizeCacheEntry* ImGuiTextSizeCache::FindSlot(ImU64 hash)
+{
+    const int mask = Entries.Size - 1;
+    ImGuiTextSizeCacheEntry* dst = NULL;
+    for (int probe_n = 0; probe_n < IM_TEXTSIZECACHE_PROBE_MAX; probe_n++)
+    {
+        ImGuiTextSizeCacheEntry* slot = &Entries.Data[((ImU32)hash + probe_n) & mask];
+        if (slot->Generation != Generation)
+            return slot;
+        if (dst == NULL || slot->LastUsedFrame < dst->LastUsedFrame)
+            dst = slot;
+    }
+    return dst;
+}
+
+void ImGuiTextSizeCache::Add(const ImGuiTextSizeCacheEntry& entry, const char* text, int frame_count)
+{
+    if (Entries.Size == 0)
+        Resize(IM_TEXTSIZECACHE_SIZE_MIN);
+
+    // Evicting an entry used this frame on a half full table means the working set doesn't fit: grow instead
+    ImGuiTextSizeCacheEntry* dst = FindSlot(entry.Hash);
+    if (dst->Generation == Generation && dst->LastUsedFrame == frame_count && Count * 2 >= Entries.Size && Entries.Size < IM_TEXTSIZECACHE_SIZE_MAX)
+    {
+        Resize(Entries.Size * 2);
+        dst = FindSlot(entry.Hash);
+    }
+    if (dst->Generation != Generation)
+        Count++;
+    else
+        LiveTextBytes -= dst->TextLen;
+    *dst = entry;
+    dst->Generation = Generation;
+    dst->LastUsedFrame = frame_count;
+
+    // Make room before taking the offset: compacting moves the text of every other entry
+    if (TextBuf.Size + entry.TextLen > IM_TEXTSIZECACHE_TEXTBUF_MIN && TextBuf.Size > LiveTextBytes * 2)
+    {
+        dst->TextLen = 0; // Not live yet
+        CompactTextBuf();
+        dst->TextLen = entry.TextLen;
+    }
+    dst->TextOffset = TextBuf.Size;
+    TextBuf.resize(TextBuf.Size + entry.TextLen);
+    memcpy(TextBuf.Data + dst->TextOffset, text, (size_t)entry.TextLen);
+    LiveTextBytes += entry.TextLen;
+}
+
+void ImGuiTextSizeCache::Resize(int new_size)
+{
+    IM_ASSERT(ImIsPowerOfTwo(new_size));
+    ImVector<ImGuiTextSizeCacheEntry> old_entries;
+    old_entries.swap(Entries);
+    Entries.resize(new_size);
+    memset(Entries.Data, 0, (size_t)Entries.size_in_bytes());
+    Count = LiveTextBytes = 0;
+    for (const ImGuiTextSizeCacheEntry& old_entry : old_entries)
+        if (old_entry.Generation == Generation)
+        {
+            ImGuiTextSizeCacheEntry* dst = FindSlot(old_entry.Hash);
+            if (dst->Generation != Generation) // In the rare case the probe window is already full, the entry is dropped
+            {
+                *dst = old_entry;
+                Count++;
+                LiveTextBytes += old_entry.TextLen;
+            }
+        }
+}
+
+// Move the text of used entries to the front of a new buffer, dropping the text of evicted entries
+void ImGuiTextSizeCache::CompactTextBuf()
+{
+    ImVector<char> old_buf;
+    old_buf.swap(TextBuf);
+    TextBuf.reserve(ImMax(LiveTextBytes * 2, 1024));
+    for (ImGuiTextSizeCacheEntry& entry : Entries)
+        if (entry.Generation == Generation)
+        {
+            const int offset = TextBuf.Size;
+            TextBuf.resize(offset + entry.TextLen);
+            memcpy(TextBuf.Data + offset, old_buf.Data + entry.TextOffset, (size_t)entry.TextLen);
+            entry.TextOffset = offset;
+        }
+    IM_ASSERT(TextBuf.Size == LiveTextBytes);
+}
+
 // Find window given position, search front-to-back
 // - Typically write output back to g.HoveredWindow and g.HoveredWindowUnderMovingWindow.
 // - FIXME: Note that we have an inconsequential lag here: OuterRectClipped is updated in Begin(), so windows moved programmatically
@@ -7180,6 +8166,69 @@ void ImGui::UpdateWindowParentAndRootLinks(ImGuiWindow* window, ImGuiWindowFlags
     }
 }
 
+// [EXPERIMENTAL] Hash what a window contents may depend on besides user data (passed as 'content_hash' to SetNextWindowRefreshPolicy()).
+// Returns true when contents need to be refreshed. Widgets react to mouse/keyboard so we refresh on any input event while
+// the window is hovered or focused, and every frame while one of its items is active (e.g. blinking text cursor).
+// Style is hashed once per frame, unless colors/vars are pushed around Begin(). Modifying g.Style directly between windows is not detected.
+static bool UpdateWindowRefreshInputsHash(ImGuiWindow* window)
+{
+    ImGuiContext& g = *GImGui;
+    const bool hovered = g.HoveredWindow && g.HoveredWindow->RootWindow == window->RootWindow;
+    const bool focused = g.NavWindow && g.NavWindow->RootWindow == window->RootWindow;
+    bool force_refresh = (hovered || focused) && g.InputEventsTrail.Size > 0;
+    force_refresh |= (g.ActiveId != 0 && g.ActiveIdWindow && g.ActiveIdWindow->RootWindow == window->RootWindow);
+
+    ImGuiID style_hash;
+    if (g.ColorStack.Size > 0 || g.StyleVarStack.Size > 0)
+        style_hash = ImHashData(&g.Style, sizeof(g.Style));
+    else if (g.WindowsRefreshStyleHashFrame == g.FrameCount)
+        style_hash = g.WindowsRefreshStyleHash;
+    else
+    {
+        style_hash = g.WindowsRefreshStyleHash = ImHashData(&g.Style, sizeof(g.Style));
+        g.WindowsRefreshStyleHashFrame = g.FrameCount;
+    }
+
+    struct
+    {
+        ImVec2              Pos, SizeFull, Scroll, ScrollTarget, ContentSizeExplicit;
+        ImVec2              DisplaySize, FramebufferScale;
+        ImGuiWindowFlags    Flags;
+        ImGuiItemFlags      ItemFlags;
+        ImFont*             Font;
+        float               FontSize;
+        float               FontWindowScale;
+        int                 FontTexUniqueID;
+        ImGuiID             StyleHash;
+        ImGuiID             ContentHash;
+        bool                Collapsed, WantCollapseToggle, Hovered, Focused;
+    } inputs;
+    memset(&inputs, 0, sizeof(inputs)); // Clear padding
+    inputs.Pos = window->Pos;
+    inputs.SizeFull = window->SizeFull;
+    inputs.Scroll = window->Scroll;
+    inputs.ScrollTarget = window->ScrollTarget;
+    inputs.ContentSizeExplicit = window->ContentSizeExplicit;
+    inputs.DisplaySize = g.IO.DisplaySize;
+    inputs.FramebufferScale = g.IO.DisplayFramebufferScale;
+    inputs.Flags = window->Flags;
+    inputs.ItemFlags = g.CurrentItemFlags;
+    inputs.Font = g.Font;
+    inputs.FontSize = g.FontSize;
+    inputs.FontWindowScale = window->FontWindowScale;
+    inputs.FontTexUniqueID = (g.Font && g.Font->ContainerAtlas->TexData) ? g.Font->ContainerAtlas->TexData->UniqueID : 0; // Atlas repack creates a new texture and moves glyphs
+    inputs.StyleHash = style_hash;
+    inputs.ContentHash = g.NextWindowData.RefreshContentHashVal;
+    inputs.Collapsed = window->Collapsed;
+    inputs.WantCollapseToggle = window->WantCollapseToggle;
+    inputs.Hovered = hovered;
+    inputs.Focused = focused;
+    const ImGuiID inputs_hash = ImHashData(&inputs, sizeof(inputs));
+    const bool inputs_changed = (inputs_hash != window->SkipRefreshInputsHash);
+    window->SkipRefreshInputsHash = inputs_hash;
+    return inputs_changed || force_refresh;
+}
+
 // [EXPERIMENTAL] Called by Begin(). NextWindowData is valid at this point.
 // This is designed as a toy/test-bed for
 void ImGui::UpdateWindowSkipRefresh(ImGuiWindow* window)
@@ -7191,16 +8240,38 @@ void ImGui::UpdateWindowSkipRefresh(ImGuiWindow* window)
     if (g.NextWindowData.RefreshFlagsVal & ImGuiWindowRefreshFlags_TryToAvoidRefresh)
     {
         // FIXME-IDLE: Tests for e.g. mouse clicks or keyboard while focused.
+        bool refresh = false;
         if (window->Appearing) // If currently appearing
-            return;
+            refresh = true;
         if (window->Hidden) // If was hidden (previous frame)
-            return;
+            refresh = true;
         if ((g.NextWindowData.RefreshFlagsVal & ImGuiWindowRefreshFlags_RefreshOnHover) && g.HoveredWindow)
             if (window->RootWindow == g.HoveredWindow->RootWindow || IsWindowWithinBeginStackOf(g.HoveredWindow->RootWindow, window))
-                return;
+                refresh = true;
         if ((g.NextWindowData.RefreshFlagsVal & ImGuiWindowRefreshFlags_RefreshOnFocus) && g.NavWindow)
             if (window->RootWindow == g.NavWindow->RootWindow || IsWindowWithinBeginStackOf(g.NavWindow->RootWindow, window))
-                return;
+                refresh = true;
+        if (g.NextWindowData.RefreshFlagsVal & ImGuiWindowRefreshFlags_RefreshOnInputsChange)
+            if (UpdateWindowRefreshInputsHash(window)) // Always called to keep hash up to date
+                refresh = true;
+        if (window->SkipRefreshDirty)
+            refresh = true;
+        window->SkipRefreshDirty = false;
+
+        // Layout generally needs an extra frame to settle after a change (e.g. tables and auto-fit measure contents then apply sizes)
+        if (refresh)
+            window->SkipRefreshSettleFrames = 1;
+        else if (window->SkipRefreshSettleFrames > 0)
+        {
+            window->SkipRefreshSettleFrames--;
+            refresh = true;
+        }
+        if (refresh)
+        {
+            window->SkipRefreshMisses++;
+            return;
+        }
+        window->SkipRefreshHits++;
         window->DrawList = NULL;
         window->SkipRefresh = true;
     }
@@ -7775,7 +8846,7 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
                 // - We disable this when the parent window has zero vertices, which is a common pattern leading to laying out multiple overlapping childs
                 ImGuiWindow* previous_child = parent_window->DC.ChildWindows.Size >= 2 ? parent_window->DC.ChildWindows[parent_window->DC.ChildWindows.Size - 2] : NULL;
                 bool previous_child_overlapping = previous_child ? previous_child->Rect().Overlaps(window->Rect()) : false;
-                bool parent_is_empty = (parent_window->DrawList->VtxBuffer.Size == 0);
+                bool parent_is_empty = (parent_window->DrawList->VtxBuffer.Size == 0 && parent_window->DrawList->GlyphBuffer.Size == 0);
                 if (window->DrawList->CmdBuffer.back().ElemCount == 0 && !parent_is_empty && !previous_child_overlapping)
                     render_decorations_in_parent = true;
             }
@@ -8495,11 +9566,23 @@ void ImGui::SetNextWindowBgAlpha(float alpha)
 }
 
 // This is experimental and meant to be a toy for exploring a future/wider range of features.
-void ImGui::SetNextWindowRefreshPolicy(ImGuiWindowRefreshFlags flags)
+void ImGui::SetNextWindowRefreshPolicy(ImGuiWindowRefreshFlags flags, ImGuiID content_hash)
 {
     ImGuiContext& g = *GImGui;
     g.NextWindowData.HasFlags |= ImGuiNextWindowDataFlags_HasRefreshPolicy;
     g.NextWindowData.RefreshFlagsVal = flags;
+    g.NextWindowData.RefreshContentHashVal = content_hash;
+}
+
+void ImGui::MarkWindowRefreshDirty(ImGuiWindow* window)
+{
+    window->SkipRefreshDirty = true;
+}
+
+void ImGui::MarkWindowRefreshDirty(const char* name)
+{
+    if (ImGuiWindow* window = FindWindowByName(name))
+        MarkWindowRefreshDirty(window);
 }
 
 ImDrawList* ImGui::GetWindowDrawList()
@@ -16045,6 +17128,12 @@ void ImGui::ShowFontAtlas(ImFontAtlas* atlas)
         SetItemTooltip("Requires #define IMGUI_ENABLE_FREETYPE + imgui_freetype.cpp.");
         EndDisabled();
 #endif
+#if defined(IMGUI_ENABLE_STB_TRUETYPE) && defined(IMGUI_ENABLE_FONT_ASYNC_BAKING)
+        CheckboxFlags("ImFontAtlasFlags_AsyncGlyphBaking", &atlas->Flags, ImFontAtlasFlags_AsyncGlyphBaking);
+        SameLine(); Text("(%d pending)", ImFontAtlasAsyncBakerGetPendingCount(atlas));
+#endif
+        CheckboxFlags("ImFontAtlasFlags_SDF", &atlas->Flags, ImFontAtlasFlags_SDF);
+        SetItemTooltip("Rebuilds the atlas on next frame. Requires renderer support for ImTextureData::UseSDF.");
         EndDisabled();
         TreePop();
     }
@@ -16067,6 +17156,13 @@ void ImGui::ShowFontAtlas(ImFontAtlas* atlas)
     if (Button("Clear All"))
         ImFontAtlasBuildClear(atlas);
     SetItemTooltip("Destroy cache and custom rectangles.");
+    if (atlas->UserImages.Size > 0)
+    {
+        int resident_count = 0;
+        for (ImFontAtlasUserImage* image : atlas->UserImages)
+            resident_count += (image->PackId != ImFontAtlasRectId_Invalid) ? 1 : 0;
+        Text("User images: %d registered, %d in texture (max %dx%d)", atlas->UserImages.Size, resident_count, atlas->UserImagesMaxSize, atlas->UserImagesMaxSize);
+    }
 
     for (int tex_n = 0; tex_n < atlas->TexList.Size; tex_n++)
     {
@@ -16146,7 +17242,7 @@ void ImGui::DebugNodeTexture(ImTextureData* tex, int int_id, const ImFontAtlasRe
         PopStyleVar();
 
         char texid_desc[30];
-        Text("Status = %s (%d), Format = %s (%d), UseColors = %d", ImTextureDataGetStatusName(tex->Status), tex->Status, ImTextureDataGetFormatName(tex->Format), tex->Format, tex->UseColors);
+        Text("Status = %s (%d), Format = %s (%d), UseColors = %d, UseSDF = %d", ImTextureDataGetStatusName(tex->Status), tex->Status, ImTextureDataGetFormatName(tex->Format), tex->Format, tex->UseColors, tex->UseSDF);
         Text("TexID = %s, BackendUserData = %p", FormatTextureRefForDebugDisplay(texid_desc, IM_ARRAYSIZE(texid_desc), tex->GetTexRef()), tex->BackendUserData);
         TreePop();
     }
@@ -16184,6 +17280,21 @@ void ImGui::ShowMetricsWindow(bool* p_open)
     Text("%d visible windows, %d current allocations", io.MetricsRenderWindows, g.DebugAllocInfo.TotalAllocCount - g.DebugAllocInfo.TotalFreeCount);
     //SameLine(); if (SmallButton("GC")) { g.GcCompactAll = true; }
 
+    // Refresh policies (ImGuiWindowRefreshFlags): number of windows which reused their previous contents this frame and overall hit rate
+    {
+        int refresh_windows = 0, refresh_skipped = 0, refresh_hits = 0, refresh_total = 0;
+        for (ImGuiWindow* window : g.Windows)
+            if (window->WasActive && window->SkipRefreshHits + window->SkipRefreshMisses > 0)
+            {
+                refresh_windows++;
+                refresh_skipped += window->SkipRefresh ? 1 : 0;
+                refresh_hits += window->SkipRefreshHits;
+                refresh_total += window->SkipRefreshHits + window->SkipRefreshMisses;
+            }
+        if (refresh_windows > 0)
+            Text("%d/%d windows with refresh policy reused contents, %.1f%% hit rate", refresh_skipped, refresh_windows, refresh_hits * 100.0f / refresh_total);
+    }
+
     Separator();
 
     // Debugging enums
@@ -16522,6 +17633,21 @@ void ImGui::ShowMetricsWindow(bool* p_open)
         TreePop();
     }
 
+    // Text size cache
+    if (TreeNode("TextSizeCache", "Text size cache (%d/%d entries)", g.TextSizeCache.Count, g.TextSizeCache.Entries.Size))
+    {
+        ImGuiTextSizeCache* cache = &g.TextSizeCache;
+        Checkbox("Enabled", &cache->Enabled);
+        SameLine();
+        if (SmallButton("Clear"))
+            cache->Clear();
+        const int lookups = cache->HitsLastFrame + cache->MissesLastFrame;
+        Text("Last frame: %d lookups, %d hits, %d misses (%.1f%% hit rate)", lookups, cache->HitsLastFrame, cache->MissesLastFrame, lookups > 0 ? cache->HitsLastFrame * 100.0f / lookups : 0.0f);
+        Text("Invalidated %d times (font atlas changes)", cache->InvalidateCount);
+        Text("Text copies: %d bytes used, %d live", cache->TextBuf.Size, cache->LiveTextBytes);
+        TreePop();
+    }
+
     // Settings
     if (TreeNode("Memory allocations"))
     {
@@ -16818,7 +17944,7 @@ void ImGui::DebugNodeDrawList(ImGuiWindow* window, ImGuiViewportP* viewport, con
     IM_UNUSED(viewport); // Used in docking branch
     ImGuiMetricsConfig* cfg = &g.DebugMetricsConfig;
     int cmd_count = draw_list->CmdBuffer.Size;
-    if (cmd_count > 0 && draw_list->CmdBuffer.back().ElemCount == 0 && draw_list->CmdBuffer.back().UserCallback == NULL)
+    if (cmd_count > 0 && draw_list->CmdBuffer.back().ElemCount == 0 && draw_list->CmdBuffer.back().GlyphCount == 0 && draw_list->CmdBuffer.back().UserCallback == NULL)
         cmd_count--;
     bool node_open = TreeNode(draw_list, "%s: '%s' %d vtx, %d indices, %d cmds", label, draw_list->_OwnerName ? draw_list->_OwnerName : "", draw_list->VtxBuffer.Size, draw_list->IdxBuffer.Size, cmd_count);
     if (draw_list == GetWindowDrawList())
@@ -16850,8 +17976,10 @@ void ImGui::DebugNodeDrawList(ImGuiWindow* window, ImGuiViewportP* viewport, con
         char texid_desc[30];
         FormatTextureRefForDebugDisplay(texid_desc, IM_ARRAYSIZE(texid_desc), pcmd->TexRef);
         char buf[300];
-        ImFormatString(buf, IM_ARRAYSIZE(buf), "DrawCmd:%5d tris, Tex %s, ClipRect (%4.0f,%4.0f)-(%4.0f,%4.0f)",
+        int buf_len = ImFormatString(buf, IM_ARRAYSIZE(buf), "DrawCmd:%5d tris, Tex %s, ClipRect (%4.0f,%4.0f)-(%4.0f,%4.0f)",
             pcmd->ElemCount / 3, texid_desc, pcmd->ClipRect.x, pcmd->ClipRect.y, pcmd->ClipRect.z, pcmd->ClipRect.w);
+        if (pcmd->GlyphCount > 0)
+            ImFormatString(buf + buf_len, IM_ARRAYSIZE(buf) - buf_len, ", %d glyphs", pcmd->GlyphCount);
         bool pcmd_node_open = TreeNode((void*)(pcmd - draw_list->CmdBuffer.begin()), "%s", buf);
         if (IsItemHovered() && (cfg->ShowDrawCmdMesh || cfg->ShowDrawCmdBoundingBoxes) && fg_draw_list)
             DebugNodeDrawCmdShowMeshAndBoundingBox(fg_draw_list, draw_list, pcmd, cfg->ShowDrawCmdMesh, cfg->ShowDrawCmdBoundingBoxes);
@@ -16888,9 +18016,10 @@ void ImGui::DebugNodeDrawList(ImGuiWindow* window, ImGuiViewportP* viewport, con
                 for (int n = 0; n < 3; n++, idx_i++)
                 {
                     const ImDrawVert& v = vtx_buffer[idx_buffer ? idx_buffer[idx_i] : idx_i];
+                    const ImVec2 uv = v.uv;
                     triangle[n] = v.pos;
                     buf_p += ImFormatString(buf_p, buf_end - buf_p, "%s %04d: pos (%8.2f,%8.2f), uv (%.6f,%.6f), col %08X\n",
-                        (n == 0) ? "Vert:" : "     ", idx_i, v.pos.x, v.pos.y, v.uv.x, v.uv.y, v.col);
+                        (n == 0) ? "Vert:" : "     ", idx_i, triangle[n].x, triangle[n].y, uv.x, uv.y, v.col);
                 }
 
                 Selectable(buf, false);
@@ -17172,7 +18301,7 @@ void ImGui::DebugNodeFontGlyph(ImFont* font, const ImFontGlyph* glyph)
 // [DEBUG] Display contents of ImGuiStorage
 void ImGui::DebugNodeStorage(ImGuiStorage* storage, const char* label)
 {
-    if (!TreeNode(label, "%s: %d entries, %d bytes", label, storage->Data.Size, storage->Data.size_in_bytes()))
+    if (!TreeNode(label, "%s: %d entries, %d bytes%s", label, storage->Data.Size, storage->Data.size_in_bytes() + storage->HashIndex.size_in_bytes(), storage->HashIndex.Size > 0 ? " (hashed)" : ""))
         return;
     for (const ImGuiStoragePair& p : storage->Data)
     {
@@ -17287,6 +18416,8 @@ void ImGui::DebugNodeWindow(ImGuiWindow* window, const char* label)
     BulletText("Scroll: (%.2f/%.2f,%.2f/%.2f) Scrollbar:%s%s", window->Scroll.x, window->ScrollMax.x, window->Scroll.y, window->ScrollMax.y, window->ScrollbarX ? "X" : "", window->ScrollbarY ? "Y" : "");
     BulletText("Active: %d/%d, WriteAccessed: %d, BeginOrderWithinContext: %d", window->Active, window->WasActive, window->WriteAccessed, (window->Active || window->WasActive) ? window->BeginOrderWithinContext : -1);
     BulletText("Appearing: %d, Hidden: %d (CanSkip %d Cannot %d), SkipItems: %d", window->Appearing, window->Hidden, window->HiddenFramesCanSkipItems, window->HiddenFramesCannotSkipItems, window->SkipItems);
+    if (window->SkipRefreshHits + window->SkipRefreshMisses > 0)
+        BulletText("SkipRefresh: %d, hits: %d, misses: %d (%.1f%% hit rate)", window->SkipRefresh, window->SkipRefreshHits, window->SkipRefreshMisses, window->SkipRefreshHits * 100.0f / (window->SkipRefreshHits + window->SkipRefreshMisses));
     for (int layer = 0; layer < ImGuiNavLayer_COUNT; layer++)
     {
         ImRect r = window->NavRectRel[layer];
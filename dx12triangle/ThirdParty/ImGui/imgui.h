@@ -48,7 +48,7 @@ Index of this file:
 // [SECTION] Misc data structures (ImGuiInputTextCallbackData, ImGuiSizeCallbackData, ImGuiPayload)
 // [SECTION] Helpers (ImGuiOnceUponAFrame, ImGuiTextFilter, ImGuiTextBuffer, ImGuiStorage, ImGuiListClipper, Math Operators, ImColor)
 // [SECTION] Multi-Select API flags and structures (ImGuiMultiSelectFlags, ImGuiMultiSelectIO, ImGuiSelectionRequest, ImGuiSelectionBasicStorage, ImGuiSelectionExternalStorage)
-// [SECTION] Drawing API (ImDrawCallback, ImDrawCmd, ImDrawIdx, ImDrawVert, ImDrawChannel, ImDrawListSplitter, ImDrawFlags, ImDrawListFlags, ImDrawList, ImDrawData)
+// [SECTION] Drawing API (ImDrawCallback, ImDrawCmd, ImDrawIdx, ImDrawVert, ImDrawChannel, ImDrawListSplitter, ImDrawListWorkers, ImDrawFlags, ImDrawListFlags, ImDrawList, ImDrawData)
 // [SECTION] Texture API (ImTextureFormat, ImTextureStatus, ImTextureRect, ImTextureData)
 // [SECTION] Font API (ImFontConfig, ImFontGlyph, ImFontGlyphRangesBuilder, ImFontAtlasFlags, ImFontAtlas, ImFontBaked, ImFont)
 // [SECTION] Viewports (ImGuiViewportFlags, ImGuiViewport)
@@ -167,14 +167,18 @@ typedef unsigned long long  ImU64;  // 64-bit unsigned integer
 struct ImDrawChannel;               // Temporary storage to output draw commands out of order, used by ImDrawListSplitter and ImDrawList::ChannelsSplit()
 struct ImDrawCmd;                   // A single draw command within a parent ImDrawList (generally maps to 1 GPU draw call, unless it is a callback)
 struct ImDrawData;                  // All draw command lists required to render the frame + pos/size coordinates to use for the projection matrix.
+struct ImDrawGlyph;                 // A glyph instance (pen position + glyph rectangle index + color = 16 bytes), emitted instead of a quad when the renderer expands glyphs on the GPU
+struct ImDrawGlyphRect;             // Quad offsets and UV coordinates of a glyph, indexed by ImDrawGlyph::GlyphId in ImTextureData::GlyphRects[]
 struct ImDrawList;                  // A single draw command list (generally one per window, conceptually you may see this as a dynamic "mesh" builder)
 struct ImDrawListSharedData;        // Data shared among multiple draw lists (typically owned by parent ImGui context, but you may create one yourself)
 struct ImDrawListSplitter;          // Helper to split a draw list into different layers which can be drawn into out of order, then flattened back.
-struct ImDrawVert;                  // A single vertex (pos + uv + col = 20 bytes by default. Override layout with IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+struct ImDrawListWorkers;           // Helper to fill draw lists from worker threads, then append them to a draw list in a deterministic order.
+struct ImDrawVert;                  // A single vertex (pos + uv + col = 20 bytes by default, 12 bytes with IMGUI_USE_COMPACT_DRAWVERT. Override layout with IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
 struct ImFont;                      // Runtime data for a single font within a parent ImFontAtlas
 struct ImFontAtlas;                 // Runtime data for multiple fonts, bake multiple fonts into a single texture, TTF/OTF font loader
 struct ImFontAtlasBuilder;          // Opaque storage for building a ImFontAtlas
 struct ImFontAtlasRect;             // Output of ImFontAtlas::GetCustomRect() when using custom rectangles.
+struct ImFontAtlasUserImage;        // Opaque storage for an image registered with ImFontAtlas::AddUserImage()
 struct ImFontBaked;                 // Baked data for a ImFont at a given size.
 struct ImFontConfig;                // Configuration data when adding a font or merging fonts
 struct ImFontGlyph;                 // A single font glyph (code point + coordinates within in ImFontAtlas + offset)
@@ -190,6 +194,7 @@ struct ImGuiIO;                     // Main configuration and I/O between your a
 struct ImGuiInputTextCallbackData;  // Shared state of InputText() when using custom ImGuiInputTextCallback (rare/advanced use)
 struct ImGuiKeyData;                // Storage for ImGuiIO and IsKeyDown(), IsKeyPressed() etc functions.
 struct ImGuiListClipper;            // Helper to manually clip large list of items
+struct ImGuiListClipperHeights;     // Helper to store heights of variable height items for ImGuiListClipper
 struct ImGuiMultiSelectIO;          // Structure to interact with a BeginMultiSelect()/EndMultiSelect() block
 struct ImGuiOnceUponAFrame;         // Helper for running a block of code not more than once a frame
 struct ImGuiPayload;                // User data payload for drag and drop operations
@@ -205,6 +210,7 @@ struct ImGuiStyle;                  // Runtime data for styling/colors
 struct ImGuiTableSortSpecs;         // Sorting specifications for a table (often handling sort specs for a single column, occasionally more)
 struct ImGuiTableColumnSortSpecs;   // Sorting specification for one column of a table
 struct ImGuiTextBuffer;             // Helper to hold and append into a text buffer (~string builder)
+struct ImGuiTextChunkedBuffer;      // Helper to append into a large text buffer stored in chunks, with a line index (~log)
 struct ImGuiTextFilter;             // Helper to parse and apply text filters (e.g. "aaaaa[,bbbbb][,ccccc]")
 struct ImGuiViewport;               // A Platform Window (always only one in 'master' branch), in the future may represent Platform Monitor
 
@@ -280,6 +286,7 @@ typedef ImS64 ImGuiSelectionUserData;
 // Callback and functions types
 typedef int     (*ImGuiInputTextCallback)(ImGuiInputTextCallbackData* data);    // Callback function for ImGui::InputText()
 typedef void    (*ImGuiSizeCallback)(ImGuiSizeCallbackData* data);              // Callback function for ImGui::SetNextWindowSizeConstraints()
+typedef float   (*ImGuiListClipperHeightCallback)(int item_index, void* user_data); // Callback function for ImGuiListClipperHeights: initial height estimate of an item
 typedef void*   (*ImGuiMemAllocFunc)(size_t sz, void* user_data);               // Function signature for ImGui::SetAllocatorFunctions()
 typedef void    (*ImGuiMemFreeFunc)(void* ptr, void* user_data);                // Function signature for ImGui::SetAllocatorFunctions()
 
@@ -1704,6 +1711,7 @@ enum ImGuiBackendFlags_
     ImGuiBackendFlags_HasSetMousePos        = 1 << 2,   // Backend Platform supports io.WantSetMousePos requests to reposition the OS mouse position (only used if io.ConfigNavMoveSetMousePos is set).
     ImGuiBackendFlags_RendererHasVtxOffset  = 1 << 3,   // Backend Renderer supports ImDrawCmd::VtxOffset. This enables output of large meshes (64K+ vertices) while still using 16-bit indices.
     ImGuiBackendFlags_RendererHasTextures   = 1 << 4,   // Backend Renderer supports ImTextureData requests to create/update/destroy textures. This enables incremental texture updates and texture reloads. See https://github.com/ocornut/imgui/blob/master/docs/BACKENDS.md for instructions on how to upgrade your custom backend.
+    ImGuiBackendFlags_RendererHasGlyphInstances = 1 << 5, // [EXPERIMENTAL] Backend Renderer supports ImDrawCmd::GlyphOffset/GlyphCount: text may be output as ImDrawGlyph instances (16 bytes per glyph instead of 4 vertices + 6 indices), to be expanded using ImTextureData::GlyphRects[].
 };
 
 // Enumeration for PushStyleColor() / PopStyleColor()
@@ -2683,11 +2691,20 @@ struct ImGuiOnceUponAFrame
 };
 
 // Helper: Parse and apply text filters. In format "aaaaa[,bbbb][,ccccc]"
+// - Build() compiles the filter (upper-cased needles, skip tables), matching uses SIMD scanning when available.
+// - PassFilterLines() filters many lines of a single buffer at once into a bitmap, e.g. for a log using ImGuiListClipper over the result:
+//     ImVector<ImU32> pass_bits; pass_bits.resize((lines_count + 31) / 32);
+//     filter.PassFilterLines(buf, buf_end, line_offsets, lines_count, pass_bits.Data);
+//     (line n spans [buf + line_offsets[n], buf + line_offsets[n + 1] - 1), the last line ends at buf_end)
+//   It is const and doesn't allocate: you may split very large sets over your own worker threads, using ranges aligned on multiples of 32 lines.
+// - When Build() sets RefinesPrevious, lines which failed the previous filter will also fail the new one: pass 'refine = true'
+//   to only re-test lines whose bit is set (e.g. typing at the end of a single search term doesn't re-scan the whole log).
 struct ImGuiTextFilter
 {
     IMGUI_API           ImGuiTextFilter(const char* default_filter = "");
     IMGUI_API bool      Draw(const char* label = "Filter (inc,-exc)", float width = 0.0f);  // Helper calling InputText+Build
     IMGUI_API bool      PassFilter(const char* text, const char* text_end = NULL) const;
+    IMGUI_API int       PassFilterLines(const char* buf, const char* buf_end, const int* line_offsets, int lines_count, ImU32* out_pass_bits, int line_begin = 0, int line_end = -1, bool refine = false) const; // Set/clear bit n of out_pass_bits[] for lines [line_begin, line_end). Return number of lines passing.
     IMGUI_API void      Build();
     void                Clear()          { InputBuf[0] = 0; Build(); }
     bool                IsActive() const { return !Filters.empty(); }
@@ -2704,8 +2721,11 @@ struct ImGuiTextFilter
         IMGUI_API void  split(char separator, ImVector<ImGuiTextRange>* out) const;
     };
     char                    InputBuf[256];
+    char                    InputBufUpper[256];     // Upper-case copy of InputBuf, filters are matched against it (same offsets)
     ImVector<ImGuiTextRange>Filters;
+    ImVector<ImU8>          FiltersSkip;            // Case-insensitive skip table (256 entries) for each filter, when SIMD scanning is not available
     int                     CountGrep;
+    bool                    RefinesPrevious;        // Set by Build(): any text passing the filter also passed the previous one
 };
 
 // Helper: Growable text buffer for logging/accumulating text
@@ -2730,6 +2750,64 @@ struct ImGuiTextBuffer
     IMGUI_API void      appendfv(const char* fmt, va_list args) IM_FMTLIST(2);
 };
 
+// Helper: Append-only text buffer stored in a list of fixed-size chunks, with a line index, for large logs [EXPERIMENTAL]
+// - Appending never reallocates nor copies previous text, unlike ImGuiTextBuffer which doubles its capacity and copies its contents.
+// - A line never spans two chunks, so each line can be passed to TextUnformatted(). When the line being appended to doesn't fit in
+//   the current chunk, it is moved to a new chunk (only that line is copied). A line larger than ChunkSize gets a chunk of its own.
+// - Pointers into complete lines (ended by '\n') stay valid until their chunk is dropped or the buffer is cleared.
+// - Set MaxSize to use as a ring buffer: the oldest chunks are dropped when the total size exceeds it. Line numbers are relative to the
+//   oldest line still stored: LinesDropped is the number of lines dropped since the last clear(), use it to track lines across drops.
+// - Dropped chunks are recycled for new ones, so a capped buffer stops allocating once it is full.
+// Usage:
+//   buf.appendf("[%05d] Hello %s\n", frame, name);
+//   ImGuiListClipper clipper;
+//   clipper.Begin(buf.lines_count());
+//   while (clipper.Step())
+//       for (ImGuiTextChunkedBuffer::Cursor c = buf.seek_line(clipper.DisplayStart); c.LineNo < clipper.DisplayEnd; buf.next_line(&c))
+//           ImGui::TextUnformatted(c.LineBegin, c.LineEnd);
+struct ImGuiTextChunkedBuffer
+{
+    struct Chunk
+    {
+        char*           Data;
+        int             Size;                   // Bytes used
+        int             Capacity;               // ChunkSize, or more for a chunk holding a line larger than ChunkSize
+        int             LineFirst;              // Number of the first line stored in this chunk, counting dropped lines
+        ImVector<int>   LineOffsets;            // Offset of each line stored in this chunk
+    };
+    struct Cursor
+    {
+        int             LineNo;                 // Line number, == lines_count() past the last line
+        int             ChunkNo;
+        const char*     LineBegin;
+        const char*     LineEnd;                // Excluding the '\n'
+    };
+    ImVector<Chunk>     Chunks;                 // Oldest first
+    ImVector<Chunk>     FreeChunks;             // Arena: dropped chunks of ChunkSize bytes, reused (with their line index storage) before allocating new ones
+    int                 LinesDropped;           // Number of lines dropped from the front since the last clear()
+    int                 ChunkSize;
+    size_t              MaxSize;                // Ring buffer cap in bytes, 0 for unlimited. The chunk being appended to is never dropped.
+    size_t              TotalSize;
+
+    ImGuiTextChunkedBuffer(int chunk_size = 64 * 1024, size_t max_size = 0) { IM_ASSERT(chunk_size > 0); LinesDropped = 0; ChunkSize = chunk_size; MaxSize = max_size; TotalSize = 0; }
+    ~ImGuiTextChunkedBuffer()                   { clear(); }
+    ImGuiTextChunkedBuffer(const ImGuiTextChunkedBuffer&) = delete;
+    ImGuiTextChunkedBuffer& operator=(const ImGuiTextChunkedBuffer&) = delete;
+    size_t              size() const            { return TotalSize; }
+    bool                empty() const           { return TotalSize == 0; }
+    int                 lines_count() const     { return Chunks.Size ? Chunks.back().LineFirst + Chunks.back().LineOffsets.Size - LinesDropped : 0; }
+    IMGUI_API void      clear();
+    IMGUI_API void      append(const char* str, const char* str_end = NULL);
+    IMGUI_API void      appendf(const char* fmt, ...) IM_FMTARGS(2);
+    IMGUI_API void      appendfv(const char* fmt, va_list args) IM_FMTLIST(2);
+
+    // Line access. seek_line() finds the chunk with a binary search, next_line() is O(1): prefer it to iterate consecutive lines.
+    IMGUI_API Cursor    seek_line(int line_no) const;
+    IMGUI_API void      next_line(Cursor* cursor) const;
+    const char*         get_line_begin(int n) const { return seek_line(n).LineBegin; }
+    const char*         get_line_end(int n) const   { return seek_line(n).LineEnd; }
+};
+
 // [Internal] Key+Value for ImGuiStorage
 struct ImGuiStoragePair
 {
@@ -2751,12 +2829,17 @@ struct ImGuiStoragePair
 struct ImGuiStorage
 {
     // [Internal]
-    ImVector<ImGuiStoragePair>      Data;
+    ImVector<ImGuiStoragePair>      Data;           // Sorted by key. Once HashIndex is used: in insertion order, until BuildSortByKey() is called.
+    ImVector<int>                   HashIndex;      // Open addressing table of indices into Data (-1 = empty slot), at most half full. Empty until Data.Size reaches HashThreshold.
+    int                             HashThreshold;  // 0 = never use HashIndex (default). >0 = build HashIndex once Data.Size reaches this value (1 = always). Windows' StateStorage uses IMGUI_WINDOW_STORAGE_HASH_THRESHOLD.
+
+    ImGuiStorage()      { HashThreshold = 0; }
 
-    // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N)
+    // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N), O(1) with HashIndex.
     // - Set***() functions find pair, insertion on demand if missing.
-    // - Sorted insertion is costly, paid once. A typical frame shouldn't need to insert any new pair.
-    void                Clear() { Data.clear(); }
+    // - Sorted insertion is costly (O(N)), paid once. A typical frame shouldn't need to insert any new pair.
+    //   Storages expected to grow large (e.g. open state of 100k+ tree nodes during an expand-all) should set HashThreshold: insertion becomes O(1).
+    void                Clear() { Data.clear(); HashIndex.clear(); }
     IMGUI_API int       GetInt(ImGuiID key, int default_val = 0) const;
     IMGUI_API void      SetInt(ImGuiID key, int val);
     IMGUI_API bool      GetBool(ImGuiID key, bool default_val = false) const;
@@ -2776,6 +2859,7 @@ struct ImGuiStorage
     IMGUI_API void**    GetVoidPtrRef(ImGuiID key, void* default_val = NULL);
 
     // Advanced: for quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
+    // Also rebuilds HashIndex, so call it after modifying Data directly. Afterwards Data is sorted by key, e.g. to iterate it in order.
     IMGUI_API void      BuildSortByKey();
     // Obsolete: use on your own storage if you know only integer are being stored (open/close all tree nodes)
     IMGUI_API void      SetAllInt(int val);
@@ -2792,6 +2876,38 @@ enum ImGuiListClipperFlags_
     ImGuiListClipperFlags_NoSetTableRowCounters = 1 << 0,   // [Internal] Disabled modifying table row counters. Avoid assumption that 1 clipper item == 1 table row.
 };
 
+// Helper: Heights of variable height items, for ImGuiListClipper::BeginVariableHeight() [EXPERIMENTAL]
+// - Keep it alongside your items: it needs to persist across frames. Call Clear() if your items all change (e.g. a new data set).
+// - Items which were never displayed use an estimate: ItemHeightCallback() if set, otherwise DefaultHeight (0.0f: GetTextLineHeightWithSpacing()).
+// - Every item displayed by the clipper is measured and its height updated, so estimates are replaced as the list is scrolled.
+//   When estimates are poor, measuring items above the view may shift the view: provide ItemHeightCallback() if you can calculate heights cheaply.
+// - Heights are summed in a Fenwick tree over blocks of items, so updating a height and converting between scroll position and item index are O(log N).
+// Usage:
+//   static ImGuiListClipperHeights heights;
+//   ImGuiListClipper clipper;
+//   clipper.BeginVariableHeight(entries.Size, &heights);
+//   while (clipper.Step())
+//       for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+//           ImGui::TextUnformatted(entries[i]);     // May span multiple lines
+struct ImGuiListClipperHeights
+{
+    float                           DefaultHeight;              // Estimate for items never displayed, including item spacing. 0.0f = GetTextLineHeightWithSpacing() at the time items are added.
+    ImGuiListClipperHeightCallback  ItemHeightCallback;         // Optional: estimate for items never displayed, called once per item when it gets added.
+    void*                           ItemHeightCallbackUserData;
+    ImVector<float>                 Heights;                    // [Internal] Height of each item, including item spacing
+    ImVector<double>                BlockTree;                  // [Internal] Fenwick tree over the sum of heights of each block of IMGUI_LISTCLIPPER_HEIGHTS_BLOCK_SIZE items
+
+    ImGuiListClipperHeights()       { memset(this, 0, sizeof(*this)); }
+    void            Clear()         { Heights.clear(); BlockTree.clear(); }
+    int             GetItemsCount() const                       { return Heights.Size; }
+    float           GetItemHeight(int item_index) const         { return Heights[item_index]; }
+    double          GetTotalHeight() const                      { return GetItemOffset(Heights.Size); }
+    IMGUI_API void  Resize(int items_count, float default_height); // Called by BeginVariableHeight(). Added items get their estimated height, removed items are discarded.
+    IMGUI_API void  SetItemHeight(int item_index, float height); // O(log N). Called by the clipper for each displayed item.
+    IMGUI_API double GetItemOffset(int item_index) const;       // Sum of heights of items before 'item_index'. O(log N).
+    IMGUI_API int   FindItemAtOffset(double offset) const;      // Item which covers 'offset' from the top of the list, clamped to [0, items_count - 1]. O(log N).
+};
+
 // Helper: Manually clip large list of items.
 // If you have lots evenly spaced items and you have random access to the list, you can perform coarse
 // clipping based on visibility to only submit items that are in view.
@@ -2822,6 +2938,7 @@ struct ImGuiListClipper
     double          StartPosY;          // [Internal] Cursor position at the time of Begin() or after table frozen rows are all processed
     double          StartSeekOffsetY;   // [Internal] Account for frozen rows in a table and initial loss of precision in very large windows.
     void*           TempData;           // [Internal] Internal data
+    ImGuiListClipperHeights* Heights;   // [Internal] Heights of items when using BeginVariableHeight(), otherwise NULL.
     ImGuiListClipperFlags Flags;        // [Internal] Flags, currently not yet well exposed.
 
     // items_count: Use INT_MAX if you don't know how many items you have (in which case the cursor won't be advanced in the final step, and you can call SeekCursorForItem() manually if you need)
@@ -2829,6 +2946,7 @@ struct ImGuiListClipper
     IMGUI_API ImGuiListClipper();
     IMGUI_API ~ImGuiListClipper();
     IMGUI_API void  Begin(int items_count, float items_height = -1.0f);
+    IMGUI_API void  BeginVariableHeight(int items_count, ImGuiListClipperHeights* heights); // [EXPERIMENTAL] Items of varying heights, see ImGuiListClipperHeights. Visible items are stepped one at a time (DisplayEnd == DisplayStart + 1) so each can be measured.
     IMGUI_API void  End();             // Automatically called on the last call of Step() that returns false.
     IMGUI_API bool  Step();            // Call until it returns false. The DisplayStart/DisplayEnd fields will be set and you can process/draw those items.
 
@@ -3116,6 +3234,9 @@ typedef void (*ImDrawCallback)(const ImDrawList* parent_list, const ImDrawCmd* c
 // - VtxOffset: When 'io.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset' is enabled,
 //   this fields allow us to render meshes larger than 64K vertices while keeping 16-bit indices.
 //   Backends made for <1.71. will typically ignore the VtxOffset fields.
+// - GlyphOffset/GlyphCount: When 'io.BackendFlags & ImGuiBackendFlags_RendererHasGlyphInstances' is enabled, a command may also draw
+//   glyph instances from the parent ImDrawList::GlyphBuffer[]. Render them AFTER the ElemCount indices, as quads using the same clipping
+//   rectangle and texture. Commands with ElemCount == 0 and GlyphCount > 0 are not empty.
 // - The ClipRect/TexRef/VtxOffset fields must be contiguous as we memcmp() them together (this is asserted for).
 struct ImDrawCmd
 {
@@ -3128,6 +3249,8 @@ struct ImDrawCmd
     void*           UserCallbackData;   // 4-8  // Callback user data (when UserCallback != NULL). If called AddCallback() with size == 0, this is a copy of the AddCallback() argument. If called AddCallback() with size > 0, this is pointing to a buffer where data is stored.
     int             UserCallbackDataSize;  // 4 // Size of callback user data when using storage, otherwise 0.
     int             UserCallbackDataOffset;// 4 // [Internal] Offset of callback user data when using storage, otherwise -1.
+    unsigned int    GlyphOffset;        // 4    // Start offset in glyph buffer. ImGuiBackendFlags_RendererHasGlyphInstances only.
+    unsigned int    GlyphCount;         // 4    // Number of ImDrawGlyph instances to be rendered after the triangles. ImGuiBackendFlags_RendererHasGlyphInstances only, otherwise always 0.
 
     ImDrawCmd()     { memset(this, 0, sizeof(*this)); } // Also ensure our padding fields are zeroed
 
@@ -3136,6 +3259,32 @@ struct ImDrawCmd
     inline ImTextureID GetTexID() const;    // == (TexRef._TexData ? TexRef._TexData->TexID : TexRef._TexID
 };
 
+// Compact vertex layout (12 bytes instead of 20), enabled by '#define IMGUI_USE_COMPACT_DRAWVERT' in imconfig.h
+// Fields convert from/to ImVec2 so ImDrawList code can write 'vtx.pos = ImVec2(...)' and read 'ImVec2 pos = vtx.pos' with either layout.
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+#ifdef IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT
+#error "IMGUI_USE_COMPACT_DRAWVERT defines IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT, don't define both."
+#endif
+#ifndef IMGUI_DRAWVERT_POS_SUBPIXEL_BITS
+#define IMGUI_DRAWVERT_POS_SUBPIXEL_BITS    3       // 1/8 pixel steps, coordinates within -4096..+4096
+#endif
+struct ImDrawVertPos16
+{
+    ImS16   X, Y;           // Fixed point with IMGUI_DRAWVERT_POS_SUBPIXEL_BITS fractional bits, rounded to nearest and saturated
+    ImDrawVertPos16&        operator=(const ImVec2& v)  { X = Pack(v.x); Y = Pack(v.y); return *this; }
+    operator                ImVec2() const              { return ImVec2(X * (1.0f / (1 << IMGUI_DRAWVERT_POS_SUBPIXEL_BITS)), Y * (1.0f / (1 << IMGUI_DRAWVERT_POS_SUBPIXEL_BITS))); }
+    static inline ImS16     Pack(float v)               { v = v * (float)(1 << IMGUI_DRAWVERT_POS_SUBPIXEL_BITS) + 0.5f; v = (v < -32768.0f) ? -32768.0f : v; v = (v > 32767.0f) ? 32767.0f : v; int i = (int)v; return (ImS16)(i - (v < (float)i)); } // floor(v + 0.5f) without branches
+};
+struct ImDrawVertUV16
+{
+    ImU16   U, V;           // Normalized: 0..65535 maps to 0.0f..1.0f, rounded to nearest and saturated
+    ImDrawVertUV16&         operator=(const ImVec2& v)  { U = Pack(v.x); V = Pack(v.y); return *this; }
+    operator                ImVec2() const              { return ImVec2(U * (1.0f / 65535.0f), V * (1.0f / 65535.0f)); }
+    static inline ImU16     Pack(float v)               { v = v * 65535.0f + 0.5f; v = (v < 0.0f) ? 0.0f : v; v = (v > 65535.0f) ? 65535.0f : v; return (ImU16)(int)v; }
+};
+#define IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT struct ImDrawVert { ImDrawVertPos16 pos; ImDrawVertUV16 uv; ImU32 col; }
+#endif
+
 // Vertex layout
 #ifndef IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT
 struct ImDrawVert
@@ -3147,11 +3296,29 @@ struct ImDrawVert
 #else
 // You can override the vertex format layout by defining IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT in imconfig.h
 // The code expect ImVec2 pos (8 bytes), ImVec2 uv (8 bytes), ImU32 col (4 bytes), but you can re-order them or add other fields as needed to simplify integration in your engine.
+// ('pos' and 'uv' may also be types assignable from and convertible to ImVec2, as done by IMGUI_USE_COMPACT_DRAWVERT.)
 // The type has to be described within the macro (you can either declare the struct or use a typedef). This is because ImVec2/ImU32 are likely not declared at the time you'd want to set your type up.
 // NOTE: IMGUI DOESN'T CLEAR THE STRUCTURE AND DOESN'T CALL A CONSTRUCTOR SO ANY CUSTOM FIELD WILL BE UNINITIALIZED. IF YOU ADD EXTRA FIELDS (SUCH AS A 'Z' COORDINATES) YOU WILL NEED TO CLEAR THEM DURING RENDER OR TO IGNORE THEM.
 IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT;
 #endif
 
+// [EXPERIMENTAL] Glyph instance, written by ImFont::RenderText() instead of a quad when ImDrawListFlags_GlyphInstances is set.
+// The renderer expands it into the same quad as ImDrawList::PrimRectUV(ImVec2(X + r.X0, Y + r.Y0), ImVec2(X + r.X1, Y + r.Y1), ImVec2(r.U0, r.V0), ImVec2(r.U1, r.V1), Col)
+// where r = ImDrawCmd::TexRef._TexData->GlyphRects[GlyphId]. See ImGuiBackendFlags_RendererHasGlyphInstances.
+struct ImDrawGlyph
+{
+    float   X, Y;       // Pen position (top-left of the line, as passed to RenderText())
+    ImU32   GlyphId;    // Index in ImTextureData::GlyphRects[]
+    ImU32   Col;
+};
+
+// [EXPERIMENTAL] Glyph quad offsets from the pen position (in pixels) and texture coordinates, see ImDrawGlyph.
+struct ImDrawGlyphRect
+{
+    float   X0, Y0, X1, Y1;
+    float   U0, V0, U1, V1;
+};
+
 // [Internal] For use by ImDrawList
 struct ImDrawCmdHeader
 {
@@ -3165,15 +3332,31 @@ struct ImDrawChannel
 {
     ImVector<ImDrawCmd>         _CmdBuffer;
     ImVector<ImDrawIdx>         _IdxBuffer;
+    int                         _IdxStart;      // In-place mode: start of the range reserved for this channel in the parent ImDrawList::IdxBuffer
+    int                         _IdxEnd;        // In-place mode: end of the range reserved for this channel
+    int                         _IdxCount;      // In-place mode: number of indices written in the range (updated when switching away from the channel)
+    int                         _IdxPeak;       // In-place mode: highest index count requested by a PrimReserve() in this channel, if it outgrew its range
+    int                         _SplitIndex;    // Channel index at the time of Split(), as channels may be reordered before Merge() (e.g. by tables)
+    ImVector<ImDrawGlyph>       _GlyphBuffer;   // Glyph instances of channels 1+, appended to the parent ImDrawList::GlyphBuffer on Merge()
+    ImVector<ImVec4>            _GlyphRuns;     // Saved ImDrawList::_GlyphRuns/_GlyphTailElemCount of the last command of the channel
+    unsigned int                _GlyphTailElemCount;
 };
 
 // Split/Merge functions are used to split the draw list into different layers which can be drawn into out of order.
 // This is used by the Columns/Tables API, so items of each column can be batched together in a same draw call.
+// By default channels write their indices in place into reserved ranges of the parent index buffer, so Merge() only stitches
+// commands together instead of copying every channel back (see comments in imgui_draw.cpp, disable with IMGUI_DISABLE_SPLITTER_IN_PLACE_MERGE).
 struct ImDrawListSplitter
 {
     int                         _Current;    // Current channel number (0)
     int                         _Count;      // Number of active channels (1+)
     ImVector<ImDrawChannel>     _Channels;   // Draw channels (not resized down so _Count might be < Channels.Size)
+    bool                        _InPlace;    // Channels write into ranges of the parent IdxBuffer for this split (false when nested inside another in-place split of the same draw list)
+    int                         _IdxEnd;     // In-place mode: end of the last range reserved in the parent IdxBuffer
+    ImVector<int>               _IdxLayout;  // In-place mode: (channel index, index count) pairs in merged order, recorded by Merge() to lay out the next Split()
+    ImVector<ImDrawIdx>         _IdxTemp;    // In-place mode: scratch buffer to compact channels that ended up out of order
+    ImDrawListSplitter*         _OuterIdxRangeSplitter; // Copying mode: in-place splitter owning our channel 0 indices, saved while other channels are current
+    int                         _OuterIdxRangeEnd;
 
     inline ImDrawListSplitter()  { memset(this, 0, sizeof(*this)); }
     inline ~ImDrawListSplitter() { ClearFreeMemory(); }
@@ -3182,6 +3365,29 @@ struct ImDrawListSplitter
     IMGUI_API void              Split(ImDrawList* draw_list, int count);
     IMGUI_API void              Merge(ImDrawList* draw_list);
     IMGUI_API void              SetCurrentChannel(ImDrawList* draw_list, int channel_idx);
+    IMGUI_API void              _ReserveIdxRange(ImDrawList* draw_list, int idx_count);
+};
+
+// Helper to build geometry on worker threads (e.g. plots with millions of points), then append it to a draw list in a deterministic order.
+// - Call Begin() from the ImGui thread. Each of the 'count' worker draw lists gets its own copy of the target draw list shared data, flags, clip rectangle and texture.
+// - Fill GetDrawList(n) from any thread, one thread per draw list at a time. Don't call ImGui:: functions nor draw text from there: font baking and glyph loading
+//   are not thread-safe. Allocations go through the regular allocator (see SetAllocatorFunctions()), which must be thread-safe. Debug allocation counters are paused until Merge().
+// - Once every worker is done, call Merge() from the ImGui thread to append draw lists 0 to count-1 to the target draw list, in that order, or call AddToDrawData()
+//   after ImGui::Render() to submit them as separate draw lists without copying (they are then drawn over everything else).
+struct ImDrawListWorkers
+{
+    int                             _Count;         // Number of draw lists recording (0 when idle)
+    ImVector<ImDrawList*>           _DrawLists;     // Worker draw lists (not resized down so _Count might be < _DrawLists.Size)
+    ImVector<ImDrawListSharedData*> _SharedData;    // Copy of the target draw list shared data for each worker draw list, as drawing uses its TempBuffer
+    ImGuiContext*                   _Context;       // Context whose allocation counters are paused while recording
+
+    inline ImDrawListWorkers()  { memset(this, 0, sizeof(*this)); }
+    inline ~ImDrawListWorkers() { ClearFreeMemory(); }
+    IMGUI_API void              ClearFreeMemory();
+    IMGUI_API void              Begin(ImDrawList* draw_list, int count);
+    inline ImDrawList*          GetDrawList(int n) const { IM_ASSERT(n >= 0 && n < _Count); return _DrawLists.Data[n]; }
+    IMGUI_API void              Merge(ImDrawList* draw_list);
+    IMGUI_API void              AddToDrawData(ImDrawData* draw_data);
 };
 
 // Flags for ImDrawList functions
@@ -3213,6 +3419,7 @@ enum ImDrawListFlags_
     ImDrawListFlags_AntiAliasedLinesUseTex  = 1 << 1,  // Enable anti-aliased lines/borders using textures when possible. Require backend to render with bilinear filtering (NOT point/nearest filtering).
     ImDrawListFlags_AntiAliasedFill         = 1 << 2,  // Enable anti-aliased edge around filled shapes (rounded rectangles, circles).
     ImDrawListFlags_AllowVtxOffset          = 1 << 3,  // Can emit 'VtxOffset > 0' to allow large meshes. Set when 'ImGuiBackendFlags_RendererHasVtxOffset' is enabled.
+    ImDrawListFlags_GlyphInstances          = 1 << 4,  // [EXPERIMENTAL] Can output unscaled text as ImDrawGlyph instances into GlyphBuffer. Set when 'ImGuiBackendFlags_RendererHasGlyphInstances' is enabled.
 };
 
 // Draw command list
@@ -3230,6 +3437,7 @@ struct ImDrawList
     ImVector<ImDrawCmd>     CmdBuffer;          // Draw commands. Typically 1 command = 1 GPU draw call, unless the command is a callback.
     ImVector<ImDrawIdx>     IdxBuffer;          // Index buffer. Each command consume ImDrawCmd::ElemCount of those
     ImVector<ImDrawVert>    VtxBuffer;          // Vertex buffer.
+    ImVector<ImDrawGlyph>   GlyphBuffer;        // Glyph instances buffer. Each command consume ImDrawCmd::GlyphCount of those. Only used with ImDrawListFlags_GlyphInstances.
     ImDrawListFlags         Flags;              // Flags, you may poke into these to adjust anti-aliasing settings per-primitive.
 
     // [Internal, used while building lists]
@@ -3240,6 +3448,10 @@ struct ImDrawList
     ImVector<ImVec2>        _Path;              // [Internal] current path building
     ImDrawCmdHeader         _CmdHeader;         // [Internal] template of active commands. Fields should match those of CmdBuffer.back().
     ImDrawListSplitter      _Splitter;          // [Internal] for channels api (note: prefer using your own persistent instance of ImDrawListSplitter!)
+    ImDrawListSplitter*     _IdxRangeSplitter;  // [Internal] splitter whose channels write in place into IdxBuffer. IdxBuffer.Size is then the write position of the current channel.
+    int                     _IdxRangeEnd;       // [Internal] end of the IdxBuffer range reserved for the current channel of _IdxRangeSplitter
+    ImVector<ImVec4>        _GlyphRuns;         // [Internal] bounding boxes of the text output as glyph instances into the current command (those are drawn after its triangles)
+    unsigned int            _GlyphTailElemCount;// [Internal] ElemCount of the current command when _GlyphRuns was last checked: triangles added since then must not overlap _GlyphRuns[]
     ImVector<ImVec4>        _ClipRectStack;     // [Internal]
     ImVector<ImTextureRef>  _TextureStack;      // [Internal]
     ImVector<ImU8>          _CallbacksDataBuf;  // [Internal]
@@ -3370,6 +3582,7 @@ struct ImDrawList
     IMGUI_API void  _ClearFreeMemory();
     IMGUI_API void  _PopUnusedDrawCmd();
     IMGUI_API void  _TryMergeDrawCmds();
+    IMGUI_API void  _CheckGlyphTail();
     IMGUI_API void  _OnChangedClipRect();
     IMGUI_API void  _OnChangedTexture();
     IMGUI_API void  _OnChangedVtxOffset();
@@ -3388,6 +3601,7 @@ struct ImDrawData
     int                 CmdListsCount;      // == CmdLists.Size. (OBSOLETE: exists for legacy reasons). Number of ImDrawList* to render.
     int                 TotalIdxCount;      // For convenience, sum of all ImDrawList's IdxBuffer.Size
     int                 TotalVtxCount;      // For convenience, sum of all ImDrawList's VtxBuffer.Size
+    int                 TotalGlyphCount;    // For convenience, sum of all ImDrawList's GlyphBuffer.Size
     ImVector<ImDrawList*> CmdLists;         // Array of ImDrawList* to render. The ImDrawLists are owned by ImGuiContext and only pointed to from here.
     ImVec2              DisplayPos;         // Top-left position of the viewport to render (== top-left of the orthogonal projection matrix to use) (== GetMainViewport()->Pos for the main viewport, == (0.0) in most single-viewport applications)
     ImVec2              DisplaySize;        // Size of the viewport to render (== GetMainViewport()->Size for the main viewport, == io.DisplaySize in most single-viewport applications)
@@ -3465,7 +3679,10 @@ struct ImTextureData
     int                 UnusedFrames;           // w    r   // In order to facilitate handling Status==WantDestroy in some backend: this is a count successive frames where the texture was not used. Always >0 when Status==WantDestroy.
     unsigned short      RefCount;               // w    r   // Number of contexts using this texture. Used during backend shutdown.
     bool                UseColors;              // w    r   // Tell whether our texture data is known to use colors (rather than just white + alpha).
+    bool                UseSDF;                 // w    r   // Alpha channel holds signed distances (ImFontAtlasFlags_SDF): 0.5 on glyph edges. Renderer needs to threshold it.
     bool                WantDestroyNextFrame;   // rw   -   // [Internal] Queued to set ImTextureStatus_WantDestroy next frame. May still be used in the current frame.
+    ImVector<ImDrawGlyphRect> GlyphRects;       // w    r   // [EXPERIMENTAL] Font atlas texture: glyph quads indexed by ImDrawGlyph::GlyphId. Only needed by backends setting ImGuiBackendFlags_RendererHasGlyphInstances.
+    int                 GlyphRectsVersion;      // w    r   // Incremented whenever GlyphRects[] is modified, so a backend can keep a copy on the GPU and only upload it again when this changes.
 
     // Functions
     ImTextureData()     { memset(this, 0, sizeof(*this)); Status = ImTextureStatus_Destroyed; TexID = ImTextureID_Invalid; }
@@ -3583,6 +3800,8 @@ enum ImFontAtlasFlags_
     ImFontAtlasFlags_NoPowerOfTwoHeight = 1 << 0,   // Don't round the height to next power of two
     ImFontAtlasFlags_NoMouseCursors     = 1 << 1,   // Don't build software mouse cursors into the atlas (save a little texture memory)
     ImFontAtlasFlags_NoBakedLines       = 1 << 2,   // Don't build thick line textures into the atlas (save a little texture memory, allow support for point/nearest filtering). The AntiAliasedLinesUseTex features uses them, otherwise they will be rendered using polygons (more expensive for CPU/GPU).
+    ImFontAtlasFlags_AsyncGlyphBaking   = 1 << 3,   // Rasterize glyphs on worker threads instead of in the frame which first uses them. They are laid out right away but only drawn from the following frame. Requires IMGUI_ENABLE_FONT_ASYNC_BAKING and the stb_truetype loader, ignored otherwise.
+    ImFontAtlasFlags_SDF                = 1 << 4,   // Bake glyphs as signed distance fields, once per font at SDFBakeSize, and scale them to any size. Avoids a bake per font size. Renderer backend must threshold textures with UseSDF set (see imgui_impl_dx12.cpp). Implies ImFontAtlasFlags_NoBakedLines. Requires the stb_truetype loader.
 };
 
 // Load and rasterize multiple TTF/OTF fonts into a same texture. The font atlas will build a single texture holding:
@@ -3688,6 +3907,20 @@ struct ImFontAtlas
     IMGUI_API void              RemoveCustomRect(ImFontAtlasRectId id);                             // Unregister a rectangle. Existing pixels will stay in texture until resized / garbage collected.
     IMGUI_API bool              GetCustomRect(ImFontAtlasRectId id, ImFontAtlasRect* out_r) const;  // Get rectangle coordinates for current texture. Valid immediately, never store this (read above)!
 
+    //-------------------------------------------
+    // [EXPERIMENTAL] User Images API
+    //-------------------------------------------
+
+    // Pack small user images into the atlas texture, so drawing them doesn't break batching with text and with each other.
+    // - Register a CPU-side copy of the RGBA32 pixels of a texture you created yourself. Pixels are copied.
+    // - ImDrawList::AddImage(), AddImageQuad(), AddImageRounded() (and therefore ImGui::Image(), ImGui::ImageButton() etc.)
+    //   called with this ImTextureID and UV coordinates within 0.0f..1.0f are transparently redirected to 'TexRef' with remapped UV.
+    //   Other calls (e.g. tiling UV coordinates, draw lists recorded with ImDrawListWorkers) keep using your texture, so don't destroy it.
+    // - Images are packed on first use. When the atlas runs out of space, images unused for a few frames are evicted and packed again when used.
+    // - Requires ImGuiBackendFlags_RendererHasTextures and a RGBA32 atlas. Not supported with ImFontAtlasFlags_SDF.
+    IMGUI_API bool              AddUserImage(ImTextureID tex_id, const void* pixels_rgba32, int width, int height); // Register or update image. Return false if larger than UserImagesMaxSize.
+    IMGUI_API void              RemoveUserImage(ImTextureID tex_id);                                                // Unregister image. Existing pixels will stay in texture until resized / garbage collected.
+
     //-------------------------------------------
     // Members
     //-------------------------------------------
@@ -3700,6 +3933,9 @@ struct ImFontAtlas
     int                         TexMinHeight;       // Minimum desired texture height. Must be a power of two. Default to 128.
     int                         TexMaxWidth;        // Maximum desired texture width. Must be a power of two. Default to 8192.
     int                         TexMaxHeight;       // Maximum desired texture height. Must be a power of two. Default to 8192.
+    float                       SDFBakeSize;        // With ImFontAtlasFlags_SDF: size at which each font is baked. Default to 32.0f. Higher keeps sharper corners when magnified.
+    int                         SDFSpread;          // With ImFontAtlasFlags_SDF: distance in pixels (at SDFBakeSize) encoded on each side of glyph edges. Default to 4.
+    int                         UserImagesMaxSize;  // Largest width/height accepted by AddUserImage(). Default to 64. Larger images gain little from batching and waste atlas space.
     void*                       UserData;           // Store your own atlas related user-data (if e.g. you have multiple font atlas).
 
     // Output
@@ -3731,6 +3967,8 @@ struct ImFontAtlas
     const char*                 FontLoaderName;     // Font loader name (for display e.g. in About box) == FontLoader->Name
     void*                       FontLoaderData;     // Font backend opaque storage
     unsigned int                FontLoaderFlags;    // Shared flags (for all fonts) for font loader. THIS IS BUILD IMPLEMENTATION DEPENDENT (e.g. Per-font override is also available in ImFontConfig).
+    ImVector<ImFontAtlasUserImage*> UserImages;     // Images registered with AddUserImage()
+    ImGuiStorage                UserImagesMap;      // Hash of ImTextureID --> ImFontAtlasUserImage*
     int                         RefCount;           // Number of contexts using this atlas
     ImGuiContext*               OwnerContext;       // Context which own the atlas will be in charge of updating and destroying it.
 
@@ -577,6 +577,7 @@ void ImGui::ShowDemoWindow(bool* p_open)
             ImGui::CheckboxFlags("io.BackendFlags: HasSetMousePos",       &io.BackendFlags, ImGuiBackendFlags_HasSetMousePos);
             ImGui::CheckboxFlags("io.BackendFlags: RendererHasVtxOffset", &io.BackendFlags, ImGuiBackendFlags_RendererHasVtxOffset);
             ImGui::CheckboxFlags("io.BackendFlags: RendererHasTextures",  &io.BackendFlags, ImGuiBackendFlags_RendererHasTextures);
+            ImGui::CheckboxFlags("io.BackendFlags: RendererHasGlyphInstances", &io.BackendFlags, ImGuiBackendFlags_RendererHasGlyphInstances);
             ImGui::EndDisabled();
 
             ImGui::TreePop();
@@ -8192,6 +8193,7 @@ void ImGui::ShowAboutWindow(bool* p_open)
         if (io.BackendFlags & ImGuiBackendFlags_HasSetMousePos)         ImGui::Text(" HasSetMousePos");
         if (io.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset)   ImGui::Text(" RendererHasVtxOffset");
         if (io.BackendFlags & ImGuiBackendFlags_RendererHasTextures)    ImGui::Text(" RendererHasTextures");
+        if (io.BackendFlags & ImGuiBackendFlags_RendererHasGlyphInstances) ImGui::Text(" RendererHasGlyphInstances");
         ImGui::Separator();
         ImGui::Text("io.Fonts: %d fonts, Flags: 0x%08X, TexSize: %d,%d", io.Fonts->Fonts.Size, io.Fonts->Flags, io.Fonts->TexData->Width, io.Fonts->TexData->Height);
         ImGui::Text("io.Fonts->FontLoaderName: %s", io.Fonts->FontLoaderName ? io.Fonts->FontLoaderName : "NULL");
@@ -9112,6 +9114,11 @@ struct ExampleAppLog
     ImGuiTextBuffer     Buf;
     ImGuiTextFilter     Filter;
     ImVector<int>       LineOffsets; // Index to lines offset. We maintain this with AddLog() calls.
+    ImVector<ImU32>     FilterPassBits;     // One bit per line: result of Filter.PassFilterLines()
+    ImVector<int>       FilteredLines;      // Index of lines passing the filter, so we can use the clipper
+    int                 FilteredLinesCount; // Lines [0, FilteredLinesCount) of FilterPassBits are up to date...
+    bool                FilterRefine;       // ...or only need to be tested again if they passed, because the filter was refined
+    int                 FilteredBufSize;
     bool                AutoScroll;  // Keep scrolling if already at the bottom.
 
     ExampleAppLog()
@@ -9125,6 +9132,8 @@ struct ExampleAppLog
         Buf.clear();
         LineOffsets.clear();
         LineOffsets.push_back(0);
+        FilteredLinesCount = FilteredBufSize = 0;
+        FilterRefine = false;
     }
 
     void    AddLog(const char* fmt, ...) IM_FMTARGS(2)
@@ -9139,6 +9148,28 @@ struct ExampleAppLog
                 LineOffsets.push_back(old_size + 1);
     }
 
+    // Filter new lines (and the last line, which may have been appended to), and refine previous results if needed.
+    // PassFilterLines() processes many lines in a single call, which is much faster than calling PassFilter() on each line of a large log.
+    void    UpdateFilter()
+    {
+        const int lines_count = LineOffsets.Size;
+        if (!FilterRefine && FilteredLinesCount == lines_count && FilteredBufSize == Buf.size())
+            return;
+        FilterPassBits.resize((lines_count + 31) / 32);
+        const int new_begin = IM_MAX(FilteredLinesCount - 1, 0);
+        if (FilterRefine)
+            Filter.PassFilterLines(Buf.begin(), Buf.end(), LineOffsets.Data, lines_count, FilterPassBits.Data, 0, new_begin, true);
+        Filter.PassFilterLines(Buf.begin(), Buf.end(), LineOffsets.Data, lines_count, FilterPassBits.Data, new_begin, lines_count);
+        FilteredLinesCount = lines_count;
+        FilteredBufSize = Buf.size();
+        FilterRefine = false;
+
+        FilteredLines.resize(0);
+        for (int line_no = 0; line_no < lines_count; line_no++)
+            if (FilterPassBits[line_no >> 5] & (1u << (line_no & 31)))
+                FilteredLines.push_back(line_no);
+    }
+
     void    Draw(const char* title, bool* p_open = NULL)
     {
         if (!ImGui::Begin(title, p_open))
@@ -9162,7 +9193,13 @@ struct ExampleAppLog
         ImGui::SameLine();
         bool copy = ImGui::Button("Copy");
         ImGui::SameLine();
-        Filter.Draw("Filter", -100.0f);
+        if (Filter.Draw("Filter", -100.0f))
+        {
+            // When the new filter refines the previous one (e.g. a character was typed), only lines which passed need to be tested again.
+            FilterRefine = Filter.RefinesPrevious && FilteredLinesCount > 0;
+            if (!FilterRefine)
+                FilteredLinesCount = 0;
+        }
 
         ImGui::Separator();
 
@@ -9178,17 +9215,22 @@ struct ExampleAppLog
             const char* buf_end = Buf.end();
             if (Filter.IsActive())
             {
-                // In this example we don't use the clipper when Filter is enabled.
-                // This is because we don't have random access to the result of our filter.
-                // A real application processing logs with ten of thousands of entries may want to store the result of
-                // search/filter.. especially if the filtering function is not trivial (e.g. reg-exp).
-                for (int line_no = 0; line_no < LineOffsets.Size; line_no++)
+                // When Filter is enabled, we store the result of the filter so we have random access to the lines passing it,
+                // which lets us use the clipper. New lines are filtered as they come.
+                UpdateFilter();
+                ImGuiListClipper clipper;
+                clipper.Begin(FilteredLines.Size);
+                while (clipper.Step())
                 {
-                    const char* line_start = buf + LineOffsets[line_no];
-                    const char* line_end = (line_no + 1 < LineOffsets.Size) ? (buf + LineOffsets[line_no + 1] - 1) : buf_end;
-                    if (Filter.PassFilter(line_start, line_end))
+                    for (int filtered_no = clipper.DisplayStart; filtered_no < clipper.DisplayEnd; filtered_no++)
+                    {
+                        const int line_no = FilteredLines[filtered_no];
+                        const char* line_start = buf + LineOffsets[line_no];
+                        const char* line_end = (line_no + 1 < LineOffsets.Size) ? (buf + LineOffsets[line_no + 1] - 1) : buf_end;
                         ImGui::TextUnformatted(line_start, line_end);
+                    }
                 }
+                clipper.End();
             }
             else
             {
@@ -9202,9 +9244,6 @@ struct ExampleAppLog
                 // - A) random access into your data
                 // - B) items all being the  same height,
                 // both of which we can handle since we have an array pointing to the beginning of each line of text.
-                // When using the filter (in the block of code above) we don't have random access into the data to display
-                // anymore, which is why we don't use the clipper. Storing or skimming through the search result would make
-                // it possible (and would be recommended if you want to search through tens of thousands of entries).
                 ImGuiListClipper clipper;
                 clipper.Begin(LineOffsets.Size);
                 while (clipper.Step())
@@ -9499,19 +9538,29 @@ static void ShowExampleAppLongText(bool* p_open)
 
     static int test_type = 0;
     static ImGuiTextBuffer log;
+    static ImGuiTextChunkedBuffer log_chunked(64 * 1024, 1024 * 1024); // Ring buffer: keeps the last ~1 MB
     static int lines = 0;
     ImGui::Text("Printing unusually long amount of text.");
     ImGui::Combo("Test type", &test_type,
         "Single call to TextUnformatted()\0"
         "Multiple calls to Text(), clipped\0"
-        "Multiple calls to Text(), not clipped (slow)\0");
-    ImGui::Text("Buffer contents: %d lines, %d bytes", lines, log.size());
-    if (ImGui::Button("Clear")) { log.clear(); lines = 0; }
+        "Multiple calls to Text(), not clipped (slow)\0"
+        "Multiple calls to Text(), variable heights, clipped\0"
+        "Chunked buffer capped to 1 MB, clipped\0");
+    if (test_type == 4)
+        ImGui::Text("Buffer contents: %d lines, %d bytes, %d lines dropped", log_chunked.lines_count(), (int)log_chunked.size(), log_chunked.LinesDropped);
+    else
+        ImGui::Text("Buffer contents: %d lines, %d bytes", lines, log.size());
+    static ImGuiListClipperHeights heights; // Persistent: stores the heights measured so far
+    if (ImGui::Button("Clear")) { log.clear(); log_chunked.clear(); lines = 0; heights.Clear(); }
     ImGui::SameLine();
     if (ImGui::Button("Add 1000 lines"))
     {
         for (int i = 0; i < 1000; i++)
+        {
             log.appendf("%i The quick brown fox jumps over the lazy dog\n", lines + i);
+            log_chunked.appendf("%i The quick brown fox jumps over the lazy dog\n", lines + i);
+        }
         lines += 1000;
     }
     ImGui::BeginChild("Log");
@@ -9540,6 +9589,36 @@ static void ShowExampleAppLongText(bool* p_open)
             ImGui::Text("%i The quick brown fox jumps over the lazy dog", i);
         ImGui::PopStyleVar();
         break;
+    case 3:
+        {
+            // Multiple calls to Text(), every 10th item spanning several lines: heights are learned as items get displayed.
+            ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(0, 0));
+            ImGuiListClipper clipper;
+            clipper.BeginVariableHeight(lines, &heights);
+            while (clipper.Step())
+                for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+                {
+                    if ((i % 10) == 0)
+                        ImGui::Text("%i The quick brown fox\n  jumps over\n  the lazy dog", i);
+                    else
+                        ImGui::Text("%i The quick brown fox jumps over the lazy dog", i);
+                }
+            ImGui::PopStyleVar();
+            break;
+        }
+    case 4:
+        {
+            // Appending to a ImGuiTextChunkedBuffer never copies previous text, and lines are indexed as they are appended.
+            // A cursor walks consecutive lines: each line is contiguous and can be passed to TextUnformatted().
+            ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(0, 0));
+            ImGuiListClipper clipper;
+            clipper.Begin(log_chunked.lines_count());
+            while (clipper.Step())
+                for (ImGuiTextChunkedBuffer::Cursor c = log_chunked.seek_line(clipper.DisplayStart); c.LineNo < clipper.DisplayEnd; log_chunked.next_line(&c))
+                    ImGui::TextUnformatted(c.LineBegin, c.LineEnd);
+            ImGui::PopStyleVar();
+            break;
+        }
     }
     ImGui::EndChild();
     ImGui::End();
@@ -10,10 +10,12 @@ Index of this file:
 // [SECTION] ImDrawList
 // [SECTION] ImTriangulator, ImDrawList concave polygon fill
 // [SECTION] ImDrawListSplitter
+// [SECTION] ImDrawListWorkers
 // [SECTION] ImDrawData
 // [SECTION] Helpers ShadeVertsXXX functions
 // [SECTION] ImFontConfig
 // [SECTION] ImFontAtlas, ImFontAtlasBuilder
+// [SECTION] ImFontAtlas: asynchronous glyph baking
 // [SECTION] ImFontAtlas: backend for stb_truetype
 // [SECTION] ImFontAtlas: glyph ranges helpers
 // [SECTION] ImFontGlyphRangesBuilder
@@ -38,6 +40,11 @@ Index of this file:
 #ifdef IMGUI_ENABLE_FREETYPE
 #include "misc/freetype/imgui_freetype.h"
 #endif
+#ifdef IMGUI_ENABLE_FONT_ASYNC_BAKING
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
 
 #include <stdio.h>      // vsnprintf, sscanf, printf
 #include <stdint.h>     // intptr_t
@@ -94,6 +101,12 @@ Index of this file:
 //#define IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION
 //#define IMGUI_DISABLE_STB_RECT_PACK_IMPLEMENTATION
 
+#if defined(IMGUI_ENABLE_STB_TRUETYPE) && defined(IMGUI_ENABLE_FONT_ASYNC_BAKING)
+// stb_truetype allocations made from worker threads are tagged with a non-NULL userdata (see ImFontAtlasAsyncBaker)
+static void* ImFontAtlasAsyncBakerMemAlloc(size_t size, void* user_data);
+static void  ImFontAtlasAsyncBakerMemFree(void* ptr, void* user_data);
+#endif
+
 #ifdef IMGUI_STB_NAMESPACE
 namespace IMGUI_STB_NAMESPACE
 {
@@ -137,8 +150,13 @@ namespace IMGUI_STB_NAMESPACE
 #ifdef  IMGUI_ENABLE_STB_TRUETYPE
 #ifndef STB_TRUETYPE_IMPLEMENTATION                         // in case the user already have an implementation in the _same_ compilation unit (e.g. unity builds)
 #ifndef IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION           // in case the user already have an implementation in another compilation unit
+#ifdef IMGUI_ENABLE_FONT_ASYNC_BAKING
+#define STBTT_malloc(x,u)   ((u) ? ImFontAtlasAsyncBakerMemAlloc(x,u) : IM_ALLOC(x))
+#define STBTT_free(x,u)     ((u) ? ImFontAtlasAsyncBakerMemFree(x,u) : IM_FREE(x))
+#else
 #define STBTT_malloc(x,u)   ((void)(u), IM_ALLOC(x))
 #define STBTT_free(x,u)     ((void)(u), IM_FREE(x))
+#endif
 #define STBTT_assert(x)     do { IM_ASSERT(x); } while(0)
 #define STBTT_fmod(x,y)     ImFmod(x,y)
 #define STBTT_sqrt(x)       ImSqrt(x)
@@ -147,6 +165,9 @@ namespace IMGUI_STB_NAMESPACE
 #define STBTT_ifloor(x)     ((int)ImFloor(x))
 #define STBTT_iceil(x)      ((int)ImCeil(x))
 #define STBTT_strlen(x)     ImStrlen(x)
+#if defined(IMGUI_ENABLE_SSE) || defined(IMGUI_ENABLE_NEON)
+#define STBTT_ENABLE_SIMD                                   // Vectorized scanline accumulation (SSE2/NEON, scalar fallback otherwise)
+#endif
 #define STBTT_STATIC
 #define STB_TRUETYPE_IMPLEMENTATION
 #else
@@ -390,6 +411,13 @@ ImDrawListSharedData::ImDrawListSharedData()
         const float a = ((float)i * 2 * IM_PI) / (float)IM_ARRAYSIZE(ArcFastVtx);
         ArcFastVtx[i] = ImVec2(ImCos(a), ImSin(a));
     }
+    for (int n = 0; n < IM_DRAWLIST_TEXT_RUN_MAX; n++)
+    {
+        ImDrawIdx* idx = &TextQuadIdx[n * 6];
+        const ImDrawIdx vtx = (ImDrawIdx)(n * 4);
+        idx[0] = vtx; idx[1] = (ImDrawIdx)(vtx + 1); idx[2] = (ImDrawIdx)(vtx + 2);
+        idx[3] = vtx; idx[4] = (ImDrawIdx)(vtx + 2); idx[5] = (ImDrawIdx)(vtx + 3);
+    }
     ArcFastRadiusCutoff = IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_CALC_R(IM_DRAWLIST_ARCFAST_SAMPLE_MAX, CircleSegmentMaxError);
 }
 
@@ -448,6 +476,7 @@ void ImDrawList::_ResetForNewFrame()
     CmdBuffer.resize(0);
     IdxBuffer.resize(0);
     VtxBuffer.resize(0);
+    GlyphBuffer.resize(0);
     Flags = _Data->InitialFlags;
     memset(&_CmdHeader, 0, sizeof(_CmdHeader));
     _VtxCurrentIdx = 0;
@@ -458,6 +487,9 @@ void ImDrawList::_ResetForNewFrame()
     _CallbacksDataBuf.resize(0);
     _Path.resize(0);
     _Splitter.Clear();
+    _IdxRangeSplitter = NULL;
+    _GlyphRuns.resize(0);
+    _GlyphTailElemCount = 0;
     CmdBuffer.push_back(ImDrawCmd());
     _FringeScale = _Data->InitialFringeScale;
 }
@@ -467,6 +499,7 @@ void ImDrawList::_ClearFreeMemory()
     CmdBuffer.clear();
     IdxBuffer.clear();
     VtxBuffer.clear();
+    GlyphBuffer.clear();
     Flags = ImDrawListFlags_None;
     _VtxCurrentIdx = 0;
     _VtxWritePtr = NULL;
@@ -476,6 +509,9 @@ void ImDrawList::_ClearFreeMemory()
     _CallbacksDataBuf.clear();
     _Path.clear();
     _Splitter.ClearFreeMemory();
+    _IdxRangeSplitter = NULL;
+    _GlyphRuns.clear();
+    _GlyphTailElemCount = 0;
 }
 
 // Note: For multi-threaded rendering, consider using `imgui_threaded_rendering` from https://github.com/ocornut/imgui_club
@@ -485,17 +521,26 @@ ImDrawList* ImDrawList::CloneOutput() const
     dst->CmdBuffer = CmdBuffer;
     dst->IdxBuffer = IdxBuffer;
     dst->VtxBuffer = VtxBuffer;
+    dst->GlyphBuffer = GlyphBuffer;
     dst->Flags = Flags;
     return dst;
 }
 
 void ImDrawList::AddDrawCmd()
 {
+    if (_GlyphRuns.Size > 0)
+    {
+        _CheckGlyphTail();
+        _GlyphRuns.resize(0);
+    }
+    _GlyphTailElemCount = 0;
+
     ImDrawCmd draw_cmd;
     draw_cmd.ClipRect = _CmdHeader.ClipRect;    // Same as calling ImDrawCmd_HeaderCopy()
     draw_cmd.TexRef = _CmdHeader.TexRef;
     draw_cmd.VtxOffset = _CmdHeader.VtxOffset;
     draw_cmd.IdxOffset = IdxBuffer.Size;
+    draw_cmd.GlyphOffset = GlyphBuffer.Size;
 
     IM_ASSERT(draw_cmd.ClipRect.x <= draw_cmd.ClipRect.z && draw_cmd.ClipRect.y <= draw_cmd.ClipRect.w);
     CmdBuffer.push_back(draw_cmd);
@@ -505,21 +550,72 @@ void ImDrawList::AddDrawCmd()
 // Note that this leaves the ImDrawList in a state unfit for further commands, as most code assume that CmdBuffer.Size > 0 && CmdBuffer.back().UserCallback == NULL
 void ImDrawList::_PopUnusedDrawCmd()
 {
+    _CheckGlyphTail();
     while (CmdBuffer.Size > 0)
     {
         ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
-        if (curr_cmd->ElemCount != 0 || curr_cmd->UserCallback != NULL)
+        if (curr_cmd->ElemCount != 0 || curr_cmd->GlyphCount != 0 || curr_cmd->UserCallback != NULL)
             return;// break;
         CmdBuffer.pop_back();
     }
 }
 
+// Glyph instances of a command are drawn after its triangles (see ImDrawCmd::GlyphCount).
+// Triangles added to the current command after some glyphs may then be drawn before them: this is fine as long as they don't overlap.
+// Check the triangles added since the last call against the text runs output as glyph instances, and move them to a new command if they overlap.
+void ImDrawList::_CheckGlyphTail()
+{
+    if (_GlyphRuns.Size == 0)
+        return;
+    IM_ASSERT_PARANOID(CmdBuffer.Size > 0);
+    ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
+    if (curr_cmd->ElemCount == _GlyphTailElemCount)
+        return;
+    IM_ASSERT(curr_cmd->GlyphCount > 0 && curr_cmd->ElemCount > _GlyphTailElemCount);
+
+    // Indices reserved by PrimReserve() but not written yet are not checked (e.g. RenderText() loading a glyph changed the texture)
+    ImVec4 bb(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+    const ImDrawVert* vtx = VtxBuffer.Data + curr_cmd->VtxOffset;
+    const ImDrawIdx* idx_end = ImMin(IdxBuffer.Data + curr_cmd->IdxOffset + curr_cmd->ElemCount, _IdxWritePtr);
+    for (const ImDrawIdx* idx = IdxBuffer.Data + curr_cmd->IdxOffset + _GlyphTailElemCount; idx < idx_end; idx++)
+    {
+        const ImVec2 p = vtx[*idx].pos;
+        bb.x = ImMin(bb.x, p.x); bb.y = ImMin(bb.y, p.y);
+        bb.z = ImMax(bb.z, p.x); bb.w = ImMax(bb.w, p.y);
+    }
+    bool overlap = false;
+    for (const ImVec4& run : _GlyphRuns)
+        if (bb.x < run.z && bb.z > run.x && bb.y < run.w && bb.w > run.y)
+        {
+            overlap = true;
+            break;
+        }
+    if (!overlap)
+    {
+        _GlyphTailElemCount = curr_cmd->ElemCount;
+        return;
+    }
+
+    // Move the triangles to a new command, drawn after the glyphs
+    ImDrawCmd draw_cmd;
+    draw_cmd.ClipRect = curr_cmd->ClipRect;
+    draw_cmd.TexRef = curr_cmd->TexRef;
+    draw_cmd.VtxOffset = curr_cmd->VtxOffset;
+    draw_cmd.IdxOffset = curr_cmd->IdxOffset + _GlyphTailElemCount;
+    draw_cmd.ElemCount = curr_cmd->ElemCount - _GlyphTailElemCount;
+    draw_cmd.GlyphOffset = GlyphBuffer.Size;
+    curr_cmd->ElemCount = _GlyphTailElemCount;
+    CmdBuffer.push_back(draw_cmd);
+    _GlyphRuns.resize(0);
+    _GlyphTailElemCount = 0;
+}
+
 void ImDrawList::AddCallback(ImDrawCallback callback, void* userdata, size_t userdata_size)
 {
     IM_ASSERT_PARANOID(CmdBuffer.Size > 0);
     ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
     IM_ASSERT(curr_cmd->UserCallback == NULL);
-    if (curr_cmd->ElemCount != 0)
+    if (curr_cmd->ElemCount != 0 || curr_cmd->GlyphCount != 0)
     {
         AddDrawCmd();
         curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
@@ -560,9 +656,12 @@ void ImDrawList::_TryMergeDrawCmds()
     IM_ASSERT_PARANOID(CmdBuffer.Size > 0);
     ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
     ImDrawCmd* prev_cmd = curr_cmd - 1;
-    if (ImDrawCmd_HeaderCompare(curr_cmd, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && curr_cmd->UserCallback == NULL && prev_cmd->UserCallback == NULL)
+    if (ImDrawCmd_HeaderCompare(curr_cmd, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && curr_cmd->UserCallback == NULL && prev_cmd->UserCallback == NULL && prev_cmd->GlyphCount == 0)
     {
+        _GlyphTailElemCount += prev_cmd->ElemCount;
         prev_cmd->ElemCount += curr_cmd->ElemCount;
+        prev_cmd->GlyphOffset = curr_cmd->GlyphOffset;
+        prev_cmd->GlyphCount = curr_cmd->GlyphCount;
         CmdBuffer.pop_back();
     }
 }
@@ -574,7 +673,7 @@ void ImDrawList::_OnChangedClipRect()
     // If current command is used with different settings we need to add a new command
     IM_ASSERT_PARANOID(CmdBuffer.Size > 0);
     ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
-    if (curr_cmd->ElemCount != 0 && memcmp(&curr_cmd->ClipRect, &_CmdHeader.ClipRect, sizeof(ImVec4)) != 0)
+    if ((curr_cmd->ElemCount != 0 || curr_cmd->GlyphCount != 0) && memcmp(&curr_cmd->ClipRect, &_CmdHeader.ClipRect, sizeof(ImVec4)) != 0)
     {
         AddDrawCmd();
         return;
@@ -582,8 +681,9 @@ void ImDrawList::_OnChangedClipRect()
     IM_ASSERT(curr_cmd->UserCallback == NULL);
 
     // Try to merge with previous command if it matches, else use current command
+    // (not with a command drawing glyph instances: we don't keep track of its text runs, see _CheckGlyphTail())
     ImDrawCmd* prev_cmd = curr_cmd - 1;
-    if (curr_cmd->ElemCount == 0 && CmdBuffer.Size > 1 && ImDrawCmd_HeaderCompare(&_CmdHeader, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && prev_cmd->UserCallback == NULL)
+    if (curr_cmd->ElemCount == 0 && curr_cmd->GlyphCount == 0 && CmdBuffer.Size > 1 && ImDrawCmd_HeaderCompare(&_CmdHeader, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && prev_cmd->UserCallback == NULL && prev_cmd->GlyphCount == 0)
     {
         CmdBuffer.pop_back();
         return;
@@ -596,7 +696,7 @@ void ImDrawList::_OnChangedTexture()
     // If current command is used with different settings we need to add a new command
     IM_ASSERT_PARANOID(CmdBuffer.Size > 0);
     ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
-    if (curr_cmd->ElemCount != 0 && curr_cmd->TexRef != _CmdHeader.TexRef)
+    if ((curr_cmd->ElemCount != 0 || curr_cmd->GlyphCount != 0) && curr_cmd->TexRef != _CmdHeader.TexRef)
     {
         AddDrawCmd();
         return;
@@ -608,7 +708,7 @@ void ImDrawList::_OnChangedTexture()
 
     // Try to merge with previous command if it matches, else use current command
     ImDrawCmd* prev_cmd = curr_cmd - 1;
-    if (curr_cmd->ElemCount == 0 && CmdBuffer.Size > 1 && ImDrawCmd_HeaderCompare(&_CmdHeader, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && prev_cmd->UserCallback == NULL)
+    if (curr_cmd->ElemCount == 0 && curr_cmd->GlyphCount == 0 && CmdBuffer.Size > 1 && ImDrawCmd_HeaderCompare(&_CmdHeader, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && prev_cmd->UserCallback == NULL && prev_cmd->GlyphCount == 0)
     {
         CmdBuffer.pop_back();
         return;
@@ -623,7 +723,7 @@ void ImDrawList::_OnChangedVtxOffset()
     IM_ASSERT_PARANOID(CmdBuffer.Size > 0);
     ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
     //IM_ASSERT(curr_cmd->VtxOffset != _CmdHeader.VtxOffset); // See #3349
-    if (curr_cmd->ElemCount != 0)
+    if (curr_cmd->ElemCount != 0 || curr_cmd->GlyphCount != 0)
     {
         AddDrawCmd();
         return;
@@ -724,6 +824,8 @@ void ImDrawList::PrimReserve(int idx_count, int vtx_count)
     _VtxWritePtr = VtxBuffer.Data + vtx_buffer_old_size;
 
     int idx_buffer_old_size = IdxBuffer.Size;
+    if (_IdxRangeSplitter != NULL && idx_buffer_old_size + idx_count > _IdxRangeEnd)
+        _IdxRangeSplitter->_ReserveIdxRange(this, idx_count); // Current channel of an in-place ImDrawListSplitter ran out of room
     IdxBuffer.resize(idx_buffer_old_size + idx_count);
     _IdxWritePtr = IdxBuffer.Data + idx_buffer_old_size;
 }
@@ -791,6 +893,224 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
 #define IM_FIXNORMAL2F_MAX_INVLEN2          100.0f // 500.0f (see #4053, #3366)
 #define IM_FIXNORMAL2F(VX,VY)               { float d2 = VX*VX + VY*VY; if (d2 > 0.000001f) { float inv_len2 = 1.0f / d2; if (inv_len2 > IM_FIXNORMAL2F_MAX_INVLEN2) inv_len2 = IM_FIXNORMAL2F_MAX_INVLEN2; VX *= inv_len2; VY *= inv_len2; } } (void)0
 
+// Polyline/convex fill tessellation kernels.
+// - ImDrawList_ComputeNormals(): unit normal (dy,-dx) of each segment, the last segment of a closed shape wraps to points[0].
+// - ImDrawList_ComputeJoinPoints2/4(): averaged normal at each point (IM_FIXNORMAL2F), scaled and offset to both sides of the point.
+// With SSE/AVX2/NEON those process 2 registers of points per iteration (4 points, 8 with AVX2) and fall back to scalar code for the tail.
+// SSE/AVX2 use the same operations in the same order as the scalar code (including the rsqrt approximation used by ImRsqrt()) so output is identical.
+// NEON refines its rsqrt estimate with two Newton-Raphson steps, which matches the scalar 1.0f/sqrtf() within a few ULP.
+#if defined(IMGUI_ENABLE_AVX2)
+#define IM_VEC2X_WIDTH 4    // ImVec2 per register
+typedef __m256 ImVec2x;
+static inline ImVec2x ImVec2x_Load(const ImVec2* p)                     { return _mm256_loadu_ps(&p->x); }
+static inline ImVec2x ImVec2x_Set1(float v)                             { return _mm256_set1_ps(v); }
+static inline ImVec2x ImVec2x_Add(ImVec2x a, ImVec2x b)                 { return _mm256_add_ps(a, b); }
+static inline ImVec2x ImVec2x_Sub(ImVec2x a, ImVec2x b)                 { return _mm256_sub_ps(a, b); }
+static inline ImVec2x ImVec2x_Mul(ImVec2x a, ImVec2x b)                 { return _mm256_mul_ps(a, b); }
+static inline ImVec2x ImVec2x_Div(ImVec2x a, ImVec2x b)                 { return _mm256_div_ps(a, b); }
+static inline ImVec2x ImVec2x_Min(ImVec2x a, ImVec2x b)                 { return _mm256_min_ps(a, b); }
+static inline ImVec2x ImVec2x_Rsqrt(ImVec2x a)                          { return _mm256_rsqrt_ps(a); }
+static inline ImVec2x ImVec2x_SwapXY(ImVec2x a)                         { return _mm256_permute_ps(a, _MM_SHUFFLE(2, 3, 0, 1)); }
+static inline ImVec2x ImVec2x_NegY(ImVec2x a)                           { return _mm256_xor_ps(a, _mm256_setr_ps(0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f)); }
+static inline ImVec2x ImVec2x_SelectGreater(ImVec2x a, ImVec2x b, ImVec2x if_true, ImVec2x if_false) { return _mm256_blendv_ps(if_false, if_true, _mm256_cmp_ps(a, b, _CMP_GT_OQ)); }
+static inline void    ImVec2x_Store(ImVec2* p, ImVec2x a)               { _mm256_storeu_ps(&p->x, a); }
+// Stores a0,b0,a1,b1,a2,b2,a3,b3
+static inline void    ImVec2x_Store2(ImVec2* p, ImVec2x a, ImVec2x b)
+{
+    __m256 lo = _mm256_castpd_ps(_mm256_unpacklo_pd(_mm256_castps_pd(a), _mm256_castps_pd(b)));
+    __m256 hi = _mm256_castpd_ps(_mm256_unpackhi_pd(_mm256_castps_pd(a), _mm256_castps_pd(b)));
+    _mm256_storeu_ps(&p[0].x, _mm256_permute2f128_ps(lo, hi, 0x20));
+    _mm256_storeu_ps(&p[4].x, _mm256_permute2f128_ps(lo, hi, 0x31));
+}
+// Stores a0,b0,c0,d0,a1,b1,c1,d1,...
+static inline void    ImVec2x_Store4(ImVec2* p, ImVec2x a, ImVec2x b, ImVec2x c, ImVec2x d)
+{
+    __m256 ab_lo = _mm256_castpd_ps(_mm256_unpacklo_pd(_mm256_castps_pd(a), _mm256_castps_pd(b)));
+    __m256 ab_hi = _mm256_castpd_ps(_mm256_unpackhi_pd(_mm256_castps_pd(a), _mm256_castps_pd(b)));
+    __m256 cd_lo = _mm256_castpd_ps(_mm256_unpacklo_pd(_mm256_castps_pd(c), _mm256_castps_pd(d)));
+    __m256 cd_hi = _mm256_castpd_ps(_mm256_unpackhi_pd(_mm256_castps_pd(c), _mm256_castps_pd(d)));
+    _mm256_storeu_ps(&p[0].x, _mm256_permute2f128_ps(ab_lo, cd_lo, 0x20));
+    _mm256_storeu_ps(&p[4].x, _mm256_permute2f128_ps(ab_hi, cd_hi, 0x20));
+    _mm256_storeu_ps(&p[8].x, _mm256_permute2f128_ps(ab_lo, cd_lo, 0x31));
+    _mm256_storeu_ps(&p[12].x, _mm256_permute2f128_ps(ab_hi, cd_hi, 0x31));
+}
+#elif defined(IMGUI_ENABLE_SSE)
+#define IM_VEC2X_WIDTH 2
+typedef __m128 ImVec2x;
+static inline ImVec2x ImVec2x_Load(const ImVec2* p)                     { return _mm_loadu_ps(&p->x); }
+static inline ImVec2x ImVec2x_Set1(float v)                             { return _mm_set1_ps(v); }
+static inline ImVec2x ImVec2x_Add(ImVec2x a, ImVec2x b)                 { return _mm_add_ps(a, b); }
+static inline ImVec2x ImVec2x_Sub(ImVec2x a, ImVec2x b)                 { return _mm_sub_ps(a, b); }
+static inline ImVec2x ImVec2x_Mul(ImVec2x a, ImVec2x b)                 { return _mm_mul_ps(a, b); }
+static inline ImVec2x ImVec2x_Div(ImVec2x a, ImVec2x b)                 { return _mm_div_ps(a, b); }
+static inline ImVec2x ImVec2x_Min(ImVec2x a, ImVec2x b)                 { return _mm_min_ps(a, b); }
+static inline ImVec2x ImVec2x_Rsqrt(ImVec2x a)                          { return _mm_rsqrt_ps(a); }
+static inline ImVec2x ImVec2x_SwapXY(ImVec2x a)                         { return _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)); }
+static inline ImVec2x ImVec2x_NegY(ImVec2x a)                           { return _mm_xor_ps(a, _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f)); }
+static inline ImVec2x ImVec2x_SelectGreater(ImVec2x a, ImVec2x b, ImVec2x if_true, ImVec2x if_false) { __m128 mask = _mm_cmpgt_ps(a, b); return _mm_or_ps(_mm_and_ps(mask, if_true), _mm_andnot_ps(mask, if_false)); }
+static inline void    ImVec2x_Store(ImVec2* p, ImVec2x a)               { _mm_storeu_ps(&p->x, a); }
+static inline void    ImVec2x_Store2(ImVec2* p, ImVec2x a, ImVec2x b)   { _mm_storeu_ps(&p[0].x, _mm_movelh_ps(a, b)); _mm_storeu_ps(&p[2].x, _mm_movehl_ps(b, a)); }
+static inline void    ImVec2x_Store4(ImVec2* p, ImVec2x a, ImVec2x b, ImVec2x c, ImVec2x d)
+{
+    _mm_storeu_ps(&p[0].x, _mm_movelh_ps(a, b)); _mm_storeu_ps(&p[2].x, _mm_movelh_ps(c, d));
+    _mm_storeu_ps(&p[4].x, _mm_movehl_ps(b, a)); _mm_storeu_ps(&p[6].x, _mm_movehl_ps(d, c));
+}
+#elif defined(IMGUI_ENABLE_NEON)
+#define IM_VEC2X_WIDTH 2
+typedef float32x4_t ImVec2x;
+static inline ImVec2x ImVec2x_Load(const ImVec2* p)                     { return vld1q_f32(&p->x); }
+static inline ImVec2x ImVec2x_Set1(float v)                             { return vdupq_n_f32(v); }
+static inline ImVec2x ImVec2x_Add(ImVec2x a, ImVec2x b)                 { return vaddq_f32(a, b); }
+static inline ImVec2x ImVec2x_Sub(ImVec2x a, ImVec2x b)                 { return vsubq_f32(a, b); }
+static inline ImVec2x ImVec2x_Mul(ImVec2x a, ImVec2x b)                 { return vmulq_f32(a, b); }
+static inline ImVec2x ImVec2x_Min(ImVec2x a, ImVec2x b)                 { return vminq_f32(a, b); }
+static inline ImVec2x ImVec2x_SwapXY(ImVec2x a)                         { return vrev64q_f32(a); }
+static inline ImVec2x ImVec2x_NegY(ImVec2x a)                           { static const float sign[4] = { 1.0f, -1.0f, 1.0f, -1.0f }; return vmulq_f32(a, vld1q_f32(sign)); }
+static inline ImVec2x ImVec2x_SelectGreater(ImVec2x a, ImVec2x b, ImVec2x if_true, ImVec2x if_false) { return vbslq_f32(vcgtq_f32(a, b), if_true, if_false); }
+static inline void    ImVec2x_Store(ImVec2* p, ImVec2x a)               { vst1q_f32(&p->x, a); }
+static inline void    ImVec2x_Store2(ImVec2* p, ImVec2x a, ImVec2x b)   { vst1q_f32(&p[0].x, vcombine_f32(vget_low_f32(a), vget_low_f32(b))); vst1q_f32(&p[2].x, vcombine_f32(vget_high_f32(a), vget_high_f32(b))); }
+static inline void    ImVec2x_Store4(ImVec2* p, ImVec2x a, ImVec2x b, ImVec2x c, ImVec2x d)
+{
+    vst1q_f32(&p[0].x, vcombine_f32(vget_low_f32(a), vget_low_f32(b)));   vst1q_f32(&p[2].x, vcombine_f32(vget_low_f32(c), vget_low_f32(d)));
+    vst1q_f32(&p[4].x, vcombine_f32(vget_high_f32(a), vget_high_f32(b))); vst1q_f32(&p[6].x, vcombine_f32(vget_high_f32(c), vget_high_f32(d)));
+}
+static inline ImVec2x ImVec2x_Rsqrt(ImVec2x a)
+{
+    float32x4_t e = vrsqrteq_f32(a);
+    e = vmulq_f32(e, vrsqrtsq_f32(vmulq_f32(a, e), e));
+    return vmulq_f32(e, vrsqrtsq_f32(vmulq_f32(a, e), e));
+}
+#if defined(__aarch64__) || defined(_M_ARM64)
+static inline ImVec2x ImVec2x_Div(ImVec2x a, ImVec2x b)                 { return vdivq_f32(a, b); }
+#else
+static inline ImVec2x ImVec2x_Div(ImVec2x a, ImVec2x b)                 { float32x4_t r = vrecpeq_f32(b); r = vmulq_f32(r, vrecpsq_f32(b, r)); r = vmulq_f32(r, vrecpsq_f32(b, r)); return vmulq_f32(a, r); }
+#endif
+#endif
+
+#ifdef IM_VEC2X_WIDTH
+// x*x+y*y of each point, in both lanes of the point
+static inline ImVec2x ImVec2x_LengthSqr(ImVec2x a)                      { ImVec2x sq = ImVec2x_Mul(a, a); return ImVec2x_Add(sq, ImVec2x_SwapXY(sq)); }
+
+// Same as IM_NORMALIZE2F_OVER_ZERO() + (dy,-dx) on IM_VEC2X_WIDTH segments
+static inline ImVec2x ImVec2x_SegmentNormals(const ImVec2* points)
+{
+    ImVec2x d = ImVec2x_Sub(ImVec2x_Load(points + 1), ImVec2x_Load(points));
+    ImVec2x d2 = ImVec2x_LengthSqr(d);
+    const ImVec2x one = ImVec2x_Set1(1.0f);
+    d = ImVec2x_Mul(d, ImVec2x_SelectGreater(d2, ImVec2x_Set1(0.0f), ImVec2x_Rsqrt(d2), one));
+    return ImVec2x_NegY(ImVec2x_SwapXY(d));
+}
+
+// Same as averaging two normals then IM_FIXNORMAL2F() on IM_VEC2X_WIDTH points
+static inline ImVec2x ImVec2x_JoinNormals(const ImVec2* normals)
+{
+    ImVec2x dm = ImVec2x_Mul(ImVec2x_Add(ImVec2x_Load(normals - 1), ImVec2x_Load(normals)), ImVec2x_Set1(0.5f));
+    ImVec2x d2 = ImVec2x_LengthSqr(dm);
+    ImVec2x inv_len2 = ImVec2x_Min(ImVec2x_Div(ImVec2x_Set1(1.0f), d2), ImVec2x_Set1(IM_FIXNORMAL2F_MAX_INVLEN2));
+    return ImVec2x_Mul(dm, ImVec2x_SelectGreater(d2, ImVec2x_Set1(0.000001f), inv_len2, ImVec2x_Set1(1.0f)));
+}
+#endif
+
+// Writes normals_count normals, the last one wraps to points[0] when normals_count == points_count
+static void ImDrawList_ComputeNormals(const ImVec2* points, const int points_count, const int normals_count, ImVec2* out_normals)
+{
+    int i1 = 0;
+#ifdef IM_VEC2X_WIDTH
+    // Reads points[i1 .. i1 + 2 * IM_VEC2X_WIDTH]
+    for (; i1 + IM_VEC2X_WIDTH * 2 <= normals_count && i1 + IM_VEC2X_WIDTH * 2 < points_count; i1 += IM_VEC2X_WIDTH * 2)
+    {
+        ImVec2x_Store(out_normals + i1, ImVec2x_SegmentNormals(points + i1));
+        ImVec2x_Store(out_normals + i1 + IM_VEC2X_WIDTH, ImVec2x_SegmentNormals(points + i1 + IM_VEC2X_WIDTH));
+    }
+#endif
+    for (; i1 < normals_count; i1++)
+    {
+        const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
+        float dx = points[i2].x - points[i1].x;
+        float dy = points[i2].y - points[i1].y;
+        IM_NORMALIZE2F_OVER_ZERO(dx, dy);
+        out_normals[i1].x = dy;
+        out_normals[i1].y = -dx;
+    }
+}
+
+// Averaged normal at point i1 between the segments i0->i1 and i1->i2, written as 'point + dm * half_size' and 'point - dm * half_size'
+static inline void ImDrawList_ComputeJoinPoint2(const ImVec2* points, const ImVec2* normals, const int i0, const int i1, const float half_size, ImVec2* out_vtx)
+{
+    float dm_x = (normals[i0].x + normals[i1].x) * 0.5f;
+    float dm_y = (normals[i0].y + normals[i1].y) * 0.5f;
+    IM_FIXNORMAL2F(dm_x, dm_y);
+    dm_x *= half_size;
+    dm_y *= half_size;
+    out_vtx[0].x = points[i1].x + dm_x;
+    out_vtx[0].y = points[i1].y + dm_y;
+    out_vtx[1].x = points[i1].x - dm_x;
+    out_vtx[1].y = points[i1].y - dm_y;
+}
+
+// Same with an inner and outer offset: point + outer, point + inner, point - inner, point - outer
+static inline void ImDrawList_ComputeJoinPoint4(const ImVec2* points, const ImVec2* normals, const int i0, const int i1, const float half_inner_size, const float half_outer_size, ImVec2* out_vtx)
+{
+    float dm_x = (normals[i0].x + normals[i1].x) * 0.5f;
+    float dm_y = (normals[i0].y + normals[i1].y) * 0.5f;
+    IM_FIXNORMAL2F(dm_x, dm_y);
+    float dm_out_x = dm_x * half_outer_size;
+    float dm_out_y = dm_y * half_outer_size;
+    float dm_in_x = dm_x * half_inner_size;
+    float dm_in_y = dm_y * half_inner_size;
+    out_vtx[0].x = points[i1].x + dm_out_x;
+    out_vtx[0].y = points[i1].y + dm_out_y;
+    out_vtx[1].x = points[i1].x + dm_in_x;
+    out_vtx[1].y = points[i1].y + dm_in_y;
+    out_vtx[2].x = points[i1].x - dm_in_x;
+    out_vtx[2].y = points[i1].y - dm_in_y;
+    out_vtx[3].x = points[i1].x - dm_out_x;
+    out_vtx[3].y = points[i1].y - dm_out_y;
+}
+
+// ImDrawList_ComputeJoinPoint2() for each point in [begin, points_count) into out_points[i * 2], point 0 wraps around to the last normal
+static void ImDrawList_ComputeJoinPoints2(const ImVec2* points, const ImVec2* normals, const int points_count, int begin, const float half_size, ImVec2* out_points)
+{
+    if (begin == 0)
+        ImDrawList_ComputeJoinPoint2(points, normals, points_count - 1, begin++, half_size, &out_points[0]);
+    int i = begin;
+#ifdef IM_VEC2X_WIDTH
+    const ImVec2x size_x = ImVec2x_Set1(half_size);
+    for (; i + IM_VEC2X_WIDTH * 2 <= points_count; i += IM_VEC2X_WIDTH * 2)
+        for (int j = i; j < i + IM_VEC2X_WIDTH * 2; j += IM_VEC2X_WIDTH)
+        {
+            ImVec2x dm = ImVec2x_Mul(ImVec2x_JoinNormals(normals + j), size_x);
+            ImVec2x p = ImVec2x_Load(points + j);
+            ImVec2x_Store2(out_points + j * 2, ImVec2x_Add(p, dm), ImVec2x_Sub(p, dm));
+        }
+#endif
+    for (; i < points_count; i++)
+        ImDrawList_ComputeJoinPoint2(points, normals, i - 1, i, half_size, &out_points[i * 2]);
+}
+
+// ImDrawList_ComputeJoinPoint4() for each point in [begin, points_count) into out_points[i * 4], point 0 wraps around to the last normal
+static void ImDrawList_ComputeJoinPoints4(const ImVec2* points, const ImVec2* normals, const int points_count, int begin, const float half_inner_size, const float half_outer_size, ImVec2* out_points)
+{
+    if (begin == 0)
+        ImDrawList_ComputeJoinPoint4(points, normals, points_count - 1, begin++, half_inner_size, half_outer_size, &out_points[0]);
+    int i = begin;
+#ifdef IM_VEC2X_WIDTH
+    const ImVec2x inner_x = ImVec2x_Set1(half_inner_size);
+    const ImVec2x outer_x = ImVec2x_Set1(half_outer_size);
+    for (; i + IM_VEC2X_WIDTH * 2 <= points_count; i += IM_VEC2X_WIDTH * 2)
+        for (int j = i; j < i + IM_VEC2X_WIDTH * 2; j += IM_VEC2X_WIDTH)
+        {
+            ImVec2x dm = ImVec2x_JoinNormals(normals + j);
+            ImVec2x dm_out = ImVec2x_Mul(dm, outer_x);
+            ImVec2x dm_in = ImVec2x_Mul(dm, inner_x);
+            ImVec2x p = ImVec2x_Load(points + j);
+            ImVec2x_Store4(out_points + j * 4, ImVec2x_Add(p, dm_out), ImVec2x_Add(p, dm_in), ImVec2x_Sub(p, dm_in), ImVec2x_Sub(p, dm_out));
+        }
+#endif
+    for (; i < points_count; i++)
+        ImDrawList_ComputeJoinPoint4(points, normals, i - 1, i, half_inner_size, half_outer_size, &out_points[i * 4]);
+}
+
 // TODO: Thickness anti-aliased lines cap are missing their AA fringe.
 // We avoid using the ImVec2 math operators here to reduce cost to a minimum for debug/non-inlined builds.
 void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32 col, ImDrawFlags flags, float thickness)
@@ -820,7 +1140,7 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         const bool use_texture = (Flags & ImDrawListFlags_AntiAliasedLinesUseTex) && (integer_thickness < IM_DRAWLIST_TEX_LINES_WIDTH_MAX) && (fractional_thickness <= 0.00001f) && (AA_SIZE == 1.0f);
 
         // We should never hit this, because NewFrame() doesn't set ImDrawListFlags_AntiAliasedLinesUseTex unless ImFontAtlasFlags_NoBakedLines is off
-        IM_ASSERT_PARANOID(!use_texture || !(_Data->Font->ContainerAtlas->Flags & ImFontAtlasFlags_NoBakedLines));
+        IM_ASSERT_PARANOID(!use_texture || !(_Data->Font->ContainerAtlas->Flags & (ImFontAtlasFlags_NoBakedLines | ImFontAtlasFlags_SDF)));
 
         const int idx_count = use_texture ? (count * 6) : (thick_line ? count * 18 : count * 12);
         const int vtx_count = use_texture ? (points_count * 2) : (thick_line ? points_count * 4 : points_count * 3);
@@ -833,15 +1153,7 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         ImVec2* temp_points = temp_normals + points_count;
 
         // Calculate normals (tangents) for each line segment
-        for (int i1 = 0; i1 < count; i1++)
-        {
-            const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
-            float dx = points[i2].x - points[i1].x;
-            float dy = points[i2].y - points[i1].y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i1].x = dy;
-            temp_normals[i1].y = -dx;
-        }
+        ImDrawList_ComputeNormals(points, points_count, count, temp_normals);
         if (!closed)
             temp_normals[points_count - 1] = temp_normals[points_count - 2];
 
@@ -858,38 +1170,25 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             //   allow scaling geometry while preserving one-screen-pixel AA fringe).
             const float half_draw_size = use_texture ? ((thickness * 0.5f) + 1) : AA_SIZE;
 
-            // If line is not closed, the first and last points need to be generated differently as there are no normals to blend
+            // If line is not closed, the first point needs to be generated differently as there are no normals to blend
+            // (the last one blends its normal with the copy made above)
             if (!closed)
             {
                 temp_points[0] = points[0] + temp_normals[0] * half_draw_size;
                 temp_points[1] = points[0] - temp_normals[0] * half_draw_size;
-                temp_points[(points_count-1)*2+0] = points[points_count-1] + temp_normals[points_count-1] * half_draw_size;
-                temp_points[(points_count-1)*2+1] = points[points_count-1] - temp_normals[points_count-1] * half_draw_size;
             }
 
-            // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
-            // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
+            // Add temporary vertices for the outer edges, averaging the normals of the segments on each side of a point.
+            // Points are offset to the outer edge of the AA area. In a closed line the first point blends with the final segment.
+            ImDrawList_ComputeJoinPoints2(points, temp_normals, points_count, closed ? 0 : 1, half_draw_size, temp_points);
+
+            // Generate the indices to form a number of triangles for each line segment
             // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
             unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
             for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
             {
-                const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1; // i2 is the second point of the line segment
                 const unsigned int idx2 = ((i1 + 1) == points_count) ? _VtxCurrentIdx : (idx1 + (use_texture ? 2 : 3)); // Vertex index for end of segment
 
-                // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y);
-                dm_x *= half_draw_size; // dm_x, dm_y are offset to the outer edge of the AA area
-                dm_y *= half_draw_size;
-
-                // Add temporary vertices for the outer edges
-                ImVec2* out_vtx = &temp_points[i2 * 2];
-                out_vtx[0].x = points[i2].x + dm_x;
-                out_vtx[0].y = points[i2].y + dm_y;
-                out_vtx[1].x = points[i2].x - dm_x;
-                out_vtx[1].y = points[i2].y - dm_y;
-
                 if (use_texture)
                 {
                     // Add indices for two triangles
@@ -949,49 +1248,27 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             // [PATH 2] Non texture-based lines (thick): we need to draw the solid line core and thus require four vertices per point
             const float half_inner_thickness = (thickness - AA_SIZE) * 0.5f;
 
-            // If line is not closed, the first and last points need to be generated differently as there are no normals to blend
+            // If line is not closed, the first point needs to be generated differently as there are no normals to blend
+            // (the last one blends its normal with the copy made above)
             if (!closed)
             {
-                const int points_last = points_count - 1;
                 temp_points[0] = points[0] + temp_normals[0] * (half_inner_thickness + AA_SIZE);
                 temp_points[1] = points[0] + temp_normals[0] * (half_inner_thickness);
                 temp_points[2] = points[0] - temp_normals[0] * (half_inner_thickness);
                 temp_points[3] = points[0] - temp_normals[0] * (half_inner_thickness + AA_SIZE);
-                temp_points[points_last * 4 + 0] = points[points_last] + temp_normals[points_last] * (half_inner_thickness + AA_SIZE);
-                temp_points[points_last * 4 + 1] = points[points_last] + temp_normals[points_last] * (half_inner_thickness);
-                temp_points[points_last * 4 + 2] = points[points_last] - temp_normals[points_last] * (half_inner_thickness);
-                temp_points[points_last * 4 + 3] = points[points_last] - temp_normals[points_last] * (half_inner_thickness + AA_SIZE);
             }
 
-            // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
-            // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
+            // Add temporary vertices, averaging the normals of the segments on each side of a point.
+            // In a closed line the first point blends with the final segment.
+            ImDrawList_ComputeJoinPoints4(points, temp_normals, points_count, closed ? 0 : 1, half_inner_thickness, half_inner_thickness + AA_SIZE, temp_points);
+
+            // Generate the indices to form a number of triangles for each line segment
             // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
             unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
             for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
             {
-                const int i2 = (i1 + 1) == points_count ? 0 : (i1 + 1); // i2 is the second point of the line segment
                 const unsigned int idx2 = (i1 + 1) == points_count ? _VtxCurrentIdx : (idx1 + 4); // Vertex index for end of segment
 
-                // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y);
-                float dm_out_x = dm_x * (half_inner_thickness + AA_SIZE);
-                float dm_out_y = dm_y * (half_inner_thickness + AA_SIZE);
-                float dm_in_x = dm_x * half_inner_thickness;
-                float dm_in_y = dm_y * half_inner_thickness;
-
-                // Add temporary vertices
-                ImVec2* out_vtx = &temp_points[i2 * 4];
-                out_vtx[0].x = points[i2].x + dm_out_x;
-                out_vtx[0].y = points[i2].y + dm_out_y;
-                out_vtx[1].x = points[i2].x + dm_in_x;
-                out_vtx[1].y = points[i2].y + dm_in_y;
-                out_vtx[2].x = points[i2].x - dm_in_x;
-                out_vtx[2].y = points[i2].y - dm_in_y;
-                out_vtx[3].x = points[i2].x - dm_out_x;
-                out_vtx[3].y = points[i2].y - dm_out_y;
-
                 // Add indexes
                 _IdxWritePtr[0]  = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[1]  = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[2]  = (ImDrawIdx)(idx1 + 2);
                 _IdxWritePtr[3]  = (ImDrawIdx)(idx1 + 2); _IdxWritePtr[4]  = (ImDrawIdx)(idx2 + 2); _IdxWritePtr[5]  = (ImDrawIdx)(idx2 + 1);
@@ -1035,10 +1312,10 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             dx *= (thickness * 0.5f);
             dy *= (thickness * 0.5f);
 
-            _VtxWritePtr[0].pos.x = p1.x + dy; _VtxWritePtr[0].pos.y = p1.y - dx; _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col;
-            _VtxWritePtr[1].pos.x = p2.x + dy; _VtxWritePtr[1].pos.y = p2.y - dx; _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col;
-            _VtxWritePtr[2].pos.x = p2.x - dy; _VtxWritePtr[2].pos.y = p2.y + dx; _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col;
-            _VtxWritePtr[3].pos.x = p1.x - dy; _VtxWritePtr[3].pos.y = p1.y + dx; _VtxWritePtr[3].uv = opaque_uv; _VtxWritePtr[3].col = col;
+            _VtxWritePtr[0].pos = ImVec2(p1.x + dy, p1.y - dx); _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col;
+            _VtxWritePtr[1].pos = ImVec2(p2.x + dy, p2.y - dx); _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col;
+            _VtxWritePtr[2].pos = ImVec2(p2.x - dy, p2.y + dx); _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col;
+            _VtxWritePtr[3].pos = ImVec2(p1.x - dy, p1.y + dx); _VtxWritePtr[3].uv = opaque_uv; _VtxWritePtr[3].col = col;
             _VtxWritePtr += 4;
 
             _IdxWritePtr[0] = (ImDrawIdx)(_VtxCurrentIdx); _IdxWritePtr[1] = (ImDrawIdx)(_VtxCurrentIdx + 1); _IdxWritePtr[2] = (ImDrawIdx)(_VtxCurrentIdx + 2);
@@ -1076,34 +1353,19 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
             _IdxWritePtr += 3;
         }
 
-        // Compute normals
-        _Data->TempBuffer.reserve_discard(points_count);
+        // Compute normals, then the outer and inner fringe points from the averaged normals
+        // (the first points_count items are normals, then 2 temp points for each polygon point: outer, inner)
+        _Data->TempBuffer.reserve_discard(points_count * 3);
         ImVec2* temp_normals = _Data->TempBuffer.Data;
-        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
-        {
-            const ImVec2& p0 = points[i0];
-            const ImVec2& p1 = points[i1];
-            float dx = p1.x - p0.x;
-            float dy = p1.y - p0.y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i0].x = dy;
-            temp_normals[i0].y = -dx;
-        }
+        ImVec2* temp_points = temp_normals + points_count;
+        ImDrawList_ComputeNormals(points, points_count, points_count, temp_normals);
+        ImDrawList_ComputeJoinPoints2(points, temp_normals, points_count, 0, AA_SIZE * 0.5f, temp_points);
 
         for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
         {
-            // Average normals
-            const ImVec2& n0 = temp_normals[i0];
-            const ImVec2& n1 = temp_normals[i1];
-            float dm_x = (n0.x + n1.x) * 0.5f;
-            float dm_y = (n0.y + n1.y) * 0.5f;
-            IM_FIXNORMAL2F(dm_x, dm_y);
-            dm_x *= AA_SIZE * 0.5f;
-            dm_y *= AA_SIZE * 0.5f;
-
             // Add vertices
-            _VtxWritePtr[0].pos.x = (points[i1].x - dm_x); _VtxWritePtr[0].pos.y = (points[i1].y - dm_y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
-            _VtxWritePtr[1].pos.x = (points[i1].x + dm_x); _VtxWritePtr[1].pos.y = (points[i1].y + dm_y); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
+            _VtxWritePtr[0].pos = temp_points[i1 * 2 + 1]; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
+            _VtxWritePtr[1].pos = temp_points[i1 * 2 + 0]; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
             _VtxWritePtr += 2;
 
             // Add indexes for fringes
@@ -1731,12 +1993,17 @@ void ImDrawList::AddImage(ImTextureRef tex_ref, const ImVec2& p_min, const ImVec
     if ((col & IM_COL32_A_MASK) == 0)
         return;
 
+    // Images registered with ImFontAtlas::AddUserImage() are drawn from the atlas texture
+    ImVec2 uvs[2] = { uv_min, uv_max };
+    if (tex_ref._TexData == NULL && _Data->FontAtlas != NULL && _Data->FontAtlas->UserImages.Size > 0)
+        ImFontAtlasUserImageRemap(_Data->FontAtlas, &tex_ref, uvs, 2);
+
     const bool push_texture_id = tex_ref != _CmdHeader.TexRef;
     if (push_texture_id)
         PushTexture(tex_ref);
 
     PrimReserve(6, 4);
-    PrimRectUV(p_min, p_max, uv_min, uv_max, col);
+    PrimRectUV(p_min, p_max, uvs[0], uvs[1], col);
 
     if (push_texture_id)
         PopTexture();
@@ -1747,12 +2014,16 @@ void ImDrawList::AddImageQuad(ImTextureRef tex_ref, const ImVec2& p1, const ImVe
     if ((col & IM_COL32_A_MASK) == 0)
         return;
 
+    ImVec2 uvs[4] = { uv1, uv2, uv3, uv4 };
+    if (tex_ref._TexData == NULL && _Data->FontAtlas != NULL && _Data->FontAtlas->UserImages.Size > 0)
+        ImFontAtlasUserImageRemap(_Data->FontAtlas, &tex_ref, uvs, 4);
+
     const bool push_texture_id = tex_ref != _CmdHeader.TexRef;
     if (push_texture_id)
         PushTexture(tex_ref);
 
     PrimReserve(6, 4);
-    PrimQuadUV(p1, p2, p3, p4, uv1, uv2, uv3, uv4, col);
+    PrimQuadUV(p1, p2, p3, p4, uvs[0], uvs[1], uvs[2], uvs[3], col);
 
     if (push_texture_id)
         PopTexture();
@@ -1770,6 +2041,10 @@ void ImDrawList::AddImageRounded(ImTextureRef tex_ref, const ImVec2& p_min, cons
         return;
     }
 
+    ImVec2 uvs[2] = { uv_min, uv_max };
+    if (tex_ref._TexData == NULL && _Data->FontAtlas != NULL && _Data->FontAtlas->UserImages.Size > 0)
+        ImFontAtlasUserImageRemap(_Data->FontAtlas, &tex_ref, uvs, 2);
+
     const bool push_texture_id = tex_ref != _CmdHeader.TexRef;
     if (push_texture_id)
         PushTexture(tex_ref);
@@ -1778,7 +2053,7 @@ void ImDrawList::AddImageRounded(ImTextureRef tex_ref, const ImVec2& p_min, cons
     PathRect(p_min, p_max, rounding, flags);
     PathFillConvex(col);
     int vert_end_idx = VtxBuffer.Size;
-    ImGui::ShadeVertsLinearUV(this, vert_start_idx, vert_end_idx, p_min, p_max, uv_min, uv_max, true);
+    ImGui::ShadeVertsLinearUV(this, vert_start_idx, vert_end_idx, p_min, p_max, uvs[0], uvs[1], true);
 
     if (push_texture_id)
         PopTexture();
@@ -1807,8 +2082,12 @@ struct ImTriangulatorNode
     ImTriangulatorNodeType  Type;
     int                     Index;
     ImVec2                  Pos;
+    int                     SpanIndex;      // Position in _Ears or _Reflexes, whichever matches Type
+    int                     GridCell;       // Cell in the reflex grid while in _Reflexes
     ImTriangulatorNode*     Next;
     ImTriangulatorNode*     Prev;
+    ImTriangulatorNode*     GridNext;
+    ImTriangulatorNode*     GridPrev;
 
     void    Unlink()        { Next->Prev = Prev; Prev->Next = Next; }
 };
@@ -1818,14 +2097,20 @@ struct ImTriangulatorNodeSpan
     ImTriangulatorNode**    Data = NULL;
     int                     Size = 0;
 
-    void    push_back(ImTriangulatorNode* node) { Data[Size++] = node; }
-    void    find_erase_unsorted(int idx)        { for (int i = Size - 1; i >= 0; i--) if (Data[i]->Index == idx) { Data[i] = Data[Size - 1]; Size--; return; } }
+    void    push_back(ImTriangulatorNode* node) { node->SpanIndex = Size; Data[Size++] = node; }
+    bool    erase_unsorted(ImTriangulatorNode* node) { int idx = node->SpanIndex; if (idx < 0 || idx >= Size || Data[idx] != node) return false; Data[idx] = Data[Size - 1]; Data[idx]->SpanIndex = idx; Size--; return true; } // Ignore nodes with a stale Type
 };
 
+// Above this many reflex vertices, IsEar() only tests the reflexes found in the grid cells overlapped by the candidate triangle
+// instead of scanning all of them, which otherwise makes triangulating large polygons O(N^2).
+#ifndef IM_TRIANGULATOR_GRID_MIN_REFLEXES
+#define IM_TRIANGULATOR_GRID_MIN_REFLEXES   32
+#endif
+
 struct ImTriangulator
 {
     static int EstimateTriangleCount(int points_count)      { return (points_count < 3) ? 0 : points_count - 2; }
-    static int EstimateScratchBufferSize(int points_count)  { return sizeof(ImTriangulatorNode) * points_count + sizeof(ImTriangulatorNode*) * points_count * 2; }
+    static int EstimateScratchBufferSize(int points_count)  { return sizeof(ImTriangulatorNode) * points_count + sizeof(ImTriangulatorNode*) * points_count * 3; }
 
     void    Init(const ImVec2* points, int points_count, void* scratch_buffer);
     void    GetNextTriangle(unsigned int out_triangle[3]);     // Return relative indexes for next triangle
@@ -1834,6 +2119,11 @@ struct ImTriangulator
     void    BuildNodes(const ImVec2* points, int points_count);
     void    BuildReflexes();
     void    BuildEars();
+    void    BuildGrid();
+    void    GridAdd(ImTriangulatorNode* node);
+    void    GridRemove(ImTriangulatorNode* node);
+    int     GridCellX(float x) const { return (int)ImClamp((x - _GridMin.x) * _GridInvCellSize.x, 0.0f, (float)(_GridSize[0] - 1)); }
+    int     GridCellY(float y) const { return (int)ImClamp((y - _GridMin.y) * _GridInvCellSize.y, 0.0f, (float)(_GridSize[1] - 1)); }
     void    FlipNodeList();
     bool    IsEar(int i0, int i1, int i2, const ImVec2& v0, const ImVec2& v1, const ImVec2& v2) const;
     void    ReclassifyNode(ImTriangulatorNode* node);
@@ -1843,6 +2133,12 @@ struct ImTriangulator
     ImTriangulatorNode*     _Nodes = NULL;
     ImTriangulatorNodeSpan  _Ears;
     ImTriangulatorNodeSpan  _Reflexes;
+    ImTriangulatorNode**    _GridCells = NULL;      // Head of each cell's reflex list, NULL when the grid is not used
+    int                     _GridSize[2] = { 0, 0 };
+    ImVec2                  _GridMin;
+    ImVec2                  _GridInvCellSize;
+    ImTriangulatorNode**    _GridStorage = NULL;    // points_count cells available in the scratch buffer
+    int                     _GridCapacity = 0;
 };
 
 // Distribute storage for nodes, ears and reflexes.
@@ -1855,8 +2151,11 @@ void ImTriangulator::Init(const ImVec2* points, int points_count, void* scratch_
     _Nodes         = (ImTriangulatorNode*)scratch_buffer;                          // points_count x Node
     _Ears.Data     = (ImTriangulatorNode**)(_Nodes + points_count);                // points_count x Node*
     _Reflexes.Data = (ImTriangulatorNode**)(_Nodes + points_count) + points_count; // points_count x Node*
+    _GridStorage   = (ImTriangulatorNode**)(_Nodes + points_count) + points_count * 2; // points_count x Node*
+    _GridCapacity  = points_count;
     BuildNodes(points, points_count);
     BuildReflexes();
+    BuildGrid();
     BuildEars();
 }
 
@@ -1867,8 +2166,10 @@ void ImTriangulator::BuildNodes(const ImVec2* points, int points_count)
         _Nodes[i].Type = ImTriangulatorNodeType_Convex;
         _Nodes[i].Index = i;
         _Nodes[i].Pos = points[i];
+        _Nodes[i].SpanIndex = -1;
         _Nodes[i].Next = _Nodes + i + 1;
         _Nodes[i].Prev = _Nodes + i - 1;
+        _Nodes[i].GridNext = _Nodes[i].GridPrev = NULL;
     }
     _Nodes[0].Prev = _Nodes + points_count - 1;
     _Nodes[points_count - 1].Next = _Nodes;
@@ -1900,6 +2201,52 @@ void ImTriangulator::BuildEars()
     }
 }
 
+// Bucket reflexes in a uniform grid of about one cell per reflex over their bounding box. The grid holds the same nodes as _Reflexes.
+void ImTriangulator::BuildGrid()
+{
+    _GridCells = NULL;
+    const int reflexes_count = _Reflexes.Size;
+    if (reflexes_count < IM_TRIANGULATOR_GRID_MIN_REFLEXES)
+        return;
+
+    ImRect bb(_Reflexes.Data[0]->Pos, _Reflexes.Data[0]->Pos);
+    for (int i = 1; i < reflexes_count; i++)
+        bb.Add(_Reflexes.Data[i]->Pos);
+    const float w = bb.GetWidth();
+    const float h = bb.GetHeight();
+    const float aspect = (w + 1.0f) / (h + 1.0f);
+    _GridSize[0] = ImClamp((int)ImSqrt((float)reflexes_count * aspect), 1, reflexes_count);
+    _GridSize[1] = ImClamp(reflexes_count / _GridSize[0], 1, reflexes_count);
+    IM_ASSERT(_GridSize[0] * _GridSize[1] <= _GridCapacity);
+    _GridMin = bb.Min;
+    _GridInvCellSize = ImVec2(w > 0.0f ? _GridSize[0] / w : 0.0f, h > 0.0f ? _GridSize[1] / h : 0.0f);
+    _GridCells = _GridStorage;
+    memset(_GridCells, 0, sizeof(ImTriangulatorNode*) * _GridSize[0] * _GridSize[1]);
+    for (int i = 0; i < reflexes_count; i++)
+        GridAdd(_Reflexes.Data[i]);
+}
+
+void ImTriangulator::GridAdd(ImTriangulatorNode* node)
+{
+    const int cell = GridCellY(node->Pos.y) * _GridSize[0] + GridCellX(node->Pos.x);
+    node->GridCell = cell;
+    node->GridPrev = NULL;
+    node->GridNext = _GridCells[cell];
+    if (node->GridNext)
+        node->GridNext->GridPrev = node;
+    _GridCells[cell] = node;
+}
+
+void ImTriangulator::GridRemove(ImTriangulatorNode* node)
+{
+    if (node->GridPrev)
+        node->GridPrev->GridNext = node->GridNext;
+    else
+        _GridCells[node->GridCell] = node->GridNext;
+    if (node->GridNext)
+        node->GridNext->GridPrev = node->GridPrev;
+}
+
 void ImTriangulator::GetNextTriangle(unsigned int out_triangle[3])
 {
     if (_Ears.Size == 0)
@@ -1911,6 +2258,7 @@ void ImTriangulator::GetNextTriangle(unsigned int out_triangle[3])
             node->Type = ImTriangulatorNodeType_Convex;
         _Reflexes.Size = 0;
         BuildReflexes();
+        BuildGrid();
         BuildEars();
 
         // If we still don't have ears, it means geometry is degenerated.
@@ -1962,6 +2310,51 @@ void ImTriangulator::FlipNodeList()
 // A triangle is an ear is no other vertex is inside it. We can test reflexes vertices only (see reference algorithm)
 bool ImTriangulator::IsEar(int i0, int i1, int i2, const ImVec2& v0, const ImVec2& v1, const ImVec2& v2) const
 {
+    // Only reflexes inside the triangle's bounding box can be inside the triangle. Large triangles (typically once most reflexes
+    // have been clipped) may overlap more cells than there are reflexes left, scan the list instead.
+    const int x0 = _GridCells ? GridCellX(ImMin(ImMin(v0.x, v1.x), v2.x)) : 0, x1 = _GridCells ? GridCellX(ImMax(ImMax(v0.x, v1.x), v2.x)) : 0;
+    const int y0 = _GridCells ? GridCellY(ImMin(ImMin(v0.y, v1.y), v2.y)) : 0, y1 = _GridCells ? GridCellY(ImMax(ImMax(v0.y, v1.y), v2.y)) : 0;
+    if (_GridCells != NULL && (x1 - x0 + 1) * (y1 - y0 + 1) < _Reflexes.Size)
+    {
+        const ImVec2* tri[3] = { &v0, &v1, &v2 };
+        for (int y = y0; y <= y1; y++)
+        {
+            // Narrow each row to the part of the triangle inside it: ear clipping produces many thin diagonal triangles.
+            // Rows are slightly enlarged so rounding never misses a point sitting on a cell boundary.
+            int row_x0 = x0, row_x1 = x1;
+            if (y0 != y1)
+            {
+                const float row_min_y = (y == 0) ? -FLT_MAX : _GridMin.y + (y - 0.01f) / _GridInvCellSize.y;
+                const float row_max_y = (y == _GridSize[1] - 1) ? FLT_MAX : _GridMin.y + (y + 1.01f) / _GridInvCellSize.y;
+                float row_min_x = FLT_MAX, row_max_x = -FLT_MAX;
+                for (int n = 0; n < 3; n++)
+                {
+                    const ImVec2& a = *tri[n];
+                    const ImVec2& b = *tri[(n + 1) % 3];
+                    const float seg_min_y = ImMax(ImMin(a.y, b.y), row_min_y);
+                    const float seg_max_y = ImMin(ImMax(a.y, b.y), row_max_y);
+                    if (seg_min_y > seg_max_y)
+                        continue;
+                    const float dx_dy = (a.y != b.y) ? (b.x - a.x) / (b.y - a.y) : 0.0f;
+                    const float xa = (a.y != b.y) ? a.x + (seg_min_y - a.y) * dx_dy : a.x;
+                    const float xb = (a.y != b.y) ? a.x + (seg_max_y - a.y) * dx_dy : b.x;
+                    row_min_x = ImMin(row_min_x, ImMin(xa, xb));
+                    row_max_x = ImMax(row_max_x, ImMax(xa, xb));
+                }
+                if (row_min_x > row_max_x)
+                    continue;
+                row_x0 = ImMax(x0, (int)ImClamp((row_min_x - _GridMin.x) * _GridInvCellSize.x - 0.01f, 0.0f, (float)(_GridSize[0] - 1)));
+                row_x1 = ImMin(x1, (int)ImClamp((row_max_x - _GridMin.x) * _GridInvCellSize.x + 0.01f, 0.0f, (float)(_GridSize[0] - 1)));
+            }
+            for (int x = row_x0; x <= row_x1; x++)
+                for (const ImTriangulatorNode* reflex = _GridCells[y * _GridSize[0] + x]; reflex != NULL; reflex = reflex->GridNext)
+                    if (reflex->Index != i0 && reflex->Index != i1 && reflex->Index != i2)
+                        if (ImTriangleContainsPoint(v0, v1, v2, reflex->Pos))
+                            return false;
+        }
+        return true;
+    }
+
     ImTriangulatorNode** p_end = _Reflexes.Data + _Reflexes.Size;
     for (ImTriangulatorNode** p = _Reflexes.Data; p < p_end; p++)
     {
@@ -1990,11 +2383,18 @@ void ImTriangulator::ReclassifyNode(ImTriangulatorNode* n1)
     if (type == n1->Type)
         return;
     if (n1->Type == ImTriangulatorNodeType_Reflex)
-        _Reflexes.find_erase_unsorted(n1->Index);
+    {
+        if (_Reflexes.erase_unsorted(n1) && _GridCells != NULL)
+            GridRemove(n1);
+    }
     else if (n1->Type == ImTriangulatorNodeType_Ear)
-        _Ears.find_erase_unsorted(n1->Index);
+        _Ears.erase_unsorted(n1);
     if (type == ImTriangulatorNodeType_Reflex)
+    {
         _Reflexes.push_back(n1);
+        if (_GridCells != NULL)
+            GridAdd(n1);
+    }
     else if (type == ImTriangulatorNodeType_Ear)
         _Ears.push_back(n1);
     n1->Type = type;
@@ -2035,34 +2435,19 @@ void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_cou
             _IdxWritePtr += 3;
         }
 
-        // Compute normals
-        _Data->TempBuffer.reserve_discard(points_count);
+        // Compute normals, then the outer and inner fringe points from the averaged normals
+        // (the first points_count items are normals, then 2 temp points for each polygon point: outer, inner)
+        _Data->TempBuffer.reserve_discard(points_count * 3);
         ImVec2* temp_normals = _Data->TempBuffer.Data;
-        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
-        {
-            const ImVec2& p0 = points[i0];
-            const ImVec2& p1 = points[i1];
-            float dx = p1.x - p0.x;
-            float dy = p1.y - p0.y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i0].x = dy;
-            temp_normals[i0].y = -dx;
-        }
+        ImVec2* temp_points = temp_normals + points_count;
+        ImDrawList_ComputeNormals(points, points_count, points_count, temp_normals);
+        ImDrawList_ComputeJoinPoints2(points, temp_normals, points_count, 0, AA_SIZE * 0.5f, temp_points);
 
         for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
         {
-            // Average normals
-            const ImVec2& n0 = temp_normals[i0];
-            const ImVec2& n1 = temp_normals[i1];
-            float dm_x = (n0.x + n1.x) * 0.5f;
-            float dm_y = (n0.y + n1.y) * 0.5f;
-            IM_FIXNORMAL2F(dm_x, dm_y);
-            dm_x *= AA_SIZE * 0.5f;
-            dm_y *= AA_SIZE * 0.5f;
-
             // Add vertices
-            _VtxWritePtr[0].pos.x = (points[i1].x - dm_x); _VtxWritePtr[0].pos.y = (points[i1].y - dm_y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
-            _VtxWritePtr[1].pos.x = (points[i1].x + dm_x); _VtxWritePtr[1].pos.y = (points[i1].y + dm_y); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
+            _VtxWritePtr[0].pos = temp_points[i1 * 2 + 1]; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
+            _VtxWritePtr[1].pos = temp_points[i1 * 2 + 0]; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
             _VtxWritePtr += 2;
 
             // Add indexes for fringes
@@ -2100,24 +2485,52 @@ void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_cou
 //-----------------------------------------------------------------------------
 // FIXME: This may be a little confusing, trying to be a little too low-level/optimal instead of just doing vector swap..
 //-----------------------------------------------------------------------------
+// In-place mode (default, disable with IMGUI_DISABLE_SPLITTER_IN_PLACE_MERGE):
+// - Split() reserves one range per channel in the parent IdxBuffer, ordered and sized after the layout recorded by the previous Merge().
+// - Channels still own their CmdBuffer, but write indices straight into their range: while a channel is current, IdxBuffer.Size is its write position.
+// - A channel outgrowing its range moves the ranges laid out after it to the end of the buffer (see _ReserveIdxRange()).
+//   Indices already written by the current channel never move: on channel 0 the command started before Split() relies on them.
+// - Merge() only stitches commands. Unused reservations between ranges are filled with degenerate triangles, so the last command of a channel
+//   and the first command of the next one can still be merged into a single draw call. Channels that ended up out of order (first frame,
+//   or a channel was moved) are compacted instead, which costs about the same as the copying mode.
+// - A split nested inside another in-place split of the same draw list uses the copying mode.
+//-----------------------------------------------------------------------------
+
+// Size of the range reserved for a channel that wrote 'idx_count' indices last time. Kept a multiple of 3 so gaps between ranges are whole triangles.
+static inline int ImDrawListSplitter_CalcIdxReserve(int idx_count)
+{
+    const int reserve = idx_count + idx_count / 16 + 6;
+    return reserve - reserve % 3;
+}
 
 void ImDrawListSplitter::ClearFreeMemory()
 {
     for (int i = 0; i < _Channels.Size; i++)
     {
         if (i == _Current)
-            memset(&_Channels[i], 0, sizeof(_Channels[i]));  // Current channel is a copy of CmdBuffer/IdxBuffer, don't destruct again
+        {
+            // Current channel is a copy of CmdBuffer/IdxBuffer, don't destruct again (in-place mode only shares CmdBuffer)
+            memset(&_Channels[i]._CmdBuffer, 0, sizeof(_Channels[i]._CmdBuffer));
+            memset(&_Channels[i]._GlyphBuffer, 0, sizeof(_Channels[i]._GlyphBuffer));
+            memset(&_Channels[i]._GlyphRuns, 0, sizeof(_Channels[i]._GlyphRuns));
+            if (!_InPlace)
+                memset(&_Channels[i]._IdxBuffer, 0, sizeof(_Channels[i]._IdxBuffer));
+        }
         _Channels[i]._CmdBuffer.clear();
         _Channels[i]._IdxBuffer.clear();
+        _Channels[i]._GlyphBuffer.clear();
+        _Channels[i]._GlyphRuns.clear();
     }
     _Current = 0;
     _Count = 1;
     _Channels.clear();
+    _InPlace = false;
+    _IdxLayout.clear();
+    _IdxTemp.clear();
 }
 
 void ImDrawListSplitter::Split(ImDrawList* draw_list, int channels_count)
 {
-    IM_UNUSED(draw_list);
     IM_ASSERT(_Current == 0 && _Count <= 1 && "Nested channel splitting is not supported. Please use separate instances of ImDrawListSplitter.");
     int old_channels_count = _Channels.Size;
     if (old_channels_count < channels_count)
@@ -2141,57 +2554,215 @@ void ImDrawListSplitter::Split(ImDrawList* draw_list, int channels_count)
         {
             _Channels[i]._CmdBuffer.resize(0);
             _Channels[i]._IdxBuffer.resize(0);
+            _Channels[i]._GlyphBuffer.resize(0);
+            _Channels[i]._GlyphRuns.resize(0);
         }
+        _Channels[i]._GlyphTailElemCount = 0;
+    }
+    for (int i = 0; i < channels_count; i++)
+    {
+        _Channels[i]._IdxStart = _Channels[i]._IdxEnd = -1;
+        _Channels[i]._IdxCount = _Channels[i]._IdxPeak = 0;
+        _Channels[i]._SplitIndex = i;
     }
+
+#ifndef IMGUI_DISABLE_SPLITTER_IN_PLACE_MERGE
+    // Lay out channel ranges after the current end of the index buffer.
+    // Reuse the merged order and sizes of last time when they match. Channel 0 always comes first as it continues the current command.
+    _InPlace = (draw_list->_IdxRangeSplitter == NULL);
+    if (_InPlace)
+    {
+        const bool use_layout = (_IdxLayout.Size == channels_count * 2 && _IdxLayout[0] == 0);
+        int idx_end = draw_list->IdxBuffer.Size;
+        for (int n = 0; n < channels_count; n++)
+        {
+            ImDrawChannel& ch = _Channels[use_layout ? _IdxLayout[n * 2] : n];
+            IM_ASSERT(ch._IdxStart == -1 && "Invalid channel layout.");
+            ch._IdxStart = idx_end;
+            idx_end += ImDrawListSplitter_CalcIdxReserve(use_layout ? _IdxLayout[n * 2 + 1] : 0);
+            ch._IdxEnd = idx_end;
+        }
+        _IdxEnd = idx_end;
+        if (idx_end > draw_list->IdxBuffer.Capacity)
+            draw_list->IdxBuffer.reserve(draw_list->IdxBuffer._grow_capacity(idx_end));
+        draw_list->_IdxWritePtr = draw_list->IdxBuffer.Data + draw_list->IdxBuffer.Size;
+        draw_list->_IdxRangeSplitter = this;
+        draw_list->_IdxRangeEnd = _Channels[0]._IdxEnd;
+    }
+#else
+    IM_UNUSED(draw_list);
+    _InPlace = false;
+#endif
 }
 
 void ImDrawListSplitter::Merge(ImDrawList* draw_list)
 {
     // Note that we never use or rely on _Channels.Size because it is merely a buffer that we never shrink back to 0 to keep all sub-buffers ready for use.
     if (_Count <= 1)
+    {
+        if (_InPlace && draw_list->_IdxRangeSplitter == this)
+            draw_list->_IdxRangeSplitter = NULL;
+        _InPlace = false;
         return;
+    }
 
+    draw_list->_CheckGlyphTail();
     SetCurrentChannel(draw_list, 0);
     draw_list->_PopUnusedDrawCmd();
 
+    // Append glyph instances of other channels after ours
+    for (int i = 1; i < _Count; i++)
+    {
+        ImDrawChannel& ch = _Channels[i];
+        if (ch._GlyphBuffer.Size == 0)
+            continue;
+        const int glyph_offset = draw_list->GlyphBuffer.Size;
+        draw_list->GlyphBuffer.resize(glyph_offset + ch._GlyphBuffer.Size);
+        memcpy(draw_list->GlyphBuffer.Data + glyph_offset, ch._GlyphBuffer.Data, (size_t)ch._GlyphBuffer.Size * sizeof(ImDrawGlyph));
+        for (ImDrawCmd& cmd : ch._CmdBuffer)
+            cmd.GlyphOffset += glyph_offset;
+    }
+
     // Calculate our final buffer sizes. Also fix the incorrect IdxOffset values in each command.
     int new_cmd_buffer_count = 0;
     int new_idx_buffer_count = 0;
     ImDrawCmd* last_cmd = (_Count > 0 && draw_list->CmdBuffer.Size > 0) ? &draw_list->CmdBuffer.back() : NULL;
-    int idx_offset = last_cmd ? last_cmd->IdxOffset + last_cmd->ElemCount : 0;
-    for (int i = 1; i < _Count; i++)
-    {
-        ImDrawChannel& ch = _Channels[i];
-        if (ch._CmdBuffer.Size > 0 && ch._CmdBuffer.back().ElemCount == 0 && ch._CmdBuffer.back().UserCallback == NULL) // Equivalent of PopUnusedDrawCmd()
-            ch._CmdBuffer.pop_back();
+    if (_InPlace)
+    {
+        // Indices are already in place. Channels laid out in merge order only leave unused reservations between them,
+        // otherwise (first frame, or a channel was moved by _ReserveIdxRange()) gather them and write them back contiguously.
+        ImDrawIdx* idx_data = draw_list->IdxBuffer.Data;
+        int idx_write = draw_list->IdxBuffer.Size;
+        _Channels[0]._IdxCount = idx_write - _Channels[0]._IdxStart;
+        bool in_order = true;
+        for (int i = 1, prev_start = _Channels[0]._IdxStart; i < _Count && in_order; i++)
+            if (_Channels[i]._IdxCount > 0)
+            {
+                in_order = (_Channels[i]._IdxStart > prev_start);
+                prev_start = _Channels[i]._IdxStart;
+            }
+        if (!in_order)
+        {
+            int idx_total = 0;
+            for (int i = 1; i < _Count; i++)
+                idx_total += _Channels[i]._IdxCount;
+            _IdxTemp.resize(idx_total);
+            for (int i = 1, idx_temp = 0; i < _Count; i++)
+            {
+                ImDrawChannel& ch = _Channels[i];
+                if (ch._IdxCount == 0)
+                    continue;
+                memcpy(_IdxTemp.Data + idx_temp, idx_data + ch._IdxStart, ch._IdxCount * sizeof(ImDrawIdx));
+                const int idx_delta = idx_write + idx_temp - ch._IdxStart;
+                for (ImDrawCmd& cmd : ch._CmdBuffer)
+                    cmd.IdxOffset += idx_delta;
+                ch._IdxStart += idx_delta;
+                idx_temp += ch._IdxCount;
+            }
+            memcpy(idx_data + idx_write, _IdxTemp.Data, idx_total * sizeof(ImDrawIdx));
+            draw_list->_Data->SplitterIdxBytes += (ImU64)idx_total * 2 * sizeof(ImDrawIdx);
+        }
 
-        if (ch._CmdBuffer.Size > 0 && last_cmd != NULL)
+        for (int i = 1; i < _Count; i++)
         {
-            // Do not include ImDrawCmd_AreSequentialIdxOffset() in the compare as we rebuild IdxOffset values ourselves.
-            // Manipulating IdxOffset (e.g. by reordering draw commands like done by RenderDimmedBackgroundBehindWindow()) is not supported within a splitter.
-            ImDrawCmd* next_cmd = &ch._CmdBuffer[0];
-            if (ImDrawCmd_HeaderCompare(last_cmd, next_cmd) == 0 && last_cmd->UserCallback == NULL && next_cmd->UserCallback == NULL)
+            ImDrawChannel& ch = _Channels[i];
+            if (ch._CmdBuffer.Size > 0 && ch._CmdBuffer.back().ElemCount == 0 && ch._CmdBuffer.back().GlyphCount == 0 && ch._CmdBuffer.back().UserCallback == NULL) // Equivalent of PopUnusedDrawCmd()
+                ch._CmdBuffer.pop_back();
+            if (ch._CmdBuffer.Size == 0)
+            {
+                IM_ASSERT(ch._IdxCount == 0);
+                continue;
+            }
+
+            // Fill the gap left by unused reservations with degenerate triangles, so commands on both sides may still be merged
+            int idx_gap = 0;
+            if (ch._IdxCount > 0)
             {
-                // Merge previous channel last draw command with current channel first draw command if matching.
-                last_cmd->ElemCount += next_cmd->ElemCount;
-                idx_offset += next_cmd->ElemCount;
-                ch._CmdBuffer.erase(ch._CmdBuffer.Data); // FIXME-OPT: Improve for multiple merges.
+                idx_gap = ch._IdxStart - idx_write;
+                IM_ASSERT(idx_gap >= 0);
+                const ImDrawIdx idx_fill = (idx_write > 0) ? idx_data[idx_write - 1] : (ImDrawIdx)0;
+                for (int n = idx_write; n < ch._IdxStart; n++)
+                    idx_data[n] = idx_fill;
+                draw_list->_Data->SplitterIdxBytes += (ImU64)idx_gap * sizeof(ImDrawIdx);
             }
+            else
+            {
+                for (ImDrawCmd& cmd : ch._CmdBuffer)
+                    cmd.IdxOffset = idx_write;
+            }
+
+            ImDrawCmd* next_cmd = &ch._CmdBuffer[0];
+            if (last_cmd != NULL && (idx_gap % 3) == 0 && last_cmd->IdxOffset + last_cmd->ElemCount == (unsigned int)idx_write)
+                if (ImDrawCmd_HeaderCompare(last_cmd, next_cmd) == 0 && last_cmd->UserCallback == NULL && next_cmd->UserCallback == NULL && last_cmd->GlyphCount == 0)
+                {
+                    // Merge previous channel last draw command with current channel first draw command if matching.
+                    last_cmd->ElemCount += idx_gap + next_cmd->ElemCount;
+                    last_cmd->GlyphOffset = next_cmd->GlyphOffset;
+                    last_cmd->GlyphCount = next_cmd->GlyphCount;
+                    ch._CmdBuffer.erase(ch._CmdBuffer.Data); // FIXME-OPT: Improve for multiple merges.
+                }
+            if (ch._CmdBuffer.Size > 0)
+                last_cmd = &ch._CmdBuffer.back();
+            if (ch._IdxCount > 0)
+                idx_write = ch._IdxStart + ch._IdxCount;
+            new_cmd_buffer_count += ch._CmdBuffer.Size;
+        }
+
+        // Trailing reservations are dropped. Record the merged order and sizes to lay out the next Split().
+        draw_list->IdxBuffer.Size = idx_write;
+        draw_list->_IdxRangeSplitter = NULL;
+        _IdxLayout.resize(_Count * 2);
+        for (int i = 0; i < _Count; i++)
+        {
+            _IdxLayout[i * 2] = _Channels[i]._SplitIndex;
+            _IdxLayout[i * 2 + 1] = ImMax(_Channels[i]._IdxCount, _Channels[i]._IdxPeak);
         }
-        if (ch._CmdBuffer.Size > 0)
-            last_cmd = &ch._CmdBuffer.back();
-        new_cmd_buffer_count += ch._CmdBuffer.Size;
-        new_idx_buffer_count += ch._IdxBuffer.Size;
-        for (int cmd_n = 0; cmd_n < ch._CmdBuffer.Size; cmd_n++)
+        _InPlace = false;
+    }
+    else
+    {
+        int idx_offset = last_cmd ? last_cmd->IdxOffset + last_cmd->ElemCount : 0;
+        for (int i = 1; i < _Count; i++)
         {
-            ch._CmdBuffer.Data[cmd_n].IdxOffset = idx_offset;
-            idx_offset += ch._CmdBuffer.Data[cmd_n].ElemCount;
+            ImDrawChannel& ch = _Channels[i];
+            if (ch._CmdBuffer.Size > 0 && ch._CmdBuffer.back().ElemCount == 0 && ch._CmdBuffer.back().GlyphCount == 0 && ch._CmdBuffer.back().UserCallback == NULL) // Equivalent of PopUnusedDrawCmd()
+                ch._CmdBuffer.pop_back();
+
+            if (ch._CmdBuffer.Size > 0 && last_cmd != NULL)
+            {
+                // Do not include ImDrawCmd_AreSequentialIdxOffset() in the compare as we rebuild IdxOffset values ourselves.
+                // Manipulating IdxOffset (e.g. by reordering draw commands like done by RenderDimmedBackgroundBehindWindow()) is not supported within a splitter.
+                ImDrawCmd* next_cmd = &ch._CmdBuffer[0];
+                if (ImDrawCmd_HeaderCompare(last_cmd, next_cmd) == 0 && last_cmd->UserCallback == NULL && next_cmd->UserCallback == NULL && last_cmd->GlyphCount == 0)
+                {
+                    // Merge previous channel last draw command with current channel first draw command if matching.
+                    last_cmd->ElemCount += next_cmd->ElemCount;
+                    last_cmd->GlyphOffset = next_cmd->GlyphOffset;
+                    last_cmd->GlyphCount = next_cmd->GlyphCount;
+                    idx_offset += next_cmd->ElemCount;
+                    ch._CmdBuffer.erase(ch._CmdBuffer.Data); // FIXME-OPT: Improve for multiple merges.
+                }
+            }
+            if (ch._CmdBuffer.Size > 0)
+                last_cmd = &ch._CmdBuffer.back();
+            new_cmd_buffer_count += ch._CmdBuffer.Size;
+            new_idx_buffer_count += ch._IdxBuffer.Size;
+            for (int cmd_n = 0; cmd_n < ch._CmdBuffer.Size; cmd_n++)
+            {
+                ch._CmdBuffer.Data[cmd_n].IdxOffset = idx_offset;
+                idx_offset += ch._CmdBuffer.Data[cmd_n].ElemCount;
+            }
         }
+
+        // Our channel 0 may itself be a channel of an in-place splitter: make room in its range (this never moves our indices)
+        if (draw_list->_IdxRangeSplitter != NULL && draw_list->IdxBuffer.Size + new_idx_buffer_count > draw_list->_IdxRangeEnd)
+            draw_list->_IdxRangeSplitter->_ReserveIdxRange(draw_list, new_idx_buffer_count);
     }
     draw_list->CmdBuffer.resize(draw_list->CmdBuffer.Size + new_cmd_buffer_count);
     draw_list->IdxBuffer.resize(draw_list->IdxBuffer.Size + new_idx_buffer_count);
 
     // Write commands and indices in order (they are fairly small structures, we don't copy vertices only indices)
+    // In-place mode only copies commands, channels IdxBuffer are empty.
     ImDrawCmd* cmd_write = draw_list->CmdBuffer.Data + draw_list->CmdBuffer.Size - new_cmd_buffer_count;
     ImDrawIdx* idx_write = draw_list->IdxBuffer.Data + draw_list->IdxBuffer.Size - new_idx_buffer_count;
     for (int i = 1; i < _Count; i++)
@@ -2201,14 +2772,19 @@ void ImDrawListSplitter::Merge(ImDrawList* draw_list)
         if (int sz = ch._IdxBuffer.Size) { memcpy(idx_write, ch._IdxBuffer.Data, sz * sizeof(ImDrawIdx)); idx_write += sz; }
     }
     draw_list->_IdxWritePtr = idx_write;
+    draw_list->_Data->SplitterIdxBytes += (ImU64)new_idx_buffer_count * sizeof(ImDrawIdx);
 
     // Ensure there's always a non-callback draw command trailing the command-buffer
     if (draw_list->CmdBuffer.Size == 0 || draw_list->CmdBuffer.back().UserCallback != NULL)
         draw_list->AddDrawCmd();
 
     // If current command is used with different settings we need to add a new command
+    // A command drawing glyph instances is not continued, the text runs of other channels were not kept (see ImDrawList::_CheckGlyphTail())
+    draw_list->_GlyphRuns.resize(0);
     ImDrawCmd* curr_cmd = &draw_list->CmdBuffer.Data[draw_list->CmdBuffer.Size - 1];
-    if (curr_cmd->ElemCount == 0)
+    if (curr_cmd->GlyphCount != 0)
+        draw_list->AddDrawCmd();
+    else if (curr_cmd->ElemCount == 0)
         ImDrawCmd_HeaderCopy(curr_cmd, &draw_list->_CmdHeader); // Copy ClipRect, TexRef, VtxOffset
     else if (ImDrawCmd_HeaderCompare(curr_cmd, &draw_list->_CmdHeader) != 0)
         draw_list->AddDrawCmd();
@@ -2222,24 +2798,255 @@ void ImDrawListSplitter::SetCurrentChannel(ImDrawList* draw_list, int idx)
     if (_Current == idx)
         return;
 
-    // Overwrite ImVector (12/16 bytes), four times. This is merely a silly optimization instead of doing .swap()
-    memcpy(&_Channels.Data[_Current]._CmdBuffer, &draw_list->CmdBuffer, sizeof(draw_list->CmdBuffer));
-    memcpy(&_Channels.Data[_Current]._IdxBuffer, &draw_list->IdxBuffer, sizeof(draw_list->IdxBuffer));
-    _Current = idx;
-    memcpy(&draw_list->CmdBuffer, &_Channels.Data[idx]._CmdBuffer, sizeof(draw_list->CmdBuffer));
-    memcpy(&draw_list->IdxBuffer, &_Channels.Data[idx]._IdxBuffer, sizeof(draw_list->IdxBuffer));
+    // Glyph instances and text runs are kept per channel in both modes
+    draw_list->_CheckGlyphTail();
+    memcpy(&_Channels.Data[_Current]._GlyphBuffer, &draw_list->GlyphBuffer, sizeof(draw_list->GlyphBuffer));
+    memcpy(&_Channels.Data[_Current]._GlyphRuns, &draw_list->_GlyphRuns, sizeof(draw_list->_GlyphRuns));
+    _Channels.Data[_Current]._GlyphTailElemCount = draw_list->_GlyphTailElemCount;
+
+    if (_InPlace)
+    {
+        // Indices stay in the parent buffer, only move the write position to the range of the new channel
+        memcpy(&_Channels.Data[_Current]._CmdBuffer, &draw_list->CmdBuffer, sizeof(draw_list->CmdBuffer));
+        _Channels.Data[_Current]._IdxCount = draw_list->IdxBuffer.Size - _Channels.Data[_Current]._IdxStart;
+        _Current = idx;
+        memcpy(&draw_list->CmdBuffer, &_Channels.Data[idx]._CmdBuffer, sizeof(draw_list->CmdBuffer));
+        draw_list->IdxBuffer.Size = _Channels.Data[idx]._IdxStart + _Channels.Data[idx]._IdxCount;
+        draw_list->_IdxRangeEnd = _Channels.Data[idx]._IdxEnd;
+    }
+    else
+    {
+        // An in-place splitter further up only owns the indices of our channel 0
+        if (_Current == 0)
+        {
+            _OuterIdxRangeSplitter = draw_list->_IdxRangeSplitter;
+            _OuterIdxRangeEnd = draw_list->_IdxRangeEnd;
+            draw_list->_IdxRangeSplitter = NULL;
+        }
+
+        // Overwrite ImVector (12/16 bytes), four times. This is merely a silly optimization instead of doing .swap()
+        memcpy(&_Channels.Data[_Current]._CmdBuffer, &draw_list->CmdBuffer, sizeof(draw_list->CmdBuffer));
+        memcpy(&_Channels.Data[_Current]._IdxBuffer, &draw_list->IdxBuffer, sizeof(draw_list->IdxBuffer));
+        _Current = idx;
+        memcpy(&draw_list->CmdBuffer, &_Channels.Data[idx]._CmdBuffer, sizeof(draw_list->CmdBuffer));
+        memcpy(&draw_list->IdxBuffer, &_Channels.Data[idx]._IdxBuffer, sizeof(draw_list->IdxBuffer));
+
+        if (idx == 0)
+        {
+            draw_list->_IdxRangeSplitter = _OuterIdxRangeSplitter;
+            draw_list->_IdxRangeEnd = _OuterIdxRangeEnd;
+        }
+    }
+    memcpy(&draw_list->GlyphBuffer, &_Channels.Data[idx]._GlyphBuffer, sizeof(draw_list->GlyphBuffer));
+    memcpy(&draw_list->_GlyphRuns, &_Channels.Data[idx]._GlyphRuns, sizeof(draw_list->_GlyphRuns));
+    draw_list->_GlyphTailElemCount = _Channels.Data[idx]._GlyphTailElemCount;
     draw_list->_IdxWritePtr = draw_list->IdxBuffer.Data + draw_list->IdxBuffer.Size;
 
     // If current command is used with different settings we need to add a new command
     ImDrawCmd* curr_cmd = (draw_list->CmdBuffer.Size == 0) ? NULL : &draw_list->CmdBuffer.Data[draw_list->CmdBuffer.Size - 1];
     if (curr_cmd == NULL)
         draw_list->AddDrawCmd();
-    else if (curr_cmd->ElemCount == 0)
+    else if (curr_cmd->ElemCount == 0 && curr_cmd->GlyphCount == 0)
         ImDrawCmd_HeaderCopy(curr_cmd, &draw_list->_CmdHeader); // Copy ClipRect, TexRef, VtxOffset
     else if (ImDrawCmd_HeaderCompare(curr_cmd, &draw_list->_CmdHeader) != 0)
         draw_list->AddDrawCmd();
 }
 
+// In-place mode: make room for 'idx_count' more indices after the write position of the current channel.
+// The current channel keeps its start and grows over the ranges laid out after it, which are moved to the end of the buffer along with their commands.
+void ImDrawListSplitter::_ReserveIdxRange(ImDrawList* draw_list, int idx_count)
+{
+    IM_ASSERT(_InPlace && draw_list->_IdxRangeSplitter == this);
+    ImVector<ImDrawIdx>& idx_buffer = draw_list->IdxBuffer;
+    ImDrawChannel& cur_ch = _Channels.Data[_Current];
+    const int idx_write = idx_buffer.Size;
+    const int idx_needed = idx_write + idx_count - cur_ch._IdxStart;
+    const int old_end = cur_ch._IdxEnd;
+    const int new_end = cur_ch._IdxStart + ImDrawListSplitter_CalcIdxReserve(idx_needed + idx_needed / 2);
+    cur_ch._IdxPeak = ImMax(cur_ch._IdxPeak, idx_needed);
+
+    // Ranges are disjoint, so the ones in the way are exactly those starting within [old_end, new_end)
+    int moved_end = ImMax(_IdxEnd, new_end);
+    for (int i = 0; i < _Count; i++)
+        if (i != _Current && _Channels.Data[i]._IdxStart >= old_end && _Channels.Data[i]._IdxStart < new_end)
+            moved_end += _Channels.Data[i]._IdxEnd - _Channels.Data[i]._IdxStart;
+
+    // ImVector only preserves Size elements when reallocating: expose the whole layout while growing
+    if (moved_end > idx_buffer.Capacity)
+    {
+        idx_buffer.Size = _IdxEnd;
+        idx_buffer.reserve(idx_buffer._grow_capacity(moved_end));
+        idx_buffer.Size = idx_write;
+    }
+
+    int idx_dst = ImMax(_IdxEnd, new_end);
+    for (int i = 0; i < _Count; i++)
+    {
+        ImDrawChannel& ch = _Channels.Data[i];
+        if (i == _Current || ch._IdxStart < old_end || ch._IdxStart >= new_end)
+            continue;
+        const int idx_delta = idx_dst - ch._IdxStart;
+        if (ch._IdxCount > 0)
+            memcpy(idx_buffer.Data + idx_dst, idx_buffer.Data + ch._IdxStart, ch._IdxCount * sizeof(ImDrawIdx));
+        draw_list->_Data->SplitterIdxBytes += (ImU64)ch._IdxCount * sizeof(ImDrawIdx);
+        for (ImDrawCmd& cmd : ch._CmdBuffer)
+            cmd.IdxOffset += idx_delta;
+        ch._IdxStart += idx_delta;
+        ch._IdxEnd += idx_delta;
+        idx_dst = ch._IdxEnd;
+    }
+    IM_ASSERT(idx_dst == moved_end);
+    cur_ch._IdxEnd = new_end;
+    _IdxEnd = moved_end;
+    draw_list->_IdxRangeEnd = new_end;
+    draw_list->_IdxWritePtr = idx_buffer.Data + idx_write;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] ImDrawListWorkers
+//-----------------------------------------------------------------------------
+// Worker draw lists are regular ImDrawList instances, each with a private copy of the target draw list shared data
+// (lookup tables are read-only but ImDrawListSharedData::TempBuffer is scratch memory written by AddPolyline() etc).
+// Merge() replays their commands into the target draw list, so commands sharing a clip rectangle and texture are merged
+// as if everything had been drawn there: vertices are copied by runs sharing a same VtxOffset, indices are rebased.
+//-----------------------------------------------------------------------------
+
+// Copy 'src' into 'dst', apart from the buffers owned by each instance
+static void ImDrawListSharedData_CopyForWorker(ImDrawListSharedData* dst, const ImDrawListSharedData* src)
+{
+    ImVector<ImVec2> temp_buffer;
+    ImVector<ImDrawList*> draw_lists;
+    dst->TempBuffer.swap(temp_buffer);
+    dst->DrawLists.swap(draw_lists);
+    memcpy((void*)dst, (const void*)src, sizeof(*dst));
+    memset((void*)&dst->TempBuffer, 0, sizeof(dst->TempBuffer)); // Don't alias the buffers of 'src'
+    memset((void*)&dst->DrawLists, 0, sizeof(dst->DrawLists));
+    dst->TempBuffer.swap(temp_buffer);
+    dst->DrawLists.swap(draw_lists);
+}
+
+void ImDrawListWorkers::ClearFreeMemory()
+{
+    IM_ASSERT(_Count == 0 && "Call Merge() or AddToDrawData() first!");
+    for (ImDrawList* draw_list : _DrawLists)
+        IM_DELETE(draw_list);
+    for (ImDrawListSharedData* shared_data : _SharedData) // After draw lists, which unregister from their shared data
+        IM_DELETE(shared_data);
+    _DrawLists.clear();
+    _SharedData.clear();
+}
+
+void ImDrawListWorkers::Begin(ImDrawList* draw_list, int count)
+{
+    IM_ASSERT(_Count == 0 && "Forgot to call Merge() or AddToDrawData()?");
+    IM_ASSERT(count > 0);
+    while (_DrawLists.Size < count)
+    {
+        ImDrawListSharedData* shared_data = IM_NEW(ImDrawListSharedData)();
+        _SharedData.push_back(shared_data);
+        _DrawLists.push_back(IM_NEW(ImDrawList)(shared_data));
+    }
+
+    const ImVec4 clip_rect = draw_list->_CmdHeader.ClipRect;
+    for (int n = 0; n < count; n++)
+    {
+        ImDrawListSharedData_CopyForWorker(_SharedData.Data[n], draw_list->_Data);
+        _SharedData.Data[n]->FontAtlas = NULL; // Packing user images into the atlas is main thread only, see ImFontAtlas::AddUserImage()
+        ImDrawList* worker_draw_list = _DrawLists.Data[n];
+        worker_draw_list->_ResetForNewFrame();
+        worker_draw_list->Flags = draw_list->Flags & ~ImDrawListFlags_GlyphInstances; // Merge() only appends vertices and indices
+        worker_draw_list->_FringeScale = draw_list->_FringeScale;
+        worker_draw_list->_OwnerName = draw_list->_OwnerName;
+        worker_draw_list->PushTexture(draw_list->_CmdHeader.TexRef);
+        worker_draw_list->PushClipRect(ImVec2(clip_rect.x, clip_rect.y), ImVec2(clip_rect.z, clip_rect.w));
+    }
+    _Count = count;
+
+    // Workers allocate through MemAlloc(), don't let them race on the context allocation counters
+    _Context = GImGui;
+    if (_Context != NULL)
+        _Context->DebugAllocInfo.PausedCount++;
+}
+
+static void ImDrawListWorkers_EndRecording(ImDrawListWorkers* workers)
+{
+    if (workers->_Context != NULL)
+        workers->_Context->DebugAllocInfo.PausedCount--;
+    workers->_Context = NULL;
+    workers->_Count = 0;
+}
+
+void ImDrawListWorkers::Merge(ImDrawList* draw_list)
+{
+    IM_ASSERT(_Count > 0 && "Forgot to call Begin()?");
+    const ImVec4 clip_rect_backup = draw_list->_CmdHeader.ClipRect;
+    const ImTextureRef tex_ref_backup = draw_list->_CmdHeader.TexRef;
+    for (int n = 0; n < _Count; n++)
+    {
+        ImDrawList* src = _DrawLists.Data[n];
+        src->_PopUnusedDrawCmd();
+        for (int cmd_n = 0; cmd_n < src->CmdBuffer.Size; )
+        {
+            // Append vertices of the commands sharing this VtxOffset. PrimReserve() starts a new VtxOffset if they don't fit in 16-bit indices.
+            const unsigned int vtx_offset = src->CmdBuffer.Data[cmd_n].VtxOffset;
+            int cmd_end = cmd_n + 1;
+            while (cmd_end < src->CmdBuffer.Size && src->CmdBuffer.Data[cmd_end].VtxOffset == vtx_offset)
+                cmd_end++;
+            const int vtx_count = ((cmd_end < src->CmdBuffer.Size) ? (int)src->CmdBuffer.Data[cmd_end].VtxOffset : src->VtxBuffer.Size) - (int)vtx_offset;
+            if (vtx_count > 0)
+            {
+                draw_list->PrimReserve(0, vtx_count);
+                memcpy(draw_list->_VtxWritePtr, src->VtxBuffer.Data + vtx_offset, (size_t)vtx_count * sizeof(ImDrawVert));
+            }
+            const unsigned int vtx_base = draw_list->_VtxCurrentIdx;
+            draw_list->_VtxWritePtr += vtx_count;
+            draw_list->_VtxCurrentIdx += vtx_count;
+
+            // Replay commands: header changes go through the same path as PushClipRect()/PushTexture() so matching commands are merged
+            for (; cmd_n < cmd_end; cmd_n++)
+            {
+                const ImDrawCmd* cmd = &src->CmdBuffer.Data[cmd_n];
+                if (cmd->UserCallback == NULL && cmd->ElemCount == 0)
+                    continue;
+                draw_list->_CmdHeader.ClipRect = cmd->ClipRect;
+                draw_list->_CmdHeader.TexRef = cmd->TexRef;
+                draw_list->_OnChangedClipRect();
+                draw_list->_OnChangedTexture();
+                if (cmd->UserCallback != NULL)
+                {
+                    void* userdata = (cmd->UserCallbackDataOffset != -1 && cmd->UserCallbackDataSize > 0) ? src->_CallbacksDataBuf.Data + cmd->UserCallbackDataOffset : cmd->UserCallbackData;
+                    draw_list->AddCallback(cmd->UserCallback, userdata, (size_t)cmd->UserCallbackDataSize);
+                    continue;
+                }
+                draw_list->PrimReserve((int)cmd->ElemCount, 0);
+                const ImDrawIdx* idx_src = src->IdxBuffer.Data + cmd->IdxOffset;
+                ImDrawIdx* idx_dst = draw_list->_IdxWritePtr;
+                if (vtx_base == 0)
+                    memcpy(idx_dst, idx_src, (size_t)cmd->ElemCount * sizeof(ImDrawIdx));
+                else
+                    for (unsigned int i = 0; i < cmd->ElemCount; i++)
+                        idx_dst[i] = (ImDrawIdx)(idx_src[i] + vtx_base);
+                draw_list->_IdxWritePtr += cmd->ElemCount;
+            }
+        }
+    }
+
+    draw_list->_CmdHeader.ClipRect = clip_rect_backup;
+    draw_list->_CmdHeader.TexRef = tex_ref_backup;
+    draw_list->_OnChangedClipRect();
+    draw_list->_OnChangedTexture();
+    ImDrawListWorkers_EndRecording(this);
+}
+
+// Worker draw lists are kept until the next Begin(), so this can be used for the ImDrawData of the current frame.
+void ImDrawListWorkers::AddToDrawData(ImDrawData* draw_data)
+{
+    IM_ASSERT(_Count > 0 && "Forgot to call Begin()?");
+    for (int n = 0; n < _Count; n++)
+        draw_data->AddDrawList(_DrawLists.Data[n]);
+    ImDrawListWorkers_EndRecording(this);
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImDrawData
 //-----------------------------------------------------------------------------
@@ -2247,7 +3054,7 @@ void ImDrawListSplitter::SetCurrentChannel(ImDrawList* draw_list, int idx)
 void ImDrawData::Clear()
 {
     Valid = false;
-    CmdListsCount = TotalIdxCount = TotalVtxCount = 0;
+    CmdListsCount = TotalIdxCount = TotalVtxCount = TotalGlyphCount = 0;
     CmdLists.resize(0); // The ImDrawList are NOT owned by ImDrawData but e.g. by ImGuiContext, so we don't clear them.
     DisplayPos = DisplaySize = FramebufferScale = ImVec2(0.0f, 0.0f);
     OwnerViewport = NULL;
@@ -2260,7 +3067,7 @@ void ImGui::AddDrawListToDrawDataEx(ImDrawData* draw_data, ImVector<ImDrawList*>
 {
     if (draw_list->CmdBuffer.Size == 0)
         return;
-    if (draw_list->CmdBuffer.Size == 1 && draw_list->CmdBuffer[0].ElemCount == 0 && draw_list->CmdBuffer[0].UserCallback == NULL)
+    if (draw_list->CmdBuffer.Size == 1 && draw_list->CmdBuffer[0].ElemCount == 0 && draw_list->CmdBuffer[0].GlyphCount == 0 && draw_list->CmdBuffer[0].UserCallback == NULL)
         return;
 
     // Draw list sanity check. Detect mismatch between PrimReserve() calls and incrementing _VtxCurrentIdx, _VtxWritePtr etc.
@@ -2299,6 +3106,7 @@ void ImGui::AddDrawListToDrawDataEx(ImDrawData* draw_data, ImVector<ImDrawList*>
     draw_data->CmdListsCount++;
     draw_data->TotalVtxCount += draw_list->VtxBuffer.Size;
     draw_data->TotalIdxCount += draw_list->IdxBuffer.Size;
+    draw_data->TotalGlyphCount += draw_list->GlyphBuffer.Size;
 }
 
 void ImDrawData::AddDrawList(ImDrawList* draw_list)
@@ -2380,12 +3188,12 @@ void ImGui::ShadeVertsLinearUV(ImDrawList* draw_list, int vert_start_idx, int ve
         const ImVec2 min = ImMin(uv_a, uv_b);
         const ImVec2 max = ImMax(uv_a, uv_b);
         for (ImDrawVert* vertex = vert_start; vertex < vert_end; ++vertex)
-            vertex->uv = ImClamp(uv_a + ImMul(ImVec2(vertex->pos.x, vertex->pos.y) - a, scale), min, max);
+            vertex->uv = ImClamp(uv_a + ImMul((ImVec2)vertex->pos - a, scale), min, max);
     }
     else
     {
         for (ImDrawVert* vertex = vert_start; vertex < vert_end; ++vertex)
-            vertex->uv = uv_a + ImMul(ImVec2(vertex->pos.x, vertex->pos.y) - a, scale);
+            vertex->uv = uv_a + ImMul((ImVec2)vertex->pos - a, scale);
     }
 }
 
@@ -2397,6 +3205,31 @@ void ImGui::ShadeVertsTransformPos(ImDrawList* draw_list, int vert_start_idx, in
         vertex->pos = ImRotate(vertex->pos- pivot_in, cos_a, sin_a) + pivot_out;
 }
 
+// Write the 4 vertices of each glyph instance of a command, in the same order as PrimRectUV(): draw them with indices 0,1,2 + 0,2,3 for each quad.
+// This is what renderers setting ImGuiBackendFlags_RendererHasGlyphInstances do on the GPU. Positions are computed as in ImFont::RenderText().
+void ImGui::ExpandGlyphInstances(const ImDrawList* draw_list, const ImDrawCmd* draw_cmd, ImDrawVert* out_vtx)
+{
+    if (draw_cmd->GlyphCount == 0)
+        return;
+    const ImTextureData* tex = draw_cmd->TexRef._TexData;
+    IM_ASSERT(tex != NULL && "Glyph instances always use the font atlas texture.");
+    const ImDrawGlyph* glyph = draw_list->GlyphBuffer.Data + draw_cmd->GlyphOffset;
+    const ImDrawGlyph* glyph_end = glyph + draw_cmd->GlyphCount;
+    for (; glyph < glyph_end; glyph++, out_vtx += 4)
+    {
+        IM_ASSERT_PARANOID(glyph->GlyphId < (ImU32)tex->GlyphRects.Size);
+        const ImDrawGlyphRect& r = tex->GlyphRects.Data[glyph->GlyphId];
+        const float x1 = glyph->X + r.X0;
+        const float x2 = glyph->X + r.X1;
+        const float y1 = glyph->Y + r.Y0;
+        const float y2 = glyph->Y + r.Y1;
+        out_vtx[0].pos = ImVec2(x1, y1); out_vtx[0].col = glyph->Col; out_vtx[0].uv = ImVec2(r.U0, r.V0);
+        out_vtx[1].pos = ImVec2(x2, y1); out_vtx[1].col = glyph->Col; out_vtx[1].uv = ImVec2(r.U1, r.V0);
+        out_vtx[2].pos = ImVec2(x2, y2); out_vtx[2].col = glyph->Col; out_vtx[2].uv = ImVec2(r.U1, r.V1);
+        out_vtx[3].pos = ImVec2(x1, y2); out_vtx[3].col = glyph->Col; out_vtx[3].uv = ImVec2(r.U0, r.V1);
+    }
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImFontConfig
 //-----------------------------------------------------------------------------
@@ -2512,6 +3345,7 @@ void ImTextureData::DestroyPixels()
 // - ImFontAtlas::AddFontFromMemoryCompressedBase85TTF()
 // - ImFontAtlas::RemoveFont()
 // - ImFontAtlasBuildNotifySetFont()
+// - ImFontAtlasBuildNotifyDiscardOutput()
 //-----------------------------------------------------------------------------
 // - ImFontAtlas::AddCustomRect()
 // - ImFontAtlas::RemoveCustomRect()
@@ -2525,6 +3359,7 @@ void ImTextureData::DestroyPixels()
 // - ImFontAtlasBuildPreloadAllGlyphRanges()
 // - ImFontAtlasBuildUpdatePointers()
 // - ImFontAtlasBuildRenderBitmapFromString()
+// - ImFontAtlasBuildConvertCoverageToSDF()
 // - ImFontAtlasBuildUpdateBasicTexData()
 // - ImFontAtlasBuildUpdateLinesTexData()
 // - ImFontAtlasBuildAddFont()
@@ -2632,6 +3467,9 @@ ImFontAtlas::ImFontAtlas()
     TexMinHeight = 128;
     TexMaxWidth = 8192;
     TexMaxHeight = 8192;
+    SDFBakeSize = 32.0f;
+    SDFSpread = 4;
+    UserImagesMaxSize = 64;
     TexRef._TexID = ImTextureID_Invalid;
     RendererHasTextures = false; // Assumed false by default, as apps can call e.g Atlas::Build() after backend init and before ImGui can update.
     TexNextUniqueID = 1;
@@ -2647,6 +3485,8 @@ ImFontAtlas::~ImFontAtlas()
     ClearTexData();
     TexList.clear_delete();
     TexData = NULL;
+    UserImages.clear_delete();
+    UserImagesMap.Clear();
 }
 
 void ImFontAtlas::Clear()
@@ -2741,6 +3581,8 @@ void ImFontAtlasUpdateNewFrame(ImFontAtlas* atlas, int frame_count, bool rendere
         atlas->TexIsBuilt = true;
         if (atlas->Builder == NULL) // This will only happen if fonts were not already loaded.
             ImFontAtlasBuildMain(atlas);
+        else if (atlas->TexData->UseSDF != ((atlas->Flags & ImFontAtlasFlags_SDF) != 0)) // ImFontAtlasFlags_SDF toggled: rebake everything
+            ImFontAtlasBuildClear(atlas);
     }
     // Legacy backend
     if (!atlas->RendererHasTextures)
@@ -2824,6 +3666,9 @@ void ImFontAtlasUpdateNewFrame(ImFontAtlas* atlas, int frame_count, bool rendere
             tex_n--;
         }
     }
+
+    // Add glyphs rasterized by worker threads since last frame
+    ImFontAtlasAsyncBakerCommit(atlas);
 }
 
 void ImFontAtlasTextureBlockConvert(const unsigned char* src_pixels, ImTextureFormat src_fmt, int src_pitch, unsigned char* dst_pixels, ImTextureFormat dst_fmt, int dst_pitch, int w, int h)
@@ -3215,6 +4060,14 @@ static void ImFontAtlasBuildNotifySetFont(ImFontAtlas* atlas, ImFont* old_font,
     }
 }
 
+// Glyph advances of discarded baked data may change when it gets baked again: drop text sizes cached by contexts using this atlas.
+static void ImFontAtlasBuildNotifyDiscardOutput(ImFontAtlas* atlas)
+{
+    for (ImDrawListSharedData* shared_data : atlas->DrawListSharedDatas)
+        if (ImGuiContext* ctx = shared_data->Context)
+            ctx->TextSizeCache.Invalidate();
+}
+
 void ImFontAtlas::RemoveFont(ImFont* font)
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas!");
@@ -3271,6 +4124,61 @@ void ImFontAtlas::RemoveCustomRect(ImFontAtlasRectId id)
     ImFontAtlasPackDiscardRect(this, id);
 }
 
+static ImFontAtlasUserImage* ImFontAtlasUserImageFind(ImFontAtlas* atlas, ImTextureID tex_id)
+{
+    ImFontAtlasUserImage* image = (ImFontAtlasUserImage*)atlas->UserImagesMap.GetVoidPtr(ImHashData(&tex_id, sizeof(tex_id)));
+    return (image != NULL && image->TexID == tex_id) ? image : NULL;
+}
+
+static void ImFontAtlasUserImageDiscard(ImFontAtlas* atlas, ImFontAtlasUserImage* image)
+{
+    if (image->PackId == ImFontAtlasRectId_Invalid)
+        return;
+    ImFontAtlasPackDiscardRect(atlas, image->PackId);
+    image->PackId = ImFontAtlasRectId_Invalid;
+}
+
+// Pixels are only copied here. Packing into the texture happens on first use, see ImFontAtlasUserImageRemap().
+bool ImFontAtlas::AddUserImage(ImTextureID tex_id, const void* pixels_rgba32, int width, int height)
+{
+    IM_ASSERT(tex_id != ImTextureID_Invalid && pixels_rgba32 != NULL);
+    IM_ASSERT(width > 0 && height > 0);
+    if (width > UserImagesMaxSize || height > UserImagesMaxSize)
+        return false;
+
+    const ImGuiID key = ImHashData(&tex_id, sizeof(tex_id));
+    ImFontAtlasUserImage* image = (ImFontAtlasUserImage*)UserImagesMap.GetVoidPtr(key);
+    IM_ASSERT((image == NULL || image->TexID == tex_id) && "ImTextureID hash collision!");
+    if (image == NULL)
+    {
+        image = IM_NEW(ImFontAtlasUserImage)();
+        image->TexID = tex_id;
+        UserImages.push_back(image);
+        UserImagesMap.SetVoidPtr(key, image);
+    }
+    else if (Builder != NULL)
+    {
+        ImFontAtlasUserImageDiscard(this, image); // Size or contents changed: pack again on next use
+    }
+    image->Width = width;
+    image->Height = height;
+    image->Pixels.resize(width * height * 4);
+    memcpy(image->Pixels.Data, pixels_rgba32, (size_t)image->Pixels.Size);
+    return true;
+}
+
+void ImFontAtlas::RemoveUserImage(ImTextureID tex_id)
+{
+    ImFontAtlasUserImage* image = ImFontAtlasUserImageFind(this, tex_id);
+    if (image == NULL)
+        return;
+    if (Builder != NULL)
+        ImFontAtlasUserImageDiscard(this, image);
+    UserImagesMap.SetVoidPtr(ImHashData(&tex_id, sizeof(tex_id)), NULL);
+    UserImages.find_erase_unsorted(image);
+    IM_DELETE(image);
+}
+
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
 // This API does not make sense anymore with scalable fonts.
 // - Prefer adding a font source (ImFontConfig) using a custom/procedural loader.
@@ -3362,7 +4270,7 @@ bool ImFontAtlasGetMouseCursorTexData(ImFontAtlas* atlas, ImGuiMouseCursor curso
 void ImFontAtlasBuildMain(ImFontAtlas* atlas)
 {
     IM_ASSERT(!atlas->Locked && "Cannot modify a locked ImFontAtlas!");
-    if (atlas->TexData && atlas->TexData->Format != atlas->TexDesiredFormat)
+    if (atlas->TexData && (atlas->TexData->Format != atlas->TexDesiredFormat || atlas->TexData->UseSDF != ((atlas->Flags & ImFontAtlasFlags_SDF) != 0)))
         ImFontAtlasBuildClear(atlas);
 
     if (atlas->Builder == NULL)
@@ -3472,6 +4380,75 @@ void ImFontAtlasBuildRenderBitmapFromString(ImFontAtlas* atlas, int x, int y, in
     }
 }
 
+// 1D squared Euclidean distance transform (Felzenszwalb & Huttenlocher), in place over 'length' values spaced by 'stride'
+static void ImFontAtlasBuildSDFTransform1D(float* grid, int stride, int length, float* f, float* z, int* v)
+{
+    for (int q = 0; q < length; q++)
+        f[q] = grid[q * stride];
+    v[0] = 0;
+    z[0] = -FLT_MAX;
+    z[1] = FLT_MAX;
+    for (int q = 1, k = 0; q < length; q++)
+    {
+        float s;
+        do
+        {
+            const int r = v[k];
+            s = (f[q] - f[r] + (float)(q * q - r * r)) / (float)(2 * (q - r));
+        } while (s <= z[k] && --k > -1);
+        k++;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = FLT_MAX;
+    }
+    for (int q = 0, k = 0; q < length; q++)
+    {
+        while (z[k + 1] < (float)q)
+            k++;
+        const int r = v[k];
+        grid[q * stride] = f[r] + (float)((q - r) * (q - r));
+    }
+}
+
+// Convert an Alpha8 coverage bitmap to a signed distance field for ImFontAtlasFlags_SDF: 128 on edges, reaching 0 and 255 at 'spread' pixels outside and inside.
+// The bitmap needs 'spread' empty pixels around the glyph. Partially covered pixels seed the transform with their estimated distance to the edge,
+// which is much faster than computing exact distances to the outline (stbtt_GetGlyphSDF) and within a fraction of a pixel of it.
+void ImFontAtlasBuildConvertCoverageToSDF(ImFontAtlas* atlas, unsigned char* pixels, int w, int h, int spread)
+{
+    const int n = w * h;
+    const int m = ImMax(w, h);
+    ImVector<float>& buf = atlas->Builder->TempBufferSDF;
+    buf.resize(n * 2 + m * 3 + 1);
+    float* outer = buf.Data;    // Squared distance to nearest inside pixel
+    float* inner = outer + n;   // Squared distance to nearest outside pixel
+    float* f = inner + n;
+    float* z = f + m;
+    int* v = (int*)(z + m + 1);
+    IM_STATIC_ASSERT(sizeof(int) == sizeof(float));
+
+    for (int i = 0; i < n; i++)
+    {
+        const float a = pixels[i] / 255.0f;
+        const float d = 0.5f - a;
+        outer[i] = (pixels[i] == 0) ? FLT_MAX : (pixels[i] == 255) ? 0.0f : (d > 0.0f) ? d * d : 0.0f;
+        inner[i] = (pixels[i] == 255) ? FLT_MAX : (pixels[i] == 0) ? 0.0f : (d < 0.0f) ? d * d : 0.0f;
+    }
+    for (int pass = 0; pass < 2; pass++)
+    {
+        float* grid = (pass == 0) ? outer : inner;
+        for (int x = 0; x < w; x++)
+            ImFontAtlasBuildSDFTransform1D(grid + x, w, h, f, z, v);
+        for (int y = 0; y < h; y++)
+            ImFontAtlasBuildSDFTransform1D(grid + y * w, 1, w, f, z, v);
+    }
+    const float scale = 127.0f / spread;
+    for (int i = 0; i < n; i++)
+    {
+        const float dist = ImSqrt(outer[i]) - ImSqrt(inner[i]);
+        pixels[i] = (unsigned char)ImClamp(128.0f - dist * scale + 0.5f, 0.0f, 255.0f);
+    }
+}
+
 static void ImFontAtlasBuildUpdateBasicTexData(ImFontAtlas* atlas)
 {
     // Pack and store identifier so we can refresh UV coordinates on texture resize.
@@ -3508,7 +4485,7 @@ static void ImFontAtlasBuildUpdateBasicTexData(ImFontAtlas* atlas)
 
 static void ImFontAtlasBuildUpdateLinesTexData(ImFontAtlas* atlas)
 {
-    if (atlas->Flags & ImFontAtlasFlags_NoBakedLines)
+    if (atlas->Flags & (ImFontAtlasFlags_NoBakedLines | ImFontAtlasFlags_SDF))
         return;
 
     // Pack and store identifier so we can refresh UV coordinates on texture resize.
@@ -3587,6 +4564,7 @@ bool ImFontAtlasFontInitOutput(ImFontAtlas* atlas, ImFont* font)
 void ImFontAtlasFontDestroyOutput(ImFontAtlas* atlas, ImFont* font)
 {
     font->ClearOutputData();
+    ImFontAtlasAsyncBakerWaitIdle(atlas); // Jobs for this font were cancelled above, but running ones still read its data
     for (ImFontConfig* src : font->Sources)
     {
         const ImFontLoader* loader = src->FontLoader ? src->FontLoader : atlas->FontLoader;
@@ -3759,9 +4737,11 @@ void ImFontAtlasBakedDiscardFontGlyph(ImFontAtlas* atlas, ImFont* font, ImFontBa
     ImWchar c = (ImWchar)glyph->Codepoint;
     IM_ASSERT(font->FallbackChar != c && font->EllipsisChar != c); // Unsupported for simplicity
     IM_ASSERT(glyph >= baked->Glyphs.Data && glyph < baked->Glyphs.Data + baked->Glyphs.Size);
+    ImFontAtlasAsyncBakerCancel(atlas, baked->BakedId, baked->Glyphs.index_from_ptr(glyph));
     IM_UNUSED(font);
     baked->IndexLookup[c] = IM_FONTGLYPH_INDEX_UNUSED;
     baked->IndexAdvanceX[c] = baked->FallbackAdvanceX;
+    ImFontAtlasBuildNotifyDiscardOutput(atlas);
 }
 
 ImFontBaked* ImFontAtlasBakedAdd(ImFontAtlas* atlas, ImFont* font, float font_size, float font_rasterizer_density, ImGuiID baked_id)
@@ -3828,6 +4808,7 @@ void ImFontAtlasBakedDiscard(ImFontAtlas* atlas, ImFont* font, ImFontBaked* bake
 {
     ImFontAtlasBuilder* builder = atlas->Builder;
     IMGUI_DEBUG_LOG_FONT("[font] Discard baked %.2f for \"%s\"\n", baked->Size, font->GetDebugName());
+    ImFontAtlasAsyncBakerCancel(atlas, baked->BakedId);
 
     for (ImFontGlyph& glyph : baked->Glyphs)
         if (glyph.PackId != ImFontAtlasRectId_Invalid)
@@ -3848,6 +4829,7 @@ void ImFontAtlasBakedDiscard(ImFontAtlas* atlas, ImFont* font, ImFontBaked* bake
     }
     builder->BakedMap.SetVoidPtr(baked->BakedId, NULL);
     builder->BakedDiscardedCount++;
+    ImFontAtlasBuildNotifyDiscardOutput(atlas);
     baked->ClearOutputData();
     baked->WantDestroy = true;
     font->LastBaked = NULL;
@@ -3883,6 +4865,65 @@ void ImFontAtlasBuildDiscardBakes(ImFontAtlas* atlas, int unused_frames)
     }
 }
 
+// use unused_frames==0 to discard everything. Discarded images are packed again on their next use.
+void ImFontAtlasBuildDiscardUserImages(ImFontAtlas* atlas, int unused_frames)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    for (ImFontAtlasUserImage* image : atlas->UserImages)
+        if (image->PackId != ImFontAtlasRectId_Invalid && image->LastUsedFrame + unused_frames <= builder->FrameCount)
+            ImFontAtlasUserImageDiscard(atlas, image);
+}
+
+// Called by ImDrawList::AddImage() etc. for references to user textures.
+// If 'tex_ref' is a user image registered with AddUserImage(), pack it if needed, then redirect 'tex_ref' and 'uvs' to the atlas texture.
+// Return false and leave parameters untouched otherwise.
+bool ImFontAtlasUserImageRemap(ImFontAtlas* atlas, ImTextureRef* tex_ref, ImVec2* uvs, int uvs_count)
+{
+    ImFontAtlasUserImage* image = ImFontAtlasUserImageFind(atlas, tex_ref->_TexID);
+    if (image == NULL || atlas->Builder == NULL || atlas->TexData == NULL)
+        return false;
+    if (!atlas->RendererHasTextures || atlas->TexData->Format != ImTextureFormat_RGBA32 || (atlas->Flags & ImFontAtlasFlags_SDF))
+        return false;
+    for (int n = 0; n < uvs_count; n++)
+        if (uvs[n].x < 0.0f || uvs[n].x > 1.0f || uvs[n].y < 0.0f || uvs[n].y > 1.0f) // Tiling/wrapping relies on texture addressing
+            return false;
+
+    if (image->PackId == ImFontAtlasRectId_Invalid)
+    {
+        // Pack with a 1 pixel border replicating edge pixels, so bilinear filtering at image edges doesn't sample neighbors.
+        // (Packing may repack or grow the texture, in which case atlas->TexData is now another texture)
+        const int w = image->Width;
+        const int h = image->Height;
+        ImFontAtlasRectId pack_id = ImFontAtlasPackAddRect(atlas, w + 2, h + 2);
+        if (pack_id == ImFontAtlasRectId_Invalid)
+            return false;
+        image->PackId = pack_id;
+
+        ImTextureData* tex = atlas->TexData;
+        ImTextureRect* r = ImFontAtlasPackGetRect(atlas, pack_id);
+        const ImU32* src_pixels = (const ImU32*)(const void*)image->Pixels.Data;
+        for (int y = 0; y < h + 2; y++)
+        {
+            const ImU32* src = src_pixels + ImClamp(y - 1, 0, h - 1) * w;
+            ImU32* dst = (ImU32*)tex->GetPixelsAt(r->x, r->y + y);
+            dst[0] = src[0];
+            memcpy(dst + 1, src, (size_t)w * 4);
+            dst[w + 1] = src[w - 1];
+        }
+        ImFontAtlasTextureBlockQueueUpload(atlas, tex, r->x, r->y, r->w, r->h);
+        atlas->TexPixelsUseColors = tex->UseColors = true;
+    }
+    image->LastUsedFrame = atlas->Builder->FrameCount;
+
+    ImTextureRect* r = ImFontAtlasPackGetRect(atlas, image->PackId);
+    const ImVec2 uv_offset = ImVec2((r->x + 1) * atlas->TexUvScale.x, (r->y + 1) * atlas->TexUvScale.y);
+    const ImVec2 uv_scale = ImVec2(image->Width * atlas->TexUvScale.x, image->Height * atlas->TexUvScale.y);
+    for (int n = 0; n < uvs_count; n++)
+        uvs[n] = ImVec2(uv_offset.x + uvs[n].x * uv_scale.x, uv_offset.y + uvs[n].y * uv_scale.y);
+    *tex_ref = atlas->TexRef;
+    return true;
+}
+
 // Those functions are designed to facilitate changing the underlying structures for ImFontAtlas to store an array of ImDrawListSharedData*
 void ImFontAtlasAddDrawListSharedData(ImFontAtlas* atlas, ImDrawListSharedData* data)
 {
@@ -3969,6 +5010,7 @@ ImTextureData* ImFontAtlasTextureAdd(ImFontAtlas* atlas, int w, int h)
     }
 
     new_tex->Create(atlas->TexDesiredFormat, w, h);
+    new_tex->UseSDF = (atlas->Flags & ImFontAtlasFlags_SDF) != 0;
     atlas->TexIsBuilt = false;
 
     ImFontAtlasBuildSetTexture(atlas, new_tex);
@@ -4039,7 +5081,7 @@ void ImFontAtlasTextureRepack(ImFontAtlas* atlas, int w, int h)
     builder->RectsDiscardedCount = 0;
     builder->RectsDiscardedSurface = 0;
 
-    // Patch glyphs UV
+    // Patch glyphs UV, fill glyph rectangles of the new texture (the old one keeps its own for commands already submitted this frame)
     for (int baked_n = 0; baked_n < builder->BakedPool.Size; baked_n++)
         for (ImFontGlyph& glyph : builder->BakedPool[baked_n].Glyphs)
             if (glyph.PackId != ImFontAtlasRectId_Invalid)
@@ -4049,6 +5091,7 @@ void ImFontAtlasTextureRepack(ImFontAtlas* atlas, int w, int h)
                 glyph.V0 = (r->y) * atlas->TexUvScale.y;
                 glyph.U1 = (r->x + r->w) * atlas->TexUvScale.x;
                 glyph.V1 = (r->y + r->h) * atlas->TexUvScale.y;
+                ImFontAtlasTextureUpdateGlyphRect(atlas, &glyph);
             }
 
     // Update other cached UV
@@ -4098,6 +5141,7 @@ void ImFontAtlasTextureMakeSpace(ImFontAtlas* atlas)
     //IMGUI_DEBUG_LOG_FONT("[font] ImFontAtlasBuildMakeSpace()\n");
     ImFontAtlasBuilder* builder = atlas->Builder;
     ImFontAtlasBuildDiscardBakes(atlas, 2);
+    ImFontAtlasBuildDiscardUserImages(atlas, 2);
 
     // Currently using a heuristic for repack without growing.
     if (builder->RectsDiscardedSurface < builder->RectsPackedSurface * 0.20f)
@@ -4140,6 +5184,27 @@ ImVec2i ImFontAtlasTextureGetSizeEstimate(ImFontAtlas* atlas)
     return ImVec2i(new_tex_w, new_tex_h);
 }
 
+// Glyph quads of the atlas texture indexed by rectangle, read by renderers expanding ImDrawGlyph instances (see ImGuiBackendFlags_RendererHasGlyphInstances).
+// Rectangle indices are stable across repacks, entries of discarded glyphs are simply left unused until their index is reused.
+void ImFontAtlasTextureUpdateGlyphRect(ImFontAtlas* atlas, const ImFontGlyph* glyph)
+{
+    IM_ASSERT(glyph->PackId != ImFontAtlasRectId_Invalid);
+    ImTextureData* tex = atlas->TexData;
+    const int rect_idx = ImFontAtlasRectId_GetIndex(glyph->PackId);
+    if (rect_idx >= tex->GlyphRects.Size)
+        tex->GlyphRects.resize(rect_idx + 1, ImDrawGlyphRect());
+    ImDrawGlyphRect& r = tex->GlyphRects.Data[rect_idx];
+    r.X0 = glyph->X0;
+    r.Y0 = glyph->Y0;
+    r.X1 = glyph->X1;
+    r.Y1 = glyph->Y1;
+    r.U0 = glyph->U0;
+    r.V0 = glyph->V0;
+    r.U1 = glyph->U1;
+    r.V1 = glyph->V1;
+    tex->GlyphRectsVersion++;
+}
+
 // Clear all output. Invalidates all AddCustomRect() return values!
 void ImFontAtlasBuildClear(ImFontAtlas* atlas)
 {
@@ -4160,6 +5225,7 @@ void ImFontAtlasTextureCompact(ImFontAtlas* atlas)
 {
     ImFontAtlasBuilder* builder = atlas->Builder;
     ImFontAtlasBuildDiscardBakes(atlas, 1);
+    ImFontAtlasBuildDiscardUserImages(atlas, 1);
 
     ImTextureData* old_tex = atlas->TexData;
     ImVec2i old_tex_size = ImVec2i(old_tex->Width, old_tex->Height);
@@ -4217,6 +5283,7 @@ void ImFontAtlasBuildInit(ImFontAtlas* atlas)
 // Destroy builder and all cached glyphs. Do not destroy actual fonts.
 void ImFontAtlasBuildDestroy(ImFontAtlas* atlas)
 {
+    ImFontAtlasAsyncBakerDestroy(atlas);
     for (ImFont* font : atlas->Fonts)
         ImFontAtlasFontDestroyOutput(atlas, font);
     if (atlas->Builder && atlas->FontLoader && atlas->FontLoader->LoaderShutdown)
@@ -4226,6 +5293,8 @@ void ImFontAtlasBuildDestroy(ImFontAtlas* atlas)
     }
     IM_DELETE(atlas->Builder);
     atlas->Builder = NULL;
+    for (ImFontAtlasUserImage* image : atlas->UserImages)
+        image->PackId = ImFontAtlasRectId_Invalid; // Packed again on next use
 }
 
 void ImFontAtlasPackInit(ImFontAtlas * atlas)
@@ -4534,6 +5603,254 @@ void ImFontAtlasDebugLogTextureRequests(ImFontAtlas* atlas)
 }
 #endif
 
+//-------------------------------------------------------------------------
+// [SECTION] ImFontAtlas: asynchronous glyph baking
+//-------------------------------------------------------------------------
+// With ImFontAtlasFlags_AsyncGlyphBaking, the stb_truetype loader registers a new glyph with its final metrics but
+// no pixels, and queues its rasterization to worker threads. ImFontAtlasUpdateNewFrame() packs the finished bitmaps,
+// so text using glyphs seen for the first time is laid out correctly right away, and drawn from the next frame on.
+// - Workers only read the font data and write the job's own bitmap. Packing and texture updates stay on the main thread.
+// - Discarding a baked font cancels its jobs. Destroying font sources waits for running jobs.
+//-------------------------------------------------------------------------
+
+#if defined(IMGUI_ENABLE_STB_TRUETYPE) && defined(IMGUI_ENABLE_FONT_ASYNC_BAKING)
+
+#ifndef IMGUI_FONT_ASYNC_BAKING_THREADS
+#define IMGUI_FONT_ASYNC_BAKING_THREADS     0       // 0: hardware threads - 1, clamped to 1..4
+#endif
+
+struct ImFontAtlasAsyncGlyphJob
+{
+    // Set on main thread
+    ImGuiID                 BakedId;
+    int                     GlyphIdx;               // Index of the glyph registered without pixels in baked->Glyphs[]
+    stbtt_fontinfo          FontInfo;               // Copy with userdata = baker, so allocations from worker threads don't go through MemAlloc()
+    int                     FontGlyphIndex;
+    float                   ScaleX, ScaleY;
+    int                     OversampleH, OversampleV;
+    int                     W, H;
+    int                     BoxX0, BoxY0;
+    float                   OffsetX, OffsetY;       // Glyph offset, without the sub-pixel shift from oversampling
+    float                   RecipH, RecipV;
+    ImVector<unsigned char> Pixels;                 // W * H, Alpha8
+    bool                    Cancelled;
+
+    // Set by worker thread
+    float                   SubX, SubY;
+    bool                    Done;                   // Protected by ImFontAtlasAsyncBaker::Mutex
+
+    ImFontAtlasAsyncGlyphJob() { BakedId = 0; GlyphIdx = -1; Cancelled = Done = false; }
+};
+
+struct ImFontAtlasAsyncBaker
+{
+    std::mutex                          Mutex;
+    std::condition_variable             WakeWorkers;
+    std::condition_variable             JobFinished;
+    ImVector<std::thread*>              Threads;
+    ImVector<ImFontAtlasAsyncGlyphJob*> Queue;          // Waiting for a worker (Mutex)
+    ImVector<ImFontAtlasAsyncGlyphJob*> Jobs;           // All jobs not committed yet (main thread only)
+    ImVector<ImFontAtlasAsyncGlyphJob*> JobsDone;       // Temporary storage for ImFontAtlasAsyncBakerCommit()
+    int                                 RunningCount;   // (Mutex)
+    bool                                Quit;           // (Mutex)
+    ImGuiMemAllocFunc                   AllocFunc;      // Captured from main thread, as GImGui is not set on worker threads
+    ImGuiMemFreeFunc                    FreeFunc;
+    void*                               AllocUserData;
+
+    ImFontAtlasAsyncBaker() { RunningCount = 0; Quit = false; ImGui::GetAllocatorFunctions(&AllocFunc, &FreeFunc, &AllocUserData); }
+};
+
+static void* ImFontAtlasAsyncBakerMemAlloc(size_t size, void* user_data)
+{
+    ImFontAtlasAsyncBaker* baker = (ImFontAtlasAsyncBaker*)user_data;
+    return baker->AllocFunc(size, baker->AllocUserData);
+}
+
+static void ImFontAtlasAsyncBakerMemFree(void* ptr, void* user_data)
+{
+    ImFontAtlasAsyncBaker* baker = (ImFontAtlasAsyncBaker*)user_data;
+    baker->FreeFunc(ptr, baker->AllocUserData);
+}
+
+static void ImFontAtlasAsyncBakerWorkerMain(ImFontAtlasAsyncBaker* baker)
+{
+    std::unique_lock<std::mutex> lock(baker->Mutex);
+    while (true)
+    {
+        while (!baker->Quit && baker->Queue.Size == 0)
+            baker->WakeWorkers.wait(lock);
+        if (baker->Quit)
+            return;
+        ImFontAtlasAsyncGlyphJob* job = baker->Queue[0];
+        baker->Queue.erase(baker->Queue.Data);
+        baker->RunningCount++;
+        lock.unlock();
+
+        memset(job->Pixels.Data, 0, (size_t)job->Pixels.Size);
+        stbtt_MakeGlyphBitmapSubpixelPrefilter(&job->FontInfo, job->Pixels.Data, job->W, job->H, job->W,
+            job->ScaleX, job->ScaleY, 0, 0, job->OversampleH, job->OversampleV, &job->SubX, &job->SubY, job->FontGlyphIndex);
+
+        lock.lock();
+        job->Done = true;
+        baker->RunningCount--;
+        baker->JobFinished.notify_all();
+    }
+}
+
+static void ImFontAtlasAsyncBakerQueueGlyph(ImFontAtlas* atlas, ImFontAtlasAsyncGlyphJob* job)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    ImFontAtlasAsyncBaker* baker = builder->AsyncBaker;
+    if (baker == NULL)
+    {
+        baker = builder->AsyncBaker = IM_NEW(ImFontAtlasAsyncBaker)();
+        int threads_count = IMGUI_FONT_ASYNC_BAKING_THREADS;
+        if (threads_count <= 0)
+            threads_count = ImClamp((int)std::thread::hardware_concurrency() - 1, 1, 4);
+        for (int n = 0; n < threads_count; n++)
+            baker->Threads.push_back(IM_NEW(std::thread)(ImFontAtlasAsyncBakerWorkerMain, baker));
+    }
+    job->FontInfo.userdata = baker;
+    job->Pixels.resize(job->W * job->H);
+    baker->Jobs.push_back(job);
+    {
+        std::lock_guard<std::mutex> lock(baker->Mutex);
+        baker->Queue.push_back(job);
+    }
+    baker->WakeWorkers.notify_one();
+}
+
+static void ImFontAtlasAsyncBakerCommitGlyph(ImFontAtlas* atlas, ImFontAtlasAsyncGlyphJob* job)
+{
+    ImFontAtlasRectId pack_id = ImFontAtlasPackAddRect(atlas, job->W, job->H);
+    if (pack_id == ImFontAtlasRectId_Invalid)
+    {
+        // Pathological out of memory case (TexMaxWidth/TexMaxHeight set too small?)
+        IM_ASSERT(pack_id != ImFontAtlasRectId_Invalid && "Out of texture memory.");
+        return;
+    }
+
+    // Making space may have discarded unused baked fonts: lookup after packing.
+    ImFontBaked* baked = (ImFontBaked*)atlas->Builder->BakedMap.GetVoidPtr(job->BakedId);
+    if (baked == NULL)
+    {
+        ImFontAtlasPackDiscardRect(atlas, pack_id);
+        return;
+    }
+    IM_ASSERT(job->GlyphIdx < baked->Glyphs.Size);
+    ImFontGlyph* glyph = &baked->Glyphs[job->GlyphIdx];
+    IM_ASSERT(glyph->Visible == false && glyph->PackId == ImFontAtlasRectId_Invalid);
+    ImTextureRect* r = ImFontAtlasPackGetRect(atlas, pack_id);
+
+    // Same as the synchronous path in ImGui_ImplStbTrueType_FontBakedLoadGlyph(). X0/X1 already hold the recentering offset added by ImFontAtlasBakedAddFontGlyph().
+    const float font_off_x = job->OffsetX + job->SubX;
+    const float font_off_y = job->OffsetY + job->SubY;
+    glyph->X0 = (job->BoxX0 * job->RecipH + font_off_x) + glyph->X0;
+    glyph->Y0 = (job->BoxY0 * job->RecipV + font_off_y) + glyph->Y0;
+    glyph->X1 = ((job->BoxX0 + (int)r->w) * job->RecipH + font_off_x) + glyph->X1;
+    glyph->Y1 = ((job->BoxY0 + (int)r->h) * job->RecipV + font_off_y) + glyph->Y1;
+    glyph->Visible = true;
+    glyph->PackId = pack_id;
+    glyph->U0 = (r->x) * atlas->TexUvScale.x;
+    glyph->V0 = (r->y) * atlas->TexUvScale.y;
+    glyph->U1 = (r->x + r->w) * atlas->TexUvScale.x;
+    glyph->V1 = (r->y + r->h) * atlas->TexUvScale.y;
+    baked->MetricsTotalSurface += r->w * r->h;
+    ImFontAtlasTextureUpdateGlyphRect(atlas, glyph);
+    ImFontAtlasBakedSetFontGlyphBitmap(atlas, baked, baked->ContainerFont->Sources[glyph->SourceIdx], glyph, r, job->Pixels.Data, ImTextureFormat_Alpha8, job->W);
+}
+
+void ImFontAtlasAsyncBakerCommit(ImFontAtlas* atlas)
+{
+    ImFontAtlasAsyncBaker* baker = atlas->Builder ? atlas->Builder->AsyncBaker : NULL;
+    if (baker == NULL || baker->Jobs.Size == 0)
+        return;
+
+    // Take finished jobs out, then commit them without holding the lock
+    {
+        std::lock_guard<std::mutex> lock(baker->Mutex);
+        int dst_n = 0;
+        for (ImFontAtlasAsyncGlyphJob* job : baker->Jobs)
+        {
+            if (job->Done)
+                baker->JobsDone.push_back(job);
+            else
+                baker->Jobs[dst_n++] = job;
+        }
+        baker->Jobs.resize(dst_n);
+    }
+    for (ImFontAtlasAsyncGlyphJob* job : baker->JobsDone)
+    {
+        if (!job->Cancelled)
+            ImFontAtlasAsyncBakerCommitGlyph(atlas, job);
+        IM_DELETE(job);
+    }
+    baker->JobsDone.resize(0);
+}
+
+// Cancel jobs for a baked font (glyph_idx == -1) or one of its glyphs. Jobs which are running complete and are dropped on commit.
+void ImFontAtlasAsyncBakerCancel(ImFontAtlas* atlas, ImGuiID baked_id, int glyph_idx)
+{
+    ImFontAtlasAsyncBaker* baker = atlas->Builder ? atlas->Builder->AsyncBaker : NULL;
+    if (baker == NULL || baker->Jobs.Size == 0)
+        return;
+    std::lock_guard<std::mutex> lock(baker->Mutex);
+    for (ImFontAtlasAsyncGlyphJob* job : baker->Jobs)
+        if (job->BakedId == baked_id && (glyph_idx == -1 || job->GlyphIdx == glyph_idx) && !job->Cancelled)
+        {
+            job->Cancelled = true;
+            if (baker->Queue.find_erase(job))
+                job->Done = true;
+        }
+}
+
+void ImFontAtlasAsyncBakerWaitIdle(ImFontAtlas* atlas)
+{
+    ImFontAtlasAsyncBaker* baker = atlas->Builder ? atlas->Builder->AsyncBaker : NULL;
+    if (baker == NULL)
+        return;
+    std::unique_lock<std::mutex> lock(baker->Mutex);
+    while (baker->RunningCount > 0)
+        baker->JobFinished.wait(lock);
+}
+
+void ImFontAtlasAsyncBakerDestroy(ImFontAtlas* atlas)
+{
+    ImFontAtlasAsyncBaker* baker = atlas->Builder ? atlas->Builder->AsyncBaker : NULL;
+    if (baker == NULL)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(baker->Mutex);
+        baker->Quit = true;
+    }
+    baker->WakeWorkers.notify_all();
+    for (std::thread* thread : baker->Threads)
+    {
+        thread->join();
+        IM_DELETE(thread);
+    }
+    for (ImFontAtlasAsyncGlyphJob* job : baker->Jobs)
+        IM_DELETE(job);
+    IM_DELETE(baker);
+    atlas->Builder->AsyncBaker = NULL;
+}
+
+int ImFontAtlasAsyncBakerGetPendingCount(ImFontAtlas* atlas)
+{
+    ImFontAtlasAsyncBaker* baker = atlas->Builder ? atlas->Builder->AsyncBaker : NULL;
+    return baker ? baker->Jobs.Size : 0;
+}
+
+#else
+
+void ImFontAtlasAsyncBakerCommit(ImFontAtlas*) {}
+void ImFontAtlasAsyncBakerCancel(ImFontAtlas*, ImGuiID, int) {}
+void ImFontAtlasAsyncBakerWaitIdle(ImFontAtlas*) {}
+void ImFontAtlasAsyncBakerDestroy(ImFontAtlas*) {}
+int  ImFontAtlasAsyncBakerGetPendingCount(ImFontAtlas*) { return 0; }
+
+#endif // #if defined(IMGUI_ENABLE_STB_TRUETYPE) && defined(IMGUI_ENABLE_FONT_ASYNC_BAKING)
+
 //-------------------------------------------------------------------------
 // [SECTION] ImFontAtlas: backend for stb_truetype
 //-------------------------------------------------------------------------
@@ -4570,6 +5887,7 @@ static bool ImGui_ImplStbTrueType_FontSrcInit(ImFontAtlas* atlas, ImFontConfig*
         IM_ASSERT_USER_ERROR(0, "stbtt_InitFont(): failed to parse FontData. It is correct and complete? Check FontDataSize.");
         return false;
     }
+    bd_font_data->FontInfo.userdata = NULL; // Passed to STBTT_malloc()
     src->FontLoaderData = bd_font_data;
 
     const float ref_size = src->DstFont->Sources[0]->SizePixels;
@@ -4623,6 +5941,62 @@ static bool ImGui_ImplStbTrueType_FontBakedInit(ImFontAtlas* atlas, ImFontConfig
     return true;
 }
 
+static void ImGui_ImplStbTrueType_GetGlyphOffset(ImFontConfig* src, ImFontBaked* baked, float* out_off_x, float* out_off_y)
+{
+    const float ref_size = baked->ContainerFont->Sources[0]->SizePixels;
+    const float offsets_scale = (ref_size != 0.0f) ? (baked->Size / ref_size) : 1.0f;
+    float font_off_x = (src->GlyphOffset.x * offsets_scale);
+    float font_off_y = (src->GlyphOffset.y * offsets_scale);
+    if (src->PixelSnapH) // Snap scaled offset. This is to mitigate backward compatibility issues for GlyphOffset, but a better design would be welcome.
+        font_off_x = IM_ROUND(font_off_x);
+    if (src->PixelSnapV)
+        font_off_y = IM_ROUND(font_off_y);
+    *out_off_x = font_off_x;
+    *out_off_y = font_off_y + IM_ROUND(baked->Ascent);
+}
+
+// Signed distance field for ImFontAtlasFlags_SDF. No oversampling: the field is bilinear filtered by the renderer.
+static bool ImGui_ImplStbTrueType_FontBakedRenderGlyphSDF(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, int glyph_index, ImFontGlyph* out_glyph)
+{
+    ImGui_ImplStbTrueType_FontSrcData* bd_font_data = (ImGui_ImplStbTrueType_FontSrcData*)src->FontLoaderData;
+    const float rasterizer_density = src->RasterizerDensity * baked->RasterizerDensity;
+    const float scale_for_raster = bd_font_data->ScaleFactor * baked->Size * rasterizer_density;
+    const int spread = ImMax(atlas->SDFSpread, 1);
+    int x0, y0, x1, y1;
+    stbtt_GetGlyphBitmapBox(&bd_font_data->FontInfo, glyph_index, scale_for_raster, scale_for_raster, &x0, &y0, &x1, &y1);
+    const int w = x1 - x0 + spread * 2;
+    const int h = y1 - y0 + spread * 2;
+
+    ImFontAtlasRectId pack_id = ImFontAtlasPackAddRect(atlas, w, h);
+    if (pack_id == ImFontAtlasRectId_Invalid)
+    {
+        // Pathological out of memory case (TexMaxWidth/TexMaxHeight set too small?)
+        IM_ASSERT(pack_id != ImFontAtlasRectId_Invalid && "Out of texture memory.");
+        return false;
+    }
+    ImTextureRect* r = ImFontAtlasPackGetRect(atlas, pack_id);
+
+    // Render coverage with 'spread' pixels of margin, then convert
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    builder->TempBuffer.resize(w * h);
+    unsigned char* bitmap_pixels = builder->TempBuffer.Data;
+    memset(bitmap_pixels, 0, w * h);
+    stbtt_MakeGlyphBitmap(&bd_font_data->FontInfo, bitmap_pixels + spread * w + spread, x1 - x0, y1 - y0, w, scale_for_raster, scale_for_raster, glyph_index);
+    ImFontAtlasBuildConvertCoverageToSDF(atlas, bitmap_pixels, w, h, spread);
+
+    float font_off_x, font_off_y;
+    ImGui_ImplStbTrueType_GetGlyphOffset(src, baked, &font_off_x, &font_off_y);
+    const float recip = 1.0f / rasterizer_density;
+    out_glyph->X0 = (x0 - spread) * recip + font_off_x;
+    out_glyph->Y0 = (y0 - spread) * recip + font_off_y;
+    out_glyph->X1 = (x0 - spread + (int)r->w) * recip + font_off_x;
+    out_glyph->Y1 = (y0 - spread + (int)r->h) * recip + font_off_y;
+    out_glyph->Visible = true;
+    out_glyph->PackId = pack_id;
+    ImFontAtlasBakedSetFontGlyphBitmap(atlas, baked, src, out_glyph, r, bitmap_pixels, ImTextureFormat_Alpha8, w);
+    return true;
+}
+
 static bool ImGui_ImplStbTrueType_FontBakedLoadGlyph(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, void*, ImWchar codepoint, ImFontGlyph* out_glyph, float* out_advance_x)
 {
     // Search for first font which has the glyph
@@ -4661,10 +6035,38 @@ static bool ImGui_ImplStbTrueType_FontBakedLoadGlyph(ImFontAtlas* atlas, ImFontC
     // Pack and retrieve position inside texture atlas
     // (generally based on stbtt_PackFontRangesRenderIntoRects)
     const bool is_visible = (x0 != x1 && y0 != y1);
+    if (is_visible && (atlas->Flags & ImFontAtlasFlags_SDF))
+        return ImGui_ImplStbTrueType_FontBakedRenderGlyphSDF(atlas, src, baked, glyph_index, out_glyph);
     if (is_visible)
     {
         const int w = (x1 - x0 + oversample_h - 1);
         const int h = (y1 - y0 + oversample_v - 1);
+
+#ifdef IMGUI_ENABLE_FONT_ASYNC_BAKING
+        // Register an invisible glyph now and rasterize it on a worker thread, see ImFontAtlasAsyncBakerCommitGlyph().
+        // Loads with no fallback are kept synchronous: they are used to build other glyphs (fallback, ellipsis).
+        if ((atlas->Flags & ImFontAtlasFlags_AsyncGlyphBaking) && !(atlas->Flags & ImFontAtlasFlags_SDF) && atlas->RendererHasTextures && !baked->LoadNoFallback)
+        {
+            ImFontAtlasAsyncGlyphJob* job = IM_NEW(ImFontAtlasAsyncGlyphJob)();
+            job->BakedId = baked->BakedId;
+            job->GlyphIdx = baked->Glyphs.Size; // ImFontBaked_BuildLoadGlyph() adds the glyph right after we return
+            job->FontInfo = bd_font_data->FontInfo;
+            job->FontGlyphIndex = glyph_index;
+            job->ScaleX = scale_for_raster_x;
+            job->ScaleY = scale_for_raster_y;
+            job->OversampleH = oversample_h;
+            job->OversampleV = oversample_v;
+            job->W = w;
+            job->H = h;
+            stbtt_GetGlyphBitmapBox(&bd_font_data->FontInfo, glyph_index, scale_for_raster_x, scale_for_raster_y, &job->BoxX0, &job->BoxY0, NULL, NULL);
+            ImGui_ImplStbTrueType_GetGlyphOffset(src, baked, &job->OffsetX, &job->OffsetY);
+            job->RecipH = 1.0f / (oversample_h * rasterizer_density);
+            job->RecipV = 1.0f / (oversample_v * rasterizer_density);
+            ImFontAtlasAsyncBakerQueueGlyph(atlas, job);
+            return true;
+        }
+#endif
+
         ImFontAtlasRectId pack_id = ImFontAtlasPackAddRect(atlas, w, h);
         if (pack_id == ImFontAtlasRectId_Invalid)
         {
@@ -4687,16 +6089,10 @@ static bool ImGui_ImplStbTrueType_FontBakedLoadGlyph(ImFontAtlas* atlas, ImFontC
         stbtt_MakeGlyphBitmapSubpixelPrefilter(&bd_font_data->FontInfo, bitmap_pixels, w, h, w,
             scale_for_raster_x, scale_for_raster_y, 0, 0, oversample_h, oversample_v, &sub_x, &sub_y, glyph_index);
 
-        const float ref_size = baked->ContainerFont->Sources[0]->SizePixels;
-        const float offsets_scale = (ref_size != 0.0f) ? (baked->Size / ref_size) : 1.0f;
-        float font_off_x = (src->GlyphOffset.x * offsets_scale);
-        float font_off_y = (src->GlyphOffset.y * offsets_scale);
-        if (src->PixelSnapH) // Snap scaled offset. This is to mitigate backward compatibility issues for GlyphOffset, but a better design would be welcome.
-            font_off_x = IM_ROUND(font_off_x);
-        if (src->PixelSnapV)
-            font_off_y = IM_ROUND(font_off_y);
+        float font_off_x, font_off_y;
+        ImGui_ImplStbTrueType_GetGlyphOffset(src, baked, &font_off_x, &font_off_y);
         font_off_x += sub_x;
-        font_off_y += sub_y + IM_ROUND(baked->Ascent);
+        font_off_y += sub_y;
         float recip_h = 1.0f / (oversample_h * rasterizer_density);
         float recip_v = 1.0f / (oversample_v * rasterizer_density);
 
@@ -5146,6 +6542,8 @@ ImFontGlyph* ImFontAtlasBakedAddFontGlyph(ImFontAtlas* atlas, ImFontBaked* baked
     }
     if (glyph->Colored)
         atlas->TexPixelsUseColors = atlas->TexData->UseColors = true;
+    if (glyph->PackId != ImFontAtlasRectId_Invalid)
+        ImFontAtlasTextureUpdateGlyphRect(atlas, glyph);
 
     // Update lookup tables
     const int codepoint = glyph->Codepoint;
@@ -5291,10 +6689,17 @@ ImFontBaked* ImFont::GetFontBaked(float size, float density)
 
     if (density < 0.0f)
         density = CurrentRasterizerDensity;
+
+    // Signed distance fields are baked once and scaled to all sizes
+    ImFontAtlas* atlas = ContainerAtlas;
+    if (atlas->Flags & ImFontAtlasFlags_SDF)
+    {
+        size = atlas->SDFBakeSize;
+        density = 1.0f;
+    }
     if (baked && baked->Size == size && baked->RasterizerDensity == density)
         return baked;
 
-    ImFontAtlas* atlas = ContainerAtlas;
     ImFontAtlasBuilder* builder = atlas->Builder;
     baked = ImFontAtlasBakedGetOrAdd(atlas, this, size, density);
     if (baked == NULL)
@@ -5581,6 +6986,147 @@ void ImFont::RenderChar(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     draw_list->PrimRectUV(ImVec2(x1, y1), ImVec2(x2, y2), ImVec2(u1, v1), ImVec2(u2, v2), col);
 }
 
+// Write the 4 vertices of a glyph quad at (x,y), in the same order as PrimRectUV(). Used by the RenderText() glyph run fast path.
+#if defined(IMGUI_ENABLE_SSE) && !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+// With the default 20 bytes ImDrawVert the quad is 80 contiguous bytes: assemble them in registers and write them with 5 stores.
+// Positions use the same operations as the scalar code (x + X0 * scale, etc.) so output is identical.
+static inline void ImFont_WriteGlyphQuad(ImDrawVert* vtx, const ImFontGlyph* glyph, float x, float y, float scale, ImU32 col)
+{
+    IM_STATIC_ASSERT(sizeof(ImDrawVert) == 20);
+    const __m128 xy = _mm_add_ps(_mm_setr_ps(x, y, x, y), _mm_mul_ps(_mm_loadu_ps(&glyph->X0), _mm_set1_ps(scale))); // x1 y1 x2 y2
+    const __m128 uv = _mm_loadu_ps(&glyph->U0);                                                                     // u1 v1 u2 v2
+    const __m128 c = _mm_castsi128_ps(_mm_cvtsi32_si128((int)col));                                                 // col 0 0 0
+    float* p = &vtx->pos.x;
+    _mm_storeu_ps(p + 0, _mm_movelh_ps(xy, uv));                                                                                            // x1 y1 u1 v1
+    _mm_storeu_ps(p + 4, _mm_or_ps(c, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(_mm_shuffle_ps(xy, uv, _MM_SHUFFLE(2, 2, 1, 2))), 4)))); // col x2 y1 u2
+    _mm_storeu_ps(p + 8, _mm_shuffle_ps(_mm_unpacklo_ps(_mm_shuffle_ps(uv, uv, _MM_SHUFFLE(1, 1, 1, 1)), c), xy, _MM_SHUFFLE(3, 2, 1, 0)));    // v1 col x2 y2
+    _mm_storeu_ps(p + 12, _mm_movelh_ps(_mm_movehl_ps(uv, uv), _mm_unpacklo_ps(c, xy)));                                                     // u2 v2 col x1
+    _mm_storeu_ps(p + 16, _mm_or_ps(_mm_castsi128_ps(_mm_srli_si128(_mm_castps_si128(_mm_shuffle_ps(xy, uv, _MM_SHUFFLE(3, 0, 3, 3))), 4)), _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(c), 12)))); // y2 u1 v2 col
+}
+#else
+static inline void ImFont_WriteGlyphQuad(ImDrawVert* vtx, const ImFontGlyph* glyph, float x, float y, float scale, ImU32 col)
+{
+    const float x1 = x + glyph->X0 * scale;
+    const float x2 = x + glyph->X1 * scale;
+    const float y1 = y + glyph->Y0 * scale;
+    const float y2 = y + glyph->Y1 * scale;
+    vtx[0].pos = ImVec2(x1, y1); vtx[0].col = col; vtx[0].uv = ImVec2(glyph->U0, glyph->V0);
+    vtx[1].pos = ImVec2(x2, y1); vtx[1].col = col; vtx[1].uv = ImVec2(glyph->U1, glyph->V0);
+    vtx[2].pos = ImVec2(x2, y2); vtx[2].col = col; vtx[2].uv = ImVec2(glyph->U1, glyph->V1);
+    vtx[3].pos = ImVec2(x1, y2); vtx[3].col = col; vtx[3].uv = ImVec2(glyph->U0, glyph->V1);
+}
+#endif
+
+// Output one ImDrawGlyph per visible glyph instead of a quad (ImDrawListFlags_GlyphInstances). Only called for unscaled text without wrapping nor CPU fine clipping.
+// Returns false when loading a glyph changed the texture: nothing is output and the caller starts over.
+static bool ImFont_RenderTextGlyphInstances(ImDrawList* draw_list, ImFontBaked* baked, float x, float y, float line_height, ImU32 col, const ImVec4& clip_rect, const char* s, const char* text_end)
+{
+    // Triangles added after the previous glyphs of this command must stay behind them: split the command first if they overlap.
+    draw_list->_CheckGlyphTail();
+
+    // Glyphs of a command need to be contiguous in GlyphBuffer[]
+    ImDrawCmd* cmd = &draw_list->CmdBuffer.Data[draw_list->CmdBuffer.Size - 1];
+    if (cmd->GlyphOffset + cmd->GlyphCount != (unsigned int)draw_list->GlyphBuffer.Size)
+    {
+        if (cmd->GlyphCount == 0)
+            cmd->GlyphOffset = (unsigned int)draw_list->GlyphBuffer.Size;
+        else
+            draw_list->AddDrawCmd();
+        cmd = &draw_list->CmdBuffer.Data[draw_list->CmdBuffer.Size - 1];
+    }
+
+    // Reserve for the worst case. Counting the reserved glyphs in the command keeps it in use if loading a glyph changes the texture (same as PrimReserve() does).
+    const int cmd_count = draw_list->CmdBuffer.Size;
+    const int glyph_count_max = (int)(text_end - s);
+    const int glyph_start = draw_list->GlyphBuffer.Size;
+    draw_list->GlyphBuffer.resize(glyph_start + glyph_count_max);
+    cmd->GlyphCount += glyph_count_max;
+    ImDrawGlyph* glyph_write = draw_list->GlyphBuffer.Data + glyph_start;
+
+    const ImU32 col_untinted = col | ~IM_COL32_A_MASK;
+    const float origin_x = x;
+    ImVec4 bb(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+    while (s < text_end)
+    {
+        unsigned int c = (unsigned int)*s;
+        if (c < 0x80)
+            s += 1;
+        else
+            s += ImTextCharFromUtf8(&c, s, text_end);
+
+        if (c < 32)
+        {
+            if (c == '\n')
+            {
+                x = origin_x;
+                y += line_height;
+                if (y > clip_rect.w)
+                    break;
+                continue;
+            }
+            if (c == '\r')
+                continue;
+        }
+
+        const ImFontGlyph* glyph;
+        if (c < (unsigned int)baked->IndexLookup.Size && baked->IndexLookup.Data[c] < IM_FONTGLYPH_INDEX_NOT_FOUND)
+            glyph = &baked->Glyphs.Data[baked->IndexLookup.Data[c]];
+        else
+            glyph = baked->FindGlyph((ImWchar)c);
+
+        if (glyph->Visible)
+        {
+            const float x1 = x + glyph->X0;
+            const float x2 = x + glyph->X1;
+            if (x1 <= clip_rect.z && x2 >= clip_rect.x)
+            {
+                IM_ASSERT_PARANOID(glyph->PackId != ImFontAtlasRectId_Invalid);
+                glyph_write->X = x;
+                glyph_write->Y = y;
+                glyph_write->GlyphId = (ImU32)ImFontAtlasRectId_GetIndex(glyph->PackId);
+                glyph_write->Col = glyph->Colored ? col_untinted : col;
+                glyph_write++;
+                bb.x = ImMin(bb.x, x1);
+                bb.y = ImMin(bb.y, y + glyph->Y0);
+                bb.z = ImMax(bb.z, x2);
+                bb.w = ImMax(bb.w, y + glyph->Y1);
+            }
+        }
+        x += glyph->AdvanceX;
+    }
+
+    // Edge case: loading a glyph changed the texture (see same in RenderText())
+    if (cmd_count != draw_list->CmdBuffer.Size)
+    {
+        IM_ASSERT(draw_list->CmdBuffer[draw_list->CmdBuffer.Size - 1].ElemCount == 0 && draw_list->CmdBuffer[draw_list->CmdBuffer.Size - 1].GlyphCount == 0);
+        draw_list->CmdBuffer.pop_back();
+        draw_list->CmdBuffer[cmd_count - 1].GlyphCount -= glyph_count_max;
+        draw_list->GlyphBuffer.Size = glyph_start;
+        draw_list->AddDrawCmd();
+        return false;
+    }
+
+    // Give back unused glyphs
+    const int glyph_count = (int)(glyph_write - (draw_list->GlyphBuffer.Data + glyph_start));
+    cmd = &draw_list->CmdBuffer.Data[cmd_count - 1];
+    cmd->GlyphCount -= glyph_count_max - glyph_count;
+    draw_list->GlyphBuffer.Size = glyph_start + glyph_count;
+    if (glyph_count == 0)
+        return true;
+
+    // Record the bounds of the run for _CheckGlyphTail(). Past IM_DRAWLIST_GLYPH_RUNS_MAX runs they are collapsed into one, which may split commands more than needed.
+    ImVector<ImVec4>& runs = draw_list->_GlyphRuns;
+    if (runs.Size == IM_DRAWLIST_GLYPH_RUNS_MAX)
+    {
+        for (int n = 1; n < runs.Size; n++)
+            runs[0] = ImVec4(ImMin(runs[0].x, runs[n].x), ImMin(runs[0].y, runs[n].y), ImMax(runs[0].z, runs[n].z), ImMax(runs[0].w, runs[n].w));
+        runs.resize(1);
+    }
+    runs.push_back(bb);
+    draw_list->_GlyphTailElemCount = cmd->ElemCount;
+    return true;
+}
+
 // Note: as with every ImDrawList drawing function, this expects that the font atlas texture is bound.
 void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip)
 {
@@ -5639,6 +7185,14 @@ begin:
     if (s == text_end)
         return;
 
+    // Output glyph instances for the renderer to expand (ImDrawListFlags_GlyphInstances)
+    if ((draw_list->Flags & ImDrawListFlags_GlyphInstances) && !word_wrap_enabled && !cpu_fine_clip && scale == 1.0f && draw_list->_CmdHeader.TexRef._TexData == ContainerAtlas->TexData && !ContainerAtlas->TexData->UseSDF)
+    {
+        if (!ImFont_RenderTextGlyphInstances(draw_list, baked, x, y, line_height, col, clip_rect, s, text_end))
+            goto begin;
+        return;
+    }
+
     // Reserve vertices for remaining worse case (over-reserving is useful and easily amortized)
     const int vtx_count_max = (int)(text_end - s) * 4;
     const int idx_count_max = (int)(text_end - s) * 6;
@@ -5651,9 +7205,65 @@ begin:
 
     const ImU32 col_untinted = col | ~IM_COL32_A_MASK;
     const char* word_wrap_eol = NULL;
+    const bool use_glyph_runs = !word_wrap_enabled && !cpu_fine_clip;
 
     while (s < text_end)
     {
+        // Fast path: render a run of ASCII/Latin-1 characters with already loaded glyphs.
+        // - Glyphs are read straight from IndexLookup[]. Control characters, other code points and glyphs needing a load end the run and go through the regular path below.
+        // - Quads are always written, the clip test then decides without branching whether they are kept.
+        // - Indices for the whole run are written at once from the ImDrawListSharedData::TextQuadIdx[] pattern.
+        if (use_glyph_runs)
+        {
+            const ImU16* index_lookup = baked->IndexLookup.Data; // Reloaded for each run as loading a glyph in the regular path may reallocate those.
+            const unsigned int index_lookup_size = (unsigned int)baked->IndexLookup.Size;
+            const ImFontGlyph* glyphs = baked->Glyphs.Data;
+            ImDrawVert* run_vtx_begin = vtx_write;
+            ImDrawVert* run_vtx_end = vtx_write + IM_DRAWLIST_TEXT_RUN_MAX * 4;
+            while (s < text_end && vtx_write < run_vtx_end)
+            {
+                unsigned int c = (unsigned char)*s;
+                int c_len = 1;
+                if (c >= 0x80)
+                {
+                    // U+0080..U+00FF are encoded as C2/C3 followed by a continuation byte
+                    if ((c & 0xFE) != 0xC2 || s + 1 >= text_end || ((unsigned char)s[1] & 0xC0) != 0x80)
+                        break;
+                    c = ((c & 0x1F) << 6) | ((unsigned char)s[1] & 0x3F);
+                    c_len = 2;
+                }
+                else if (c < 32)
+                {
+                    break;
+                }
+                if (c >= index_lookup_size)
+                    break;
+                const unsigned int glyph_index = index_lookup[c];
+                if (glyph_index >= IM_FONTGLYPH_INDEX_NOT_FOUND)
+                    break;
+                s += c_len;
+
+                const ImFontGlyph* glyph = &glyphs[glyph_index];
+                const float x1 = x + glyph->X0 * scale;
+                const float x2 = x + glyph->X1 * scale;
+                ImFont_WriteGlyphQuad(vtx_write, glyph, x, y, scale, glyph->Colored ? col_untinted : col);
+                vtx_write += (glyph->Visible & (x1 <= clip_rect.z) & (x2 >= clip_rect.x)) * 4;
+                x += glyph->AdvanceX * scale;
+            }
+
+            const int run_idx_count = (int)(vtx_write - run_vtx_begin) / 4 * 6;
+            const ImDrawIdx* quad_idx = draw_list->_Data->TextQuadIdx;
+            const ImDrawIdx run_vtx_index = (ImDrawIdx)vtx_index;
+            for (int n = 0; n < run_idx_count; n++)
+                idx_write[n] = (ImDrawIdx)(quad_idx[n] + run_vtx_index);
+            idx_write += run_idx_count;
+            vtx_index += (unsigned int)(vtx_write - run_vtx_begin);
+            if (s >= text_end)
+                break;
+            if (vtx_write == run_vtx_end)
+                continue;
+        }
+
         if (word_wrap_enabled)
         {
             // Calculate how far we can render. Requires two passes on the string data but keeps the code simple and not intrusive for what's essentially an uncommon feature.
@@ -5748,10 +7358,10 @@ begin:
 
                 // We are NOT calling PrimRectUV() here because non-inlined causes too much overhead in a debug builds. Inlined here:
                 {
-                    vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = glyph_col; vtx_write[0].uv.x = u1; vtx_write[0].uv.y = v1;
-                    vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = glyph_col; vtx_write[1].uv.x = u2; vtx_write[1].uv.y = v1;
-                    vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = glyph_col; vtx_write[2].uv.x = u2; vtx_write[2].uv.y = v2;
-                    vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = glyph_col; vtx_write[3].uv.x = u1; vtx_write[3].uv.y = v2;
+                    vtx_write[0].pos = ImVec2(x1, y1); vtx_write[0].col = glyph_col; vtx_write[0].uv = ImVec2(u1, v1);
+                    vtx_write[1].pos = ImVec2(x2, y1); vtx_write[1].col = glyph_col; vtx_write[1].uv = ImVec2(u2, v1);
+                    vtx_write[2].pos = ImVec2(x2, y2); vtx_write[2].col = glyph_col; vtx_write[2].uv = ImVec2(u2, v2);
+                    vtx_write[3].pos = ImVec2(x1, y2); vtx_write[3].col = glyph_col; vtx_write[3].uv = ImVec2(u1, v2);
                     idx_write[0] = (ImDrawIdx)(vtx_index); idx_write[1] = (ImDrawIdx)(vtx_index + 1); idx_write[2] = (ImDrawIdx)(vtx_index + 2);
                     idx_write[3] = (ImDrawIdx)(vtx_index); idx_write[4] = (ImDrawIdx)(vtx_index + 2); idx_write[5] = (ImDrawIdx)(vtx_index + 3);
                     vtx_write += 4;
@@ -6,6 +6,7 @@
 //  [X] Renderer: Large meshes support (64k+ vertices) even with 16-bit indices (ImGuiBackendFlags_RendererHasVtxOffset).
 //  [X] Renderer: Texture updates support for dynamic font atlas (ImGuiBackendFlags_RendererHasTextures).
 //  [X] Renderer: Expose selected render state for draw callbacks to use. Access in '(ImGui_ImplXXXX_RenderState*)GetPlatformIO().Renderer_RenderState'.
+//  [X] Renderer: Glyph instances expanded in the vertex shader (ImGuiBackendFlags_RendererHasGlyphInstances), opt-in with ImGui_ImplDX12_InitInfo::UseGlyphInstances.
 
 // The aim of imgui_impl_dx12.h/.cpp is to be usable in your engine without any modification.
 // IF YOU FEEL YOU NEED TO MAKE ANY CHANGE TO THIS CODE, please share them and your feedback at https://github.com/ocornut/imgui/
@@ -20,6 +21,12 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2026-10-18: DirectX12: Draw glyph instances (ImGuiBackendFlags_RendererHasGlyphInstances) with DrawInstanced(), expanding quads in the vertex shader from ImTextureData::GlyphRects[] bound as a root SRV at t1. Opt-in with ImGui_ImplDX12_InitInfo::UseGlyphInstances.
+//  2026-10-18: DirectX12: Support the 12 bytes ImDrawVert enabled by IMGUI_USE_COMPACT_DRAWVERT (16-bit fixed point positions and normalized UVs, unpacked in the vertex shader).
+//  2026-10-18: DirectX12: Copy large frames into upload buffers with non-temporal stores, split in jobs which can run on the application job system (ImGui_ImplDX12_InitInfo::ParallelForFn).
+//  2026-10-18: DirectX12: Render textures with ImTextureData::UseSDF (ImFontAtlasFlags_SDF) with a second pipeline state thresholding signed distance fields.
+//  2026-10-18: DirectX12: Added optional ImGui_ImplDX12_InitInfo::ResourceCreateFn/ResourceReleaseFn to let the application allocate buffers and textures (e.g. placed in its own heaps).
+//  2026-10-18: DirectX12: Added ImGui_ImplDX12_RenderDrawDataInRects() to redraw only damaged regions (for partial presents with IDXGISwapChain1::Present1() dirty rects).
 //  2025-06-19: Fixed build on MinGW. (#8702, #4594)
 //  2025-06-11: DirectX12: Added support for ImGuiBackendFlags_RendererHasTextures, for dynamic font atlas.
 //  2025-05-07: DirectX12: Honor draw_data->FramebufferScale to allow for custom backends and experiment using it (consistently with other renderer backends, even though in normal condition it is not set under Windows).
@@ -53,6 +60,7 @@
 #include "imgui.h"
 #ifndef IMGUI_DISABLE
 #include "imgui_impl_dx12.h"
+#include "imgui_impl_dx12_upload.h"
 
 // DirectX
 #include <d3d12.h>
@@ -62,6 +70,13 @@
 #pragma comment(lib, "d3dcompiler") // Automatically link with d3dcompiler.lib as we are using D3DCompile() below.
 #endif
 
+// Frames uploading fewer bytes of vertices and indices are copied with memcpy() on the calling thread.
+#ifndef IMGUI_IMPL_DX12_UPLOAD_STREAM_MIN_SIZE
+#define IMGUI_IMPL_DX12_UPLOAD_STREAM_MIN_SIZE  (1024 * 1024)
+#endif
+#define IMGUI_IMPL_DX12_STRINGIFY_HELPER(_X)    #_X
+#define IMGUI_IMPL_DX12_STRINGIFY(_X)           IMGUI_IMPL_DX12_STRINGIFY_HELPER(_X)
+
 // Clang/GCC warnings with -Weverything
 #if defined(__clang__)
 #pragma clang diagnostic ignored "-Wold-style-cast"         // warning: use of old-style cast                            // yes, they are more terse.
@@ -83,12 +98,24 @@ struct ImGui_ImplDX12_Texture
     ImGui_ImplDX12_Texture()    { memset((void*)this, 0, sizeof(*this)); }
 };
 
+// A glyph rect table (ImTextureData::GlyphRects[]) in ImGui_ImplDX12_RenderBuffers::GlyphRectBuffer
+struct ImGui_ImplDX12_GlyphRects
+{
+    ImTextureData*              Tex;
+    int                         TexUniqueID;
+    int                         Version;                // ImTextureData::GlyphRectsVersion when uploaded
+    int                         Offset;                 // In number of rects
+    int                         Count;
+};
+
 struct ImGui_ImplDX12_Data
 {
     ImGui_ImplDX12_InitInfo     InitInfo;
     ID3D12Device*               pd3dDevice;
     ID3D12RootSignature*        pRootSignature;
     ID3D12PipelineState*        pPipelineState;
+    ID3D12PipelineState*        pPipelineStateSDF;      // Same with a pixel shader thresholding signed distance fields, for textures with UseSDF set
+    ID3D12PipelineState*        pPipelineStateGlyphs;   // Same pixel shader, vertex shader expanding glyph instances (ImDrawCmd::GlyphCount)
     ID3D12CommandQueue*         pCommandQueue;
     bool                        commandQueueOwned;
     DXGI_FORMAT                 RTVFormat;
@@ -102,6 +129,9 @@ struct ImGui_ImplDX12_Data
     ImGui_ImplDX12_Texture      FontTexture;
     bool                        LegacySingleDescriptorUsed;
 
+    ImGui_ImplDX12_UploadJobs   UploadJobs;             // Copies for large frames (see imgui_impl_dx12_upload.h)
+    ImVector<ImGui_ImplDX12_GlyphRects> GlyphRectTables;// Glyph rect tables used by the frame being rendered
+
     ImGui_ImplDX12_Data()       { memset((void*)this, 0, sizeof(*this)); frameIndex = UINT_MAX; }
 };
 
@@ -117,8 +147,13 @@ struct ImGui_ImplDX12_RenderBuffers
 {
     ID3D12Resource*     IndexBuffer;
     ID3D12Resource*     VertexBuffer;
+    ID3D12Resource*     GlyphBuffer;            // ImDrawGlyph instances, bound to input slot 1
+    ID3D12Resource*     GlyphRectBuffer;        // ImDrawGlyphRect tables, bound as a root SRV
     int                 IndexBufferSize;
     int                 VertexBufferSize;
+    int                 GlyphBufferSize;
+    int                 GlyphRectBufferSize;
+    ImVector<ImGui_ImplDX12_GlyphRects> GlyphRectTables; // Tables in GlyphRectBuffer, only uploaded again when they changed since this buffer was last used
 };
 
 struct VERTEX_CONSTANT_BUFFER_DX12
@@ -171,6 +206,14 @@ static void ImGui_ImplDX12_SetupRenderState(ImDrawData* draw_data, ID3D12Graphic
     ibv.SizeInBytes = fr->IndexBufferSize * sizeof(ImDrawIdx);
     ibv.Format = sizeof(ImDrawIdx) == 2 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
     command_list->IASetIndexBuffer(&ibv);
+    if (fr->GlyphBuffer != nullptr)
+    {
+        D3D12_VERTEX_BUFFER_VIEW gbv = {};
+        gbv.BufferLocation = fr->GlyphBuffer->GetGPUVirtualAddress();
+        gbv.SizeInBytes = fr->GlyphBufferSize * sizeof(ImDrawGlyph);
+        gbv.StrideInBytes = sizeof(ImDrawGlyph);
+        command_list->IASetVertexBuffers(1, 1, &gbv);
+    }
     command_list->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
     command_list->SetPipelineState(bd->pPipelineState);
     command_list->SetGraphicsRootSignature(bd->pRootSignature);
@@ -189,8 +232,138 @@ static inline void SafeRelease(T*& res)
     res = nullptr;
 }
 
+// Buffers and textures go through the user allocator when one is provided
+static HRESULT ImGui_ImplDX12_CreateResource(const D3D12_HEAP_PROPERTIES* props, const D3D12_RESOURCE_DESC* desc, D3D12_RESOURCE_STATES initial_state, ID3D12Resource** out_resource)
+{
+    ImGui_ImplDX12_Data* bd = ImGui_ImplDX12_GetBackendData();
+    if (bd->InitInfo.ResourceCreateFn != nullptr)
+        return bd->InitInfo.ResourceCreateFn(&bd->InitInfo, props, desc, initial_state, out_resource);
+    return bd->pd3dDevice->CreateCommittedResource(props, D3D12_HEAP_FLAG_NONE, desc, initial_state, nullptr, IID_PPV_ARGS(out_resource));
+}
+
+static void ImGui_ImplDX12_ReleaseResource(ID3D12Resource*& res)
+{
+    ImGui_ImplDX12_Data* bd = ImGui_ImplDX12_GetBackendData();
+    if (res && bd->InitInfo.ResourceReleaseFn != nullptr)
+        bd->InitInfo.ResourceReleaseFn(&bd->InitInfo, res);
+    else if (res)
+        res->Release();
+    res = nullptr;
+}
+
+// May run on any thread (see ImGui_ImplDX12_InitInfo::ParallelForFn), so backend data is passed explicitly.
+static void ImGui_ImplDX12_UploadJob(void* job_data, int job_n)
+{
+    ImGui_ImplDX12_Data* bd = (ImGui_ImplDX12_Data*)job_data;
+    bd->UploadJobs.RunJob(job_n);
+}
+
+static HRESULT ImGui_ImplDX12_CreateUploadBuffer(size_t size, ID3D12Resource** out_resource)
+{
+    D3D12_HEAP_PROPERTIES props = {};
+    props.Type = D3D12_HEAP_TYPE_UPLOAD;
+    props.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+    props.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+    D3D12_RESOURCE_DESC desc = {};
+    desc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+    desc.Width = size;
+    desc.Height = 1;
+    desc.DepthOrArraySize = 1;
+    desc.MipLevels = 1;
+    desc.Format = DXGI_FORMAT_UNKNOWN;
+    desc.SampleDesc.Count = 1;
+    desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+    desc.Flags = D3D12_RESOURCE_FLAG_NONE;
+    return ImGui_ImplDX12_CreateResource(&props, &desc, D3D12_RESOURCE_STATE_GENERIC_READ, out_resource);
+}
+
+// Upload glyph instances, and the glyph rect tables of the textures they use (usually only the font atlas).
+// Rect tables only change when glyphs are added to the atlas, so they are skipped when this frame resource already holds the same versions.
+static bool ImGui_ImplDX12_UploadGlyphs(ImDrawData* draw_data, ImGui_ImplDX12_RenderBuffers* fr)
+{
+    ImGui_ImplDX12_Data* bd = ImGui_ImplDX12_GetBackendData();
+    ImVector<ImGui_ImplDX12_GlyphRects>& tables = bd->GlyphRectTables;
+    tables.resize(0);
+    int rects_count = 0;
+    for (const ImDrawList* draw_list : draw_data->CmdLists)
+        for (const ImDrawCmd& cmd : draw_list->CmdBuffer)
+        {
+            if (cmd.GlyphCount == 0)
+                continue;
+            ImTextureData* tex = cmd.TexRef._TexData;
+            IM_ASSERT(tex != nullptr && tex->GlyphRects.Size > 0);
+            bool found = false;
+            for (const ImGui_ImplDX12_GlyphRects& table : tables)
+                if (table.Tex == tex)
+                {
+                    found = true;
+                    break;
+                }
+            if (found)
+                continue;
+            ImGui_ImplDX12_GlyphRects table = { tex, tex->UniqueID, tex->GlyphRectsVersion, rects_count, tex->GlyphRects.Size };
+            tables.push_back(table);
+            rects_count += tex->GlyphRects.Size;
+        }
+
+    // Create and grow buffers if needed
+    if (fr->GlyphBuffer == nullptr || fr->GlyphBufferSize < draw_data->TotalGlyphCount)
+    {
+        ImGui_ImplDX12_ReleaseResource(fr->GlyphBuffer);
+        fr->GlyphBufferSize = draw_data->TotalGlyphCount + 2000;
+        if (ImGui_ImplDX12_CreateUploadBuffer(fr->GlyphBufferSize * sizeof(ImDrawGlyph), &fr->GlyphBuffer) < 0)
+            return false;
+    }
+    if (fr->GlyphRectBuffer == nullptr || fr->GlyphRectBufferSize < rects_count)
+    {
+        ImGui_ImplDX12_ReleaseResource(fr->GlyphRectBuffer);
+        fr->GlyphRectBufferSize = rects_count + 500;
+        fr->GlyphRectTables.resize(0);
+        if (ImGui_ImplDX12_CreateUploadBuffer(fr->GlyphRectBufferSize * sizeof(ImDrawGlyphRect), &fr->GlyphRectBuffer) < 0)
+            return false;
+    }
+
+    // Upload glyph instances
+    void* glyph_resource;
+    D3D12_RANGE range = { 0, 0 };
+    if (fr->GlyphBuffer->Map(0, &range, &glyph_resource) != S_OK)
+        return false;
+    ImDrawGlyph* glyph_dst = (ImDrawGlyph*)glyph_resource;
+    for (const ImDrawList* draw_list : draw_data->CmdLists)
+    {
+        memcpy(glyph_dst, draw_list->GlyphBuffer.Data, draw_list->GlyphBuffer.Size * sizeof(ImDrawGlyph));
+        glyph_dst += draw_list->GlyphBuffer.Size;
+    }
+    range.End = (SIZE_T)((intptr_t)glyph_dst - (intptr_t)glyph_resource);
+    IM_ASSERT(range.End == draw_data->TotalGlyphCount * sizeof(ImDrawGlyph));
+    fr->GlyphBuffer->Unmap(0, &range);
+
+    // Upload glyph rect tables if they changed
+    bool tables_changed = (tables.Size != fr->GlyphRectTables.Size);
+    for (int n = 0; n < tables.Size && !tables_changed; n++)
+    {
+        const ImGui_ImplDX12_GlyphRects& a = tables[n];
+        const ImGui_ImplDX12_GlyphRects& b = fr->GlyphRectTables[n];
+        tables_changed = (a.TexUniqueID != b.TexUniqueID || a.Version != b.Version || a.Offset != b.Offset || a.Count != b.Count);
+    }
+    if (tables_changed)
+    {
+        void* rect_resource;
+        range.End = 0;
+        if (fr->GlyphRectBuffer->Map(0, &range, &rect_resource) != S_OK)
+            return false;
+        for (const ImGui_ImplDX12_GlyphRects& table : tables)
+            memcpy((ImDrawGlyphRect*)rect_resource + table.Offset, table.Tex->GlyphRects.Data, table.Count * sizeof(ImDrawGlyphRect));
+        range.End = rects_count * sizeof(ImDrawGlyphRect);
+        fr->GlyphRectBuffer->Unmap(0, &range);
+        fr->GlyphRectTables = tables;
+    }
+    return true;
+}
+
 // Render function
-void ImGui_ImplDX12_RenderDrawData(ImDrawData* draw_data, ID3D12GraphicsCommandList* command_list)
+// When rects_count > 0, draw calls are additionally scissored to each of 'rects' (in framebuffer space) and skipped when they don't intersect any.
+static void ImGui_ImplDX12_RenderDrawDataImpl(ImDrawData* draw_data, ID3D12GraphicsCommandList* command_list, const D3D12_RECT* rects, int rects_count)
 {
     // Avoid rendering when minimized
     if (draw_data->DisplaySize.x <= 0.0f || draw_data->DisplaySize.y <= 0.0f)
@@ -211,7 +384,7 @@ void ImGui_ImplDX12_RenderDrawData(ImDrawData* draw_data, ID3D12GraphicsCommandL
     // Create and grow vertex/index buffers if needed
     if (fr->VertexBuffer == nullptr || fr->VertexBufferSize < draw_data->TotalVtxCount)
     {
-        SafeRelease(fr->VertexBuffer);
+        ImGui_ImplDX12_ReleaseResource(fr->VertexBuffer);
         fr->VertexBufferSize = draw_data->TotalVtxCount + 5000;
         D3D12_HEAP_PROPERTIES props = {};
         props.Type = D3D12_HEAP_TYPE_UPLOAD;
@@ -227,12 +400,12 @@ void ImGui_ImplDX12_RenderDrawData(ImDrawData* draw_data, ID3D12GraphicsCommandL
         desc.SampleDesc.Count = 1;
         desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
         desc.Flags = D3D12_RESOURCE_FLAG_NONE;
-        if (bd->pd3dDevice->CreateCommittedResource(&props, D3D12_HEAP_FLAG_NONE, &desc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&fr->VertexBuffer)) < 0)
+        if (ImGui_ImplDX12_CreateResource(&props, &desc, D3D12_RESOURCE_STATE_GENERIC_READ, &fr->VertexBuffer) < 0)
             return;
     }
     if (fr->IndexBuffer == nullptr || fr->IndexBufferSize < draw_data->TotalIdxCount)
     {
-        SafeRelease(fr->IndexBuffer);
+        ImGui_ImplDX12_ReleaseResource(fr->IndexBuffer);
         fr->IndexBufferSize = draw_data->TotalIdxCount + 10000;
         D3D12_HEAP_PROPERTIES props = {};
         props.Type = D3D12_HEAP_TYPE_UPLOAD;
@@ -248,7 +421,7 @@ void ImGui_ImplDX12_RenderDrawData(ImDrawData* draw_data, ID3D12GraphicsCommandL
         desc.SampleDesc.Count = 1;
         desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
         desc.Flags = D3D12_RESOURCE_FLAG_NONE;
-        if (bd->pd3dDevice->CreateCommittedResource(&props, D3D12_HEAP_FLAG_NONE, &desc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&fr->IndexBuffer)) < 0)
+        if (ImGui_ImplDX12_CreateResource(&props, &desc, D3D12_RESOURCE_STATE_GENERIC_READ, &fr->IndexBuffer) < 0)
             return;
     }
 
@@ -262,12 +435,39 @@ void ImGui_ImplDX12_RenderDrawData(ImDrawData* draw_data, ID3D12GraphicsCommandL
         return;
     ImDrawVert* vtx_dst = (ImDrawVert*)vtx_resource;
     ImDrawIdx* idx_dst = (ImDrawIdx*)idx_resource;
-    for (const ImDrawList* draw_list : draw_data->CmdLists)
+    const size_t upload_size = draw_data->TotalVtxCount * sizeof(ImDrawVert) + draw_data->TotalIdxCount * sizeof(ImDrawIdx);
+    if (upload_size < IMGUI_IMPL_DX12_UPLOAD_STREAM_MIN_SIZE)
     {
-        memcpy(vtx_dst, draw_list->VtxBuffer.Data, draw_list->VtxBuffer.Size * sizeof(ImDrawVert));
-        memcpy(idx_dst, draw_list->IdxBuffer.Data, draw_list->IdxBuffer.Size * sizeof(ImDrawIdx));
-        vtx_dst += draw_list->VtxBuffer.Size;
-        idx_dst += draw_list->IdxBuffer.Size;
+        for (const ImDrawList* draw_list : draw_data->CmdLists)
+        {
+            memcpy(vtx_dst, draw_list->VtxBuffer.Data, draw_list->VtxBuffer.Size * sizeof(ImDrawVert));
+            memcpy(idx_dst, draw_list->IdxBuffer.Data, draw_list->IdxBuffer.Size * sizeof(ImDrawIdx));
+            vtx_dst += draw_list->VtxBuffer.Size;
+            idx_dst += draw_list->IdxBuffer.Size;
+        }
+    }
+    else
+    {
+        // Large frames: destinations are laid out first, then copied in jobs of similar sizes with non-temporal stores.
+        // All vertex buffers then all index buffers, so jobs never share a line of the destination (see ImGui_ImplDX12_UploadJobs).
+        ImGui_ImplDX12_UploadJobs* jobs = &bd->UploadJobs;
+        jobs->Clear();
+        for (const ImDrawList* draw_list : draw_data->CmdLists)
+        {
+            jobs->AddCopy(vtx_dst, draw_list->VtxBuffer.Data, draw_list->VtxBuffer.Size * sizeof(ImDrawVert));
+            vtx_dst += draw_list->VtxBuffer.Size;
+        }
+        for (const ImDrawList* draw_list : draw_data->CmdLists)
+        {
+            jobs->AddCopy(idx_dst, draw_list->IdxBuffer.Data, draw_list->IdxBuffer.Size * sizeof(ImDrawIdx));
+            idx_dst += draw_list->IdxBuffer.Size;
+        }
+        const int jobs_count = jobs->Finish();
+        if (bd->InitInfo.ParallelForFn != nullptr && jobs_count > 1)
+            bd->InitInfo.ParallelForFn(&bd->InitInfo, ImGui_ImplDX12_UploadJob, bd, jobs_count);
+        else
+            for (int job_n = 0; job_n < jobs_count; job_n++)
+                ImGui_ImplDX12_UploadJob(bd, job_n);
     }
 
     // During Unmap() we specify the written range (as per DX12 API, this is informational and for tooling only)
@@ -278,6 +478,11 @@ void ImGui_ImplDX12_RenderDrawData(ImDrawData* draw_data, ID3D12GraphicsCommandL
     IM_ASSERT(range.End == draw_data->TotalIdxCount * sizeof(ImDrawIdx));
     fr->IndexBuffer->Unmap(0, &range);
 
+    // Upload glyph instances (ImGuiBackendFlags_RendererHasGlyphInstances)
+    if (draw_data->TotalGlyphCount > 0)
+        if (!ImGui_ImplDX12_UploadGlyphs(draw_data, fr))
+            return;
+
     // Setup desired DX state
     ImGui_ImplDX12_SetupRenderState(draw_data, command_list, fr);
 
@@ -290,8 +495,10 @@ void ImGui_ImplDX12_RenderDrawData(ImDrawData* draw_data, ID3D12GraphicsCommandL
 
     // Render command lists
     // (Because we merged all buffers into a single one, we maintain our own offset into them)
+    ID3D12PipelineState* pipeline_state = bd->pPipelineState;
     int global_vtx_offset = 0;
     int global_idx_offset = 0;
+    int global_glyph_offset = 0;
     ImVec2 clip_off = draw_data->DisplayPos;
     ImVec2 clip_scale = draw_data->FramebufferScale;
     for (const ImDrawList* draw_list : draw_data->CmdLists)
@@ -304,9 +511,15 @@ void ImGui_ImplDX12_RenderDrawData(ImDrawData* draw_data, ID3D12GraphicsCommandL
                 // User callback, registered via ImDrawList::AddCallback()
                 // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
                 if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
+                {
                     ImGui_ImplDX12_SetupRenderState(draw_data, command_list, fr);
+                    pipeline_state = bd->pPipelineState;
+                }
                 else
+                {
                     pcmd->UserCallback(draw_list, pcmd);
+                    pipeline_state = nullptr; // Callback may have bound its own
+                }
             }
             else
             {
@@ -316,23 +529,84 @@ void ImGui_ImplDX12_RenderDrawData(ImDrawData* draw_data, ID3D12GraphicsCommandL
                 if (clip_max.x <= clip_min.x || clip_max.y <= clip_min.y)
                     continue;
 
+                // Glyph rects of the command texture
+                D3D12_GPU_VIRTUAL_ADDRESS glyph_rects_address = 0;
+                if (pcmd->GlyphCount > 0)
+                    for (const ImGui_ImplDX12_GlyphRects& table : bd->GlyphRectTables)
+                        if (table.Tex == pcmd->TexRef._TexData)
+                            glyph_rects_address = fr->GlyphRectBuffer->GetGPUVirtualAddress() + table.Offset * sizeof(ImDrawGlyphRect);
+
                 // Apply scissor/clipping rectangle
                 const D3D12_RECT r = { (LONG)clip_min.x, (LONG)clip_min.y, (LONG)clip_max.x, (LONG)clip_max.y };
-                command_list->RSSetScissorRects(1, &r);
-
-                // Bind texture, Draw
-                D3D12_GPU_DESCRIPTOR_HANDLE texture_handle = {};
-                texture_handle.ptr = (UINT64)pcmd->GetTexID();
-                command_list->SetGraphicsRootDescriptorTable(1, texture_handle);
-                command_list->DrawIndexedInstanced(pcmd->ElemCount, 1, pcmd->IdxOffset + global_idx_offset, pcmd->VtxOffset + global_vtx_offset, 0);
+                bool texture_bound = false;
+                for (int rect_n = 0; rect_n < (rects_count > 0 ? rects_count : 1); rect_n++)
+                {
+                    D3D12_RECT scissor = r;
+                    if (rects_count > 0)
+                    {
+                        const D3D12_RECT& damage = rects[rect_n];
+                        scissor.left = (r.left > damage.left) ? r.left : damage.left;
+                        scissor.top = (r.top > damage.top) ? r.top : damage.top;
+                        scissor.right = (r.right < damage.right) ? r.right : damage.right;
+                        scissor.bottom = (r.bottom < damage.bottom) ? r.bottom : damage.bottom;
+                        if (scissor.right <= scissor.left || scissor.bottom <= scissor.top)
+                            continue;
+                    }
+                    command_list->RSSetScissorRects(1, &scissor);
+
+                    // Bind texture, Draw
+                    if (!texture_bound)
+                    {
+                        D3D12_GPU_DESCRIPTOR_HANDLE texture_handle = {};
+                        texture_handle.ptr = (UINT64)pcmd->GetTexID();
+                        command_list->SetGraphicsRootDescriptorTable(1, texture_handle);
+                        if (pcmd->GlyphCount > 0)
+                            command_list->SetGraphicsRootShaderResourceView(2, glyph_rects_address);
+                        texture_bound = true;
+                    }
+                    if (pcmd->ElemCount > 0)
+                    {
+                        const ImTextureData* tex = pcmd->TexRef._TexData;
+                        ID3D12PipelineState* cmd_pipeline_state = (tex != nullptr && tex->UseSDF) ? bd->pPipelineStateSDF : bd->pPipelineState;
+                        if (cmd_pipeline_state != pipeline_state)
+                        {
+                            command_list->SetPipelineState(cmd_pipeline_state);
+                            pipeline_state = cmd_pipeline_state;
+                        }
+                        command_list->DrawIndexedInstanced(pcmd->ElemCount, 1, pcmd->IdxOffset + global_idx_offset, pcmd->VtxOffset + global_vtx_offset, 0);
+                    }
+
+                    // Glyph instances are drawn after the command triangles, 6 vertices each (see ImDrawGlyph)
+                    if (pcmd->GlyphCount > 0)
+                    {
+                        if (pipeline_state != bd->pPipelineStateGlyphs)
+                        {
+                            command_list->SetPipelineState(bd->pPipelineStateGlyphs);
+                            pipeline_state = bd->pPipelineStateGlyphs;
+                        }
+                        command_list->DrawInstanced(6, pcmd->GlyphCount, 0, pcmd->GlyphOffset + global_glyph_offset);
+                    }
+                }
             }
         }
         global_idx_offset += draw_list->IdxBuffer.Size;
         global_vtx_offset += draw_list->VtxBuffer.Size;
+        global_glyph_offset += draw_list->GlyphBuffer.Size;
     }
     platform_io.Renderer_RenderState = nullptr;
 }
 
+void ImGui_ImplDX12_RenderDrawData(ImDrawData* draw_data, ID3D12GraphicsCommandList* command_list)
+{
+    ImGui_ImplDX12_RenderDrawDataImpl(draw_data, command_list, nullptr, 0);
+}
+
+void ImGui_ImplDX12_RenderDrawDataInRects(ImDrawData* draw_data, ID3D12GraphicsCommandList* command_list, const D3D12_RECT* rects, int rects_count)
+{
+    IM_ASSERT(rects != nullptr || rects_count == 0);
+    ImGui_ImplDX12_RenderDrawDataImpl(draw_data, command_list, rects, rects_count);
+}
+
 static void ImGui_ImplDX12_DestroyTexture(ImTextureData* tex)
 {
     ImGui_ImplDX12_Texture* backend_tex = (ImGui_ImplDX12_Texture*)tex->BackendUserData;
@@ -341,7 +615,7 @@ static void ImGui_ImplDX12_DestroyTexture(ImTextureData* tex)
     IM_ASSERT(backend_tex->hFontSrvGpuDescHandle.ptr == (UINT64)tex->TexID);
     ImGui_ImplDX12_Data* bd = ImGui_ImplDX12_GetBackendData();
     bd->InitInfo.SrvDescriptorFreeFn(&bd->InitInfo, backend_tex->hFontSrvCpuDescHandle, backend_tex->hFontSrvGpuDescHandle);
-    SafeRelease(backend_tex->pTextureResource);
+    ImGui_ImplDX12_ReleaseResource(backend_tex->pTextureResource);
     backend_tex->hFontSrvCpuDescHandle.ptr = 0;
     backend_tex->hFontSrvGpuDescHandle.ptr = 0;
     IM_DELETE(backend_tex);
@@ -386,8 +660,7 @@ void ImGui_ImplDX12_UpdateTexture(ImTextureData* tex)
         desc.Flags = D3D12_RESOURCE_FLAG_NONE;
 
         ID3D12Resource* pTexture = nullptr;
-        bd->pd3dDevice->CreateCommittedResource(&props, D3D12_HEAP_FLAG_NONE, &desc,
-            D3D12_RESOURCE_STATE_COPY_DEST, nullptr, IID_PPV_ARGS(&pTexture));
+        ImGui_ImplDX12_CreateResource(&props, &desc, D3D12_RESOURCE_STATE_COPY_DEST, &pTexture);
 
         // Create SRV
         D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc;
@@ -398,7 +671,7 @@ void ImGui_ImplDX12_UpdateTexture(ImTextureData* tex)
         srvDesc.Texture2D.MostDetailedMip = 0;
         srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
         bd->pd3dDevice->CreateShaderResourceView(pTexture, &srvDesc, backend_tex->hFontSrvCpuDescHandle);
-        SafeRelease(backend_tex->pTextureResource);
+        ImGui_ImplDX12_ReleaseResource(backend_tex->pTextureResource);
         backend_tex->pTextureResource = pTexture;
 
         // Store identifiers
@@ -450,8 +723,7 @@ void ImGui_ImplDX12_UpdateTexture(ImTextureData* tex)
 
         // FIXME-OPT: Can upload buffer be reused?
         ID3D12Resource* uploadBuffer = nullptr;
-        HRESULT hr = bd->pd3dDevice->CreateCommittedResource(&props, D3D12_HEAP_FLAG_NONE, &desc,
-            D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&uploadBuffer));
+        HRESULT hr = ImGui_ImplDX12_CreateResource(&props, &desc, D3D12_RESOURCE_STATE_GENERIC_READ, &uploadBuffer);
         IM_ASSERT(SUCCEEDED(hr));
 
         // Create temporary command list and execute immediately
@@ -539,7 +811,7 @@ void ImGui_ImplDX12_UpdateTexture(ImTextureData* tex)
         cmdAlloc->Release();
         ::CloseHandle(event);
         fence->Release();
-        uploadBuffer->Release();
+        ImGui_ImplDX12_ReleaseResource(uploadBuffer);
         tex->SetStatus(ImTextureStatus_OK);
     }
 
@@ -564,7 +836,7 @@ bool    ImGui_ImplDX12_CreateDeviceObjects()
         descRange.RegisterSpace = 0;
         descRange.OffsetInDescriptorsFromTableStart = 0;
 
-        D3D12_ROOT_PARAMETER param[2] = {};
+        D3D12_ROOT_PARAMETER param[3] = {};
 
         param[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
         param[0].Constants.ShaderRegister = 0;
@@ -577,6 +849,12 @@ bool    ImGui_ImplDX12_CreateDeviceObjects()
         param[1].DescriptorTable.pDescriptorRanges = &descRange;
         param[1].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
 
+        // Glyph rects for glyph instances (only bound when drawing them)
+        param[2].ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV;
+        param[2].Descriptor.ShaderRegister = 1;
+        param[2].Descriptor.RegisterSpace = 0;
+        param[2].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+
         // Bilinear sampling is required by default. Set 'io.Fonts->Flags |= ImFontAtlasFlags_NoBakedLines' or 'style.AntiAliasedLinesUseTex = false' to allow point/nearest sampling.
         D3D12_STATIC_SAMPLER_DESC staticSampler = {};
         staticSampler.Filter = D3D12_FILTER_MIN_MAG_MIP_LINEAR;
@@ -656,6 +934,7 @@ bool    ImGui_ImplDX12_CreateDeviceObjects()
     psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
 
     ID3DBlob* vertexShaderBlob;
+    ID3DBlob* vertexShaderGlyphsBlob;
     ID3DBlob* pixelShaderBlob;
 
     // Create the vertex shader
@@ -667,7 +946,7 @@ bool    ImGui_ImplDX12_CreateDeviceObjects()
             };\
             struct VS_INPUT\
             {\
-              float2 pos : POSITION;\
+              POS_TYPE pos : POSITION;\
               float4 col : COLOR0;\
               float2 uv  : TEXCOORD0;\
             };\
@@ -682,21 +961,32 @@ bool    ImGui_ImplDX12_CreateDeviceObjects()
             PS_INPUT main(VS_INPUT input)\
             {\
               PS_INPUT output;\
-              output.pos = mul( ProjectionMatrix, float4(input.pos.xy, 0.f, 1.f));\
+              output.pos = mul( ProjectionMatrix, float4(float2(input.pos.xy) * POS_SCALE, 0.f, 1.f));\
               output.col = input.col;\
               output.uv  = input.uv;\
               return output;\
             }";
 
-        if (FAILED(D3DCompile(vertexShader, strlen(vertexShader), nullptr, nullptr, nullptr, "main", "vs_5_0", 0, 0, &vertexShaderBlob, nullptr)))
+        // With IMGUI_USE_COMPACT_DRAWVERT positions are fixed point integers (see ImDrawVertPos16) and UVs are fetched as R16G16_UNORM.
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+        static const D3D_SHADER_MACRO vertexShaderDefines[] = { { "POS_TYPE", "int2" }, { "POS_SCALE", "(1.0f / (1 << " IMGUI_IMPL_DX12_STRINGIFY(IMGUI_DRAWVERT_POS_SUBPIXEL_BITS) "))" }, { nullptr, nullptr } };
+#else
+        static const D3D_SHADER_MACRO vertexShaderDefines[] = { { "POS_TYPE", "float2" }, { "POS_SCALE", "1.0f" }, { nullptr, nullptr } };
+#endif
+        if (FAILED(D3DCompile(vertexShader, strlen(vertexShader), nullptr, vertexShaderDefines, nullptr, "main", "vs_5_0", 0, 0, &vertexShaderBlob, nullptr)))
             return false; // NB: Pass ID3DBlob* pErrorBlob to D3DCompile() to get error showing in (const char*)pErrorBlob->GetBufferPointer(). Make sure to Release() the blob!
         psoDesc.VS = { vertexShaderBlob->GetBufferPointer(), vertexShaderBlob->GetBufferSize() };
 
         // Create the input layout
         static D3D12_INPUT_ELEMENT_DESC local_layout[] =
         {
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+            { "POSITION", 0, DXGI_FORMAT_R16G16_SINT,    0, (UINT)offsetof(ImDrawVert, pos), D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+            { "TEXCOORD", 0, DXGI_FORMAT_R16G16_UNORM,   0, (UINT)offsetof(ImDrawVert, uv),  D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+#else
             { "POSITION", 0, DXGI_FORMAT_R32G32_FLOAT,   0, (UINT)offsetof(ImDrawVert, pos), D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
             { "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT,   0, (UINT)offsetof(ImDrawVert, uv),  D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+#endif
             { "COLOR",    0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, (UINT)offsetof(ImDrawVert, col), D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
         };
         psoDesc.InputLayout = { local_layout, 3 };
@@ -771,6 +1061,113 @@ bool    ImGui_ImplDX12_CreateDeviceObjects()
     }
 
     HRESULT result_pipeline_state = bd->pd3dDevice->CreateGraphicsPipelineState(&psoDesc, IID_PPV_ARGS(&bd->pPipelineState));
+    if (result_pipeline_state != S_OK)
+    {
+        vertexShaderBlob->Release();
+        pixelShaderBlob->Release();
+        return false;
+    }
+
+    // Create the pipeline state for glyph instances (ImGuiBackendFlags_RendererHasGlyphInstances), with the same pixel shader
+    // Each instance is drawn as 6 vertices forming the same two triangles as ImDrawList::PrimRectUV(): corners 0,1,2 and 0,2,3.
+    // Corners are selected rather than interpolated so positions and UVs exactly match the quads ImFont::RenderText() would output.
+    D3D12_GRAPHICS_PIPELINE_STATE_DESC psoDescGlyphs = psoDesc;
+    {
+        static const char* vertexShaderGlyphs =
+            "cbuffer vertexBuffer : register(b0) \
+            {\
+              float4x4 ProjectionMatrix; \
+            };\
+            struct GlyphRect\
+            {\
+              float4 pos;\
+              float4 uv;\
+            };\
+            StructuredBuffer<GlyphRect> GlyphRects : register(t1);\
+            struct VS_INPUT\
+            {\
+              float2 pos : POSITION;\
+              uint glyph : GLYPH;\
+              float4 col : COLOR0;\
+              uint vid : SV_VertexID;\
+            };\
+            \
+            struct PS_INPUT\
+            {\
+              float4 pos : SV_POSITION;\
+              float4 col : COLOR0;\
+              float2 uv  : TEXCOORD0;\
+            };\
+            \
+            PS_INPUT main(VS_INPUT input)\
+            {\
+              PS_INPUT output;\
+              uint corner = input.vid < 3 ? input.vid : (input.vid == 3 ? 0 : input.vid - 2);\
+              bool right = (corner == 1 || corner == 2);\
+              bool bottom = (corner >= 2);\
+              GlyphRect r = GlyphRects[input.glyph];\
+              float2 pos = input.pos + float2(right ? r.pos.z : r.pos.x, bottom ? r.pos.w : r.pos.y);\
+              output.pos = mul( ProjectionMatrix, float4(pos, 0.f, 1.f));\
+              output.col = input.col;\
+              output.uv  = float2(right ? r.uv.z : r.uv.x, bottom ? r.uv.w : r.uv.y);\
+              return output;\
+            }";
+
+        if (FAILED(D3DCompile(vertexShaderGlyphs, strlen(vertexShaderGlyphs), nullptr, nullptr, nullptr, "main", "vs_5_0", 0, 0, &vertexShaderGlyphsBlob, nullptr)))
+        {
+            vertexShaderBlob->Release();
+            pixelShaderBlob->Release();
+            return false;
+        }
+        psoDescGlyphs.VS = { vertexShaderGlyphsBlob->GetBufferPointer(), vertexShaderGlyphsBlob->GetBufferSize() };
+
+        static D3D12_INPUT_ELEMENT_DESC glyph_layout[] =
+        {
+            { "POSITION", 0, DXGI_FORMAT_R32G32_FLOAT,   1, (UINT)offsetof(ImDrawGlyph, X),       D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 },
+            { "GLYPH",    0, DXGI_FORMAT_R32_UINT,       1, (UINT)offsetof(ImDrawGlyph, GlyphId), D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 },
+            { "COLOR",    0, DXGI_FORMAT_R8G8B8A8_UNORM, 1, (UINT)offsetof(ImDrawGlyph, Col),     D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 },
+        };
+        psoDescGlyphs.InputLayout = { glyph_layout, 3 };
+    }
+    result_pipeline_state = bd->pd3dDevice->CreateGraphicsPipelineState(&psoDescGlyphs, IID_PPV_ARGS(&bd->pPipelineStateGlyphs));
+    vertexShaderGlyphsBlob->Release();
+    pixelShaderBlob->Release();
+    if (result_pipeline_state != S_OK)
+    {
+        vertexShaderBlob->Release();
+        return false;
+    }
+
+    // Create the pixel shader for signed distance field textures (ImFontAtlasFlags_SDF)
+    // Alpha is 0.5 on glyph edges: threshold it with a ramp about one pixel wide, whatever the text scale.
+    {
+        static const char* pixelShaderSDF =
+            "struct PS_INPUT\
+            {\
+              float4 pos : SV_POSITION;\
+              float4 col : COLOR0;\
+              float2 uv  : TEXCOORD0;\
+            };\
+            SamplerState sampler0 : register(s0);\
+            Texture2D texture0 : register(t0);\
+            \
+            float4 main(PS_INPUT input) : SV_Target\
+            {\
+              float4 tex_col = texture0.Sample(sampler0, input.uv); \
+              float width = max(fwidth(tex_col.a) * 0.5f, 0.0001f); \
+              tex_col.a = smoothstep(0.5f - width, 0.5f + width, tex_col.a); \
+              float4 out_col = input.col * tex_col; \
+              return out_col; \
+            }";
+
+        if (FAILED(D3DCompile(pixelShaderSDF, strlen(pixelShaderSDF), nullptr, nullptr, nullptr, "main", "ps_5_0", 0, 0, &pixelShaderBlob, nullptr)))
+        {
+            vertexShaderBlob->Release();
+            return false;
+        }
+        psoDesc.PS = { pixelShaderBlob->GetBufferPointer(), pixelShaderBlob->GetBufferSize() };
+    }
+    result_pipeline_state = bd->pd3dDevice->CreateGraphicsPipelineState(&psoDesc, IID_PPV_ARGS(&bd->pPipelineStateSDF));
     vertexShaderBlob->Release();
     pixelShaderBlob->Release();
     if (result_pipeline_state != S_OK)
@@ -790,6 +1187,8 @@ void    ImGui_ImplDX12_InvalidateDeviceObjects()
     bd->commandQueueOwned = false;
     SafeRelease(bd->pRootSignature);
     SafeRelease(bd->pPipelineState);
+    SafeRelease(bd->pPipelineStateSDF);
+    SafeRelease(bd->pPipelineStateGlyphs);
 
     // Destroy all textures
     for (ImTextureData* tex : ImGui::GetPlatformIO().Textures)
@@ -799,8 +1198,11 @@ void    ImGui_ImplDX12_InvalidateDeviceObjects()
     for (UINT i = 0; i < bd->numFramesInFlight; i++)
     {
         ImGui_ImplDX12_RenderBuffers* fr = &bd->pFrameResources[i];
-        SafeRelease(fr->IndexBuffer);
-        SafeRelease(fr->VertexBuffer);
+        ImGui_ImplDX12_ReleaseResource(fr->IndexBuffer);
+        ImGui_ImplDX12_ReleaseResource(fr->VertexBuffer);
+        ImGui_ImplDX12_ReleaseResource(fr->GlyphBuffer);
+        ImGui_ImplDX12_ReleaseResource(fr->GlyphRectBuffer);
+        fr->GlyphRectTables.clear();
     }
 }
 
@@ -849,6 +1251,8 @@ bool ImGui_ImplDX12_Init(ImGui_ImplDX12_InitInfo* init_info)
     io.BackendRendererName = "imgui_impl_dx12";
     io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
     io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;   // We can honor ImGuiPlatformIO::Textures[] requests during render.
+    if (init_info->UseGlyphInstances)
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasGlyphInstances; // We can honor the ImDrawCmd::GlyphOffset/GlyphCount fields, expanding glyph instances on the GPU.
 
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
     if (init_info->SrvDescriptorAllocFn == nullptr)
@@ -864,8 +1268,12 @@ bool ImGui_ImplDX12_Init(ImGui_ImplDX12_InitInfo* init_info)
         ImGui_ImplDX12_RenderBuffers* fr = &bd->pFrameResources[i];
         fr->IndexBuffer = nullptr;
         fr->VertexBuffer = nullptr;
+        fr->GlyphBuffer = nullptr;
+        fr->GlyphRectBuffer = nullptr;
         fr->IndexBufferSize = 10000;
         fr->VertexBufferSize = 5000;
+        fr->GlyphBufferSize = 0;
+        fr->GlyphRectBufferSize = 0;
     }
 
     return true;
@@ -913,7 +1321,7 @@ void ImGui_ImplDX12_Shutdown()
 
     io.BackendRendererName = nullptr;
     io.BackendRendererUserData = nullptr;
-    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTextures);
+    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTextures | ImGuiBackendFlags_RendererHasGlyphInstances);
     IM_DELETE(bd);
 }
 
@@ -39,6 +39,21 @@ struct ImGui_ImplDX12_InitInfo
     ID3D12DescriptorHeap*       SrvDescriptorHeap;
     void                        (*SrvDescriptorAllocFn)(ImGui_ImplDX12_InitInfo* info, D3D12_CPU_DESCRIPTOR_HANDLE* out_cpu_desc_handle, D3D12_GPU_DESCRIPTOR_HANDLE* out_gpu_desc_handle);
     void                        (*SrvDescriptorFreeFn)(ImGui_ImplDX12_InitInfo* info, D3D12_CPU_DESCRIPTOR_HANDLE cpu_desc_handle, D3D12_GPU_DESCRIPTOR_HANDLE gpu_desc_handle);
+
+    // Optional: create/release the backend's buffers and textures yourself, e.g. to place them in your own heaps.
+    // ResourceCreateFn has the same contract as CreateCommittedResource(). When ResourceReleaseFn is set it is called instead of Release().
+    // Leave both NULL to use CreateCommittedResource().
+    HRESULT                     (*ResourceCreateFn)(ImGui_ImplDX12_InitInfo* info, const D3D12_HEAP_PROPERTIES* heap_props, const D3D12_RESOURCE_DESC* desc, D3D12_RESOURCE_STATES initial_state, ID3D12Resource** out_resource);
+    void                        (*ResourceReleaseFn)(ImGui_ImplDX12_InitInfo* info, ID3D12Resource* resource);
+
+    // Optional: run jobs on your job system. Used to copy vertex/index data into upload buffers in parallel for large frames.
+    // Must call job_fn(job_data, job_n) once for each job_n in [0, jobs_count), in any order and on any thread, and return when they are all done.
+    // Leave NULL to run jobs on the calling thread.
+    void                        (*ParallelForFn)(ImGui_ImplDX12_InitInfo* info, void (*job_fn)(void* job_data, int job_n), void* job_data, int jobs_count);
+
+    // Optional: [EXPERIMENTAL] let text be output as glyph instances expanded in the vertex shader (sets ImGuiBackendFlags_RendererHasGlyphInstances).
+    // Uploads less per glyph but may need more draw calls. Leave false to draw text as indexed quads like everything else.
+    bool                        UseGlyphInstances;
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
     D3D12_CPU_DESCRIPTOR_HANDLE LegacySingleSrvCpuDescriptor; // To facilitate transition from single descriptor to allocator callback, you may use those.
     D3D12_GPU_DESCRIPTOR_HANDLE LegacySingleSrvGpuDescriptor;
@@ -53,6 +68,10 @@ IMGUI_IMPL_API void     ImGui_ImplDX12_Shutdown();
 IMGUI_IMPL_API void     ImGui_ImplDX12_NewFrame();
 IMGUI_IMPL_API void     ImGui_ImplDX12_RenderDrawData(ImDrawData* draw_data, ID3D12GraphicsCommandList* graphics_command_list);
 
+// (Advanced) Same as ImGui_ImplDX12_RenderDrawData() but only touches pixels inside 'rects' (framebuffer space, same convention as RSSetScissorRects()).
+// Use for partial redraws where the rest of the back buffer still holds valid content, e.g. together with IDXGISwapChain1::Present1() dirty rects.
+IMGUI_IMPL_API void     ImGui_ImplDX12_RenderDrawDataInRects(ImDrawData* draw_data, ID3D12GraphicsCommandList* graphics_command_list, const D3D12_RECT* rects, int rects_count);
+
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
 // Legacy initialization API Obsoleted in 1.91.5
 // - font_srv_cpu_desc_handle and font_srv_gpu_desc_handle are handles to a single SRV descriptor to use for the internal font texture, they must be in 'srv_descriptor_heap'
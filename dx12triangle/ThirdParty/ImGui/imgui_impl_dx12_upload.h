@@ -0,0 +1,119 @@
+// dear imgui: Renderer Backend for DirectX12, upload helpers
+// Splitting large vertex/index uploads in jobs, and the non-temporal copy they run. Used by imgui_impl_dx12.cpp.
+// This doesn't depend on DirectX, so it can be tested and benchmarked on any platform.
+
+#pragma once
+#include "imgui.h"          // ImVector
+#include <stdint.h>         // uintptr_t
+#include <string.h>         // memcpy
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>      // _mm_stream_si128, _mm_sfence
+#define IMGUI_IMPL_DX12_HAS_STREAMING_STORES
+#endif
+
+// Bytes copied by each upload job.
+#ifndef IMGUI_IMPL_DX12_UPLOAD_JOB_SIZE
+#define IMGUI_IMPL_DX12_UPLOAD_JOB_SIZE         (512 * 1024)
+#endif
+
+// A piece of a vertex/index buffer to copy into an upload buffer
+struct ImGui_ImplDX12_UploadCopy
+{
+    void*                       Dst;
+    const void*                 Src;
+    size_t                      Size;
+};
+
+// Copies grouped in jobs of about IMGUI_IMPL_DX12_UPLOAD_JOB_SIZE bytes. Call Clear() before adding the copies of a frame, then Finish().
+// Jobs start on 64-byte lines of the destination, so no two jobs write into a same line, as long as copies into a same buffer
+// are added in order and one buffer after the other (e.g. all vertex buffers, then all index buffers), into buffers aligned on 64 bytes.
+struct ImGui_ImplDX12_UploadJobs
+{
+    ImVector<ImGui_ImplDX12_UploadCopy> Copies;
+    ImVector<int>               JobStarts;              // Index of the first copy of each job, plus one past the last copy after Finish()
+    size_t                      JobSize;                // Bytes in the last job
+
+    ImGui_ImplDX12_UploadJobs() { JobSize = 0; }
+    void                        Clear()                 { Copies.resize(0); JobStarts.resize(0); JobStarts.push_back(0); JobSize = 0; }
+    void                        AddCopy(void* dst, const void* src, size_t size);
+    int                         Finish()                { if (JobSize > 0) JobStarts.push_back(Copies.Size); JobSize = 0; return JobStarts.Size - 1; } // Return number of jobs
+    void                        RunJob(int job_n) const;
+};
+
+// Copy with non-temporal stores, for upload buffers which are write-combined memory.
+// Only 64-byte lines fully covered by the copy are streamed. Partial lines at both ends may be shared with the previous or next copy,
+// they are written with regular stores, as mixing both kinds of stores on a same line is very slow on cached memory.
+static inline void ImGui_ImplDX12_StreamCopy(void* dst, const void* src, size_t size)
+{
+#ifdef IMGUI_IMPL_DX12_HAS_STREAMING_STORES
+    unsigned char* d = (unsigned char*)dst;
+    const unsigned char* s = (const unsigned char*)src;
+    size_t head = (size_t)(-(intptr_t)d) & 63;
+    if (head > size)
+        head = size;
+    memcpy(d, s, head);
+    d += head;
+    s += head;
+    size -= head;
+    for (; size >= 64; d += 64, s += 64, size -= 64)
+    {
+        __m128i v0 = _mm_loadu_si128((const __m128i*)(s + 0));
+        __m128i v1 = _mm_loadu_si128((const __m128i*)(s + 16));
+        __m128i v2 = _mm_loadu_si128((const __m128i*)(s + 32));
+        __m128i v3 = _mm_loadu_si128((const __m128i*)(s + 48));
+        _mm_stream_si128((__m128i*)(d + 0), v0);
+        _mm_stream_si128((__m128i*)(d + 16), v1);
+        _mm_stream_si128((__m128i*)(d + 32), v2);
+        _mm_stream_si128((__m128i*)(d + 48), v3);
+    }
+    memcpy(d, s, size);
+#else
+    memcpy(dst, src, size);
+#endif
+}
+
+// Append a copy, starting a new job once IMGUI_IMPL_DX12_UPLOAD_JOB_SIZE bytes are reached.
+// The split is moved back to the last line boundary within budget. When there is none, the end of the partial line being written
+// stays in the current job (which may then exceed the budget by up to 63 bytes) and the next job starts on the following line.
+inline void ImGui_ImplDX12_UploadJobs::AddCopy(void* dst, const void* src, size_t size)
+{
+    unsigned char* d = (unsigned char*)dst;
+    const unsigned char* s = (const unsigned char*)src;
+    while (size > 0)
+    {
+        size_t piece = size;
+        if (JobSize + piece > IMGUI_IMPL_DX12_UPLOAD_JOB_SIZE)
+        {
+            const size_t budget = (JobSize < IMGUI_IMPL_DX12_UPLOAD_JOB_SIZE) ? IMGUI_IMPL_DX12_UPLOAD_JOB_SIZE - JobSize : 0;
+            uintptr_t split = ((uintptr_t)d + budget) & ~(uintptr_t)63;
+            if (split <= (uintptr_t)d)
+                split = ((uintptr_t)d + 63) & ~(uintptr_t)63;
+            if ((size_t)(split - (uintptr_t)d) < piece)
+                piece = (size_t)(split - (uintptr_t)d);
+        }
+        if (piece > 0)
+        {
+            ImGui_ImplDX12_UploadCopy copy = { d, s, piece };
+            Copies.push_back(copy);
+            d += piece;
+            s += piece;
+            size -= piece;
+            JobSize += piece;
+        }
+        if (size > 0)
+        {
+            JobStarts.push_back(Copies.Size);
+            JobSize = 0;
+        }
+    }
+}
+
+// May run on any thread, one job per thread at a time.
+inline void ImGui_ImplDX12_UploadJobs::RunJob(int job_n) const
+{
+    for (int n = JobStarts[job_n]; n < JobStarts[job_n + 1]; n++)
+        ImGui_ImplDX12_StreamCopy(Copies[n].Dst, Copies[n].Src, Copies[n].Size);
+#ifdef IMGUI_IMPL_DX12_HAS_STREAMING_STORES
+    _mm_sfence(); // Non-temporal stores are weakly ordered: complete them before the job is reported as done
+#endif
+}
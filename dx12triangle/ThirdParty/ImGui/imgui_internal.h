@@ -67,11 +67,29 @@ Index of this file:
 #define IMGUI_ENABLE_SSE4_2
 #include <nmmintrin.h>
 #endif
+#if defined __AVX2__ && !defined(IMGUI_DISABLE_AVX2)
+#ifndef IMGUI_ENABLE_AVX2
+#define IMGUI_ENABLE_AVX2
+#endif
+#endif
+#endif
+// Enable NEON intrinsics if available
+#if (defined __ARM_NEON || defined __ARM_NEON__ || defined _M_ARM64) && !defined(IMGUI_DISABLE_NEON)
+#define IMGUI_ENABLE_NEON
+#include <arm_neon.h>
 #endif
 // Emscripten has partial SSE 4.2 support where _mm_crc32_u32 is not available. See https://emscripten.org/docs/porting/simd.html#id11 and #8213
 #if defined(IMGUI_ENABLE_SSE4_2) && !defined(IMGUI_USE_LEGACY_CRC32_ADLER) && !defined(__EMSCRIPTEN__)
 #define IMGUI_ENABLE_SSE4_2_CRC
 #endif
+// Enable ARMv8 CRC32 instructions if available (same CRC32c values as SSE 4.2 and the byte-wise table, define IMGUI_DISABLE_ARM_CRC32 to use the table)
+#if defined(__ARM_FEATURE_CRC32) && !defined(IMGUI_USE_LEGACY_CRC32_ADLER) && !defined(IMGUI_DISABLE_ARM_CRC32)
+#define IMGUI_ENABLE_ARM_CRC32
+#include <arm_acle.h>
+#endif
+#if defined(IMGUI_USE_FAST_HASH) && defined(IMGUI_USE_LEGACY_CRC32_ADLER)
+#error "IMGUI_USE_FAST_HASH and IMGUI_USE_LEGACY_CRC32_ADLER are mutually exclusive."
+#endif
 
 // Visual Studio warnings
 #ifdef _MSC_VER
@@ -137,13 +155,16 @@ Index of this file:
 struct ImBitVector;                 // Store 1-bit per value
 struct ImRect;                      // An axis-aligned rectangle (2 points)
 struct ImGuiTextIndex;              // Maintain a line index for a text buffer.
+struct ImGuiTextWrapIndex;          // Maintain a wrapped line index for a text buffer.
 
 // ImDrawList/ImFontAtlas
 struct ImDrawDataBuilder;           // Helper to build a ImDrawData instance
 struct ImDrawListSharedData;        // Data shared between all ImDrawList instances
+struct ImFontAtlasAsyncBaker;       // Worker threads rasterizing glyphs for ImFontAtlasFlags_AsyncGlyphBaking
 struct ImFontAtlasBuilder;          // Internal storage for incrementally packing and building a ImFontAtlas
 struct ImFontAtlasPostProcessData;  // Data available to potential texture post-processing functions
 struct ImFontAtlasRectEntry;        // Packed rectangle lookup entry
+struct ImFontAtlasUserImage;        // Image registered with ImFontAtlas::AddUserImage()
 
 // ImGui
 struct ImGuiBoxSelectState;         // Box-selection state (currently used by multi-selection, could potentially be used by others)
@@ -180,6 +201,7 @@ struct ImGuiTableInstanceData;      // Storage for one instance of a same table
 struct ImGuiTableTempData;          // Temporary storage for one table (one per table in the stack), shared between tables.
 struct ImGuiTableSettings;          // Storage for a table .ini settings
 struct ImGuiTableColumnsSettings;   // Storage for a column .ini settings
+struct ImGuiTextSizeCache;          // Cache for CalcTextSize() results
 struct ImGuiTreeNodeStackData;      // Temporary storage for TreeNode().
 struct ImGuiTypingSelectState;      // Storage for GetTypingSelectRequest()
 struct ImGuiTypingSelectRequest;    // Storage for GetTypingSelectRequest() (aimed to be public)
@@ -801,7 +823,33 @@ struct ImGuiTextIndex
     void            append(const char* base, int old_size, int new_size);
 };
 
+// Helper: ImGuiTextWrapIndex
+// Extends ImGuiTextIndex with the start offset of each wrapped (visual) line, for a given font, font size and wrap width.
+// - Call append() as text is appended, same as ImGuiTextIndex, then update() before using the wrapped lines. update() only wraps
+//   lines added since the previous call, plus the last line which may still be growing. Use with ImGuiListClipper, see TextWrappedWithIndex().
+// - Changing font, font size or wrap width wraps everything again. Call clear_wrap() after changing glyph advances of the font in use.
+struct ImGuiTextWrapIndex : ImGuiTextIndex
+{
+    ImVector<int>   WrapOffsets;                            // Start offset of each wrapped line
+    ImFont*         WrapFont = NULL;
+    float           WrapFontSize = 0.0f;
+    float           WrapWidth = 0.0f;
+    int             WrapLinesDone = 0;                      // Number of LineOffsets[] lines whose wrapped lines are final
+    int             WrapOffsetsDone = 0;                    // Number of WrapOffsets[] entries for those lines
+
+    void            clear()                                 { ImGuiTextIndex::clear(); clear_wrap(); }
+    void            clear_wrap()                            { WrapOffsets.clear(); WrapLinesDone = WrapOffsetsDone = 0; }
+    int             wrapped_size()                          { return WrapOffsets.Size; }
+    const char*     get_wrapped_line_begin(const char* base, int n) { return base + WrapOffsets[n]; }
+    const char*     get_wrapped_line_end(const char* base, int n);
+    void            update(const char* base, ImFont* font, float font_size, float wrap_width);
+};
+
 // Helper: ImGuiStorage
+// Size at which windows' StateStorage (tree nodes open state, GetStateStorage() data) switches from sorted insertion to a hash index. 0 to disable.
+#ifndef IMGUI_WINDOW_STORAGE_HASH_THRESHOLD
+#define IMGUI_WINDOW_STORAGE_HASH_THRESHOLD     64
+#endif
 IMGUI_API ImGuiStoragePair* ImLowerBound(ImGuiStoragePair* in_begin, ImGuiStoragePair* in_end, ImGuiID key);
 
 //-----------------------------------------------------------------------------
@@ -833,6 +881,16 @@ IMGUI_API ImGuiStoragePair* ImLowerBound(ImGuiStoragePair* in_begin, ImGuiStorag
 #endif
 #define IM_DRAWLIST_ARCFAST_SAMPLE_MAX                          IM_DRAWLIST_ARCFAST_TABLE_SIZE // Sample index _PathArcToFastEx() for 360 angle.
 
+// ImDrawList: Max number of glyph quads ImFont::RenderText() batches before writing their indices from ImDrawListSharedData::TextQuadIdx[].
+#ifndef IM_DRAWLIST_TEXT_RUN_MAX
+#define IM_DRAWLIST_TEXT_RUN_MAX                                64
+#endif
+
+// ImDrawList: Max number of text runs tracked for overlap tests when outputting glyph instances (ImDrawListFlags_GlyphInstances), they are collapsed into one past that.
+#ifndef IM_DRAWLIST_GLYPH_RUNS_MAX
+#define IM_DRAWLIST_GLYPH_RUNS_MAX                              32
+#endif
+
 // Data shared between all ImDrawList instances
 // Conceptually this could have been called e.g. ImDrawListSharedContext
 // Typically one ImGui context would create and maintain one of this.
@@ -853,11 +911,13 @@ struct IMGUI_API ImDrawListSharedData
     ImVector<ImVec2> TempBuffer;                // Temporary write buffer
     ImVector<ImDrawList*> DrawLists;            // All draw lists associated to this ImDrawListSharedData
     ImGuiContext*   Context;                    // [OPTIONAL] Link to Dear ImGui context. 99% of ImDrawList/ImFontAtlas can function without an ImGui context, but this facilitate handling one legacy edge case.
+    ImU64           SplitterIdxBytes;           // Stats: bytes of indices copied or filled by ImDrawListSplitter on draw lists using this data. Never reset.
 
     // Lookup tables
     ImVec2          ArcFastVtx[IM_DRAWLIST_ARCFAST_TABLE_SIZE]; // Sample points on the quarter of the circle.
     float           ArcFastRadiusCutoff;                        // Cutoff radius after which arc drawing will fallback to slower PathArcTo()
     ImU8            CircleSegmentCounts[64];    // Precomputed segment count for given radius before we calculate it dynamically (to avoid calculation overhead)
+    ImDrawIdx       TextQuadIdx[IM_DRAWLIST_TEXT_RUN_MAX * 6];  // Index pattern 0,1,2,0,2,3,4,5,6,4,6,7... for a run of glyph quads, offset by the run's first vertex index.
 
     ImDrawListSharedData();
     ~ImDrawListSharedData();
@@ -879,6 +939,56 @@ struct ImFontStackData
     float       FontSizeAfterScaling;       // ~~ g.FontSize
 };
 
+// Cache of CalcTextSize() results, so labels submitted every frame are not measured again every frame. Disabled by default: set g.TextSizeCache.Enabled or use the Metrics window.
+// - Open addressing: linear probing over a power-of-two table, at most IM_TEXTSIZECACHE_PROBE_MAX slots. Slots are never emptied one by one so an empty slot ends a probe.
+// - Keyed by (ImFontBaked::BakedId, font size, wrap width, text). A copy of each key's text is kept in TextBuf and compared on a hash match, so colliding strings never share a size.
+// - Eviction: when a probe window is full its least recently used entry is replaced. When that entry was used this frame and the table is half full, the table is doubled instead (up to IM_TEXTSIZECACHE_SIZE_MAX).
+// - Text of evicted entries stays in TextBuf until it holds more than twice the text of live entries (and at least IM_TEXTSIZECACHE_TEXTBUF_MIN bytes), then TextBuf is compacted.
+// - Invalidate() bumps Generation, which empties every slot at once. The atlas calls it whenever baked font data is discarded (rebuild, font source change, garbage collection).
+#define IM_TEXTSIZECACHE_PROBE_MAX      8
+#define IM_TEXTSIZECACHE_SIZE_MIN       512
+#define IM_TEXTSIZECACHE_SIZE_MAX       16384
+#define IM_TEXTSIZECACHE_TEXTBUF_MIN    (64 * 1024)
+
+struct ImGuiTextSizeCacheEntry
+{
+    ImU64       Hash;                       // HashKey()
+    ImGuiID     BakedId;
+    int         TextLen;
+    int         TextOffset;                 // Copy of the text in ImGuiTextSizeCache::TextBuf
+    float       FontSize;
+    float       WrapWidth;
+    ImU32       Generation;                 // Slot is empty when != ImGuiTextSizeCache::Generation
+    int         LastUsedFrame;
+    ImVec2      Size;
+};
+
+struct IMGUI_API ImGuiTextSizeCache
+{
+    ImVector<ImGuiTextSizeCacheEntry> Entries;
+    ImVector<char> TextBuf;                 // Text of the entries, compared on a hash match
+    ImU32       Generation;
+    int         Count;                      // Used entries
+    int         LiveTextBytes;              // Text of used entries, the rest of TextBuf is garbage
+    bool        Enabled;
+
+    // Stats for the Metrics window
+    int         HitsThisFrame, MissesThisFrame;
+    int         HitsLastFrame, MissesLastFrame;
+    int         InvalidateCount;
+
+    ImGuiTextSizeCache()                    { Generation = 1; Count = LiveTextBytes = 0; Enabled = false; HitsThisFrame = MissesThisFrame = HitsLastFrame = MissesLastFrame = InvalidateCount = 0; }
+    void        Invalidate()                { Generation++; Count = LiveTextBytes = 0; TextBuf.resize(0); InvalidateCount++; }
+    void        NewFrame()                  { HitsLastFrame = HitsThisFrame; MissesLastFrame = MissesThisFrame; HitsThisFrame = MissesThisFrame = 0; }
+    void        Clear()                     { Entries.clear(); TextBuf.clear(); Invalidate(); }
+    static ImU64 HashKey(const char* text, const ImGuiTextSizeCacheEntry& key);     // Hash of text seeded with the other key fields
+    const ImVec2* Find(const ImGuiTextSizeCacheEntry& key, const char* text, int frame_count);  // Return NULL on miss
+    void        Add(const ImGuiTextSizeCacheEntry& entry, const char* text, int frame_count);
+    ImGuiTextSizeCacheEntry* FindSlot(ImU64 hash);
+    void        Resize(int new_size);
+    void        CompactTextBuf();
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] Style support
 //-----------------------------------------------------------------------------
@@ -1262,6 +1372,7 @@ enum ImGuiWindowRefreshFlags_
     ImGuiWindowRefreshFlags_TryToAvoidRefresh   = 1 << 0,   // [EXPERIMENTAL] Try to keep existing contents, USER MUST NOT HONOR BEGIN() RETURNING FALSE AND NOT APPEND.
     ImGuiWindowRefreshFlags_RefreshOnHover      = 1 << 1,   // [EXPERIMENTAL] Always refresh on hover
     ImGuiWindowRefreshFlags_RefreshOnFocus      = 1 << 2,   // [EXPERIMENTAL] Always refresh on focus
+    ImGuiWindowRefreshFlags_RefreshOnInputsChange = 1 << 3, // [EXPERIMENTAL] Refresh when the window geometry, style, font, focus/hover state or user content hash changed, on input events while hovered/focused, and while an item is active.
     // Refresh policy/frequency, Load Balancing etc.
 };
 
@@ -1304,6 +1415,7 @@ struct ImGuiNextWindowData
     float                       BgAlphaVal;             // Override background alpha
     ImVec2                      MenuBarOffsetMinVal;    // (Always on) This is not exposed publicly, so we don't clear it and it doesn't have a corresponding flag (could we? for consistency?)
     ImGuiWindowRefreshFlags     RefreshFlagsVal;
+    ImGuiID                     RefreshContentHashVal;
 
     ImGuiNextWindowData()       { memset(this, 0, sizeof(*this)); }
     inline void ClearFlags()    { HasFlags = ImGuiNextWindowDataFlags_None; }
@@ -1637,12 +1749,20 @@ struct ImGuiListClipperData
     float                           LossynessOffset;
     int                             StepNo;
     int                             ItemsFrozen;
+    int                             MeasureItemIndex;       // Variable height: item displayed by the previous step, measured by the next one (-1 if none)
+    float                           MeasureItemPosY;        // Variable height: cursor position when that item started
     ImVector<ImGuiListClipperRange> Ranges;
 
     ImGuiListClipperData()          { memset(this, 0, sizeof(*this)); }
-    void                            Reset(ImGuiListClipper* clipper) { ListClipper = clipper; StepNo = ItemsFrozen = 0; Ranges.resize(0); }
+    void                            Reset(ImGuiListClipper* clipper) { ListClipper = clipper; StepNo = ItemsFrozen = 0; MeasureItemIndex = -1; Ranges.resize(0); }
 };
 
+// Number of items summed together in each ImGuiListClipperHeights::BlockTree node: keeps the tree small (8 bytes per block)
+// while finding an item inside a block is a short linear scan.
+#ifndef IMGUI_LISTCLIPPER_HEIGHTS_BLOCK_SIZE
+#define IMGUI_LISTCLIPPER_HEIGHTS_BLOCK_SIZE    64
+#endif
+
 //-----------------------------------------------------------------------------
 // [SECTION] Navigation support
 //-----------------------------------------------------------------------------
@@ -2070,6 +2190,7 @@ struct ImGuiDebugAllocInfo
     int         TotalFreeCount;
     ImS16       LastEntriesIdx;             // Current index in buffer
     ImGuiDebugAllocEntry LastEntriesBuf[6]; // Track last 6 frames that had allocations
+    int         PausedCount;                // Allocations are not tracked while > 0, e.g. while ImDrawListWorkers record from other threads.
 
     ImGuiDebugAllocInfo() { memset(this, 0, sizeof(*this)); }
 };
@@ -2156,6 +2277,7 @@ struct ImGuiContext
     float                   FontRasterizerDensity;              // Current font density. Used by all calls to GetFontBaked().
     float                   CurrentDpiScale;                    // Current window/viewport DpiScale == CurrentViewport->DpiScale
     ImDrawListSharedData    DrawListSharedData;
+    ImGuiTextSizeCache      TextSizeCache;                      // Cache for CalcTextSize()
     double                  Time;
     int                     FrameCount;
     int                     FrameCountEnded;
@@ -2182,6 +2304,8 @@ struct ImGuiContext
     ImGuiStorage            WindowsById;                        // Map window's ImGuiID to ImGuiWindow*
     int                     WindowsActiveCount;                 // Number of unique windows submitted by frame
     float                   WindowsBorderHoverPadding;          // Padding around resizable windows for which hovering on counts as hovering the window == ImMax(style.TouchExtraPadding, style.WindowBorderHoverPadding). This isn't so multi-dpi friendly.
+    ImGuiID                 WindowsRefreshStyleHash;            // [EXPERIMENTAL] Hash of g.Style for ImGuiWindowRefreshFlags_RefreshOnInputsChange, computed once per frame when no style is pushed.
+    int                     WindowsRefreshStyleHashFrame;
     ImGuiID                 DebugBreakInWindow;                 // Set to break in Begin() call.
     ImGuiWindow*            CurrentWindow;                      // Window being drawn into
     ImGuiWindow*            HoveredWindow;                      // Window the mouse is hovering. Will typically catch mouse inputs.
@@ -2687,6 +2811,12 @@ struct IMGUI_API ImGuiWindow
     ImVec2                  NavPreferredScoringPosRel[ImGuiNavLayer_COUNT]; // Preferred X/Y position updated when moving on a given axis, reset to FLT_MAX.
     ImGuiID                 NavRootFocusScopeId;                // Focus Scope ID at the time of Begin()
 
+    ImGuiID                 SkipRefreshInputsHash;              // [EXPERIMENTAL] Inputs hash at the last Begin() using ImGuiWindowRefreshFlags_RefreshOnInputsChange
+    bool                    SkipRefreshDirty;                   // [EXPERIMENTAL] Set by MarkWindowRefreshDirty(), force a refresh on the next Begin()
+    ImS8                    SkipRefreshSettleFrames;            // [EXPERIMENTAL] Keep refreshing for N frames after a refresh, to let layout settle
+    int                     SkipRefreshHits;                    // [EXPERIMENTAL] Number of Begin() with a refresh policy which reused the previous frame contents
+    int                     SkipRefreshMisses;                  // [EXPERIMENTAL] Number of Begin() with a refresh policy which refreshed contents
+
     int                     MemoryDrawListIdxCapacity;          // Backup of last idx/vtx count, so when waking up the window we can preallocate and avoid iterative alloc/copy
     int                     MemoryDrawListVtxCapacity;
     bool                    MemoryCompacted;                    // Set when window extraneous data have been garbage collected
@@ -2959,6 +3089,7 @@ struct IMGUI_API ImGuiTable
     ImGuiWindow*                InnerWindow;                // Window holding the table data (== OuterWindow or a child window)
     ImGuiTextBuffer             ColumnsNames;               // Contiguous buffer holding columns names
     ImDrawListSplitter*         DrawSplitter;               // Shortcut to TempData->DrawSplitter while in table. Isolate draw commands per columns to avoid switching clip rect constantly
+    ImVector<int>               DrawSplitterIdxLayout;      // Channels layout recorded by our last merge, lent to DrawSplitter (which is shared by tables of a same nesting level) so it can write channels in place
     ImGuiTableInstanceData      InstanceDataFirst;
     ImVector<ImGuiTableInstanceData>    InstanceDataExtra;  // FIXME-OPT: Using a small-vector pattern would be good.
     ImGuiTableColumnSortSpecs   SortSpecsSingle;
@@ -3129,7 +3260,9 @@ namespace ImGui
     IMGUI_API ImGuiWindow*  FindBottomMostVisibleWindowWithinBeginStack(ImGuiWindow* window);
 
     // Windows: Idle, Refresh Policies [EXPERIMENTAL]
-    IMGUI_API void          SetNextWindowRefreshPolicy(ImGuiWindowRefreshFlags flags);
+    IMGUI_API void          SetNextWindowRefreshPolicy(ImGuiWindowRefreshFlags flags, ImGuiID content_hash = 0); // content_hash: hash of your own data displayed by the window, used by ImGuiWindowRefreshFlags_RefreshOnInputsChange
+    IMGUI_API void          MarkWindowRefreshDirty(ImGuiWindow* window);    // Force next Begin() to refresh contents
+    IMGUI_API void          MarkWindowRefreshDirty(const char* name);
 
     // Fonts, drawing
     IMGUI_API void          RegisterUserTexture(ImTextureData* tex); // Register external texture. EXPERIMENTAL: DO NOT USE YET.
@@ -3544,6 +3677,7 @@ namespace ImGui
 
     // Widgets: Text
     IMGUI_API void          TextEx(const char* text, const char* text_end = NULL, ImGuiTextFlags flags = 0);
+    IMGUI_API void          TextWrappedWithIndex(ImGuiTextWrapIndex* index, const char* text);            // Large wrapped text: only visible lines are measured and rendered. 'index' is kept by the caller and appended to along with 'text'.
     IMGUI_API void          TextAligned(float align_x, float size_x, const char* fmt, ...);               // FIXME-WIP: Works but API is likely to be reworked. This is designed for 1 item on the line. (#7024)
     IMGUI_API void          TextAlignedV(float align_x, float size_x, const char* fmt, va_list args);
 
@@ -3622,6 +3756,7 @@ namespace ImGui
     IMGUI_API void          ShadeVertsLinearColorGradientKeepAlpha(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, ImVec2 gradient_p0, ImVec2 gradient_p1, ImU32 col0, ImU32 col1);
     IMGUI_API void          ShadeVertsLinearUV(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, const ImVec2& a, const ImVec2& b, const ImVec2& uv_a, const ImVec2& uv_b, bool clamp);
     IMGUI_API void          ShadeVertsTransformPos(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, const ImVec2& pivot_in, float cos_a, float sin_a, const ImVec2& pivot_out);
+    IMGUI_API void          ExpandGlyphInstances(const ImDrawList* draw_list, const ImDrawCmd* draw_cmd, ImDrawVert* out_vtx);  // Write 4 vertices per glyph instance of 'draw_cmd' (reference for renderers, see ImGuiBackendFlags_RendererHasGlyphInstances)
 
     // Garbage collection
     IMGUI_API void          GcCompactTransientMiscBuffers();
@@ -3791,6 +3926,7 @@ struct ImFontAtlasBuilder
     ImVector<ImTextureRect>     Rects;
     ImVector<ImFontAtlasRectEntry> RectsIndex;          // ImFontAtlasRectId -> index into Rects[]
     ImVector<unsigned char>     TempBuffer;             // Misc scratch buffer
+    ImVector<float>             TempBufferSDF;          // Scratch buffer for ImFontAtlasBuildConvertCoverageToSDF()
     int                         RectsIndexFreeListStart;// First unused entry
     int                         RectsPackedCount;       // Number of packed rectangles.
     int                         RectsPackedSurface;     // Number of packed pixels. Used when compacting to heuristically find the ideal texture size.
@@ -3811,15 +3947,32 @@ struct ImFontAtlasBuilder
     ImFontAtlasRectId           PackIdMouseCursors;     // White pixel + mouse cursors. Also happen to be fallback in case of packing failure.
     ImFontAtlasRectId           PackIdLinesTexData;
 
+    // Glyphs being rasterized on worker threads (ImFontAtlasFlags_AsyncGlyphBaking), created on first use
+    ImFontAtlasAsyncBaker*      AsyncBaker;
+
     ImFontAtlasBuilder()        { memset(this, 0, sizeof(*this)); FrameCount = -1; RectsIndexFreeListStart = -1; PackIdMouseCursors = PackIdLinesTexData = -1; }
 };
 
+// Image registered with ImFontAtlas::AddUserImage(), packed into the atlas texture while in use
+struct ImFontAtlasUserImage
+{
+    ImTextureID                 TexID;                  // User texture this image is a copy of
+    int                         Width;
+    int                         Height;
+    ImVector<unsigned char>     Pixels;                 // RGBA32, Width*Height*4 bytes
+    ImFontAtlasRectId           PackId;                 // Packed rectangle (image + 1 pixel border on each side), ImFontAtlasRectId_Invalid when not in texture
+    int                         LastUsedFrame;          // Record of atlas->Builder->FrameCount
+
+    ImFontAtlasUserImage()      { TexID = ImTextureID_Invalid; Width = Height = 0; PackId = ImFontAtlasRectId_Invalid; LastUsedFrame = 0; }
+};
+
 IMGUI_API void              ImFontAtlasBuildInit(ImFontAtlas* atlas);
 IMGUI_API void              ImFontAtlasBuildDestroy(ImFontAtlas* atlas);
 IMGUI_API void              ImFontAtlasBuildMain(ImFontAtlas* atlas);
 IMGUI_API void              ImFontAtlasBuildSetupFontLoader(ImFontAtlas* atlas, const ImFontLoader* font_loader);
 IMGUI_API void              ImFontAtlasBuildUpdatePointers(ImFontAtlas* atlas);
 IMGUI_API void              ImFontAtlasBuildRenderBitmapFromString(ImFontAtlas* atlas, int x, int y, int w, int h, const char* in_str, char in_marker_char);
+IMGUI_API void              ImFontAtlasBuildConvertCoverageToSDF(ImFontAtlas* atlas, unsigned char* pixels, int w, int h, int spread);
 IMGUI_API void              ImFontAtlasBuildClear(ImFontAtlas* atlas); // Clear output and custom rects
 
 IMGUI_API ImTextureData*    ImFontAtlasTextureAdd(ImFontAtlas* atlas, int w, int h);
@@ -3828,11 +3981,14 @@ IMGUI_API void              ImFontAtlasTextureRepack(ImFontAtlas* atlas, int w,
 IMGUI_API void              ImFontAtlasTextureGrow(ImFontAtlas* atlas, int old_w = -1, int old_h = -1);
 IMGUI_API void              ImFontAtlasTextureCompact(ImFontAtlas* atlas);
 IMGUI_API ImVec2i           ImFontAtlasTextureGetSizeEstimate(ImFontAtlas* atlas);
+IMGUI_API void              ImFontAtlasTextureUpdateGlyphRect(ImFontAtlas* atlas, const ImFontGlyph* glyph); // Update ImTextureData::GlyphRects[] entry of a packed glyph
 
 IMGUI_API void              ImFontAtlasBuildSetupFontSpecialGlyphs(ImFontAtlas* atlas, ImFont* font, ImFontConfig* src);
 IMGUI_API void              ImFontAtlasBuildLegacyPreloadAllGlyphRanges(ImFontAtlas* atlas); // Legacy
 IMGUI_API void              ImFontAtlasBuildGetOversampleFactors(ImFontConfig* src, ImFontBaked* baked, int* out_oversample_h, int* out_oversample_v);
 IMGUI_API void              ImFontAtlasBuildDiscardBakes(ImFontAtlas* atlas, int unused_frames);
+IMGUI_API void              ImFontAtlasBuildDiscardUserImages(ImFontAtlas* atlas, int unused_frames);
+IMGUI_API bool              ImFontAtlasUserImageRemap(ImFontAtlas* atlas, ImTextureRef* tex_ref, ImVec2* uvs, int uvs_count);
 
 IMGUI_API bool              ImFontAtlasFontSourceInit(ImFontAtlas* atlas, ImFontConfig* src);
 IMGUI_API void              ImFontAtlasFontSourceAddToFont(ImFontAtlas* atlas, ImFont* font, ImFontConfig* src);
@@ -3851,6 +4007,12 @@ IMGUI_API void              ImFontAtlasBakedAddFontGlyphAdvancedX(ImFontAtlas* a
 IMGUI_API void              ImFontAtlasBakedDiscardFontGlyph(ImFontAtlas* atlas, ImFont* font, ImFontBaked* baked, ImFontGlyph* glyph);
 IMGUI_API void              ImFontAtlasBakedSetFontGlyphBitmap(ImFontAtlas* atlas, ImFontBaked* baked, ImFontConfig* src, ImFontGlyph* glyph, ImTextureRect* r, const unsigned char* src_pixels, ImTextureFormat src_fmt, int src_pitch);
 
+IMGUI_API void              ImFontAtlasAsyncBakerCommit(ImFontAtlas* atlas);     // Pack glyphs finished by worker threads
+IMGUI_API void              ImFontAtlasAsyncBakerCancel(ImFontAtlas* atlas, ImGuiID baked_id, int glyph_idx = -1);
+IMGUI_API void              ImFontAtlasAsyncBakerWaitIdle(ImFontAtlas* atlas);   // Wait for running jobs, before destroying font sources
+IMGUI_API void              ImFontAtlasAsyncBakerDestroy(ImFontAtlas* atlas);
+IMGUI_API int               ImFontAtlasAsyncBakerGetPendingCount(ImFontAtlas* atlas);
+
 IMGUI_API void              ImFontAtlasPackInit(ImFontAtlas* atlas);
 IMGUI_API ImFontAtlasRectId ImFontAtlasPackAddRect(ImFontAtlas* atlas, int w, int h, ImFontAtlasRectEntry* overwrite_entry = NULL);
 IMGUI_API ImTextureRect*    ImFontAtlasPackGetRect(ImFontAtlas* atlas, ImFontAtlasRectId id);
@@ -339,6 +339,28 @@ void ImGui::TextWrappedV(const char* fmt, va_list args)
         PopTextWrapPos();
 }
 
+// Same output as TextWrapped() for large text. The wrapped line index is updated incrementally and lines are submitted through a clipper,
+// so the cost per frame is the visible lines + the text appended since last frame, instead of the whole text.
+void ImGui::TextWrappedWithIndex(ImGuiTextWrapIndex* index, const char* text)
+{
+    ImGuiWindow* window = GetCurrentWindow();
+    if (window->SkipItems)
+        return;
+    ImGuiContext& g = *GImGui;
+
+    const float wrap_pos_x = window->DC.TextWrapPos >= 0.0f ? window->DC.TextWrapPos : 0.0f;
+    index->update(text, g.Font, g.FontSize, CalcWrapWidthForPos(window->DC.CursorPos, wrap_pos_x));
+
+    PushStyleVarY(ImGuiStyleVar_ItemSpacing, 0.0f);
+    ImGuiListClipper clipper;
+    clipper.Begin(index->wrapped_size(), GetTextLineHeight());
+    while (clipper.Step())
+        for (int line_n = clipper.DisplayStart; line_n < clipper.DisplayEnd; line_n++)
+            TextUnformatted(index->get_wrapped_line_begin(text, line_n), index->get_wrapped_line_end(text, line_n));
+    clipper.End();
+    PopStyleVar();
+}
+
 void ImGui::TextAligned(float align_x, float size_x, const char* fmt, ...)
 {
     va_list args;
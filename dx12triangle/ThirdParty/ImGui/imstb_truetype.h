@@ -142,6 +142,12 @@
 //        #define STBTT_RASTERIZER_VERSION 1
 //   which will incur about a 15% speed hit.
 //
+//   [DEAR IMGUI] The new rasterizer can vectorize its scanline accumulation
+//   and coverage-to-alpha conversion with SSE2 or NEON, with
+//        #define STBTT_ENABLE_SIMD
+//   It falls back to the scalar loops when neither instruction set is available.
+//   Summation order differs, so pixels may differ from the scalar output by 1.
+//
 // ADDITIONAL DOCUMENTATION
 //
 //   Immediately after this block comment are a series of sample programs.
@@ -492,6 +498,17 @@ int main(int arg, char **argv)
    #define STBTT_memcpy       memcpy
    #define STBTT_memset       memset
    #endif
+
+   // [DEAR IMGUI] #define STBTT_ENABLE_SIMD to vectorize the v2 rasterizer inner loops
+   #ifdef STBTT_ENABLE_SIMD
+   #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+   #include <emmintrin.h>
+   #define STBTT__SSE2
+   #elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+   #include <arm_neon.h>
+   #define STBTT__NEON
+   #endif
+   #endif
 #endif
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -3084,6 +3101,105 @@ static float stbtt__sized_triangle_area(float height, float width)
    return height * width / 2;
 }
 
+// [DEAR IMGUI] adds the sliding trapezoid areas (area + step/2, area + step*3/2, ...) to scanline[x0..x1), returns the area at x1
+static float stbtt__fill_span(float *scanline, int x0, int x1, float area, float step)
+{
+   int x = x0;
+#if defined(STBTT__SSE2)
+   if (x1 - x >= 4) {
+      __m128 v = _mm_add_ps(_mm_set1_ps(area + step/2), _mm_mul_ps(_mm_set1_ps(step), _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f)));
+      __m128 step4 = _mm_set1_ps(step*4);
+      for (; x + 4 <= x1; x += 4) {
+         _mm_storeu_ps(scanline + x, _mm_add_ps(_mm_loadu_ps(scanline + x), v));
+         v = _mm_add_ps(v, step4);
+      }
+      area += step * (x - x0);
+   }
+#elif defined(STBTT__NEON)
+   if (x1 - x >= 4) {
+      static const float lanes[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+      float32x4_t v = vmlaq_n_f32(vdupq_n_f32(area + step/2), vld1q_f32(lanes), step);
+      float32x4_t step4 = vdupq_n_f32(step*4);
+      for (; x + 4 <= x1; x += 4) {
+         vst1q_f32(scanline + x, vaddq_f32(vld1q_f32(scanline + x), v));
+         v = vaddq_f32(v, step4);
+      }
+      area += step * (x - x0);
+   }
+#endif
+   for (; x < x1; ++x) {
+      scanline[x] += area + step/2; // area of trapezoid is 1*step/2
+      area += step;
+   }
+   return area;
+}
+
+// [DEAR IMGUI] prefix sums the fill deltas into the coverage row and converts it to 8-bit alpha
+static void stbtt__resolve_scanline(unsigned char *pixels, const float *scanline, const float *scanline_fill, int w)
+{
+   float sum = 0;
+   int i = 0;
+#if defined(STBTT__SSE2)
+   {
+      const __m128 sign_mask = _mm_set1_ps(-0.0f);
+      const __m128 scale = _mm_set1_ps(255.0f);
+      const __m128 half = _mm_set1_ps(0.5f);
+      __m128 carry = _mm_setzero_ps();
+      for (; i + 4 <= w; i += 4) {
+         __m128 s = _mm_loadu_ps(scanline_fill + i);
+         __m128 k;
+         __m128i m;
+         int packed;
+         s = _mm_add_ps(s, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(s), 4)));
+         s = _mm_add_ps(s, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(s), 8)));
+         s = _mm_add_ps(s, carry);
+         carry = _mm_shuffle_ps(s, s, _MM_SHUFFLE(3, 3, 3, 3));
+         k = _mm_andnot_ps(sign_mask, _mm_add_ps(_mm_loadu_ps(scanline + i), s));
+         k = _mm_min_ps(_mm_add_ps(_mm_mul_ps(k, scale), half), scale);
+         m = _mm_cvttps_epi32(k);
+         m = _mm_packs_epi32(m, m);
+         m = _mm_packus_epi16(m, m);
+         packed = _mm_cvtsi128_si32(m);
+         STBTT_memcpy(pixels + i, &packed, 4);
+      }
+      sum = _mm_cvtss_f32(carry);
+   }
+#elif defined(STBTT__NEON)
+   {
+      const float32x4_t zero = vdupq_n_f32(0.0f);
+      const float32x4_t scale = vdupq_n_f32(255.0f);
+      const float32x4_t half = vdupq_n_f32(0.5f);
+      float32x4_t carry = zero;
+      for (; i + 4 <= w; i += 4) {
+         float32x4_t s = vld1q_f32(scanline_fill + i);
+         float32x4_t k;
+         uint16x4_t m16;
+         uint8x8_t m8;
+         s = vaddq_f32(s, vextq_f32(zero, s, 3));
+         s = vaddq_f32(s, vextq_f32(zero, s, 2));
+         s = vaddq_f32(s, carry);
+         carry = vdupq_n_f32(vgetq_lane_f32(s, 3));
+         k = vabsq_f32(vaddq_f32(vld1q_f32(scanline + i), s));
+         k = vminq_f32(vmlaq_f32(half, k, scale), scale);
+         m16 = vmovn_u32(vcvtq_u32_f32(k));
+         m8 = vmovn_u16(vcombine_u16(m16, m16));
+         vst1_lane_u32((stbtt_uint32 *) (void *) (pixels + i), vreinterpret_u32_u8(m8), 0);
+      }
+      sum = vgetq_lane_f32(carry, 0);
+   }
+#endif
+   for (; i < w; ++i) {
+      float k;
+      int m;
+      sum += scanline_fill[i];
+      k = scanline[i] + sum;
+      k = (float) STBTT_fabs(k)*255 + 0.5f;
+      m = (int) k;
+      if (m > 255) m = 255;
+      pixels[i] = (unsigned char) m;
+   }
+}
+
 static void stbtt__fill_active_edges_new(float *scanline, float *scanline_fill, int len, stbtt__active_edge *e, float y_top)
 {
    float y_bottom = y_top+1;
@@ -3143,7 +3259,7 @@ static void stbtt__fill_active_edges_new(float *scanline, float *scanline_fill,
                scanline[x]      += stbtt__position_trapezoid_area(height, x_top, x+1.0f, x_bottom, x+1.0f);
                scanline_fill[x] += height; // everything right of this pixel is filled
             } else {
-               int x,x1,x2;
+               int x1,x2; // [DEAR IMGUI] removed x, the span loop moved to stbtt__fill_span()
                float y_crossing, y_final, step, sign, area;
                // covers 2+ pixels
                if (x_top > x_bottom) {
@@ -3221,10 +3337,7 @@ static void stbtt__fill_active_edges_new(float *scanline, float *scanline_fill,
                // which multiplied by 1-pixel-width is how much pixel area changes for each step in x
                // so the area advances by 'step' every time
 
-               for (x = x1+1; x < x2; ++x) {
-                  scanline[x] += area + step/2; // area of trapezoid is 1*step/2
-                  area += step;
-               }
+               area = stbtt__fill_span(scanline, x1+1, x2, area, step); // [DEAR IMGUI] factored out for the SIMD path
                STBTT_assert(STBTT_fabs(area) <= 1.01f); // accumulated error from area += step unless we round step down
                STBTT_assert(sy1 > y_final-0.01f);
 
@@ -3306,7 +3419,7 @@ static void stbtt__rasterize_sorted_edges(stbtt__bitmap *result, stbtt__edge *e,
 {
    stbtt__hheap hh = { 0, 0, 0 };
    stbtt__active_edge *active = NULL;
-   int y,j=0, i;
+   int y,j=0; // [DEAR IMGUI] removed i, the conversion loop moved to stbtt__resolve_scanline()
    float scanline_data[129], *scanline, *scanline2;
 
    STBTT__NOTUSED(vsubsample);
@@ -3368,19 +3481,7 @@ static void stbtt__rasterize_sorted_edges(stbtt__bitmap *result, stbtt__edge *e,
       if (active)
          stbtt__fill_active_edges_new(scanline, scanline2+1, result->w, active, scan_y_top);
 
-      {
-         float sum = 0;
-         for (i=0; i < result->w; ++i) {
-            float k;
-            int m;
-            sum += scanline2[i];
-            k = scanline[i] + sum;
-            k = (float) STBTT_fabs(k)*255 + 0.5f;
-            m = (int) k;
-            if (m > 255) m = 255;
-            result->pixels[j*result->stride + i] = (unsigned char) m;
-         }
-      }
+      stbtt__resolve_scanline(result->pixels + j*result->stride, scanline, scanline2, result->w); // [DEAR IMGUI] factored out for the SIMD path
       // advance all the edges
       step = &active;
       while (*step) {
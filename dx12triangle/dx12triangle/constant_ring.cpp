@@ -0,0 +1,67 @@
+#include "constant_ring.h"
+#include <cassert>
+
+ConstantRing::ConstantRing(uint64_t capacity, uint64_t alignment)
+	: m_capacity(capacity - capacity % alignment), m_alignment(alignment)
+{
+	assert(alignment > 0 && (alignment & (alignment - 1)) == 0 && "alignment must be a power of two");
+}
+
+uint64_t ConstantRing::Allocate(uint64_t size)
+{
+	size = (size + m_alignment - 1) & ~(m_alignment - 1);
+	if (size == 0 || size > m_capacity)
+		return InvalidOffset;
+
+	uint64_t offset = m_head;
+	uint64_t padding = 0;
+	if (m_usedSize == 0)
+	{
+		// nothing in use, start over at the front so the whole buffer is available
+		offset = 0;
+		m_tail = 0;
+	}
+	else if (m_head > m_tail)
+	{
+		// free space is [head, capacity) and [0, tail)
+		if (m_capacity - m_head < size)
+		{
+			if (size > m_tail)
+				return InvalidOffset;
+			padding = m_capacity - m_head;
+			offset = 0;
+		}
+	}
+	else
+	{
+		// wrapped around, free space is [head, tail), nothing when head caught up with tail
+		if (m_tail - m_head < size)
+			return InvalidOffset;
+	}
+
+	m_head = offset + size;
+	if (m_head == m_capacity)
+		m_head = 0;
+	m_usedSize += padding + size;
+	m_frameSize += padding + size;
+	return offset;
+}
+
+void ConstantRing::EndFrame(uint64_t fenceValue)
+{
+	assert((m_frames.empty() || m_frames.back().fenceValue <= fenceValue) && "fence values must not go backwards");
+	if (m_frameSize == 0)
+		return;
+	m_frames.push_back({ fenceValue, m_head, m_frameSize });
+	m_frameSize = 0;
+}
+
+void ConstantRing::Retire(uint64_t completedFenceValue)
+{
+	while (!m_frames.empty() && m_frames.front().fenceValue <= completedFenceValue)
+	{
+		m_tail = m_frames.front().end;
+		m_usedSize -= m_frames.front().size;
+		m_frames.pop_front();
+	}
+}
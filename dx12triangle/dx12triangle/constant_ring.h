@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+
+// ring sub-allocator for per-frame constant data
+// every call gets a fresh slice so nothing written this frame overwrites data an earlier
+// draw (or a frame still in flight) reads. slices are handed out in order, a frame's slices
+// are recycled once the fence value it was submitted with has completed.
+// only offsets are managed, the memory is a mapped upload buffer owned by the caller.
+// no d3d12/windows dependencies so it can be compiled and tested on its own
+
+class ConstantRing
+{
+public:
+	static const uint64_t InvalidOffset = UINT64_MAX;
+
+	// capacity is the size of the buffer, alignment of every slice (cbvs need 256 bytes)
+	explicit ConstantRing(uint64_t capacity = 0, uint64_t alignment = 256);
+
+	// offset of a slice of at least size bytes, InvalidOffset when frames in flight still use
+	// the space. a slice never wraps around the end of the buffer
+	uint64_t Allocate(uint64_t size);
+
+	// the slices allocated since the last call belong to gpu work that signals fenceValue
+	void EndFrame(uint64_t fenceValue);
+	// recycles the slices of every frame whose fence value is <= completedFenceValue
+	void Retire(uint64_t completedFenceValue);
+
+	uint64_t GetCapacity() const { return m_capacity; }
+	uint64_t GetUsedSize() const { return m_usedSize; } // including padding skipped at the end
+	uint32_t GetFramesInFlight() const { return (uint32_t)m_frames.size(); }
+
+private:
+	struct Frame
+	{
+		uint64_t fenceValue;
+		uint64_t end;  // head after the frame's last slice
+		uint64_t size; // bytes the frame took, padding included
+	};
+
+	uint64_t m_capacity;
+	uint64_t m_alignment;
+	uint64_t m_head = 0; // next free byte
+	uint64_t m_tail = 0; // oldest byte still in use
+	uint64_t m_usedSize = 0;
+	uint64_t m_frameSize = 0; // taken since the last EndFrame
+	std::deque<Frame> m_frames;
+};
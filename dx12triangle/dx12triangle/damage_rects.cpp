@@ -0,0 +1,324 @@
+#include "damage_rects.h"
+#include "idle_frame.h" // HashBytes
+#include "ImGui/imgui.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+// if more than this fraction of the frame is damaged we just redraw everything
+static const float FullRedrawThreshold = 0.75f;
+// beyond this many raw rectangles merging gets expensive, collapse to the bounding box instead
+static const int MaxRawRects = 256;
+
+static DamageRect UnionRect(const DamageRect& a, const DamageRect& b)
+{
+	return { std::min(a.left, b.left), std::min(a.top, b.top), std::max(a.right, b.right), std::max(a.bottom, b.bottom) };
+}
+
+static bool RectsOverlap(const DamageRect& a, const DamageRect& b)
+{
+	return a.left < b.right && b.left < a.right && a.top < b.bottom && b.top < a.bottom;
+}
+
+DamageTracker::DamageTracker(int bufferCount)
+	: m_bufferCount(std::max(bufferCount, 1))
+{
+	m_history.resize(m_bufferCount);
+}
+
+void DamageTracker::Reset()
+{
+	m_hasPrevious = false;
+	m_previous.clear();
+	for (FrameDamage& frame : m_history)
+	{
+		frame.full = true;
+		frame.rects.clear();
+	}
+}
+
+void DamageTracker::BeginFrame(int framebufferWidth, int framebufferHeight)
+{
+	if (framebufferWidth != m_width || framebufferHeight != m_height)
+	{
+		m_width = framebufferWidth;
+		m_height = framebufferHeight;
+		Reset();
+	}
+	m_current.clear();
+	m_pending.clear();
+	m_currentFull = !m_hasPrevious;
+}
+
+void DamageTracker::AddRect(const DamageRect& rect)
+{
+	DamageRect clipped = { std::max(rect.left, 0), std::max(rect.top, 0), std::min(rect.right, m_width), std::min(rect.bottom, m_height) };
+	if (!clipped.IsEmpty())
+		m_pending.push_back(clipped);
+}
+
+void DamageTracker::AddFullFrame()
+{
+	m_currentFull = true;
+}
+
+void DamageTracker::AddDrawData(const ImDrawData* drawData)
+{
+	if (drawData == nullptr || !drawData->Valid)
+		return;
+
+	const ImVec2 clipOff = drawData->DisplayPos;
+	const ImVec2 clipScale = drawData->FramebufferScale;
+
+	// textures created or updated this frame change what their commands show without changing
+	// the commands themselves (e.g. glyphs baked into the font atlas), so those commands are damage
+	m_updatedTextures.clear();
+	if (drawData->Textures != nullptr)
+		for (const ImTextureData* tex : *drawData->Textures)
+			if (tex->Status == ImTextureStatus_WantCreate || tex->Status == ImTextureStatus_WantUpdates)
+				m_updatedTextures.push_back(tex);
+
+	for (const ImDrawList* drawList : drawData->CmdLists)
+	{
+		for (const ImDrawCmd& cmd : drawList->CmdBuffer)
+		{
+			if (cmd.UserCallback != nullptr)
+			{
+				// we can't know what a callback draws, assume its whole clip rect changes every frame
+				if (cmd.UserCallback != ImDrawCallback_ResetRenderState)
+					AddRect({ (int)floorf((cmd.ClipRect.x - clipOff.x) * clipScale.x), (int)floorf((cmd.ClipRect.y - clipOff.y) * clipScale.y),
+						(int)ceilf((cmd.ClipRect.z - clipOff.x) * clipScale.x), (int)ceilf((cmd.ClipRect.w - clipOff.y) * clipScale.y) });
+				continue;
+			}
+			if (cmd.ElemCount == 0 && cmd.GlyphCount == 0)
+				continue;
+
+			// vertex range referenced by this command
+			const ImDrawIdx* indices = drawList->IdxBuffer.Data + cmd.IdxOffset;
+			unsigned int minIndex = 0;
+			unsigned int maxIndex = 0;
+			if (cmd.ElemCount > 0)
+			{
+				minIndex = maxIndex = indices[0];
+				for (unsigned int i = 1; i < cmd.ElemCount; i++)
+				{
+					minIndex = std::min<unsigned int>(minIndex, indices[i]);
+					maxIndex = std::max<unsigned int>(maxIndex, indices[i]);
+				}
+			}
+			const ImDrawVert* vertices = drawList->VtxBuffer.Data + cmd.VtxOffset + minIndex;
+			const unsigned int vertexCount = (cmd.ElemCount > 0) ? maxIndex - minIndex + 1 : 0;
+
+			ImVec2 boundsMin(FLT_MAX, FLT_MAX);
+			ImVec2 boundsMax(-FLT_MAX, -FLT_MAX);
+			for (unsigned int i = 0; i < vertexCount; i++)
+			{
+				const ImVec2 pos = vertices[i].pos; // also works with IMGUI_USE_COMPACT_DRAWVERT
+				boundsMin.x = std::min(boundsMin.x, pos.x);
+				boundsMin.y = std::min(boundsMin.y, pos.y);
+				boundsMax.x = std::max(boundsMax.x, pos.x);
+				boundsMax.y = std::max(boundsMax.y, pos.y);
+			}
+
+			// glyph instances are expanded by the renderer, their quads come from the texture's glyph rects
+			const ImDrawGlyph* glyphs = drawList->GlyphBuffer.Data + cmd.GlyphOffset;
+			const ImTextureData* glyphTex = cmd.TexRef._TexData;
+			for (unsigned int i = 0; i < cmd.GlyphCount; i++)
+			{
+				const ImDrawGlyphRect& rect = glyphTex->GlyphRects[glyphs[i].GlyphId];
+				boundsMin.x = std::min(boundsMin.x, glyphs[i].X + rect.X0);
+				boundsMin.y = std::min(boundsMin.y, glyphs[i].Y + rect.Y0);
+				boundsMax.x = std::max(boundsMax.x, glyphs[i].X + rect.X1);
+				boundsMax.y = std::max(boundsMax.y, glyphs[i].Y + rect.Y1);
+			}
+			boundsMin.x = std::max(boundsMin.x, cmd.ClipRect.x);
+			boundsMin.y = std::max(boundsMin.y, cmd.ClipRect.y);
+			boundsMax.x = std::min(boundsMax.x, cmd.ClipRect.z);
+			boundsMax.y = std::min(boundsMax.y, cmd.ClipRect.w);
+
+			Record record;
+			record.bounds = {
+				std::max((int)floorf((boundsMin.x - clipOff.x) * clipScale.x), 0),
+				std::max((int)floorf((boundsMin.y - clipOff.y) * clipScale.y), 0),
+				std::min((int)ceilf((boundsMax.x - clipOff.x) * clipScale.x), m_width),
+				std::min((int)ceilf((boundsMax.y - clipOff.y) * clipScale.y), m_height) };
+			if (record.bounds.IsEmpty())
+				continue;
+			if (!m_updatedTextures.empty() && std::find(m_updatedTextures.begin(), m_updatedTextures.end(), cmd.TexRef._TexData) != m_updatedTextures.end())
+				m_pending.push_back(record.bounds);
+
+			// indices are hashed relative to the first referenced vertex so the record
+			// does not depend on where the geometry sits in the draw list buffers
+			uint64_t hash = HashBytes(&cmd.ClipRect, sizeof(cmd.ClipRect), FrameHashSeed);
+			hash = HashBytes(&cmd.TexRef._TexData, sizeof(cmd.TexRef._TexData), hash);
+			hash = HashBytes(&cmd.TexRef._TexID, sizeof(cmd.TexRef._TexID), hash);
+			hash = HashBytes(vertices, vertexCount * sizeof(ImDrawVert), hash);
+			for (unsigned int i = 0; i < cmd.ElemCount; i++)
+			{
+				const unsigned int relative = indices[i] - minIndex;
+				hash = HashBytes(&relative, sizeof(relative), hash);
+			}
+			hash = HashBytes(glyphs, cmd.GlyphCount * sizeof(ImDrawGlyph), hash);
+			record.hash = HashBytes(&record.bounds, sizeof(record.bounds), hash);
+			m_current.push_back(record);
+		}
+	}
+}
+
+// walks the current records in order and greedily matches them against previous records
+// that come after the last match. the matched records form a common subsequence, so every
+// pixel covered only by matched records is composited from the same commands in the same
+// order as last frame and does not need to be redrawn. everything else is damage.
+void DamageTracker::DiffRecords()
+{
+	m_positions.clear();
+	m_cursors.clear();
+	for (int i = 0; i < (int)m_previous.size(); i++)
+		m_positions[m_previous[i].hash].push_back(i);
+	m_previousMatched.assign(m_previous.size(), false);
+
+	int lastMatched = -1;
+	for (const Record& record : m_current)
+	{
+		int match = -1;
+		auto positions = m_positions.find(record.hash);
+		if (positions != m_positions.end())
+		{
+			int& cursor = m_cursors[record.hash];
+			const std::vector<int>& list = positions->second;
+			while (cursor < (int)list.size() && list[cursor] <= lastMatched)
+				cursor++;
+			if (cursor < (int)list.size())
+				match = list[cursor++];
+		}
+
+		if (match >= 0)
+		{
+			m_previousMatched[match] = true;
+			lastMatched = match;
+		}
+		else
+		{
+			m_pending.push_back(record.bounds);
+		}
+	}
+
+	for (int i = 0; i < (int)m_previous.size(); i++)
+		if (!m_previousMatched[i])
+			m_pending.push_back(m_previous[i].bounds);
+}
+
+void DamageTracker::EndFrame()
+{
+	if (!m_currentFull)
+		DiffRecords();
+	m_previous.swap(m_current);
+	m_hasPrevious = true;
+
+	// shift the history, [0] becomes this frame
+	std::rotate(m_history.rbegin(), m_history.rbegin() + 1, m_history.rend());
+	FrameDamage& frame = m_history[0];
+	frame.rects.clear();
+	frame.full = m_currentFull;
+	if (!frame.full)
+	{
+		frame.rects = m_pending;
+		MergeRects(frame.rects, MaxDamageRects);
+		int64_t area = 0;
+		for (const DamageRect& rect : frame.rects)
+			area += rect.Area();
+		if (area > (int64_t)(GetFramePixels() * FullRedrawThreshold))
+			frame.full = true;
+	}
+
+	m_frameDamage.clear();
+	if (!frame.full)
+		m_frameDamage = frame.rects;
+
+	// the back buffer holds content from m_bufferCount frames ago
+	m_fullRedraw = false;
+	m_redrawRects.clear();
+	for (const FrameDamage& older : m_history)
+	{
+		if (older.full)
+		{
+			m_fullRedraw = true;
+			break;
+		}
+		m_redrawRects.insert(m_redrawRects.end(), older.rects.begin(), older.rects.end());
+	}
+	if (!m_fullRedraw)
+	{
+		MergeRects(m_redrawRects, MaxDamageRects);
+		if (GetRedrawPixels() > (int64_t)(GetFramePixels() * FullRedrawThreshold))
+			m_fullRedraw = true;
+	}
+	if (m_fullRedraw)
+	{
+		m_redrawRects.clear();
+		m_redrawRects.push_back({ 0, 0, m_width, m_height });
+	}
+}
+
+int64_t DamageTracker::GetRedrawPixels() const
+{
+	int64_t area = 0;
+	for (const DamageRect& rect : m_redrawRects)
+		area += rect.Area();
+	return area;
+}
+
+void DamageTracker::MergeRects(std::vector<DamageRect>& rects, int maxRects)
+{
+	rects.erase(std::remove_if(rects.begin(), rects.end(), [](const DamageRect& r) { return r.IsEmpty(); }), rects.end());
+	if (rects.empty())
+		return;
+
+	if ((int)rects.size() > MaxRawRects)
+	{
+		DamageRect bounds = rects[0];
+		for (const DamageRect& rect : rects)
+			bounds = UnionRect(bounds, rect);
+		rects.clear();
+		rects.push_back(bounds);
+		return;
+	}
+
+	// merge overlapping rects until nothing overlaps anymore, the output never overlaps
+	// itself so no pixel gets drawn twice
+	bool merged = true;
+	while (merged)
+	{
+		merged = false;
+		for (size_t i = 0; i < rects.size() && !merged; i++)
+			for (size_t j = i + 1; j < rects.size(); j++)
+				if (RectsOverlap(rects[i], rects[j]))
+				{
+					rects[i] = UnionRect(rects[i], rects[j]);
+					rects.erase(rects.begin() + j);
+					merged = true;
+					break;
+				}
+	}
+
+	// too many left, merge the pair that adds the fewest extra pixels
+	while ((int)rects.size() > maxRects)
+	{
+		size_t bestI = 0, bestJ = 1;
+		int64_t bestCost = INT64_MAX;
+		for (size_t i = 0; i < rects.size(); i++)
+			for (size_t j = i + 1; j < rects.size(); j++)
+			{
+				int64_t cost = UnionRect(rects[i], rects[j]).Area() - rects[i].Area() - rects[j].Area();
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestI = i;
+					bestJ = j;
+				}
+			}
+		rects[bestI] = UnionRect(rects[bestI], rects[bestJ]);
+		rects.erase(rects.begin() + bestJ);
+		MergeRects(rects, (int)rects.size()); // the union may now overlap others
+	}
+}
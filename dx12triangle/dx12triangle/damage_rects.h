@@ -0,0 +1,90 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+
+// damage tracking for partial redraws
+// every imgui draw command is reduced to a record (screen bounds + hash of its geometry,
+// texture and clip rect). consecutive frames are diffed in draw order, records that
+// did not survive unchanged and in the same relative order become damage rectangles.
+// no d3d12/windows dependencies so it can be compiled and tested on its own
+
+struct ImDrawData;
+struct ImTextureData;
+
+// framebuffer pixels, right/bottom exclusive (same convention as RECT/D3D12_RECT)
+struct DamageRect
+{
+	int left, top, right, bottom;
+
+	bool IsEmpty() const { return right <= left || bottom <= top; }
+	int64_t Area() const { return IsEmpty() ? 0 : (int64_t)(right - left) * (bottom - top); }
+};
+
+class DamageTracker
+{
+public:
+	// upper bound on rectangles handed to the renderer / Present1, extra ones get merged
+	static const int MaxDamageRects = 8;
+
+	// frames in flight that still hold older content, a back buffer we render into
+	// is this many frames old so its redraw area is the union of that many frames of damage
+	explicit DamageTracker(int bufferCount = 2);
+
+	// the next frames are fully damaged, call after enabling, resizing or losing the back buffers
+	void Reset();
+
+	void BeginFrame(int framebufferWidth, int framebufferHeight);
+	void AddRect(const DamageRect& rect); // damage coming from outside imgui (scene changes)
+	void AddFullFrame();
+	void AddDrawData(const ImDrawData* drawData);
+	void EndFrame();
+
+	// damage relative to the previously presented frame, this is what Present1 wants
+	const std::vector<DamageRect>& GetFrameDamage() const { return m_frameDamage; }
+	// area that has to be redrawn in the current back buffer
+	const std::vector<DamageRect>& GetRedrawRects() const { return m_redrawRects; }
+	// true when partial redraw would not pay off and the whole back buffer is redrawn
+	bool IsFullRedraw() const { return m_fullRedraw; }
+	bool IsFrameDamageFull() const { return m_history[0].full; }
+
+	int64_t GetRedrawPixels() const;
+	int64_t GetFramePixels() const { return (int64_t)m_width * m_height; }
+
+	// merges overlapping rectangles, then the cheapest pairs until at most maxRects are left
+	static void MergeRects(std::vector<DamageRect>& rects, int maxRects);
+
+private:
+	struct Record
+	{
+		uint64_t hash;
+		DamageRect bounds;
+	};
+	struct FrameDamage
+	{
+		bool full = true;
+		std::vector<DamageRect> rects;
+	};
+
+	void DiffRecords();
+
+	int m_bufferCount;
+	int m_width = 0;
+	int m_height = 0;
+	bool m_hasPrevious = false;
+	bool m_currentFull = false;
+	bool m_fullRedraw = true;
+
+	std::vector<Record> m_previous;
+	std::vector<Record> m_current;
+	std::vector<DamageRect> m_pending;
+	std::vector<FrameDamage> m_history; // [0] = current frame
+	std::vector<DamageRect> m_frameDamage;
+	std::vector<DamageRect> m_redrawRects;
+
+	// diff scratch, kept around to avoid reallocating every frame
+	std::unordered_map<uint64_t, std::vector<int>> m_positions;
+	std::unordered_map<uint64_t, int> m_cursors;
+	std::vector<bool> m_previousMatched;
+	std::vector<const ImTextureData*> m_updatedTextures; // textures whose pixels change this frame
+};
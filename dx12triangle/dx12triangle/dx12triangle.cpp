@@ -7,6 +7,13 @@
 #include "ImGui/imgui_impl_win32.h"
 #include "ImGui/imgui_impl_dx12.h"
 #include <DirectXMath.h>
+#include <cfloat>
+#include <algorithm>
+#include "idle_frame.h"
+#include "damage_rects.h"
+#include "gpu_memory.h"
+#include "residency.h"
+#include "root_signature.h"
 using namespace DirectX;
 
 #pragma comment(lib, "d3d12.lib")
@@ -35,7 +42,18 @@ ComPtr<ID3D12Fence> g_fence;
 UINT64 g_fenceValue = 0;
 HANDLE g_fenceEvent; // to tell CPU to wait for GPU
 
-ComPtr<ID3D12RootSignature> g_rootSignature; // defines resources shaders need
+// buffers and textures are placed in large heaps instead of one committed resource each
+GpuMemoryAllocator g_gpuMemory;
+// evicts the least recently used default heap memory when we go over the video memory budget
+ResidencyManager g_residency;
+std::vector<ID3D12Resource*> g_imguiResources; // created by the imgui backend, all used every frame
+int g_budgetLimitMB = 0; // ui override, 0 = os budget
+
+// root signatures are built from layouts and cached by layout hash
+RootSignatureCache g_rootSignatures;
+RootLayout g_sceneLayout; // the rotation matrix goes in as root constants when it fits
+UINT g_sceneConstantsParam = 0;
+ID3D12RootSignature* g_rootSignature = nullptr; // defines resources shaders need, owned by g_rootSignatures
 ComPtr<ID3D12PipelineState> g_pipelineState;
 
 // simple shaders
@@ -79,24 +97,79 @@ const char* g_PixelShader = R"(
 ComPtr<ID3D12Resource> g_vertexBuffer;
 D3D12_VERTEX_BUFFER_VIEW g_vertexBufferView; 
 
-ComPtr<ID3D12Resource> g_constantBuffer; // gpu resource, we use this for rotation values
+ComPtr<ID3D12Resource> g_constantBuffer; // gpu resource, per-draw data that does not fit in root constants goes here
 UINT8* g_pConstantBufferStart = nullptr; // cpu pointer to gpu memory
+PerDrawConstantRing g_perDrawConstants; // hands out a slice of g_constantBuffer per draw
 float g_angle = 0.0f; // current rotation angle
+XMFLOAT4X4 g_rotationMatrix; // this frame's constant buffer contents
 
 struct Vertex {
 	float position[3];
 	float color[4];
 };
 
+const Vertex g_triangleVertices[] = {
+	// bottom-left vertex - red
+	{ { -0.5f, -0.5f, 0.0f }, { 1.0f, 0.0f, 0.0f, 1.0f } },
+	// bottom-right vertex - green
+	{ { 0.0f, 0.5f, 0.0f },  { 0.0f, 1.0f, 0.0f, 1.0f } },
+	// top vertex - blue
+	{ { 0.5f, -0.5f, 0.0f }, { 0.0f, 0.0f, 1.0f, 1.0f } }
+};
+
 ComPtr<ID3D12DescriptorHeap> g_ImguiSrvDescHeap;
+const UINT ImguiSrvDescriptorCount = 64; // one per imgui texture (font atlas pages, user images)
+UINT g_imguiSrvDescriptorSize = 0;
+std::vector<UINT> g_imguiSrvFreeIndices;
 float g_clearColor[4] = { 0.0f, 0.2f, 0.4f, 1.0f };
 float g_rotationSpeed = 0.01f;
 
+// idle frame skipping
+// when the imgui output and the scene constants hash to the same value as the last
+// presented frame we skip recording and presenting, and block on window messages instead
+IdleFrameDetector g_idleFrames;
+const DWORD IdleWaitTimeoutMs = 100; // still wake up now and then for imgui timers (cursor blink, tooltips)
+
+// stats shown in the ui are only refreshed once per interval, otherwise the
+// numbers themselves would change every frame and no frame would ever be idle
+const double StatsRefreshInterval = 1.0;
+struct FrameStats
+{
+	double lastRefreshTime = -1.0;
+	float framerate = 0.0f;
+	uint64_t presentedFrames = 0;
+	uint64_t skippedFrames = 0;
+	float redrawnFraction = 1.0f;
+	UINT64 memoryBudget = 0;
+	UINT64 memoryUsage = 0;
+	UINT64 trackedResidentBytes = 0;
+	UINT64 trackedEvictedBytes = 0;
+	uint64_t totalEvictions = 0;
+	uint64_t totalMakeResidents = 0;
+
+	// accumulated since the last refresh
+	int64_t redrawnPixels = 0;
+	int64_t framePixels = 0;
+};
+FrameStats g_frameStats;
+
+// partial redraw
+// imgui draw commands are diffed against the last presented frame, only the damaged
+// regions get cleared and redrawn and they are passed to Present1 as dirty rects.
+// needs a flip sequential swap chain so the back buffers keep their old content
+bool g_partialRedraw = false;
+DamageTracker g_damageTracker(2); // one history entry per back buffer
+float g_presentedClearColor[4] = {};
+XMFLOAT4X4 g_presentedRotationMatrix = {};
+
 
 LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam);
 extern IMGUI_IMPL_API LRESULT ImGui_ImplWin32_WndProcHandler(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
 void InitD3D();
-void PopulateCommandList();
+void UpdateSceneConstants();
+void UpdateDamage(ImDrawData* drawData);
+void MarkFrameResourcesUsed(UINT64 fenceValue);
+void PopulateCommandList(const D3D12_RECT* redrawRects, UINT redrawRectCount, bool fullRedraw);
 void WaitForPreviousFrame();
 
 // main entry point for windows applications
@@ -151,28 +224,125 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
 			ImGui_ImplWin32_NewFrame();
 			ImGui::NewFrame();
 
+			if (ImGui::GetTime() - g_frameStats.lastRefreshTime >= StatsRefreshInterval)
+			{
+				g_frameStats.lastRefreshTime = ImGui::GetTime();
+				g_frameStats.framerate = io.Framerate;
+				g_frameStats.presentedFrames = g_idleFrames.presentedFrames;
+				g_frameStats.skippedFrames = g_idleFrames.skippedFrames;
+				if (g_frameStats.framePixels > 0)
+					g_frameStats.redrawnFraction = (float)((double)g_frameStats.redrawnPixels / (double)g_frameStats.framePixels);
+				g_frameStats.redrawnPixels = 0;
+				g_frameStats.framePixels = 0;
+				g_frameStats.memoryBudget = g_residency.GetBudget();
+				g_frameStats.memoryUsage = g_residency.GetLocalMemoryInfo().CurrentUsage;
+				g_frameStats.trackedResidentBytes = g_residency.GetPolicy().GetResidentBytes();
+				g_frameStats.trackedEvictedBytes = g_residency.GetPolicy().GetEvictedBytes();
+				g_frameStats.totalEvictions = g_residency.GetPolicy().GetTotalEvictions();
+				g_frameStats.totalMakeResidents = g_residency.GetPolicy().GetTotalMakeResidents();
+			}
+
 			// simple control window
 			ImGui::Begin("triangle controls");
 			ImGui::SliderFloat("rotation speed", &g_rotationSpeed, 0.0f, 0.1f);
 			ImGui::ColorEdit3("clear color", g_clearColor);
+			ImGui::Checkbox("skip idle frames", &g_idleFrames.enabled);
+			if (ImGui::Checkbox("partial redraw", &g_partialRedraw))
+				g_damageTracker.Reset();
 
 			ImGui::Text("current angle: %.2f radians", g_angle);
-			ImGui::Text("application avg: %.3f ms/frame (%.1f FPS)", 100.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+			ImGui::Text("application avg: %.3f ms/frame (%.1f FPS)", 100.0f / g_frameStats.framerate, g_frameStats.framerate);
+			ImGui::Text("presented frames: %llu, skipped frames: %llu", g_frameStats.presentedFrames, g_frameStats.skippedFrames);
+			ImGui::Text("pixels redrawn: %.1f%% of full frame", g_frameStats.redrawnFraction * 100.0f);
+
+			if (ImGui::CollapsingHeader("gpu memory"))
+			{
+				ImGui::Text("heap blocks: %u (%.1f MB), committed fallbacks: %.1f KB", g_gpuMemory.GetBlockCount(),
+					g_gpuMemory.GetReservedBytes() / (1024.0 * 1024.0), g_gpuMemory.GetCommittedBytes() / 1024.0);
+				for (int category = 0; category < GpuMemoryCategory_Count; category++)
+				{
+					const GpuMemoryStats& stats = g_gpuMemory.GetCategoryStats((GpuMemoryCategory)category);
+					ImGui::Text("%-15s %3u resources, %8.1f KB requested, %8.1f KB allocated", GetGpuMemoryCategoryName((GpuMemoryCategory)category),
+						stats.allocationCount, stats.requestedBytes / 1024.0, stats.allocatedBytes / 1024.0);
+				}
+			}
+			if (ImGui::CollapsingHeader("video memory"))
+			{
+				const double mb = 1024.0 * 1024.0;
+				ImGui::Text("usage: %.1f MB of %.1f MB budget", g_frameStats.memoryUsage / mb, g_frameStats.memoryBudget / mb);
+				ImGui::ProgressBar(g_frameStats.memoryBudget > 0 ? (float)((double)g_frameStats.memoryUsage / (double)g_frameStats.memoryBudget) : 0.0f);
+				ImGui::Text("tracked: %.1f MB resident, %.1f MB evicted", g_frameStats.trackedResidentBytes / mb, g_frameStats.trackedEvictedBytes / mb);
+				ImGui::Text("evictions: %llu, made resident again: %llu", g_frameStats.totalEvictions, g_frameStats.totalMakeResidents);
+				if (ImGui::SliderInt("budget limit (MB)", &g_budgetLimitMB, 0, 4096, g_budgetLimitMB == 0 ? "os budget" : "%d MB"))
+					g_residency.SetBudgetLimit((UINT64)g_budgetLimitMB * 1024 * 1024);
+			}
 			ImGui::End();
 
-			PopulateCommandList();
-			ID3D12CommandList* commandLists[] = { g_commandList.Get() };
-			g_commandQueue->ExecuteCommandLists(_countof(commandLists), commandLists);
-			g_swapChain->Present(1, 0);
-			WaitForPreviousFrame();
+			ImGui::Render();
+			UpdateSceneConstants();
+
+			// hash what would be drawn, the clear color and the rotation matrix are the only scene inputs
+			ImDrawData* drawData = ImGui::GetDrawData();
+			uint64_t frameHash = HashBytes(g_clearColor, sizeof(g_clearColor), FrameHashSeed);
+			frameHash = HashBytes(&g_rotationMatrix, sizeof(g_rotationMatrix), frameHash);
+			frameHash = HashDrawData(drawData, frameHash);
+
+			if (g_idleFrames.ShouldPresent(frameHash, DrawDataHasPendingTextures(drawData)))
+			{
+				D3D12_RECT redrawRects[DamageTracker::MaxDamageRects];
+				RECT dirtyRects[DamageTracker::MaxDamageRects];
+				UINT redrawRectCount = 0;
+				UINT dirtyRectCount = 0;
+				bool fullRedraw = true;
+
+				if (g_partialRedraw)
+				{
+					UpdateDamage(drawData);
+					fullRedraw = g_damageTracker.IsFullRedraw();
+					for (const DamageRect& rect : g_damageTracker.GetRedrawRects())
+						redrawRects[redrawRectCount++] = { rect.left, rect.top, rect.right, rect.bottom };
+					for (const DamageRect& rect : g_damageTracker.GetFrameDamage())
+						dirtyRects[dirtyRectCount++] = { rect.left, rect.top, rect.right, rect.bottom };
+				}
+				g_frameStats.redrawnPixels += fullRedraw ? (int64_t)WindowWidth * WindowHeight : g_damageTracker.GetRedrawPixels();
+				g_frameStats.framePixels += (int64_t)WindowWidth * WindowHeight;
+
+				// everything this frame touches has to be resident before it is submitted
+				MarkFrameResourcesUsed(g_fenceValue);
+				g_residency.MakePendingResident();
+
+				g_perDrawConstants.BeginFrame(g_fence->GetCompletedValue());
+				PopulateCommandList(redrawRects, redrawRectCount, fullRedraw);
+				ID3D12CommandList* commandLists[] = { g_commandList.Get() };
+				g_commandQueue->ExecuteCommandLists(_countof(commandLists), commandLists);
+				g_perDrawConstants.EndFrame(g_fenceValue); // WaitForPreviousFrame signals this value
+
+				// no dirty rects means the whole frame changed
+				DXGI_PRESENT_PARAMETERS presentParams = {};
+				presentParams.DirtyRectsCount = dirtyRectCount;
+				presentParams.pDirtyRects = dirtyRectCount > 0 ? dirtyRects : nullptr;
+				g_swapChain->Present1(1, 0, &presentParams);
+				WaitForPreviousFrame();
+				g_residency.Update(g_fence->GetCompletedValue());
+			}
+			else
+			{
+				// the last presented image is still valid, sleep until input arrives or the timeout expires
+				MsgWaitForMultipleObjects(0, nullptr, FALSE, IdleWaitTimeoutMs, QS_ALLINPUT);
+			}
 		}
 	}
 
-	// cleanup done by comptr
+	// cleanup done by comptr, except for resources owned by the gpu memory allocator
 	CloseHandle(g_fenceEvent);
 	ImGui_ImplDX12_Shutdown();
 	ImGui_ImplWin32_Shutdown();
 	ImGui::DestroyContext();
+	g_gpuMemory.ReleaseResource(g_vertexBuffer.Detach());
+	g_gpuMemory.ReleaseResource(g_constantBuffer.Detach());
+	g_gpuMemory.Shutdown();
+	g_residency.Shutdown();
+	g_rootSignatures.Shutdown();
 	return 0;
 }
 
@@ -220,37 +390,15 @@ void CreatePipelineStateObject()
 	}
 
 	// create a root signature
-	// updating root parameter for imgui
-	// parameter0 cbv
-	D3D12_ROOT_PARAMETER rootParameters[2] = {};
-	rootParameters[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV; // constant buffer view
-	rootParameters[0].Descriptor.ShaderRegister = 0;
-	rootParameters[0].Descriptor.RegisterSpace = 0;
-	rootParameters[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX; // only the vertex shader will use this
-
-	// parameter1 descriptor table for textures
-	D3D12_DESCRIPTOR_RANGE descriptorRange = {};
-	descriptorRange.RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV; // shader resource view
-	descriptorRange.NumDescriptors = 1;
-	descriptorRange.BaseShaderRegister = 0; // use register t0
-	descriptorRange.RegisterSpace = 0;
-	descriptorRange.OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
-	
-	rootParameters[1].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
-	rootParameters[1].DescriptorTable.NumDescriptorRanges = 1;
-	rootParameters[1].DescriptorTable.pDescriptorRanges = &descriptorRange;
-	rootParameters[1].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL; // textures are usally used in pixel shaders
-
-	D3D12_ROOT_SIGNATURE_DESC rootSignatureDesc = {};
-	rootSignatureDesc.NumParameters = 2;
-	rootSignatureDesc.pParameters = rootParameters;
-	rootSignatureDesc.NumStaticSamplers = 0;
-	rootSignatureDesc.pStaticSamplers = nullptr;
-	rootSignatureDesc.Flags = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
-
-	ComPtr<ID3DBlob> signature;
-	D3D12SerializeRootSignature(&rootSignatureDesc, D3D_ROOT_SIGNATURE_VERSION_1, &signature, nullptr);
-	g_device->CreateRootSignature(0, signature->GetBufferPointer(), signature->GetBufferSize(), IID_PPV_ARGS(&g_rootSignature));
+	// parameter0 per-draw scene constants (b0), parameter1 descriptor table for textures (t0)
+	g_sceneConstantsParam = g_sceneLayout.AddPerDrawData(0, sizeof(XMFLOAT4X4), RootShaderStage_Vertex); // only the vertex shader will use this
+	g_sceneLayout.AddSrvTable(0, 1, RootShaderStage_Pixel); // textures are usally used in pixel shaders
+	g_rootSignature = g_rootSignatures.Get(g_sceneLayout);
+	if (g_rootSignature == nullptr)
+	{
+		MessageBox(nullptr, L"Failed to create root signature!", L"Error", MB_OK);
+		exit(1);
+	}
 
 	// define vertex input layout
 	D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
@@ -261,7 +409,7 @@ void CreatePipelineStateObject()
 	// create pso
 	D3D12_GRAPHICS_PIPELINE_STATE_DESC psoDesc = {};
 	psoDesc.InputLayout = { inputLayout, _countof(inputLayout) };
-	psoDesc.pRootSignature = g_rootSignature.Get();
+	psoDesc.pRootSignature = g_rootSignature;
 	psoDesc.VS = { vertexShader->GetBufferPointer(), vertexShader->GetBufferSize() };
 	psoDesc.PS = { pixelShader->GetBufferPointer(), pixelShader->GetBufferSize() };
 
@@ -315,16 +463,7 @@ void CreateAssets()
 {
 	HRESULT hr;
 
-	Vertex triangleVertices[] = {
-		// bottom-left vertex - red
-		{ { -0.5f, -0.5f, 0.0f }, { 1.0f, 0.0f, 0.0f, 1.0f } },
-		// bottom-right vertex - green
-		{ { 0.0f, 0.5f, 0.0f },  { 0.0f, 1.0f, 0.0f, 1.0f } },
-		// top vertex - blue
-		{ { 0.5f, -0.5f, 0.0f }, { 0.0f, 0.0f, 1.0f, 1.0f } }
-	};
-
-	const UINT vertexBufferSize = sizeof(triangleVertices);
+	const UINT vertexBufferSize = sizeof(g_triangleVertices);
 
 	// create vertex buffer resource on te gpu (default heap)
 	D3D12_HEAP_PROPERTIES heapProps = {};
@@ -347,36 +486,34 @@ void CreateAssets()
 	resDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
 	resDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
 
-	g_device->CreateCommittedResource(
+	g_gpuMemory.CreateResource(
+		GpuMemoryCategory_Geometry,
 		&heapProps,
-		D3D12_HEAP_FLAG_NONE,
 		&resDesc,
 		D3D12_RESOURCE_STATE_COPY_DEST,
-		nullptr,
-		IID_PPV_ARGS(&g_vertexBuffer)
+		&g_vertexBuffer
 	);
 
 	// temporary upload heap to get data to the gpu
 	heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
 
-	ComPtr<ID3D12Resource> vertexBufferUpload;
-	g_device->CreateCommittedResource(
+	ID3D12Resource* vertexBufferUpload = nullptr; // handed back to the allocator once the copy is done
+	g_gpuMemory.CreateResource(
+		GpuMemoryCategory_Upload,
 		&heapProps,
-		D3D12_HEAP_FLAG_NONE,
 		&resDesc,
 		D3D12_RESOURCE_STATE_GENERIC_READ,
-		nullptr,
-		IID_PPV_ARGS(&vertexBufferUpload)
+		&vertexBufferUpload
 	);
 
 	// copy data to the upload heap, then schedule a copy to the default heap
 	void* data;
 	vertexBufferUpload->Map(0, nullptr, &data);
-	memcpy(data, triangleVertices, vertexBufferSize);
+	memcpy(data, g_triangleVertices, vertexBufferSize);
 	vertexBufferUpload->Unmap(0, nullptr);
 
 	g_commandList->Reset(g_commandAllocator.Get(), nullptr);
-	g_commandList->CopyResource(g_vertexBuffer.Get(), vertexBufferUpload.Get());
+	g_commandList->CopyResource(g_vertexBuffer.Get(), vertexBufferUpload);
 	g_commandList->Close();
 
 	ID3D12CommandList* ppCommandLists[] = { g_commandList.Get() };
@@ -401,14 +538,16 @@ void CreateAssets()
 	g_commandQueue->ExecuteCommandLists(_countof(ppCommandListsTransition), ppCommandListsTransition);
 
 	WaitForPreviousFrame();
+	g_gpuMemory.ReleaseResource(vertexBufferUpload);
 	g_vertexBufferView.BufferLocation = g_vertexBuffer->GetGPUVirtualAddress();
 
 	g_vertexBufferView.BufferLocation = g_vertexBuffer->GetGPUVirtualAddress();
 	g_vertexBufferView.StrideInBytes = sizeof(Vertex);
 	g_vertexBufferView.SizeInBytes = vertexBufferSize;
 
-	// create the constant buffer for the rotation matrix
-	const UINT constantBufferSize = sizeof(XMMATRIX); // 64 bytes
+	// create the constant buffer per-draw data falls back to when it is not a root constant,
+	// every draw gets its own 256 byte slice so this holds a few hundred draws across the frames in flight
+	const UINT constantBufferSize = 64 * 1024;
 
 	D3D12_HEAP_PROPERTIES heapPropscb = {};
 	heapPropscb.Type = D3D12_HEAP_TYPE_UPLOAD;
@@ -430,13 +569,12 @@ void CreateAssets()
 	resDesccb.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
 	resDesccb.Flags = D3D12_RESOURCE_FLAG_NONE;
 
-	hr = g_device->CreateCommittedResource(
+	hr = g_gpuMemory.CreateResource(
+		GpuMemoryCategory_Constants,
 		&heapPropscb,
-		D3D12_HEAP_FLAG_NONE,
 		&resDesccb,
 		D3D12_RESOURCE_STATE_GENERIC_READ,
-		nullptr,
-		IID_PPV_ARGS(&g_constantBuffer)
+		&g_constantBuffer
 	);
 
 	if (FAILED(hr)) {
@@ -455,9 +593,7 @@ void CreateAssets()
 		exit(1);
 	}
 
-	// init constant buffer with an identity matrix first
-	XMMATRIX identityMatrix = XMMatrixIdentity();
-	memcpy(g_pConstantBufferStart, &identityMatrix, sizeof(identityMatrix));
+	g_perDrawConstants.Init(g_constantBuffer.Get(), g_pConstantBufferStart, constantBufferSize);
 }
 
 // setup directx objects
@@ -484,6 +620,22 @@ void InitD3D()
 	factory->EnumAdapters1(0, &hwAdapter); // get the first default adapter
 	
 	D3D12CreateDevice(hwAdapter.Get(), D3D_FEATURE_LEVEL_11_0, IID_PPV_ARGS(&g_device));
+	g_gpuMemory.Init(g_device.Get());
+	g_rootSignatures.Init(g_device.Get());
+
+	// only default heaps count against the local budget we watch, upload heaps stay mapped
+	ComPtr<IDXGIAdapter3> adapter3;
+	hwAdapter.As(&adapter3);
+	g_residency.Init(g_device.Get(), adapter3.Get());
+	g_gpuMemory.SetPageableCallback([](void*, ID3D12Pageable* pageable, D3D12_HEAP_TYPE heapType, UINT64 size, bool created)
+	{
+		if (heapType != D3D12_HEAP_TYPE_DEFAULT)
+			return;
+		if (created)
+			g_residency.Track(pageable, size);
+		else
+			g_residency.Untrack(pageable);
+	}, nullptr);
 
 	// create command queue
 	D3D12_COMMAND_QUEUE_DESC queueDesc = {};
@@ -498,7 +650,7 @@ void InitD3D()
 	swapChainDesc.Height = WindowHeight;
 	swapChainDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
 	swapChainDesc.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
-	swapChainDesc.SwapEffect = DXGI_SWAP_EFFECT_FLIP_DISCARD;
+	swapChainDesc.SwapEffect = DXGI_SWAP_EFFECT_FLIP_SEQUENTIAL; // partial redraw relies on back buffers keeping their content
 	swapChainDesc.SampleDesc.Count = 1;
 
 	ComPtr<IDXGISwapChain1> swapChainLocal;
@@ -523,7 +675,7 @@ void InitD3D()
 
 	D3D12_DESCRIPTOR_HEAP_DESC imGuiDesc = {};
 	imGuiDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-	imGuiDesc.NumDescriptors = 1; // one for the font texture
+	imGuiDesc.NumDescriptors = ImguiSrvDescriptorCount;
 	imGuiDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
 	HRESULT hr = g_device->CreateDescriptorHeap(&imGuiDesc, IID_PPV_ARGS(&g_ImguiSrvDescHeap));
 	
@@ -531,6 +683,9 @@ void InitD3D()
 		MessageBox(nullptr, L"Failed to create imgui descriptor heap!", L"Error", MB_OK);
 		exit(1);
 	}
+	g_imguiSrvDescriptorSize = g_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+	for (UINT i = ImguiSrvDescriptorCount; i > 0; i--)
+		g_imguiSrvFreeIndices.push_back(i - 1);
 
 	// create RTVs for the back buffers
 	/*
@@ -577,39 +732,107 @@ void InitD3D()
 	ImGui::CreateContext();
 	ImGuiIO& io = ImGui::GetIO(); (void)io;
 
-	// build font atlas manually first
-	// dx12 backend will handle uploading this to a texture
-	unsigned char* pixels;
-	int width, height;
-	io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
-
 	ImGui_ImplWin32_Init(hWnd);
 
-	// get the cpu and gpu descriptor handles from the heap
-	D3D12_CPU_DESCRIPTOR_HANDLE fontCpuHandle = g_ImguiSrvDescHeap->GetCPUDescriptorHandleForHeapStart();
-	D3D12_GPU_DESCRIPTOR_HANDLE fontGpuHandle = g_ImguiSrvDescHeap->GetGPUDescriptorHandleForHeapStart();
-
-	ImGui_ImplDX12_Init(g_device.Get(), 2,
-		DXGI_FORMAT_R8G8B8A8_UNORM,
-		g_ImguiSrvDescHeap.Get(),
-		fontCpuHandle,
-		fontGpuHandle
-	);
+	// the dx12 backend creates and uploads the font atlas textures itself,
+	// we hand out srv descriptors from our heap and place its buffers/textures with our allocator
+	ImGui_ImplDX12_InitInfo initInfo;
+	initInfo.Device = g_device.Get();
+	initInfo.CommandQueue = g_commandQueue.Get();
+	initInfo.NumFramesInFlight = 2;
+	initInfo.RTVFormat = DXGI_FORMAT_R8G8B8A8_UNORM;
+	initInfo.DSVFormat = DXGI_FORMAT_UNKNOWN;
+	initInfo.SrvDescriptorHeap = g_ImguiSrvDescHeap.Get();
+	initInfo.SrvDescriptorAllocFn = [](ImGui_ImplDX12_InitInfo*, D3D12_CPU_DESCRIPTOR_HANDLE* outCpuHandle, D3D12_GPU_DESCRIPTOR_HANDLE* outGpuHandle)
+	{
+		IM_ASSERT(!g_imguiSrvFreeIndices.empty() && "out of imgui srv descriptors");
+		UINT index = g_imguiSrvFreeIndices.back();
+		g_imguiSrvFreeIndices.pop_back();
+		outCpuHandle->ptr = g_ImguiSrvDescHeap->GetCPUDescriptorHandleForHeapStart().ptr + (SIZE_T)index * g_imguiSrvDescriptorSize;
+		outGpuHandle->ptr = g_ImguiSrvDescHeap->GetGPUDescriptorHandleForHeapStart().ptr + (UINT64)index * g_imguiSrvDescriptorSize;
+	};
+	initInfo.SrvDescriptorFreeFn = [](ImGui_ImplDX12_InitInfo*, D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle, D3D12_GPU_DESCRIPTOR_HANDLE)
+	{
+		UINT index = (UINT)((cpuHandle.ptr - g_ImguiSrvDescHeap->GetCPUDescriptorHandleForHeapStart().ptr) / g_imguiSrvDescriptorSize);
+		g_imguiSrvFreeIndices.push_back(index);
+	};
+	initInfo.ResourceCreateFn = [](ImGui_ImplDX12_InitInfo*, const D3D12_HEAP_PROPERTIES* heapProps, const D3D12_RESOURCE_DESC* desc, D3D12_RESOURCE_STATES initialState, ID3D12Resource** outResource)
+	{
+		GpuMemoryCategory category = desc->Dimension == D3D12_RESOURCE_DIMENSION_BUFFER ? GpuMemoryCategory_UserInterface : GpuMemoryCategory_Textures;
+		HRESULT hr = g_gpuMemory.CreateResource(category, heapProps, desc, initialState, outResource);
+		if (FAILED(hr))
+			return hr;
+		// the backend uploads into new resources right away, the heap they landed in may have been evicted
+		g_imguiResources.push_back(*outResource);
+		g_residency.MarkUsed(g_gpuMemory.GetPageable(*outResource), g_fenceValue);
+		return g_residency.MakePendingResident();
+	};
+	initInfo.ResourceReleaseFn = [](ImGui_ImplDX12_InitInfo*, ID3D12Resource* resource)
+	{
+		g_imguiResources.erase(std::find(g_imguiResources.begin(), g_imguiResources.end(), resource));
+		g_gpuMemory.ReleaseResource(resource);
+	};
+	ImGui_ImplDX12_Init(&initInfo);
 
 	ImGui_ImplDX12_CreateDeviceObjects();
 }
 
-void PopulateCommandList()
+// calculate the new rotation matrix for this frame
+void UpdateSceneConstants()
 {
-	// calculate the new rotation matrix for this frame
 	XMMATRIX rotationMat = XMMatrixRotationZ(g_angle);
-	XMFLOAT4X4 mat4x4;
-	XMStoreFloat4x4(&mat4x4, rotationMat);
-	memcpy(g_pConstantBufferStart, &mat4x4, sizeof(XMFLOAT4X4)); // copy to gpu
+	XMStoreFloat4x4(&g_rotationMatrix, rotationMat);
+}
 
+// screen space bounds of the triangle for a given rotation, used as scene damage
+DamageRect TriangleScreenRect(const XMFLOAT4X4& rotation)
+{
+	XMMATRIX mat = XMLoadFloat4x4(&rotation);
+	float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+	for (const Vertex& vertex : g_triangleVertices)
+	{
+		// same transform as the vertex shader, then ndc to pixels
+		XMFLOAT3 ndc;
+		XMStoreFloat3(&ndc, XMVector3Transform(XMLoadFloat3((const XMFLOAT3*)vertex.position), mat));
+		float x = (ndc.x * 0.5f + 0.5f) * WindowWidth;
+		float y = (0.5f - ndc.y * 0.5f) * WindowHeight;
+		minX = min(minX, x);
+		minY = min(minY, y);
+		maxX = max(maxX, x);
+		maxY = max(maxY, y);
+	}
+	// one extra pixel around for rasterization rounding
+	return { (int)floorf(minX) - 1, (int)floorf(minY) - 1, (int)ceilf(maxX) + 1, (int)ceilf(maxY) + 1 };
+}
+
+// diff this frame against the last presented one
+void UpdateDamage(ImDrawData* drawData)
+{
+	g_damageTracker.BeginFrame(WindowWidth, WindowHeight);
+	if (memcmp(g_presentedClearColor, g_clearColor, sizeof(g_clearColor)) != 0)
+	{
+		g_damageTracker.AddFullFrame();
+	}
+	else if (memcmp(&g_presentedRotationMatrix, &g_rotationMatrix, sizeof(g_rotationMatrix)) != 0)
+	{
+		g_damageTracker.AddRect(TriangleScreenRect(g_presentedRotationMatrix));
+		g_damageTracker.AddRect(TriangleScreenRect(g_rotationMatrix));
+	}
+	g_damageTracker.AddDrawData(drawData);
+	g_damageTracker.EndFrame();
+
+	memcpy(g_presentedClearColor, g_clearColor, sizeof(g_clearColor));
+	g_presentedRotationMatrix = g_rotationMatrix;
+}
+
+// redrawRects are only used when fullRedraw is false, an empty list then means nothing changed
+void PopulateCommandList(const D3D12_RECT* redrawRects, UINT redrawRectCount, bool fullRedraw)
+{
 	// reset command allocator and command list
 	g_commandAllocator->Reset();
 	g_commandList->Reset(g_commandAllocator.Get(), g_pipelineState.Get()); // no pso yet so pass null
+	// render targets / depth stencils placed since the last frame need a discard before first use
+	g_gpuMemory.RecordPendingDiscards(g_commandList.Get());
 
 	// tell gpu that we will draw to it now by transitioning the back buffer from
 	// present state to a render target state
@@ -639,24 +862,37 @@ void PopulateCommandList()
 	D3D12_RECT scissorRect = {};
 	scissorRect.right = WindowWidth;
 	scissorRect.bottom = WindowHeight;
-	g_commandList->RSSetScissorRects(1, &scissorRect);
+	if (fullRedraw)
+	{
+		redrawRects = &scissorRect;
+		redrawRectCount = 1;
+	}
 
-	// issue commands to clear the render target
-	g_commandList->ClearRenderTargetView(rtvHandle, g_clearColor, 0, nullptr);
+	// issue commands to clear the render target, only inside the redraw rects
+	// the rest of the back buffer still holds what was presented from it last time
+	if (redrawRectCount > 0)
+		g_commandList->ClearRenderTargetView(rtvHandle, g_clearColor, redrawRectCount, redrawRects);
 
-	g_commandList->SetGraphicsRootSignature(g_rootSignature.Get());
-	g_commandList->SetGraphicsRootConstantBufferView(0, g_constantBuffer->GetGPUVirtualAddress());
+	g_commandList->SetGraphicsRootSignature(g_rootSignature);
+	const bool sceneConstantsBound = SetGraphicsPerDrawData(g_commandList.Get(), g_sceneLayout, g_sceneConstantsParam,
+		&g_rotationMatrix, sizeof(g_rotationMatrix), g_perDrawConstants);
 	g_commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 	g_commandList->IASetVertexBuffers(0, 1, &g_vertexBufferView);
-	g_commandList->DrawInstanced(3, 1, 0, 0);
+	for (UINT i = 0; i < redrawRectCount && sceneConstantsBound; i++)
+	{
+		g_commandList->RSSetScissorRects(1, &redrawRects[i]);
+		g_commandList->DrawInstanced(3, 1, 0, 0);
+	}
 
 	// set the descriptor heap that imgui will use
 	ID3D12DescriptorHeap* ppHeaps[] = { g_ImguiSrvDescHeap.Get() };
 	g_commandList->SetDescriptorHeaps(_countof(ppHeaps), ppHeaps);
 
-	// render imgui data onto the same back buffer
-	ImGui::Render();
-	ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), g_commandList.Get());
+	// render imgui data onto the same back buffer, ImGui::Render() was already called by the main loop
+	if (fullRedraw)
+		ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), g_commandList.Get());
+	else if (redrawRectCount > 0)
+		ImGui_ImplDX12_RenderDrawDataInRects(ImGui::GetDrawData(), g_commandList.Get(), redrawRects, redrawRectCount);
 
 	// transition the back buffer back to a present state
 	D3D12_RESOURCE_BARRIER barrier2 = {};
@@ -671,6 +907,14 @@ void PopulateCommandList()
 	g_commandList->Close();
 }
 
+void MarkFrameResourcesUsed(UINT64 fenceValue)
+{
+	g_residency.MarkUsed(g_gpuMemory.GetPageable(g_vertexBuffer.Get()), fenceValue);
+	g_residency.MarkUsed(g_gpuMemory.GetPageable(g_constantBuffer.Get()), fenceValue);
+	for (ID3D12Resource* resource : g_imguiResources)
+		g_residency.MarkUsed(g_gpuMemory.GetPageable(resource), fenceValue);
+}
+
 void WaitForPreviousFrame() 
 {
 	// signal the fence with the current value
@@ -0,0 +1,368 @@
+#include "gpu_memory.h"
+#include <cassert>
+
+const char* GetGpuMemoryCategoryName(GpuMemoryCategory category)
+{
+	switch (category)
+	{
+	case GpuMemoryCategory_Geometry: return "geometry";
+	case GpuMemoryCategory_Constants: return "constants";
+	case GpuMemoryCategory_Textures: return "textures";
+	case GpuMemoryCategory_Upload: return "upload";
+	case GpuMemoryCategory_UserInterface: return "user interface";
+	default: return "unknown";
+	}
+}
+
+void GpuMemoryAllocator::Init(ID3D12Device* device, UINT64 blockSize)
+{
+	m_device = device;
+	m_blockSize = blockSize;
+
+	const D3D12_HEAP_TYPE heapTypes[PoolHeapTypeCount] = { D3D12_HEAP_TYPE_DEFAULT, D3D12_HEAP_TYPE_UPLOAD, D3D12_HEAP_TYPE_READBACK };
+	for (int type = 0; type < PoolHeapTypeCount; type++)
+	{
+		// resource heap tier 1 can't mix buffers, textures and render targets in one heap
+		const D3D12_HEAP_FLAGS heapFlags[PoolKind_Count] = { D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS, D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES, D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES };
+		const UINT64 granularities[PoolKind_Count] = { D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT, D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT };
+		for (int kind = 0; kind < PoolKind_Count; kind++)
+		{
+			Pool& pool = m_pools[type][kind];
+			pool.heapType = heapTypes[type];
+			pool.heapFlags = heapFlags[kind];
+			pool.blocks = BlockList(granularities[kind]);
+		}
+	}
+}
+
+void GpuMemoryAllocator::Shutdown()
+{
+	assert(m_allocations.empty() && "release all resources before shutting down the allocator");
+	m_pendingDiscards.clear();
+	ReleaseEmptyBlocks();
+	m_device = nullptr;
+}
+
+GpuMemoryAllocator::Pool* GpuMemoryAllocator::FindPool(const D3D12_HEAP_PROPERTIES* heapProps, const D3D12_RESOURCE_DESC* desc)
+{
+	int type;
+	switch (heapProps->Type)
+	{
+	case D3D12_HEAP_TYPE_DEFAULT: type = 0; break;
+	case D3D12_HEAP_TYPE_UPLOAD: type = 1; break;
+	case D3D12_HEAP_TYPE_READBACK: type = 2; break;
+	default: return nullptr; // custom heaps go the committed route
+	}
+
+	if (desc->Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+		return &m_pools[type][PoolKind_Buffers];
+
+	// textures only live in default heaps, msaa needs 4MB placement alignment
+	if (heapProps->Type != D3D12_HEAP_TYPE_DEFAULT || desc->SampleDesc.Count > 1)
+		return nullptr;
+	if (desc->Flags & (D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL))
+		return &m_pools[type][PoolKind_RenderTargets];
+	return &m_pools[type][PoolKind_Textures];
+}
+
+GpuMemoryAllocator::Block* GpuMemoryAllocator::AddBlock(Pool* pool, UINT64 minSize)
+{
+	UINT64 size = m_blockSize;
+	if (size < minSize)
+		size = (minSize + D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT - 1) & ~(UINT64)(D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT - 1);
+
+	D3D12_HEAP_DESC heapDesc = {};
+	heapDesc.SizeInBytes = size;
+	heapDesc.Properties.Type = pool->heapType;
+	heapDesc.Properties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+	heapDesc.Properties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+	heapDesc.Properties.CreationNodeMask = 1;
+	heapDesc.Properties.VisibleNodeMask = 1;
+	heapDesc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+	heapDesc.Flags = pool->heapFlags;
+
+	Microsoft::WRL::ComPtr<ID3D12Heap> heap;
+	if (FAILED(m_device->CreateHeap(&heapDesc, IID_PPV_ARGS(&heap))))
+		return nullptr;
+	NotifyPageable(heap.Get(), pool->heapType, size, true);
+	return pool->blocks.AddBlock(std::move(heap), size);
+}
+
+void GpuMemoryAllocator::ReleaseBlock(Pool* pool, Block& block)
+{
+	NotifyPageable(block.heap.Get(), pool->heapType, block.allocator.GetCapacity(), false);
+}
+
+HRESULT GpuMemoryAllocator::PlaceResource(Pool* pool, const Block* sourceBlock, float minTargetUsage, const D3D12_RESOURCE_DESC* desc,
+	const D3D12_RESOURCE_ALLOCATION_INFO& info, D3D12_RESOURCE_STATES state, ID3D12Resource** outResource, Allocation& allocation)
+{
+	TlsfAllocator::Handle handle;
+	Block* block = pool->blocks.Allocate(info.SizeInBytes, info.Alignment, sourceBlock, minTargetUsage, handle);
+	if (block == nullptr)
+	{
+		// moving an allocation must not grow the pool
+		if (sourceBlock != nullptr)
+			return E_OUTOFMEMORY;
+		block = AddBlock(pool, info.SizeInBytes);
+		if (block == nullptr)
+			return E_OUTOFMEMORY;
+		handle = block->allocator.Allocate(info.SizeInBytes, info.Alignment);
+		assert(handle != TlsfAllocator::InvalidHandle);
+	}
+
+	// a new render target / depth stencil gets discarded before its first use, which needs it in the
+	// render target / depth write state. moved ones are initialized by the full copy of the old contents
+	D3D12_RESOURCE_STATES createState = state;
+	const bool needsDiscard = sourceBlock == nullptr && (desc->Flags & (D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL)) != 0;
+	if (needsDiscard)
+		createState = (desc->Flags & D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL) ? D3D12_RESOURCE_STATE_DEPTH_WRITE : D3D12_RESOURCE_STATE_RENDER_TARGET;
+
+	HRESULT hr = m_device->CreatePlacedResource(block->heap.Get(), block->allocator.GetOffset(handle), desc, createState, nullptr, IID_PPV_ARGS(outResource));
+	if (FAILED(hr))
+	{
+		// Defragment() is iterating the pool's blocks, it releases the empty ones once it is done
+		if (sourceBlock != nullptr)
+			block->allocator.Free(handle);
+		else
+			pool->blocks.Free(block, handle, [this, pool](Block& released) { ReleaseBlock(pool, released); });
+		return hr;
+	}
+	if (needsDiscard)
+		m_pendingDiscards.push_back({ *outResource, createState, state });
+	allocation.pool = pool;
+	allocation.block = block;
+	allocation.handle = handle;
+	allocation.allocatedBytes = block->allocator.GetSize(handle);
+	allocation.state = state;
+	return S_OK;
+}
+
+HRESULT GpuMemoryAllocator::CreateResource(GpuMemoryCategory category, const D3D12_HEAP_PROPERTIES* heapProps, const D3D12_RESOURCE_DESC* desc,
+	D3D12_RESOURCE_STATES initialState, ID3D12Resource** outResource)
+{
+	Pool* pool = FindPool(heapProps, desc);
+	D3D12_RESOURCE_DESC placedDesc = *desc;
+	D3D12_RESOURCE_ALLOCATION_INFO info;
+
+	// small textures can use 4KB alignment if the device agrees, otherwise fall back to the default
+	if (pool != nullptr && desc->Dimension != D3D12_RESOURCE_DIMENSION_BUFFER && desc->Alignment == 0)
+	{
+		placedDesc.Alignment = D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT;
+		info = m_device->GetResourceAllocationInfo(0, 1, &placedDesc);
+		if (info.Alignment != D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT)
+			placedDesc.Alignment = 0;
+	}
+	if (placedDesc.Alignment == 0 || desc->Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+		info = m_device->GetResourceAllocationInfo(0, 1, &placedDesc);
+
+	// big resources get their own committed allocation, they would just fragment the blocks
+	if (info.SizeInBytes == UINT64_MAX || info.Alignment > D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT || info.SizeInBytes > m_blockSize / 2)
+		pool = nullptr;
+
+	Allocation allocation = {};
+	allocation.category = category;
+	allocation.requestedBytes = desc->Dimension == D3D12_RESOURCE_DIMENSION_BUFFER ? desc->Width : info.SizeInBytes;
+	allocation.heapType = heapProps->Type;
+
+	HRESULT hr;
+	if (pool != nullptr)
+	{
+		hr = PlaceResource(pool, nullptr, 0.0f, &placedDesc, info, initialState, outResource, allocation);
+	}
+	else
+	{
+		hr = m_device->CreateCommittedResource(heapProps, D3D12_HEAP_FLAG_NONE, desc, initialState, nullptr, IID_PPV_ARGS(outResource));
+		allocation.allocatedBytes = info.SizeInBytes != UINT64_MAX ? info.SizeInBytes : 0;
+		allocation.state = initialState;
+		if (SUCCEEDED(hr))
+		{
+			m_committedBytes += allocation.allocatedBytes;
+			NotifyPageable(*outResource, heapProps->Type, allocation.allocatedBytes, true);
+		}
+	}
+	if (FAILED(hr))
+		return hr;
+
+	m_allocations[*outResource] = allocation;
+	GpuMemoryStats& stats = m_stats[category];
+	stats.allocationCount++;
+	stats.requestedBytes += allocation.requestedBytes;
+	stats.allocatedBytes += allocation.allocatedBytes;
+	return S_OK;
+}
+
+void GpuMemoryAllocator::FreeAllocation(const Allocation& allocation)
+{
+	if (allocation.pool != nullptr)
+	{
+		Pool* pool = allocation.pool;
+		pool->blocks.Free(allocation.block, allocation.handle, [this, pool](Block& released) { ReleaseBlock(pool, released); });
+	}
+	else
+		m_committedBytes -= allocation.allocatedBytes;
+
+	GpuMemoryStats& stats = m_stats[allocation.category];
+	stats.allocationCount--;
+	stats.requestedBytes -= allocation.requestedBytes;
+	stats.allocatedBytes -= allocation.allocatedBytes;
+}
+
+void GpuMemoryAllocator::ReleaseResource(ID3D12Resource* resource)
+{
+	if (resource == nullptr)
+		return;
+	for (size_t i = 0; i < m_pendingDiscards.size(); i++)
+		if (m_pendingDiscards[i].resource == resource)
+		{
+			m_pendingDiscards.erase(m_pendingDiscards.begin() + i);
+			break;
+		}
+
+	auto it = m_allocations.find(resource);
+	if (it != m_allocations.end())
+	{
+		if (it->second.pool == nullptr)
+			NotifyPageable(resource, it->second.heapType, it->second.allocatedBytes, false);
+		FreeAllocation(it->second);
+		m_allocations.erase(it);
+	}
+	resource->Release();
+}
+
+bool GpuMemoryAllocator::HasPendingDiscard(ID3D12Resource* resource) const
+{
+	for (const PendingDiscard& pending : m_pendingDiscards)
+		if (pending.resource == resource)
+			return true;
+	return false;
+}
+
+UINT GpuMemoryAllocator::Defragment(MoveFn moveFn, void* userData, float maxBlockUsage)
+{
+	UINT moved = 0;
+	std::vector<ID3D12Resource*> candidates;
+	std::vector<Block*> blocks;
+	for (auto& poolsOfType : m_pools)
+	{
+		for (Pool& pool : poolsOfType)
+		{
+			if (pool.blocks.GetBlockCount() < 2)
+				continue;
+			// iterate a copy of the block list: allocations are freed straight from their block here and
+			// PlaceResource() leaves emptied blocks to ReleaseEmptyBlocks() below, but a block released
+			// or added mid-loop must not invalidate the iteration
+			blocks.clear();
+			for (const std::unique_ptr<Block>& block : pool.blocks.GetBlocks())
+				blocks.push_back(block.get());
+			for (Block* block : blocks)
+			{
+				const TlsfAllocator& allocator = block->allocator;
+				if (allocator.IsEmpty() || (float)allocator.GetUsedSize() >= maxBlockUsage * (float)allocator.GetCapacity())
+					continue;
+
+				candidates.clear();
+				for (const auto& entry : m_allocations)
+					if (entry.second.block == block && !HasPendingDiscard(entry.first))
+						candidates.push_back(entry.first);
+
+				for (ID3D12Resource* oldResource : candidates)
+				{
+					Allocation oldAllocation = m_allocations[oldResource];
+					D3D12_RESOURCE_DESC desc = oldResource->GetDesc();
+					D3D12_RESOURCE_ALLOCATION_INFO info = m_device->GetResourceAllocationInfo(0, 1, &desc);
+
+					Allocation newAllocation = oldAllocation;
+					ID3D12Resource* newResource = nullptr;
+					if (FAILED(PlaceResource(&pool, block, maxBlockUsage, &desc, info, oldAllocation.state, &newResource, newAllocation)))
+						continue;
+					if (!moveFn(userData, oldResource, newResource))
+					{
+						newAllocation.block->allocator.Free(newAllocation.handle);
+						newResource->Release();
+						continue;
+					}
+
+					// same category, so only the allocated size can change
+					m_stats[oldAllocation.category].allocatedBytes += newAllocation.allocatedBytes - oldAllocation.allocatedBytes;
+					oldAllocation.block->allocator.Free(oldAllocation.handle);
+					m_allocations.erase(oldResource);
+					m_allocations[newResource] = newAllocation;
+					oldResource->Release();
+					moved++;
+				}
+			}
+		}
+	}
+	ReleaseEmptyBlocks();
+	return moved;
+}
+
+void GpuMemoryAllocator::ReleaseEmptyBlocks()
+{
+	for (auto& poolsOfType : m_pools)
+		for (Pool& pool : poolsOfType)
+			pool.blocks.ReleaseEmptyBlocks(0, [this, &pool](Block& released) { ReleaseBlock(&pool, released); });
+}
+
+void GpuMemoryAllocator::SetMaxEmptyBlocks(UINT maxEmptyBlocks)
+{
+	for (auto& poolsOfType : m_pools)
+		for (Pool& pool : poolsOfType)
+		{
+			pool.blocks.SetMaxEmptyBlocks(maxEmptyBlocks);
+			pool.blocks.ReleaseEmptyBlocks(maxEmptyBlocks, [this, &pool](Block& released) { ReleaseBlock(&pool, released); });
+		}
+}
+
+void GpuMemoryAllocator::RecordPendingDiscards(ID3D12GraphicsCommandList* commandList)
+{
+	std::vector<D3D12_RESOURCE_BARRIER> barriers;
+	for (const PendingDiscard& pending : m_pendingDiscards)
+	{
+		commandList->DiscardResource(pending.resource, nullptr);
+		if (pending.state == pending.discardState)
+			continue;
+		D3D12_RESOURCE_BARRIER barrier = {};
+		barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+		barrier.Transition.pResource = pending.resource;
+		barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+		barrier.Transition.StateBefore = pending.discardState;
+		barrier.Transition.StateAfter = pending.state;
+		barriers.push_back(barrier);
+	}
+	if (!barriers.empty())
+		commandList->ResourceBarrier((UINT)barriers.size(), barriers.data());
+	m_pendingDiscards.clear();
+}
+
+UINT GpuMemoryAllocator::GetBlockCount() const
+{
+	UINT count = 0;
+	for (const auto& poolsOfType : m_pools)
+		for (const Pool& pool : poolsOfType)
+			count += (UINT)pool.blocks.GetBlockCount();
+	return count;
+}
+
+UINT64 GpuMemoryAllocator::GetReservedBytes() const
+{
+	UINT64 bytes = 0;
+	for (const auto& poolsOfType : m_pools)
+		for (const Pool& pool : poolsOfType)
+			bytes += pool.blocks.GetReservedBytes();
+	return bytes;
+}
+
+ID3D12Pageable* GpuMemoryAllocator::GetPageable(ID3D12Resource* resource) const
+{
+	auto it = m_allocations.find(resource);
+	if (it != m_allocations.end() && it->second.pool != nullptr)
+		return it->second.block->heap.Get();
+	return resource;
+}
+
+void GpuMemoryAllocator::NotifyPageable(ID3D12Pageable* pageable, D3D12_HEAP_TYPE heapType, UINT64 size, bool created)
+{
+	if (m_pageableFn != nullptr)
+		m_pageableFn(m_pageableUserData, pageable, heapType, size, created);
+}
@@ -0,0 +1,140 @@
+#pragma once
+#include <d3d12.h>
+#include <wrl/client.h>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "heap_block_list.h"
+
+// gpu memory suballocator
+// instead of one implicit heap per CreateCommittedResource call, resources are placed
+// into large ID3D12Heap blocks and their ranges managed with a TlsfAllocator per block.
+// heaps are split by heap type and by resource kind (buffers / textures / render targets)
+// so it also works on resource heap tier 1 hardware. block selection and release is HeapBlockList.
+// note: d3d12 still requires 64KB placement alignment for buffers, textures up to 64KB
+// get the 4KB small resource alignment when the device allows it
+
+enum GpuMemoryCategory
+{
+	GpuMemoryCategory_Geometry,
+	GpuMemoryCategory_Constants,
+	GpuMemoryCategory_Textures,
+	GpuMemoryCategory_Upload,
+	GpuMemoryCategory_UserInterface,
+	GpuMemoryCategory_Count
+};
+
+const char* GetGpuMemoryCategoryName(GpuMemoryCategory category);
+
+struct GpuMemoryStats
+{
+	UINT allocationCount = 0;
+	UINT64 requestedBytes = 0; // what the resources asked for
+	UINT64 allocatedBytes = 0; // what they occupy in the heaps including alignment
+};
+
+class GpuMemoryAllocator
+{
+public:
+	static const UINT64 DefaultBlockSize = 16 * 1024 * 1024;
+
+	void Init(ID3D12Device* device, UINT64 blockSize = DefaultBlockSize);
+	// all resources must have been released before
+	void Shutdown();
+
+	// same contract as CreateCommittedResource, the caller owns the returned reference
+	// but must give it back through ReleaseResource instead of calling Release itself.
+	// resources too large for a block or with unusual heap/alignment needs fall back to committed resources
+	HRESULT CreateResource(GpuMemoryCategory category, const D3D12_HEAP_PROPERTIES* heapProps, const D3D12_RESOURCE_DESC* desc,
+		D3D12_RESOURCE_STATES initialState, ID3D12Resource** outResource);
+	// the gpu must be done with the resource, its range is reused right away
+	void ReleaseResource(ID3D12Resource* resource);
+
+	// defragmentation hook
+	// allocations living in blocks that are less than maxBlockUsage full get a new placed resource
+	// in a fuller block. moveFn has to copy the contents, wait for the copy to finish and swap every
+	// reference from oldResource to newResource, then return true. returning false keeps the allocation.
+	// returns the number of moved resources, blocks emptied this way are released
+	typedef bool (*MoveFn)(void* userData, ID3D12Resource* oldResource, ID3D12Resource* newResource);
+	UINT Defragment(MoveFn moveFn, void* userData, float maxBlockUsage = 0.25f);
+	// frees all blocks that have no allocations left
+	void ReleaseEmptyBlocks();
+	// how many empty blocks each pool keeps for reuse, others are released as soon as they empty
+	void SetMaxEmptyBlocks(UINT maxEmptyBlocks);
+
+	// placed render targets and depth stencils start out with undefined contents, d3d12 requires
+	// a discard, clear or full copy before anything else uses them. they are created in the
+	// render target / depth write state, this records the pending DiscardResource calls and the
+	// transitions to the requested initial states. call it before recording anything that uses them
+	void RecordPendingDiscards(ID3D12GraphicsCommandList* commandList);
+
+	// residency hook, called after a heap block or committed resource was created (created = true)
+	// and right before one is destroyed. pageable is what has to be evicted / made resident
+	typedef void (*PageableFn)(void* userData, ID3D12Pageable* pageable, D3D12_HEAP_TYPE heapType, UINT64 size, bool created);
+	void SetPageableCallback(PageableFn pageableFn, void* userData) { m_pageableFn = pageableFn; m_pageableUserData = userData; }
+	// the heap a placed resource lives in, or the resource itself when it is committed
+	ID3D12Pageable* GetPageable(ID3D12Resource* resource) const;
+
+	const GpuMemoryStats& GetCategoryStats(GpuMemoryCategory category) const { return m_stats[category]; }
+	UINT GetBlockCount() const;
+	UINT64 GetReservedBytes() const; // heap memory owned by the allocator
+	UINT64 GetCommittedBytes() const { return m_committedBytes; } // fallback allocations
+
+private:
+	enum PoolKind
+	{
+		PoolKind_Buffers,
+		PoolKind_Textures,
+		PoolKind_RenderTargets,
+		PoolKind_Count
+	};
+	enum { PoolHeapTypeCount = 3 }; // default, upload, readback
+
+	typedef HeapBlockList<Microsoft::WRL::ComPtr<ID3D12Heap>> BlockList;
+	typedef BlockList::Block Block;
+	struct Pool
+	{
+		D3D12_HEAP_TYPE heapType;
+		D3D12_HEAP_FLAGS heapFlags;
+		BlockList blocks;
+	};
+	struct Allocation
+	{
+		Pool* pool; // null for committed fallbacks
+		Block* block;
+		TlsfAllocator::Handle handle;
+		GpuMemoryCategory category;
+		UINT64 requestedBytes;
+		UINT64 allocatedBytes;
+		D3D12_RESOURCE_STATES state;
+		D3D12_HEAP_TYPE heapType;
+	};
+	struct PendingDiscard
+	{
+		ID3D12Resource* resource;
+		D3D12_RESOURCE_STATES discardState; // what it was created in
+		D3D12_RESOURCE_STATES state; // what the caller asked for
+	};
+
+	Pool* FindPool(const D3D12_HEAP_PROPERTIES* heapProps, const D3D12_RESOURCE_DESC* desc);
+	Block* AddBlock(Pool* pool, UINT64 minSize);
+	// sourceBlock is set when defragmenting, the resource then has to land in another block that is at least minTargetUsage full
+	// and a failed placement never releases a block (Defragment() releases the empty ones when it is done)
+	HRESULT PlaceResource(Pool* pool, const Block* sourceBlock, float minTargetUsage, const D3D12_RESOURCE_DESC* desc,
+		const D3D12_RESOURCE_ALLOCATION_INFO& info, D3D12_RESOURCE_STATES state, ID3D12Resource** outResource, Allocation& allocation);
+	void FreeAllocation(const Allocation& allocation);
+	void ReleaseBlock(Pool* pool, Block& block);
+	// not discarded yet, so its contents can't be copied by Defragment
+	bool HasPendingDiscard(ID3D12Resource* resource) const;
+	void NotifyPageable(ID3D12Pageable* pageable, D3D12_HEAP_TYPE heapType, UINT64 size, bool created);
+
+	ID3D12Device* m_device = nullptr;
+	UINT64 m_blockSize = DefaultBlockSize;
+	Pool m_pools[PoolHeapTypeCount][PoolKind_Count];
+	std::unordered_map<ID3D12Resource*, Allocation> m_allocations;
+	std::vector<PendingDiscard> m_pendingDiscards;
+	GpuMemoryStats m_stats[GpuMemoryCategory_Count];
+	UINT64 m_committedBytes = 0;
+	PageableFn m_pageableFn = nullptr;
+	void* m_pageableUserData = nullptr;
+};
@@ -0,0 +1,115 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "tlsf_allocator.h"
+
+// the blocks of one gpu memory pool, each a heap whose range is managed by a TlsfAllocator.
+// decides which block an allocation goes into and which empty blocks get released.
+// the heap is opaque (ComPtr<ID3D12Heap> in gpu_memory.h), creating and destroying it is
+// up to the caller, so this has no d3d12/windows dependencies and can be tested on its own
+//
+// empty blocks are released as soon as they become empty, except for up to maxEmptyBlocks
+// of them which are kept so a resource created and released every frame does not create
+// and destroy a heap every frame
+
+template<typename Heap>
+class HeapBlockList
+{
+public:
+	struct Block
+	{
+		Block(Heap heapIn, uint64_t size, uint64_t granularity) : heap(std::move(heapIn)), allocator(size, granularity) {}
+
+		Heap heap;
+		TlsfAllocator allocator;
+	};
+
+	explicit HeapBlockList(uint64_t granularity = 256, uint32_t maxEmptyBlocks = 1)
+		: m_granularity(granularity), m_maxEmptyBlocks(maxEmptyBlocks) {}
+
+	// finds room in an existing block, null when none has any. when moving an allocation out of
+	// sourceBlock (defragmentation) that block is skipped, as are blocks less than minTargetUsage
+	// full, so allocations are only packed into well used blocks and never move back and forth
+	Block* Allocate(uint64_t size, uint64_t alignment, const Block* sourceBlock, float minTargetUsage, TlsfAllocator::Handle& outHandle)
+	{
+		for (const std::unique_ptr<Block>& block : m_blocks)
+		{
+			if (block.get() == sourceBlock)
+				continue;
+			if (sourceBlock != nullptr && (float)block->allocator.GetUsedSize() < minTargetUsage * (float)block->allocator.GetCapacity())
+				continue;
+			outHandle = block->allocator.Allocate(size, alignment);
+			if (outHandle != TlsfAllocator::InvalidHandle)
+				return block.get();
+		}
+		outHandle = TlsfAllocator::InvalidHandle;
+		return nullptr;
+	}
+
+	// takes over a heap of 'size' bytes the caller just created
+	Block* AddBlock(Heap heap, uint64_t size)
+	{
+		m_blocks.emplace_back(new Block(std::move(heap), size, m_granularity));
+		return m_blocks.back().get();
+	}
+
+	// frees an allocation. when that empties its block and more than maxEmptyBlocks blocks are
+	// empty, the block is passed to releaseFn(Block&) and removed
+	template<typename ReleaseFn>
+	void Free(Block* block, TlsfAllocator::Handle handle, ReleaseFn releaseFn)
+	{
+		block->allocator.Free(handle);
+		if (!block->allocator.IsEmpty() || GetEmptyBlockCount() <= m_maxEmptyBlocks)
+			return;
+		for (size_t i = 0; i < m_blocks.size(); i++)
+			if (m_blocks[i].get() == block)
+			{
+				releaseFn(*block);
+				m_blocks.erase(m_blocks.begin() + i);
+				return;
+			}
+	}
+
+	// releases empty blocks until at most 'keep' are left
+	template<typename ReleaseFn>
+	void ReleaseEmptyBlocks(uint32_t keep, ReleaseFn releaseFn)
+	{
+		uint32_t empty = GetEmptyBlockCount();
+		for (size_t i = m_blocks.size(); i-- > 0 && empty > keep;)
+		{
+			if (!m_blocks[i]->allocator.IsEmpty())
+				continue;
+			releaseFn(*m_blocks[i]);
+			m_blocks.erase(m_blocks.begin() + i);
+			empty--;
+		}
+	}
+
+	void SetMaxEmptyBlocks(uint32_t maxEmptyBlocks) { m_maxEmptyBlocks = maxEmptyBlocks; }
+	uint32_t GetMaxEmptyBlocks() const { return m_maxEmptyBlocks; }
+	uint64_t GetGranularity() const { return m_granularity; }
+
+	const std::vector<std::unique_ptr<Block>>& GetBlocks() const { return m_blocks; }
+	size_t GetBlockCount() const { return m_blocks.size(); }
+	uint32_t GetEmptyBlockCount() const
+	{
+		uint32_t count = 0;
+		for (const std::unique_ptr<Block>& block : m_blocks)
+			count += block->allocator.IsEmpty() ? 1 : 0;
+		return count;
+	}
+	uint64_t GetReservedBytes() const
+	{
+		uint64_t bytes = 0;
+		for (const std::unique_ptr<Block>& block : m_blocks)
+			bytes += block->allocator.GetCapacity();
+		return bytes;
+	}
+
+private:
+	uint64_t m_granularity;
+	uint32_t m_maxEmptyBlocks;
+	std::vector<std::unique_ptr<Block>> m_blocks;
+};
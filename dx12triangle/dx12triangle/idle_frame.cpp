@@ -0,0 +1,97 @@
+#include "idle_frame.h"
+#include "ImGui/imgui.h"
+#include <cstring>
+
+static const uint64_t FnvPrime = 0x100000001b3ull;
+
+uint64_t HashBytes(const void* data, size_t size, uint64_t seed)
+{
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+	uint64_t hash = seed;
+
+	// 8 bytes per step, memcpy keeps unaligned loads legal
+	while (size >= sizeof(uint64_t))
+	{
+		uint64_t word;
+		memcpy(&word, bytes, sizeof(word));
+		hash = (hash ^ word) * FnvPrime;
+		hash ^= hash >> 32;
+		bytes += sizeof(word);
+		size -= sizeof(word);
+	}
+	while (size > 0)
+	{
+		hash = (hash ^ *bytes) * FnvPrime;
+		bytes++;
+		size--;
+	}
+	return hash;
+}
+
+template<typename T>
+static uint64_t HashValue(const T& value, uint64_t seed)
+{
+	return HashBytes(&value, sizeof(value), seed);
+}
+
+uint64_t HashDrawData(const ImDrawData* drawData, uint64_t seed)
+{
+	uint64_t hash = seed;
+	if (drawData == nullptr || !drawData->Valid)
+		return hash;
+
+	hash = HashValue(drawData->DisplayPos, hash);
+	hash = HashValue(drawData->DisplaySize, hash);
+	hash = HashValue(drawData->FramebufferScale, hash);
+	hash = HashValue(drawData->CmdLists.Size, hash);
+
+	for (const ImDrawList* drawList : drawData->CmdLists)
+	{
+		hash = HashValue(drawList->VtxBuffer.Size, hash);
+		hash = HashBytes(drawList->VtxBuffer.Data, drawList->VtxBuffer.size_in_bytes(), hash);
+		hash = HashValue(drawList->IdxBuffer.Size, hash);
+		hash = HashBytes(drawList->IdxBuffer.Data, drawList->IdxBuffer.size_in_bytes(), hash);
+		hash = HashValue(drawList->GlyphBuffer.Size, hash);
+		hash = HashBytes(drawList->GlyphBuffer.Data, drawList->GlyphBuffer.size_in_bytes(), hash);
+
+		// field by field, ImDrawCmd has padding that copies don't have to preserve
+		for (const ImDrawCmd& cmd : drawList->CmdBuffer)
+		{
+			hash = HashValue(cmd.ClipRect, hash);
+			hash = HashValue(cmd.TexRef._TexData, hash);
+			hash = HashValue(cmd.TexRef._TexID, hash);
+			hash = HashValue(cmd.VtxOffset, hash);
+			hash = HashValue(cmd.IdxOffset, hash);
+			hash = HashValue(cmd.ElemCount, hash);
+			hash = HashValue(cmd.GlyphOffset, hash);
+			hash = HashValue(cmd.GlyphCount, hash);
+			hash = HashValue(cmd.UserCallback, hash);
+			hash = HashValue(cmd.UserCallbackData, hash);
+		}
+	}
+	return hash;
+}
+
+bool DrawDataHasPendingTextures(const ImDrawData* drawData)
+{
+	if (drawData == nullptr || drawData->Textures == nullptr)
+		return false;
+	for (const ImTextureData* tex : *drawData->Textures)
+		if (tex->Status != ImTextureStatus_OK)
+			return true;
+	return false;
+}
+
+bool IdleFrameDetector::ShouldPresent(uint64_t frameHash, bool forcePresent)
+{
+	if (enabled && !forcePresent && hasLastHash && frameHash == lastHash)
+	{
+		skippedFrames++;
+		return false;
+	}
+
+	lastHash = frameHash;
+	hasLastHash = true;
+	presentedFrames++;
+	return true;
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+// idle frame detection
+// hashes everything that would end up on screen and lets the main loop skip
+// command recording and Present() when a frame is identical to the last presented one.
+// no d3d12/windows dependencies so it can be compiled and tested on its own
+
+struct ImDrawData;
+
+// word-at-a-time FNV-1a style hash, pass the previous result as seed to chain blocks
+uint64_t HashBytes(const void* data, size_t size, uint64_t seed);
+
+// hashes display rect, vertices, indices and draw commands of every draw list
+uint64_t HashDrawData(const ImDrawData* drawData, uint64_t seed);
+
+// true if imgui still wants the renderer to create/update/destroy a texture,
+// those requests are only serviced while rendering so such a frame must not be skipped
+bool DrawDataHasPendingTextures(const ImDrawData* drawData);
+
+const uint64_t FrameHashSeed = 0xcbf29ce484222325ull; // FNV offset basis
+
+struct IdleFrameDetector
+{
+	bool enabled = true;
+	bool hasLastHash = false;
+	uint64_t lastHash = 0;
+	uint64_t presentedFrames = 0;
+	uint64_t skippedFrames = 0;
+
+	// returns true when the frame has to be rendered and presented, false when it can be skipped
+	bool ShouldPresent(uint64_t frameHash, bool forcePresent);
+
+	// forget the last presented frame, e.g. after a resize or device reset
+	void Invalidate() { hasLastHash = false; }
+};
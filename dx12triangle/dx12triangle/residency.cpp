@@ -0,0 +1,99 @@
+#include "residency.h"
+#include <cassert>
+
+// evict a bit below the budget so we don't end up evicting something every frame
+static const double EvictionTargetFraction = 0.9;
+// objects used within the last few fence values are the working set, evicting them
+// would only bring them back next frame
+static const UINT64 MinIdleFences = 3;
+
+bool ResidencyManager::Init(ID3D12Device* device, IDXGIAdapter3* adapter)
+{
+	m_device = device;
+	m_adapter = adapter;
+	return m_adapter != nullptr;
+}
+
+void ResidencyManager::Shutdown()
+{
+	assert(m_handles.empty() && "untrack all pageables before shutting down the residency manager");
+	m_pendingResident.clear();
+	m_adapter.Reset();
+	m_device.Reset();
+}
+
+void ResidencyManager::Track(ID3D12Pageable* pageable, UINT64 size)
+{
+	assert(m_handles.find(pageable) == m_handles.end() && "pageable is already tracked");
+	ResidencyPolicy::Handle handle = m_policy.Add(size);
+	if (handle >= m_pageables.size())
+		m_pageables.resize(handle + 1);
+	m_pageables[handle] = pageable;
+	m_handles[pageable] = handle;
+}
+
+void ResidencyManager::Untrack(ID3D12Pageable* pageable)
+{
+	auto it = m_handles.find(pageable);
+	if (it == m_handles.end())
+		return;
+	m_policy.Remove(it->second);
+	m_pageables[it->second] = nullptr;
+	m_handles.erase(it);
+	for (size_t i = 0; i < m_pendingResident.size(); i++)
+		if (m_pendingResident[i] == pageable)
+		{
+			m_pendingResident.erase(m_pendingResident.begin() + i);
+			break;
+		}
+}
+
+void ResidencyManager::MarkUsed(ID3D12Pageable* pageable, UINT64 fenceValue)
+{
+	auto it = m_handles.find(pageable);
+	if (it == m_handles.end())
+		return;
+	if (m_policy.MarkUsed(it->second, fenceValue))
+		m_pendingResident.push_back(pageable);
+}
+
+HRESULT ResidencyManager::MakePendingResident()
+{
+	if (m_pendingResident.empty())
+		return S_OK;
+	HRESULT hr = m_device->MakeResident((UINT)m_pendingResident.size(), m_pendingResident.data());
+	m_pendingResident.clear();
+	return hr;
+}
+
+UINT64 ResidencyManager::GetBudget() const
+{
+	if (m_budgetLimit != 0 && m_budgetLimit < m_localInfo.Budget)
+		return m_budgetLimit;
+	return m_localInfo.Budget;
+}
+
+void ResidencyManager::Update(UINT64 completedFenceValue)
+{
+	if (m_adapter == nullptr)
+		return;
+	m_adapter->QueryVideoMemoryInfo(0, DXGI_MEMORY_SEGMENT_GROUP_LOCAL, &m_localInfo);
+	m_adapter->QueryVideoMemoryInfo(0, DXGI_MEMORY_SEGMENT_GROUP_NON_LOCAL, &m_nonLocalInfo);
+
+	// usage covers the whole process (swap chain, driver allocations), we can only
+	// take it down by what we track
+	const UINT64 budget = GetBudget();
+	if (m_localInfo.CurrentUsage <= budget)
+		return;
+
+	m_evictHandles.clear();
+	const UINT64 evictableFence = completedFenceValue > MinIdleFences ? completedFenceValue - MinIdleFences : 0;
+	m_policy.SelectEvictions(m_localInfo.CurrentUsage, (UINT64)(budget * EvictionTargetFraction), evictableFence, m_evictHandles);
+	if (m_evictHandles.empty())
+		return;
+
+	m_evictPageables.clear();
+	for (ResidencyPolicy::Handle handle : m_evictHandles)
+		m_evictPageables.push_back(m_pageables[handle]);
+	m_device->Evict((UINT)m_evictPageables.size(), m_evictPageables.data());
+}
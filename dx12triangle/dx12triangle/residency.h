@@ -0,0 +1,57 @@
+#pragma once
+#include <d3d12.h>
+#include <dxgi1_6.h>
+#include <wrl/client.h>
+#include <unordered_map>
+#include <vector>
+#include "residency_policy.h"
+
+// video memory residency manager
+// polls the local segment budget with IDXGIAdapter3::QueryVideoMemoryInfo and evicts the
+// least recently used tracked heaps/resources when the process goes over it. evicted
+// objects are made resident again when they get used. the policy itself is ResidencyPolicy.
+//
+// per frame: MarkUsed for everything the frame touches, MakePendingResident before
+// ExecuteCommandLists, Update with the completed fence value once the frame is submitted
+
+class ResidencyManager
+{
+public:
+	bool Init(ID3D12Device* device, IDXGIAdapter3* adapter);
+	void Shutdown();
+
+	// pageable objects we are allowed to evict, they must stay alive until Untrack
+	void Track(ID3D12Pageable* pageable, UINT64 size);
+	void Untrack(ID3D12Pageable* pageable);
+
+	// fenceValue is the value the queue signals once the work using the object is done.
+	// untracked objects are ignored
+	void MarkUsed(ID3D12Pageable* pageable, UINT64 fenceValue);
+	// brings back everything MarkUsed found evicted, blocks until the memory is resident
+	HRESULT MakePendingResident();
+
+	// refreshes the budget and evicts when over it
+	void Update(UINT64 completedFenceValue);
+
+	// caps the budget below what the os grants, 0 uses the os budget. handy to test eviction
+	void SetBudgetLimit(UINT64 bytes) { m_budgetLimit = bytes; }
+	UINT64 GetBudgetLimit() const { return m_budgetLimit; }
+	UINT64 GetBudget() const; // effective budget
+	const DXGI_QUERY_VIDEO_MEMORY_INFO& GetLocalMemoryInfo() const { return m_localInfo; }
+	const DXGI_QUERY_VIDEO_MEMORY_INFO& GetNonLocalMemoryInfo() const { return m_nonLocalInfo; }
+	const ResidencyPolicy& GetPolicy() const { return m_policy; }
+
+private:
+	Microsoft::WRL::ComPtr<ID3D12Device> m_device;
+	Microsoft::WRL::ComPtr<IDXGIAdapter3> m_adapter;
+	ResidencyPolicy m_policy;
+	std::unordered_map<ID3D12Pageable*, ResidencyPolicy::Handle> m_handles;
+	std::vector<ID3D12Pageable*> m_pageables; // indexed by policy handle
+	std::vector<ID3D12Pageable*> m_pendingResident;
+	std::vector<ResidencyPolicy::Handle> m_evictHandles; // scratch
+	std::vector<ID3D12Pageable*> m_evictPageables; // scratch
+
+	DXGI_QUERY_VIDEO_MEMORY_INFO m_localInfo = {};
+	DXGI_QUERY_VIDEO_MEMORY_INFO m_nonLocalInfo = {};
+	UINT64 m_budgetLimit = 0;
+};
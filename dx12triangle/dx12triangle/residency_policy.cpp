@@ -0,0 +1,166 @@
+#include "residency_policy.h"
+#include <cassert>
+
+ResidencyPolicy::Handle ResidencyPolicy::Add(uint64_t size)
+{
+	uint32_t object;
+	if (!m_unusedObjects.empty())
+	{
+		object = m_unusedObjects.back();
+		m_unusedObjects.pop_back();
+	}
+	else
+	{
+		object = (uint32_t)m_objects.size();
+		m_objects.push_back(Object());
+	}
+	m_objects[object] = { size, 0, NullObject, NullObject, true, true };
+
+	// never used, so it is the first eviction candidate
+	Object& o = m_objects[object];
+	o.next = m_lruHead;
+	if (m_lruHead != NullObject)
+		m_objects[m_lruHead].prev = object;
+	else
+		m_lruTail = object;
+	m_lruHead = object;
+
+	m_residentBytes += size;
+	m_residentCount++;
+	return object;
+}
+
+void ResidencyPolicy::Remove(Handle handle)
+{
+	assert(handle < m_objects.size() && m_objects[handle].alive && "invalid residency handle");
+	Object& o = m_objects[handle];
+	if (o.resident)
+	{
+		Unlink(handle);
+		m_residentBytes -= o.size;
+		m_residentCount--;
+	}
+	else
+	{
+		m_evictedBytes -= o.size;
+		m_evictedCount--;
+	}
+	o.alive = false;
+	m_unusedObjects.push_back(handle);
+}
+
+bool ResidencyPolicy::MarkUsed(Handle handle, uint64_t fenceValue)
+{
+	assert(handle < m_objects.size() && m_objects[handle].alive && "invalid residency handle");
+	Object& o = m_objects[handle];
+	assert(fenceValue >= o.lastUsedFence && "fence values must not go backwards");
+	o.lastUsedFence = fenceValue;
+
+	bool wasEvicted = !o.resident;
+	if (wasEvicted)
+	{
+		o.resident = true;
+		m_evictedBytes -= o.size;
+		m_evictedCount--;
+		m_residentBytes += o.size;
+		m_residentCount++;
+		m_totalMakeResidents++;
+	}
+	else
+	{
+		if (m_lruTail == handle)
+			return false;
+		Unlink(handle);
+	}
+	LinkBack(handle);
+	return wasEvicted;
+}
+
+uint64_t ResidencyPolicy::SelectEvictions(uint64_t currentUsage, uint64_t targetUsage, uint64_t completedFenceValue, std::vector<Handle>& outEvicted)
+{
+	// the list is ordered by last use, so the first object still in flight ends the search
+	uint64_t freed = 0;
+	while (currentUsage > targetUsage + freed && m_lruHead != NullObject)
+	{
+		uint32_t object = m_lruHead;
+		Object& o = m_objects[object];
+		if (o.lastUsedFence > completedFenceValue)
+			break;
+
+		Unlink(object);
+		o.resident = false;
+		m_residentBytes -= o.size;
+		m_residentCount--;
+		m_evictedBytes += o.size;
+		m_evictedCount++;
+		m_totalEvictions++;
+		freed += o.size;
+		outEvicted.push_back(object);
+	}
+	return freed;
+}
+
+void ResidencyPolicy::LinkBack(uint32_t object)
+{
+	Object& o = m_objects[object];
+	o.prev = m_lruTail;
+	o.next = NullObject;
+	if (m_lruTail != NullObject)
+		m_objects[m_lruTail].next = object;
+	else
+		m_lruHead = object;
+	m_lruTail = object;
+}
+
+void ResidencyPolicy::Unlink(uint32_t object)
+{
+	Object& o = m_objects[object];
+	if (o.prev != NullObject)
+		m_objects[o.prev].next = o.next;
+	else
+		m_lruHead = o.next;
+	if (o.next != NullObject)
+		m_objects[o.next].prev = o.prev;
+	else
+		m_lruTail = o.prev;
+	o.prev = NullObject;
+	o.next = NullObject;
+}
+
+bool ResidencyPolicy::Validate() const
+{
+	uint64_t residentBytes = 0;
+	uint32_t residentCount = 0;
+	uint64_t lastFence = 0;
+	uint32_t prev = NullObject;
+	for (uint32_t object = m_lruHead; object != NullObject; object = m_objects[object].next)
+	{
+		const Object& o = m_objects[object];
+		if (!o.alive || !o.resident || o.prev != prev || o.lastUsedFence < lastFence)
+			return false;
+		if (residentCount > m_objects.size())
+			return false; // cycle
+		lastFence = o.lastUsedFence;
+		residentBytes += o.size;
+		residentCount++;
+		prev = object;
+	}
+	if (prev != m_lruTail || residentBytes != m_residentBytes || residentCount != m_residentCount)
+		return false;
+
+	uint64_t evictedBytes = 0;
+	uint32_t evictedCount = 0;
+	uint32_t aliveCount = 0;
+	for (const Object& o : m_objects)
+	{
+		if (!o.alive)
+			continue;
+		aliveCount++;
+		if (!o.resident)
+		{
+			evictedBytes += o.size;
+			evictedCount++;
+		}
+	}
+	return evictedBytes == m_evictedBytes && evictedCount == m_evictedCount && aliveCount == residentCount + evictedCount;
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// least recently used residency policy
+// objects are opaque sizes with the fence value of their last gpu use. resident objects
+// are kept in a list ordered by last use, when the process goes over its budget the
+// oldest ones whose last use has already completed on the gpu are picked for eviction.
+// no d3d12/windows dependencies so it can be compiled and tested on its own
+
+class ResidencyPolicy
+{
+public:
+	typedef uint32_t Handle;
+	static const Handle InvalidHandle = UINT32_MAX;
+
+	// new objects start out resident and unused
+	Handle Add(uint64_t size);
+	void Remove(Handle handle);
+
+	// records a use by gpu work that completes at fenceValue, fence values must not go backwards.
+	// returns true when the object was evicted, it is counted as resident again from here on
+	// and the caller has to make it resident before submitting that work
+	bool MarkUsed(Handle handle, uint64_t fenceValue);
+
+	// picks the least recently used resident objects until currentUsage drops to targetUsage.
+	// objects still in use by the gpu (last use > completedFenceValue) are never picked.
+	// the picked objects are marked evicted and appended to outEvicted, returns the bytes freed
+	uint64_t SelectEvictions(uint64_t currentUsage, uint64_t targetUsage, uint64_t completedFenceValue, std::vector<Handle>& outEvicted);
+
+	uint64_t GetSize(Handle handle) const { return m_objects[handle].size; }
+	bool IsResident(Handle handle) const { return m_objects[handle].resident; }
+	uint64_t GetLastUsedFence(Handle handle) const { return m_objects[handle].lastUsedFence; }
+
+	uint64_t GetResidentBytes() const { return m_residentBytes; }
+	uint64_t GetEvictedBytes() const { return m_evictedBytes; }
+	uint32_t GetResidentCount() const { return m_residentCount; }
+	uint32_t GetEvictedCount() const { return m_evictedCount; }
+	uint64_t GetTotalEvictions() const { return m_totalEvictions; } // since creation
+	uint64_t GetTotalMakeResidents() const { return m_totalMakeResidents; }
+
+	// checks list links, ordering and counters, for tests
+	bool Validate() const;
+
+private:
+	static const uint32_t NullObject = UINT32_MAX;
+
+	struct Object
+	{
+		uint64_t size;
+		uint64_t lastUsedFence;
+		uint32_t prev; // lru links, only valid while resident
+		uint32_t next;
+		bool resident;
+		bool alive;
+	};
+
+	void LinkBack(uint32_t object);
+	void Unlink(uint32_t object);
+
+	std::vector<Object> m_objects;
+	std::vector<uint32_t> m_unusedObjects;
+	uint32_t m_lruHead = NullObject; // least recently used
+	uint32_t m_lruTail = NullObject; // most recently used
+
+	uint64_t m_residentBytes = 0;
+	uint64_t m_evictedBytes = 0;
+	uint32_t m_residentCount = 0;
+	uint32_t m_evictedCount = 0;
+	uint64_t m_totalEvictions = 0;
+	uint64_t m_totalMakeResidents = 0;
+};
@@ -0,0 +1,85 @@
+#include "root_layout.h"
+
+static uint32_t ParamDwordCost(const RootParam& param)
+{
+	switch (param.kind)
+	{
+	case RootParamKind_Constants: return param.count;
+	case RootParamKind_Cbv: return 2;
+	default: return 1;
+	}
+}
+
+uint32_t RootLayout::AddPerDrawData(uint32_t shaderRegister, uint32_t sizeInBytes, RootShaderStage stage, uint32_t registerSpace)
+{
+	// inline when small enough and there is room left, the cbv fallback costs 2 dwords
+	const uint32_t dwords = (sizeInBytes + 3) / 4;
+	if (dwords <= MaxInlineDwords && GetDwordCost() + dwords <= MaxRootDwords)
+		return AddConstants(shaderRegister, dwords, stage, registerSpace);
+	return AddCbv(shaderRegister, stage, registerSpace);
+}
+
+uint32_t RootLayout::AddConstants(uint32_t shaderRegister, uint32_t dwordCount, RootShaderStage stage, uint32_t registerSpace)
+{
+	m_params.push_back({ RootParamKind_Constants, stage, shaderRegister, registerSpace, dwordCount });
+	return (uint32_t)m_params.size() - 1;
+}
+
+uint32_t RootLayout::AddCbv(uint32_t shaderRegister, RootShaderStage stage, uint32_t registerSpace)
+{
+	m_params.push_back({ RootParamKind_Cbv, stage, shaderRegister, registerSpace, 0 });
+	return (uint32_t)m_params.size() - 1;
+}
+
+uint32_t RootLayout::AddSrvTable(uint32_t baseShaderRegister, uint32_t descriptorCount, RootShaderStage stage, uint32_t registerSpace)
+{
+	m_params.push_back({ RootParamKind_SrvTable, stage, baseShaderRegister, registerSpace, descriptorCount });
+	return (uint32_t)m_params.size() - 1;
+}
+
+uint32_t RootLayout::GetDwordCost() const
+{
+	uint32_t cost = 0;
+	for (const RootParam& param : m_params)
+		cost += ParamDwordCost(param);
+	return cost;
+}
+
+// fnv-1a over the fields, not the raw structs so padding never leaks into the hash
+uint64_t RootLayout::Hash() const
+{
+	uint64_t hash = 0xcbf29ce484222325ull;
+	auto mix = [&hash](uint32_t value)
+	{
+		for (int i = 0; i < 4; i++)
+		{
+			hash ^= (value >> (i * 8)) & 0xff;
+			hash *= 0x100000001b3ull;
+		}
+	};
+	mix(m_allowInputLayout ? 1 : 0);
+	mix((uint32_t)m_params.size());
+	for (const RootParam& param : m_params)
+	{
+		mix(param.kind);
+		mix(param.stage);
+		mix(param.shaderRegister);
+		mix(param.registerSpace);
+		mix(param.count);
+	}
+	return hash;
+}
+
+bool RootLayout::operator==(const RootLayout& other) const
+{
+	if (m_allowInputLayout != other.m_allowInputLayout || m_params.size() != other.m_params.size())
+		return false;
+	for (size_t i = 0; i < m_params.size(); i++)
+	{
+		const RootParam& a = m_params[i];
+		const RootParam& b = other.m_params[i];
+		if (a.kind != b.kind || a.stage != b.stage || a.shaderRegister != b.shaderRegister || a.registerSpace != b.registerSpace || a.count != b.count)
+			return false;
+	}
+	return true;
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// root signature layout builder
+// describes root parameters without any d3d12 types so layouts can be built, hashed and
+// cached on their own, root_signature.h turns them into ID3D12RootSignature objects.
+//
+// per-draw data is routed automatically: payloads up to MaxInlineDwords go in as 32 bit
+// root constants (set straight on the command list, no buffer write, no address), larger
+// ones or ones that would blow the 64 dword root signature limit become a root cbv.
+
+enum RootShaderStage
+{
+	RootShaderStage_All,
+	RootShaderStage_Vertex,
+	RootShaderStage_Pixel
+};
+
+enum RootParamKind
+{
+	RootParamKind_Constants, // 32 bit root constants, 1 dword each
+	RootParamKind_Cbv,       // root descriptor, 2 dwords
+	RootParamKind_SrvTable   // descriptor table, 1 dword
+};
+
+struct RootParam
+{
+	RootParamKind kind;
+	RootShaderStage stage;
+	uint32_t shaderRegister;
+	uint32_t registerSpace;
+	uint32_t count; // dwords for constants, descriptors for tables, unused for cbvs
+};
+
+class RootLayout
+{
+public:
+	static const uint32_t MaxRootDwords = 64;    // d3d12 root signature limit
+	static const uint32_t MaxInlineDwords = 16;  // a 4x4 matrix, above that a cbv is cheaper to update
+
+	// each Add returns the root parameter index
+	// per-draw data of sizeInBytes bound at register b<shaderRegister>, constants or cbv by size
+	uint32_t AddPerDrawData(uint32_t shaderRegister, uint32_t sizeInBytes, RootShaderStage stage, uint32_t registerSpace = 0);
+	uint32_t AddConstants(uint32_t shaderRegister, uint32_t dwordCount, RootShaderStage stage, uint32_t registerSpace = 0);
+	uint32_t AddCbv(uint32_t shaderRegister, RootShaderStage stage, uint32_t registerSpace = 0);
+	uint32_t AddSrvTable(uint32_t baseShaderRegister, uint32_t descriptorCount, RootShaderStage stage, uint32_t registerSpace = 0);
+
+	void SetAllowInputLayout(bool allow) { m_allowInputLayout = allow; }
+	bool GetAllowInputLayout() const { return m_allowInputLayout; }
+
+	const std::vector<RootParam>& GetParams() const { return m_params; }
+	uint32_t GetDwordCost() const; // total root signature size in dwords
+	bool IsValid() const { return GetDwordCost() <= MaxRootDwords; }
+
+	uint64_t Hash() const;
+	bool operator==(const RootLayout& other) const;
+
+private:
+	std::vector<RootParam> m_params;
+	bool m_allowInputLayout = true;
+};
+
+// cache of objects created from layouts, keyed by layout hash. colliding layouts are told
+// apart by comparing them, so the hash only has to be fast, not perfect.
+// Object is ComPtr<ID3D12RootSignature> in the app, anything copyable works
+template<typename Object>
+class RootLayoutCache
+{
+public:
+	// returns the cached object for an equal layout, or stores create(layout).
+	// the reference is only valid until the next GetOrCreate
+	template<typename CreateFn>
+	const Object& GetOrCreate(const RootLayout& layout, CreateFn create)
+	{
+		std::vector<Entry>& bucket = m_entries[layout.Hash()];
+		for (const Entry& entry : bucket)
+			if (entry.first == layout)
+			{
+				m_hits++;
+				return entry.second;
+			}
+		m_misses++;
+		bucket.emplace_back(layout, create(layout));
+		m_size++;
+		return bucket.back().second;
+	}
+
+	void Clear() { m_entries.clear(); m_size = 0; }
+	size_t GetSize() const { return m_size; }
+	uint64_t GetHits() const { return m_hits; }
+	uint64_t GetMisses() const { return m_misses; }
+
+private:
+	typedef std::pair<RootLayout, Object> Entry;
+	std::unordered_map<uint64_t, std::vector<Entry>> m_entries;
+	size_t m_size = 0;
+	uint64_t m_hits = 0;
+	uint64_t m_misses = 0;
+};
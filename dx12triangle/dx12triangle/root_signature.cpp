@@ -0,0 +1,111 @@
+#include "root_signature.h"
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+static D3D12_SHADER_VISIBILITY ToVisibility(RootShaderStage stage)
+{
+	switch (stage)
+	{
+	case RootShaderStage_Vertex: return D3D12_SHADER_VISIBILITY_VERTEX;
+	case RootShaderStage_Pixel: return D3D12_SHADER_VISIBILITY_PIXEL;
+	default: return D3D12_SHADER_VISIBILITY_ALL;
+	}
+}
+
+HRESULT CreateRootSignature(ID3D12Device* device, const RootLayout& layout, ID3D12RootSignature** outRootSignature)
+{
+	if (!layout.IsValid())
+		return E_INVALIDARG;
+
+	const std::vector<RootParam>& params = layout.GetParams();
+	std::vector<D3D12_ROOT_PARAMETER> rootParameters(params.size());
+	std::vector<D3D12_DESCRIPTOR_RANGE> ranges(params.size()); // one per table, stays alive until serialized
+	for (size_t i = 0; i < params.size(); i++)
+	{
+		const RootParam& param = params[i];
+		D3D12_ROOT_PARAMETER& rootParameter = rootParameters[i];
+		rootParameter.ShaderVisibility = ToVisibility(param.stage);
+		switch (param.kind)
+		{
+		case RootParamKind_Constants:
+			rootParameter.ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+			rootParameter.Constants.ShaderRegister = param.shaderRegister;
+			rootParameter.Constants.RegisterSpace = param.registerSpace;
+			rootParameter.Constants.Num32BitValues = param.count;
+			break;
+		case RootParamKind_Cbv:
+			rootParameter.ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
+			rootParameter.Descriptor.ShaderRegister = param.shaderRegister;
+			rootParameter.Descriptor.RegisterSpace = param.registerSpace;
+			break;
+		case RootParamKind_SrvTable:
+			ranges[i].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+			ranges[i].NumDescriptors = param.count;
+			ranges[i].BaseShaderRegister = param.shaderRegister;
+			ranges[i].RegisterSpace = param.registerSpace;
+			ranges[i].OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
+			rootParameter.ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+			rootParameter.DescriptorTable.NumDescriptorRanges = 1;
+			rootParameter.DescriptorTable.pDescriptorRanges = &ranges[i];
+			break;
+		}
+	}
+
+	D3D12_ROOT_SIGNATURE_DESC rootSignatureDesc = {};
+	rootSignatureDesc.NumParameters = (UINT)rootParameters.size();
+	rootSignatureDesc.pParameters = rootParameters.data();
+	rootSignatureDesc.Flags = layout.GetAllowInputLayout() ? D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT : D3D12_ROOT_SIGNATURE_FLAG_NONE;
+
+	Microsoft::WRL::ComPtr<ID3DBlob> signature;
+	HRESULT hr = D3D12SerializeRootSignature(&rootSignatureDesc, D3D_ROOT_SIGNATURE_VERSION_1, &signature, nullptr);
+	if (FAILED(hr))
+		return hr;
+	return device->CreateRootSignature(0, signature->GetBufferPointer(), signature->GetBufferSize(), IID_PPV_ARGS(outRootSignature));
+}
+
+ID3D12RootSignature* RootSignatureCache::Get(const RootLayout& layout)
+{
+	return m_cache.GetOrCreate(layout, [this](const RootLayout& newLayout)
+	{
+		Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature;
+		CreateRootSignature(m_device, newLayout, &rootSignature);
+		return rootSignature;
+	}).Get();
+}
+
+void PerDrawConstantRing::Init(ID3D12Resource* buffer, void* cpuStart, UINT64 size)
+{
+	m_ring = ConstantRing(size, D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
+	m_cpuStart = (UINT8*)cpuStart;
+	m_gpuStart = buffer->GetGPUVirtualAddress();
+}
+
+D3D12_GPU_VIRTUAL_ADDRESS PerDrawConstantRing::Push(const void* data, UINT sizeInBytes)
+{
+	const uint64_t offset = m_ring.Allocate(sizeInBytes);
+	if (offset == ConstantRing::InvalidOffset)
+		return 0;
+	memcpy(m_cpuStart + offset, data, sizeInBytes);
+	return m_gpuStart + offset;
+}
+
+bool SetGraphicsPerDrawData(ID3D12GraphicsCommandList* commandList, const RootLayout& layout, UINT index,
+	const void* data, UINT sizeInBytes, PerDrawConstantRing& constantRing)
+{
+	const RootParam& param = layout.GetParams()[index];
+	if (param.kind == RootParamKind_Constants)
+	{
+		assert(sizeInBytes <= param.count * 4 && "per-draw data larger than the root constants");
+		commandList->SetGraphicsRoot32BitConstants(index, (sizeInBytes + 3) / 4, data, 0);
+		return true;
+	}
+
+	assert(param.kind == RootParamKind_Cbv);
+	const D3D12_GPU_VIRTUAL_ADDRESS gpuAddress = constantRing.Push(data, sizeInBytes);
+	assert(gpuAddress != 0 && "per-draw constant ring is full, make it bigger");
+	if (gpuAddress == 0)
+		return false;
+	commandList->SetGraphicsRootConstantBufferView(index, gpuAddress);
+	return true;
+}
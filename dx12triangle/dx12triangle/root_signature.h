@@ -0,0 +1,57 @@
+#pragma once
+#include <d3d12.h>
+#include <wrl/client.h>
+#include "constant_ring.h"
+#include "root_layout.h"
+
+// d3d12 side of root_layout.h
+
+// serializes a layout (root signature 1.0) and creates the root signature
+HRESULT CreateRootSignature(ID3D12Device* device, const RootLayout& layout, ID3D12RootSignature** outRootSignature);
+
+// creates each distinct layout only once
+class RootSignatureCache
+{
+public:
+	void Init(ID3D12Device* device) { m_device = device; }
+	void Shutdown() { m_cache.Clear(); m_device = nullptr; }
+
+	// null if creation failed, the failure is cached too so it is not retried every draw
+	ID3D12RootSignature* Get(const RootLayout& layout);
+	size_t GetSize() const { return m_cache.GetSize(); }
+	uint64_t GetHits() const { return m_cache.GetHits(); }
+	uint64_t GetMisses() const { return m_cache.GetMisses(); }
+
+private:
+	ID3D12Device* m_device = nullptr;
+	RootLayoutCache<Microsoft::WRL::ComPtr<ID3D12RootSignature>> m_cache;
+};
+
+// where per-draw data that ended up as a cbv lives: a persistently mapped upload buffer,
+// every SetGraphicsPerDrawData call gets its own 256 byte aligned slice of it
+class PerDrawConstantRing
+{
+public:
+	void Init(ID3D12Resource* buffer, void* cpuStart, UINT64 size);
+
+	// recycles the slices of frames the gpu is done with, call before recording a frame
+	void BeginFrame(UINT64 completedFenceValue) { m_ring.Retire(completedFenceValue); }
+	// the slices handed out since BeginFrame are read by work that signals fenceValue
+	void EndFrame(UINT64 fenceValue) { m_ring.EndFrame(fenceValue); }
+
+	// copies data into a fresh slice and returns its address, 0 when the ring is full
+	D3D12_GPU_VIRTUAL_ADDRESS Push(const void* data, UINT sizeInBytes);
+
+	const ConstantRing& GetRing() const { return m_ring; }
+
+private:
+	ConstantRing m_ring;
+	UINT8* m_cpuStart = nullptr;
+	D3D12_GPU_VIRTUAL_ADDRESS m_gpuStart = 0;
+};
+
+// binds per-draw data for the parameter at index as the layout decided: root constants are
+// set directly, for a cbv the data goes into a fresh slice of constantRing which is bound.
+// returns false when the ring had no room left and nothing was bound
+bool SetGraphicsPerDrawData(ID3D12GraphicsCommandList* commandList, const RootLayout& layout, UINT index,
+	const void* data, UINT sizeInBytes, PerDrawConstantRing& constantRing);
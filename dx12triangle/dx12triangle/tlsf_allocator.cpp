@@ -0,0 +1,323 @@
+#include "tlsf_allocator.h"
+#include <cassert>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// index of the lowest / highest set bit, value must not be 0
+static int LowestBit(uint64_t value)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, value);
+	return (int)index;
+#else
+	return __builtin_ctzll(value);
+#endif
+}
+
+static int HighestBit(uint64_t value)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanReverse64(&index, value);
+	return (int)index;
+#else
+	return 63 - __builtin_clzll(value);
+#endif
+}
+
+static uint64_t AlignUp(uint64_t value, uint64_t alignment)
+{
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+TlsfAllocator::TlsfAllocator(uint64_t size, uint64_t granularity)
+	: m_granularity(granularity)
+{
+	assert(granularity > 0 && (granularity & (granularity - 1)) == 0 && "granularity must be a power of two");
+	m_granularityLog2 = HighestBit(granularity);
+	m_capacity = size & ~(granularity - 1);
+
+	for (int fl = 0; fl < FlCount; fl++)
+		for (int sl = 0; sl < SlCount; sl++)
+			m_freeLists[fl][sl] = NullNode;
+
+	if (m_capacity == 0)
+		return;
+	uint32_t node = NewNode();
+	m_nodes[node].offset = 0;
+	m_nodes[node].size = m_capacity;
+	m_firstNode = node;
+	InsertFree(node);
+}
+
+// sizes are counted in granularity units, the first SlCount units map 1:1 to buckets of
+// level 0, above that every power of two gets its own level split into SlCount buckets
+void TlsfAllocator::Mapping(uint64_t size, int& fl, int& sl) const
+{
+	uint64_t units = size >> m_granularityLog2;
+	if (units < SlCount)
+	{
+		fl = 0;
+		sl = (int)units;
+		return;
+	}
+	int highest = HighestBit(units);
+	sl = (int)(units >> (highest - SlCountLog2)) - SlCount;
+	fl = highest - SlCountLog2 + 1;
+}
+
+uint32_t TlsfAllocator::FindFreeNode(uint64_t size) const
+{
+	// round up to the next bucket so whatever we find is large enough
+	uint64_t units = size >> m_granularityLog2;
+	if (units >= SlCount)
+		units += (1ull << (HighestBit(units) - SlCountLog2)) - 1;
+	int fl, sl;
+	Mapping(units << m_granularityLog2, fl, sl);
+	if (fl >= FlCount)
+		return NullNode;
+
+	uint32_t slMap = sl < SlCount ? m_slBitmap[fl] & (~0u << sl) : 0;
+	if (slMap == 0)
+	{
+		uint64_t flMap = fl + 1 < FlCount ? m_flBitmap & (~0ull << (fl + 1)) : 0;
+		if (flMap == 0)
+			return NullNode;
+		fl = LowestBit(flMap);
+		slMap = m_slBitmap[fl];
+	}
+	sl = LowestBit(slMap);
+	return m_freeLists[fl][sl];
+}
+
+TlsfAllocator::Handle TlsfAllocator::Allocate(uint64_t size, uint64_t alignment)
+{
+	if (size == 0)
+		size = m_granularity;
+	if (alignment < m_granularity)
+		alignment = m_granularity;
+	assert((alignment & (alignment - 1)) == 0 && "alignment must be a power of two");
+	size = AlignUp(size, m_granularity);
+	if (size > m_capacity)
+		return InvalidHandle;
+
+	// worst case padding in front of the block to reach the alignment
+	const uint64_t searchSize = size + (alignment - m_granularity);
+	uint32_t node = searchSize <= m_capacity ? FindFreeNode(searchSize) : NullNode;
+	if (node == NullNode)
+	{
+		// the rounded search skips the bucket the request falls into, near full
+		// capacity a block in there may still fit so check it the slow way
+		int fl, sl;
+		Mapping(size, fl, sl);
+		for (uint32_t candidate = m_freeLists[fl][sl]; candidate != NullNode; candidate = m_nodes[candidate].nextFree)
+		{
+			const Node& n = m_nodes[candidate];
+			if (AlignUp(n.offset, alignment) - n.offset + size <= n.size)
+			{
+				node = candidate;
+				break;
+			}
+		}
+		if (node == NullNode)
+			return InvalidHandle;
+	}
+	RemoveFree(node);
+
+	// the free neighbours of a free block are always merged into it, so both the
+	// padding in front and the leftover at the back can go straight into the free lists
+	const uint64_t padding = AlignUp(m_nodes[node].offset, alignment) - m_nodes[node].offset;
+	if (padding > 0)
+	{
+		uint32_t aligned = Split(node, padding);
+		InsertFree(node);
+		node = aligned;
+	}
+	if (m_nodes[node].size > size)
+	{
+		uint32_t rest = Split(node, size);
+		InsertFree(rest);
+	}
+
+	m_nodes[node].free = false;
+	m_usedSize += m_nodes[node].size;
+	m_allocationCount++;
+	return node;
+}
+
+void TlsfAllocator::Free(Handle handle)
+{
+	assert(handle < m_nodes.size() && !m_nodes[handle].free && "invalid or double free");
+	uint32_t node = handle;
+	m_nodes[node].free = true;
+	m_usedSize -= m_nodes[node].size;
+	m_allocationCount--;
+
+	uint32_t prev = m_nodes[node].prevPhys;
+	if (prev != NullNode && m_nodes[prev].free)
+	{
+		RemoveFree(prev);
+		Absorb(prev, node);
+		node = prev;
+	}
+	uint32_t next = m_nodes[node].nextPhys;
+	if (next != NullNode && m_nodes[next].free)
+	{
+		RemoveFree(next);
+		Absorb(node, next);
+	}
+	InsertFree(node);
+}
+
+uint64_t TlsfAllocator::GetLargestFreeBlock() const
+{
+	if (m_flBitmap == 0)
+		return 0;
+	int fl = HighestBit(m_flBitmap);
+	int sl = HighestBit(m_slBitmap[fl]);
+	uint64_t largest = 0;
+	for (uint32_t node = m_freeLists[fl][sl]; node != NullNode; node = m_nodes[node].nextFree)
+		if (m_nodes[node].size > largest)
+			largest = m_nodes[node].size;
+	return largest;
+}
+
+void TlsfAllocator::InsertFree(uint32_t node)
+{
+	int fl, sl;
+	Mapping(m_nodes[node].size, fl, sl);
+	uint32_t head = m_freeLists[fl][sl];
+	m_nodes[node].free = true;
+	m_nodes[node].prevFree = NullNode;
+	m_nodes[node].nextFree = head;
+	if (head != NullNode)
+		m_nodes[head].prevFree = node;
+	m_freeLists[fl][sl] = node;
+	m_flBitmap |= 1ull << fl;
+	m_slBitmap[fl] |= 1u << sl;
+	m_freeBlockCount++;
+}
+
+void TlsfAllocator::RemoveFree(uint32_t node)
+{
+	int fl, sl;
+	Mapping(m_nodes[node].size, fl, sl);
+	uint32_t prev = m_nodes[node].prevFree;
+	uint32_t next = m_nodes[node].nextFree;
+	if (prev != NullNode)
+		m_nodes[prev].nextFree = next;
+	else
+		m_freeLists[fl][sl] = next;
+	if (next != NullNode)
+		m_nodes[next].prevFree = prev;
+
+	if (m_freeLists[fl][sl] == NullNode)
+	{
+		m_slBitmap[fl] &= ~(1u << sl);
+		if (m_slBitmap[fl] == 0)
+			m_flBitmap &= ~(1ull << fl);
+	}
+	m_freeBlockCount--;
+}
+
+uint32_t TlsfAllocator::NewNode()
+{
+	uint32_t node;
+	if (!m_unusedNodes.empty())
+	{
+		node = m_unusedNodes.back();
+		m_unusedNodes.pop_back();
+	}
+	else
+	{
+		node = (uint32_t)m_nodes.size();
+		m_nodes.push_back(Node());
+	}
+	m_nodes[node] = { 0, 0, NullNode, NullNode, NullNode, NullNode, false };
+	return node;
+}
+
+void TlsfAllocator::DeleteNode(uint32_t node)
+{
+	m_unusedNodes.push_back(node);
+}
+
+uint32_t TlsfAllocator::Split(uint32_t node, uint64_t size)
+{
+	uint32_t rest = NewNode(); // may reallocate m_nodes, don't hold references across this
+	m_nodes[rest].offset = m_nodes[node].offset + size;
+	m_nodes[rest].size = m_nodes[node].size - size;
+	m_nodes[rest].prevPhys = node;
+	m_nodes[rest].nextPhys = m_nodes[node].nextPhys;
+	if (m_nodes[node].nextPhys != NullNode)
+		m_nodes[m_nodes[node].nextPhys].prevPhys = rest;
+	m_nodes[node].nextPhys = rest;
+	m_nodes[node].size = size;
+	return rest;
+}
+
+void TlsfAllocator::Absorb(uint32_t node, uint32_t next)
+{
+	m_nodes[node].size += m_nodes[next].size;
+	m_nodes[node].nextPhys = m_nodes[next].nextPhys;
+	if (m_nodes[next].nextPhys != NullNode)
+		m_nodes[m_nodes[next].nextPhys].prevPhys = node;
+	DeleteNode(next);
+}
+
+bool TlsfAllocator::Validate() const
+{
+	uint64_t expectedOffset = 0;
+	uint64_t usedSize = 0;
+	uint32_t allocationCount = 0;
+	uint32_t freeCount = 0;
+	uint32_t prev = NullNode;
+	for (uint32_t node = m_firstNode; node != NullNode; node = m_nodes[node].nextPhys)
+	{
+		const Node& n = m_nodes[node];
+		if (n.offset != expectedOffset || n.size == 0 || n.prevPhys != prev)
+			return false;
+		if ((n.offset | n.size) & (m_granularity - 1))
+			return false;
+		if (n.free && prev != NullNode && m_nodes[prev].free)
+			return false; // two free neighbours should have been merged
+		if (n.free)
+		{
+			freeCount++;
+		}
+		else
+		{
+			usedSize += n.size;
+			allocationCount++;
+		}
+		expectedOffset += n.size;
+		prev = node;
+	}
+	if (expectedOffset != m_capacity || usedSize != m_usedSize || allocationCount != m_allocationCount)
+		return false;
+
+	uint32_t listedCount = 0;
+	for (int fl = 0; fl < FlCount; fl++)
+	{
+		if (((m_flBitmap >> fl) & 1) != (m_slBitmap[fl] != 0 ? 1u : 0u))
+			return false;
+		for (int sl = 0; sl < SlCount; sl++)
+		{
+			if (((m_slBitmap[fl] >> sl) & 1) != (m_freeLists[fl][sl] != NullNode ? 1u : 0u))
+				return false;
+			uint32_t prevFree = NullNode;
+			for (uint32_t node = m_freeLists[fl][sl]; node != NullNode; node = m_nodes[node].nextFree)
+			{
+				int nodeFl, nodeSl;
+				Mapping(m_nodes[node].size, nodeFl, nodeSl);
+				if (!m_nodes[node].free || nodeFl != fl || nodeSl != sl || m_nodes[node].prevFree != prevFree)
+					return false;
+				prevFree = node;
+				listedCount++;
+			}
+		}
+	}
+	return listedCount == freeCount && freeCount == m_freeBlockCount;
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// two-level segregated fit allocator over an abstract address range
+// it never touches the memory it manages, block headers live in a separate node pool,
+// so it can hand out offsets into gpu heaps. allocate and free are O(1).
+// no d3d12/windows dependencies so it can be compiled and tested on its own
+//
+// first level: power of two size classes, second level: each class split linearly
+// into SlCount buckets. a free block of size s sits in bucket (fl, sl) = Mapping(s),
+// allocation rounds the request up to the next bucket boundary so any block found
+// in a non-empty bucket at or above it is guaranteed to fit.
+
+class TlsfAllocator
+{
+public:
+	typedef uint32_t Handle;
+	static const Handle InvalidHandle = UINT32_MAX;
+
+	// size is the range being managed, granularity the smallest unit (power of two),
+	// every offset and size handed out is a multiple of it
+	explicit TlsfAllocator(uint64_t size, uint64_t granularity = 256);
+
+	// returns InvalidHandle when no free block is large enough
+	Handle Allocate(uint64_t size, uint64_t alignment = 0);
+	void Free(Handle handle);
+
+	uint64_t GetOffset(Handle handle) const { return m_nodes[handle].offset; }
+	uint64_t GetSize(Handle handle) const { return m_nodes[handle].size; }
+
+	uint64_t GetCapacity() const { return m_capacity; }
+	uint64_t GetUsedSize() const { return m_usedSize; }
+	uint64_t GetFreeSize() const { return m_capacity - m_usedSize; }
+	uint32_t GetAllocationCount() const { return m_allocationCount; }
+	uint32_t GetFreeBlockCount() const { return m_freeBlockCount; }
+	uint64_t GetLargestFreeBlock() const;
+	bool IsEmpty() const { return m_allocationCount == 0; }
+
+	// defragmentation hook: visits live allocations in address order,
+	// callers use it to pick allocations to move elsewhere and then Free() them
+	template<typename Fn>
+	void ForEachAllocation(Fn fn) const
+	{
+		for (uint32_t node = m_firstNode; node != NullNode; node = m_nodes[node].nextPhys)
+			if (!m_nodes[node].free)
+				fn(node, m_nodes[node].offset, m_nodes[node].size);
+	}
+
+	// walks every block and checks links, sizes, coalescing and bitmaps, for tests
+	bool Validate() const;
+
+private:
+	static const uint32_t NullNode = UINT32_MAX;
+	static const int SlCountLog2 = 5;
+	static const int SlCount = 1 << SlCountLog2;
+	static const int FlCount = 64;
+
+	struct Node
+	{
+		uint64_t offset;
+		uint64_t size;
+		uint32_t prevPhys;
+		uint32_t nextPhys;
+		uint32_t prevFree;
+		uint32_t nextFree;
+		bool free;
+	};
+
+	void Mapping(uint64_t size, int& fl, int& sl) const;
+	uint32_t FindFreeNode(uint64_t size) const;
+	void InsertFree(uint32_t node);
+	void RemoveFree(uint32_t node);
+	uint32_t NewNode();
+	void DeleteNode(uint32_t node);
+	// cuts 'size' bytes off the front of a node, the remainder becomes a new node that is returned
+	uint32_t Split(uint32_t node, uint64_t size);
+	// folds 'next' into 'node', both must be physically adjacent
+	void Absorb(uint32_t node, uint32_t next);
+
+	uint64_t m_capacity;
+	uint64_t m_granularity;
+	int m_granularityLog2;
+	uint64_t m_usedSize = 0;
+	uint32_t m_allocationCount = 0;
+	uint32_t m_freeBlockCount = 0;
+	uint32_t m_firstNode = NullNode;
+
+	uint64_t m_flBitmap = 0;
+	uint32_t m_slBitmap[FlCount] = {};
+	uint32_t m_freeLists[FlCount][SlCount];
+
+	std::vector<Node> m_nodes;
+	std::vector<uint32_t> m_unusedNodes;
+};
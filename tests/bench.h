@@ -0,0 +1,53 @@
+#pragma once
+#include <chrono>
+#include <cstring>
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+// helpers for the benchmark executables. ctest runs them with --quick to check they
+// still work, the numbers only mean something from a full run of an optimized build
+
+inline bool IsQuickRun(int argc, char** argv)
+{
+	for (int i = 1; i < argc; i++)
+		if (strcmp(argv[i], "--quick") == 0)
+			return true;
+	return false;
+}
+
+class BenchTimer
+{
+public:
+	BenchTimer() : m_start(std::chrono::steady_clock::now()) {}
+	void Restart() { m_start = std::chrono::steady_clock::now(); }
+	double Seconds() const { return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count(); }
+	double Milliseconds() const { return Seconds() * 1000.0; }
+
+private:
+	std::chrono::steady_clock::time_point m_start;
+};
+
+// peak resident set size of the process in MB, 0 where not available
+inline double PeakRssMB()
+{
+#if defined(__linux__)
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss / 1024.0; // KB on linux
+#else
+	return 0.0;
+#endif
+}
+
+// keeps the optimizer from dropping work whose result is never used
+template<typename T>
+inline void DoNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static volatile const T* sink;
+	sink = &value;
+#endif
+}
@@ -0,0 +1,68 @@
+// pixels redrawn with partial redraw vs full frames, and the cost of computing the damage,
+// on a dashboard of static panels with a few live values and a hovered button moving around
+#include "bench.h"
+#include "damage_rects.h"
+#include "imgui_headless.h"
+#include <cstdio>
+
+static void Dashboard(int frame, int panels)
+{
+	for (int p = 0; p < panels; p++)
+	{
+		ImGui::SetNextWindowPos(ImVec2(10.0f + (p % 6) * 210.0f, 10.0f + (p / 6) * 170.0f));
+		ImGui::SetNextWindowSize(ImVec2(200, 160));
+		char name[32];
+		snprintf(name, sizeof(name), "panel %d", p);
+		ImGui::Begin(name);
+		for (int row = 0; row < 6; row++)
+			ImGui::Text("sensor %d.%d: %s", p, row, "nominal");
+		// one live value per panel, only every few panels change each frame
+		ImGui::Text("value: %d", (p % 4 == 0) ? frame / 2 : 42);
+		ImGui::Button("details");
+		ImGui::End();
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const bool quick = IsQuickRun(argc, argv);
+	const int frames = quick ? 30 : 2000;
+	const int panels = 24;
+
+	HeadlessImGui imgui(1280.0f, 720.0f);
+	DamageTracker tracker(2);
+	int64_t redrawPixels = 0, framePixels = 0, presentedDamage = 0;
+	int fullRedraws = 0;
+	double trackMs = 0.0;
+	for (int frame = 0; frame < frames; frame++)
+	{
+		// the mouse wanders over the panels, hovering buttons
+		ImGui::GetIO().AddMousePosEvent((float)((frame * 7) % 1280), (float)((frame * 3) % 720));
+		imgui.NewFrame();
+		Dashboard(frame, panels);
+		ImGui::Render();
+
+		BenchTimer timer;
+		tracker.BeginFrame(1280, 720);
+		tracker.AddDrawData(ImGui::GetDrawData());
+		tracker.EndFrame();
+		trackMs += timer.Milliseconds();
+		HeadlessImGui::ProcessTextures();
+
+		if (frame < 4)
+			continue; // first frames are full redraws by design
+		redrawPixels += tracker.GetRedrawPixels();
+		framePixels += tracker.GetFramePixels();
+		for (const DamageRect& rect : tracker.GetFrameDamage())
+			presentedDamage += rect.Area();
+		fullRedraws += tracker.IsFullRedraw() ? 1 : 0;
+	}
+
+	const int measured = frames - 4;
+	printf("%d frames, %d panels, %d draw lists\n", measured, panels, ImGui::GetDrawData()->CmdListsCount);
+	printf("pixels redrawn: %.1f%% of full frames (%.0f vs %.0f per frame), full redraws: %d\n",
+		100.0 * (double)redrawPixels / (double)framePixels, (double)redrawPixels / measured, (double)framePixels / measured, fullRedraws);
+	printf("damage presented: %.1f%% of the frame on average\n", 100.0 * (double)presentedDamage / (double)framePixels);
+	printf("damage tracking: %.3f ms per frame\n", trackMs / frames);
+	return 0;
+}
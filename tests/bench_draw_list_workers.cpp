@@ -0,0 +1,86 @@
+// ImDrawListWorkers on 1 to N threads (N = hardware threads, at least 4): the worker scene's points
+// (1M, 100K with --quick) drawn straight into the window's draw list, then recorded as 4 slices per
+// thread on a JobPool and appended with Merge() or submitted with AddToDrawData(). ms per frame for
+// recording and merging, best of several frames, and the speedup of record + merge over drawing
+// directly. only meaningful on a machine with that many cores
+#include "bench.h"
+#include "imgui_headless.h"
+#include "job_pool.h"
+#include "worker_scene.h"
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+
+struct Timings
+{
+	double record = 1e9, merge = 1e9;
+	int vertices = 0;
+};
+
+// threads == 0 draws on the imgui thread, without workers
+static Timings Run(int threads, int totalPoints, int frames, bool addToDrawData)
+{
+	HeadlessImGui imgui(1920.0f, 1080.0f);
+	JobPool pool(std::max(threads, 1));
+	ImDrawListWorkers workers;
+	const int slices = threads * 4;
+	Timings timings;
+	for (int frame = 0; frame < frames; frame++)
+	{
+		imgui.NewFrame();
+		ImGui::SetNextWindowPos(ImVec2(0, 0));
+		ImGui::SetNextWindowSize(ImVec2(1920, 1080));
+		ImGui::Begin("canvas", nullptr, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoDecoration);
+		ImDrawList* drawList = ImGui::GetWindowDrawList();
+		BenchTimer timer;
+		if (threads == 0)
+		{
+			DrawWorkerSlice(drawList, 0, totalPoints, frame);
+			timings.record = std::min(timings.record, timer.Milliseconds());
+			timings.merge = 0.0;
+		}
+		else
+		{
+			workers.Begin(drawList, slices);
+			pool.Run(slices, [&](int slice) { DrawWorkerSlice(workers.GetDrawList(slice), slice, totalPoints / slices, frame); });
+			timings.record = std::min(timings.record, timer.Milliseconds());
+			if (!addToDrawData)
+			{
+				timer.Restart();
+				workers.Merge(drawList);
+				timings.merge = std::min(timings.merge, timer.Milliseconds());
+			}
+		}
+		ImGui::End();
+		ImGui::Render();
+		if (threads > 0 && addToDrawData)
+		{
+			timer.Restart();
+			workers.AddToDrawData(ImGui::GetDrawData());
+			timings.merge = std::min(timings.merge, timer.Milliseconds());
+		}
+		HeadlessImGui::ProcessTextures();
+		timings.vertices = ImGui::GetDrawData()->TotalVtxCount;
+	}
+	return timings;
+}
+
+int main(int argc, char** argv)
+{
+	const bool quick = IsQuickRun(argc, argv);
+	const int totalPoints = quick ? 100000 : 1000000;
+	const int frames = quick ? 2 : 10;
+	const int maxThreads = std::max(4, (int)std::thread::hardware_concurrency());
+
+	const Timings direct = Run(0, totalPoints, frames, false);
+	printf("%d points, %.1fM vertices, %u hardware threads\n", totalPoints, direct.vertices / 1e6, std::thread::hardware_concurrency());
+	printf("%-8s %10s %10s %10s %16s\n", "threads", "record ms", "Merge ms", "speedup", "AddToDrawData ms");
+	printf("%-8s %10.2f %10s %10s %16s\n", "direct", direct.record, "", "", "");
+	for (int threads = 1; threads <= maxThreads; threads *= 2)
+	{
+		const Timings merged = Run(threads, totalPoints, frames, false);
+		const Timings submitted = Run(threads, totalPoints, frames, true);
+		printf("%-8d %10.2f %10.2f %9.2fx %16.3f\n", threads, merged.record, merged.merge, direct.record / (merged.record + merged.merge), submitted.merge);
+	}
+	return 0;
+}
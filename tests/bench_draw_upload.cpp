@@ -0,0 +1,34 @@
+// vertex and index bytes a renderer uploads per frame of the demo scene, and the cpu time to build
+// the frame. run bench_draw_upload (20-byte ImDrawVert) and bench_draw_upload_compact
+// (IMGUI_USE_COMPACT_DRAWVERT, 12 bytes) side by side
+#include "bench.h"
+#include "demo_scene.h"
+#include "imgui_headless.h"
+#include <algorithm>
+#include <cstdio>
+
+int main(int argc, char** argv)
+{
+	const bool quick = IsQuickRun(argc, argv);
+	const int frames = quick ? 20 : 600;
+	const int warmup = 10;
+
+	HeadlessImGui imgui(1920.0f, 1080.0f);
+	double vertexBytes = 0.0, indexBytes = 0.0, totalMs = 0.0, bestMs = 1e9;
+	for (int frame = 0; frame < frames; frame++)
+	{
+		BenchTimer timer;
+		ImDrawData* drawData = imgui.Frame([&] { DemoScene(frame); });
+		const double ms = timer.Milliseconds();
+		if (frame < warmup)
+			continue;
+		vertexBytes += (double)drawData->TotalVtxCount * sizeof(ImDrawVert);
+		indexBytes += (double)drawData->TotalIdxCount * sizeof(ImDrawIdx);
+		totalMs += ms;
+		bestMs = std::min(bestMs, ms);
+	}
+	const int measured = frames - warmup;
+	printf("%2d-byte ImDrawVert  vertex bytes/frame %8.0f  index bytes/frame %8.0f  total %8.0f  frame avg %.3f best %.3f ms\n",
+		(int)sizeof(ImDrawVert), vertexBytes / measured, indexBytes / measured, (vertexBytes + indexBytes) / measured, totalMs / measured, bestMs);
+	return 0;
+}
@@ -0,0 +1,80 @@
+// main thread frame times while every frame draws all latin-1 glyphs at a new size, with glyphs
+// rasterized in the frame that uses them and on worker threads. frames are paced at 16 ms so the
+// workers get the idle time a real application leaves them
+#include "bench.h"
+#include "imgui_headless.h"
+#include "imgui_internal.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+static void Report(const char* name, std::vector<double> times)
+{
+	std::sort(times.begin(), times.end());
+	double sum = 0.0;
+	for (double time : times)
+		sum += time;
+	const size_t count = times.size();
+	printf("%-6s %4zu frames  mean %6.2f  p50 %6.2f  p90 %6.2f  p99 %6.2f  max %6.2f ms  over 16.6 ms: %d\n", name, count, sum / count,
+		times[count / 2], times[count * 9 / 10], times[count * 99 / 100], times.back(), (int)std::count_if(times.begin(), times.end(), [](double time) { return time > 16.6; }));
+
+	// histogram in 1 ms buckets, the last one open ended
+	int buckets[17] = {};
+	for (double time : times)
+		buckets[std::min((int)time, 16)]++;
+	for (int bucket = 0; bucket < 17; bucket++)
+		if (buckets[bucket] > 0)
+			printf("       %2d%s ms %5d\n", bucket, bucket == 16 ? "+" : " ", buckets[bucket]);
+}
+
+int main(int argc, char** argv)
+{
+	const bool quick = IsQuickRun(argc, argv);
+	const int frames = quick ? 8 : 480;
+
+	std::string text;
+	for (unsigned c = 0x20; c < 0x100; c++)
+	{
+		if (c >= 0x7F && c < 0xA0)
+			continue;
+		char utf8[5];
+		text.append(utf8, ImTextCharToUtf8(utf8, c));
+		if ((c & 31) == 31)
+			text += "\n";
+	}
+
+	HeadlessImGui contexts[2];
+	ImFont* fonts[2];
+	for (int async = 0; async < 2; async++)
+	{
+		contexts[async].MakeCurrent();
+		if (async)
+			ImGui::GetIO().Fonts->Flags |= ImFontAtlasFlags_AsyncGlyphBaking;
+		fonts[async] = ImGui::GetIO().Fonts->AddFontDefault();
+	}
+
+	std::vector<double> times[2];
+	for (int frame = 0; frame < frames; frame++)
+	{
+		const float size = 12.0f + (frame % 120) * 0.75f + (frame / 120) * 0.1f;
+		for (int async = 0; async < 2; async++)
+		{
+			contexts[async].MakeCurrent();
+			BenchTimer timer;
+			contexts[async].Frame([&] {
+				ImGui::Begin("text");
+				ImGui::PushFont(fonts[async], size);
+				ImGui::TextUnformatted(text.c_str());
+				ImGui::PopFont();
+				ImGui::End();
+			});
+			times[async].push_back(timer.Milliseconds());
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(16));
+	}
+	Report("sync", times[0]);
+	Report("async", times[1]);
+	return 0;
+}
@@ -0,0 +1,131 @@
+// ImHashStr() / ImHashData() throughput and collisions over 1M keys of four label distributions
+// (short labels, long paths, "label###id", "name##id") and PushID(int)/PushID(ptr) ids. "hot"
+// re-hashes 2000 cached labels like a frame does, "cold" walks the whole set. collisions are
+// counted over distinct hashed strings, next to the ~116 a random 32-bit hash would give.
+// bench_hash is the crc32c table, bench_hash_sse42 the crc instructions (avx2 build) and
+// bench_hash_fast IMGUI_USE_FAST_HASH
+#include "bench.h"
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+static unsigned g_randomState = 12345;
+
+static unsigned Random()
+{
+	g_randomState ^= g_randomState << 13;
+	g_randomState ^= g_randomState >> 17;
+	g_randomState ^= g_randomState << 5;
+	return g_randomState;
+}
+
+static const char* g_words[] = { "Button", "Enabled", "Color", "Position", "Scale", "Rotation", "Name", "Value", "Speed", "Filter",
+	"Open", "Save", "Delete", "Apply", "Texture", "Mesh", "Light", "Camera", "Layer", "Debug" };
+
+static std::vector<std::string> MakeKeys(int kind, int count)
+{
+	std::vector<std::string> keys;
+	char buffer[256];
+	for (int i = 0; i < count; i++)
+	{
+		const char* word = g_words[Random() % 20];
+		switch (kind)
+		{
+		case 0: snprintf(buffer, sizeof(buffer), (i & 1) ? "%s %d" : "##%s%d", word, i); break;
+		case 1: snprintf(buffer, sizeof(buffer), "assets/%s/%s_%d/%s_%05d_diffuse.png", g_words[i % 20], word, i % 97, word, i); break;
+		case 2: snprintf(buffer, sizeof(buffer), "%s %.3f ms###%s%d", word, (Random() % 100000) / 1000.0f, word, i); break;
+		default: snprintf(buffer, sizeof(buffer), "%s %d##%d", word, i / 7, i); break;
+		}
+		keys.push_back(buffer);
+	}
+	return keys;
+}
+
+static size_t CountCollisions(std::vector<ImGuiID> ids)
+{
+	std::sort(ids.begin(), ids.end());
+	size_t collisions = 0;
+	for (size_t i = 1; i < ids.size(); i++)
+		collisions += ids[i] == ids[i - 1];
+	return collisions;
+}
+
+static double ExpectedCollisions(size_t keys)
+{
+	return (double)keys * (keys - 1) / 2 / 4294967296.0;
+}
+
+int main(int argc, char** argv)
+{
+	const bool quick = IsQuickRun(argc, argv);
+	const int count = quick ? 20000 : 1000000;
+	const int repeats = quick ? 1 : 5;
+	const ImGuiID windowSeed = ImHashStr("Debug##Default");
+	const char* kindNames[] = { "short labels", "long paths", "label###id", "name##id" };
+
+	for (int kind = 0; kind < 4; kind++)
+	{
+		const std::vector<std::string> keys = MakeKeys(kind, count);
+		std::vector<ImGuiID> ids(count);
+		size_t totalLength = 0;
+		for (int i = 0; i < count; i++)
+		{
+			ids[i] = ImHashStr(keys[i].c_str(), 0, windowSeed);
+			totalLength += keys[i].size();
+		}
+		// keys equal after their last ### are the same id, not collisions
+		std::vector<std::string> hashed;
+		for (const std::string& key : keys)
+			hashed.push_back(ImHashSkipUncontributingPrefix(key.c_str()));
+		std::sort(hashed.begin(), hashed.end());
+		const size_t distinct = std::unique(hashed.begin(), hashed.end()) - hashed.begin();
+		const size_t collisions = CountCollisions(ids) - (count - distinct);
+
+		double bestCold = 1e9, bestHot = 1e9;
+		const int hotKeys = std::min(2000, count), hotRounds = quick ? 10 : 1000;
+		for (int repeat = 0; repeat < repeats; repeat++)
+		{
+			ImGuiID sum = 0;
+			BenchTimer timer;
+			for (int i = 0; i < count; i++)
+				sum += ImHashStr(keys[i].c_str(), 0, windowSeed);
+			bestCold = std::min(bestCold, timer.Seconds() * 1e9 / count);
+			timer.Restart();
+			for (int round = 0; round < hotRounds; round++)
+				for (int i = 0; i < hotKeys; i++)
+					sum += ImHashStr(keys[i].c_str(), 0, windowSeed + round);
+			bestHot = std::min(bestHot, timer.Seconds() * 1e9 / ((double)hotRounds * hotKeys));
+			DoNotOptimize(sum);
+		}
+		printf("%-12s avg %5.1f chars  hot %6.2f ns  cold %6.2f ns  %5zu collisions (random: %.0f)\n",
+			kindNames[kind], (double)totalLength / count, bestHot, bestCold, collisions, ExpectedCollisions(distinct));
+	}
+
+	// PushID(int) and PushID(ptr), as in table rows
+	std::vector<ImGuiID> ids(count);
+	for (int i = 0; i < count; i++)
+		ids[i] = ImHashData(&i, sizeof(int), windowSeed);
+	const size_t collisions = CountCollisions(ids);
+	double bestInt = 1e9, bestPointer = 1e9;
+	for (int repeat = 0; repeat < repeats; repeat++)
+	{
+		ImGuiID sum = 0;
+		BenchTimer timer;
+		for (int i = 0; i < count; i++)
+			sum += ImHashData(&i, sizeof(int), windowSeed);
+		bestInt = std::min(bestInt, timer.Seconds() * 1e9 / count);
+		timer.Restart();
+		for (int i = 0; i < count; i++)
+		{
+			const void* pointer = (const char*)ids.data() + (size_t)i * 16;
+			sum += ImHashData(&pointer, sizeof(pointer), windowSeed);
+		}
+		bestPointer = std::min(bestPointer, timer.Seconds() * 1e9 / count);
+		DoNotOptimize(sum);
+	}
+	printf("%-12s int %6.2f ns  pointer %6.2f ns  %5zu collisions (random: %.0f)\n", "ids", bestInt, bestPointer, collisions, ExpectedCollisions(count));
+	return 0;
+}
@@ -0,0 +1,107 @@
+// variable height ImGuiListClipper on 10M items: ImGuiListClipperHeights build time, memory and the
+// cost of FindItemAtOffset() (next to a linear prefix scan), GetItemOffset() and SetItemHeight(),
+// then frames scrolling randomly through the list with BeginVariableHeight() and with the uniform
+// Begin(), and one unclipped frame of 200k items for scale
+#include "bench.h"
+#include "imgui_headless.h"
+#include <cstdio>
+#include <random>
+
+static float CallbackHeight(int n, void*)
+{
+	return (n % 13) == 0 ? 40.0f : 17.0f;
+}
+
+// heights: BeginVariableHeight(), otherwise Begin() if clipped
+static void ListFrame(HeadlessImGui& imgui, int count, bool clipped, ImGuiListClipperHeights* heights, float scroll)
+{
+	imgui.Frame([&] {
+		ImGui::SetNextWindowPos(ImVec2(0, 0));
+		ImGui::SetNextWindowSize(ImVec2(500, 700));
+		ImGui::Begin("List", nullptr, ImGuiWindowFlags_NoSavedSettings);
+		ImGui::SetScrollY(scroll);
+		if (!clipped)
+		{
+			for (int i = 0; i < count; i++)
+				ImGui::Text("%d", i);
+		}
+		else
+		{
+			ImGuiListClipper clipper;
+			if (heights != nullptr)
+				clipper.BeginVariableHeight(count, heights);
+			else
+				clipper.Begin(count);
+			while (clipper.Step())
+				for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+				{
+					if (i % 13 == 0)
+						ImGui::Text("%d line\nline", i);
+					else
+						ImGui::Text("%d", i);
+				}
+		}
+		ImGui::End();
+	});
+}
+
+int main(int argc, char** argv)
+{
+	const bool quick = IsQuickRun(argc, argv);
+	const int count = quick ? 100000 : 10000000;
+	const int queries = quick ? 10000 : 2000000;
+	std::mt19937 random(1);
+
+	ImGuiListClipperHeights heights;
+	heights.ItemHeightCallback = CallbackHeight;
+	BenchTimer timer;
+	heights.Resize(count, 17.0f);
+	const double buildMs = timer.Milliseconds();
+	const double total = heights.GetTotalHeight();
+	double sum = 0.0;
+	timer.Restart();
+	for (int i = 0; i < queries; i++)
+		sum += heights.FindItemAtOffset(random() / 4294967296.0 * total);
+	const double findNs = timer.Seconds() * 1e9 / queries;
+	timer.Restart();
+	for (int i = 0; i < queries; i++)
+		sum += heights.GetItemOffset(random() % count);
+	const double offsetNs = timer.Seconds() * 1e9 / queries;
+	timer.Restart();
+	for (int i = 0; i < queries; i++)
+		heights.SetItemHeight(random() % count, (float)(10 + random() % 30));
+	const double setNs = timer.Seconds() * 1e9 / queries;
+	timer.Restart();
+	for (int i = 0; i < 20; i++)
+	{
+		const double target = random() / 4294967296.0 * heights.GetTotalHeight();
+		double offset = 0.0;
+		int n = 0;
+		for (; n < count - 1 && offset + heights.Heights[n] <= target; n++)
+			offset += heights.Heights[n];
+		sum += n;
+	}
+	const double linearMs = timer.Milliseconds() / 20;
+	DoNotOptimize(sum);
+	printf("%d items: build %.1f ms, find %.0f ns (linear scan %.3f ms), offset %.0f ns, set %.0f ns, %.2f MB heights + %.3f MB tree\n",
+		count, buildMs, findNs, linearMs, offsetNs, setNs, heights.Heights.size_in_bytes() / 1e6, heights.BlockTree.size_in_bytes() / 1e6);
+
+	HeadlessImGui imgui(1280.0f, 800.0f);
+	const int frames = quick ? 20 : 300;
+	for (int variable = 1; variable >= 0; variable--)
+	{
+		ImGuiListClipperHeights listHeights;
+		ImGuiListClipperHeights* listHeightsPtr = variable ? &listHeights : nullptr;
+		timer.Restart();
+		ListFrame(imgui, count, true, listHeightsPtr, 0.0f);
+		const double firstMs = timer.Milliseconds();
+		timer.Restart();
+		for (int frame = 0; frame < frames; frame++)
+			ListFrame(imgui, count, true, listHeightsPtr, (float)(random() / 4294967296.0 * count * 16.0));
+		printf("%-8s clipper, %d items: first frame %.2f ms, random scroll %.3f ms/frame\n", variable ? "variable" : "uniform", count, firstMs, timer.Milliseconds() / frames);
+	}
+	timer.Restart();
+	ListFrame(imgui, 200000, false, nullptr, 0.0f);
+	printf("unclipped, 200000 items: %.1f ms/frame\n", timer.Milliseconds());
+	return 0;
+}
@@ -0,0 +1,58 @@
+// 50 dashboard panels of which 5 get new values every frame, drawn as is and with
+// ImGuiWindowRefreshFlags_RefreshOnInputsChange: cpu time per frame (NewFrame() to Render()) and the
+// hit rate, with the mouse resting outside the panels and with it moving over one panel and clicking
+// every 60 frames
+#include "bench.h"
+#include "imgui_headless.h"
+#include "retained_scene.h"
+#include <cstdio>
+
+static void Run(bool retained, bool mouseMoving, int frames)
+{
+	HeadlessImGui imgui(1920.0f, 1080.0f);
+	RetainedScene scene(50, 10, 10);
+	for (int frame = 0; frame < 3; frame++)
+		imgui.Frame([&] { scene.Draw(retained); });
+
+	ImGuiIO& io = imgui.GetContext()->IO;
+	double seconds = 0.0;
+	for (int frame = 0; frame < frames; frame++)
+	{
+		if (mouseMoving)
+		{
+			const ImVec2 pos = scene.PanelPos(12);
+			io.AddMousePosEvent(pos.x + 20.0f + (frame % 60) * 2.0f, pos.y + 40.0f + (frame % 30));
+			if (frame % 60 == 0 || frame % 60 == 1)
+				io.AddMouseButtonEvent(0, frame % 60 == 0);
+		}
+		scene.Update(frame);
+		BenchTimer timer;
+		imgui.NewFrame();
+		scene.Draw(retained);
+		ImGui::Render();
+		seconds += timer.Seconds();
+		HeadlessImGui::ProcessTextures();
+	}
+
+	int hits = 0, total = 0;
+	for (ImGuiWindow* window : imgui.GetContext()->Windows)
+	{
+		hits += window->SkipRefreshHits;
+		total += window->SkipRefreshHits + window->SkipRefreshMisses;
+	}
+	printf("%-14s %-9s %7.3f ms/frame", mouseMoving ? "mouse moving" : "mouse static", retained ? "retained" : "refreshed", seconds * 1000.0 / frames);
+	if (retained)
+		printf(", %5.1f%% hit rate", hits * 100.0 / ImMax(total, 1));
+	printf("\n");
+}
+
+int main(int argc, char** argv)
+{
+	const int frames = IsQuickRun(argc, argv) ? 30 : 600;
+	for (bool mouseMoving : { false, true })
+	{
+		Run(false, mouseMoving, frames);
+		Run(true, mouseMoving, frames);
+	}
+	return 0;
+}
@@ -0,0 +1,140 @@
+// ImFontAtlasFlags_SDF against coverage baking. the cpu generator: microseconds per glyph to bake
+// latin-1 at 32 px as coverage, as an SDF (coverage + ImFontAtlasBuildConvertCoverageToSDF) and as
+// stbtt_GetGlyphSDF's exact distances. then a zoom sweep from 8 to 96 px and back in quarter pixel
+// steps (whole pixels with --quick) drawing latin-1 text: bakes, glyphs rasterized, textures
+// created by growing the atlas, peak atlas memory and time. ProggyClean, or the .ttf passed
+#include "bench.h"
+#include "counting_font_loader.h"
+#include "imgui_headless.h"
+#include "stb_truetype_variant.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+static const char* g_fontPath = nullptr;
+
+static ImFont* AddFont(ImFontAtlas* atlas, bool sdf)
+{
+	if (sdf)
+		atlas->Flags |= ImFontAtlasFlags_SDF;
+	CountingFontLoader::Install(atlas);
+	ImFont* font = g_fontPath ? atlas->AddFontFromFileTTF(g_fontPath, 13.0f) : atlas->AddFontDefault();
+	CountingFontLoader::Reset();
+	return font;
+}
+
+static std::string Latin1Text()
+{
+	std::string text;
+	for (unsigned c = 0x20; c < 0x100; c++)
+	{
+		if (c >= 0x7F && c < 0xA0)
+			continue;
+		char utf8[5];
+		text.append(utf8, ImTextCharToUtf8(utf8, c));
+		if ((c & 31) == 31)
+			text += "\n";
+	}
+	return text;
+}
+
+// every latin-1 glyph loaded into a fresh atlas, each round
+static double MicrosecondsPerGlyph(bool sdf, int rounds)
+{
+	double seconds = 0.0;
+	int glyphs = 0;
+	for (int round = 0; round < rounds; round++)
+	{
+		HeadlessImGui imgui;
+		ImFont* font = AddFont(ImGui::GetIO().Fonts, sdf);
+		imgui.Frame([] {});
+		ImFontBaked* baked = font->GetFontBaked(32.0f);
+		const int before = CountingFontLoader::glyphs;
+		BenchTimer timer;
+		for (unsigned c = 0x21; c < 0x100; c++)
+			DoNotOptimize(baked->FindGlyph((ImWchar)c));
+		seconds += timer.Seconds();
+		glyphs += CountingFontLoader::glyphs - before;
+	}
+	return seconds * 1e6 / ImMax(glyphs, 1);
+}
+
+static double ExactMicrosecondsPerGlyph(int rounds)
+{
+	HeadlessImGui imgui;
+	ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+	AddFont(atlas, false);
+	imgui.Frame([] {});
+	StbTrueTypeFont* font = StbScalar.LoadFont((const unsigned char*)atlas->Sources[0].FontData);
+	const float scale = StbScalar.ScaleForPixelHeight(font, 32.0f);
+	const int spread = atlas->SDFSpread, glyphCount = ImMin(StbScalar.GlyphCount(font), 200);
+	BenchTimer timer;
+	for (int round = 0; round < rounds; round++)
+		for (int glyph = 0; glyph < glyphCount; glyph++)
+		{
+			int w, h;
+			unsigned char* bitmap = StbScalar.GlyphSDF(font, scale, glyph, spread, 128, 127.0f / spread, &w, &h);
+			DoNotOptimize(bitmap);
+			StbScalar.FreeBitmap(bitmap);
+		}
+	const double microseconds = timer.Seconds() * 1e6 / (rounds * glyphCount);
+	StbScalar.FreeFont(font);
+	return microseconds;
+}
+
+static void ZoomSweep(bool sdf, float step)
+{
+	HeadlessImGui imgui;
+	ImFont* font = AddFont(ImGui::GetIO().Fonts, sdf);
+	const std::string text = Latin1Text();
+	std::vector<float> sizes;
+	for (float size = 8.0f; size <= 96.0f; size += step)
+		sizes.push_back(size);
+	for (float size = 96.0f; size >= 8.0f; size -= step)
+		sizes.push_back(size);
+
+	int texturesCreated = 0;
+	size_t peakBytes = 0;
+	BenchTimer timer;
+	for (float size : sizes)
+	{
+		imgui.NewFrame();
+		ImGui::SetNextWindowPos(ImVec2(0, 0));
+		ImGui::Begin("zoom", nullptr, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+		ImGui::PushFont(font, size);
+		ImGui::TextUnformatted(text.c_str());
+		ImGui::PopFont();
+		ImGui::End();
+		ImGui::Render();
+		size_t bytes = 0;
+		for (ImTextureData* tex : ImGui::GetPlatformIO().Textures)
+		{
+			texturesCreated += tex->Status == ImTextureStatus_WantCreate;
+			if (tex->Status != ImTextureStatus_Destroyed)
+				bytes += (size_t)tex->Width * tex->Height * tex->BytesPerPixel;
+		}
+		peakBytes = ImMax(peakBytes, bytes);
+		HeadlessImGui::ProcessTextures();
+	}
+	const ImTextureData* tex = ImGui::GetIO().Fonts->TexData;
+	printf("%-8s %4zu frames: %3d bakes, %6d glyphs rasterized, %3d textures created, atlas %4dx%-4d, peak %5.1f MB, %7.1f ms\n", sdf ? "sdf" : "coverage",
+		sizes.size(), CountingFontLoader::bakes, CountingFontLoader::glyphs, texturesCreated, tex->Width, tex->Height, peakBytes / 1048576.0, timer.Milliseconds());
+}
+
+int main(int argc, char** argv)
+{
+	const bool quick = IsQuickRun(argc, argv);
+	for (int i = 1; i < argc; i++)
+		if (argv[i][0] != '-')
+			g_fontPath = argv[i];
+	printf("%s\n", g_fontPath ? g_fontPath : "ProggyClean");
+
+	const int rounds = quick ? 2 : 30;
+	printf("bake at 32 px: coverage %.1f us/glyph, sdf %.1f us/glyph, stbtt_GetGlyphSDF %.1f us/glyph\n", MicrosecondsPerGlyph(false, rounds),
+		MicrosecondsPerGlyph(true, rounds), ExactMicrosecondsPerGlyph(quick ? 1 : 5));
+
+	const float step = quick ? 1.0f : 0.25f;
+	ZoomSweep(false, step);
+	ZoomSweep(true, step);
+	return 0;
+}
@@ -0,0 +1,45 @@
+// ImDrawListSplitter cost on the table scene: index bytes copied or filled by the splitter per frame
+// (ImDrawListSharedData::SplitterIdxBytes), index bytes handed to the renderer and cpu time. run
+// bench_splitter (in place) and bench_splitter_copy (IMGUI_DISABLE_SPLITTER_IN_PLACE_MERGE) side by side
+#include "bench.h"
+#include "imgui_headless.h"
+#include "imgui_internal.h"
+#include "table_scene.h"
+#include <algorithm>
+#include <cstdio>
+
+int main(int argc, char** argv)
+{
+	const bool quick = IsQuickRun(argc, argv);
+	const int frames = quick ? 20 : 600;
+	const int warmup = 10;
+
+	HeadlessImGui imgui(1920.0f, 1440.0f);
+	const ImDrawListSharedData& sharedData = GImGui->DrawListSharedData;
+	ImU64 splitterBytes = 0, uploadBytes = 0, peakSplitterBytes = 0;
+	double totalMs = 0.0, bestMs = 1e9;
+	for (int frame = 0; frame < frames; frame++)
+	{
+		const ImU64 bytesBefore = sharedData.SplitterIdxBytes;
+		BenchTimer timer;
+		ImDrawData* drawData = imgui.Frame([&] { TableScene(frame); });
+		const double ms = timer.Milliseconds();
+		if (frame < warmup)
+			continue;
+		const ImU64 frameBytes = sharedData.SplitterIdxBytes - bytesBefore;
+		splitterBytes += frameBytes;
+		peakSplitterBytes = std::max(peakSplitterBytes, frameBytes);
+		uploadBytes += (ImU64)drawData->TotalIdxCount * sizeof(ImDrawIdx);
+		totalMs += ms;
+		bestMs = std::min(bestMs, ms);
+	}
+	const int measured = frames - warmup;
+#ifdef IMGUI_DISABLE_SPLITTER_IN_PLACE_MERGE
+	const char* mode = "copy";
+#else
+	const char* mode = "in place";
+#endif
+	printf("%-8s splitter bytes/frame avg %8.0f peak %8llu  uploaded index bytes/frame %8.0f  frame avg %.3f best %.3f ms\n", mode,
+		(double)splitterBytes / measured, (unsigned long long)peakSplitterBytes, (double)uploadBytes / measured, totalMs / measured, bestMs);
+	return 0;
+}
@@ -0,0 +1,122 @@
+// glyphs/s of the stb_truetype rasterizer, scalar against STBTT_ENABLE_SIMD: every ProggyClean
+// glyph rendered the way the atlas bakes them (stbtt_MakeGlyphBitmapSubpixelPrefilter, 1x1 and 2x1
+// oversampling) at 13 to 96 px, and random curved outlines standing in for a vector font. .ttf
+// files passed on the command line are measured too
+#include "bench.h"
+#include "imgui_headless.h"
+#include "stb_truetype_variant.h"
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+struct GlyphBox
+{
+	int glyph, w, h;
+};
+
+static std::vector<unsigned char> g_pixels(512 * 512);
+
+static double GlyphsPerSecond(const StbTrueTypeVariant& variant, const unsigned char* data, float size, int oversampleX, double seconds)
+{
+	StbTrueTypeFont* font = variant.LoadFont(data);
+	const float scale = variant.ScaleForPixelHeight(font, size);
+	std::vector<GlyphBox> boxes;
+	for (int glyph = 0; glyph < variant.GlyphCount(font); glyph++)
+	{
+		int x0, y0, x1, y1;
+		variant.GlyphBitmapBox(font, glyph, scale * oversampleX, scale, 0.0f, 0.0f, &x0, &y0, &x1, &y1);
+		if (x1 > x0 && y1 > y0 && (x1 - x0 + oversampleX) * (y1 - y0) < (int)g_pixels.size())
+			boxes.push_back({ glyph, x1 - x0 + oversampleX - 1, y1 - y0 });
+	}
+	size_t glyphs = 0;
+	BenchTimer timer;
+	do
+	{
+		for (const GlyphBox& box : boxes)
+			variant.MakeGlyphBitmap(font, g_pixels.data(), box.w, box.h, box.w, scale * oversampleX, scale, 0.0f, 0.0f, oversampleX, 1, box.glyph);
+		glyphs += boxes.size();
+	} while (timer.Seconds() < seconds);
+	DoNotOptimize(g_pixels[0]);
+	variant.FreeFont(font);
+	return glyphs / timer.Seconds();
+}
+
+static double OutlinesPerSecond(const StbTrueTypeVariant& variant, float size, double seconds)
+{
+	std::mt19937 random(1);
+	std::vector<std::vector<StbOutlineVertex>> outlines;
+	for (int i = 0; i < 200; i++)
+		outlines.push_back(MakeRandomOutline(random, 3, 4, 15));
+	const int w = (int)ceilf(size) + 1, h = (int)ceilf(size) + 2;
+	size_t glyphs = 0;
+	BenchTimer timer;
+	do
+	{
+		for (const std::vector<StbOutlineVertex>& outline : outlines)
+			variant.Rasterize(g_pixels.data(), w, h, outline.data(), (int)outline.size(), size / 2048.0f, 0.0f, 0.0f, 0, (int)floorf(-size));
+		glyphs += outlines.size();
+	} while (timer.Seconds() < seconds);
+	DoNotOptimize(g_pixels[0]);
+	return glyphs / timer.Seconds();
+}
+
+static const float g_sizes[] = { 13.0f, 16.0f, 24.0f, 48.0f, 96.0f };
+
+static void MeasureFont(const char* name, const unsigned char* data, double seconds)
+{
+	for (float size : g_sizes)
+		for (int oversampleX = 1; oversampleX <= 2; oversampleX++)
+		{
+			const double scalar = GlyphsPerSecond(StbScalar, data, size, oversampleX, seconds);
+			const double simd = GlyphsPerSecond(StbSimd, data, size, oversampleX, seconds);
+			printf("%-16s %3.0f px %dx1: scalar %9.0f glyphs/s, simd %9.0f glyphs/s, %.2fx\n", name, size, oversampleX, scalar, simd, simd / scalar);
+		}
+}
+
+static std::vector<unsigned char> ReadFile(const char* path)
+{
+	std::vector<unsigned char> data;
+	if (FILE* file = fopen(path, "rb"))
+	{
+		unsigned char buffer[65536];
+		for (size_t read; (read = fread(buffer, 1, sizeof(buffer), file)) > 0;)
+			data.insert(data.end(), buffer, buffer + read);
+		fclose(file);
+	}
+	return data;
+}
+
+int main(int argc, char** argv)
+{
+	const bool quick = IsQuickRun(argc, argv);
+	const double seconds = quick ? 0.02 : 0.5;
+	if (!StbSimd.simd)
+		printf("no sse2/neon: both variants are scalar\n");
+
+	HeadlessImGui imgui;
+	imgui.Frame([] {});
+	MeasureFont("ProggyClean", (const unsigned char*)ImGui::GetIO().Fonts->Sources[0].FontData, seconds);
+	for (float size : g_sizes)
+	{
+		const double scalar = OutlinesPerSecond(StbScalar, size, seconds);
+		const double simd = OutlinesPerSecond(StbSimd, size, seconds);
+		printf("%-16s %3.0f px:     scalar %9.0f glyphs/s, simd %9.0f glyphs/s, %.2fx\n", "random outlines", size, scalar, simd, simd / scalar);
+	}
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (argv[i][0] == '-')
+			continue;
+		const std::vector<unsigned char> data = ReadFile(argv[i]);
+		StbTrueTypeFont* font = data.empty() ? nullptr : StbScalar.LoadFont(data.data());
+		if (font == nullptr)
+		{
+			printf("%s: not a font\n", argv[i]);
+			continue;
+		}
+		StbScalar.FreeFont(font);
+		MeasureFont(argv[i], data.data(), seconds);
+	}
+	return 0;
+}
@@ -0,0 +1,86 @@
+// ImGuiStorage insert and lookup cost per key, sorted (HashThreshold 0) vs hash index (HashThreshold
+// 1), for 32 to 1M ImHashData(int) keys inserted in order and looked up scattered. small storages are
+// timed in batches. the sorted insert is quadratic and skipped past 100k keys. then the frame time
+// of an expand-all over tree nodes in one window, whose StateStorage goes through the index
+#include "bench.h"
+#include "imgui_headless.h"
+#include "imgui_internal.h"
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+	const bool quick = IsQuickRun(argc, argv);
+	printf("%8s  %-26s  %-26s  %s\n", "keys", "sorted insert / lookup", "hashed insert / lookup", "hashed KB");
+	for (int count : { 32, 64, 256, 1000, 10000, 100000, 1000000 })
+	{
+		if (quick && count > 10000)
+			break;
+		std::vector<ImGuiID> keys(count);
+		for (int i = 0; i < count; i++)
+			keys[i] = ImHashData(&i, sizeof(i), 0x1234);
+		double insertNs[2] = { -1.0, -1.0 }, lookupNs[2] = { -1.0, -1.0 };
+		int memory = 0;
+		for (int hashed = 0; hashed < 2; hashed++)
+		{
+			if (!hashed && count > 100000)
+				continue;
+			const int batch = std::max(1, 100000 / count);
+			const int repeats = quick ? 1 : (!hashed && count >= 10000) ? 2 : 7;
+			for (int repeat = 0; repeat < repeats; repeat++)
+			{
+				std::vector<ImGuiStorage> storages(batch);
+				for (ImGuiStorage& storage : storages)
+					storage.HashThreshold = hashed;
+				BenchTimer timer;
+				for (ImGuiStorage& storage : storages)
+					for (int i = 0; i < count; i++)
+						storage.SetInt(keys[i], i);
+				const double insert = timer.Seconds() * 1e9 / ((double)count * batch);
+				timer.Restart();
+				unsigned sum = 0;
+				for (ImGuiStorage& storage : storages)
+					for (int round = 0; round < 4; round++)
+						for (int i = 0; i < count; i++)
+							sum += storage.GetInt(keys[(int)(((long long)i * 7919) % count)]);
+				const double lookup = timer.Seconds() * 1e9 / (4.0 * count * batch);
+				DoNotOptimize(sum);
+				insertNs[hashed] = (insertNs[hashed] < 0.0) ? insert : std::min(insertNs[hashed], insert);
+				lookupNs[hashed] = (lookupNs[hashed] < 0.0) ? lookup : std::min(lookupNs[hashed], lookup);
+				if (hashed)
+					memory = storages[0].Data.size_in_bytes() + storages[0].HashIndex.size_in_bytes();
+			}
+		}
+		char sorted[32] = "skipped";
+		if (insertNs[0] >= 0.0)
+			snprintf(sorted, sizeof(sorted), "%10.1f / %6.1f ns/key", insertNs[0], lookupNs[0]);
+		printf("%8d  %-26s  %10.1f / %6.1f ns/key  %8d\n", count, sorted, insertNs[1], lookupNs[1], memory / 1024);
+	}
+
+	// expand-all: every node writes its open state on frame 1
+	const int nodes = quick ? 10000 : 100000;
+	HeadlessImGui imgui(1920.0f, 1080.0f);
+	for (int frame = 0; frame < 4; frame++)
+	{
+		double ms = 0.0;
+		imgui.Frame([&] {
+			ImGui::Begin("Tree");
+			BenchTimer timer;
+			for (int i = 0; i < nodes; i++)
+			{
+				if (frame == 1)
+					ImGui::SetNextItemOpen(true);
+				ImGui::PushID(i);
+				ImGui::TreeNodeEx("node", ImGuiTreeNodeFlags_NoTreePushOnOpen);
+				ImGui::PopID();
+			}
+			ms = timer.Milliseconds();
+			ImGui::End();
+		});
+		const ImGuiStorage& storage = ImGui::FindWindowByName("Tree")->StateStorage;
+		printf("tree of %d nodes, frame %d%s: %8.2f ms, %d pairs%s\n", nodes, frame, frame == 1 ? " (expand all)" : "", ms,
+			storage.Data.Size, storage.HashIndex.Size > 0 ? " (hashed)" : "");
+	}
+	return 0;
+}
@@ -0,0 +1,52 @@
+// polyline and convex fill tessellation time on a 20000 point line. built against the default
+// (sse) imgui, the scalar build and, when the machine has it, the avx2 build
+#include "bench.h"
+#include "imgui_headless.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+	const bool quick = IsQuickRun(argc, argv);
+	const int repeats = quick ? 2 : 30;
+
+	HeadlessImGui imgui(1920.0f, 1080.0f);
+	std::vector<ImVec2> points(20000);
+	unsigned state = 1;
+	for (int i = 0; i < (int)points.size(); i++)
+	{
+		state = state * 1664525u + 1013904223u;
+		points[i] = ImVec2(i * 0.09f, 500.0f + 300.0f * sinf(i * 0.01f) + 20.0f * ((state >> 8) / 16777216.0f));
+	}
+
+	const char* names[] = { "polyline 1px", "polyline 3px", "polyline closed 1px", "convex fill 8000" };
+	for (int mode = 0; mode < 4; mode++)
+	{
+		double best = 1e9;
+		for (int repeat = 0; repeat < repeats; repeat++)
+		{
+			imgui.NewFrame();
+			ImDrawList* drawList = ImGui::GetBackgroundDrawList();
+			drawList->Flags &= ~ImDrawListFlags_AntiAliasedLinesUseTex; // the geometry path, not the textured line shortcut
+			BenchTimer timer;
+			for (int k = 0; k < 5; k++)
+			{
+				if (mode == 0)
+					drawList->AddPolyline(points.data(), (int)points.size(), IM_COL32_WHITE, 0, 1.0f);
+				else if (mode == 1)
+					drawList->AddPolyline(points.data(), (int)points.size(), IM_COL32_WHITE, 0, 3.0f);
+				else if (mode == 2)
+					drawList->AddPolyline(points.data(), (int)points.size(), IM_COL32_WHITE, ImDrawFlags_Closed, 1.0f);
+				else
+					drawList->AddConvexPolyFilled(points.data(), 8000, IM_COL32_WHITE);
+			}
+			best = std::min(best, timer.Milliseconds() / 5);
+			DoNotOptimize(drawList->VtxBuffer.Size);
+			imgui.EndFrame();
+		}
+		printf("%-22s %.3f ms\n", names[mode], best);
+	}
+	return 0;
+}
@@ -0,0 +1,47 @@
+// ImFont::RenderText throughput: 1MB of text in 100 character lines, once unclipped (every glyph
+// written) and once as a screen of 60 visible lines rendered repeatedly, in glyphs per second
+#include "bench.h"
+#include "imgui_headless.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+int main(int argc, char** argv)
+{
+	const bool quick = IsQuickRun(argc, argv);
+	const int repeats = quick ? 1 : 15;
+
+	std::string line;
+	for (int i = 0; i < 100; i++)
+		line += (char)(32 + (i * 7) % 95);
+	line += "\n";
+	std::string text;
+	while (text.size() < (quick ? (64u << 10) : (1u << 20)))
+		text += line;
+
+	HeadlessImGui imgui(1920.0f, 1080.0f);
+	for (int mode = 0; mode < 2; mode++)
+	{
+		const bool screen = mode == 1;
+		const ImVec4 clip = screen ? ImVec4(0, 0, 1920, 1080) : ImVec4(0, 0, 1e9f, 1e9f);
+		const char* begin = text.c_str();
+		const char* end = begin + (screen ? line.size() * 60 : text.size());
+		const int calls = screen ? 100 : 1;
+		double best = 1e9;
+		int glyphs = 0;
+		for (int repeat = 0; repeat < repeats + 1; repeat++)
+		{
+			imgui.NewFrame();
+			ImDrawList* drawList = ImGui::GetBackgroundDrawList();
+			BenchTimer timer;
+			for (int call = 0; call < calls; call++)
+				ImGui::GetFont()->RenderText(drawList, 13.0f, ImVec2(0, 0), IM_COL32_WHITE, clip, begin, end, 0.0f, false);
+			if (repeat > 0) // the first frame bakes the glyphs
+				best = std::min(best, timer.Milliseconds() / calls);
+			glyphs = drawList->VtxBuffer.Size / 4 / calls;
+			imgui.EndFrame();
+		}
+		printf("%-18s %8d glyphs %8.3f ms %7.1f Mglyphs/s\n", screen ? "60 visible lines" : "unclipped", glyphs, best, glyphs / best / 1000.0);
+	}
+	return 0;
+}
@@ -0,0 +1,88 @@
+// appending a 512 MB log (16 MB with --quick) one formatted line at a time: ImGuiTextBuffer with an
+// ImGuiTextIndex against ImGuiTextChunkedBuffer, unlimited and capped to 64 MB. throughput, the
+// worst single append (a contiguous buffer doubling copies everything) and peak RSS. peak RSS only
+// grows, so the layouts run from the smallest footprint to the largest and each reading is that
+// layout's own peak. then seeking and iterating lines in a list clipper pattern
+#include "bench.h"
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <cstdio>
+#include <random>
+
+enum Layout { Layout_ChunkedCapped, Layout_Chunked, Layout_Contiguous };
+
+static void AppendLine(ImGuiTextBuffer& buffer, ImGuiTextIndex& index, ImGuiTextChunkedBuffer& chunked, Layout layout, int i)
+{
+	const char* fmt = "[%08d] frame %d: some log message with a value %.3f and a name %s\n";
+	const char* name = (i & 7) ? "short" : "a somewhat longer name";
+	if (layout == Layout_Contiguous)
+	{
+		const int oldSize = buffer.size();
+		buffer.appendf(fmt, i, i / 60, i * 0.25f, name);
+		index.append(buffer.begin(), oldSize, buffer.size());
+	}
+	else
+	{
+		chunked.appendf(fmt, i, i / 60, i * 0.25f, name);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const bool quick = IsQuickRun(argc, argv);
+	const size_t total = (size_t)(quick ? 16 : 512) << 20;
+	const size_t cap = (size_t)64 << 20;
+	ImGui::CreateContext();
+	for (Layout layout : { Layout_ChunkedCapped, Layout_Chunked, Layout_Contiguous })
+	{
+		ImGuiTextBuffer buffer;
+		ImGuiTextIndex index;
+		ImGuiTextChunkedBuffer chunked(64 * 1024, layout == Layout_ChunkedCapped ? cap : 0);
+		double worstMs = 0.0;
+		int lines = 0, slowAppends = 0;
+		size_t appended = 0;
+		BenchTimer timer, appendTimer;
+		for (int i = 0; appended < total; i++, lines++)
+		{
+			const size_t oldSize = (layout == Layout_Contiguous) ? (size_t)buffer.size() : chunked.size();
+			appendTimer.Restart();
+			AppendLine(buffer, index, chunked, layout, i);
+			const double ms = appendTimer.Milliseconds();
+			worstMs = ImMax(worstMs, ms);
+			slowAppends += ms > 1.0;
+			const size_t newSize = (layout == Layout_Contiguous) ? (size_t)buffer.size() : chunked.size();
+			appended += (newSize > oldSize) ? newSize - oldSize : 80; // a full capped buffer stops growing
+		}
+		const double seconds = timer.Seconds();
+
+		// a 40 line window at random positions: one seek, then consecutive lines, reading their first
+		// character as TextUnformatted() would (the chunked cursor reads the text for the trailing '\n')
+		std::mt19937 random(1);
+		const int stored = (layout == Layout_Contiguous) ? index.size() : chunked.lines_count();
+		const int windows = quick ? 10000 : 200000;
+		size_t sum = 0;
+		timer.Restart();
+		for (int k = 0; k < windows; k++)
+		{
+			const int first = random() % ImMax(1, stored - 40);
+			if (layout == Layout_Contiguous)
+			{
+				for (int n = first; n < first + 40 && n < stored; n++)
+					sum += index.get_line_end(buffer.begin(), n) - index.get_line_begin(buffer.begin(), n) + *index.get_line_begin(buffer.begin(), n);
+			}
+			else
+			{
+				for (ImGuiTextChunkedBuffer::Cursor cursor = chunked.seek_line(first); cursor.LineNo < first + 40 && cursor.LineNo < stored; chunked.next_line(&cursor))
+					sum += cursor.LineEnd - cursor.LineBegin + *cursor.LineBegin;
+			}
+		}
+		const double windowNs = timer.Seconds() * 1e9 / windows;
+		DoNotOptimize(sum);
+
+		static const char* names[] = { "chunked, capped 64 MB", "chunked", "contiguous + index" };
+		printf("%-22s %9d lines, %4.0f MB: %6.0f MB/s, worst append %7.2f ms, %4d appends > 1 ms, peak RSS %6.0f MB, %8d lines stored, 40 line window %6.0f ns\n",
+			names[layout], lines, appended / 1048576.0, appended / 1048576.0 / seconds, worstMs, slowAppends, PeakRssMB(), stored, windowNs);
+	}
+	ImGui::DestroyContext();
+	return 0;
+}
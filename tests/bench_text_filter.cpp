@@ -0,0 +1,129 @@
+// ImGuiTextFilter on a 5M line log (250 MB): the previous per-line matching through ImStristr(),
+// PassFilter() per line, PassFilterLines() over the whole log and split across 4 threads in
+// 32-line aligned ranges, for selective, exclusive, common and missing terms. then typing a word one
+// key at a time, with a full pass per keystroke vs refining the previous result.
+// bench_text_filter_scalar measures the horspool search instead of the simd one
+#include "bench.h"
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+	const bool quick = IsQuickRun(argc, argv);
+	const int lines = quick ? 20000 : 5000000;
+	ImGui::CreateContext();
+
+	std::mt19937 random(1);
+	std::string log;
+	log.reserve((size_t)lines * 64);
+	std::vector<int> offsets(lines);
+	static const char* messages[] = { "Loaded texture '%s' (%dx%d)", "Frame %d took %.2f ms", "Shader compile warning in %s line %d",
+		"Saving settings to %s", "Connection to %s established", "Error: failed to open %s (%d)" };
+	static const char* names[] = { "grass_diffuse.png", "hero_normal.dds", "ui_atlas.png", "imgui.ini", "server-eu-west.example.net", "water.hlsl" };
+	char line[256];
+	for (int i = 0; i < lines; i++)
+	{
+		offsets[i] = (int)log.size();
+		const int message = random() % 6;
+		const char* name = names[random() % 6];
+		int length = snprintf(line, sizeof(line), "[%08d] ", i);
+		if (message == 1)
+			snprintf(line + length, sizeof(line) - length, "Frame %d took %.2f ms", i, (random() % 2000) / 100.0);
+		else
+			snprintf(line + length, sizeof(line) - length, messages[message], name, (int)(random() % 4096), (int)(random() % 4096));
+		log += line;
+		log += '\n';
+	}
+	const char* logBegin = log.c_str();
+	const char* logEnd = logBegin + log.size();
+	printf("log: %d lines, %.1f MB\n", lines, log.size() / 1e6);
+
+	std::vector<ImU32> bits((lines + 31) / 32);
+	bool countsMatch = true;
+	for (const char* text : { "error", "-imgui", "imgui", "warning", "hero_normal", "error,-imgui", "xyzzy", "e", "Frame 123456" })
+	{
+		const ImGuiTextFilter filter(text);
+		BenchTimer timer;
+		int previousCount = 0;
+		for (int n = 0; n < lines; n++)
+		{
+			const char* lineBegin = logBegin + offsets[n];
+			const char* lineEnd = (n + 1 < lines) ? logBegin + offsets[n + 1] - 1 : logEnd;
+			bool pass = filter.CountGrep == 0;
+			for (const ImGuiTextFilter::ImGuiTextRange& range : filter.Filters)
+			{
+				if (range.b == range.e)
+					continue;
+				const bool exclude = range.b[0] == '-';
+				if (ImStristr(lineBegin, lineEnd, exclude ? range.b + 1 : range.b, range.e))
+				{
+					pass = !exclude;
+					break;
+				}
+			}
+			previousCount += pass;
+		}
+		const double previousMs = timer.Milliseconds();
+
+		timer.Restart();
+		int perLineCount = 0;
+		for (int n = 0; n < lines; n++)
+		{
+			const char* lineBegin = logBegin + offsets[n];
+			const char* lineEnd = (n + 1 < lines) ? logBegin + offsets[n + 1] - 1 : logEnd;
+			perLineCount += filter.PassFilter(lineBegin, lineEnd);
+		}
+		const double perLineMs = timer.Milliseconds();
+
+		timer.Restart();
+		const int batchCount = filter.PassFilterLines(logBegin, logEnd, offsets.data(), lines, bits.data());
+		const double batchMs = timer.Milliseconds();
+
+		const int threads = 4;
+		std::vector<int> counts(threads);
+		std::vector<std::thread> workers;
+		timer.Restart();
+		for (int k = 0; k < threads; k++)
+			workers.emplace_back([&, k] {
+				const int perThread = ((lines / threads) + 31) & ~31;
+				counts[k] = filter.PassFilterLines(logBegin, logEnd, offsets.data(), lines, bits.data(), ImMin(lines, k * perThread), ImMin(lines, (k + 1) * perThread));
+			});
+		for (std::thread& worker : workers)
+			worker.join();
+		const double threadsMs = timer.Milliseconds();
+		int threadsCount = 0;
+		for (int count : counts)
+			threadsCount += count;
+
+		const bool match = previousCount == perLineCount && perLineCount == batchCount && batchCount == threadsCount;
+		countsMatch &= match;
+		printf("%-14s %7d lines: previous %7.1f ms, per line %7.1f ms, batch %7.1f ms, batch x%d threads %7.1f ms%s\n", text, previousCount,
+			previousMs, perLineMs, batchMs, threads, threadsMs, match ? "" : "  COUNT MISMATCH");
+	}
+
+	const char* word = "hero_normal";
+	ImGuiTextFilter filter;
+	std::vector<ImU32> refined(bits.size());
+	double fullMs = 0.0, refineMs = 0.0;
+	for (int typed = 1; typed <= (int)strlen(word); typed++)
+	{
+		ImStrncpy(filter.InputBuf, word, typed + 1);
+		filter.Build();
+		BenchTimer timer;
+		filter.PassFilterLines(logBegin, logEnd, offsets.data(), lines, bits.data());
+		fullMs += timer.Milliseconds();
+		timer.Restart();
+		filter.PassFilterLines(logBegin, logEnd, offsets.data(), lines, refined.data(), 0, lines, typed > 1 && filter.RefinesPrevious);
+		refineMs += timer.Milliseconds();
+		countsMatch &= refined == bits;
+	}
+	printf("typing '%s': full pass per key %.1f ms, refine %.1f ms in total\n", word, fullMs, refineMs);
+	ImGui::DestroyContext();
+	return countsMatch ? 0 : 1;
+}
@@ -0,0 +1,120 @@
+// frame time of a window full of widgets and a table with the text size cache off and on, and
+// CalcTextSize() on 1000 typical labels. the two settings are interleaved to average out noise
+#include "bench.h"
+#include "imgui_headless.h"
+#include "imgui_internal.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+static void WidgetWindow()
+{
+	static bool values[150];
+	char label[64];
+	ImGui::SetNextWindowPos(ImVec2(0, 0));
+	ImGui::SetNextWindowSize(ImVec2(3800, 3800));
+	ImGui::Begin("Widgets");
+	for (int i = 0; i < 150; i++)
+	{
+		snprintf(label, sizeof(label), "Button number %d##b", i);
+		ImGui::Button(label);
+		ImGui::SameLine();
+		snprintf(label, sizeof(label), "Option %d with a longer label", i);
+		ImGui::Checkbox(label, &values[i]);
+		ImGui::SameLine();
+		snprintf(label, sizeof(label), "Tree node %d", i);
+		if (ImGui::TreeNode(label))
+			ImGui::TreePop();
+	}
+	if (ImGui::BeginTable("table", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable))
+	{
+		for (int column = 0; column < 6; column++)
+		{
+			snprintf(label, sizeof(label), "Column header %d", column);
+			ImGui::TableSetupColumn(label);
+		}
+		ImGui::TableHeadersRow();
+		for (int row = 0; row < 120; row++)
+		{
+			ImGui::TableNextRow();
+			for (int column = 0; column < 6; column++)
+			{
+				ImGui::TableNextColumn();
+				snprintf(label, sizeof(label), "Cell %d,%d value", row, column);
+				ImGui::TextUnformatted(label);
+			}
+		}
+		ImGui::EndTable();
+	}
+	ImGui::End();
+}
+
+int main(int argc, char** argv)
+{
+	const bool quick = IsQuickRun(argc, argv);
+	const int rounds = quick ? 1 : 20;
+	const int framesPerRound = quick ? 2 : 20;
+
+	HeadlessImGui imgui(4000.0f, 4000.0f);
+	ImGuiTextSizeCache& cache = GImGui->TextSizeCache;
+
+	double best[2] = { 1e9, 1e9 }, total[2] = { 0, 0 };
+	int hits = 0, misses = 0;
+	for (int round = 0; round < rounds; round++)
+		for (int enabled = 0; enabled < 2; enabled++)
+		{
+			cache.Enabled = enabled != 0;
+			for (int frame = 0; frame < 3; frame++)
+				imgui.Frame(WidgetWindow);
+			for (int frame = 0; frame < framesPerRound; frame++)
+			{
+				BenchTimer timer;
+				imgui.Frame(WidgetWindow);
+				const double ms = timer.Milliseconds();
+				total[enabled] += ms;
+				best[enabled] = std::min(best[enabled], ms);
+			}
+			if (enabled)
+			{
+				hits = cache.HitsLastFrame;
+				misses = cache.MissesLastFrame;
+			}
+		}
+	for (int enabled = 0; enabled < 2; enabled++)
+		printf("widget frame, cache %-3s best %.3f ms avg %.3f ms\n", enabled ? "on" : "off", best[enabled], total[enabled] / (rounds * framesPerRound));
+	printf("lookups per frame: %d hits %d misses\n", hits, misses);
+
+	std::vector<std::string> labels;
+	const char* words[] = { "Enable", "shadows", "Color", "Edit", "Window", "Settings", "Apply", "Button", "Advanced", "Frame rate" };
+	unsigned state = 1;
+	for (int i = 0; i < 1000; i++)
+	{
+		std::string label;
+		for (int k = 0; k < 3; k++)
+		{
+			state = state * 1664525u + 1013904223u;
+			label += words[(state >> 8) % 10];
+			label += " ";
+		}
+		labels.push_back(label + std::to_string(i));
+	}
+	for (int enabled = 0; enabled < 2; enabled++)
+	{
+		cache.Enabled = enabled != 0;
+		double bestUs = 1e9;
+		for (int repeat = 0; repeat < (quick ? 2 : 50); repeat++)
+		{
+			imgui.NewFrame();
+			BenchTimer timer;
+			float width = 0.0f;
+			for (const std::string& label : labels)
+				width += ImGui::CalcTextSize(label.c_str(), label.c_str() + label.size()).x;
+			bestUs = std::min(bestUs, timer.Milliseconds() * 1000.0);
+			DoNotOptimize(width);
+			imgui.EndFrame();
+		}
+		printf("CalcTextSize x1000 labels, cache %-3s %.1f us\n", enabled ? "on" : "off", bestUs);
+	}
+	return 0;
+}
@@ -0,0 +1,86 @@
+// a 100 MB log (4 MB with --quick) shown wrapped in a window: one-shot ImGuiTextWrapIndex build,
+// then frames appending 4 KB each with TextWrappedWithIndex() (incremental update + clipper), the
+// frame that rewraps everything after a width change, and TextWrapped() of the whole log for scale
+#include "bench.h"
+#include "imgui_headless.h"
+#include "imgui_internal.h"
+#include <cstdio>
+#include <random>
+
+static std::mt19937 g_random(7);
+static int g_lineNumber = 0;
+
+static void AppendLogLines(ImGuiTextBuffer& log, ImGuiTextWrapIndex& index, size_t bytes)
+{
+	static const char* words[] = { "texture", "upload", "of", "frame", "took", "ms", "shader", "compiled", "warning:", "the", "resource", "state" };
+	const int oldSize = log.size();
+	const size_t target = (size_t)log.size() + bytes;
+	while ((size_t)log.size() < target)
+	{
+		log.appendf("[%08d] ", g_lineNumber++);
+		const int count = (g_random() % 8 == 0) ? 20 + g_random() % 60 : 3 + g_random() % 10; // some lines wrap several times
+		for (int i = 0; i < count; i++)
+			log.appendf("%s ", words[g_random() % IM_ARRAYSIZE(words)]);
+		log.append("\n");
+	}
+	index.append(log.begin(), oldSize, log.size());
+}
+
+static void LogFrame(HeadlessImGui& imgui, ImGuiTextWrapIndex* index, const ImGuiTextBuffer& log, float width)
+{
+	imgui.Frame([&] {
+		ImGui::SetNextWindowPos(ImVec2(0, 0));
+		ImGui::SetNextWindowSize(ImVec2(width, 800));
+		ImGui::Begin("Log", nullptr, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysVerticalScrollbar);
+		if (index != nullptr)
+			ImGui::TextWrappedWithIndex(index, log.c_str());
+		else
+			ImGui::TextWrapped("%s", log.c_str());
+		ImGui::SetScrollHereY(1.0f);
+		ImGui::End();
+	});
+}
+
+int main(int argc, char** argv)
+{
+	const bool quick = IsQuickRun(argc, argv);
+	const size_t logBytes = (size_t)(quick ? 4 : 100) << 20;
+	HeadlessImGui imgui(1920.0f, 1080.0f);
+	imgui.Frame([] {});
+
+	ImGuiTextBuffer log;
+	ImGuiTextWrapIndex index;
+	log.reserve((int)logBytes + (1 << 20));
+	AppendLogLines(log, index, logBytes);
+	BenchTimer timer;
+	index.update(log.c_str(), ImGui::GetFont(), ImGui::GetFontSize(), 900.0f);
+	printf("log: %.1f MB, %d lines, %d wrapped at 900 px, one-shot wrap %.1f ms, index %.1f MB\n", log.size() / 1048576.0, index.size(),
+		index.wrapped_size(), timer.Milliseconds(), (index.LineOffsets.size_in_bytes() + index.WrapOffsets.size_in_bytes()) / 1048576.0);
+
+	// the first frame wraps at the window's width, then each frame appends 4 KB
+	index.clear();
+	index.append(log.begin(), 0, log.size());
+	timer.Restart();
+	LogFrame(imgui, &index, log, 1000.0f);
+	const double firstMs = timer.Milliseconds();
+	const int frames = quick ? 50 : 500;
+	double appendMs = 0.0;
+	for (int frame = 0; frame < frames; frame++)
+	{
+		AppendLogLines(log, index, 4096);
+		BenchTimer frameTimer;
+		LogFrame(imgui, &index, log, 1000.0f);
+		appendMs += frameTimer.Milliseconds();
+	}
+	timer.Restart();
+	LogFrame(imgui, &index, log, 1100.0f);
+	const double resizeMs = timer.Milliseconds();
+	printf("TextWrappedWithIndex: first frame %.1f ms, appending 4 KB per frame %.3f ms/frame, width change %.1f ms\n", firstMs, appendMs / frames, resizeMs);
+
+	const int plainFrames = quick ? 3 : 2;
+	timer.Restart();
+	for (int frame = 0; frame < plainFrames; frame++)
+		LogFrame(imgui, nullptr, log, 1000.0f);
+	printf("TextWrapped: %.1f ms/frame\n", timer.Milliseconds() / plainFrames);
+	return 0;
+}
@@ -0,0 +1,94 @@
+// TlsfAllocator alloc/free cost with many live allocations, and how well a pool of heap blocks
+// packs a churning mix of resource sizes (reserved bytes vs bytes in use)
+#include "bench.h"
+#include "heap_block_list.h"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+static void BenchAllocFree(int rounds, int allocations)
+{
+	std::mt19937_64 rng(1);
+	TlsfAllocator allocator(1ull << 40, 256);
+	std::vector<TlsfAllocator::Handle> handles;
+	handles.reserve(allocations);
+
+	BenchTimer timer;
+	int64_t ops = 0;
+	for (int round = 0; round < rounds; round++)
+	{
+		for (int i = 0; i < allocations; i++)
+			handles.push_back(allocator.Allocate(rng() % 65536 + 1));
+		// free in random order so the free lists see real fragmentation
+		std::shuffle(handles.begin(), handles.end(), rng);
+		for (TlsfAllocator::Handle handle : handles)
+			allocator.Free(handle);
+		ops += (int64_t)handles.size();
+		handles.clear();
+	}
+	printf("alloc+free, %d live at peak: %.1f ns per pair\n", allocations, timer.Seconds() * 1e9 / (double)ops);
+}
+
+static void BenchBlockPacking(int frames)
+{
+	const uint64_t blockSize = 64ull << 20;
+	std::mt19937 rng(3);
+	HeapBlockList<int> blocks(65536, 1);
+	struct Live
+	{
+		HeapBlockList<int>::Block* block;
+		TlsfAllocator::Handle handle;
+		uint64_t size;
+	};
+	std::vector<Live> live;
+	uint64_t liveBytes = 0, peakReserved = 0;
+	double reservedSum = 0.0, liveSum = 0.0;
+	int heapsCreated = 0;
+
+	BenchTimer timer;
+	for (int frame = 0; frame < frames; frame++)
+	{
+		// a few resources come and go every frame, the working set slowly breathes
+		const int target = 400 + (int)(300.0 * ((frame / 500) % 2 == 0 ? (frame % 500) / 500.0 : 1.0 - (frame % 500) / 500.0));
+		for (int i = 0; i < 8; i++)
+		{
+			if ((int)live.size() < target)
+			{
+				const uint64_t size = (rng() % 16 == 0) ? (rng() % 16 + 1) << 20 : (rng() % 1024 + 1) << 10;
+				TlsfAllocator::Handle handle;
+				HeapBlockList<int>::Block* block = blocks.Allocate(size, 65536, nullptr, 0.0f, handle);
+				if (block == nullptr)
+				{
+					block = blocks.AddBlock(heapsCreated++, std::max(size, blockSize));
+					handle = block->allocator.Allocate(size, 65536);
+				}
+				live.push_back({ block, handle, size });
+				liveBytes += size;
+			}
+			else
+			{
+				const size_t index = rng() % live.size();
+				liveBytes -= live[index].size;
+				blocks.Free(live[index].block, live[index].handle, [](HeapBlockList<int>::Block&) {});
+				live[index] = live.back();
+				live.pop_back();
+			}
+		}
+		peakReserved = std::max(peakReserved, blocks.GetReservedBytes());
+		reservedSum += (double)blocks.GetReservedBytes();
+		liveSum += (double)liveBytes;
+	}
+	printf("%d frames: %.1f MB reserved on average for %.1f MB live (%.1f%% overhead), peak %.1f MB, %d heaps created\n",
+		frames, reservedSum / frames / (1 << 20), liveSum / frames / (1 << 20), 100.0 * (reservedSum / liveSum - 1.0),
+		peakReserved / (double)(1 << 20), heapsCreated);
+	printf("block bookkeeping: %.3f ms per frame\n", timer.Milliseconds() / frames);
+}
+
+int main(int argc, char** argv)
+{
+	const bool quick = IsQuickRun(argc, argv);
+	BenchAllocFree(quick ? 2 : 20, quick ? 10000 : 100000);
+	BenchBlockPacking(quick ? 500 : 20000);
+	return 0;
+}
@@ -0,0 +1,51 @@
+// AddConcavePolyFilled() time on 1k, 10k and 100k vertex stars, combs and spirals. build the
+// bench_triangulation_scan variant for the plain reflex scan (expect minutes on the 100k shapes)
+#include "bench.h"
+#include "imgui_headless.h"
+#include "polygons.h"
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+static unsigned g_randomState = 1;
+
+static float RandomFloat()
+{
+	g_randomState = g_randomState * 1664525u + 1013904223u;
+	return (g_randomState >> 8) / 16777216.0f;
+}
+
+int main(int argc, char** argv)
+{
+	const bool quick = IsQuickRun(argc, argv);
+	HeadlessImGui imgui(1920.0f, 1080.0f);
+	std::vector<ImVec2> points;
+	const char* names[] = { "star", "comb", "spiral" };
+	for (int count : { 1000, 10000, 100000 })
+	{
+		if (quick && count > 1000)
+			break;
+		for (int shape = 0; shape < 3; shape++)
+		{
+			if (shape == 0)
+				MakeStar(points, count, 0.5f, false, RandomFloat);
+			else if (shape == 1)
+				MakeComb(points, count / 4);
+			else
+				MakeSpiral(points, count);
+			double best = 1e9;
+			for (int repeat = 0; repeat < (quick ? 1 : count >= 100000 ? 1 : 5); repeat++)
+			{
+				imgui.NewFrame();
+				ImDrawList* drawList = ImGui::GetBackgroundDrawList();
+				BenchTimer timer;
+				drawList->AddConcavePolyFilled(points.data(), (int)points.size(), IM_COL32_WHITE);
+				best = std::min(best, timer.Milliseconds());
+				DoNotOptimize(drawList->IdxBuffer.Size);
+				imgui.EndFrame();
+			}
+			printf("%6d vertices %-6s %10.3f ms\n", (int)points.size(), names[shape], best);
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,104 @@
+// upload throughput for frames of 1 to 32 MB in 1 to 512 draw lists: plain memcpy() per draw list
+// (the backend's small frame path), the stream copy jobs run serially, and the same jobs spread over
+// 2 and 4 threads. destinations are 64 KB aligned like upload buffers. GB/s, best of several runs
+#include "bench.h"
+#include "imgui_impl_dx12_upload.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+// runs the jobs on 'threads' threads, the calling one included. threads are started per call, which
+// is pessimistic next to the application's job system
+static void RunJobs(const ImGui_ImplDX12_UploadJobs& jobs, int jobCount, int threads)
+{
+	std::atomic<int> next(0);
+	auto worker = [&] {
+		for (int job = next++; job < jobCount; job = next++)
+			jobs.RunJob(job);
+	};
+	std::vector<std::thread> pool;
+	for (int i = 1; i < threads; i++)
+		pool.emplace_back(worker);
+	worker();
+	for (std::thread& thread : pool)
+		thread.join();
+}
+
+int main(int argc, char** argv)
+{
+	const bool quick = IsQuickRun(argc, argv);
+	const size_t frameSizes[] = { 1u << 20, 8u << 20, 32u << 20 };
+	const int listCounts[] = { 1, 8, 64, 512 };
+	printf("%-8s %5s %8s %8s %8s %8s   (GB/s)\n", "MB", "lists", "memcpy", "jobs x1", "jobs x2", "jobs x4");
+	for (size_t frameSize : frameSizes)
+	{
+		if (quick && frameSize > (1u << 20))
+			break;
+		for (int lists : listCounts)
+		{
+			// a real frame's split: 20-byte vertices and about 1.5 2-byte indices per vertex
+			std::vector<std::vector<unsigned char>> vertices(lists), indices(lists);
+			size_t vertexBytes = 0, indexBytes = 0;
+			for (int list = 0; list < lists; list++)
+			{
+				const size_t perList = frameSize / lists;
+				const size_t vertexCount = perList / 23;
+				vertices[list].assign(vertexCount * 20, (unsigned char)list);
+				indices[list].assign((perList - vertexCount * 20) / 2 * 2, (unsigned char)(list + 1));
+				vertexBytes += vertices[list].size();
+				indexBytes += indices[list].size();
+			}
+			unsigned char* vertexDst = (unsigned char*)aligned_alloc(65536, (vertexBytes + 65535) & ~(size_t)65535);
+			unsigned char* indexDst = (unsigned char*)aligned_alloc(65536, (indexBytes + 65535) & ~(size_t)65535);
+			const double totalBytes = (double)(vertexBytes + indexBytes);
+			const int repeats = quick ? 1 : std::max(5, (int)((1u << 30) / frameSize));
+
+			double best[4] = { 1e9, 1e9, 1e9, 1e9 };
+			ImGui_ImplDX12_UploadJobs jobs;
+			for (int repeat = 0; repeat < repeats; repeat++)
+				for (int mode = 0; mode < 4; mode++)
+				{
+					BenchTimer timer;
+					if (mode == 0)
+					{
+						size_t vertexOffset = 0, indexOffset = 0;
+						for (int list = 0; list < lists; list++)
+						{
+							memcpy(vertexDst + vertexOffset, vertices[list].data(), vertices[list].size());
+							memcpy(indexDst + indexOffset, indices[list].data(), indices[list].size());
+							vertexOffset += vertices[list].size();
+							indexOffset += indices[list].size();
+						}
+					}
+					else
+					{
+						// building the job list is part of the backend's cost
+						jobs.Clear();
+						size_t offset = 0;
+						for (int list = 0; list < lists; list++)
+						{
+							jobs.AddCopy(vertexDst + offset, vertices[list].data(), vertices[list].size());
+							offset += vertices[list].size();
+						}
+						offset = 0;
+						for (int list = 0; list < lists; list++)
+						{
+							jobs.AddCopy(indexDst + offset, indices[list].data(), indices[list].size());
+							offset += indices[list].size();
+						}
+						RunJobs(jobs, jobs.Finish(), mode == 1 ? 1 : mode == 2 ? 2 : 4);
+					}
+					best[mode] = std::min(best[mode], timer.Seconds());
+					DoNotOptimize(vertexDst[0]);
+				}
+			printf("%-8.0f %5d %8.2f %8.2f %8.2f %8.2f\n", frameSize / 1048576.0, lists,
+				totalBytes / best[0] / 1e9, totalBytes / best[1] / 1e9, totalBytes / best[2] / 1e9, totalBytes / best[3] / 1e9);
+			free(vertexDst);
+			free(indexDst);
+		}
+	}
+	return 0;
+}
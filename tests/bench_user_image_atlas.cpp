@@ -0,0 +1,102 @@
+// a synthesized toolbar: rows of 40 ImageButton() with text between them, drawn with its icons as
+// separate textures and with them registered with ImFontAtlas::AddUserImage(). draw calls and cpu
+// time per frame for 12 icons on 240 buttons, for 200 icons cycling through them, and for 400 48 px
+// images in an atlas capped at 512x512, which keeps evicting and packing them again: 240 of them
+// don't fit at once and the rest keep their own textures, 60 do
+#include "bench.h"
+#include "imgui_headless.h"
+#include "imgui_internal.h"
+#include <cstdio>
+#include <vector>
+
+struct Scenario
+{
+	const char* name;
+	int buttons, textures, size, maxAtlasSize;
+	bool cycle;
+};
+
+static ImTextureID IconId(int icon)
+{
+	return (ImTextureID)(intptr_t)(0x10000 + icon);
+}
+
+static void Toolbar(const Scenario& scenario, int frame)
+{
+	ImGui::SetNextWindowPos(ImVec2(0, 0));
+	ImGui::SetNextWindowSize(ImVec2(1920, 1080));
+	ImGui::Begin("toolbar", nullptr, ImGuiWindowFlags_NoSavedSettings);
+	const float size = (float)ImMin(scenario.size, 32);
+	for (int row = 0; row * 40 < scenario.buttons; row++)
+	{
+		ImGui::Text("row %d", row);
+		for (int button = 0; button < 40 && row * 40 + button < scenario.buttons; button++)
+		{
+			const int slot = row * 40 + button;
+			const int icon = (scenario.cycle ? slot + frame * 7 : slot) % scenario.textures;
+			ImGui::SameLine();
+			ImGui::PushID(slot);
+			ImGui::ImageButton("##icon", ImTextureRef(IconId(icon)), ImVec2(size, size));
+			ImGui::PopID();
+			if (button % 8 == 7)
+			{
+				ImGui::SameLine();
+				ImGui::TextUnformatted("|");
+			}
+		}
+	}
+	ImGui::End();
+}
+
+static void Run(const Scenario& scenario, bool atlased, int frames)
+{
+	HeadlessImGui imgui(1920.0f, 1080.0f);
+	ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+	if (scenario.maxAtlasSize > 0)
+		atlas->TexMaxWidth = atlas->TexMaxHeight = scenario.maxAtlasSize;
+	if (atlased)
+	{
+		std::vector<ImU32> pixels((size_t)scenario.size * scenario.size);
+		for (int icon = 0; icon < scenario.textures; icon++)
+		{
+			for (size_t i = 0; i < pixels.size(); i++)
+				pixels[i] = (ImU32)(icon * 2654435761u + i * 40503u) | IM_COL32_A_MASK;
+			atlas->AddUserImage(IconId(icon), pixels.data(), scenario.size, scenario.size);
+		}
+	}
+	for (int frame = 0; frame < 3; frame++)
+		imgui.Frame([&] { Toolbar(scenario, frame); });
+
+	long long drawCalls = 0;
+	BenchTimer timer;
+	for (int frame = 0; frame < frames; frame++)
+	{
+		ImDrawData* drawData = imgui.Frame([&] { Toolbar(scenario, frame); });
+		for (ImDrawList* list : drawData->CmdLists)
+			for (const ImDrawCmd& cmd : list->CmdBuffer)
+				drawCalls += cmd.ElemCount > 0;
+	}
+	const double ms = timer.Milliseconds() / frames;
+	int resident = 0;
+	for (ImFontAtlasUserImage* image : atlas->UserImages)
+		resident += image->PackId != ImFontAtlasRectId_Invalid;
+	printf("%-32s %-8s %6.1f draw calls/frame, %6.3f ms/frame, atlas %4dx%-4d, %3d images in atlas\n", scenario.name, atlased ? "atlased" : "separate",
+		(double)drawCalls / frames, ms, atlas->TexData->Width, atlas->TexData->Height, resident);
+}
+
+int main(int argc, char** argv)
+{
+	const int frames = IsQuickRun(argc, argv) ? 10 : 500;
+	static const Scenario scenarios[] = {
+		{ "12 icons", 240, 12, 24, 0, false },
+		{ "200 icons cycling", 240, 200, 24, 0, true },
+		{ "400 x 48 px, atlas <= 512x512", 240, 400, 48, 512, true },
+		{ "400 x 48 px, 60 buttons", 60, 400, 48, 512, true },
+	};
+	for (const Scenario& scenario : scenarios)
+	{
+		Run(scenario, false, frames);
+		Run(scenario, true, frames);
+	}
+	return 0;
+}
@@ -0,0 +1,79 @@
+// compare_draw_dumps <expected> <actual> [position tolerance] [uv tolerance]
+// compares two draw dumps record by record: same vertex and index counts, same indices and
+// colors, positions and uvs within the tolerances (0 = bit exact, the default)
+#include "draw_dump.h"
+#include <cmath>
+#include <cstdlib>
+
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		printf("usage: compare_draw_dumps <expected> <actual> [position tolerance] [uv tolerance]\n");
+		return 2;
+	}
+	const float posTolerance = argc > 3 ? (float)atof(argv[3]) : 0.0f;
+	const float uvTolerance = argc > 4 ? (float)atof(argv[4]) : 0.0f;
+	FILE* expectedFile = fopen(argv[1], "rb");
+	FILE* actualFile = fopen(argv[2], "rb");
+	if (expectedFile == nullptr || actualFile == nullptr)
+	{
+		printf("can't open %s\n", expectedFile == nullptr ? argv[1] : argv[2]);
+		return 2;
+	}
+
+	int records = 0, mismatches = 0;
+	float maxPosError = 0.0f, maxUvError = 0.0f;
+	DumpRecord expected, actual;
+	for (;; records++)
+	{
+		const bool hasExpected = ReadDumpRecord(expectedFile, expected);
+		const bool hasActual = ReadDumpRecord(actualFile, actual);
+		if (hasExpected != hasActual)
+		{
+			printf("record count differs after %d records\n", records);
+			return 1;
+		}
+		if (!hasExpected)
+			break;
+
+		if (expected.vertices.size() != actual.vertices.size() || expected.indices != actual.indices)
+		{
+			if (mismatches++ < 10)
+				printf("record %d: %zu/%zu vertices, %zu/%zu indices%s\n", records, expected.vertices.size(), actual.vertices.size(),
+					expected.indices.size(), actual.indices.size(), expected.indices.size() == actual.indices.size() ? " (different)" : "");
+			continue;
+		}
+		for (size_t i = 0; i < expected.vertices.size(); i++)
+		{
+			const DumpVertex& a = expected.vertices[i];
+			const DumpVertex& b = actual.vertices[i];
+			const float posError = fmaxf(fabsf(a.x - b.x), fabsf(a.y - b.y));
+			const float uvError = fmaxf(fabsf(a.u - b.u), fabsf(a.v - b.v));
+			maxPosError = fmaxf(maxPosError, posError);
+			maxUvError = fmaxf(maxUvError, uvError);
+			if (a.col != b.col || !(posError <= posTolerance) || !(uvError <= uvTolerance))
+			{
+				if (mismatches++ < 10)
+					printf("record %d vertex %zu: (%g %g %g %g %08x) vs (%g %g %g %g %08x)\n", records, i,
+						a.x, a.y, a.u, a.v, a.col, b.x, b.y, b.u, b.v, b.col);
+			}
+		}
+	}
+	fclose(expectedFile);
+	fclose(actualFile);
+
+	printf("%d records, max position error %g, max uv error %g\n", records, maxPosError, maxUvError);
+	if (mismatches > 0)
+	{
+		printf("FAILED: %d mismatch(es)\n", mismatches);
+		return 1;
+	}
+	if (records == 0)
+	{
+		printf("FAILED: empty dumps\n");
+		return 1;
+	}
+	printf("ok\n");
+	return 0;
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include "imgui.h"
+#include "imgui_internal.h"
+
+// the stb_truetype font loader, counting what the atlas asks of it: one FontBakedInit() per font
+// size baked, one FontBakedLoadGlyph() per glyph rasterized. install before adding fonts
+
+struct CountingFontLoader
+{
+	static inline int bakes = 0;
+	static inline int glyphs = 0;
+
+	static void Install(ImFontAtlas* atlas)
+	{
+		static ImFontLoader loader;
+		loader = *ImFontAtlasGetFontLoaderForStbTruetype();
+		loader.Name = "stb_truetype (counting)";
+		loader.FontBakedInit = BakedInit;
+		loader.FontBakedLoadGlyph = LoadGlyph;
+		atlas->SetFontLoader(&loader);
+	}
+
+	static void Reset() { bakes = glyphs = 0; }
+
+private:
+	static bool BakedInit(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, void* loaderData)
+	{
+		bakes++;
+		const ImFontLoader* base = ImFontAtlasGetFontLoaderForStbTruetype();
+		return base->FontBakedInit == nullptr || base->FontBakedInit(atlas, src, baked, loaderData);
+	}
+
+	static bool LoadGlyph(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, void* loaderData, ImWchar codepoint, ImFontGlyph* outGlyph, float* outAdvanceX)
+	{
+		glyphs++;
+		return ImFontAtlasGetFontLoaderForStbTruetype()->FontBakedLoadGlyph(atlas, src, baked, loaderData, codepoint, outGlyph, outAdvanceX);
+	}
+};
@@ -0,0 +1,32 @@
+#pragma once
+#include "imgui.h"
+#include <cmath>
+
+// the demo window next to a window of circles, bezier curves, scaled text and a multicolor rect
+// that move every frame, with the mouse sweeping over the demo. a typical large imgui frame
+
+inline void DemoScene(int frame)
+{
+	ImGuiIO& io = ImGui::GetIO();
+	io.MousePos = ImVec2(300.0f + (frame % 50) * 7.3f, 200.0f + (frame % 30) * 5.1f);
+	ImGui::SetNextWindowPos(ImVec2(10, 10), ImGuiCond_Once);
+	ImGui::SetNextWindowSize(ImVec2(1000, 1000), ImGuiCond_Once);
+	ImGui::ShowDemoWindow();
+
+	ImGui::SetNextWindowPos(ImVec2(1020, 10), ImGuiCond_Once);
+	ImGui::Begin("Shapes");
+	ImDrawList* drawList = ImGui::GetWindowDrawList();
+	const ImVec2 p = ImGui::GetCursorScreenPos();
+	for (int i = 0; i < 40; i++)
+	{
+		const float t = frame * 0.03f + i * 0.37f;
+		drawList->AddCircle(ImVec2(p.x + 200 + 150 * cosf(t), p.y + 200 + 150 * sinf(t * 1.3f)), 10.0f + i, IM_COL32(255, i * 6, 0, 255), 0, 1.0f + (i % 4) * 0.7f);
+		drawList->AddBezierCubic(ImVec2(p.x + i * 9.1f, p.y + 400), ImVec2(p.x + 100, p.y + 300 + i), ImVec2(p.x + 300, p.y + 500 - i),
+			ImVec2(p.x + 420, p.y + 400 + i * 1.7f), IM_COL32(0, 255, i * 6, 255), 1.3f);
+		drawList->AddText(nullptr, 13.0f + i * 0.25f, ImVec2(p.x + 10 + i * 0.33f, p.y + 520 + i * 11.3f), IM_COL32_WHITE, "The quick brown fox jumps over the lazy dog");
+	}
+	drawList->AddRectFilledMultiColor(ImVec2(p.x, p.y + 1000), ImVec2(p.x + 300, p.y + 1050),
+		IM_COL32(255, 0, 0, 255), IM_COL32(0, 255, 0, 255), IM_COL32(0, 0, 255, 255), IM_COL32(255, 255, 0, 255));
+	ImGui::Dummy(ImVec2(450, 1060));
+	ImGui::End();
+}
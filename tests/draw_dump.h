@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// draw list dumps, to compare the output of imgui builds that can't be linked into one
+// executable (simd vs scalar, ...). the file format does not depend on the ImDrawVert
+// layout, so compare_draw_dumps reads it without imgui
+
+struct DumpVertex
+{
+	float x, y, u, v;
+	uint32_t col;
+};
+
+struct DumpRecord
+{
+	std::vector<DumpVertex> vertices;
+	std::vector<uint32_t> indices;
+};
+
+// copies a draw list's buffers, called as MakeDumpRecord<ImVec2>(drawList). pos and uv only have
+// to convert to ImVec2, so this works with IMGUI_USE_COMPACT_DRAWVERT too
+template<typename Vec2, typename DrawList>
+DumpRecord MakeDumpRecord(const DrawList* drawList)
+{
+	DumpRecord record;
+	record.vertices.reserve(drawList->VtxBuffer.Size);
+	for (const auto& vertex : drawList->VtxBuffer)
+	{
+		const Vec2 pos = vertex.pos;
+		const Vec2 uv = vertex.uv;
+		record.vertices.push_back({ pos.x, pos.y, uv.x, uv.y, vertex.col });
+	}
+	record.indices.assign(drawList->IdxBuffer.begin(), drawList->IdxBuffer.end());
+	return record;
+}
+
+inline bool WriteDumpRecord(FILE* file, const DumpRecord& record)
+{
+	const uint32_t counts[2] = { (uint32_t)record.vertices.size(), (uint32_t)record.indices.size() };
+	return fwrite(counts, sizeof(counts), 1, file) == 1 &&
+		fwrite(record.vertices.data(), sizeof(DumpVertex), counts[0], file) == counts[0] &&
+		fwrite(record.indices.data(), sizeof(uint32_t), counts[1], file) == counts[1];
+}
+
+// false at the end of the file
+inline bool ReadDumpRecord(FILE* file, DumpRecord& record)
+{
+	uint32_t counts[2];
+	if (fread(counts, sizeof(counts), 1, file) != 1)
+		return false;
+	record.vertices.resize(counts[0]);
+	record.indices.resize(counts[1]);
+	return fread(record.vertices.data(), sizeof(DumpVertex), counts[0], file) == counts[0] &&
+		fread(record.indices.data(), sizeof(uint32_t), counts[1], file) == counts[1];
+}
@@ -0,0 +1,28 @@
+// dump_demo <output>: renders the demo scene for 60 frames and writes every draw list. built with
+// and without IMGUI_USE_COMPACT_DRAWVERT, which must only round positions and uvs
+#include "demo_scene.h"
+#include "draw_dump.h"
+#include "imgui_headless.h"
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		printf("usage: dump_demo <output>\n");
+		return 2;
+	}
+	FILE* file = fopen(argv[1], "wb");
+	if (file == nullptr)
+		return 2;
+
+	HeadlessImGui imgui(1920.0f, 1080.0f);
+	bool written = true;
+	for (int frame = 0; frame < 60; frame++)
+	{
+		ImDrawData* drawData = imgui.Frame([&] { DemoScene(frame); });
+		for (const ImDrawList* drawList : drawData->CmdLists)
+			written &= WriteDumpRecord(file, MakeDumpRecord<ImVec2>(drawList));
+	}
+	fclose(file);
+	return written ? 0 : 1;
+}
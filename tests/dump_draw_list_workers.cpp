@@ -0,0 +1,84 @@
+// dump_draw_list_workers <output>: draws the worker scene into a window for 30 frames and writes
+// the window's draw list as is: its vertex and index buffers, then its commands (element count,
+// offsets, clip rect, texture, callback). built with DRAW_LIST_WORKER_THREADS=0 it draws the slices
+// on the imgui thread, otherwise they are recorded by ImDrawListWorkers on that many threads and
+// merged, which must write the same bytes. with 16-bit indices frames stay under 64K vertices:
+// past that Merge() starts a new VtxOffset where a worker's vertices no longer fit rather than at
+// the primitive that overflowed, so the vertices match but not the indices. 32-bit builds go to
+// about 160K vertices
+#include "draw_dump.h"
+#include "imgui_headless.h"
+#include "job_pool.h"
+#include "worker_scene.h"
+#include <cstring>
+
+#ifndef DRAW_LIST_WORKER_THREADS
+#define DRAW_LIST_WORKER_THREADS 0
+#endif
+
+static uint32_t FloatBits(float value)
+{
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+static DumpRecord MakeCommandRecord(const ImDrawList* drawList)
+{
+	DumpRecord record;
+	for (const ImDrawCmd& cmd : drawList->CmdBuffer)
+	{
+		const uint32_t fields[] = { cmd.ElemCount, cmd.IdxOffset, cmd.VtxOffset, FloatBits(cmd.ClipRect.x), FloatBits(cmd.ClipRect.y),
+			FloatBits(cmd.ClipRect.z), FloatBits(cmd.ClipRect.w), (uint32_t)cmd.GetTexID(), cmd.UserCallback != nullptr ? 1u : 0u };
+		record.indices.insert(record.indices.end(), fields, fields + 9);
+	}
+	return record;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		printf("usage: dump_draw_list_workers <output>\n");
+		return 2;
+	}
+	FILE* file = fopen(argv[1], "wb");
+	if (file == nullptr)
+		return 2;
+
+	HeadlessImGui imgui(1920.0f, 1080.0f);
+	JobPool pool(DRAW_LIST_WORKER_THREADS > 0 ? DRAW_LIST_WORKER_THREADS : 1);
+	ImDrawListWorkers workers;
+	bool written = true;
+	for (int frame = 0; frame < 30; frame++)
+	{
+		// about 8 vertices per point
+		const int slices = 1 + frame % 8;
+		const int points = ((sizeof(ImDrawIdx) == 2 ? 7000 : 20000) >> (frame % 5)) / slices;
+		ImDrawList* windowDrawList = nullptr;
+		imgui.Frame([&] {
+			ImGui::SetNextWindowPos(ImVec2(0, 0));
+			ImGui::SetNextWindowSize(ImVec2(1920, 1080));
+			ImGui::Begin("canvas", nullptr, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoDecoration);
+			windowDrawList = ImGui::GetWindowDrawList();
+			windowDrawList->AddRectFilled(ImVec2(20, 20), ImVec2(1900, 1060), IM_COL32(30, 30, 40, 255));
+			if (DRAW_LIST_WORKER_THREADS == 0)
+			{
+				for (int slice = 0; slice < slices; slice++)
+					DrawWorkerSlice(windowDrawList, slice, points, frame);
+			}
+			else
+			{
+				workers.Begin(windowDrawList, slices);
+				pool.Run(slices, [&](int slice) { DrawWorkerSlice(workers.GetDrawList(slice), slice, points, frame); });
+				workers.Merge(windowDrawList);
+			}
+			windowDrawList->AddRect(ImVec2(20, 20), ImVec2(1900, 1060), IM_COL32_WHITE);
+			ImGui::End();
+		});
+		written &= WriteDumpRecord(file, MakeDumpRecord<ImVec2>(windowDrawList));
+		written &= WriteDumpRecord(file, MakeCommandRecord(windowDrawList));
+	}
+	fclose(file);
+	return written ? 0 : 1;
+}
@@ -0,0 +1,65 @@
+// dump_tables <output>: renders the table scene for 160 frames and writes what gets rasterized. in
+// place splitter merging pads channel ranges with degenerate triangles, so each record holds the
+// non-degenerate triangles as a vertex list, and per command its clip rect, texture, callback flag
+// and triangle count as "indices". built with and without IMGUI_DISABLE_SPLITTER_IN_PLACE_MERGE
+#include "draw_dump.h"
+#include "imgui_headless.h"
+#include "table_scene.h"
+#include <cstring>
+
+static uint32_t FloatBits(float value)
+{
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+static DumpRecord MakeTriangleRecord(const ImDrawData* drawData)
+{
+	DumpRecord record;
+	for (const ImDrawList* drawList : drawData->CmdLists)
+		for (const ImDrawCmd& cmd : drawList->CmdBuffer)
+		{
+			if (cmd.UserCallback == nullptr && cmd.ElemCount == 0)
+				continue;
+			uint32_t triangles = 0;
+			for (unsigned int i = 0; i + 3 <= cmd.ElemCount; i += 3)
+			{
+				const ImDrawIdx* idx = drawList->IdxBuffer.Data + cmd.IdxOffset + i;
+				if (idx[0] == idx[1] && idx[1] == idx[2])
+					continue;
+				for (int k = 0; k < 3; k++)
+				{
+					const ImDrawVert& vertex = drawList->VtxBuffer[idx[k] + cmd.VtxOffset];
+					record.vertices.push_back({ vertex.pos.x, vertex.pos.y, vertex.uv.x, vertex.uv.y, vertex.col });
+				}
+				triangles++;
+			}
+			const uint32_t header[] = { FloatBits(cmd.ClipRect.x), FloatBits(cmd.ClipRect.y), FloatBits(cmd.ClipRect.z), FloatBits(cmd.ClipRect.w),
+				(uint32_t)cmd.GetTexID(), cmd.UserCallback != nullptr ? 1u : 0u, triangles };
+			record.indices.insert(record.indices.end(), header, header + 7);
+		}
+	return record;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		printf("usage: dump_tables <output>\n");
+		return 2;
+	}
+	FILE* file = fopen(argv[1], "wb");
+	if (file == nullptr)
+		return 2;
+
+	HeadlessImGui imgui(1920.0f, 1440.0f);
+	bool written = true;
+	for (int frame = 0; frame < 160; frame++)
+	{
+		ImDrawData* drawData = imgui.Frame([&] { TableScene(frame); });
+		written &= WriteDumpRecord(file, MakeTriangleRecord(drawData));
+	}
+	fclose(file);
+	return written ? 0 : 1;
+}
@@ -0,0 +1,61 @@
+// dump_tessellation <output>: tessellates random polylines and polygons (open/closed, thin/thick,
+// textured and untextured anti-aliasing, degenerate segments, all point counts up to 61 so every
+// simd tail length is hit) and writes the vertex/index buffers. built once per simd configuration,
+// compare_draw_dumps checks the builds agree
+#include "draw_dump.h"
+#include "imgui_headless.h"
+#include <vector>
+
+static unsigned g_randomState = 1;
+
+static float RandomFloat()
+{
+	g_randomState = g_randomState * 1664525u + 1013904223u;
+	return (g_randomState >> 8) / 16777216.0f;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		printf("usage: dump_tessellation <output>\n");
+		return 2;
+	}
+	FILE* file = fopen(argv[1], "wb");
+	if (file == nullptr)
+		return 2;
+
+	HeadlessImGui imgui(1920.0f, 1080.0f);
+	std::vector<ImVec2> points;
+	bool written = true;
+	for (int shape = 0; shape < 600; shape++)
+	{
+		imgui.NewFrame();
+		ImDrawList* drawList = ImGui::GetBackgroundDrawList();
+		const int count = 2 + shape % 60;
+		points.resize(count);
+		for (ImVec2& point : points)
+			point = ImVec2(RandomFloat() * 800.0f, RandomFloat() * 600.0f);
+		if (shape % 5 == 0)
+			for (int i = 1; i < count; i += 3)
+				points[i] = points[i - 1]; // zero length segments
+		const float thickness = (shape % 4 == 0) ? 1.0f : 0.5f + RandomFloat() * 6.0f;
+		if (shape % 7 == 0)
+			drawList->Flags &= ~ImDrawListFlags_AntiAliasedLinesUseTex;
+		if (shape % 11 == 0)
+			drawList->Flags &= ~(ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedFill);
+
+		drawList->AddPolyline(points.data(), count, IM_COL32(255, 0, 0, 255), (shape & 1) ? ImDrawFlags_Closed : 0, thickness);
+		if (count >= 3)
+		{
+			drawList->AddConvexPolyFilled(points.data(), count, IM_COL32(0, 255, 0, 200));
+			drawList->AddConcavePolyFilled(points.data(), count, IM_COL32(0, 0, 255, 200));
+		}
+		drawList->AddCircle(ImVec2(400, 300), 10.0f + RandomFloat() * 200.0f, IM_COL32_WHITE, 0, thickness);
+		drawList->AddCircleFilled(ImVec2(400, 300), 10.0f + RandomFloat() * 200.0f, IM_COL32_WHITE);
+		written &= WriteDumpRecord(file, MakeDumpRecord<ImVec2>(drawList));
+		imgui.EndFrame();
+	}
+	fclose(file);
+	return written ? 0 : 1;
+}
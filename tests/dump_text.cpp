@@ -0,0 +1,64 @@
+// dump_text <output>: renders random strings (ascii, latin-1, other utf-8, broken sequences, line
+// breaks, tabs) at random sizes, positions and clip rects, with and without wrapping and cpu fine
+// clipping, and writes the draw lists. the sse glyph quad writer has to match the scalar one
+#include "draw_dump.h"
+#include "imgui_headless.h"
+#include <string>
+
+static unsigned g_randomState = 1;
+
+static unsigned RandomInt()
+{
+	g_randomState = g_randomState * 1664525u + 1013904223u;
+	return g_randomState >> 8;
+}
+
+static float RandomFloat()
+{
+	return (RandomInt() & 0xFFFFFF) / 16777216.0f;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		printf("usage: dump_text <output>\n");
+		return 2;
+	}
+	FILE* file = fopen(argv[1], "wb");
+	if (file == nullptr)
+		return 2;
+
+	static const char* pieces[] = { "hello", " ", "world", "\n", "\r\n", "\xC3\xA9t\xC3\xA9", "\xC2\xB0", "\xE2\x82\xAC",
+		"\xE6\x97\xA5\xE6\x9C\xAC", "\t", "\xC3", "\xC2\x41", "ABCDEFGHIJKLMNOPQRSTUVWXYZ", "0123456789", "{}[]()<>", "\xC3\xBF", "\x7F" };
+	HeadlessImGui imgui(1920.0f, 1080.0f);
+	std::string text;
+	bool written = true;
+	for (int iteration = 0; iteration < 600; iteration++)
+	{
+		imgui.NewFrame();
+		ImDrawList* drawList = ImGui::GetBackgroundDrawList();
+		text.clear();
+		const size_t length = 1 + RandomInt() % 400;
+		while (text.size() < length)
+			text += pieces[RandomInt() % (sizeof(pieces) / sizeof(pieces[0]))];
+		const float size = (iteration % 3 == 0) ? 13.0f : 8.0f + RandomFloat() * 30.0f;
+		const ImVec2 pos(RandomFloat() * 400.0f - 100.0f, RandomFloat() * 400.0f - 100.0f);
+		ImVec4 clip(RandomFloat() * 300.0f, RandomFloat() * 300.0f, 0.0f, 0.0f);
+		clip.z = clip.x + RandomFloat() * 600.0f;
+		clip.w = clip.y + RandomFloat() * 600.0f;
+		if (iteration % 9 == 0)
+			clip = ImVec4(-1e9f, -1e9f, 1e9f, 1e9f);
+		const float wrapWidth = (iteration % 4 == 1) ? RandomFloat() * 300.0f : 0.0f;
+		const bool cpuFineClip = (iteration % 5 == 2);
+		const ImU32 col = IM_COL32(RandomInt() & 255, RandomInt() & 255, RandomInt() & 255, RandomInt() & 255);
+		// sometimes cut in the middle of a utf-8 sequence
+		const size_t end = (iteration % 13 == 0 && text.size() > 2) ? text.size() - RandomInt() % 3 : text.size();
+		ImGui::GetFont()->RenderText(drawList, size, pos, col, clip, text.c_str(), text.c_str() + end, wrapWidth, cpuFineClip);
+		drawList->AddText(ImVec2(10, 10), col, text.c_str());
+		written &= WriteDumpRecord(file, MakeDumpRecord<ImVec2>(drawList));
+		imgui.EndFrame();
+	}
+	fclose(file);
+	return written ? 0 : 1;
+}
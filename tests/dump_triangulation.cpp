@@ -0,0 +1,53 @@
+// dump_triangulation <output>: fills random concave polygons (noisy stars of both windings, combs,
+// spirals and self-intersecting ones, anti-aliased and not) and writes the draw lists. built with
+// the reflex grid and with IM_TRIANGULATOR_GRID_MIN_REFLEXES high enough that IsEar() always scans
+// every reflex, the reference algorithm. both have to emit the same triangles in the same order
+#include "draw_dump.h"
+#include "imgui_headless.h"
+#include "polygons.h"
+#include <vector>
+
+static unsigned g_randomState = 1;
+
+static float RandomFloat()
+{
+	g_randomState = g_randomState * 1664525u + 1013904223u;
+	return (g_randomState >> 8) / 16777216.0f;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		printf("usage: dump_triangulation <output>\n");
+		return 2;
+	}
+	FILE* file = fopen(argv[1], "wb");
+	if (file == nullptr)
+		return 2;
+
+	HeadlessImGui imgui(1920.0f, 1080.0f);
+	std::vector<ImVec2> points;
+	bool written = true;
+	for (int polygon = 0; polygon < 1500; polygon++)
+	{
+		imgui.NewFrame();
+		ImDrawList* drawList = ImGui::GetBackgroundDrawList();
+		const int count = 3 + (int)(RandomFloat() * (polygon < 1200 ? 300 : 2000));
+		switch (polygon % 5)
+		{
+		case 0: MakeStar(points, count, 0.9f, false, RandomFloat); break;
+		case 1: MakeStar(points, count, 0.5f, true, RandomFloat); break;
+		case 2: MakeComb(points, 1 + count / 4); break;
+		case 3: MakeSpiral(points, count < 6 ? 6 : count); break;
+		default: MakeRandomPolygon(points, count < 60 ? count : 60, RandomFloat); break;
+		}
+		if (polygon & 1)
+			drawList->Flags &= ~ImDrawListFlags_AntiAliasedFill;
+		drawList->AddConcavePolyFilled(points.data(), (int)points.size(), IM_COL32_WHITE);
+		written &= WriteDumpRecord(file, MakeDumpRecord<ImVec2>(drawList));
+		imgui.EndFrame();
+	}
+	fclose(file);
+	return written ? 0 : 1;
+}
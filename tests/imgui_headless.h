@@ -0,0 +1,67 @@
+#pragma once
+#include "imgui.h"
+#include <cstdint>
+
+// runs imgui frames without a window or renderer. textures requested by imgui are
+// acknowledged with fake ids so the font atlas works like it would with a real backend.
+// a new instance becomes the current context, switch between several with MakeCurrent()
+
+class HeadlessImGui
+{
+public:
+	explicit HeadlessImGui(float width = 1280.0f, float height = 720.0f)
+	{
+		IMGUI_CHECKVERSION();
+		m_context = ImGui::CreateContext();
+		ImGui::SetCurrentContext(m_context);
+		ImGuiIO& io = ImGui::GetIO();
+		io.DisplaySize = ImVec2(width, height);
+		io.DeltaTime = 1.0f / 60.0f;
+		io.IniFilename = nullptr;
+		io.LogFilename = nullptr;
+		io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures | ImGuiBackendFlags_RendererHasVtxOffset;
+	}
+	~HeadlessImGui() { ImGui::DestroyContext(m_context); }
+	HeadlessImGui(const HeadlessImGui&) = delete;
+	HeadlessImGui& operator=(const HeadlessImGui&) = delete;
+
+	ImGuiContext* GetContext() const { return m_context; }
+	void MakeCurrent() { ImGui::SetCurrentContext(m_context); }
+	void NewFrame() { ImGui::NewFrame(); }
+
+	// renders and services texture requests, returns the frame's draw data
+	ImDrawData* EndFrame()
+	{
+		ImGui::Render();
+		ProcessTextures();
+		return ImGui::GetDrawData();
+	}
+
+	template<typename Fn>
+	ImDrawData* Frame(Fn fn)
+	{
+		NewFrame();
+		fn();
+		return EndFrame();
+	}
+
+	static void ProcessTextures()
+	{
+		for (ImTextureData* tex : ImGui::GetPlatformIO().Textures)
+		{
+			if (tex->Status == ImTextureStatus_WantCreate || tex->Status == ImTextureStatus_WantUpdates)
+			{
+				tex->SetTexID((ImTextureID)(intptr_t)(tex->UniqueID + 1));
+				tex->SetStatus(ImTextureStatus_OK);
+			}
+			else if (tex->Status == ImTextureStatus_WantDestroy && tex->UnusedFrames > 0)
+			{
+				tex->SetTexID(ImTextureID_Invalid);
+				tex->SetStatus(ImTextureStatus_Destroyed);
+			}
+		}
+	}
+
+private:
+	ImGuiContext* m_context;
+};
@@ -0,0 +1,89 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// a fixed set of threads that run numbered jobs, standing in for the application's job system.
+// Run() hands out jobs 0 to count-1 to the pool threads and the calling thread, and returns once
+// all of them are done. threads are started once, so Run() only costs a wake up and a join
+
+class JobPool
+{
+public:
+	// 'threads' counts the calling thread, JobPool(1) runs everything on the caller
+	explicit JobPool(int threads)
+	{
+		for (int i = 1; i < threads; i++)
+			m_threads.emplace_back([this] { WorkerLoop(); });
+	}
+	~JobPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_quit = true;
+		}
+		m_wake.notify_all();
+		for (std::thread& thread : m_threads)
+			thread.join();
+	}
+	JobPool(const JobPool&) = delete;
+	JobPool& operator=(const JobPool&) = delete;
+
+	int ThreadCount() const { return (int)m_threads.size() + 1; }
+
+	void Run(int count, const std::function<void(int)>& job)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_job = &job;
+			m_count = count;
+			m_next = 0;
+			m_busy = (int)m_threads.size();
+			m_generation++;
+		}
+		m_wake.notify_all();
+		RunJobs();
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_done.wait(lock, [this] { return m_busy == 0; });
+		m_job = nullptr;
+	}
+
+private:
+	void RunJobs()
+	{
+		for (int job = m_next++; job < m_count; job = m_next++)
+			(*m_job)(job);
+	}
+
+	void WorkerLoop()
+	{
+		unsigned generation = 0;
+		for (;;)
+		{
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_wake.wait(lock, [&] { return m_quit || m_generation != generation; });
+				if (m_quit)
+					return;
+				generation = m_generation;
+			}
+			RunJobs();
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (--m_busy == 0)
+				m_done.notify_one();
+		}
+	}
+
+	std::vector<std::thread> m_threads;
+	std::mutex m_mutex;
+	std::condition_variable m_wake, m_done;
+	const std::function<void(int)>* m_job = nullptr;
+	int m_count = 0;
+	std::atomic<int> m_next{ 0 };
+	int m_busy = 0;
+	unsigned m_generation = 0;
+	bool m_quit = false;
+};
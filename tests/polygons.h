@@ -0,0 +1,62 @@
+#pragma once
+#include <cmath>
+#include <vector>
+
+// polygon generators for the triangulator tests. stars, combs and spirals are simple polygons,
+// random ones self-intersect. the caller passes the random source so each test keeps its sequence
+
+template<typename Vec2, typename Random>
+void MakeStar(std::vector<Vec2>& points, int count, float noise, bool counterClockwise, Random&& random)
+{
+	points.resize(count);
+	for (int i = 0; i < count; i++)
+	{
+		const float angle = (counterClockwise ? -1.0f : 1.0f) * 6.2831853f * i / count;
+		const float radius = 300.0f * (1.0f - noise * random());
+		points[i] = Vec2(400.0f + cosf(angle) * radius, 400.0f + sinf(angle) * radius);
+	}
+}
+
+// deep thin teeth: lots of reflexes and long base triangles, the triangulator's worst case
+template<typename Vec2>
+void MakeComb(std::vector<Vec2>& points, int teeth)
+{
+	points.clear();
+	for (int i = 0; i < teeth; i++)
+	{
+		const float x = i * 4.0f;
+		points.push_back(Vec2(x, 0.0f));
+		points.push_back(Vec2(x + 2.0f, 500.0f));
+		points.push_back(Vec2(x + 3.0f, 500.0f));
+		points.push_back(Vec2(x + 4.0f, 0.5f));
+	}
+	points.push_back(Vec2(teeth * 4.0f, -10.0f));
+	points.push_back(Vec2(0.0f, -10.0f));
+}
+
+template<typename Vec2>
+void MakeSpiral(std::vector<Vec2>& points, int count)
+{
+	points.clear();
+	for (int i = 0; i < count / 2; i++)
+	{
+		const float angle = i * 0.05f;
+		const float radius = 10.0f + angle * 8.0f;
+		points.push_back(Vec2(cosf(angle) * radius, sinf(angle) * radius));
+	}
+	for (int i = count / 2 - 1; i >= 0; i--)
+	{
+		const float angle = i * 0.05f;
+		const float radius = 14.0f + angle * 8.0f;
+		points.push_back(Vec2(cosf(angle) * radius, sinf(angle) * radius));
+	}
+}
+
+// points on a 20x20 integer grid: self-intersecting, duplicated and collinear points
+template<typename Vec2, typename Random>
+void MakeRandomPolygon(std::vector<Vec2>& points, int count, Random&& random)
+{
+	points.resize(count);
+	for (Vec2& point : points)
+		point = Vec2(floorf(random() * 20.0f), floorf(random() * 20.0f));
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// a grid of dashboard panels (text, progress bar, plot, checkbox, button, slider, a 6x3 table and
+// more rows than fit, so they scroll). every 'liveEvery'th panel gets new values each frame, the
+// others only change when clicked. with 'retained' each panel uses SetNextWindowRefreshPolicy()
+// with ImGuiWindowRefreshFlags_RefreshOnInputsChange and a hash of its data
+
+struct RetainedPanel
+{
+	float values[32];
+	float progress;
+	float slider;
+	int clicks;
+	bool checked;
+};
+
+struct RetainedScene
+{
+	std::vector<RetainedPanel> panels;
+	int columns;
+	int liveEvery;
+	bool tint = false; // push a window background color around every panel
+
+	RetainedScene(int count, int columns, int liveEvery) : panels(count), columns(columns), liveEvery(liveEvery)
+	{
+		for (int i = 0; i < count; i++)
+			Animate(i, 0);
+	}
+
+	void Animate(int panel, int frame)
+	{
+		RetainedPanel& data = panels[panel];
+		for (int k = 0; k < 32; k++)
+			data.values[k] = sinf((k + frame) * 0.3f + panel);
+		data.progress = (float)((panel * 7 + frame) % 100) / 100.0f;
+	}
+
+	void Update(int frame)
+	{
+		for (int i = 0; i < (int)panels.size(); i += liveEvery)
+			Animate(i, frame);
+	}
+
+	ImVec2 PanelSize() const
+	{
+		const ImVec2 display = ImGui::GetIO().DisplaySize;
+		const int rows = ((int)panels.size() + columns - 1) / columns;
+		return ImVec2(floorf(display.x / columns) - 10.0f, floorf(display.y / rows) - 10.0f);
+	}
+
+	ImVec2 PanelPos(int panel) const
+	{
+		const ImVec2 size = PanelSize();
+		return ImVec2(5.0f + (panel % columns) * (size.x + 10.0f), 5.0f + (panel / columns) * (size.y + 10.0f));
+	}
+
+	void Draw(bool retained)
+	{
+		for (int i = 0; i < (int)panels.size(); i++)
+		{
+			RetainedPanel& data = panels[i];
+			char name[32];
+			snprintf(name, sizeof(name), "panel %d", i);
+			ImGui::SetNextWindowPos(PanelPos(i), ImGuiCond_FirstUseEver);
+			ImGui::SetNextWindowSize(PanelSize(), ImGuiCond_FirstUseEver);
+			if (retained)
+				ImGui::SetNextWindowRefreshPolicy(ImGuiWindowRefreshFlags_TryToAvoidRefresh | ImGuiWindowRefreshFlags_RefreshOnInputsChange, ImHashData(&data, sizeof(data)));
+			if (tint)
+				ImGui::PushStyleColor(ImGuiCol_WindowBg, IM_COL32(40, 20, 60, 255));
+			if (ImGui::Begin(name, nullptr, ImGuiWindowFlags_NoSavedSettings))
+			{
+				ImGui::Text("%s: %.3f", name, data.values[0]);
+				ImGui::ProgressBar(data.progress);
+				ImGui::PlotLines("##plot", data.values, 32, 0, nullptr, -1.0f, 1.0f, ImVec2(0, 40));
+				ImGui::Checkbox("enabled", &data.checked);
+				ImGui::SameLine();
+				if (ImGui::Button("click"))
+					data.clicks++;
+				ImGui::SameLine();
+				ImGui::Text("%d clicks", data.clicks);
+				ImGui::SliderFloat("##slider", &data.slider, 0.0f, 1.0f);
+				if (ImGui::BeginTable("table", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+				{
+					for (int row = 0; row < 6; row++)
+					{
+						ImGui::TableNextRow();
+						for (int column = 0; column < 3; column++)
+						{
+							ImGui::TableSetColumnIndex(column);
+							ImGui::Text("%.2f", data.values[row * 3 + column]);
+						}
+					}
+					ImGui::EndTable();
+				}
+			}
+			ImGui::End();
+			if (tint)
+				ImGui::PopStyleColor();
+		}
+	}
+};
@@ -0,0 +1,83 @@
+// one stb_truetype variant, STB_TRUETYPE_VARIANT names its table (see stb_truetype_variant.h)
+#include "stb_truetype_variant.h"
+#include <cstddef>
+
+#define STBTT_STATIC
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "imstb_truetype.h"
+
+static_assert(sizeof(StbOutlineVertex) == sizeof(stbtt_vertex), "StbOutlineVertex must match stbtt_vertex");
+static_assert(offsetof(StbOutlineVertex, cy1) == offsetof(stbtt_vertex, cy1) && offsetof(StbOutlineVertex, type) == offsetof(stbtt_vertex, type), "StbOutlineVertex must match stbtt_vertex");
+
+static const stbtt_fontinfo* FontInfo(const StbTrueTypeFont* font)
+{
+	return (const stbtt_fontinfo*)font;
+}
+
+static StbTrueTypeFont* LoadFont(const unsigned char* data)
+{
+	const int offset = stbtt_GetFontOffsetForIndex(data, 0);
+	stbtt_fontinfo* info = new stbtt_fontinfo();
+	if (offset < 0 || !stbtt_InitFont(info, data, offset))
+	{
+		delete info;
+		return nullptr;
+	}
+	return (StbTrueTypeFont*)info;
+}
+
+static void FreeFont(StbTrueTypeFont* font)
+{
+	delete (stbtt_fontinfo*)font;
+}
+
+static int GlyphCount(const StbTrueTypeFont* font)
+{
+	return FontInfo(font)->numGlyphs;
+}
+
+static float ScaleForPixelHeight(const StbTrueTypeFont* font, float pixels)
+{
+	return stbtt_ScaleForPixelHeight(FontInfo(font), pixels);
+}
+
+static void GlyphBitmapBox(const StbTrueTypeFont* font, int glyph, float scaleX, float scaleY, float shiftX, float shiftY, int* x0, int* y0, int* x1, int* y1)
+{
+	stbtt_GetGlyphBitmapBoxSubpixel(FontInfo(font), glyph, scaleX, scaleY, shiftX, shiftY, x0, y0, x1, y1);
+}
+
+static void MakeGlyphBitmap(const StbTrueTypeFont* font, unsigned char* output, int w, int h, int stride, float scaleX, float scaleY, float shiftX, float shiftY, int oversampleX, int oversampleY, int glyph)
+{
+	float subX, subY;
+	stbtt_MakeGlyphBitmapSubpixelPrefilter(FontInfo(font), output, w, h, stride, scaleX, scaleY, shiftX, shiftY, oversampleX, oversampleY, &subX, &subY, glyph);
+}
+
+static void Rasterize(unsigned char* pixels, int w, int h, const StbOutlineVertex* vertices, int count, float scale, float shiftX, float shiftY, int xOff, int yOff)
+{
+	stbtt__bitmap bitmap = { w, h, w, pixels };
+	stbtt_Rasterize(&bitmap, 0.35f, (stbtt_vertex*)vertices, count, scale, scale, shiftX, shiftY, xOff, yOff, 1, nullptr);
+}
+
+static unsigned char* GlyphSDF(const StbTrueTypeFont* font, float scale, int glyph, int padding, unsigned char onEdgeValue, float pixelDistScale, int* w, int* h)
+{
+	int xOff, yOff;
+	return stbtt_GetGlyphSDF(FontInfo(font), scale, glyph, padding, onEdgeValue, pixelDistScale, w, h, &xOff, &yOff);
+}
+
+static void FreeBitmap(unsigned char* bitmap)
+{
+	stbtt_FreeSDF(bitmap, nullptr);
+}
+
+#if defined(STBTT__SSE2) || defined(STBTT__NEON)
+static const bool Simd = true;
+#else
+static const bool Simd = false;
+#endif
+
+#define STB_TRUETYPE_VARIANT_NAME2(name) #name
+#define STB_TRUETYPE_VARIANT_NAME(name) STB_TRUETYPE_VARIANT_NAME2(name)
+
+extern const StbTrueTypeVariant STB_TRUETYPE_VARIANT = {
+	STB_TRUETYPE_VARIANT_NAME(STB_TRUETYPE_VARIANT), Simd, LoadFont, FreeFont, GlyphCount, ScaleForPixelHeight, GlyphBitmapBox, MakeGlyphBitmap, Rasterize, GlyphSDF, FreeBitmap
+};
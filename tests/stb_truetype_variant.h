@@ -0,0 +1,71 @@
+#pragma once
+#include <vector>
+
+// the stb_truetype rasterizer built twice, once as is and once with STBTT_ENABLE_SIMD the way
+// imgui_draw.cpp builds it. stb_truetype_variant.cpp is compiled into one library per variant (its
+// functions are static and extern "C", so two copies can't share a translation unit) and each
+// library fills in one of these tables
+
+struct StbTrueTypeFont;
+
+// stbtt_vertex, an outline in font units
+struct StbOutlineVertex
+{
+	short x, y, cx, cy, cx1, cy1;
+	unsigned char type, padding;
+};
+
+enum StbOutlineVertexType { StbOutline_Move = 1, StbOutline_Line, StbOutline_Curve, StbOutline_Cubic };
+
+struct StbTrueTypeVariant
+{
+	const char* name;
+	bool simd; // false if STBTT_ENABLE_SIMD found neither sse2 nor neon
+	StbTrueTypeFont* (*LoadFont)(const unsigned char* data); // the first font of a ttf/ttc, nullptr if it isn't one
+	void (*FreeFont)(StbTrueTypeFont* font);
+	int (*GlyphCount)(const StbTrueTypeFont* font);
+	float (*ScaleForPixelHeight)(const StbTrueTypeFont* font, float pixels);
+	void (*GlyphBitmapBox)(const StbTrueTypeFont* font, int glyph, float scaleX, float scaleY, float shiftX, float shiftY, int* x0, int* y0, int* x1, int* y1);
+	// stbtt_MakeGlyphBitmapSubpixelPrefilter(), as the atlas bakes glyphs
+	void (*MakeGlyphBitmap)(const StbTrueTypeFont* font, unsigned char* output, int w, int h, int stride, float scaleX, float scaleY, float shiftX, float shiftY, int oversampleX, int oversampleY, int glyph);
+	// stbtt_Rasterize() with the y axis flipped, as for glyphs
+	void (*Rasterize)(unsigned char* pixels, int w, int h, const StbOutlineVertex* vertices, int count, float scale, float shiftX, float shiftY, int xOff, int yOff);
+	// stbtt_GetGlyphSDF(), exact distances to the outline, free the bitmap with FreeBitmap()
+	unsigned char* (*GlyphSDF)(const StbTrueTypeFont* font, float scale, int glyph, int padding, unsigned char onEdgeValue, float pixelDistScale, int* w, int* h);
+	void (*FreeBitmap)(unsigned char* bitmap);
+};
+
+extern const StbTrueTypeVariant StbScalar;
+extern const StbTrueTypeVariant StbSimd;
+
+// closed contours in a 2048 unit em square with random lines, quadratic and cubic curves: some
+// contours clockwise and some not, overlapping and self intersecting. stands in for a vector font
+template<typename Random>
+std::vector<StbOutlineVertex> MakeRandomOutline(Random& random, int maxContours, int minSegments, int maxSegments)
+{
+	auto coordinate = [&] { return (short)(random() % 2049); };
+	std::vector<StbOutlineVertex> vertices;
+	const int contours = 1 + (int)(random() % maxContours);
+	for (int contour = 0; contour < contours; contour++)
+	{
+		StbOutlineVertex move = {};
+		move.type = StbOutline_Move;
+		move.x = coordinate();
+		move.y = coordinate();
+		vertices.push_back(move);
+		const int segments = minSegments + (int)(random() % (maxSegments - minSegments + 1));
+		for (int segment = 0; segment < segments; segment++)
+		{
+			StbOutlineVertex vertex = {};
+			vertex.type = (unsigned char)(StbOutline_Line + random() % 3);
+			vertex.x = coordinate();
+			vertex.y = coordinate();
+			vertex.cx = coordinate();
+			vertex.cy = coordinate();
+			vertex.cx1 = coordinate();
+			vertex.cy1 = coordinate();
+			vertices.push_back(vertex);
+		}
+	}
+	return vertices;
+}
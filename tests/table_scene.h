@@ -0,0 +1,108 @@
+#pragma once
+#include "imgui.h"
+
+// a window of tables exercising ImDrawListSplitter: a hideable table whose row count and cell text
+// change every frame with callbacks in cells, a frozen scrolling table with a clipper (four merge
+// groups), and nested tables with ChannelsSplit() and legacy columns in their cells
+
+inline void TableSceneCallback(const ImDrawList*, const ImDrawCmd*) {}
+
+inline void TableScene(int frame)
+{
+	ImGui::SetNextWindowPos(ImVec2(0, 0));
+	ImGui::SetNextWindowSize(ImVec2(1900, 1400));
+	ImGui::Begin("Tables");
+	const int rows = 120 + (frame % 37) * 3;
+	const bool hideColumn = (frame / 40) % 2 == 1;
+
+	if (ImGui::BeginTable("plain", 8, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Hideable))
+	{
+		for (int column = 0; column < 8; column++)
+			ImGui::TableSetupColumn(column == 3 ? "Three" : "Col", (column == 5 && hideColumn) ? ImGuiTableColumnFlags_DefaultHide : 0);
+		ImGui::TableSetColumnEnabled(5, !hideColumn);
+		ImGui::TableHeadersRow();
+		for (int row = 0; row < rows; row++)
+		{
+			ImGui::TableNextRow();
+			for (int column = 0; column < 8; column++)
+			{
+				if (!ImGui::TableSetColumnIndex(column))
+					continue;
+				if (column == 2)
+					ImGui::Button("Btn");
+				else if (column == 4 && (row % 7) == 0)
+					ImGui::TextUnformatted("a much longer piece of text that does not fit in the column and gets clipped");
+				else
+					ImGui::Text("%d,%d %.*s", row, column, (row * 7 + column + frame) % 9, "xxxxxxxxx");
+				if (column == 6 && (row % 50) == 3)
+					ImGui::GetWindowDrawList()->AddCallback(TableSceneCallback, nullptr);
+			}
+		}
+		ImGui::EndTable();
+	}
+
+	if (ImGui::BeginTable("frozen", 12, ImGuiTableFlags_ScrollX | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable, ImVec2(900, 400)))
+	{
+		ImGui::TableSetupScrollFreeze(1, 1);
+		for (int column = 0; column < 12; column++)
+			ImGui::TableSetupColumn("F", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+		ImGui::TableHeadersRow();
+		ImGuiListClipper clipper;
+		clipper.Begin(500);
+		while (clipper.Step())
+			for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+			{
+				ImGui::TableNextRow();
+				for (int column = 0; column < 12; column++)
+				{
+					ImGui::TableSetColumnIndex(column);
+					ImGui::Text("r%d c%d", row, column);
+				}
+			}
+		if (frame % 10 == 0)
+			ImGui::SetScrollY(ImGui::GetScrollY() + 37.0f);
+		ImGui::EndTable();
+	}
+
+	if (ImGui::BeginTable("outer", 3, ImGuiTableFlags_Borders))
+	{
+		for (int row = 0; row < 6; row++)
+		{
+			ImGui::TableNextRow();
+			ImGui::TableSetColumnIndex(0);
+			ImGui::Text("outer %d", row);
+			ImGui::TableSetColumnIndex(1);
+			if (ImGui::BeginTable("inner", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+			{
+				for (int innerRow = 0; innerRow < 4 + (row + frame) % 5; innerRow++)
+				{
+					ImGui::TableNextRow();
+					for (int column = 0; column < 4; column++)
+					{
+						ImGui::TableSetColumnIndex(column);
+						ImGui::Text("%d.%d", innerRow, column);
+					}
+				}
+				ImGui::EndTable();
+			}
+			ImGui::TableSetColumnIndex(2);
+			ImDrawList* drawList = ImGui::GetWindowDrawList();
+			const ImVec2 pos = ImGui::GetCursorScreenPos();
+			drawList->ChannelsSplit(2);
+			drawList->ChannelsSetCurrent(1);
+			drawList->AddRectFilled(pos, ImVec2(pos.x + 40, pos.y + 10), IM_COL32(255, 0, 0, 255));
+			drawList->ChannelsSetCurrent(0);
+			drawList->AddRectFilled(pos, ImVec2(pos.x + 20, pos.y + 20), IM_COL32(0, 255, 0, 255));
+			drawList->ChannelsMerge();
+			ImGui::Columns(3, "columns");
+			for (int i = 0; i < 6; i++)
+			{
+				ImGui::Text("column %d", i);
+				ImGui::NextColumn();
+			}
+			ImGui::Columns(1);
+		}
+		ImGui::EndTable();
+	}
+	ImGui::End();
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdio>
+
+// minimal checks for the test executables. a failed CHECK prints where it failed and
+// the test keeps going, main returns TestResult() so ctest sees the failure
+
+inline int g_testFailures = 0;
+
+#define CHECK(cond) \
+	do { \
+		if (!(cond)) \
+		{ \
+			g_testFailures++; \
+			if (g_testFailures <= 20) \
+				printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+		} \
+	} while (0)
+
+inline int TestResult()
+{
+	if (g_testFailures > 0)
+	{
+		printf("FAILED: %d check(s)\n", g_testFailures);
+		return 1;
+	}
+	printf("ok\n");
+	return 0;
+}
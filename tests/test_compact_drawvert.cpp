@@ -0,0 +1,74 @@
+// IMGUI_USE_COMPACT_DRAWVERT: the 12-byte vertex, positions rounded to the nearest 1/8 pixel and
+// saturated, uvs rounded to the nearest unorm16 and clamped to 0..1. whole frames are compared
+// against the default layout by the *_compact_drawvert dump comparisons
+#include "imgui.h"
+#include "test.h"
+#include <cmath>
+
+static_assert(sizeof(ImDrawVert) == 12, "built without IMGUI_USE_COMPACT_DRAWVERT");
+
+static int ExpectedPos(float v)
+{
+	const float steps = floorf(v * (1 << IMGUI_DRAWVERT_POS_SUBPIXEL_BITS) + 0.5f);
+	return (int)fminf(fmaxf(steps, -32768.0f), 32767.0f);
+}
+
+static int ExpectedUV(float v)
+{
+	return (int)floorf(fminf(fmaxf(v, 0.0f), 1.0f) * 65535.0f + 0.5f);
+}
+
+static void TestPositions()
+{
+	int wrong = 0;
+	for (float v = -5000.0f; v < 5000.0f; v += 0.0137f)
+	{
+		ImDrawVertPos16 pos;
+		pos = ImVec2(v, -v);
+		wrong += (pos.X != ExpectedPos(v)) + (pos.Y != ExpectedPos(-v));
+	}
+	CHECK(wrong == 0);
+
+	// steps and half steps, both signs: half steps round up
+	for (int step = -200; step <= 200; step++)
+	{
+		const float v = step / 8.0f;
+		ImDrawVertPos16 pos;
+		pos = ImVec2(v, v + 1.0f / 16.0f);
+		CHECK(pos.X == step && pos.Y == step + 1);
+		const ImVec2 back = pos;
+		CHECK(back.x == v && back.y == v + 0.125f);
+	}
+
+	ImDrawVertPos16 pos;
+	pos = ImVec2(1e9f, -1e9f);
+	CHECK(pos.X == 32767 && pos.Y == -32768);
+	pos = ImVec2(-0.0626f, -0.0624f);
+	CHECK(pos.X == -1 && pos.Y == 0);
+}
+
+static void TestUVs()
+{
+	int wrong = 0;
+	for (float v = -0.5f; v < 1.5f; v += 0.0000131f)
+	{
+		ImDrawVertUV16 uv;
+		uv = ImVec2(v, 1.0f - v);
+		wrong += (uv.U != ExpectedUV(v)) + (uv.V != ExpectedUV(1.0f - v));
+	}
+	CHECK(wrong == 0);
+
+	ImDrawVertUV16 uv;
+	uv = ImVec2(0.0f, 1.0f);
+	const ImVec2 back = uv;
+	CHECK(back.x == 0.0f && back.y == 1.0f);
+	uv = ImVec2(-1e9f, 1e9f);
+	CHECK(uv.U == 0 && uv.V == 65535);
+}
+
+int main()
+{
+	TestPositions();
+	TestUVs();
+	return TestResult();
+}
@@ -0,0 +1,129 @@
+// ConstantRing: slices of the per-draw cbv fallback buffer never overlap one still in use by a
+// frame in flight, are aligned, never wrap around the end, and are recycled by fence value
+#include "constant_ring.h"
+#include "test.h"
+#include <deque>
+#include <random>
+#include <vector>
+
+static void TestSlices()
+{
+	ConstantRing ring(4096, 256);
+	CHECK(ring.GetCapacity() == 4096);
+
+	// every call gets its own slice, rounded up to the alignment
+	const uint64_t a = ring.Allocate(64);
+	const uint64_t b = ring.Allocate(64);
+	const uint64_t c = ring.Allocate(300);
+	CHECK(a == 0 && b == 256 && c == 512);
+	CHECK(ring.GetUsedSize() == 1024);
+	ring.EndFrame(1);
+
+	// the second frame fills the rest, then the ring is full until frame 1 completes
+	for (int i = 0; i < 12; i++)
+		CHECK(ring.Allocate(256) != ConstantRing::InvalidOffset);
+	CHECK(ring.Allocate(1) == ConstantRing::InvalidOffset);
+	ring.EndFrame(2);
+	ring.Retire(0);
+	CHECK(ring.Allocate(1) == ConstantRing::InvalidOffset);
+	ring.Retire(1);
+	CHECK(ring.GetUsedSize() == 3072);
+	CHECK(ring.GetFramesInFlight() == 1);
+
+	// a slice that does not fit before the end starts over at the front
+	CHECK(ring.Allocate(512) == 0);
+	CHECK(ring.Allocate(512) == 512);
+	CHECK(ring.Allocate(256) == ConstantRing::InvalidOffset);
+	ring.EndFrame(3);
+	ring.Retire(3);
+	CHECK(ring.GetUsedSize() == 0);
+	CHECK(ring.GetFramesInFlight() == 0);
+
+	// too big or empty requests fail
+	CHECK(ring.Allocate(8192) == ConstantRing::InvalidOffset);
+	CHECK(ring.Allocate(0) == ConstantRing::InvalidOffset);
+}
+
+static void TestPaddingAtTheEnd()
+{
+	ConstantRing ring(1024, 256);
+	CHECK(ring.Allocate(512) == 0);
+	ring.EndFrame(1);
+	CHECK(ring.Allocate(256) == 512);
+	ring.EndFrame(2);
+	ring.Retire(1);
+
+	// [768, 1024) is free but too small, the slice goes to the front and the end is skipped
+	CHECK(ring.Allocate(512) == 0);
+	CHECK(ring.GetUsedSize() == 1024);
+	CHECK(ring.Allocate(1) == ConstantRing::InvalidOffset);
+	ring.EndFrame(3);
+
+	// the skipped end is freed together with the frame that skipped it
+	ring.Retire(2);
+	CHECK(ring.GetUsedSize() == 768);
+	CHECK(ring.Allocate(256) == 512);
+	ring.EndFrame(4);
+	ring.Retire(4);
+	CHECK(ring.GetUsedSize() == 0);
+	CHECK(ring.Allocate(1024) == 0);
+}
+
+// random frames with a random number of draws and two or three frames in flight, checking
+// every slice against all slices of frames the gpu has not finished yet
+static void TestFuzz()
+{
+	struct Slice
+	{
+		uint64_t offset;
+		uint64_t size;
+		uint64_t fenceValue;
+	};
+
+	std::mt19937 rng(5);
+	ConstantRing ring(64 * 1024, 256);
+	std::deque<Slice> inFlight;
+	uint64_t completed = 0;
+	int failed = 0;
+	for (uint64_t frame = 1; frame <= 20000; frame++)
+	{
+		const int draws = rng() % 40;
+		for (int i = 0; i < draws; i++)
+		{
+			const uint64_t size = rng() % 4 == 0 ? rng() % 2048 + 1 : 64;
+			const uint64_t offset = ring.Allocate(size);
+			if (offset == ConstantRing::InvalidOffset)
+			{
+				failed++;
+				continue;
+			}
+			CHECK(offset % 256 == 0);
+			CHECK(offset + size <= ring.GetCapacity());
+			for (const Slice& other : inFlight)
+				CHECK(offset >= other.offset + ((other.size + 255) & ~255ull) || other.offset >= offset + size);
+			inFlight.push_back({ offset, size, frame });
+		}
+		ring.EndFrame(frame);
+
+		// the gpu lags two or three frames behind
+		const uint64_t lag = 2 + rng() % 2;
+		if (frame > lag && frame - lag > completed)
+			completed = frame - lag;
+		ring.Retire(completed);
+		while (!inFlight.empty() && inFlight.front().fenceValue <= completed)
+			inFlight.pop_front();
+		CHECK(ring.GetFramesInFlight() <= 3);
+	}
+	// 64KB holds three frames of this workload most of the time
+	CHECK(failed < 20000 * 20 / 100);
+	ring.Retire(UINT64_MAX);
+	CHECK(ring.GetUsedSize() == 0);
+}
+
+int main()
+{
+	TestSlices();
+	TestPaddingAtTheEnd();
+	TestFuzz();
+	return TestResult();
+}
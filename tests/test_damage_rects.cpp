@@ -0,0 +1,278 @@
+// DamageTracker: rect merging, and the damage it reports for imgui frames that change in known ways
+#include "damage_rects.h"
+#include "imgui_headless.h"
+#include "test.h"
+#include <random>
+
+static bool Contains(const DamageRect& outer, const DamageRect& inner)
+{
+	return inner.left >= outer.left && inner.top >= outer.top && inner.right <= outer.right && inner.bottom <= outer.bottom;
+}
+
+static bool Overlap(const DamageRect& a, const DamageRect& b)
+{
+	return a.left < b.right && b.left < a.right && a.top < b.bottom && b.top < a.bottom;
+}
+
+// true if every pixel of rect is covered by one of rects
+static bool Covered(const std::vector<DamageRect>& rects, const DamageRect& rect)
+{
+	for (int y = rect.top; y < rect.bottom; y++)
+		for (int x = rect.left; x < rect.right; x++)
+		{
+			bool hit = false;
+			for (const DamageRect& r : rects)
+				hit |= (x >= r.left && x < r.right && y >= r.top && y < r.bottom);
+			if (!hit)
+				return false;
+		}
+	return true;
+}
+
+// item rects include the advance after the last glyph, the glyphs themselves don't reach their edges
+static DamageRect Inset(const DamageRect& rect, int pixels)
+{
+	return { rect.left + pixels, rect.top + pixels, rect.right - pixels, rect.bottom - pixels };
+}
+
+static DamageRect ItemRect()
+{
+	ImVec2 min = ImGui::GetItemRectMin();
+	ImVec2 max = ImGui::GetItemRectMax();
+	return { (int)min.x, (int)min.y, (int)max.x, (int)max.y };
+}
+
+static void TestMergeRects()
+{
+	std::mt19937 rng(1);
+	for (int iter = 0; iter < 2000; iter++)
+	{
+		std::vector<DamageRect> input;
+		const int count = 1 + rng() % 40;
+		for (int i = 0; i < count; i++)
+		{
+			int x = rng() % 1200, y = rng() % 700;
+			input.push_back({ x, y, x + 1 + (int)(rng() % 200), y + 1 + (int)(rng() % 100) });
+		}
+		if (iter % 10 == 0)
+			input.push_back({ 5, 5, 5, 50 }); // empty ones get dropped
+		const int maxRects = 1 + rng() % DamageTracker::MaxDamageRects;
+		std::vector<DamageRect> merged = input;
+		DamageTracker::MergeRects(merged, maxRects);
+
+		CHECK(!merged.empty() && (int)merged.size() <= maxRects);
+		for (size_t i = 0; i < merged.size(); i++)
+			for (size_t j = i + 1; j < merged.size(); j++)
+				CHECK(!Overlap(merged[i], merged[j]));
+		for (const DamageRect& rect : input)
+		{
+			if (rect.IsEmpty())
+				continue;
+			bool contained = false;
+			for (const DamageRect& m : merged)
+				contained |= Contains(m, rect);
+			CHECK(contained);
+		}
+	}
+
+	// disjoint rects under the limit are left alone
+	std::vector<DamageRect> rects = { { 0, 0, 10, 10 }, { 20, 0, 30, 10 }, { 0, 20, 10, 30 } };
+	DamageTracker::MergeRects(rects, 8);
+	CHECK(rects.size() == 3);
+}
+
+static int g_counter = 1234567890; // all digits, so changing it never bakes new glyphs
+static float g_windowX = 300.0f;
+static DamageRect g_counterRect;
+static DamageRect g_labelRect;
+static DamageRect g_windowRect;
+static bool g_callback = false;
+static float g_newGlyphSize = 0.0f;
+
+static void DashboardFrame()
+{
+	ImGui::SetNextWindowPos(ImVec2(10, 10));
+	ImGui::SetNextWindowSize(ImVec2(250, 200));
+	ImGui::Begin("stats");
+	ImGui::Text("static label");
+	g_labelRect = ItemRect();
+	ImGui::Text("counter: %d", g_counter);
+	g_counterRect = ItemRect();
+	ImGui::Button("button");
+	if (g_callback)
+		ImGui::GetWindowDrawList()->AddCallback([](const ImDrawList*, const ImDrawCmd*) {}, nullptr);
+	ImGui::End();
+
+	ImGui::SetNextWindowPos(ImVec2(g_windowX, 300));
+	ImGui::SetNextWindowSize(ImVec2(200, 100));
+	ImGui::Begin("mover");
+	ImGui::Text("moving window");
+	if (g_newGlyphSize > 0.0f)
+	{
+		// a size not used before, its glyphs get baked into the atlas this frame
+		ImGui::PushFont(nullptr, g_newGlyphSize);
+		ImGui::Text("baked");
+		ImGui::PopFont();
+	}
+	ImVec2 pos = ImGui::GetWindowPos(), size = ImGui::GetWindowSize();
+	g_windowRect = { (int)pos.x, (int)pos.y, (int)(pos.x + size.x), (int)(pos.y + size.y) };
+	ImGui::End();
+}
+
+static void Track(HeadlessImGui& imgui, DamageTracker& tracker)
+{
+	imgui.NewFrame();
+	DashboardFrame();
+	ImGui::Render();
+	tracker.BeginFrame(1280, 720);
+	tracker.AddDrawData(ImGui::GetDrawData());
+	tracker.EndFrame();
+	HeadlessImGui::ProcessTextures();
+}
+
+static void TestFrames()
+{
+	HeadlessImGui imgui;
+	DamageTracker tracker(2);
+
+	// nothing to compare with yet
+	Track(imgui, tracker);
+	CHECK(tracker.IsFullRedraw() && tracker.IsFrameDamageFull());
+	CHECK(tracker.GetRedrawPixels() == tracker.GetFramePixels());
+
+	// static frames settle to no damage once both back buffers are up to date
+	for (int i = 0; i < 4; i++)
+		Track(imgui, tracker);
+	CHECK(!tracker.IsFullRedraw());
+	CHECK(tracker.GetFrameDamage().empty());
+	CHECK(tracker.GetRedrawPixels() == 0);
+
+	// a changing number damages (at least) its own text, and not much more
+	const DamageRect before = g_counterRect;
+	g_counter = 12345;
+	Track(imgui, tracker);
+	CHECK(!tracker.IsFullRedraw());
+	CHECK(!tracker.GetFrameDamage().empty());
+	CHECK(Covered(tracker.GetFrameDamage(), Inset(g_counterRect, 2)));
+	CHECK(Covered(tracker.GetFrameDamage(), Inset(before, 2)));
+	CHECK(tracker.GetRedrawPixels() < tracker.GetFramePixels() / 20);
+
+	// the other back buffer still shows the old number: redrawn once more, but not presented as damage
+	Track(imgui, tracker);
+	CHECK(tracker.GetFrameDamage().empty());
+	CHECK(Covered(tracker.GetRedrawRects(), Inset(g_counterRect, 2)));
+	Track(imgui, tracker);
+	CHECK(tracker.GetRedrawPixels() == 0);
+
+	// a moved window damages where it was and where it is now
+	const DamageRect oldWindow = g_windowRect;
+	g_windowX = 700.0f;
+	Track(imgui, tracker);
+	CHECK(Covered(tracker.GetFrameDamage(), oldWindow));
+	CHECK(Covered(tracker.GetFrameDamage(), g_windowRect));
+	for (const DamageRect& rect : tracker.GetFrameDamage())
+		CHECK(!Overlap(rect, g_counterRect)); // the other window is untouched
+	Track(imgui, tracker);
+	Track(imgui, tracker);
+	CHECK(tracker.GetRedrawPixels() == 0);
+
+	// callbacks may draw anything, their clip rect is damaged every frame
+	g_callback = true;
+	Track(imgui, tracker);
+	Track(imgui, tracker);
+	Track(imgui, tracker);
+	CHECK(!tracker.GetFrameDamage().empty());
+	g_callback = false;
+	Track(imgui, tracker);
+	Track(imgui, tracker);
+	Track(imgui, tracker);
+	CHECK(tracker.GetRedrawPixels() == 0);
+
+	// damage from outside imgui is clipped to the frame
+	imgui.NewFrame();
+	DashboardFrame();
+	ImGui::Render();
+	tracker.BeginFrame(1280, 720);
+	tracker.AddRect({ -50, -50, 40, 30 });
+	tracker.AddDrawData(ImGui::GetDrawData());
+	tracker.EndFrame();
+	CHECK(tracker.GetFrameDamage().size() == 1);
+	CHECK(tracker.GetFrameDamage().size() == 1 && tracker.GetFrameDamage()[0].left == 0 && tracker.GetFrameDamage()[0].top == 0 &&
+		tracker.GetFrameDamage()[0].right == 40 && tracker.GetFrameDamage()[0].bottom == 30);
+
+	// a full frame request, and a resize, redraw everything
+	imgui.NewFrame();
+	DashboardFrame();
+	ImGui::Render();
+	tracker.BeginFrame(1280, 720);
+	tracker.AddFullFrame();
+	tracker.AddDrawData(ImGui::GetDrawData());
+	tracker.EndFrame();
+	CHECK(tracker.IsFullRedraw() && tracker.IsFrameDamageFull());
+
+	for (int i = 0; i < 3; i++)
+		Track(imgui, tracker);
+	CHECK(tracker.GetRedrawPixels() == 0);
+	imgui.NewFrame();
+	DashboardFrame();
+	ImGui::Render();
+	tracker.BeginFrame(1920, 1080);
+	tracker.AddDrawData(ImGui::GetDrawData());
+	tracker.EndFrame();
+	CHECK(tracker.IsFullRedraw());
+	CHECK(tracker.GetRedrawPixels() == 1920 * 1080);
+}
+
+// a texture update changes what unchanged commands show, e.g. new glyphs baked into the font atlas
+static void TestTextureUpdates()
+{
+	HeadlessImGui imgui;
+	DamageTracker tracker(2);
+	for (int i = 0; i < 5; i++)
+		Track(imgui, tracker);
+	CHECK(tracker.GetRedrawPixels() == 0);
+
+	// the atlas grows while everything else stays the same: every command drawing from it is damage
+	g_newGlyphSize = 37.0f;
+	imgui.NewFrame();
+	DashboardFrame();
+	ImGui::Render();
+	ImTextureData* atlas = ImGui::GetIO().Fonts->TexData;
+	CHECK(atlas->Status == ImTextureStatus_WantUpdates);
+	tracker.BeginFrame(1280, 720);
+	tracker.AddDrawData(ImGui::GetDrawData());
+	tracker.EndFrame();
+	HeadlessImGui::ProcessTextures();
+	CHECK(!tracker.IsFrameDamageFull());
+	CHECK(Covered(tracker.GetFrameDamage(), Inset(g_labelRect, 2)));
+	CHECK(Covered(tracker.GetFrameDamage(), Inset(g_counterRect, 2)));
+
+	// both back buffers catch up, then nothing is damaged once the atlas is uploaded
+	Track(imgui, tracker);
+	CHECK(Covered(tracker.GetRedrawRects(), Inset(g_labelRect, 2)));
+	Track(imgui, tracker);
+	Track(imgui, tracker);
+	CHECK(tracker.GetRedrawPixels() == 0);
+
+	// a pending destroy does not change anything on screen
+	ImTextureData unused;
+	unused.Status = ImTextureStatus_WantDestroy;
+	imgui.NewFrame();
+	DashboardFrame();
+	ImGui::Render();
+	ImGui::GetDrawData()->Textures->push_back(&unused);
+	tracker.BeginFrame(1280, 720);
+	tracker.AddDrawData(ImGui::GetDrawData());
+	tracker.EndFrame();
+	ImGui::GetDrawData()->Textures->pop_back();
+	CHECK(tracker.GetFrameDamage().empty());
+	g_newGlyphSize = 0.0f;
+}
+
+int main()
+{
+	TestMergeRects();
+	TestFrames();
+	TestTextureUpdates();
+	return TestResult();
+}
@@ -0,0 +1,154 @@
+// ImFontAtlasFlags_AsyncGlyphBaking: glyphs get their final metrics in the frame that first uses them,
+// and once the worker threads are done their pixels match the synchronous rasterizer bit for bit.
+// the atlas survives cache compaction, loader changes and font removal with jobs in flight
+#include "imgui_headless.h"
+#include "imgui_internal.h"
+#include "test.h"
+#include <cstring>
+#include <string>
+#include <thread>
+
+static std::string Latin1Text()
+{
+	std::string text;
+	for (unsigned c = 0x20; c < 0x100; c++)
+	{
+		if (c >= 0x7F && c < 0xA0)
+			continue;
+		char utf8[5];
+		text.append(utf8, ImTextCharToUtf8(utf8, c));
+		if ((c & 31) == 31)
+			text += "\n";
+	}
+	return text;
+}
+
+static float FrameFontSize(int frame)
+{
+	return 12.0f + (frame % 120) * 0.75f; // a new baked size every frame
+}
+
+static void DrawText(ImFont* font, float size, const std::string& text)
+{
+	ImGui::Begin("text");
+	ImGui::PushFont(font, size);
+	ImGui::TextUnformatted(text.c_str());
+	ImGui::PopFont();
+	ImGui::End();
+}
+
+static void DrainJobs(HeadlessImGui& imgui, ImFont* font, const std::string& text)
+{
+	imgui.MakeCurrent();
+	for (int frame = 0; frame < 1000 && (frame < 2 || ImFontAtlasAsyncBakerGetPendingCount(ImGui::GetIO().Fonts) > 0); frame++)
+	{
+		imgui.Frame([&] { DrawText(font, 12.0f, text); });
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	CHECK(ImFontAtlasAsyncBakerGetPendingCount(ImGui::GetIO().Fonts) == 0);
+}
+
+static bool SameGlyph(ImFontAtlas* syncAtlas, const ImFontGlyph* syncGlyph, ImFontAtlas* asyncAtlas, const ImFontGlyph* asyncGlyph)
+{
+	if (syncGlyph->Visible != asyncGlyph->Visible || syncGlyph->AdvanceX != asyncGlyph->AdvanceX ||
+		syncGlyph->X0 != asyncGlyph->X0 || syncGlyph->Y0 != asyncGlyph->Y0 || syncGlyph->X1 != asyncGlyph->X1 || syncGlyph->Y1 != asyncGlyph->Y1)
+		return false;
+	if (!syncGlyph->Visible)
+		return true;
+	const ImTextureRect* syncRect = ImFontAtlasPackGetRect(syncAtlas, syncGlyph->PackId);
+	const ImTextureRect* asyncRect = ImFontAtlasPackGetRect(asyncAtlas, asyncGlyph->PackId);
+	if (syncRect == nullptr || asyncRect == nullptr || syncRect->w != asyncRect->w || syncRect->h != asyncRect->h)
+		return false;
+	const int bytesPerPixel = syncAtlas->TexData->BytesPerPixel;
+	for (int y = 0; y < syncRect->h; y++)
+		if (memcmp(syncAtlas->TexData->GetPixelsAt(syncRect->x, syncRect->y + y), asyncAtlas->TexData->GetPixelsAt(asyncRect->x, asyncRect->y + y), (size_t)(syncRect->w * bytesPerPixel)) != 0)
+			return false;
+	return true;
+}
+
+static void TestMatchesSync()
+{
+	const std::string text = Latin1Text();
+	HeadlessImGui sync;
+	ImFont* syncFont = ImGui::GetIO().Fonts->AddFontDefault();
+	HeadlessImGui async;
+	async.MakeCurrent();
+	ImGui::GetIO().Fonts->Flags |= ImFontAtlasFlags_AsyncGlyphBaking;
+	ImFont* asyncFont = ImGui::GetIO().Fonts->AddFontDefault();
+
+	const int frames = 60;
+	int pendingAfterFirstUse = 0;
+	for (int frame = 0; frame < frames; frame++)
+	{
+		const float size = FrameFontSize(frame);
+		sync.MakeCurrent();
+		sync.Frame([&] { DrawText(syncFont, size, text); });
+		async.MakeCurrent();
+		async.NewFrame();
+		DrawText(asyncFont, size, text);
+
+		// laid out right away: the metrics are there before the pixels
+		ImFontBaked* baked = asyncFont->GetFontBaked(size);
+		const ImFontGlyph* glyph = baked->FindGlyphNoFallback('W');
+		CHECK(glyph != nullptr && glyph->AdvanceX > 0.0f);
+		async.EndFrame();
+		pendingAfterFirstUse += ImFontAtlasAsyncBakerGetPendingCount(ImGui::GetIO().Fonts) > 0 ? 1 : 0;
+	}
+	CHECK(pendingAfterFirstUse > 0); // or the glyphs were never baked on the workers
+	DrainJobs(async, asyncFont, text);
+
+	int checked = 0, mismatches = 0;
+	for (int frame = 0; frame < frames; frame++)
+	{
+		const float size = FrameFontSize(frame);
+		sync.MakeCurrent();
+		ImFontAtlas* syncAtlas = ImGui::GetIO().Fonts;
+		ImFontBaked* syncBaked = syncFont->GetFontBaked(size);
+		async.MakeCurrent();
+		ImFontAtlas* asyncAtlas = ImGui::GetIO().Fonts;
+		ImFontBaked* asyncBaked = asyncFont->GetFontBaked(size);
+		for (unsigned c = 0x20; c < 0x100; c++)
+		{
+			const ImFontGlyph* syncGlyph = syncBaked->FindGlyphNoFallback((ImWchar)c);
+			const ImFontGlyph* asyncGlyph = asyncBaked->FindGlyphNoFallback((ImWchar)c);
+			CHECK((syncGlyph == nullptr) == (asyncGlyph == nullptr));
+			if (syncGlyph == nullptr || asyncGlyph == nullptr)
+				continue;
+			checked++;
+			mismatches += SameGlyph(syncAtlas, syncGlyph, asyncAtlas, asyncGlyph) ? 0 : 1;
+		}
+	}
+	CHECK(checked > frames * 90);
+	CHECK(mismatches == 0);
+}
+
+// baked fonts, loaders and fonts going away while their glyphs are still being rasterized
+static void TestStress()
+{
+	const std::string text = Latin1Text();
+	HeadlessImGui async;
+	ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+	atlas->Flags |= ImFontAtlasFlags_AsyncGlyphBaking;
+	ImFont* font = atlas->AddFontDefault();
+	for (int frame = 0; frame < 120; frame++)
+	{
+		async.Frame([&] { DrawText(font, FrameFontSize(frame), text); });
+		if (frame % 3 == 0)
+			atlas->CompactCache();
+		if (frame % 50 == 49)
+			atlas->SetFontLoader(ImFontAtlasGetFontLoaderForStbTruetype());
+		if (frame % 40 == 39)
+		{
+			atlas->RemoveFont(font);
+			font = atlas->AddFontDefault();
+		}
+	}
+	DrainJobs(async, font, text);
+}
+
+int main()
+{
+	TestMatchesSync();
+	TestStress();
+	return TestResult();
+}
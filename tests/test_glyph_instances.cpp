@@ -0,0 +1,253 @@
+// ImGuiBackendFlags_RendererHasGlyphInstances: two contexts render the same text heavy scene, one
+// with indexed quads (the default) and one with glyph instances expanded by the cpu reference
+// ImGui::ExpandGlyphInstances(). every frame must hold the same triangles, and an alpha blended
+// rasterization of every fifth frame must match pixel for pixel, which checks that shapes drawn
+// over text still draw after it
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include "imgui_headless.h"
+#include "imgui_internal.h"
+#include "test.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+static void TextScene(int frame)
+{
+	ImGui::SetNextWindowPos(ImVec2(10, 10));
+	ImGui::SetNextWindowSize(ImVec2(900, 1300));
+	ImGui::Begin("Text");
+	ImGui::PushFont(nullptr, 13.0f + (float)((frame / 7) % 9)); // new sizes load glyphs and now and then grow the atlas
+	for (int i = 0; i < 30; i++)
+	{
+		ImGui::Text("Line %d frame %d: The quick brown fox jumps over the lazy dog %.*s", i, frame, (i + frame) % 11, "0123456789ABCDEF");
+		if (i % 9 == 0)
+			ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.2f, 1.0f), "colored %d caf\xC3\xA9 na\xC3\xAFve \xC3\xBC\xC3\xB1 \xE2\x82\xAC \xCE\xB1\xCE\xB2", i);
+		if (i % 13 == 0)
+			ImGui::TextWrapped("Wrapped text which is long enough to wrap on a few lines of this window, as the window is not that wide after all %d", i);
+		if (i % 5 == 0)
+		{
+			ImGui::Button("Button");
+			ImGui::SameLine();
+			ImGui::SmallButton("Small");
+			ImGui::SameLine();
+			static bool checked = false;
+			ImGui::Checkbox("Check", &checked);
+		}
+		if (i % 7 == 3)
+		{
+			// shapes over text in the same command must stay on top of the glyphs
+			ImDrawList* drawList = ImGui::GetWindowDrawList();
+			const ImVec2 p = ImGui::GetItemRectMin();
+			drawList->AddText(ImVec2(p.x + 300, p.y), IM_COL32(255, 255, 0, 255), "under a rect");
+			drawList->AddRectFilled(ImVec2(p.x + 310, p.y + 2), ImVec2(p.x + 340, p.y + 9), IM_COL32(0, 128, 255, 160));
+			drawList->AddRectFilled(ImVec2(p.x + 500, p.y + 2), ImVec2(p.x + 530, p.y + 9), IM_COL32(0, 255, 128, 160));
+			drawList->AddText(ImVec2(p.x + 495, p.y), IM_COL32(255, 0, 255, 200), "over a rect");
+		}
+	}
+	if (ImGui::BeginTable("table", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable))
+	{
+		for (int row = 0; row < 20; row++)
+		{
+			ImGui::TableNextRow();
+			for (int column = 0; column < 4; column++)
+			{
+				ImGui::TableSetColumnIndex(column);
+				if (column == 3 && row % 4 == 0)
+					ImGui::Selectable("selectable", row % 8 == 0);
+				else
+					ImGui::Text("%d,%d some text that will be clipped in the cell %d", row, column, frame);
+			}
+		}
+		ImGui::EndTable();
+	}
+	ImGui::Columns(3, "columns");
+	for (int i = 0; i < 9; i++)
+	{
+		ImGui::Text("column text %d", i);
+		ImGui::NextColumn();
+	}
+	ImGui::Columns(1);
+	ImGui::BeginChild("child", ImVec2(400, 150), ImGuiChildFlags_Borders);
+	for (int i = 0; i < 20; i++)
+		ImGui::Text("child line %d", i);
+	ImGui::SetScrollY((float)(frame % 50) * 3.0f);
+	ImGui::EndChild();
+	ImDrawList* drawList = ImGui::GetWindowDrawList();
+	const ImVec2 cursor = ImGui::GetCursorScreenPos();
+	drawList->ChannelsSplit(2);
+	drawList->ChannelsSetCurrent(1);
+	drawList->AddText(cursor, IM_COL32(255, 255, 255, 255), "channel 1 text");
+	drawList->ChannelsSetCurrent(0);
+	drawList->AddRectFilled(cursor, cursor + ImVec2(200, 20), IM_COL32(80, 0, 0, 255));
+	drawList->AddText(cursor + ImVec2(0, 10), IM_COL32(0, 255, 255, 255), "channel 0 text");
+	drawList->ChannelsMerge();
+	ImGui::Dummy(ImVec2(200, 30));
+	static char text[128] = "input text content";
+	ImGui::InputText("input", text, IM_ARRAYSIZE(text));
+	ImGui::PopFont();
+	ImGui::End();
+
+	ImGui::SetNextWindowPos(ImVec2(950, 10));
+	ImGui::SetNextWindowSize(ImVec2(600, 700));
+	ImGui::Begin("Other");
+	ImGui::SetWindowFontScale(1.0f + 0.25f * ((frame / 30) % 3)); // scaled text stays quads
+	for (int i = 0; i < 20; i++)
+		ImGui::BulletText("bullet %d", i);
+	ImGui::ProgressBar(0.3f, ImVec2(-1, 0), "progress text");
+	ImGui::End();
+}
+
+struct Triangle
+{
+	ImVec4 clip;
+	ImTextureData* tex;
+	int texIndex; // in the context's texture list, ids differ between contexts
+	ImVec2 pos[3], uv[3];
+	ImU32 col[3];
+
+	// compared bytewise, there is no padding
+	bool operator<(const Triangle& other) const { return memcmp(this, &other, sizeof(Triangle)) < 0; }
+	bool operator==(const Triangle& other) const { return memcmp(this, &other, sizeof(Triangle)) == 0; }
+};
+
+static int TextureIndex(ImTextureData* tex)
+{
+	const ImVector<ImTextureData*>& textures = ImGui::GetPlatformIO().Textures;
+	for (int i = 0; i < textures.Size; i++)
+		if (textures[i] == tex)
+			return i;
+	return -1;
+}
+
+static void AddTriangle(std::vector<Triangle>& triangles, const ImDrawCmd& cmd, const ImDrawVert* v0, const ImDrawVert* v1, const ImDrawVert* v2)
+{
+	Triangle triangle = {};
+	triangle.clip = cmd.ClipRect;
+	triangle.texIndex = TextureIndex(cmd.TexRef._TexData);
+	const ImDrawVert* vertices[3] = { v0, v1, v2 };
+	for (int k = 0; k < 3; k++)
+	{
+		triangle.pos[k] = vertices[k]->pos;
+		triangle.uv[k] = vertices[k]->uv;
+		triangle.col[k] = vertices[k]->col;
+	}
+	triangles.push_back(triangle);
+	triangles.back().tex = cmd.TexRef._TexData; // for sampling, not compared
+}
+
+// triangles in draw order, each command's glyph instances expanded after its indexed triangles
+static std::vector<Triangle> CollectTriangles(const ImDrawData* drawData)
+{
+	std::vector<Triangle> triangles;
+	std::vector<ImDrawVert> quads;
+	for (const ImDrawList* drawList : drawData->CmdLists)
+		for (const ImDrawCmd& cmd : drawList->CmdBuffer)
+		{
+			if (cmd.UserCallback != nullptr)
+				continue;
+			const ImDrawVert* vertices = drawList->VtxBuffer.Data + cmd.VtxOffset;
+			for (unsigned int i = 0; i + 3 <= cmd.ElemCount; i += 3)
+			{
+				const ImDrawIdx* idx = drawList->IdxBuffer.Data + cmd.IdxOffset + i;
+				if (idx[0] != idx[1] || idx[1] != idx[2])
+					AddTriangle(triangles, cmd, &vertices[idx[0]], &vertices[idx[1]], &vertices[idx[2]]);
+			}
+			if (cmd.GlyphCount == 0)
+				continue;
+			quads.resize(cmd.GlyphCount * 4);
+			ImGui::ExpandGlyphInstances(drawList, &cmd, quads.data());
+			for (unsigned int glyph = 0; glyph < cmd.GlyphCount; glyph++)
+			{
+				const ImDrawVert* quad = &quads[glyph * 4];
+				AddTriangle(triangles, cmd, &quad[0], &quad[1], &quad[2]);
+				AddTriangle(triangles, cmd, &quad[0], &quad[2], &quad[3]);
+			}
+		}
+	return triangles;
+}
+
+static bool SameTriangles(std::vector<Triangle> expected, std::vector<Triangle> actual)
+{
+	for (Triangle& triangle : expected)
+		triangle.tex = nullptr;
+	for (Triangle& triangle : actual)
+		triangle.tex = nullptr;
+	std::sort(expected.begin(), expected.end());
+	std::sort(actual.begin(), actual.end());
+	return expected == actual;
+}
+
+// alpha blends the triangles in order at pixel centers, scissored like the backends, nearest texel
+static const int g_width = 1600, g_height = 1400;
+
+static std::vector<float> Rasterize(const std::vector<Triangle>& triangles)
+{
+	std::vector<float> image(g_width * g_height * 3, 0.0f);
+	for (const Triangle& t : triangles)
+	{
+		const ImVec2 a = t.pos[0], b = t.pos[1], c = t.pos[2];
+		const float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+		if (area == 0.0f)
+			continue;
+		const int x0 = ImMax(ImMax((int)t.clip.x, 0), (int)floorf(ImMin(a.x, ImMin(b.x, c.x))));
+		const int x1 = ImMin(ImMin((int)t.clip.z, g_width), (int)ceilf(ImMax(a.x, ImMax(b.x, c.x))) + 1);
+		const int y0 = ImMax(ImMax((int)t.clip.y, 0), (int)floorf(ImMin(a.y, ImMin(b.y, c.y))));
+		const int y1 = ImMin(ImMin((int)t.clip.w, g_height), (int)ceilf(ImMax(a.y, ImMax(b.y, c.y))) + 1);
+		for (int y = y0; y < y1; y++)
+			for (int x = x0; x < x1; x++)
+			{
+				const ImVec2 p((float)x + 0.5f, (float)y + 0.5f);
+				const float w0 = ((b.x - p.x) * (c.y - p.y) - (b.y - p.y) * (c.x - p.x)) / area;
+				const float w1 = ((c.x - p.x) * (a.y - p.y) - (c.y - p.y) * (a.x - p.x)) / area;
+				const float w2 = 1.0f - w0 - w1;
+				if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f)
+					continue;
+				float texAlpha = 1.0f;
+				if (t.tex != nullptr && t.tex->Pixels != nullptr)
+				{
+					const float u = w0 * t.uv[0].x + w1 * t.uv[1].x + w2 * t.uv[2].x;
+					const float v = w0 * t.uv[0].y + w1 * t.uv[1].y + w2 * t.uv[2].y;
+					const int tx = ImClamp((int)(u * t.tex->Width), 0, t.tex->Width - 1);
+					const int ty = ImClamp((int)(v * t.tex->Height), 0, t.tex->Height - 1);
+					const unsigned char* texel = (const unsigned char*)t.tex->GetPixelsAt(tx, ty);
+					texAlpha = (t.tex->Format == ImTextureFormat_RGBA32 ? texel[3] : texel[0]) / 255.0f;
+				}
+				const float alpha = ((t.col[0] >> IM_COL32_A_SHIFT) & 0xFF) / 255.0f * texAlpha;
+				float* pixel = &image[(y * g_width + x) * 3];
+				for (int k = 0; k < 3; k++)
+					pixel[k] = ((t.col[0] >> (k * 8)) & 0xFF) / 255.0f * alpha + pixel[k] * (1.0f - alpha);
+			}
+	}
+	return image;
+}
+
+int main()
+{
+	HeadlessImGui quads(1600.0f, 1400.0f), instances(1600.0f, 1400.0f);
+	instances.MakeCurrent();
+	CHECK((ImGui::GetIO().BackendFlags & ImGuiBackendFlags_RendererHasGlyphInstances) == 0); // quads unless the renderer opts in
+	ImGui::GetIO().BackendFlags |= ImGuiBackendFlags_RendererHasGlyphInstances;
+
+	int glyphs = 0, differentFrames = 0, differentImages = 0;
+	for (int frame = 0; frame < 150; frame++)
+	{
+		quads.MakeCurrent();
+		const ImDrawData* quadData = quads.Frame([&] { TextScene(frame); });
+		CHECK(quadData->TotalGlyphCount == 0);
+		const std::vector<Triangle> expected = CollectTriangles(quadData);
+		const std::vector<float> expectedImage = (frame % 5 == 0) ? Rasterize(expected) : std::vector<float>();
+
+		instances.MakeCurrent();
+		const ImDrawData* instanceData = instances.Frame([&] { TextScene(frame); });
+		glyphs += instanceData->TotalGlyphCount;
+		const std::vector<Triangle> actual = CollectTriangles(instanceData);
+		differentFrames += !SameTriangles(expected, actual);
+		if (frame % 5 == 0)
+			differentImages += Rasterize(actual) != expectedImage;
+	}
+	CHECK(glyphs > 150 * 1000); // most text was output as instances
+	CHECK(differentFrames == 0);
+	CHECK(differentImages == 0);
+	return TestResult();
+}
@@ -0,0 +1,139 @@
+// ImHashData() / ImHashStr(), built once per hash backend: the crc32c table, sse 4.2 crc
+// instructions (the avx2 build), IMGUI_USE_FAST_HASH and a user ImHashData() with
+// IMGUI_DISABLE_DEFAULT_HASH_FUNCTIONS. every backend must keep the "###" semantics of ImHashStr(),
+// the crc32c ones must match a bytewise crc32c, and the fast hash must spread single bit changes
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "test.h"
+#include <cstring>
+#include <random>
+#include <vector>
+
+#ifdef IMGUI_DISABLE_DEFAULT_HASH_FUNCTIONS
+// what a user would plug in: fnv-1a, reading the seed like the default backends do
+ImGuiID ImHashData(const void* data, size_t size, ImGuiID seed)
+{
+	ImU32 hash = 2166136261u ^ seed;
+	for (size_t i = 0; i < size; i++)
+		hash = (hash ^ ((const unsigned char*)data)[i]) * 16777619u;
+	return size == 0 ? seed : hash;
+}
+#endif
+
+static void TestTripleHash()
+{
+	CHECK(ImHashStr("Hello###ID", 0, 42) == ImHashStr("World###ID", 0, 42));
+	CHECK(ImHashStr("Hello###ID", 0, 42) == ImHashStr("###ID", 0, 42));
+	CHECK(ImHashStr("Hello###ID", 0, 42) == ImHashData("###ID", 5, 42));
+	CHECK(ImHashStr("Hello###ID", 0, 42) != ImHashStr("Hello###ID", 0, 43));
+	CHECK(ImHashStr("a###b###c", 0, 7) == ImHashStr("###c", 0, 7)); // the last ### wins
+	CHECK(ImHashStr("a####b", 0, 7) == ImHashStr("####b", 0, 7));
+	CHECK(ImHashStr("a####b", 0, 7) == ImHashStr("x####b", 0, 7));
+	CHECK(ImHashStr("a##b##c", 0, 7) != ImHashStr("##c", 0, 7)); // ## doesn't reset
+	CHECK(ImHashStr("ab##", 4, 7) == ImHashData("ab##", 4, 7));
+	CHECK(ImHashStr("ab###", 5, 7) == ImHashStr("###", 3, 7));
+	CHECK(ImHashStr("abc###xyz", 6, 7) == ImHashStr("###", 0, 7)); // a known size ending inside the ### run
+	CHECK(ImHashStr("", 0, 1234) == 1234 && ImHashData("", 0, 1234) == 1234);
+	CHECK(ImHashStr("Label", 0, 99) == ImHashStr("Label", 5, 99));
+	CHECK(ImHashStr("Label", 0, 99) == ImHashData("Label", 5, 99));
+}
+
+// ImHashStr() without ### is ImHashData() over the whole string, for every length and alignment
+static void TestStringMatchesData()
+{
+	char buffer[160];
+	int mismatches = 0;
+	for (int offset = 0; offset < 8; offset++)
+		for (int length = 1; length < 140; length++)
+		{
+			for (int i = 0; i < length; i++)
+				buffer[offset + i] = (char)('a' + (i * 7 + offset) % 26);
+			buffer[offset + length] = 0;
+			const ImGuiID id = ImHashData(buffer + offset, length, 0x1234);
+			mismatches += ImHashStr(buffer + offset, 0, 0x1234) != id;
+			mismatches += ImHashStr(buffer + offset, length, 0x1234) != id;
+		}
+	CHECK(mismatches == 0);
+}
+
+#if !defined(IMGUI_USE_FAST_HASH) && !defined(IMGUI_DISABLE_DEFAULT_HASH_FUNCTIONS) && !defined(IMGUI_USE_LEGACY_CRC32_ADLER)
+static ImGuiID Crc32c(const unsigned char* data, size_t size, ImGuiID seed)
+{
+	ImU32 crc = ~seed;
+	for (size_t i = 0; i < size; i++)
+	{
+		crc ^= data[i];
+		for (int bit = 0; bit < 8; bit++)
+			crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1)));
+	}
+	return ~crc;
+}
+
+// the table and the 8/4/1 byte crc instructions compute the same crc32c, so ids and .ini data don't
+// depend on the build. random data at every alignment and length up to 300 bytes
+static void TestCrc32c()
+{
+	std::mt19937 random(1);
+	std::vector<unsigned char> data(320);
+	int mismatches = 0;
+	for (int round = 0; round < 20; round++)
+	{
+		for (unsigned char& byte : data)
+			byte = (unsigned char)random();
+		const ImGuiID seed = (ImGuiID)random();
+		for (int offset = 0; offset < 8; offset++)
+			for (int size = 0; size < 300; size++)
+				mismatches += ImHashData(data.data() + offset, size, seed) != Crc32c(data.data() + offset, size, seed);
+	}
+	CHECK(mismatches == 0);
+	CHECK(ImHashStr("Debug##Default") == Crc32c((const unsigned char*)"Debug##Default", 14, 0));
+}
+#endif
+
+#ifdef IMGUI_USE_FAST_HASH
+// flipping any one bit of a 1-40 byte key flips about half the bits of the id. a hash whose
+// differences only carry upwards fails this on the low bits
+static void TestFastHashAvalanche()
+{
+	std::mt19937 random(2);
+	unsigned char key[40];
+	double flippedBits = 0.0;
+	int samples = 0, unchanged = 0;
+	for (int size = 1; size <= 40; size++)
+		for (int round = 0; round < 20; round++)
+		{
+			for (unsigned char& byte : key)
+				byte = (unsigned char)random();
+			const ImGuiID id = ImHashData(key, size, 0);
+			for (int bit = 0; bit < size * 8; bit++)
+			{
+				key[bit / 8] ^= (unsigned char)(1 << (bit % 8));
+				const ImGuiID flipped = ImHashData(key, size, 0);
+				key[bit / 8] ^= (unsigned char)(1 << (bit % 8));
+				unchanged += flipped == id;
+				flippedBits += ImCountSetBits(flipped ^ id);
+				samples++;
+			}
+		}
+	CHECK(unchanged == 0);
+	CHECK(flippedBits / samples > 15.5 && flippedBits / samples < 16.5);
+
+	// the length is part of the hash: zero bytes of different lengths differ
+	const unsigned char zeros[16] = {};
+	for (int size = 1; size < 16; size++)
+		CHECK(ImHashData(zeros, size, 0) != ImHashData(zeros, size + 1, 0));
+}
+#endif
+
+int main()
+{
+	TestTripleHash();
+	TestStringMatchesData();
+#if !defined(IMGUI_USE_FAST_HASH) && !defined(IMGUI_DISABLE_DEFAULT_HASH_FUNCTIONS) && !defined(IMGUI_USE_LEGACY_CRC32_ADLER)
+	TestCrc32c();
+#endif
+#ifdef IMGUI_USE_FAST_HASH
+	TestFastHashAvalanche();
+#endif
+	return TestResult();
+}
@@ -0,0 +1,198 @@
+// HeapBlockList: how GpuMemoryAllocator places allocations into heap blocks, which blocks a
+// defragmentation move may target, and that empty blocks are released beyond the retention limit.
+// heaps are plain ids here, the d3d12 side only creates and destroys them
+#include "heap_block_list.h"
+#include "test.h"
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+typedef HeapBlockList<int> BlockList;
+
+static const uint64_t BlockSize = 1 << 20;
+
+// what GpuMemoryAllocator::PlaceResource does for a new resource: existing blocks first, then a new heap
+struct Placer
+{
+	explicit Placer(uint32_t maxEmptyBlocks) : blocks(256, maxEmptyBlocks) {}
+
+	BlockList::Block* Place(uint64_t size, TlsfAllocator::Handle& handle)
+	{
+		BlockList::Block* block = blocks.Allocate(size, 0, nullptr, 0.0f, handle);
+		if (block != nullptr)
+			return block;
+		const int heap = nextHeap++;
+		live.insert(heap);
+		// like GpuMemoryAllocator::AddBlock, oversized blocks are rounded up to the placement alignment
+		block = blocks.AddBlock(heap, std::max((size + 65535) & ~(uint64_t)65535, BlockSize));
+		handle = block->allocator.Allocate(size);
+		return block;
+	}
+
+	void Free(BlockList::Block* block, TlsfAllocator::Handle handle)
+	{
+		blocks.Free(block, handle, [this](BlockList::Block& released) { Release(released); });
+	}
+
+	void Release(BlockList::Block& block)
+	{
+		CHECK(block.allocator.IsEmpty());
+		CHECK(live.erase(block.heap) == 1);
+	}
+
+	BlockList blocks;
+	std::set<int> live; // heaps created and not released yet
+	int nextHeap = 0;
+};
+
+static void TestPlacement()
+{
+	Placer placer(1);
+	TlsfAllocator::Handle a, b, c;
+	BlockList::Block* blockA = placer.Place(BlockSize / 2, a);
+	BlockList::Block* blockB = placer.Place(BlockSize / 2, b);
+	CHECK(blockA == blockB); // fits next to the first one
+	CHECK(placer.blocks.GetBlockCount() == 1);
+
+	BlockList::Block* blockC = placer.Place(1024, c);
+	CHECK(blockC != blockA);
+	CHECK(placer.blocks.GetBlockCount() == 2);
+
+	// bigger than a block gets a block of its own size
+	TlsfAllocator::Handle big;
+	BlockList::Block* blockBig = placer.Place(BlockSize * 3, big);
+	CHECK(blockBig->allocator.GetCapacity() == BlockSize * 3);
+	CHECK(placer.blocks.GetReservedBytes() == BlockSize * 5);
+
+	// freed space is reused before a new block is created
+	placer.Free(blockA, a);
+	TlsfAllocator::Handle d;
+	CHECK(placer.Place(BlockSize / 4, d) == blockA);
+	CHECK(placer.blocks.GetBlockCount() == 3);
+}
+
+static void TestRetention()
+{
+	Placer placer(1);
+	TlsfAllocator::Handle handles[3];
+	BlockList::Block* blocks[3];
+	for (int i = 0; i < 3; i++)
+		blocks[i] = placer.Place(BlockSize, handles[i]);
+	CHECK(placer.blocks.GetBlockCount() == 3);
+
+	// the first block to empty is kept for reuse, the next one is released right away
+	placer.Free(blocks[0], handles[0]);
+	CHECK(placer.blocks.GetBlockCount() == 3);
+	CHECK(placer.blocks.GetEmptyBlockCount() == 1);
+	placer.Free(blocks[1], handles[1]);
+	CHECK(placer.blocks.GetBlockCount() == 2);
+	CHECK(placer.blocks.GetEmptyBlockCount() == 1);
+	CHECK(placer.live.size() == 2);
+
+	// creating and releasing a resource every frame reuses the kept block instead of a new heap
+	const int heapsBefore = placer.nextHeap;
+	for (int frame = 0; frame < 10; frame++)
+	{
+		TlsfAllocator::Handle handle;
+		BlockList::Block* block = placer.Place(BlockSize / 2, handle);
+		placer.Free(block, handle);
+	}
+	CHECK(placer.nextHeap == heapsBefore);
+
+	// no retention: every block goes as soon as it is empty
+	placer.blocks.SetMaxEmptyBlocks(0);
+	placer.blocks.ReleaseEmptyBlocks(0, [&](BlockList::Block& released) { placer.Release(released); });
+	CHECK(placer.blocks.GetBlockCount() == 1);
+	placer.Free(blocks[2], handles[2]);
+	CHECK(placer.blocks.GetBlockCount() == 0);
+	CHECK(placer.live.empty());
+	CHECK(placer.blocks.GetReservedBytes() == 0);
+}
+
+static void TestDefragmentTargets()
+{
+	// one sparse block, one well used block, and the block an allocation is moved out of
+	BlockList blocks(256, 4);
+	BlockList::Block* sparseBlock = blocks.AddBlock(0, BlockSize);
+	BlockList::Block* fullBlock = blocks.AddBlock(1, BlockSize);
+	BlockList::Block* sourceBlock = blocks.AddBlock(2, BlockSize);
+	sparseBlock->allocator.Allocate(BlockSize / 16);
+	fullBlock->allocator.Allocate(BlockSize * 3 / 4);
+	sourceBlock->allocator.Allocate(BlockSize / 8);
+
+	// a new allocation takes the first block with room
+	TlsfAllocator::Handle handle;
+	BlockList::Block* target = blocks.Allocate(BlockSize / 8, 0, nullptr, 0.0f, handle);
+	CHECK(target == sparseBlock);
+	target->allocator.Free(handle);
+
+	// a move never lands in its own block or in one below the usage threshold
+	target = blocks.Allocate(BlockSize / 8, 0, sourceBlock, 0.5f, handle);
+	CHECK(target == fullBlock);
+	target->allocator.Free(handle);
+
+	// nothing qualifies: the move fails instead of growing the pool
+	target = blocks.Allocate(BlockSize / 2, 0, sourceBlock, 0.5f, handle);
+	CHECK(target == nullptr);
+	CHECK(handle == TlsfAllocator::InvalidHandle);
+	CHECK(blocks.GetBlockCount() == 3);
+}
+
+static void TestFuzz()
+{
+	struct Live
+	{
+		BlockList::Block* block;
+		TlsfAllocator::Handle handle;
+		uint64_t offset;
+		uint64_t size;
+	};
+
+	std::mt19937 rng(7);
+	for (uint32_t maxEmpty = 0; maxEmpty < 4; maxEmpty++)
+	{
+		Placer placer(maxEmpty);
+		std::vector<Live> live;
+		for (int op = 0; op < 8000; op++)
+		{
+			// grow for a while, then shrink, so blocks fill up and empty out again
+			const bool growing = (op / 1000) % 2 == 0;
+			if (live.empty() || rng() % 4 < (growing ? 3u : 1u))
+			{
+				const uint64_t size = rng() % 8 == 0 ? rng() % (BlockSize * 2) + 1 : rng() % 65536 + 1;
+				TlsfAllocator::Handle handle;
+				BlockList::Block* block = placer.Place(size, handle);
+				CHECK(handle != TlsfAllocator::InvalidHandle);
+				const uint64_t offset = block->allocator.GetOffset(handle);
+				const uint64_t allocated = block->allocator.GetSize(handle);
+				for (const Live& other : live)
+					CHECK(other.block != block || offset >= other.offset + other.size || other.offset >= offset + allocated);
+				live.push_back({ block, handle, offset, allocated });
+			}
+			else
+			{
+				const size_t i = rng() % live.size();
+				placer.Free(live[i].block, live[i].handle);
+				live[i] = live.back();
+				live.pop_back();
+				CHECK(placer.blocks.GetEmptyBlockCount() <= maxEmpty);
+			}
+			CHECK(placer.live.size() == placer.blocks.GetBlockCount());
+		}
+		for (const Live& allocation : live)
+			placer.Free(allocation.block, allocation.handle);
+		CHECK(placer.blocks.GetBlockCount() <= maxEmpty);
+		for (const std::unique_ptr<BlockList::Block>& block : placer.blocks.GetBlocks())
+			CHECK(block->allocator.IsEmpty() && block->allocator.Validate());
+	}
+}
+
+int main()
+{
+	TestPlacement();
+	TestRetention();
+	TestDefragmentTargets();
+	TestFuzz();
+	return TestResult();
+}
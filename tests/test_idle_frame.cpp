@@ -0,0 +1,213 @@
+// idle frame detection: HashBytes() chaining and alignment, HashDrawData() of identical imgui frames
+// and of the same frame with one vertex, clip rect or texture id changed, DrawDataHasPendingTextures() for
+// every texture status, and IdleFrameDetector skipping/presenting the way the main loop drives it
+#include "idle_frame.h"
+#include "imgui_headless.h"
+#include "test.h"
+#include <cstring>
+#include <initializer_list>
+
+static ImTextureID g_imageId = (ImTextureID)(intptr_t)0x1000;
+
+static void DashboardFrame()
+{
+	ImGui::SetNextWindowPos(ImVec2(20, 20));
+	ImGui::SetNextWindowSize(ImVec2(400, 300));
+	ImGui::Begin("Dashboard", nullptr, ImGuiWindowFlags_NoSavedSettings);
+	ImGui::Text("static label");
+	ImGui::Button("Button");
+	ImGui::Image(ImTextureRef(g_imageId), ImVec2(32, 32));
+	ImGui::End();
+}
+
+static uint64_t FrameHash(const ImDrawData* drawData)
+{
+	return HashDrawData(drawData, FrameHashSeed);
+}
+
+static void TestHashBytes()
+{
+	unsigned char bytes[64 + 8];
+	for (int i = 0; i < (int)sizeof(bytes); i++)
+		bytes[i] = (unsigned char)(i * 37 + 11);
+
+	// the same data hashes the same at every alignment, and every byte counts
+	unsigned char shifted[64 + 16];
+	for (int offset = 0; offset < 8; offset++)
+	{
+		memcpy(shifted + offset, bytes, 64);
+		CHECK(HashBytes(shifted + offset, 64, FrameHashSeed) == HashBytes(bytes, 64, FrameHashSeed));
+	}
+	const uint64_t hash = HashBytes(bytes, 64, FrameHashSeed);
+	int sameHashes = 0;
+	for (int i = 0; i < 64; i++)
+		for (int bit = 0; bit < 8; bit++)
+		{
+			bytes[i] ^= (unsigned char)(1 << bit);
+			sameHashes += HashBytes(bytes, 64, FrameHashSeed) == hash;
+			bytes[i] ^= (unsigned char)(1 << bit);
+		}
+	CHECK(sameHashes == 0);
+
+	// chaining: the seed carries the previous blocks, sizes are not interchangeable
+	CHECK(HashBytes(bytes + 16, 16, HashBytes(bytes, 16, FrameHashSeed)) != HashBytes(bytes + 16, 16, FrameHashSeed));
+	CHECK(HashBytes(bytes, 0, 1234) == 1234);
+	CHECK(HashBytes(bytes, 63, FrameHashSeed) != HashBytes(bytes, 64, FrameHashSeed));
+}
+
+static void TestDrawDataHash()
+{
+	HeadlessImGui imgui(1280.0f, 720.0f);
+	for (int frame = 0; frame < 3; frame++)
+		imgui.Frame(DashboardFrame);
+
+	// identical frames hash the same
+	const uint64_t hash = FrameHash(imgui.Frame(DashboardFrame));
+	ImDrawData* drawData = imgui.Frame(DashboardFrame);
+	CHECK(FrameHash(drawData) == hash);
+	CHECK(FrameHash(nullptr) == FrameHashSeed);
+
+	// one thing changed at a time in the largest draw list, then restored
+	ImDrawList* drawList = nullptr;
+	for (ImDrawList* list : drawData->CmdLists)
+		if (list->VtxBuffer.Size > 0 && (drawList == nullptr || list->VtxBuffer.Size > drawList->VtxBuffer.Size))
+			drawList = list;
+	CHECK(drawList != nullptr && drawList->CmdBuffer.Size > 0);
+	if (drawList == nullptr)
+		return;
+
+	int unchangedHashes = 0;
+	for (int i = 0; i < drawList->VtxBuffer.Size; i += 7)
+	{
+		ImDrawVert& vertex = drawList->VtxBuffer[i];
+		const ImDrawVert saved = vertex;
+		vertex.pos.x += 1.0f;
+		unchangedHashes += FrameHash(drawData) == hash;
+		vertex = saved;
+		vertex.col ^= 0x01000000;
+		unchangedHashes += FrameHash(drawData) == hash;
+		vertex = saved;
+		vertex.uv.y += 1.0f / 512.0f;
+		unchangedHashes += FrameHash(drawData) == hash;
+		vertex = saved;
+	}
+	CHECK(unchangedHashes == 0);
+
+	for (ImDrawCmd& cmd : drawList->CmdBuffer)
+	{
+		const ImDrawCmd saved = cmd;
+		cmd.ClipRect.z -= 1.0f;
+		CHECK(FrameHash(drawData) != hash);
+		cmd = saved;
+		cmd.ElemCount -= 3;
+		CHECK(FrameHash(drawData) != hash);
+		cmd = saved;
+	}
+	CHECK(FrameHash(drawData) == hash);
+	drawList->IdxBuffer[0] ^= 1;
+	CHECK(FrameHash(drawData) != hash);
+	drawList->IdxBuffer[0] ^= 1;
+	drawData->DisplaySize.x += 1.0f;
+	CHECK(FrameHash(drawData) != hash);
+	drawData->DisplaySize.x -= 1.0f;
+	CHECK(FrameHash(drawData) == hash);
+
+	// the same frame with another image texture, and with a clip rect pushed around the image
+	g_imageId = (ImTextureID)(intptr_t)0x2000;
+	CHECK(FrameHash(imgui.Frame(DashboardFrame)) != hash);
+	g_imageId = (ImTextureID)(intptr_t)0x1000;
+	CHECK(FrameHash(imgui.Frame(DashboardFrame)) == hash);
+	const uint64_t clippedHash = FrameHash(imgui.Frame([] {
+		ImGui::SetNextWindowPos(ImVec2(20, 20));
+		ImGui::SetNextWindowSize(ImVec2(400, 300));
+		ImGui::Begin("Dashboard", nullptr, ImGuiWindowFlags_NoSavedSettings);
+		ImGui::Text("static label");
+		ImGui::Button("Button");
+		ImGui::PushClipRect(ImVec2(0, 0), ImVec2(600, 200), true);
+		ImGui::Image(ImTextureRef(g_imageId), ImVec2(32, 32));
+		ImGui::PopClipRect();
+		ImGui::End();
+	}));
+	CHECK(clippedHash != hash);
+	CHECK(FrameHash(imgui.Frame(DashboardFrame)) == hash);
+}
+
+static void TestPendingTextures()
+{
+	HeadlessImGui imgui(1280.0f, 720.0f);
+
+	// the first frame asks for the font atlas, until the renderer creates it nothing may be skipped
+	imgui.NewFrame();
+	DashboardFrame();
+	ImGui::Render();
+	CHECK(DrawDataHasPendingTextures(ImGui::GetDrawData()));
+	HeadlessImGui::ProcessTextures();
+	CHECK(!DrawDataHasPendingTextures(ImGui::GetDrawData()));
+	CHECK(!DrawDataHasPendingTextures(nullptr));
+
+	ImDrawData* drawData = imgui.Frame(DashboardFrame);
+	CHECK(!DrawDataHasPendingTextures(drawData));
+	ImTextureData* atlas = drawData->Textures->Data[0];
+	for (ImTextureStatus status : { ImTextureStatus_WantCreate, ImTextureStatus_WantUpdates, ImTextureStatus_WantDestroy })
+	{
+		atlas->Status = status;
+		CHECK(DrawDataHasPendingTextures(drawData));
+	}
+	atlas->Status = ImTextureStatus_OK;
+	CHECK(!DrawDataHasPendingTextures(drawData));
+
+	// glyphs baked mid-run: the frame asking for the atlas update is presented even if its hash
+	// matches the last presented one, the next identical frame is skipped again
+	IdleFrameDetector detector;
+	CHECK(detector.ShouldPresent(FrameHash(drawData), DrawDataHasPendingTextures(drawData)));
+	CHECK(!detector.ShouldPresent(FrameHash(drawData), DrawDataHasPendingTextures(drawData)));
+	imgui.NewFrame();
+	DashboardFrame();
+	ImGui::GetFont()->GetFontBaked(57.0f)->FindGlyph('~'); // bakes a glyph without drawing anything
+	ImGui::Render();
+	drawData = ImGui::GetDrawData();
+	CHECK(DrawDataHasPendingTextures(drawData) && FrameHash(drawData) == detector.lastHash);
+	CHECK(detector.ShouldPresent(FrameHash(drawData), DrawDataHasPendingTextures(drawData)));
+	HeadlessImGui::ProcessTextures();
+	drawData = imgui.Frame(DashboardFrame);
+	detector.ShouldPresent(FrameHash(drawData), DrawDataHasPendingTextures(drawData));
+	CHECK(!detector.ShouldPresent(FrameHash(drawData), DrawDataHasPendingTextures(drawData)));
+}
+
+static void TestDetector()
+{
+	IdleFrameDetector detector;
+
+	// the first frame always presents, then only changes or forced frames do
+	CHECK(detector.ShouldPresent(1, false));
+	CHECK(!detector.ShouldPresent(1, false));
+	CHECK(!detector.ShouldPresent(1, false));
+	CHECK(detector.presentedFrames == 1 && detector.skippedFrames == 2);
+	CHECK(detector.ShouldPresent(2, false));
+	CHECK(detector.ShouldPresent(2, true));
+	CHECK(!detector.ShouldPresent(2, false));
+	CHECK(detector.ShouldPresent(1, false));
+	CHECK(detector.presentedFrames == 4 && detector.skippedFrames == 3);
+
+	// resize or device reset
+	detector.Invalidate();
+	CHECK(detector.ShouldPresent(1, false));
+	CHECK(!detector.ShouldPresent(1, false));
+
+	// disabled: nothing is skipped, the last hash keeps tracking so enabling again skips right away
+	detector.enabled = false;
+	CHECK(detector.ShouldPresent(3, false));
+	CHECK(detector.ShouldPresent(3, false));
+	detector.enabled = true;
+	CHECK(!detector.ShouldPresent(3, false));
+	CHECK(detector.presentedFrames == 7 && detector.skippedFrames == 5);
+}
+
+int main()
+{
+	TestHashBytes();
+	TestDrawDataHash();
+	TestPendingTextures();
+	TestDetector();
+	return TestResult();
+}
@@ -0,0 +1,201 @@
+// variable height ImGuiListClipper: ImGuiListClipperHeights against plain prefix sums under random
+// resizes and height changes, then a list of 3000 items of mixed heights clipped with
+// BeginVariableHeight() against the same list submitted unclipped: same scroll range, and at 200
+// random scroll positions every displayed item at its unclipped position and no visible item
+// missing. jumping to the end with unknown heights and a frozen header table must not assert
+#include "imgui_headless.h"
+#include "imgui_internal.h"
+#include "test.h"
+#include <cmath>
+#include <map>
+#include <random>
+#include <vector>
+
+static std::mt19937 g_random(12345);
+
+static float CallbackHeight(int n, void*)
+{
+	return (n % 13) == 0 ? 40.0f : 17.0f;
+}
+
+static void TestHeights()
+{
+	ImGuiListClipperHeights heights;
+	std::vector<float> expected;
+	int wrongCounts = 0, wrongOffsets = 0, wrongFinds = 0, wrongTotals = 0;
+	for (int op = 0; op < 3000; op++)
+	{
+		if (g_random() % 10 == 0)
+		{
+			const int count = g_random() % 700;
+			const float defaultHeight = (float)(g_random() % 30);
+			heights.ItemHeightCallback = (g_random() % 2) ? CallbackHeight : nullptr;
+			heights.Resize(count, defaultHeight);
+			const size_t oldCount = expected.size();
+			expected.resize(count);
+			for (size_t n = oldCount; n < (size_t)count; n++)
+				expected[n] = heights.ItemHeightCallback ? CallbackHeight((int)n, nullptr) : defaultHeight;
+		}
+		else if (!expected.empty())
+		{
+			const int n = g_random() % expected.size();
+			const float height = (g_random() % 4 == 0) ? 0.0f : (float)(g_random() % 1000) * 0.25f; // zero height items too
+			heights.SetItemHeight(n, height);
+			expected[n] = height;
+		}
+		if (heights.GetItemsCount() != (int)expected.size())
+		{
+			wrongCounts++;
+			continue;
+		}
+		std::vector<double> prefix(expected.size() + 1, 0.0);
+		for (size_t n = 0; n < expected.size(); n++)
+			prefix[n + 1] = prefix[n] + expected[n];
+		for (int query = 0; query < 20; query++)
+		{
+			const int n = g_random() % (expected.size() + 1);
+			wrongOffsets += fabs(heights.GetItemOffset(n) - prefix[n]) > 1e-6;
+
+			// the item n with prefix[n] <= offset < prefix[n + 1], clamped to the list
+			const double offset = (double)(g_random() % 200000) * 0.01 - 10.0;
+			int item = 0;
+			if (!expected.empty() && offset > 0.0)
+			{
+				item = (int)expected.size() - 1;
+				for (size_t m = 0; m < expected.size(); m++)
+					if (offset < prefix[m + 1])
+					{
+						item = (int)m;
+						break;
+					}
+			}
+			wrongFinds += heights.FindItemAtOffset(offset) != item;
+		}
+		wrongTotals += fabs(heights.GetTotalHeight() - prefix.back()) > 1e-6;
+	}
+	CHECK(wrongCounts == 0);
+	CHECK(wrongOffsets == 0);
+	CHECK(wrongFinds == 0);
+	CHECK(wrongTotals == 0);
+}
+
+enum ListMode { ListMode_Unclipped, ListMode_Clipped, ListMode_ClippedTable };
+
+static const int g_count = 3000;
+static ImGuiListClipperHeights g_heights;
+static std::map<int, float> g_positions; // screen y of each item submitted by the last frame
+
+static void Item(int i)
+{
+	g_positions[i] = ImGui::GetCursorScreenPos().y;
+	if (i % 7 == 0)
+		ImGui::Text("%d line\nline\nline", i);
+	else if (i % 11 == 0)
+		ImGui::Button("Button", ImVec2(0, 35.0f + (i % 5)));
+	else
+		ImGui::Text("%d", i);
+}
+
+// scroll < 0 keeps the current scroll position
+static void ListFrame(HeadlessImGui& imgui, ListMode mode, float scroll)
+{
+	imgui.Frame([&] {
+		ImGui::SetNextWindowPos(ImVec2(0, 0));
+		ImGui::SetNextWindowSize(ImVec2(500, 700));
+		ImGui::Begin("List", nullptr, ImGuiWindowFlags_NoSavedSettings);
+		if (scroll >= 0.0f)
+			ImGui::SetScrollY(scroll);
+		g_positions.clear();
+		if (mode == ListMode_Unclipped)
+		{
+			for (int i = 0; i < g_count; i++)
+				Item(i);
+		}
+		else if (mode == ListMode_Clipped)
+		{
+			ImGuiListClipper clipper;
+			clipper.BeginVariableHeight(g_count, &g_heights);
+			while (clipper.Step())
+				for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+					Item(i);
+		}
+		else if (ImGui::BeginTable("table", 2, ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders))
+		{
+			ImGui::TableSetupScrollFreeze(0, 1);
+			ImGui::TableHeadersRow();
+			ImGuiListClipper clipper;
+			clipper.BeginVariableHeight(g_count, &g_heights);
+			while (clipper.Step())
+				for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+				{
+					ImGui::TableNextRow();
+					ImGui::TableSetColumnIndex(0);
+					Item(i);
+					ImGui::TableSetColumnIndex(1);
+					ImGui::Text("x");
+				}
+			ImGui::EndTable();
+		}
+		ImGui::End();
+	});
+}
+
+static void TestLayout()
+{
+	HeadlessImGui imgui(1280.0f, 800.0f);
+	for (int frame = 0; frame < 3; frame++)
+		ListFrame(imgui, ListMode_Unclipped, 0.0f);
+	const float scrollMax = ImGui::FindWindowByName("List")->ScrollMax.y;
+
+	// a first pass top to bottom measures every item, after which positions must be exact
+	for (float scroll = 0.0f; scroll <= scrollMax + 700.0f; scroll += 300.0f)
+	{
+		ListFrame(imgui, ListMode_Clipped, scroll);
+		ListFrame(imgui, ListMode_Clipped, scroll);
+	}
+	CHECK(fabsf(ImGui::FindWindowByName("List")->ScrollMax.y - scrollMax) <= 0.5f);
+
+	int misplaced = 0, missing = 0, compared = 0;
+	for (int k = 0; k < 200; k++)
+	{
+		ListFrame(imgui, ListMode_Clipped, (float)(g_random() % (int)scrollMax));
+		ListFrame(imgui, ListMode_Clipped, -1.0f);
+		const float scroll = ImGui::FindWindowByName("List")->Scroll.y;
+		ListFrame(imgui, ListMode_Unclipped, scroll);
+		ListFrame(imgui, ListMode_Unclipped, -1.0f);
+		std::map<int, float> unclipped = g_positions;
+		ListFrame(imgui, ListMode_Clipped, scroll);
+		const ImRect clip = ImGui::FindWindowByName("List")->InnerClipRect;
+		for (const auto& item : g_positions)
+		{
+			misplaced += fabsf(item.second - unclipped[item.first]) > 0.01f;
+			compared++;
+		}
+		for (const auto& item : unclipped)
+		{
+			const auto next = unclipped.find(item.first + 1);
+			if (next != unclipped.end() && next->second > clip.Min.y && item.second < clip.Max.y && g_positions.count(item.first) == 0)
+				missing++;
+		}
+	}
+	CHECK(misplaced == 0);
+	CHECK(missing == 0);
+	CHECK(compared > 200 * 10);
+
+	// unknown heights: jump to the end of a fresh cache and keep going
+	g_heights.Clear();
+	for (int frame = 0; frame < 20; frame++)
+		ListFrame(imgui, ListMode_Clipped, 1e9f);
+	CHECK(!g_positions.empty() && g_positions.rbegin()->first == g_count - 1);
+	g_heights.Clear();
+	for (int frame = 0; frame < 50; frame++)
+		ListFrame(imgui, ListMode_ClippedTable, (float)(frame * 97));
+	CHECK(!g_positions.empty());
+}
+
+int main()
+{
+	TestHeights();
+	TestLayout();
+	return TestResult();
+}
@@ -0,0 +1,140 @@
+// ResidencyPolicy: eviction order, objects still in use by the gpu, counters, and a simulated
+// workload with a hot working set under a budget it does not fit in
+#include "residency_policy.h"
+#include "test.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+static const uint64_t MB = 1 << 20;
+
+static void TestLeastRecentlyUsedOrder()
+{
+	ResidencyPolicy policy;
+	ResidencyPolicy::Handle a = policy.Add(10 * MB);
+	ResidencyPolicy::Handle b = policy.Add(10 * MB);
+	ResidencyPolicy::Handle c = policy.Add(10 * MB);
+	CHECK(policy.GetResidentBytes() == 30 * MB);
+	CHECK(policy.GetResidentCount() == 3);
+
+	// a is used last, so b goes first, then c
+	policy.MarkUsed(b, 1);
+	policy.MarkUsed(c, 2);
+	policy.MarkUsed(a, 3);
+	std::vector<ResidencyPolicy::Handle> evicted;
+	CHECK(policy.SelectEvictions(30 * MB, 15 * MB, 3, evicted) == 20 * MB);
+	CHECK(evicted.size() == 2 && evicted[0] == b && evicted[1] == c);
+	CHECK(!policy.IsResident(b) && !policy.IsResident(c) && policy.IsResident(a));
+	CHECK(policy.GetEvictedBytes() == 20 * MB && policy.GetResidentBytes() == 10 * MB);
+	CHECK(policy.GetTotalEvictions() == 2);
+	CHECK(policy.Validate());
+
+	// using an evicted object makes it resident again, the caller has to page it back in
+	CHECK(policy.MarkUsed(b, 4));
+	CHECK(!policy.MarkUsed(a, 4));
+	CHECK(policy.IsResident(b));
+	CHECK(policy.GetTotalMakeResidents() == 1);
+	CHECK(policy.GetResidentBytes() == 20 * MB);
+
+	// already under the target: nothing to do
+	evicted.clear();
+	CHECK(policy.SelectEvictions(20 * MB, 25 * MB, 4, evicted) == 0);
+	CHECK(evicted.empty());
+
+	policy.Remove(c);
+	CHECK(policy.GetEvictedBytes() == 0);
+	CHECK(policy.Validate());
+}
+
+static void TestInFlightNeverEvicted()
+{
+	ResidencyPolicy policy;
+	std::vector<ResidencyPolicy::Handle> handles;
+	for (int i = 0; i < 8; i++)
+	{
+		handles.push_back(policy.Add(4 * MB));
+		policy.MarkUsed(handles.back(), 10 + i);
+	}
+
+	// the gpu has only finished up to fence 13: the four objects used after that have to stay
+	std::vector<ResidencyPolicy::Handle> evicted;
+	CHECK(policy.SelectEvictions(32 * MB, 0, 13, evicted) == 16 * MB);
+	CHECK(evicted.size() == 4);
+	for (ResidencyPolicy::Handle handle : evicted)
+		CHECK(policy.GetLastUsedFence(handle) <= 13);
+	for (int i = 4; i < 8; i++)
+		CHECK(policy.IsResident(handles[i]));
+	CHECK(policy.Validate());
+
+	// handles of removed objects are reused
+	policy.Remove(handles[0]);
+	CHECK(policy.Add(MB) == handles[0]);
+	CHECK(policy.IsResident(handles[0]) && policy.GetSize(handles[0]) == MB);
+	CHECK(policy.Validate());
+}
+
+// objects come and go, a hot set is used every frame and a few random others now and then.
+// the budget is far below the total, so eviction runs constantly
+static void TestSimulation()
+{
+	std::mt19937 rng(1);
+	ResidencyPolicy policy;
+	std::vector<ResidencyPolicy::Handle> live;
+	const uint64_t budget = 256 * MB;
+	uint64_t fence = 1;
+	uint64_t hotMakeResidents = 0;
+	for (int frame = 0; frame < 20000; frame++)
+	{
+		if (live.size() < 200 && rng() % 3 == 0)
+			live.push_back(policy.Add((rng() % 64 + 1) << 16));
+		if (live.size() > 20 && rng() % 7 == 0)
+		{
+			// the hot set at the front stays alive
+			const size_t i = 20 + rng() % (live.size() - 20);
+			policy.Remove(live[i]);
+			live[i] = live.back();
+			live.pop_back();
+		}
+
+		for (int k = 0; k < 30 && !live.empty(); k++)
+		{
+			const bool hot = k < 20;
+			const size_t i = hot ? k % live.size() : rng() % live.size();
+			if (policy.MarkUsed(live[i], fence) && hot && frame > 1000)
+				hotMakeResidents++;
+		}
+
+		// two frames in flight
+		const uint64_t completed = fence >= 2 ? fence - 2 : 0;
+		fence++;
+		const uint64_t usage = policy.GetResidentBytes();
+		if (usage > budget)
+		{
+			std::vector<ResidencyPolicy::Handle> evicted;
+			const uint64_t freed = policy.SelectEvictions(usage, budget * 9 / 10, completed, evicted);
+			uint64_t evictedBytes = 0;
+			for (ResidencyPolicy::Handle handle : evicted)
+			{
+				CHECK(!policy.IsResident(handle));
+				CHECK(policy.GetLastUsedFence(handle) <= completed);
+				evictedBytes += policy.GetSize(handle);
+			}
+			CHECK(freed == evictedBytes);
+			CHECK(policy.GetResidentBytes() == usage - freed);
+		}
+		if (frame % 97 == 0)
+			CHECK(policy.Validate());
+	}
+	CHECK(policy.Validate());
+	// once warmed up, the objects used every frame are always the most recently used ones
+	CHECK(hotMakeResidents == 0);
+	CHECK(policy.GetTotalEvictions() > 0);
+}
+
+int main()
+{
+	TestLeastRecentlyUsedOrder();
+	TestInFlightNeverEvicted();
+	TestSimulation();
+	return TestResult();
+}
@@ -0,0 +1,215 @@
+// windows with ImGuiWindowRefreshFlags_RefreshOnInputsChange: the same panels and input script run
+// in a retained and a non-retained context draw the same triangles, clip rects and textures frame
+// for frame (hovering, clicking, scrolling, dragging a window, pushed colors, font scale, resizing
+// the display), and the per-window hit/miss counters count what each event refreshed, as shown in
+// the Metrics window
+#include "imgui_headless.h"
+#include "retained_scene.h"
+#include "test.h"
+#include <cfloat>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static uint32_t FloatBits(float value)
+{
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+// every draw command's header then its triangles as resolved vertices
+static std::vector<uint32_t> Flatten(const ImDrawData* drawData)
+{
+	std::vector<uint32_t> out;
+	for (const ImDrawList* drawList : drawData->CmdLists)
+		for (const ImDrawCmd& cmd : drawList->CmdBuffer)
+		{
+			const uint32_t header[] = { FloatBits(cmd.ClipRect.x), FloatBits(cmd.ClipRect.y), FloatBits(cmd.ClipRect.z), FloatBits(cmd.ClipRect.w),
+				(uint32_t)cmd.GetTexID(), cmd.UserCallback != nullptr ? 1u : 0u, cmd.ElemCount };
+			out.insert(out.end(), header, header + 7);
+			for (unsigned int i = 0; i < cmd.ElemCount; i++)
+			{
+				const ImDrawVert& vertex = drawList->VtxBuffer[drawList->IdxBuffer[cmd.IdxOffset + i] + cmd.VtxOffset];
+				const uint32_t fields[] = { FloatBits(vertex.pos.x), FloatBits(vertex.pos.y), FloatBits(vertex.uv.x), FloatBits(vertex.uv.y), vertex.col };
+				out.insert(out.end(), fields, fields + 5);
+			}
+		}
+	return out;
+}
+
+static ImVec2 Offset(ImVec2 pos, float x, float y)
+{
+	return ImVec2(pos.x + x, pos.y + y);
+}
+
+// mouse, wheel, style and display changes for 'frame', the same in both contexts
+static void ScriptInput(RetainedScene& scene, int frame)
+{
+	ImGuiIO& io = ImGui::GetIO();
+	if (frame >= 30 && frame < 60) // sweep over panel 1
+	{
+		const ImVec2 pos = Offset(scene.PanelPos(1), 20.0f + (frame - 30) * 8.0f, 60.0f);
+		io.AddMousePosEvent(pos.x, pos.y);
+	}
+	if (frame == 60) // click in panel 5's body, focusing it
+	{
+		const ImVec2 pos = Offset(scene.PanelPos(5), 40.0f, 110.0f);
+		io.AddMousePosEvent(pos.x, pos.y);
+	}
+	if (frame == 61 || frame == 62)
+		io.AddMouseButtonEvent(0, frame == 61);
+	if (frame >= 80 && frame < 90) // scroll panel 6
+	{
+		const ImVec2 pos = Offset(scene.PanelPos(6), 60.0f, 80.0f);
+		io.AddMousePosEvent(pos.x, pos.y);
+		io.AddMouseWheelEvent(0.0f, -1.0f);
+	}
+	if (frame >= 100 && frame <= 120) // drag panel 2 by its title bar
+	{
+		const ImVec2 pos = Offset(scene.PanelPos(2), 40.0f + (frame - 100) * 3.0f, 8.0f + (frame - 100) * 2.0f);
+		io.AddMousePosEvent(pos.x, pos.y);
+		if (frame == 100 || frame == 120)
+			io.AddMouseButtonEvent(0, frame == 100);
+	}
+	if (frame == 130)
+		io.AddMousePosEvent(-FLT_MAX, -FLT_MAX);
+	scene.tint = frame >= 140 && frame < 150;
+	ImGui::GetStyle().FontScaleMain = (frame >= 170 && frame < 200) ? 1.25f : 1.0f;
+	io.DisplaySize = frame >= 220 && frame < 240 ? ImVec2(1400.0f, 800.0f) : ImVec2(1280.0f, 720.0f);
+}
+
+static int Hits(const char* name)
+{
+	ImGuiWindow* window = ImGui::FindWindowByName(name);
+	return window ? window->SkipRefreshHits : -1;
+}
+
+static int Misses(const char* name)
+{
+	ImGuiWindow* window = ImGui::FindWindowByName(name);
+	return window ? window->SkipRefreshMisses : -1;
+}
+
+static void TestMatchesNonRetained()
+{
+	HeadlessImGui retained(1280.0f, 720.0f), plain(1280.0f, 720.0f);
+	RetainedScene retainedScene(12, 4, 5), plainScene(12, 4, 5);
+	int mismatchedFrames = 0, firstMismatch = -1;
+	for (int frame = 0; frame < 300; frame++)
+	{
+		retained.MakeCurrent();
+		ScriptInput(retainedScene, frame);
+		retainedScene.Update(frame);
+		const std::vector<uint32_t> expected = Flatten(retained.Frame([&] { retainedScene.Draw(true); }));
+
+		plain.MakeCurrent();
+		ScriptInput(plainScene, frame);
+		plainScene.Update(frame);
+		const std::vector<uint32_t> actual = Flatten(plain.Frame([&] { plainScene.Draw(false); }));
+		if (expected != actual)
+		{
+			mismatchedFrames++;
+			if (firstMismatch < 0)
+				firstMismatch = frame;
+		}
+	}
+	if (mismatchedFrames > 0)
+		printf("%d frames differ, the first is frame %d\n", mismatchedFrames, firstMismatch);
+	CHECK(mismatchedFrames == 0);
+
+	// the script did something: the click and drag happened, and most static panels were reused
+	plain.MakeCurrent();
+	const ImVec2 plainPos = ImGui::FindWindowByName("panel 2")->Pos;
+	CHECK(plainPos.x > plainScene.PanelPos(2).x + 30.0f);
+	CHECK(ImGui::FindWindowByName("panel 6")->Scroll.y > 0.0f);
+	CHECK(ImGui::GetCurrentContext()->NavWindow == ImGui::FindWindowByName("panel 2")); // focused by the drag, after panel 5
+	retained.MakeCurrent();
+	CHECK(ImGui::FindWindowByName("panel 2")->Pos.x == plainPos.x && ImGui::FindWindowByName("panel 2")->Pos.y == plainPos.y);
+	int hits = 0, total = 0;
+	for (int i = 0; i < 12; i++)
+	{
+		char name[32];
+		snprintf(name, sizeof(name), "panel %d", i);
+		hits += Hits(name);
+		total += Hits(name) + Misses(name);
+		if (i % 5 == 0)
+			CHECK(Hits(name) == 0); // live panels change every frame
+	}
+	CHECK(total == 12 * 300);
+	CHECK(hits > total / 2);
+}
+
+// counters of one context, event by event
+static void TestCounters()
+{
+	HeadlessImGui imgui(1280.0f, 720.0f);
+	RetainedScene scene(4, 2, 1000); // panel 0 is live, but only animated when asked
+	auto frame = [&] { imgui.Frame([&] { scene.Draw(true); }); };
+
+	// appearing, then one more frame for layout to settle
+	frame();
+	CHECK(Misses("panel 1") == 1 && Hits("panel 1") == 0);
+	frame();
+	CHECK(Misses("panel 1") == 2 && Hits("panel 1") == 0);
+	for (int i = 0; i < 10; i++)
+		frame();
+	CHECK(Misses("panel 1") == 2 && Hits("panel 1") == 10);
+	CHECK(Misses("panel 0") == 2 && Hits("panel 0") == 10);
+
+	// new user data: a refresh and a settle frame for that panel only
+	scene.Animate(0, 1);
+	frame();
+	frame();
+	frame();
+	CHECK(Misses("panel 0") == 4 && Hits("panel 0") == 11);
+	CHECK(Misses("panel 1") == 2 && Hits("panel 1") == 13);
+
+	// hovering: refreshes while the mouse moves over it. panel 3 already refreshed once more than the
+	// others as it took focus after its first Begin()
+	int misses = Misses("panel 3"), hits = Hits("panel 3");
+	const ImVec2 pos = Offset(scene.PanelPos(3), 50.0f, 60.0f);
+	for (int i = 0; i < 5; i++)
+	{
+		ImGui::GetIO().AddMousePosEvent(pos.x + i, pos.y);
+		frame();
+	}
+	CHECK(Misses("panel 3") == misses + 5 && Hits("panel 3") == hits);
+	CHECK(Misses("panel 2") == 2 && Hits("panel 2") == 18);
+	// the mouse rests: one settle frame, then reused although still hovered
+	frame();
+	frame();
+	CHECK(Misses("panel 3") == misses + 6 && Hits("panel 3") == hits + 1);
+
+	// MarkWindowRefreshDirty()
+	ImGui::MarkWindowRefreshDirty("panel 2");
+	frame();
+	CHECK(Misses("panel 2") == 3 && Hits("panel 2") == 20);
+
+	// Metrics shows the summary line and each window's counters
+	// (logged text, with tree nodes opened. End() of the window logging was started from stops it)
+	imgui.Frame([&] { scene.Draw(true); ImGui::ShowMetricsWindow(); });
+	imgui.NewFrame();
+	scene.Draw(true);
+	ImGui::Begin("log");
+	ImGui::LogToBuffer(3);
+	ImGui::GetCurrentContext()->LogWindow = nullptr;
+	ImGui::End();
+	ImGui::ShowMetricsWindow();
+	const std::string log = ImGui::GetCurrentContext()->LogBuffer.c_str();
+	ImGui::LogFinish();
+	imgui.EndFrame();
+	// the Metrics window took focus on its first frame, after panel 3's Begin(), so panel 3 was reused
+	// in that frame and refreshed in the logged one
+	CHECK(log.find("3/4 windows with refresh policy reused contents, 80.0% hit rate") != std::string::npos);
+	char panel3[64];
+	snprintf(panel3, sizeof(panel3), "SkipRefresh: 0, hits: %d, misses: %d", hits + 3, misses + 7);
+	CHECK(log.find(panel3) != std::string::npos);
+}
+
+int main()
+{
+	TestMatchesNonRetained();
+	TestCounters();
+	return TestResult();
+}
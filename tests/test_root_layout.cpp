@@ -0,0 +1,101 @@
+// RootLayout: per-draw data routing between root constants and the cbv fallback, the root
+// signature size limit, hashing, and RootLayoutCache telling equal and different layouts apart
+#include "root_layout.h"
+#include "test.h"
+
+static void TestPerDrawRouting()
+{
+	// a 4x4 matrix fits in root constants
+	RootLayout scene;
+	const uint32_t matrix = scene.AddPerDrawData(0, 64, RootShaderStage_Vertex);
+	scene.AddSrvTable(0, 1, RootShaderStage_Pixel);
+	CHECK(scene.GetParams()[matrix].kind == RootParamKind_Constants);
+	CHECK(scene.GetParams()[matrix].count == 16);
+	CHECK(scene.GetDwordCost() == 17);
+	CHECK(scene.IsValid());
+
+	// odd sizes round up to whole dwords
+	RootLayout small;
+	small.AddPerDrawData(0, 6, RootShaderStage_All);
+	CHECK(small.GetParams()[0].kind == RootParamKind_Constants && small.GetParams()[0].count == 2);
+
+	// larger payloads fall back to a cbv, 2 dwords
+	RootLayout big;
+	big.AddPerDrawData(0, 256, RootShaderStage_Vertex);
+	CHECK(big.GetParams()[0].kind == RootParamKind_Cbv);
+	CHECK(big.GetDwordCost() == 2);
+
+	// once the root signature would go over 64 dwords even small payloads become cbvs
+	RootLayout full;
+	for (uint32_t i = 0; i < 3; i++)
+		full.AddPerDrawData(i, 64, RootShaderStage_All);
+	full.AddPerDrawData(5, 64, RootShaderStage_All);
+	full.AddPerDrawData(6, 4, RootShaderStage_All);
+	CHECK(full.GetParams()[3].kind == RootParamKind_Constants);
+	CHECK(full.GetParams()[4].kind == RootParamKind_Cbv);
+	CHECK(full.GetParams()[4].shaderRegister == 6);
+	CHECK(!full.IsValid());
+
+	RootLayout fallback;
+	for (uint32_t i = 0; i < 3; i++)
+		fallback.AddPerDrawData(i, 64, RootShaderStage_All);
+	fallback.AddPerDrawData(3, 64, RootShaderStage_All);
+	CHECK(fallback.GetDwordCost() <= RootLayout::MaxRootDwords);
+	CHECK(fallback.IsValid());
+}
+
+static void TestHashAndEquality()
+{
+	RootLayout a;
+	a.AddPerDrawData(0, 64, RootShaderStage_Vertex);
+	a.AddSrvTable(0, 1, RootShaderStage_Pixel);
+	RootLayout b;
+	b.AddPerDrawData(0, 64, RootShaderStage_Vertex);
+	b.AddSrvTable(0, 1, RootShaderStage_Pixel);
+	CHECK(a == b && a.Hash() == b.Hash());
+
+	// every field takes part
+	RootLayout stage;
+	stage.AddPerDrawData(0, 64, RootShaderStage_Pixel);
+	stage.AddSrvTable(0, 1, RootShaderStage_Pixel);
+	RootLayout reg;
+	reg.AddPerDrawData(1, 64, RootShaderStage_Vertex);
+	reg.AddSrvTable(0, 1, RootShaderStage_Pixel);
+	RootLayout flags = a;
+	flags.SetAllowInputLayout(false);
+	CHECK(!(a == stage) && a.Hash() != stage.Hash());
+	CHECK(!(a == reg) && a.Hash() != reg.Hash());
+	CHECK(!(a == flags) && a.Hash() != flags.Hash());
+}
+
+static void TestCache()
+{
+	RootLayoutCache<int> cache;
+	int created = 0;
+	auto create = [&](const RootLayout&) { return ++created; };
+
+	RootLayout a;
+	a.AddPerDrawData(0, 64, RootShaderStage_Vertex);
+	a.AddSrvTable(0, 1, RootShaderStage_Pixel);
+	RootLayout same = a;
+	RootLayout other;
+	other.AddPerDrawData(0, 256, RootShaderStage_Vertex);
+
+	CHECK(cache.GetOrCreate(a, create) == 1);
+	CHECK(cache.GetOrCreate(same, create) == 1);
+	CHECK(cache.GetOrCreate(other, create) == 2);
+	CHECK(cache.GetSize() == 2);
+	CHECK(cache.GetHits() == 1 && cache.GetMisses() == 2);
+
+	cache.Clear();
+	CHECK(cache.GetSize() == 0);
+	CHECK(cache.GetOrCreate(a, create) == 3);
+}
+
+int main()
+{
+	TestPerDrawRouting();
+	TestHashAndEquality();
+	TestCache();
+	return TestResult();
+}
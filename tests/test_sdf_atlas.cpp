@@ -0,0 +1,212 @@
+// ImFontAtlasFlags_SDF: a zoom sweep from 8 to 96 px and back in quarter pixel steps is served by
+// one bake at SDFBakeSize, rasterizing each glyph once into a texture that never grows, where a
+// coverage atlas bakes every rounded size. ImFontAtlasBuildConvertCoverageToSDF() on anti-aliased
+// half planes and discs: values decrease monotonically across the edge and cross 128 on it. on
+// baked glyphs the margin stays outside and neighbours differ by at most two pixels' worth of distance
+#include "counting_font_loader.h"
+#include "imgui_headless.h"
+#include "test.h"
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+static std::string LatinText()
+{
+	std::string text;
+	for (unsigned c = 0x20; c < 0x7F; c++)
+	{
+		text += (char)c;
+		if ((c & 31) == 31)
+			text += "\n";
+	}
+	return text;
+}
+
+static std::vector<float> SweepSizes()
+{
+	std::vector<float> sizes;
+	for (float size = 8.0f; size <= 96.0f; size += 0.25f)
+		sizes.push_back(size);
+	for (float size = 96.0f; size >= 8.0f; size -= 0.25f)
+		sizes.push_back(size);
+	return sizes;
+}
+
+struct SweepResult
+{
+	int bakes = 0, glyphs = 0, glyphsAfterFirstFrame = 0, texturesCreated = 0, texturesAfterFirstFrame = 0;
+	float widthAt32 = 0.0f, widthAt64 = 0.0f;
+};
+
+static SweepResult ZoomSweep(bool sdf)
+{
+	HeadlessImGui imgui;
+	ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+	if (sdf)
+		atlas->Flags |= ImFontAtlasFlags_SDF;
+	CountingFontLoader::Install(atlas);
+	ImFont* font = atlas->AddFontDefault();
+	CountingFontLoader::Reset();
+
+	SweepResult result;
+	const std::string text = LatinText();
+	for (float size : SweepSizes())
+	{
+		imgui.NewFrame();
+		ImGui::SetNextWindowPos(ImVec2(0, 0));
+		ImGui::Begin("zoom", nullptr, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+		ImGui::PushFont(font, size);
+		ImGui::TextUnformatted(text.c_str());
+		if (size == 32.0f)
+			result.widthAt32 = ImGui::CalcTextSize(text.c_str()).x;
+		if (size == 64.0f)
+			result.widthAt64 = ImGui::CalcTextSize(text.c_str()).x;
+		ImGui::PopFont();
+		ImGui::End();
+		ImGui::Render();
+		for (ImTextureData* tex : ImGui::GetPlatformIO().Textures)
+		{
+			result.texturesCreated += tex->Status == ImTextureStatus_WantCreate;
+			result.texturesAfterFirstFrame += tex->Status == ImTextureStatus_WantCreate && ImGui::GetFrameCount() > 1;
+			CHECK(tex->UseSDF == sdf);
+		}
+		HeadlessImGui::ProcessTextures();
+		if (size == 8.0f && result.glyphs == 0)
+			result.glyphs = CountingFontLoader::glyphs;
+	}
+	result.glyphsAfterFirstFrame = CountingFontLoader::glyphs - result.glyphs;
+	result.glyphs = CountingFontLoader::glyphs;
+	result.bakes = CountingFontLoader::bakes;
+	return result;
+}
+
+static void TestZoomSweep()
+{
+	const SweepResult sdf = ZoomSweep(true);
+	CHECK(sdf.bakes == 1);
+	CHECK(sdf.glyphs >= 95 && sdf.glyphsAfterFirstFrame == 0); // the text, and the fallback glyph
+	CHECK(sdf.texturesAfterFirstFrame == 0);
+	CHECK(fabsf(sdf.widthAt64 - sdf.widthAt32 * 2.0f) <= 1.0f); // the one bake scaled to each size, CalcTextSize() rounds up
+
+	// every rounded size from 8 to 96, and again on the way back for the bakes discarded meanwhile
+	const SweepResult coverage = ZoomSweep(false);
+	CHECK(coverage.bakes > 89);
+	CHECK(coverage.glyphsAfterFirstFrame > 95 * 88);
+	CHECK(coverage.texturesAfterFirstFrame > 10);
+}
+
+// coverage of a shape supersampled 16x16 per pixel, converted, then every pixel against the signed
+// distance from its center to the shape, which signedDistance() returns negative inside
+template<typename SignedDistance>
+static void CheckField(ImFontAtlas* atlas, int size, int spread, SignedDistance signedDistance, int& outOfOrder, float& maxError, int& edgePixels)
+{
+	std::vector<unsigned char> pixels(size * size);
+	for (int y = 0; y < size; y++)
+		for (int x = 0; x < size; x++)
+		{
+			int covered = 0;
+			for (int sy = 0; sy < 16; sy++)
+				for (int sx = 0; sx < 16; sx++)
+					covered += signedDistance(x + (sx + 0.5f) / 16.0f, y + (sy + 0.5f) / 16.0f) < 0.0f;
+			pixels[y * size + x] = (unsigned char)((covered * 255 + 128) / 256);
+		}
+	ImFontAtlasBuildConvertCoverageToSDF(atlas, pixels.data(), size, size, spread);
+
+	const float scale = 127.0f / spread;
+	for (int y = 0; y < size; y++)
+		for (int x = 0; x < size; x++)
+		{
+			const float distance = signedDistance(x + 0.5f, y + 0.5f);
+			const int value = pixels[y * size + x];
+			if (fabsf(distance) < spread - 1.0f)
+				maxError = ImMax(maxError, fabsf((128.0f - value) / scale - distance));
+			edgePixels += fabsf(distance) < 0.5f;
+
+			// moving one pixel further out along any axis never gets closer to inside
+			const int dx[] = { 1, -1, 0, 0 }, dy[] = { 0, 0, 1, -1 };
+			for (int k = 0; k < 4; k++)
+			{
+				const int nx = x + dx[k], ny = y + dy[k];
+				if (nx < 0 || ny < 0 || nx >= size || ny >= size)
+					continue;
+				if (signedDistance(nx + 0.5f, ny + 0.5f) > distance + 0.5f)
+					outOfOrder += pixels[ny * size + nx] > value;
+			}
+		}
+}
+
+static void TestMonotoneAcrossEdge(ImFontAtlas* atlas)
+{
+	const int spread = 4;
+	int outOfOrder = 0, edgePixels = 0;
+	float maxError = 0.0f;
+	for (int i = 0; i < 24; i++)
+	{
+		// half planes through the middle at every angle and subpixel offset
+		const float angle = i * 0.2617994f + 0.05f, offset = (i % 4) * 0.25f;
+		const float nx = cosf(angle), ny = sinf(angle);
+		CheckField(atlas, 32, spread, [&](float x, float y) { return (x - 16.0f) * nx + (y - 16.0f) * ny - offset; }, outOfOrder, maxError, edgePixels);
+
+		// discs, the field is positive outside and negative inside
+		const float radius = 2.5f + i * 0.5f, cx = 20.0f + offset, cy = 20.0f - offset;
+		CheckField(atlas, 40, spread, [&](float x, float y) { return sqrtf((x - cx) * (x - cx) + (y - cy) * (y - cy)) - radius; }, outOfOrder, maxError, edgePixels);
+	}
+	CHECK(outOfOrder == 0);
+	CHECK(maxError < 0.75f);
+	CHECK(edgePixels > 1000);
+}
+
+// the glyphs of an SDF atlas, baked at SDFBakeSize
+static void TestBakedGlyphs()
+{
+	HeadlessImGui imgui;
+	ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+	atlas->Flags |= ImFontAtlasFlags_SDF;
+	ImFont* font = atlas->AddFontDefault();
+	const std::string text = LatinText();
+	imgui.Frame([&] {
+		ImGui::PushFont(font, 13.0f);
+		ImGui::TextUnformatted(text.c_str());
+		ImGui::PopFont();
+	});
+	TestMonotoneAcrossEdge(atlas);
+
+	ImFontBaked* baked = font->GetFontBaked(13.0f);
+	CHECK(baked->Size == atlas->SDFBakeSize);
+	const int spread = atlas->SDFSpread;
+	const float maxStep = 127.0f / spread * 2.0f + 1.0f; // ProggyClean has hard edges: distances from pixel centers put half a pixel on each side
+	ImTextureData* tex = atlas->TexData;
+	int glyphs = 0, tooSteep = 0, borderInside = 0;
+	for (const ImFontGlyph& glyph : baked->Glyphs)
+	{
+		if (!glyph.Visible)
+			continue;
+		const ImTextureRect* rect = ImFontAtlasPackGetRect(atlas, glyph.PackId);
+		auto value = [&](int x, int y) { return (int)((const unsigned char*)tex->GetPixelsAt(rect->x + x, rect->y + y))[tex->BytesPerPixel - 1]; };
+		glyphs++;
+		int maxValue = 0;
+		for (int y = 0; y < rect->h; y++)
+			for (int x = 0; x < rect->w; x++)
+			{
+				maxValue = ImMax(maxValue, value(x, y));
+				if (x + 1 < rect->w)
+					tooSteep += abs(value(x + 1, y) - value(x, y)) > maxStep;
+				if (y + 1 < rect->h)
+					tooSteep += abs(value(x, y + 1) - value(x, y)) > maxStep;
+				if (x == 0 || y == 0 || x == rect->w - 1 || y == rect->h - 1)
+					borderInside += value(x, y) >= 128; // the margin is 'spread' pixels of outside
+			}
+		CHECK(maxValue > 128);
+	}
+	CHECK(glyphs > 90);
+	CHECK(tooSteep == 0);
+	CHECK(borderInside == 0);
+}
+
+int main()
+{
+	TestZoomSweep();
+	TestBakedGlyphs();
+	return TestResult();
+}
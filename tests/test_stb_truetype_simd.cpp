@@ -0,0 +1,141 @@
+// the STBTT_ENABLE_SIMD rasterizer (stbtt__fill_span, stbtt__resolve_scanline) against the scalar
+// one, byte for byte: every ProggyClean glyph at sizes 8 to 96 px with subpixel shifts and 1x1, 2x1
+// and 3x3 oversampling, random outlines with lines, quadratic and cubic curves in both windings at
+// 4 to 300 px, and every glyph of each .ttf passed on the command line. the two sum the same
+// coverage in another order, so pixels may differ by 1 and never more (so far they match exactly)
+#include "imgui_headless.h"
+#include "stb_truetype_variant.h"
+#include "test.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+struct Comparison
+{
+	int maxDiff = 0;
+	size_t pixels = 0, coveredPixels = 0, differentPixels = 0;
+	int shapes = 0;
+
+	void Add(const std::vector<unsigned char>& scalar, const std::vector<unsigned char>& simd)
+	{
+		for (size_t i = 0; i < scalar.size(); i++)
+		{
+			const int diff = abs((int)scalar[i] - (int)simd[i]);
+			maxDiff = diff > maxDiff ? diff : maxDiff;
+			differentPixels += diff != 0;
+			coveredPixels += scalar[i] != 0;
+		}
+		pixels += scalar.size();
+		shapes++;
+	}
+};
+
+static void CompareGlyphs(const unsigned char* data, const float* sizes, int sizeCount, Comparison& comparison)
+{
+	static const float shifts[] = { 0.0f, 0.33f, 0.71f };
+	static const int oversamples[][2] = { { 1, 1 }, { 2, 1 }, { 3, 3 } };
+	StbTrueTypeFont* scalarFont = StbScalar.LoadFont(data);
+	StbTrueTypeFont* simdFont = StbSimd.LoadFont(data);
+	CHECK(scalarFont != nullptr && simdFont != nullptr);
+	if (scalarFont == nullptr || simdFont == nullptr)
+		return;
+	std::vector<unsigned char> scalar, simd;
+	for (int sizeIndex = 0; sizeIndex < sizeCount; sizeIndex++)
+		for (const int* oversample : oversamples)
+			for (float shift : shifts)
+			{
+				const float scale = StbScalar.ScaleForPixelHeight(scalarFont, sizes[sizeIndex]);
+				const float scaleX = scale * oversample[0], scaleY = scale * oversample[1];
+				for (int glyph = 0; glyph < StbScalar.GlyphCount(scalarFont); glyph++)
+				{
+					int x0, y0, x1, y1;
+					StbScalar.GlyphBitmapBox(scalarFont, glyph, scaleX, scaleY, shift, shift, &x0, &y0, &x1, &y1);
+					if (x1 <= x0 || y1 <= y0)
+						continue;
+					const int w = x1 - x0 + oversample[0] - 1, h = y1 - y0 + oversample[1] - 1;
+					scalar.assign((size_t)w * h, 0);
+					simd.assign((size_t)w * h, 0);
+					StbScalar.MakeGlyphBitmap(scalarFont, scalar.data(), w, h, w, scaleX, scaleY, shift, shift, oversample[0], oversample[1], glyph);
+					StbSimd.MakeGlyphBitmap(simdFont, simd.data(), w, h, w, scaleX, scaleY, shift, shift, oversample[0], oversample[1], glyph);
+					comparison.Add(scalar, simd);
+				}
+			}
+	StbScalar.FreeFont(scalarFont);
+	StbSimd.FreeFont(simdFont);
+}
+
+static void CompareOutlines(int count, Comparison& comparison)
+{
+	std::mt19937 random(38);
+	std::vector<unsigned char> scalar, simd;
+	for (int i = 0; i < count; i++)
+	{
+		const std::vector<StbOutlineVertex> outline = MakeRandomOutline(random, 4, 2, 13);
+		const float pixels = 4.0f + (random() % 2970) / 10.0f;
+		const float scale = pixels / 2048.0f;
+		const float shiftX = (random() % 100) / 100.0f, shiftY = (random() % 100) / 100.0f;
+		const int w = (int)ceilf(pixels + shiftX) + 1, h = (int)ceilf(pixels) + 2;
+		const int yOff = (int)floorf(-pixels + shiftY);
+		scalar.assign((size_t)w * h, 0);
+		simd.assign((size_t)w * h, 0);
+		StbScalar.Rasterize(scalar.data(), w, h, outline.data(), (int)outline.size(), scale, shiftX, shiftY, 0, yOff);
+		StbSimd.Rasterize(simd.data(), w, h, outline.data(), (int)outline.size(), scale, shiftX, shiftY, 0, yOff);
+		comparison.Add(scalar, simd);
+	}
+}
+
+static void Report(const char* name, const Comparison& comparison)
+{
+	printf("%-28s %6d shapes, %9zu pixels, %9zu covered, %7zu differ, max diff %d\n", name, comparison.shapes, comparison.pixels,
+		comparison.coveredPixels, comparison.differentPixels, comparison.maxDiff);
+	CHECK(comparison.maxDiff <= 1);
+	CHECK(comparison.coveredPixels > comparison.pixels / 10);
+}
+
+static std::vector<unsigned char> ReadFile(const char* path)
+{
+	std::vector<unsigned char> data;
+	if (FILE* file = fopen(path, "rb"))
+	{
+		unsigned char buffer[65536];
+		for (size_t read; (read = fread(buffer, 1, sizeof(buffer), file)) > 0;)
+			data.insert(data.end(), buffer, buffer + read);
+		fclose(file);
+	}
+	return data;
+}
+
+int main(int argc, char** argv)
+{
+	CHECK(!StbScalar.simd);
+	if (!StbSimd.simd)
+		printf("no sse2/neon: both variants are scalar\n");
+
+	// ProggyClean is the only font shipped with imgui, the atlas holds its decompressed ttf
+	HeadlessImGui imgui;
+	imgui.Frame([] {});
+	static const float sizes[] = { 8.0f, 11.0f, 13.0f, 16.0f, 20.0f, 27.0f, 33.0f, 48.0f, 64.0f, 96.0f };
+	Comparison proggy;
+	CompareGlyphs((const unsigned char*)ImGui::GetIO().Fonts->Sources[0].FontData, sizes, IM_ARRAYSIZE(sizes), proggy);
+	Report("ProggyClean", proggy);
+	CHECK(proggy.shapes > 5000);
+
+	Comparison outlines;
+	CompareOutlines(2000, outlines);
+	Report("random outlines", outlines);
+
+	for (int i = 1; i < argc; i++)
+	{
+		static const float fileSizes[] = { 9.0f, 13.0f, 17.5f, 24.0f, 48.0f };
+		const std::vector<unsigned char> data = ReadFile(argv[i]);
+		CHECK(!data.empty());
+		if (data.empty())
+			continue;
+		Comparison font;
+		CompareGlyphs(data.data(), fileSizes, IM_ARRAYSIZE(fileSizes), font);
+		Report(argv[i], font);
+	}
+	return TestResult();
+}
@@ -0,0 +1,140 @@
+// ImGuiStorage with and without its hash index: random Set/Get/GetRef/GetVoidPtrRef/SetFloat
+// sequences checked against std::map for several HashThreshold values, hashed and sequential keys,
+// then BuildSortByKey() (also after pushing into Data directly), SetAllInt() and Clear(). a window
+// with 1000 tree nodes switches its StateStorage to the index and keeps every node's open state
+#include "imgui_headless.h"
+#include "imgui_internal.h"
+#include "test.h"
+#include <cstring>
+#include <map>
+#include <random>
+
+static bool Matches(const ImGuiStorage& storage, const std::map<ImGuiID, int>& expected)
+{
+	bool same = storage.Data.Size == (int)expected.size();
+	for (const auto& pair : expected)
+		same &= storage.GetInt(pair.first, -12345) == pair.second;
+	return same;
+}
+
+static void TestAgainstMap(int threshold, int keyRange)
+{
+	std::mt19937 random(threshold * 7 + keyRange);
+	ImGuiStorage storage;
+	storage.HashThreshold = threshold;
+	std::map<ImGuiID, int> expected;
+	int wrong = 0;
+	for (int op = 0; op < 20000; op++)
+	{
+		// sequential user keys (PushID(int) style) and scattered hash-like keys
+		const ImGuiID key = (keyRange > 1000) ? (ImGuiID)(random() % keyRange) * 2654435761u : (ImGuiID)(random() % keyRange);
+		const int value = (int)random();
+		const bool present = expected.count(key) != 0;
+		switch (random() % 6)
+		{
+		case 0:
+			storage.SetInt(key, value);
+			expected[key] = value;
+			break;
+		case 1:
+		{
+			int* ref = storage.GetIntRef(key, value);
+			wrong += *ref != (present ? expected[key] : value);
+			*ref = value + 1;
+			expected[key] = value + 1;
+			break;
+		}
+		case 2:
+		{
+			void** ref = storage.GetVoidPtrRef(key, (void*)(intptr_t)value);
+			if (!present)
+				expected[key] = value;
+			wrong += (int)(intptr_t)*ref != expected[key];
+			break;
+		}
+		case 3:
+			wrong += storage.GetInt(key, -12345) != (present ? expected[key] : -12345);
+			break;
+		case 4:
+		{
+			storage.SetFloat(key, 1.5f);
+			const float f = 1.5f;
+			int bits;
+			memcpy(&bits, &f, sizeof(bits));
+			expected[key] = bits;
+			break;
+		}
+		case 5:
+			if (!present)
+				wrong += storage.GetVoidPtr(key) != nullptr;
+			break;
+		}
+	}
+	CHECK(wrong == 0);
+	CHECK(Matches(storage, expected));
+	CHECK((storage.HashIndex.Size > 0) == (threshold > 0 && storage.Data.Size >= threshold));
+
+	storage.BuildSortByKey();
+	bool sorted = true;
+	for (int n = 1; n < storage.Data.Size; n++)
+		sorted &= storage.Data[n - 1].key < storage.Data[n].key;
+	CHECK(sorted);
+	CHECK(Matches(storage, expected));
+
+	// bulk fill then BuildSortByKey() rebuilds the index
+	for (int n = 0; n < 3000; n++)
+	{
+		const ImGuiID key = (ImGuiID)random();
+		if (expected.count(key) == 0)
+		{
+			storage.Data.push_back(ImGuiStoragePair(key, n));
+			expected[key] = n;
+		}
+	}
+	storage.BuildSortByKey();
+	CHECK(Matches(storage, expected));
+
+	storage.SetAllInt(7);
+	for (auto& pair : expected)
+		pair.second = 7;
+	CHECK(Matches(storage, expected));
+
+	storage.Clear();
+	CHECK(storage.Data.Size == 0 && storage.HashIndex.Size == 0 && storage.GetInt(1, -1) == -1);
+}
+
+// expand all on frame 1, then collapse every third node on frame 3
+static void TestTreeOpenState()
+{
+	HeadlessImGui imgui;
+	const int nodes = 1000;
+	bool correct = true;
+	for (int frame = 0; frame < 5; frame++)
+		imgui.Frame([&] {
+			ImGui::Begin("Tree");
+			for (int i = 0; i < nodes; i++)
+			{
+				if (frame == 1)
+					ImGui::SetNextItemOpen(true);
+				if (frame == 3 && i % 3 == 0)
+					ImGui::SetNextItemOpen(false);
+				ImGui::PushID(i);
+				const bool open = ImGui::TreeNodeEx("node", ImGuiTreeNodeFlags_NoTreePushOnOpen);
+				ImGui::PopID();
+				correct &= open == (frame >= 1 && !(frame >= 3 && i % 3 == 0));
+			}
+			ImGui::End();
+		});
+	CHECK(correct);
+	const ImGuiStorage& storage = ImGui::FindWindowByName("Tree")->StateStorage;
+	CHECK(storage.Data.Size >= nodes && storage.HashIndex.Size > 0);
+}
+
+int main()
+{
+	for (int threshold : { 0, 1, 5, 64, 256 })
+		for (int keyRange : { 50, 1000, 100000 })
+			TestAgainstMap(threshold, keyRange);
+	TestTreeOpenState();
+	return TestResult();
+}
@@ -0,0 +1,173 @@
+// ImGuiTextChunkedBuffer against a std::string split into lines the ImGuiTextIndex way: random
+// appends through append() with and without str_end and appendf(), small chunks, lines longer than
+// a chunk, with and without a MaxSize cap. every step checks line count and LinesDropped, the size
+// kept within the cap, iteration with next_line() and random seek_line(), and that complete lines
+// never move. a full capped buffer must stop allocating
+#include "imgui.h"
+#include "test.h"
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+static std::mt19937 g_random(12345);
+static int g_allocations = 0;
+
+static void* CountingAlloc(size_t size, void*)
+{
+	g_allocations++;
+	return malloc(size);
+}
+
+static void CountingFree(void* ptr, void*)
+{
+	free(ptr);
+}
+
+static std::vector<std::string> SplitLines(const std::string& text)
+{
+	std::vector<std::string> lines;
+	size_t begin = 0;
+	while (begin < text.size())
+	{
+		const size_t end = text.find('\n', begin);
+		if (end == std::string::npos)
+		{
+			lines.push_back(text.substr(begin));
+			break;
+		}
+		lines.push_back(text.substr(begin, end - begin));
+		begin = end + 1;
+	}
+	return lines;
+}
+
+struct StableLine
+{
+	const char* Begin;
+	std::string Text;
+	int AbsoluteLine;
+};
+
+static void TestRandomAppends()
+{
+	int wrongCounts = 0, wrongSizes = 0, wrongLines = 0, wrongSeeks = 0, movedLines = 0, overCap = 0;
+	for (int iteration = 0; iteration < 400; iteration++)
+	{
+		const int chunkSize = 16 + g_random() % 300;
+		const size_t maxSize = (iteration % 3 == 0) ? 0 : (size_t)(g_random() % 3000);
+		ImGuiTextChunkedBuffer buffer(chunkSize, maxSize);
+		std::string expected;
+		std::vector<StableLine> stableLines;
+		const int appends = 50 + g_random() % 400;
+		for (int step = 0; step < appends; step++)
+		{
+			std::string text;
+			const int length = (g_random() % 10 == 0) ? g_random() % (chunkSize * 3) : g_random() % 40;
+			for (int i = 0; i < length; i++)
+				text += (g_random() % 8 == 0) ? '\n' : (char)('a' + g_random() % 26);
+			const int mode = g_random() % 3;
+			if (mode == 0)
+			{
+				buffer.append(text.c_str(), text.c_str() + text.size());
+			}
+			else if (mode == 1)
+			{
+				buffer.append(text.c_str());
+			}
+			else
+			{
+				buffer.appendf("%s%d", text.c_str(), step);
+				text += std::to_string(step);
+			}
+			expected += text;
+
+			const std::vector<std::string> lines = SplitLines(expected);
+			if (buffer.LinesDropped + buffer.lines_count() != (int)lines.size() || (maxSize == 0 && buffer.LinesDropped != 0))
+			{
+				wrongCounts++;
+				continue;
+			}
+			overCap += maxSize != 0 && buffer.TotalSize > maxSize && buffer.Chunks.Size > 1;
+			size_t chunksSize = 0;
+			for (const ImGuiTextChunkedBuffer::Chunk& chunk : buffer.Chunks)
+			{
+				chunksSize += chunk.Size;
+				wrongSizes += chunk.Size <= 0 || chunk.Size > chunk.Capacity - 1;
+			}
+			wrongSizes += chunksSize != buffer.TotalSize;
+
+			// every stored line through next_line(), a '\n' after each but the unfinished last one
+			size_t storedSize = 0;
+			int lineCount = 0;
+			for (ImGuiTextChunkedBuffer::Cursor cursor = buffer.seek_line(0); cursor.LineNo < buffer.lines_count(); buffer.next_line(&cursor), lineCount++)
+			{
+				const std::string& line = lines[buffer.LinesDropped + cursor.LineNo];
+				wrongLines += std::string(cursor.LineBegin, cursor.LineEnd) != line;
+				storedSize += line.size() + 1;
+			}
+			wrongLines += lineCount != buffer.lines_count();
+			if (buffer.lines_count() > 0)
+			{
+				if (expected.back() != '\n')
+					storedSize--;
+				wrongSizes += storedSize != buffer.TotalSize;
+				for (int k = 0; k < 4; k++)
+				{
+					const int line = g_random() % buffer.lines_count();
+					wrongSeeks += std::string(buffer.get_line_begin(line), buffer.get_line_end(line)) != lines[buffer.LinesDropped + line];
+				}
+			}
+			wrongSeeks += buffer.seek_line(buffer.lines_count()).LineBegin != nullptr;
+
+			// complete lines stay where they are until their chunk is dropped
+			for (const StableLine& stable : stableLines)
+				if (stable.AbsoluteLine >= buffer.LinesDropped)
+					movedLines += memcmp(stable.Begin, stable.Text.data(), stable.Text.size()) != 0;
+			if (buffer.lines_count() > 1)
+			{
+				const int line = g_random() % (buffer.lines_count() - 1);
+				stableLines.push_back({ buffer.get_line_begin(line), lines[buffer.LinesDropped + line], buffer.LinesDropped + line });
+			}
+		}
+		if (iteration % 50 == 0)
+		{
+			buffer.clear();
+			CHECK(buffer.lines_count() == 0 && buffer.TotalSize == 0 && buffer.LinesDropped == 0);
+			buffer.append("x\ny");
+			CHECK(buffer.lines_count() == 2);
+		}
+	}
+	CHECK(wrongCounts == 0);
+	CHECK(wrongSizes == 0);
+	CHECK(wrongLines == 0);
+	CHECK(wrongSeeks == 0);
+	CHECK(movedLines == 0);
+	CHECK(overCap == 0);
+}
+
+static void TestCappedStopsAllocating()
+{
+	ImGui::SetAllocatorFunctions(CountingAlloc, CountingFree);
+	{
+		ImGuiTextChunkedBuffer buffer(4096, 64 * 1024);
+		for (int i = 0; i < 20000; i++)
+			buffer.appendf("[%08d] some log message %d\n", i, i * 7);
+		const int allocations = g_allocations;
+		const int linesDropped = buffer.LinesDropped;
+		for (int i = 0; i < 20000; i++)
+			buffer.appendf("[%08d] some log message %d\n", i, i * 7);
+		CHECK(g_allocations == allocations);
+		CHECK(buffer.LinesDropped > linesDropped && buffer.TotalSize <= 64 * 1024);
+		CHECK(std::string(buffer.get_line_begin(buffer.lines_count() - 1), buffer.get_line_end(buffer.lines_count() - 1)) == "[00019999] some log message 139993");
+	}
+	ImGui::SetAllocatorFunctions(nullptr, nullptr);
+}
+
+int main()
+{
+	TestRandomAppends();
+	TestCappedStopsAllocating();
+	return TestResult();
+}
@@ -0,0 +1,208 @@
+// ImGuiTextFilter, built with simd (test_text_filter) and horspool (test_text_filter_scalar)
+// needle search: random filters on random logs against a bounded ImStristr() style reference of
+// the previous matching, through PassFilter() with and without text_end, PassFilterLines() on random
+// line ranges (bits outside the range untouched), and refine passes after typing one more character
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "test.h"
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+static std::mt19937 g_random(88172645);
+
+// case insensitive search that never reads past text_end
+static bool ReferenceFind(const char* text, const char* textEnd, const char* needle, const char* needleEnd)
+{
+	if (needle >= needleEnd)
+		return false;
+	for (; textEnd - text >= needleEnd - needle; text++)
+	{
+		int k = 0;
+		while (needle + k < needleEnd && ImToUpper(text[k]) == ImToUpper(needle[k]))
+			k++;
+		if (needle + k == needleEnd)
+			return true;
+	}
+	return false;
+}
+
+static bool ReferencePass(const ImGuiTextFilter& filter, const char* text, const char* textEnd)
+{
+	if (filter.Filters.Size == 0)
+		return true;
+	for (const ImGuiTextFilter::ImGuiTextRange& range : filter.Filters)
+	{
+		if (range.b == range.e)
+			continue;
+		if (range.b[0] == '-')
+		{
+			if (ReferenceFind(text, textEnd, range.b + 1, range.e))
+				return false;
+		}
+		else if (ReferenceFind(text, textEnd, range.b, range.e))
+		{
+			return true;
+		}
+	}
+	return filter.CountGrep == 0;
+}
+
+static const char* g_words[] = { "error", "Warning", "info", "texture", "Shader", "frame", "ERR", "load", "save", "abc", "aBcD", "x", "zz", "The", "quick", "brown", "fox" };
+
+static std::string RandomWord()
+{
+	std::string word = g_words[g_random() % IM_ARRAYSIZE(g_words)];
+	if (g_random() % 3 == 0)
+		for (char& c : word)
+			c = (g_random() & 1) ? ImToUpper(c) : (char)((c >= 'A' && c <= 'Z') ? c | 32 : c);
+	return word;
+}
+
+static std::string RandomLine()
+{
+	std::string line;
+	const int words = g_random() % 12;
+	for (int i = 0; i < words; i++)
+	{
+		if (i > 0)
+			line += (g_random() % 5 == 0) ? "," : " ";
+		line += RandomWord();
+		if (g_random() % 4 == 0)
+			line += std::to_string(g_random() % 1000);
+	}
+	return line;
+}
+
+// 1-3 include/exclude terms made of word pieces, with stray separators and a lone "-" now and then
+static std::string RandomFilter()
+{
+	std::string filter;
+	const int terms = 1 + g_random() % 3;
+	for (int i = 0; i < terms; i++)
+	{
+		if (i > 0)
+			filter += (g_random() % 2) ? "," : " , ";
+		if (g_random() % 4 == 0)
+			filter += "-";
+		const std::string word = RandomWord();
+		const int length = 1 + g_random() % word.size();
+		filter += word.substr(g_random() % (word.size() - length + 1), length);
+		if (g_random() % 6 == 0)
+			filter += " " + RandomWord();
+	}
+	if (g_random() % 20 == 0)
+		filter += ",";
+	if (g_random() % 30 == 0)
+		filter = "-";
+	return filter;
+}
+
+static void TestRandomFilters()
+{
+	int wrongPass = 0, wrongBits = 0, wrongCounts = 0, wrongRefines = 0, refines = 0;
+	for (int iteration = 0; iteration < 3000; iteration++)
+	{
+		ImGuiTextFilter filter(RandomFilter().c_str());
+		std::string log;
+		std::vector<int> offsets;
+		int lines = g_random() % 300;
+		for (int i = 0; i < lines; i++)
+		{
+			offsets.push_back((int)log.size());
+			log += RandomLine();
+			if (i + 1 < lines || g_random() % 2)
+				log += "\n";
+		}
+		if (lines == 0)
+		{
+			offsets.push_back(0);
+			lines = 1;
+		}
+		const char* logBegin = log.c_str();
+		const char* logEnd = logBegin + log.size();
+		std::vector<char> expected(lines);
+		for (int n = 0; n < lines; n++)
+		{
+			const char* lineBegin = logBegin + offsets[n];
+			const char* lineEnd = (n + 1 < lines) ? logBegin + offsets[n + 1] - 1 : logEnd;
+			expected[n] = ReferencePass(filter, lineBegin, lineEnd);
+			const std::string line(lineBegin, lineEnd);
+			wrongPass += filter.PassFilter(lineBegin, lineEnd) != (bool)expected[n];
+			wrongPass += filter.PassFilter(line.c_str()) != (bool)expected[n];
+		}
+
+		// a random range of lines, guard bits around it must survive
+		const ImU32 guard = 0xA5A5A5A5u;
+		std::vector<ImU32> bits((lines + 31) / 32 + 1, guard);
+		const int rangeBegin = g_random() % (lines + 1);
+		const int rangeEnd = rangeBegin + g_random() % (lines - rangeBegin + 1);
+		const int count = filter.PassFilterLines(logBegin, logEnd, offsets.data(), lines, bits.data(), rangeBegin, rangeEnd);
+		int expectedCount = 0;
+		for (int n = 0; n < (int)bits.size() * 32; n++)
+		{
+			const bool inRange = n >= rangeBegin && n < rangeEnd;
+			const bool bit = (bits[n >> 5] >> (n & 31)) & 1;
+			wrongBits += bit != (inRange ? (bool)expected[n] : (bool)((guard >> (n & 31)) & 1));
+			expectedCount += inRange && expected[n];
+		}
+		wrongCounts += count != expectedCount;
+
+		// typing one more character: when Build() says the filter refines the previous one, a refine
+		// pass over the previous bits gives the same bits as a full pass
+		std::vector<ImU32> previous((lines + 31) / 32, 0);
+		filter.PassFilterLines(logBegin, logEnd, offsets.data(), lines, previous.data());
+		const size_t length = strlen(filter.InputBuf);
+		if (length + 2 < sizeof(filter.InputBuf))
+		{
+			filter.InputBuf[length] = "aeiouxZ3 -"[g_random() % 10];
+			filter.InputBuf[length + 1] = 0;
+			if (g_random() % 5 == 0)
+			{
+				memmove(filter.InputBuf + 1, filter.InputBuf, length + 2);
+				filter.InputBuf[0] = 'q';
+			}
+			filter.Build();
+			std::vector<ImU32> fresh((lines + 31) / 32, 0);
+			filter.PassFilterLines(logBegin, logEnd, offsets.data(), lines, fresh.data());
+			if (filter.RefinesPrevious)
+			{
+				for (size_t word = 0; word < fresh.size(); word++)
+					wrongRefines += (fresh[word] & ~previous[word]) != 0;
+				filter.PassFilterLines(logBegin, logEnd, offsets.data(), lines, previous.data(), 0, lines, true);
+				wrongRefines += previous != fresh;
+				refines++;
+			}
+		}
+	}
+	CHECK(wrongPass == 0);
+	CHECK(wrongBits == 0);
+	CHECK(wrongCounts == 0);
+	CHECK(wrongRefines == 0);
+	CHECK(refines > 500);
+}
+
+static void TestCases()
+{
+	ImGuiTextFilter filter("-bar,foo");
+	ImGuiTextFilter copy = filter; // terms point into the copy's own buffers, first matching term wins
+	CHECK(copy.PassFilter("xFOOx") && !copy.PassFilter("foo bar") && !copy.PassFilter("nothing"));
+
+	// no reading past text_end
+	ImGuiTextFilter needle("needle");
+	const char text[] = "a needle";
+	CHECK(needle.PassFilter(text, text + 8) && !needle.PassFilter(text, text + 7));
+
+	ImGuiTextFilter exclude("-x");
+	CHECK(exclude.PassFilter("abc") && !exclude.PassFilter("aXc"));
+	ImGuiTextFilter empty("");
+	CHECK(empty.PassFilter("anything") && !empty.IsActive());
+}
+
+int main()
+{
+	TestCases();
+	TestRandomFilters();
+	return TestResult();
+}
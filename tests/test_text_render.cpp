@@ -0,0 +1,97 @@
+// ImFont::RenderText glyph-run fast path against the regular per-character loop. cpu fine clipping
+// turns the fast path off and changes nothing when the clip rect contains all of the text, so
+// rendering with and without it must give the same vertices, indices and commands. the fast path's
+// branchless horizontal clipping is checked by filtering unclipped output with the same test
+#include "imgui_headless.h"
+#include "draw_dump.h"
+#include "test.h"
+#include <string>
+#include <vector>
+
+static unsigned g_randomState = 1;
+
+static unsigned RandomInt()
+{
+	g_randomState = g_randomState * 1664525u + 1013904223u;
+	return g_randomState >> 8;
+}
+
+static float RandomFloat()
+{
+	return (RandomInt() & 0xFFFFFF) / 16777216.0f;
+}
+
+// ascii, latin-1, other utf-8, truncated and invalid sequences, tabs and line breaks
+static void RandomText(std::string& out, int length)
+{
+	static const char* pieces[] = { "hello", " ", "world", "\n", "\r\n", "\xC3\xA9t\xC3\xA9", "\xC2\xB0", "\xE2\x82\xAC",
+		"\xE6\x97\xA5\xE6\x9C\xAC", "\t", "\xC3", "\xC2\x41", "ABCDEFGHIJKLMNOPQRSTUVWXYZ", "0123456789", "{}[]()<>", "\xC3\xBF", "\x7F" };
+	out.clear();
+	while ((int)out.size() < length)
+		out += pieces[RandomInt() % (sizeof(pieces) / sizeof(pieces[0]))];
+}
+
+static bool SameRecords(const DumpRecord& a, const DumpRecord& b)
+{
+	if (a.vertices.size() != b.vertices.size() || a.indices != b.indices)
+		return false;
+	for (size_t i = 0; i < a.vertices.size(); i++)
+		if (a.vertices[i].x != b.vertices[i].x || a.vertices[i].y != b.vertices[i].y ||
+			a.vertices[i].u != b.vertices[i].u || a.vertices[i].v != b.vertices[i].v || a.vertices[i].col != b.vertices[i].col)
+			return false;
+	return true;
+}
+
+// quads of a draw list with the vertices in PrimRectUV() order, x1/x2 from the top-left/bottom-right corners
+static std::vector<DumpVertex> QuadsInside(const DumpRecord& record, float clipMinX, float clipMaxX)
+{
+	std::vector<DumpVertex> kept;
+	for (size_t quad = 0; quad + 4 <= record.vertices.size(); quad += 4)
+		if (record.vertices[quad].x <= clipMaxX && record.vertices[quad + 2].x >= clipMinX)
+			kept.insert(kept.end(), record.vertices.begin() + quad, record.vertices.begin() + quad + 4);
+	return kept;
+}
+
+static DumpRecord Render(HeadlessImGui& imgui, const std::string& text, float size, const ImVec2& pos, ImU32 col, const ImVec4& clip, bool cpuFineClip)
+{
+	imgui.NewFrame();
+	ImDrawList* drawList = ImGui::GetBackgroundDrawList();
+	ImGui::GetFont()->RenderText(drawList, size, pos, col, clip, text.c_str(), text.c_str() + text.size(), 0.0f, cpuFineClip);
+	DumpRecord record = MakeDumpRecord<ImVec2>(drawList);
+	imgui.EndFrame();
+	return record;
+}
+
+int main()
+{
+	HeadlessImGui imgui(1920.0f, 1080.0f);
+	const ImVec4 noClip(-1e9f, -1e9f, 1e9f, 1e9f);
+	std::string text;
+	int rendered = 0;
+	for (int iteration = 0; iteration < 600; iteration++)
+	{
+		RandomText(text, 1 + RandomInt() % 400);
+		const float size = (iteration % 3 == 0) ? 13.0f : 8.0f + RandomFloat() * 30.0f;
+		const ImVec2 pos(RandomFloat() * 400.0f - 100.0f, RandomFloat() * 400.0f - 100.0f);
+		const ImU32 col = IM_COL32(RandomInt() & 255, RandomInt() & 255, RandomInt() & 255, 255);
+
+		// the first render bakes the glyphs the text needs, so both paths then see the same atlas
+		Render(imgui, text, size, pos, col, noClip, false);
+		const DumpRecord fast = Render(imgui, text, size, pos, col, noClip, false);
+		const DumpRecord regular = Render(imgui, text, size, pos, col, noClip, true);
+		CHECK(SameRecords(fast, regular));
+		rendered += fast.vertices.empty() ? 0 : 1;
+
+		// only horizontal clipping, so whole lines are never skipped
+		const float clipMinX = RandomFloat() * 300.0f;
+		const float clipMaxX = clipMinX + RandomFloat() * 600.0f;
+		const DumpRecord clipped = Render(imgui, text, size, pos, col, ImVec4(clipMinX, -1e9f, clipMaxX, 1e9f), false);
+		const std::vector<DumpVertex> expected = QuadsInside(fast, clipMinX, clipMaxX);
+		DumpRecord expectedRecord;
+		expectedRecord.vertices = expected;
+		CHECK(SameRecords(DumpRecord{ clipped.vertices, {} }, expectedRecord));
+		CHECK(clipped.indices.size() == clipped.vertices.size() / 4 * 6);
+	}
+	CHECK(rendered > 550); // a few strings are only blanks and line breaks
+	return TestResult();
+}
@@ -0,0 +1,169 @@
+// ImGuiTextSizeCache: CalcTextSize() with the cache on returns what it returns with the cache off,
+// across frames, font sizes, wrap widths, evictions, text buffer compaction and atlas changes.
+// entries whose hashes collide are told apart by their text
+#include "imgui_headless.h"
+#include "imgui_internal.h"
+#include "test.h"
+#include <string>
+#include <vector>
+
+static unsigned g_randomState = 1;
+
+static unsigned RandomInt()
+{
+	g_randomState = g_randomState * 1664525u + 1013904223u;
+	return g_randomState >> 8;
+}
+
+static ImGuiTextSizeCacheEntry MakeKey(ImU64 hash, const char* text)
+{
+	ImGuiTextSizeCacheEntry key = {};
+	key.Hash = hash;
+	key.BakedId = 1;
+	key.TextLen = (int)strlen(text);
+	key.FontSize = 13.0f;
+	key.WrapWidth = -1.0f;
+	key.Size = ImVec2((float)key.TextLen, 13.0f);
+	return key;
+}
+
+static void TestDisabledByDefault()
+{
+	ImGuiTextSizeCache cache;
+	CHECK(!cache.Enabled);
+	HeadlessImGui imgui;
+	CHECK(!GImGui->TextSizeCache.Enabled);
+	imgui.Frame([] { ImGui::Button("Label"); });
+	CHECK(GImGui->TextSizeCache.Count == 0);
+}
+
+// same hash, length and other key fields, different text: only the matching text hits
+static void TestCollisions()
+{
+	ImGuiTextSizeCache cache;
+	const char* texts[] = { "abcd", "abce", "xbcd", "dcba" };
+	for (int i = 0; i < 4; i++)
+	{
+		ImGuiTextSizeCacheEntry key = MakeKey(42, texts[i]);
+		CHECK(cache.Find(key, texts[i], 1) == nullptr);
+		key.Size.x = (float)i;
+		cache.Add(key, texts[i], 1);
+	}
+	for (int i = 0; i < 4; i++)
+	{
+		const ImVec2* size = cache.Find(MakeKey(42, texts[i]), texts[i], 2);
+		CHECK(size != nullptr && size->x == (float)i);
+	}
+	CHECK(cache.Find(MakeKey(42, "abcf"), "abcf", 2) == nullptr);
+
+	// a full probe window evicts the least recently used entry and its text stops matching
+	for (int i = 0; i < IM_TEXTSIZECACHE_PROBE_MAX; i++)
+	{
+		const std::string text = "filler" + std::to_string(i);
+		cache.Add(MakeKey(42, text.c_str()), text.c_str(), 3 + i);
+	}
+	CHECK(cache.Count <= IM_TEXTSIZECACHE_PROBE_MAX);
+	CHECK(cache.Find(MakeKey(42, "abcd"), "abcd", 20) == nullptr);
+	CHECK(cache.Find(MakeKey(42, "filler7"), "filler7", 20) != nullptr);
+}
+
+// evicted entries leave their text behind until the buffer is compacted
+static void TestTextBufCompaction()
+{
+	ImGuiTextSizeCache cache;
+	std::string text;
+	int maxLength = 0;
+	for (int frame = 1; frame < 2000; frame++)
+		for (int i = 0; i < 50; i++)
+		{
+			text = "label " + std::to_string(frame) + " " + std::to_string(i) + std::string(RandomInt() % 64, 'x');
+			maxLength = ImMax(maxLength, (int)text.size());
+			ImGuiTextSizeCacheEntry key = MakeKey(ImGuiTextSizeCache::HashKey(text.c_str(), MakeKey(0, text.c_str())), text.c_str());
+			cache.Add(key, text.c_str(), frame);
+			CHECK(cache.TextBuf.Size <= IM_TEXTSIZECACHE_TEXTBUF_MIN + cache.LiveTextBytes * 2 + maxLength);
+		}
+	CHECK(cache.Entries.Size <= IM_TEXTSIZECACHE_SIZE_MAX);
+
+	// every live entry still finds its own text
+	int live = 0, liveBytes = 0;
+	for (const ImGuiTextSizeCacheEntry& entry : cache.Entries)
+		if (entry.Generation == cache.Generation)
+		{
+			const std::string copy(cache.TextBuf.Data + entry.TextOffset, entry.TextLen);
+			CHECK(cache.Find(entry, copy.c_str(), 5000) == &entry.Size);
+			live++;
+			liveBytes += entry.TextLen;
+		}
+	CHECK(live == cache.Count);
+	CHECK(liveBytes == cache.LiveTextBytes);
+	cache.CompactTextBuf();
+	CHECK(cache.TextBuf.Size == liveBytes);
+}
+
+static std::vector<std::string> g_strings;
+
+static void CheckStrings()
+{
+	ImGuiContext& g = *GImGui;
+	for (int n = 0; n < (int)g_strings.size(); n++)
+	{
+		const std::string& s = g_strings[n];
+		const float wrap = (n % 3 == 0) ? 50.0f + (n % 7) * 20.0f : -1.0f;
+		ImGui::PushFont(nullptr, 10.0f + (n % 5) * 3.0f);
+		g.TextSizeCache.Enabled = false;
+		const ImVec2 reference = ImGui::CalcTextSize(s.c_str(), nullptr, (n & 1) != 0, wrap);
+		g.TextSizeCache.Enabled = true;
+		const ImVec2 first = ImGui::CalcTextSize(s.c_str(), nullptr, (n & 1) != 0, wrap);
+		const ImVec2 second = ImGui::CalcTextSize(s.c_str(), nullptr, (n & 1) != 0, wrap);
+		CHECK(first.x == reference.x && first.y == reference.y);
+		CHECK(second.x == reference.x && second.y == reference.y);
+		ImGui::PopFont();
+	}
+}
+
+static void TestCalcTextSize()
+{
+	HeadlessImGui imgui;
+	ImGuiContext& g = *GImGui;
+	ImFont* font = ImGui::GetIO().Fonts->AddFontDefault();
+
+	const char* pieces[] = { "Hello", " ", "World", "\n", "##hidden", "###id", "\xC3\xA9", "\xE2\x82\xAC", "wrap me please ", "0123456789" };
+	for (int i = 0; i < 3000; i++)
+	{
+		std::string s;
+		for (int k = 1 + RandomInt() % 8; k > 0; k--)
+			s += pieces[RandomInt() % 10];
+		g_strings.push_back(s);
+	}
+	for (int frame = 0; frame < 5; frame++)
+		imgui.Frame(CheckStrings);
+	CHECK(g.TextSizeCache.HitsLastFrame > 0);
+
+	// changing glyph advances rebuilds the baked font data, which has to invalidate the cache
+	g.TextSizeCache.Enabled = true;
+	imgui.Frame([] { ImGui::CalcTextSize("Invalidation test"); });
+	imgui.NewFrame();
+	const float before = ImGui::CalcTextSize("Invalidation test").x;
+	imgui.EndFrame();
+	font->Sources[0]->GlyphExtraAdvanceX = 3.0f;
+	font->ClearOutputData(); // what the font editor in the Metrics window does
+	imgui.NewFrame();
+	const float after = ImGui::CalcTextSize("Invalidation test").x;
+	g.TextSizeCache.Enabled = false;
+	const float reference = ImGui::CalcTextSize("Invalidation test").x;
+	imgui.EndFrame();
+	CHECK(after == reference && after != before);
+	font->Sources[0]->GlyphExtraAdvanceX = 0.0f;
+	font->ClearOutputData();
+	for (int frame = 0; frame < 3; frame++)
+		imgui.Frame(CheckStrings);
+}
+
+int main()
+{
+	TestDisabledByDefault();
+	TestCollisions();
+	TestTextBufCompaction();
+	TestCalcTextSize();
+	return TestResult();
+}
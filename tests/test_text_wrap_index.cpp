@@ -0,0 +1,170 @@
+// ImGuiTextWrapIndex on random texts (words, long words, runs of blanks, empty lines, utf-8) at
+// several wrap widths: every logical line gets as many wrapped lines as CalcTextSizeA() measures,
+// each wrapped line starts where CalcWordWrapPosition() breaks the previous one and fits the width.
+// appends in random pieces, updating in between and changing width on the way, end with the same
+// offsets as a one-shot build. TextWrappedWithIndex() lays out as tall as TextWrapped()
+#include "imgui_headless.h"
+#include "imgui_internal.h"
+#include "test.h"
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <string>
+
+static std::mt19937 g_random(4242);
+static const float g_widths[] = { 20.0f, 57.5f, 120.0f, 300.0f, 1000.0f };
+
+static std::string RandomText(int words)
+{
+	static const char* pieces[] = { "a", "log", "frame", "texture", "compilation", "x=12.5,", "end.", "done!", "\xC3\xA9t\xC3\xA9", "-", "(42)" };
+	std::string text;
+	for (int i = 0; i < words; i++)
+	{
+		const int kind = g_random() % 20;
+		if (kind == 0)
+			text += "\n";
+		else if (kind == 1)
+			text += "\n\n";
+		else if (kind == 2)
+			text += std::string(1 + g_random() % 6, ' ');
+		else if (kind == 3)
+			text += std::string(20 + g_random() % 60, 'w'); // longer than the narrow widths, gets cut
+		else
+			text += pieces[g_random() % IM_ARRAYSIZE(pieces)];
+		if (kind > 3)
+			text += (g_random() % 4 == 0) ? "  " : " ";
+	}
+	return text;
+}
+
+static const char* SkipBlanks(const char* s, const char* end)
+{
+	while (s < end && ImCharIsBlankA(*s))
+		s++;
+	return s;
+}
+
+// wrapped lines of each logical line against CalcTextSizeA() and CalcWordWrapPosition()
+static void CheckWrapping(ImGuiTextWrapIndex& index, const char* text, ImFont* font, float fontSize, float width, int& wrongCounts, int& wrongBreaks, int& tooWide)
+{
+	const float lineHeight = fontSize;
+	int wrapped = 0;
+	for (int line = 0; line < index.size(); line++)
+	{
+		const char* lineBegin = index.get_line_begin(text, line);
+		const char* lineEnd = index.get_line_end(text, line);
+		const ImVec2 size = font->CalcTextSizeA(fontSize, FLT_MAX, width, lineBegin, lineEnd);
+		const int expectedLines = ImMax(1, (int)lroundf(size.y / lineHeight));
+		const char* nextLineBegin = (line + 1 < index.size()) ? index.get_line_begin(text, line + 1) : text + index.EndOffset;
+		const int first = wrapped;
+		while (wrapped < index.wrapped_size() && index.get_wrapped_line_begin(text, wrapped) < nextLineBegin)
+			wrapped++;
+		if (wrapped - first != expectedLines)
+		{
+			wrongCounts++;
+			continue;
+		}
+		for (int n = first; n < wrapped; n++)
+		{
+			const char* begin = index.get_wrapped_line_begin(text, n);
+			const char* expectedNext = SkipBlanks(font->CalcWordWrapPosition(fontSize, begin, lineEnd, width), lineEnd);
+			const char* next = (n + 1 < wrapped) ? index.get_wrapped_line_begin(text, n + 1) : lineEnd;
+			wrongBreaks += next != expectedNext;
+			const float lineWidth = font->CalcTextSizeA(fontSize, FLT_MAX, 0.0f, begin, index.get_wrapped_line_end(text, n)).x;
+			tooWide += lineWidth > width + 0.01f;
+		}
+	}
+	wrongCounts += wrapped != index.wrapped_size();
+}
+
+static void TestRandomTexts(ImFont* font, float fontSize)
+{
+	int wrongCounts = 0, wrongBreaks = 0, tooWide = 0, wrongIncremental = 0, lines = 0, wrappedLines = 0;
+	for (int iteration = 0; iteration < 300; iteration++)
+	{
+		const std::string text = RandomText(g_random() % 400);
+		const float width = g_widths[iteration % IM_ARRAYSIZE(g_widths)];
+		ImGuiTextWrapIndex oneShot;
+		oneShot.append(text.c_str(), 0, (int)text.size());
+		oneShot.update(text.c_str(), font, fontSize, width);
+		CheckWrapping(oneShot, text.c_str(), font, fontSize, width, wrongCounts, wrongBreaks, tooWide);
+		lines += oneShot.size();
+		wrappedLines += oneShot.wrapped_size();
+
+		// the same text appended in random pieces, cutting through words, blanks and line ends, with
+		// an update() after most appends and now and then at another width
+		ImGuiTextBuffer buffer;
+		ImGuiTextWrapIndex incremental;
+		for (size_t done = 0; done < text.size();)
+		{
+			const size_t piece = ImMin(text.size() - done, (size_t)(1 + g_random() % 60));
+			const int oldSize = buffer.size();
+			buffer.append(text.c_str() + done, text.c_str() + done + piece);
+			incremental.append(buffer.begin(), oldSize, buffer.size());
+			done += piece;
+			if (g_random() % 4 != 0)
+				incremental.update(buffer.begin(), font, fontSize, (g_random() % 10 == 0) ? width * 2.0f : width);
+		}
+		incremental.update(buffer.begin(), font, fontSize, width);
+		wrongIncremental += incremental.LineOffsets.Size != oneShot.LineOffsets.Size || incremental.WrapOffsets.Size != oneShot.WrapOffsets.Size ||
+			memcmp(incremental.WrapOffsets.Data, oneShot.WrapOffsets.Data, oneShot.WrapOffsets.size_in_bytes()) != 0;
+	}
+	CHECK(wrongCounts == 0);
+	CHECK(wrongBreaks == 0);
+	CHECK(tooWide == 0);
+	CHECK(wrongIncremental == 0);
+	CHECK(wrappedLines > lines * 2);
+}
+
+// a font or size change wraps everything again
+static void TestRewrap(ImFont* font, float fontSize)
+{
+	const std::string text = RandomText(2000);
+	ImGuiTextWrapIndex index;
+	index.append(text.c_str(), 0, (int)text.size());
+	index.update(text.c_str(), font, fontSize, 200.0f);
+	ImVector<int> at200 = index.WrapOffsets;
+	index.update(text.c_str(), font, fontSize * 2.0f, 200.0f);
+	CHECK(index.WrapOffsets.Size > at200.Size);
+	index.update(text.c_str(), font, fontSize, 200.0f);
+	CHECK(index.WrapOffsets.Size == at200.Size && memcmp(index.WrapOffsets.Data, at200.Data, at200.size_in_bytes()) == 0);
+	index.clear();
+	CHECK(index.size() == 0 && index.wrapped_size() == 0);
+}
+
+// same content height as TextWrapped() of the whole text
+static void TestLayout(HeadlessImGui& imgui)
+{
+	const std::string text = RandomText(3000);
+	ImGuiTextWrapIndex index;
+	index.append(text.c_str(), 0, (int)text.size());
+	float heights[2] = {};
+	for (int withIndex = 0; withIndex < 2; withIndex++)
+		for (int frame = 0; frame < 3; frame++)
+			imgui.Frame([&] {
+				ImGui::SetNextWindowPos(ImVec2(0, 0));
+				ImGui::SetNextWindowSize(ImVec2(400, 600));
+				ImGui::Begin(withIndex ? "Indexed" : "Plain", nullptr, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysVerticalScrollbar);
+				if (withIndex)
+					ImGui::TextWrappedWithIndex(&index, text.c_str());
+				else
+					ImGui::TextWrapped("%s", text.c_str());
+				heights[withIndex] = ImGui::GetCurrentWindow()->DC.CursorMaxPos.y - ImGui::GetCurrentWindow()->DC.CursorStartPos.y;
+				ImGui::End();
+			});
+	CHECK(fabsf(heights[0] - heights[1]) < 0.5f);
+	CHECK(index.wrapped_size() > index.size());
+}
+
+int main()
+{
+	HeadlessImGui imgui;
+	imgui.Frame([] {});
+	ImFont* font = ImGui::GetFont();
+	const float fontSize = ImGui::GetFontSize();
+	TestRandomTexts(font, fontSize);
+	TestRewrap(font, fontSize);
+	TestLayout(imgui);
+	return TestResult();
+}
@@ -0,0 +1,142 @@
+// TlsfAllocator: fixed cases for alignment, coalescing and exhaustion, then a random alloc/free
+// fuzz that checks every allocation against the ones still live and validates the structure
+#include "tlsf_allocator.h"
+#include "test.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+static void TestBasics()
+{
+	TlsfAllocator allocator(1 << 20, 256);
+	CHECK(allocator.IsEmpty());
+	CHECK(allocator.GetLargestFreeBlock() == 1 << 20);
+
+	// sizes round up to the granularity
+	TlsfAllocator::Handle a = allocator.Allocate(100);
+	CHECK(a != TlsfAllocator::InvalidHandle);
+	CHECK(allocator.GetSize(a) == 256);
+	CHECK(allocator.GetOffset(a) % 256 == 0);
+
+	// explicit alignment above the granularity
+	TlsfAllocator::Handle b = allocator.Allocate(1000, 65536);
+	CHECK(b != TlsfAllocator::InvalidHandle);
+	CHECK(allocator.GetOffset(b) % 65536 == 0);
+	CHECK(allocator.GetAllocationCount() == 2);
+	CHECK(allocator.Validate());
+
+	// freeing both coalesces back into one block
+	allocator.Free(a);
+	allocator.Free(b);
+	CHECK(allocator.IsEmpty());
+	CHECK(allocator.GetFreeBlockCount() == 1);
+	CHECK(allocator.GetLargestFreeBlock() == allocator.GetCapacity());
+	CHECK(allocator.Validate());
+}
+
+static void TestExhaustion()
+{
+	TlsfAllocator allocator(64 * 1024, 1024);
+	std::vector<TlsfAllocator::Handle> handles;
+	for (;;)
+	{
+		TlsfAllocator::Handle handle = allocator.Allocate(1024);
+		if (handle == TlsfAllocator::InvalidHandle)
+			break;
+		handles.push_back(handle);
+	}
+	CHECK(handles.size() == 64);
+	CHECK(allocator.GetFreeSize() == 0);
+	CHECK(allocator.Allocate(1) == TlsfAllocator::InvalidHandle);
+
+	// every other block free: plenty of space in total but nothing contiguous
+	for (size_t i = 0; i < handles.size(); i += 2)
+		allocator.Free(handles[i]);
+	CHECK(allocator.GetFreeSize() == 32 * 1024);
+	CHECK(allocator.GetLargestFreeBlock() == 1024);
+	CHECK(allocator.Allocate(2048) == TlsfAllocator::InvalidHandle);
+	CHECK(allocator.Validate());
+
+	// the gaps merge with their neighbours as the rest is freed
+	for (size_t i = 1; i < handles.size(); i += 2)
+		allocator.Free(handles[i]);
+	CHECK(allocator.GetFreeBlockCount() == 1);
+	CHECK(allocator.Validate());
+}
+
+static void TestForEachAllocation()
+{
+	TlsfAllocator allocator(1 << 16, 256);
+	TlsfAllocator::Handle a = allocator.Allocate(512);
+	TlsfAllocator::Handle b = allocator.Allocate(256);
+	TlsfAllocator::Handle c = allocator.Allocate(1024);
+	allocator.Free(b);
+
+	std::vector<uint64_t> offsets;
+	allocator.ForEachAllocation([&](TlsfAllocator::Handle, uint64_t offset, uint64_t) { offsets.push_back(offset); });
+	CHECK(offsets.size() == 2);
+	CHECK(std::is_sorted(offsets.begin(), offsets.end()));
+	CHECK(offsets.size() == 2 && offsets[0] == allocator.GetOffset(a) && offsets[1] == allocator.GetOffset(c));
+}
+
+static void TestFuzz()
+{
+	struct Live
+	{
+		TlsfAllocator::Handle handle;
+		uint64_t offset;
+		uint64_t size;
+	};
+
+	std::mt19937_64 rng(1);
+	for (int iteration = 0; iteration < 200; iteration++)
+	{
+		const uint64_t capacity = (rng() % (64 << 20)) + 4096;
+		const uint64_t granularity = 1ull << (rng() % 10);
+		TlsfAllocator allocator(capacity, granularity);
+		std::vector<Live> live;
+		for (int op = 0; op < 3000; op++)
+		{
+			if (live.empty() || rng() % 3 != 0)
+			{
+				const uint64_t size = rng() % 4 == 0 ? rng() % (capacity / 4 + 1) : rng() % 70000;
+				const uint64_t alignment = rng() % 4 == 0 ? 1ull << (rng() % 17) : 0;
+				TlsfAllocator::Handle handle = allocator.Allocate(size, alignment);
+				if (handle == TlsfAllocator::InvalidHandle)
+					continue;
+				const uint64_t offset = allocator.GetOffset(handle);
+				const uint64_t allocated = allocator.GetSize(handle);
+				CHECK(offset % std::max(alignment, granularity) == 0);
+				CHECK(allocated >= size);
+				CHECK(offset + allocated <= allocator.GetCapacity());
+				for (const Live& other : live)
+					CHECK(offset >= other.offset + other.size || other.offset >= offset + allocated);
+				live.push_back({ handle, offset, allocated });
+			}
+			else
+			{
+				const size_t i = rng() % live.size();
+				allocator.Free(live[i].handle);
+				live[i] = live.back();
+				live.pop_back();
+			}
+			if (op % 50 == 0)
+				CHECK(allocator.Validate());
+		}
+		for (const Live& allocation : live)
+			allocator.Free(allocation.handle);
+		CHECK(allocator.Validate());
+		CHECK(allocator.GetUsedSize() == 0);
+		CHECK(allocator.GetFreeBlockCount() == 1);
+		CHECK(allocator.GetLargestFreeBlock() == allocator.GetCapacity());
+	}
+}
+
+int main()
+{
+	TestBasics();
+	TestExhaustion();
+	TestForEachAllocation();
+	TestFuzz();
+	return TestResult();
+}
@@ -0,0 +1,98 @@
+// AddConcavePolyFilled() triangulation of simple polygons large enough to use the reflex grid: every
+// polygon gets points_count - 2 triangles, all wound like the polygon, covering exactly its area.
+// self-intersecting polygons still produce points_count - 2 triangles of valid indices. ear clipping
+// only flips to the other winding when it finds no ear at all, so only clockwise polygons are
+// checked for area (counter-clockwise ones are compared against the plain reflex scan instead)
+#include "imgui_headless.h"
+#include "polygons.h"
+#include "test.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+static unsigned g_randomState = 1;
+
+static float RandomFloat()
+{
+	g_randomState = g_randomState * 1664525u + 1013904223u;
+	return (g_randomState >> 8) / 16777216.0f;
+}
+
+static double SignedArea(const ImVec2& a, const ImVec2& b, const ImVec2& c)
+{
+	return 0.5 * ((double)(b.x - a.x) * (c.y - a.y) - (double)(c.x - a.x) * (b.y - a.y));
+}
+
+// positive for clockwise polygons on screen (y down)
+static double SignedArea(const std::vector<ImVec2>& points)
+{
+	double area = 0.0;
+	for (size_t i = 0; i < points.size(); i++)
+		area += 0.5 * ((double)points[i].x * points[(i + 1) % points.size()].y - (double)points[(i + 1) % points.size()].x * points[i].y);
+	return area;
+}
+
+// the non anti-aliased fill writes the points as they are, then the triangles
+static void CheckTriangles(const std::vector<ImVec2>& points, bool simple)
+{
+	ImDrawList* drawList = ImGui::GetBackgroundDrawList();
+	drawList->Flags &= ~ImDrawListFlags_AntiAliasedFill;
+	const int firstIndex = drawList->IdxBuffer.Size;
+	const int firstVertex = drawList->VtxBuffer.Size;
+	drawList->AddConcavePolyFilled(points.data(), (int)points.size(), IM_COL32_WHITE);
+	const int indexCount = drawList->IdxBuffer.Size - firstIndex;
+	CHECK(indexCount == ((int)points.size() - 2) * 3);
+	CHECK(drawList->VtxBuffer.Size - firstVertex == (int)points.size());
+
+	const double polygonArea = SignedArea(points);
+	double triangleArea = 0.0;
+	int badIndices = 0, badWinding = 0;
+	for (int i = 0; i + 3 <= indexCount; i += 3)
+	{
+		int local[3];
+		for (int k = 0; k < 3; k++)
+		{
+			local[k] = (int)drawList->IdxBuffer[firstIndex + i + k] + (int)drawList->_CmdHeader.VtxOffset - firstVertex;
+			if (local[k] < 0 || local[k] >= (int)points.size())
+			{
+				badIndices++;
+				local[k] = 0;
+			}
+		}
+		const double area = SignedArea(points[local[0]], points[local[1]], points[local[2]]);
+		triangleArea += area;
+		if (area * polygonArea < -1e-6)
+			badWinding++;
+	}
+	CHECK(badIndices == 0);
+	if (simple)
+	{
+		CHECK(badWinding == 0);
+		CHECK(fabs(triangleArea - polygonArea) <= 1e-4 * fabs(polygonArea));
+	}
+}
+
+int main()
+{
+	HeadlessImGui imgui(1920.0f, 1080.0f);
+	std::vector<ImVec2> points;
+	for (int polygon = 0; polygon < 400; polygon++)
+	{
+		imgui.NewFrame();
+		const int count = 40 + (int)(RandomFloat() * 3000); // well above IM_TRIANGULATOR_GRID_MIN_REFLEXES reflexes
+		switch (polygon % 4)
+		{
+		case 0: MakeStar(points, count, 0.9f, false, RandomFloat); break;
+		case 1: MakeStar(points, count, 0.5f, false, RandomFloat); break;
+		case 2: MakeComb(points, count / 4); break;
+		default: MakeSpiral(points, count); break;
+		}
+		if (SignedArea(points) < 0.0)
+			std::reverse(points.begin(), points.end());
+		CheckTriangles(points, true);
+		MakeRandomPolygon(points, 3 + polygon % 200, RandomFloat);
+		CheckTriangles(points, false);
+		imgui.EndFrame();
+	}
+	return TestResult();
+}
@@ -0,0 +1,137 @@
+// ImGui_ImplDX12_UploadJobs (imgui_impl_dx12_upload.h): random frames of vertex and index buffers
+// added like the dx12 backend does (all vertices, then all indices) are copied exactly, jobs stay
+// within budget, and no 64-byte line of the destination is written by two jobs. a small job size
+// that isn't a multiple of 64 gives many splits
+#define IMGUI_IMPL_DX12_UPLOAD_JOB_SIZE 1000
+#include "imgui_impl_dx12_upload.h"
+#include "test.h"
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+struct AlignedBuffer
+{
+	explicit AlignedBuffer(size_t size) : data((unsigned char*)aligned_alloc(65536, (size + 65535) & ~(size_t)65535)) {}
+	~AlignedBuffer() { free(data); }
+	unsigned char* data;
+};
+
+static void TestFrame(std::mt19937& random, int lists, bool threaded)
+{
+	std::vector<std::vector<unsigned char>> vertices(lists), indices(lists);
+	size_t vertexBytes = 0, indexBytes = 0;
+	for (int list = 0; list < lists; list++)
+	{
+		vertices[list].resize(20 * (random() % 300)); // 20-byte vertices, 2-byte indices
+		indices[list].resize(2 * (random() % 500));
+		for (unsigned char& byte : vertices[list])
+			byte = (unsigned char)random();
+		for (unsigned char& byte : indices[list])
+			byte = (unsigned char)random();
+		vertexBytes += vertices[list].size();
+		indexBytes += indices[list].size();
+	}
+	AlignedBuffer vertexDst(vertexBytes + 1), indexDst(indexBytes + 1);
+
+	ImGui_ImplDX12_UploadJobs jobs;
+	jobs.Clear();
+	size_t offset = 0;
+	for (int list = 0; list < lists; list++)
+	{
+		jobs.AddCopy(vertexDst.data + offset, vertices[list].data(), vertices[list].size());
+		offset += vertices[list].size();
+	}
+	offset = 0;
+	for (int list = 0; list < lists; list++)
+	{
+		jobs.AddCopy(indexDst.data + offset, indices[list].data(), indices[list].size());
+		offset += indices[list].size();
+	}
+	const int jobCount = jobs.Finish();
+	CHECK(jobCount >= (int)((vertexBytes + indexBytes) / (IMGUI_IMPL_DX12_UPLOAD_JOB_SIZE + 63)));
+	CHECK(jobs.JobStarts.Size == jobCount + 1 && jobs.JobStarts.back() == jobs.Copies.Size);
+
+	// the job writing each line of both buffers, -1 before any
+	std::vector<int> vertexLines(vertexBytes / 64 + 1, -1), indexLines(indexBytes / 64 + 1, -1);
+	int sharedLines = 0;
+	for (int job = 0; job < jobCount; job++)
+	{
+		size_t jobBytes = 0;
+		CHECK(jobs.JobStarts[job] < jobs.JobStarts[job + 1]); // no empty job
+		for (int n = jobs.JobStarts[job]; n < jobs.JobStarts[job + 1]; n++)
+		{
+			const ImGui_ImplDX12_UploadCopy& copy = jobs.Copies[n];
+			CHECK(copy.Size > 0);
+			jobBytes += copy.Size;
+			const bool isVertex = (unsigned char*)copy.Dst >= vertexDst.data && (unsigned char*)copy.Dst < vertexDst.data + vertexBytes;
+			unsigned char* base = isVertex ? vertexDst.data : indexDst.data;
+			std::vector<int>& lines = isVertex ? vertexLines : indexLines;
+			const size_t begin = (unsigned char*)copy.Dst - base;
+			for (size_t line = begin / 64; line <= (begin + copy.Size - 1) / 64; line++)
+			{
+				if (lines[line] != -1 && lines[line] != job)
+					sharedLines++;
+				lines[line] = job;
+			}
+		}
+		CHECK(jobBytes <= IMGUI_IMPL_DX12_UPLOAD_JOB_SIZE + 63);
+	}
+	CHECK(sharedLines == 0);
+
+	if (threaded)
+	{
+		std::vector<std::thread> threads;
+		for (int job = 0; job < jobCount; job++)
+			threads.emplace_back([&jobs, job] { jobs.RunJob(job); });
+		for (std::thread& thread : threads)
+			thread.join();
+	}
+	else
+	{
+		for (int job = 0; job < jobCount; job++)
+			jobs.RunJob(job);
+	}
+	offset = 0;
+	bool same = true;
+	for (int list = 0; list < lists; list++)
+	{
+		same &= memcmp(vertexDst.data + offset, vertices[list].data(), vertices[list].size()) == 0;
+		offset += vertices[list].size();
+	}
+	offset = 0;
+	for (int list = 0; list < lists; list++)
+	{
+		same &= memcmp(indexDst.data + offset, indices[list].data(), indices[list].size()) == 0;
+		offset += indices[list].size();
+	}
+	CHECK(same);
+}
+
+// copies of every size at every alignment, straddling the job budget
+static void TestStreamCopy()
+{
+	AlignedBuffer src(512), dst(512);
+	for (int i = 0; i < 512; i++)
+		src.data[i] = (unsigned char)(i * 7 + 3);
+	for (size_t offset = 0; offset < 64; offset++)
+		for (size_t size = 0; size < 300; size++)
+		{
+			memset(dst.data, 0xAA, 512);
+			ImGui_ImplDX12_StreamCopy(dst.data + offset, src.data + offset, size);
+			bool same = memcmp(dst.data + offset, src.data + offset, size) == 0;
+			for (size_t i = 0; i < 512; i++)
+				if (i < offset || i >= offset + size)
+					same &= dst.data[i] == 0xAA;
+			CHECK(same);
+		}
+}
+
+int main()
+{
+	TestStreamCopy();
+	std::mt19937 random(1);
+	for (int frame = 0; frame < 300; frame++)
+		TestFrame(random, 1 + frame % 40, frame % 10 == 0);
+	return TestResult();
+}
@@ -0,0 +1,273 @@
+// ImFontAtlas::AddUserImage(): images drawn with AddImage() land in the atlas texture, and every
+// quad samples back the source pixels through its remapped uvs, whole images and sub rectangles,
+// with the replicated 1 pixel border around them. an atlas capped at 512x512 cycling through 400
+// images evicts unused ones and packs them again when they come back, updated and re-registered
+// images show their new pixels, and calls the atlas can't take keep their own texture
+#include "imgui_headless.h"
+#include "imgui_internal.h"
+#include "test.h"
+#include <cmath>
+#include <vector>
+
+struct SourceImage
+{
+	ImTextureID id;
+	int w, h;
+	std::vector<ImU32> pixels;
+};
+
+static ImU32 PixelValue(int image, int x, int y, int version)
+{
+	ImU32 value = (ImU32)(image * 0x9E3779B1u) ^ (ImU32)(x * 0x85EBCA77u) ^ (ImU32)(y * 0xC2B2AE3Du) ^ (ImU32)(version * 0x27D4EB2Fu);
+	value ^= value >> 15;
+	return value * 0x2C1B3C6Du;
+}
+
+static SourceImage MakeImage(int index, int w, int h, int version = 0)
+{
+	SourceImage image = { (ImTextureID)(intptr_t)(0x10000 + index), w, h, std::vector<ImU32>((size_t)w * h) };
+	for (int y = 0; y < h; y++)
+		for (int x = 0; x < w; x++)
+			image.pixels[(size_t)y * w + x] = PixelValue(index, x, y, version);
+	return image;
+}
+
+struct DrawnQuad
+{
+	const SourceImage* image;
+	ImVec2 uv0, uv1;
+	ImDrawList* drawList;
+	int vtxStart;
+};
+
+// draws the image with AddImage(), remembering where its four vertices went
+static void DrawImage(std::vector<DrawnQuad>& quads, const SourceImage& image, const ImVec2& pos, const ImVec2& uv0 = ImVec2(0, 0), const ImVec2& uv1 = ImVec2(1, 1))
+{
+	ImDrawList* drawList = ImGui::GetWindowDrawList();
+	quads.push_back({ &image, uv0, uv1, drawList, drawList->VtxBuffer.Size });
+	drawList->AddImage(ImTextureRef(image.id), pos, ImVec2(pos.x + image.w, pos.y + image.h), uv0, uv1);
+}
+
+static const ImDrawCmd* CommandOf(const DrawnQuad& quad)
+{
+	// the command whose indices reference the first vertex
+	for (const ImDrawCmd& cmd : quad.drawList->CmdBuffer)
+		for (unsigned int n = cmd.IdxOffset; n < cmd.IdxOffset + cmd.ElemCount; n++)
+			if ((int)(quad.drawList->IdxBuffer[n] + cmd.VtxOffset) == quad.vtxStart)
+				return &cmd;
+	return nullptr;
+}
+
+// every source pixel shown by the quad against the atlas texel its uv lands on, and the border
+// texels just outside whole images against the replicated edge. returns the mismatches
+static int SampleQuad(const DrawnQuad& quad, int& samples)
+{
+	const ImDrawCmd* cmd = CommandOf(quad);
+	if (cmd == nullptr || cmd->TexRef._TexData == nullptr || cmd->TexRef._TexData->Format != ImTextureFormat_RGBA32)
+		return 1;
+	ImTextureData* tex = cmd->TexRef._TexData; // the atlas texture, or the one it was growing from
+	const ImVec2 vertexUv0 = quad.drawList->VtxBuffer[quad.vtxStart].uv;
+	const ImVec2 vertexUv1 = quad.drawList->VtxBuffer[quad.vtxStart + 2].uv;
+	const SourceImage& image = *quad.image;
+	auto texel = [&](float u, float v) { return *(const ImU32*)tex->GetPixelsAt((int)floorf(u * tex->Width), (int)floorf(v * tex->Height)); };
+	auto quadUv = [&](float imageU, float imageV) {
+		const float tx = (imageU - quad.uv0.x) / (quad.uv1.x - quad.uv0.x), ty = (imageV - quad.uv0.y) / (quad.uv1.y - quad.uv0.y);
+		return ImVec2(vertexUv0.x + tx * (vertexUv1.x - vertexUv0.x), vertexUv0.y + ty * (vertexUv1.y - vertexUv0.y));
+	};
+
+	int mismatches = 0;
+	for (int y = (int)ceilf(quad.uv0.y * image.h); y < (int)(quad.uv1.y * image.h); y++)
+		for (int x = (int)ceilf(quad.uv0.x * image.w); x < (int)(quad.uv1.x * image.w); x++)
+		{
+			const ImVec2 uv = quadUv((x + 0.5f) / image.w, (y + 0.5f) / image.h);
+			mismatches += texel(uv.x, uv.y) != image.pixels[(size_t)y * image.w + x];
+			samples++;
+		}
+	if (quad.uv0.x == 0.0f && quad.uv0.y == 0.0f && quad.uv1.x == 1.0f && quad.uv1.y == 1.0f)
+	{
+		const float texelW = 1.0f / tex->Width, texelH = 1.0f / tex->Height;
+		for (int y = -1; y <= image.h; y++)
+			for (int x = -1; x <= image.w; x++)
+			{
+				if (x >= 0 && y >= 0 && x < image.w && y < image.h)
+					continue;
+				const ImVec2 uv = quadUv((ImClamp(x, 0, image.w - 1) + 0.5f) / image.w, (ImClamp(y, 0, image.h - 1) + 0.5f) / image.h);
+				const float u = uv.x + (x < 0 ? -texelW : x >= image.w ? texelW : 0.0f), v = uv.y + (y < 0 ? -texelH : y >= image.h ? texelH : 0.0f);
+				mismatches += texel(u, v) != image.pixels[(size_t)ImClamp(y, 0, image.h - 1) * image.w + ImClamp(x, 0, image.w - 1)];
+				samples++;
+			}
+	}
+	return mismatches;
+}
+
+static bool IsResident(ImFontAtlas* atlas, const SourceImage& image)
+{
+	for (ImFontAtlasUserImage* userImage : atlas->UserImages)
+		if (userImage->TexID == image.id)
+			return userImage->PackId != ImFontAtlasRectId_Invalid;
+	return false;
+}
+
+static void TestSampling()
+{
+	HeadlessImGui imgui;
+	ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+	std::vector<SourceImage> images;
+	for (int i = 0; i < 40; i++)
+		images.push_back(MakeImage(i, 1 + (i * 7) % 64, 1 + (i * 13) % 64));
+	for (const SourceImage& image : images)
+		CHECK(atlas->AddUserImage(image.id, image.pixels.data(), image.w, image.h));
+	const SourceImage tooLarge = MakeImage(999, 65, 8);
+	CHECK(!atlas->AddUserImage(tooLarge.id, tooLarge.pixels.data(), tooLarge.w, tooLarge.h));
+
+	int mismatches = 0, samples = 0, quadsInAtlas = 0, ownTexture = 0;
+	for (int frame = 0; frame < 4; frame++)
+	{
+		std::vector<DrawnQuad> quads;
+		imgui.NewFrame();
+		ImGui::SetNextWindowPos(ImVec2(0, 0));
+		ImGui::SetNextWindowSize(ImVec2(1200, 700));
+		ImGui::Begin("images", nullptr, ImGuiWindowFlags_NoSavedSettings);
+		ImGui::Text("icons");
+		for (int i = 0; i < (int)images.size(); i++)
+		{
+			const ImVec2 pos((i % 10) * 70.0f + 10.0f, (i / 10) * 70.0f + 40.0f);
+			if (frame % 2 == 0)
+				DrawImage(quads, images[i], pos);
+			else
+				DrawImage(quads, images[i], pos, ImVec2(0.25f, 0.5f), ImVec2(0.75f, 1.0f));
+		}
+
+		// tiling uvs need texture addressing, unregistered textures aren't touched
+		ImDrawList* drawList = ImGui::GetWindowDrawList();
+		drawList->AddImage(ImTextureRef(images[0].id), ImVec2(800, 40), ImVec2(864, 104), ImVec2(0, 0), ImVec2(2, 2));
+		drawList->AddImage(ImTextureRef(tooLarge.id), ImVec2(800, 140), ImVec2(864, 204));
+		ImGui::End();
+		ImGui::Render();
+		for (const ImDrawCmd& cmd : drawList->CmdBuffer)
+			ownTexture += cmd.ElemCount > 0 && (cmd.GetTexID() == images[0].id || cmd.GetTexID() == tooLarge.id);
+		for (const DrawnQuad& quad : quads)
+		{
+			mismatches += SampleQuad(quad, samples);
+			const ImDrawCmd* cmd = CommandOf(quad);
+			quadsInAtlas += cmd != nullptr && cmd->TexRef._TexData != nullptr;
+		}
+		HeadlessImGui::ProcessTextures();
+	}
+	CHECK(mismatches == 0);
+	CHECK(quadsInAtlas == 4 * (int)images.size());
+	CHECK(ownTexture == 8);
+	CHECK(samples > 40000);
+
+	// ImGui::Image() and ImageButton() between text share the atlas draw commands with the text
+	auto toolbar = [&] {
+		ImGui::SetNextWindowPos(ImVec2(0, 0));
+		ImGui::Begin("toolbar", nullptr, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+		for (int i = 0; i < 12; i++)
+		{
+			ImGui::PushID(i);
+			ImGui::ImageButton("button", ImTextureRef(images[i].id), ImVec2(24, 24));
+			ImGui::SameLine();
+			ImGui::Text("%d", i);
+			ImGui::SameLine();
+			ImGui::Image(ImTextureRef(images[i + 12].id), ImVec2(16, 16));
+			ImGui::PopID();
+		}
+		ImGui::End();
+	};
+	imgui.Frame(toolbar); // auto resizing windows are hidden in their first frame
+	ImDrawData* drawData = imgui.Frame(toolbar);
+	int commands = 0, otherTextures = 0;
+	for (ImDrawList* list : drawData->CmdLists)
+		for (const ImDrawCmd& cmd : list->CmdBuffer)
+		{
+			commands += cmd.ElemCount > 0;
+			otherTextures += cmd.ElemCount > 0 && cmd.TexRef._TexData != atlas->TexData;
+		}
+	CHECK(otherTextures == 0);
+	CHECK(commands <= 2); // the window decorations are clipped apart from the contents
+}
+
+static void TestEviction()
+{
+	HeadlessImGui imgui;
+	ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+	atlas->TexMaxWidth = atlas->TexMaxHeight = 512;
+	std::vector<SourceImage> images;
+	for (int i = 0; i < 400; i++)
+		images.push_back(MakeImage(i, 48, 48));
+	for (const SourceImage& image : images)
+		atlas->AddUserImage(image.id, image.pixels.data(), image.w, image.h);
+
+	// 60 images a frame, moving on by 20: each image is drawn for 3 frames then not for 17
+	int mismatches = 0, samples = 0, evicted = 0, packedAgain = 0;
+	std::vector<int> wasResident(images.size(), 0);
+	for (int frame = 0; frame < 60; frame++)
+	{
+		std::vector<DrawnQuad> quads;
+		imgui.NewFrame();
+		ImGui::SetNextWindowPos(ImVec2(0, 0));
+		ImGui::SetNextWindowSize(ImVec2(1200, 700));
+		ImGui::Begin("images", nullptr, ImGuiWindowFlags_NoSavedSettings);
+		for (int k = 0; k < 60; k++)
+		{
+			const int i = (frame * 20 + k) % (int)images.size();
+			if (wasResident[i] == 2 && !IsResident(atlas, images[i]))
+				packedAgain++;
+			DrawImage(quads, images[i], ImVec2((k % 20) * 55.0f, (k / 20) * 55.0f + 30.0f));
+		}
+		ImGui::End();
+		ImGui::Render();
+		for (const DrawnQuad& quad : quads)
+			mismatches += SampleQuad(quad, samples);
+		HeadlessImGui::ProcessTextures();
+		for (int i = 0; i < (int)images.size(); i++)
+		{
+			const bool resident = IsResident(atlas, images[i]);
+			if (wasResident[i] == 1 && !resident)
+			{
+				evicted++;
+				wasResident[i] = 2;
+			}
+			else if (resident)
+			{
+				wasResident[i] = 1;
+			}
+		}
+		CHECK(atlas->TexData->Width <= 512 && atlas->TexData->Height <= 512);
+	}
+	CHECK(mismatches == 0);
+	CHECK(evicted > 100);
+	CHECK(packedAgain > 50);
+
+	// new pixels for a resident image, and an image removed then registered again
+	const SourceImage updated = MakeImage(5, 32, 40, 1);
+	const SourceImage readded = MakeImage(6, 48, 48, 2);
+	atlas->AddUserImage(updated.id, updated.pixels.data(), updated.w, updated.h);
+	atlas->RemoveUserImage(readded.id);
+	CHECK(!IsResident(atlas, readded));
+	atlas->AddUserImage(readded.id, readded.pixels.data(), readded.w, readded.h);
+	for (int frame = 0; frame < 2; frame++)
+	{
+		std::vector<DrawnQuad> quads;
+		imgui.NewFrame();
+		ImGui::Begin("images");
+		DrawImage(quads, updated, ImVec2(10, 10));
+		DrawImage(quads, readded, ImVec2(100, 10));
+		ImGui::End();
+		ImGui::Render();
+		for (const DrawnQuad& quad : quads)
+			mismatches += SampleQuad(quad, samples);
+		HeadlessImGui::ProcessTextures();
+	}
+	CHECK(mismatches == 0);
+	atlas->RemoveUserImage(updated.id);
+	CHECK(atlas->UserImages.Size == (int)images.size() - 1);
+}
+
+int main()
+{
+	TestSampling();
+	TestEviction();
+	return TestResult();
+}
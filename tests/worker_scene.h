@@ -0,0 +1,45 @@
+#pragma once
+#include "imgui.h"
+#include <cmath>
+
+// a canvas drawn in slices, for ImDrawListWorkers: each slice of 'points' points is a scatter plot of
+// 2x2 rects with a thick polyline through every 64 points, and every 4096 points a clipped circle,
+// a concave polygon (uses the shared data's TempBuffer), an image and a callback, so the merged draw
+// list has clip rect, texture and callback commands. a slice only depends on its index, so it can be
+// drawn on any thread or straight into the window's draw list with the same result. no text
+
+inline void WorkerSceneCallback(const ImDrawList*, const ImDrawCmd*) {}
+
+inline ImVec2 WorkerScenePoint(int point, int frame)
+{
+	const float t = point * 0.0007f + frame * 0.05f;
+	return ImVec2(40.0f + (point % 1800) + 8.0f * sinf(t * 3.0f), 40.0f + 500.0f + 450.0f * sinf(t) * cosf(t * 0.37f));
+}
+
+inline void DrawWorkerSlice(ImDrawList* drawList, int slice, int points, int frame)
+{
+	const int first = slice * points;
+	ImVec2 line[64];
+	for (int i = 0; i < points; i++)
+	{
+		const int point = first + i;
+		const ImVec2 p = WorkerScenePoint(point, frame);
+		const ImU32 col = IM_COL32(point * 37 & 255, point * 91 & 255, 200, 255);
+		drawList->AddRectFilled(p, ImVec2(p.x + 2.0f, p.y + 2.0f), col);
+		line[point % 64] = ImVec2(p.x, p.y - 20.0f);
+		if (point % 64 == 63)
+			drawList->AddPolyline(line, 64, col, ImDrawFlags_None, 1.5f + (point / 64 % 4));
+		if (point % 4096 == 2048)
+		{
+			drawList->PushClipRect(ImVec2(p.x - 30.0f, p.y - 30.0f), ImVec2(p.x + 10.0f, p.y + 10.0f), true);
+			drawList->AddCircleFilled(p, 25.0f, col);
+			drawList->AddCircle(p, 25.0f, IM_COL32_WHITE, 0, 2.0f);
+			drawList->PopClipRect();
+			const ImVec2 star[] = { ImVec2(p.x, p.y - 20), ImVec2(p.x + 5, p.y - 5), ImVec2(p.x + 20, p.y), ImVec2(p.x + 5, p.y + 5),
+				ImVec2(p.x, p.y + 20), ImVec2(p.x - 5, p.y + 5), ImVec2(p.x - 20, p.y), ImVec2(p.x - 5, p.y - 5) };
+			drawList->AddConcavePolyFilled(star, IM_ARRAYSIZE(star), col);
+			drawList->AddImage(ImTextureRef((ImTextureID)(intptr_t)(0x1000 + slice)), p, ImVec2(p.x + 16.0f, p.y + 16.0f));
+			drawList->AddCallback(WorkerSceneCallback, nullptr);
+		}
+	}
+}